@@ -419,6 +419,39 @@ TEST(GbdtTest, require_that_fast_forest_evaluation_is_correct_for_all_tree_size_
     }
 }
 
+TEST(GbdtTest, require_that_fast_forest_batch_evaluation_matches_single_evaluation) {
+    for (size_t tree_size : std::vector<size_t>({7, 15, 30, 61, 127})) {
+        std::string expression =
+            Model().max_features(35).less_percent(100).invert_percent(50).make_forest(64, tree_size);
+        auto function = Function::parse(expression);
+        auto forest = FastForest::try_convert(*function);
+        if ((tree_size <= 64) || is_little_endian()) {
+            ASSERT_TRUE(forest);
+            SCOPED_TRACE(forest->impl_name());
+            size_t num_params = function->num_params();
+            auto   ctx = forest->create_context();
+            for (size_t num_docs : std::vector<size_t>({1, 7, FastForest::max_batch_size})) {
+                std::vector<float> params(num_params * num_docs);
+                for (size_t p = 0; p < num_params; ++p) {
+                    for (size_t d = 0; d < num_docs; ++d) {
+                        params[(p * num_docs) + d] = (((p + d) % 5) == 0) ? std::numeric_limits<float>::quiet_NaN()
+                                                                          : ((p * 7 + d * 13) % 10) / 10.0;
+                    }
+                }
+                std::vector<double> results(num_docs);
+                forest->eval_batch(*ctx, params.data(), num_docs, results.data());
+                for (size_t d = 0; d < num_docs; ++d) {
+                    std::vector<float> doc_params(num_params);
+                    for (size_t p = 0; p < num_params; ++p) {
+                        doc_params[p] = params[(p * num_docs) + d];
+                    }
+                    EXPECT_EQ(forest->eval(*ctx, doc_params.data()), results[d]);
+                }
+            }
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 TEST(GbdtTest, require_that_GDBT_expressions_can_be_detected) {
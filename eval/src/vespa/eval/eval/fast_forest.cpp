@@ -13,6 +13,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <limits>
 
 namespace vespalib::eval::gbdt {
 
@@ -156,7 +157,8 @@ template <typename T> constexpr size_t max_leafs() {
 
 template <typename T> struct FixedContext : FastForest::Context {
     std::vector<T> masks;
-    FixedContext(size_t num_trees) : masks(num_trees) {}
+    std::vector<T> batch_masks; // allocated on first batch evaluation
+    FixedContext(size_t num_trees) : masks(num_trees), batch_masks() {}
 };
 
 template <typename T> struct FixedForest : FastForest {
@@ -202,11 +204,15 @@ template <typename T> struct FixedForest : FastForest {
     void init_state(T* ctx_masks) const;
     static void apply_masks(T* ctx_masks, const Mask* pos, const Mask* end, float limit);
     static void apply_masks(T* ctx_masks, const DMask* pos, const DMask* end);
+    static void apply_batch_mask(T* doc_masks, T bits, float value, const float* features, size_t num_docs);
+    static void apply_default_batch_mask(T* doc_masks, T bits, const float* features, size_t num_docs);
     double get_result(const T* ctx_masks) const;
+    double get_batch_result(const T* batch_masks, size_t doc) const;
 
     std::string impl_name() const override { return fixed_impl_name<T>(); }
     Context::UP create_context() const override;
     double eval(Context& context, const float* params) const override;
+    void eval_batch(Context& context, const float* params, size_t num_docs, double* results) const override;
 };
 
 template <typename T>
@@ -317,13 +323,92 @@ template <typename T> double FixedForest<T>::eval(Context& context, const float*
     return get_result(ctx_masks);
 }
 
+// The mask of each tree is stored for all documents in the batch next
+// to each other, so that a comparison node is applied to all documents
+// with a branch-free loop the compiler can vectorize.
+template <typename T>
+void FixedForest<T>::apply_batch_mask(T* doc_masks, T bits, float value, const float* features, size_t num_docs) {
+    for (size_t d = 0; d < num_docs; ++d) {
+        doc_masks[d] &= (value <= features[d]) ? bits : T(~T(0));
+    }
+}
+
+template <typename T>
+void FixedForest<T>::apply_default_batch_mask(T* doc_masks, T bits, const float* features, size_t num_docs) {
+    for (size_t d = 0; d < num_docs; ++d) {
+        doc_masks[d] &= std::isnan(features[d]) ? bits : T(~T(0));
+    }
+}
+
+// same summation order as get_result
+template <typename T> double FixedForest<T>::get_batch_result(const T* batch_masks, size_t doc) const {
+    constexpr size_t stride = max_batch_size;
+    double           result1 = 0.0;
+    double           result2 = 0.0;
+    const T*         ctx_masks = batch_masks + doc;
+    const T*         ctx_end = ctx_masks + (_num_trees * stride);
+    const float*     leafs = &_padded_leafs[0];
+    size_t           leaf_cnt = _max_leafs;
+    for (; (ctx_masks + (3 * stride)) < ctx_end; ctx_masks += (4 * stride), leafs += (leaf_cnt * 4)) {
+        result1 += leafs[(0 * leaf_cnt) + get_lsb(ctx_masks[0 * stride])];
+        result2 += leafs[(1 * leaf_cnt) + get_lsb(ctx_masks[1 * stride])];
+        result1 += leafs[(2 * leaf_cnt) + get_lsb(ctx_masks[2 * stride])];
+        result2 += leafs[(3 * leaf_cnt) + get_lsb(ctx_masks[3 * stride])];
+    }
+    for (; ctx_masks < ctx_end; ctx_masks += stride, leafs += leaf_cnt) {
+        result1 += leafs[get_lsb(*ctx_masks)];
+    }
+    return (result1 + result2);
+}
+
+template <typename T>
+void FixedForest<T>::eval_batch(Context& context, const float* params, size_t num_docs, double* results) const {
+    assert(num_docs <= max_batch_size);
+    auto& batch_masks = static_cast<FixedContext<T>&>(context).batch_masks;
+    if (batch_masks.empty()) {
+        batch_masks.resize(_num_trees * max_batch_size);
+    }
+    T* ctx_masks = &batch_masks[0];
+    memset(ctx_masks, 0xff, batch_masks.size() * sizeof(T));
+    const Mask* mask_pos = &_masks[0];
+    for (size_t p = 0; p < _mask_sizes.size(); ++p) {
+        const float* features = params + (p * num_docs);
+        const Mask*  mask_end = mask_pos + _mask_sizes[p];
+        // masks are sorted on value; only apply the ones at or below the largest feature value
+        float limit = -std::numeric_limits<float>::infinity();
+        bool  has_nan = false;
+        for (size_t d = 0; d < num_docs; ++d) {
+            if (std::isnan(features[d])) {
+                has_nan = true;
+            } else {
+                limit = std::max(limit, features[d]);
+            }
+        }
+        for (const Mask* pos = mask_pos; (pos < mask_end) && !(limit < pos->value); ++pos) {
+            apply_batch_mask(ctx_masks + (pos->tree * max_batch_size), pos->bits, pos->value, features, num_docs);
+        }
+        if (has_nan) {
+            const DMask* pos = _default_masks.data() + _default_offsets[p];
+            const DMask* end = _default_masks.data() + _default_offsets[p + 1];
+            for (; pos < end; ++pos) {
+                apply_default_batch_mask(ctx_masks + (pos->tree * max_batch_size), pos->bits, features, num_docs);
+            }
+        }
+        mask_pos = mask_end;
+    }
+    for (size_t d = 0; d < num_docs; ++d) {
+        results[d] = get_batch_result(ctx_masks, d);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // implementation using multiple words for each tree
 //-----------------------------------------------------------------------------
 
 struct MultiWordContext : FastForest::Context {
     std::vector<uint32_t> words;
-    MultiWordContext(size_t size) : words(size) {}
+    std::vector<float>    doc_params; // used for batch evaluation
+    MultiWordContext(size_t size, size_t num_params) : words(size), doc_params(num_params) {}
 };
 
 struct MultiWordForest : FastForest {
@@ -421,6 +506,7 @@ struct MultiWordForest : FastForest {
     std::string impl_name() const override { return "ff-multiword"; }
     Context::UP create_context() const override;
     double eval(Context& context, const float* params) const override;
+    void eval_batch(Context& context, const float* params, size_t num_docs, double* results) const override;
 };
 
 MultiWordForest::MultiWordForest(const State& state)
@@ -549,7 +635,7 @@ double MultiWordForest::get_result(const uint32_t* ctx_words) const {
 }
 
 FastForest::Context::UP MultiWordForest::create_context() const {
-    return std::make_unique<MultiWordContext>(_words_per_tree * _tree_offsets.size());
+    return std::make_unique<MultiWordContext>(_words_per_tree * _tree_offsets.size(), _mask_sizes.size());
 }
 
 double MultiWordForest::eval(Context& context, const float* params) const {
@@ -575,6 +661,17 @@ double MultiWordForest::eval(Context& context, const float* params) const {
     return get_result(ctx_words);
 }
 
+// masks spanning multiple words are not vectorized; evaluate one document at a time
+void MultiWordForest::eval_batch(Context& context, const float* params, size_t num_docs, double* results) const {
+    auto& doc_params = static_cast<MultiWordContext&>(context).doc_params;
+    for (size_t d = 0; d < num_docs; ++d) {
+        for (size_t p = 0; p < doc_params.size(); ++p) {
+            doc_params[p] = params[(p * num_docs) + d];
+        }
+        results[d] = eval(context, doc_params.data());
+    }
+}
+
 } // namespace
 
 //-----------------------------------------------------------------------------
@@ -39,6 +39,16 @@ public:
     virtual std::string impl_name() const = 0;
     virtual Context::UP create_context() const = 0;
     virtual double eval(Context& context, const float* params) const = 0;
+
+    static constexpr size_t max_batch_size = 16;
+    /**
+     * Evaluate the forest for up to max_batch_size documents at
+     * once. Parameters are stored column-wise; the value of parameter
+     * 'p' for document 'd' is params[(p * num_docs) + d]. Comparisons
+     * are done for all documents in the batch at the same time,
+     * giving the same results as calling eval for each document.
+     **/
+    virtual void eval_batch(Context& context, const float* params, size_t num_docs, double* results) const = 0;
     double estimate_cost_us(const std::vector<double>& params, double budget = 5.0) const;
 };
 
@@ -279,6 +279,7 @@ public enum SearchNodeMetrics implements VespaMetrics {
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_APPROXIMATE_NNS_DISTANCES_COMPUTED("content.proton.documentdb.matching.rank_profile.approximate_nns_distances_computed", Unit.DISTANCE, "Number of distances computed in approximate nearest-neighbor search"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_APPROXIMATE_NNS_NODES_VISITED("content.proton.documentdb.matching.rank_profile.approximate_nns_nodes_visited", Unit.GRAPH_NODE, "Number of nodes visited in approximate nearest-neighbor search"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_LIMITED_QUERIES("content.proton.documentdb.matching.rank_profile.limited_queries", Unit.QUERY, "Number of queries limited in match phase"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_PROFILED_QUERIES("content.proton.documentdb.matching.rank_profile.profiled_queries", Unit.QUERY, "Number of queries sampled for execution profiling"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_DOCID_PARTITION_ACTIVE_TIME("content.proton.documentdb.matching.rank_profile.docid_partition.active_time", Unit.SECOND, "Time (sec) spent doing actual work"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_DOCID_PARTITION_DOCS_MATCHED("content.proton.documentdb.matching.rank_profile.docid_partition.docs_matched", Unit.DOCUMENT, "Number of documents matched"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_DOCID_PARTITION_DOCS_RANKED("content.proton.documentdb.matching.rank_profile.docid_partition.docs_ranked", Unit.DOCUMENT, "Number of documents ranked (first phase)"),
@@ -43,6 +43,8 @@
 #include <vespa/searchlib/predicate/predicate_hash.h>
 #include <vespa/searchlib/predicate/predicate_index.h>
 #include <vespa/searchlib/tensor/dense_tensor_attribute.h>
+#include <vespa/searchlib/tensor/distance_function_factory.h>
+#include <vespa/searchlib/tensor/nearest_neighbor_index.h>
 #include <vespa/searchlib/tensor/tensor_attribute.h>
 #include <vespa/searchlib/test/directory_handler.h>
 #include <vespa/searchlib/test/doc_builder.h>
@@ -89,6 +91,7 @@ using search::index::DummyFileHeaderContext;
 using search::predicate::PredicateHash;
 using search::predicate::PredicateIndex;
 using search::tensor::DenseTensorAttribute;
+using search::tensor::NearestNeighborIndex;
 using search::tensor::PrepareResult;
 using search::tensor::TensorAttribute;
 using search::test::DirectoryHandler;
@@ -940,6 +943,118 @@ TEST_F(TwoPhasePutTest, handles_assign_update_as_two_phase_put_when_specified_fo
     assertExecuteHistory({0, 0});
 }
 
+class PartitionedTensorTest : public AttributeWriterTest {
+public:
+    DocBuilder          builder;
+    AttributeVector::SP tenant;
+    AttributeVector::SP tensor;
+
+    PartitionedTensorTest()
+        : AttributeWriterTest(),
+          builder([](auto& bldr, auto& header) {
+              header.addField("tenant", bldr.intTypeRef());
+              header.addTensorField("t1", dense_tensor);
+          }),
+          tenant(),
+          tensor() {}
+    ~PartitionedTensorTest() override;
+    void add_attributes(const AVConfig& tenant_cfg, const std::string& partition_attribute) {
+        tenant = addAttribute({"tenant", tenant_cfg});
+        auto cfg = get_tensor_config(false);
+        cfg.set_hnsw_index_params(HnswIndexParams(4, 4, DistanceMetric::Euclidean, false, 0, partition_attribute));
+        tensor = addAttribute({"t1", cfg});
+        allocAttributeWriter();
+    }
+    // Document with lid i has the vector (i, 0)
+    void put_doc(SerialNum serial_num, uint32_t lid, int32_t tenant_value) {
+        auto doc = builder.make_document("id:ns:searchdocument::" + std::to_string(lid));
+        doc->setValue("tenant", IntFieldValue(tenant_value));
+        TensorFieldValue fv(*doc->getField("t1").getDataType().cast_tensor());
+        fv = SimpleValue::from_spec(TensorSpec(dense_tensor).add({{"x", 0}}, lid).add({{"x", 1}}, 0));
+        doc->setValue("t1", fv);
+        put(serial_num, *doc, lid);
+    }
+    void update_tenant(SerialNum serial_num, uint32_t lid, int32_t tenant_value) {
+        DocumentUpdate upd(builder.get_repo(), builder.get_document_type(),
+                           DocumentId("id:ns:searchdocument::" + std::to_string(lid)));
+        auto           value = std::make_unique<IntFieldValue>(tenant_value);
+        upd.addUpdate(FieldUpdate(upd.getType().getField("tenant"))
+                          .addUpdate(std::make_unique<AssignValueUpdate>(std::move(value))));
+        DummyFieldUpdateCallback on_update;
+        update(serial_num, upd, lid, on_update);
+    }
+    const NearestNeighborIndex* get_partition(int64_t key) {
+        return dynamic_cast<TensorAttribute&>(*tensor).nearest_neighbor_index()->get_partition(key);
+    }
+    std::vector<uint32_t> find_in_partition(int64_t key) {
+        auto* partition = get_partition(key);
+        if (partition == nullptr) {
+            return {99};
+        }
+        std::vector<double>         query = {0.0, 0.0};
+        NearestNeighborIndex::Stats stats;
+        auto df = partition->distance_function_factory().for_query_vector(
+            vespalib::eval::TypedCells(std::span<const double>(query)));
+        auto hits = partition->find_top_k(stats, 10, *df, 100, 0.0, false, vespalib::Deadline::never(), 10000.0);
+        std::vector<uint32_t> result;
+        for (const auto& hit : hits) {
+            result.push_back(hit.docid);
+        }
+        return result;
+    }
+};
+
+PartitionedTensorTest::~PartitionedTensorTest() = default;
+
+TEST_F(PartitionedTensorTest, partitioned_tensor_attribute_is_written_after_its_partition_attribute) {
+    add_attributes(AVConfig(AVBasicType::INT32), "tenant");
+    const auto& ctx = _aw->get_write_contexts();
+    ASSERT_EQ(1, ctx.size());
+    ASSERT_EQ(2, ctx[0].getFields().size());
+    EXPECT_EQ("tenant", ctx[0].getFields()[0].getAttribute().getName());
+    EXPECT_EQ((std::vector<TensorAttribute*>{dynamic_cast<TensorAttribute*>(tensor.get())}),
+              ctx[0].getFields()[0].partitioned_tensors());
+    EXPECT_EQ("t1", ctx[0].getFields()[1].getAttribute().getName());
+    EXPECT_TRUE(ctx[0].getFields()[1].partitioned_tensors().empty());
+}
+
+TEST_F(PartitionedTensorTest, documents_are_added_to_partition_of_partition_attribute_value) {
+    add_attributes(AVConfig(AVBasicType::INT32), "tenant");
+    put_doc(1, 1, 10);
+    put_doc(2, 2, 11);
+    put_doc(3, 3, 10);
+    EXPECT_EQ((std::vector<uint32_t>{1, 3}), find_in_partition(10));
+    EXPECT_EQ((std::vector<uint32_t>{2}), find_in_partition(11));
+    EXPECT_EQ((std::vector<uint32_t>{}), find_in_partition(12));
+    remove(4, 3);
+    EXPECT_EQ((std::vector<uint32_t>{1}), find_in_partition(10));
+}
+
+TEST_F(PartitionedTensorTest, partial_update_of_partition_attribute_moves_document_to_new_partition) {
+    add_attributes(AVConfig(AVBasicType::INT32), "tenant");
+    put_doc(1, 1, 10);
+    put_doc(2, 2, 11);
+    update_tenant(3, 1, 11);
+    EXPECT_EQ((std::vector<uint32_t>{}), find_in_partition(10));
+    EXPECT_EQ((std::vector<uint32_t>{1, 2}), find_in_partition(11));
+    // Put with the same tensor, but with a new value of the partition attribute
+    put_doc(4, 2, 10);
+    EXPECT_EQ((std::vector<uint32_t>{2}), find_in_partition(10));
+    EXPECT_EQ((std::vector<uint32_t>{1}), find_in_partition(11));
+}
+
+TEST_F(PartitionedTensorTest, index_is_not_partitioned_when_partition_attribute_is_not_single_value_integer) {
+    add_attributes(AVConfig(AVBasicType::INT32, AVCollectionType::ARRAY), "tenant");
+    EXPECT_EQ(nullptr, get_partition(10));
+    EXPECT_TRUE(_aw->get_write_contexts()[0].getFields()[0].partitioned_tensors().empty());
+}
+
+TEST_F(PartitionedTensorTest, index_is_not_partitioned_when_partition_attribute_is_missing) {
+    add_attributes(AVConfig(AVBasicType::INT32), "missing");
+    put_doc(1, 1, 10);
+    EXPECT_EQ(nullptr, get_partition(10));
+}
+
 ImportedAttributeVector::SP createImportedAttribute(const std::string& name) {
     auto result = ImportedAttributeVectorFactory::create(name, {}, {}, {}, {}, true);
     result->getSearchCache()->insert("foo", {});
@@ -24,6 +24,7 @@
 
 #include <cinttypes>
 #include <filesystem>
+#include <fstream>
 #include <thread>
 
 #include <vespa/log/log.h>
@@ -550,6 +551,116 @@ TEST(AttributeFlushTest, require_that_flush_failure_prevents_sync_token_update)
     EXPECT_EQ(0u, flush_target->getFlushedSerialNum());
 }
 
+TEST(AttributeFlushTest, require_that_delta_flushes_are_saved_and_loaded) {
+    constexpr uint32_t numDocs = 1000;
+    BaseFixture        f;
+    AVConfig           cfg(getInt32Config());
+    cfg.set_max_delta_flushes(2);
+    auto has_file = [](uint64_t serial, const std::string& suffix) {
+        return fs::exists(fs::path("flush/a13/snapshot-" + std::to_string(serial) + "/a13" + suffix));
+    };
+    auto flush = [](AttributeManager& am, uint64_t serial) {
+        auto ft = am.getFlushable("a13");
+        ft->initFlush(serial, std::make_shared<search::FlushToken>())->run();
+        EXPECT_EQ(serial, ft->getFlushedSerialNum());
+    };
+    {
+        AttributeManagerFixture amf(f);
+        AttributeVector::SP     av = amf._m.addAttribute({"a13", cfg}, createSerialNum);
+        IntegerAttribute&       ia = static_cast<IntegerAttribute&>(*av);
+        av->addDocs(numDocs);
+        for (uint32_t i = 0; i < numDocs; ++i) {
+            ia.update(i + 1, i + 43);
+        }
+        av->commit(CommitParam::UpdateStats::FORCE);
+        flush(amf._m, 200);
+        EXPECT_FALSE(has_file(200, ".delta.1.dat"));
+        ia.update(5, 1000);
+        av->commit(CommitParam::UpdateStats::FORCE);
+        flush(amf._m, 201);
+        EXPECT_TRUE(has_file(201, ".dat"));
+        EXPECT_TRUE(has_file(201, ".delta.1.dat"));
+        av->addDocs(10);
+        ia.update(numDocs + 5, 7);
+        ia.update(6, 2000);
+        av->commit(CommitParam::UpdateStats::FORCE);
+        flush(amf._m, 202);
+        EXPECT_TRUE(has_file(202, ".delta.1.dat"));
+        EXPECT_TRUE(has_file(202, ".delta.2.dat"));
+    }
+    {
+        AttributeManagerFixture amf(f);
+        AttributeVector::SP     av = amf._m.addAttribute({"a13", cfg}, createSerialNum);
+        IntegerAttribute&       ia = static_cast<IntegerAttribute&>(*av);
+        EXPECT_EQ(numDocs + 11, av->getNumDocs());
+        EXPECT_EQ(1000, av->getInt(5));
+        EXPECT_EQ(2000, av->getInt(6));
+        EXPECT_EQ(49, av->getInt(7));
+        EXPECT_EQ(7, av->getInt(numDocs + 5));
+        // Max number of deltas reached, consolidate with a full flush
+        ia.update(7, 3000);
+        av->commit(CommitParam::UpdateStats::FORCE);
+        flush(amf._m, 203);
+        EXPECT_FALSE(has_file(203, ".delta.1.dat"));
+        ia.update(8, 4000);
+        av->commit(CommitParam::UpdateStats::FORCE);
+        flush(amf._m, 204);
+        EXPECT_TRUE(has_file(204, ".delta.1.dat"));
+    }
+    {
+        AttributeManagerFixture amf(f);
+        AttributeVector::SP     av = amf._m.addAttribute({"a13", cfg}, createSerialNum);
+        EXPECT_EQ(numDocs + 11, av->getNumDocs());
+        EXPECT_EQ(3000, av->getInt(7));
+        EXPECT_EQ(4000, av->getInt(8));
+        EXPECT_EQ(51, av->getInt(9));
+    }
+}
+
+TEST(AttributeFlushTest, require_that_corrupt_delta_file_fails_load) {
+    BaseFixture f;
+    AVConfig    cfg(getInt32Config());
+    cfg.set_max_delta_flushes(2);
+    std::string delta_file_name("flush/a14/snapshot-201/a14.delta.1.dat");
+    {
+        AttributeManagerFixture amf(f);
+        AttributeVector::SP     av = amf._m.addAttribute({"a14", cfg}, createSerialNum);
+        IntegerAttribute&       ia = static_cast<IntegerAttribute&>(*av);
+        av->addDocs(100);
+        for (uint32_t i = 1; i < 100; ++i) {
+            ia.update(i, i);
+        }
+        av->commit(CommitParam::UpdateStats::FORCE);
+        amf._m.getFlushable("a14")->initFlush(200, std::make_shared<search::FlushToken>())->run();
+        ia.update(5, 1000);
+        av->commit(CommitParam::UpdateStats::FORCE);
+        amf._m.getFlushable("a14")->initFlush(201, std::make_shared<search::FlushToken>())->run();
+        ASSERT_TRUE(fs::exists(fs::path(delta_file_name)));
+    }
+    // A docid outside the doc id limit fails the load instead of aborting
+    {
+        std::fstream file(delta_file_name, std::ios::in | std::ios::out | std::ios::binary);
+        std::string  content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        uint32_t     record[2] = {5, 1000};
+        auto         pos = content.rfind(std::string_view(reinterpret_cast<const char*>(record), sizeof(record)));
+        ASSERT_NE(std::string::npos, pos);
+        uint32_t bad_docid = 1000;
+        file.clear();
+        file.seekp(pos);
+        file.write(reinterpret_cast<const char*>(&bad_docid), sizeof(bad_docid));
+    }
+    {
+        AttributeManagerFixture amf(f);
+        EXPECT_FALSE(amf._m.addAttribute({"a14", cfg}, createSerialNum));
+    }
+    // A truncated file fails the load instead of aborting
+    fs::resize_file(fs::path(delta_file_name), fs::file_size(fs::path(delta_file_name)) - 1);
+    {
+        AttributeManagerFixture amf(f);
+        EXPECT_FALSE(amf._m.addAttribute({"a14", cfg}, createSerialNum));
+    }
+}
+
 } // namespace proton
 
 int main(int argc, char* argv[]) {
@@ -94,6 +94,10 @@ struct ViewPtrs {
 
 ViewPtrs::~ViewPtrs() = default;
 
+struct MyGetSerialNum : public IGetSerialNum {
+    SerialNum getSerialNum() const override { return 0u; }
+};
+
 struct ViewSet {
     IndexManagerDummyReconfigurer                  _reconfigurer;
     DummyFileHeaderContext                         _fileHeaderContext;
@@ -102,6 +106,7 @@ struct ViewSet {
     std::shared_ptr<const DocumentTypeRepo>        repo;
     DocTypeName                                    _docTypeName;
     DocIdLimit                                     _docIdLimit;
+    MyGetSerialNum                                 _getSerialNum;
     search::transactionlog::NoSyncProxy            _noTlSyncer;
     ISummaryManager::SP                            _summaryMgr;
     proton::IDocumentMetaStoreContext::SP          _dmsc;
@@ -128,6 +133,7 @@ ViewSet::ViewSet()
       repo(createRepo()),
       _docTypeName(DOC_TYPE),
       _docIdLimit(0u),
+      _getSerialNum(),
       _noTlSyncer(),
       _summaryMgr(),
       _dmsc(),
@@ -221,8 +227,8 @@ void Fixture::initViewSet(ViewSet& views) {
     views._summaryMgr = summaryMgr;
     views._dmsc = metaStore;
     IndexSearchable::SP indexSearchable;
-    auto                matchView =
-        std::make_shared<MatchView>(matchers, indexSearchable, attrMgr, _sessionMgr, metaStore, views._docIdLimit);
+    auto                matchView = std::make_shared<MatchView>(matchers, indexSearchable, attrMgr, _sessionMgr, metaStore,
+                                                                views._docIdLimit, views._getSerialNum);
     views.searchView.set(SearchView::create(
         summaryMgr->createSummarySetup(SummaryConfig(), JuniperrcConfig(), views.repo, attrMgr, *schema),
         std::move(matchView)));
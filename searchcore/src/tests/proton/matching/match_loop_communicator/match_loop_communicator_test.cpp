@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cmath>
 
 using namespace proton::matching;
 
@@ -346,4 +347,30 @@ TEST(MatchLoopCommunicatorTest, require_that_before_second_phase_is_called_once)
     EXPECT_EQ(1, cnt.load(std::memory_order_acquire));
 }
 
+TEST(MatchLoopCommunicatorTest, require_that_first_phase_score_threshold_is_the_highest_published_score) {
+    MatchLoopCommunicator f1(1, 3);
+    EXPECT_EQ(-HUGE_VAL, f1.first_phase_score_threshold().get());
+    f1.raise_first_phase_score_threshold(2.0);
+    EXPECT_EQ(2.0, f1.first_phase_score_threshold().get());
+    f1.raise_first_phase_score_threshold(1.0);
+    EXPECT_EQ(2.0, f1.first_phase_score_threshold().get());
+    f1.raise_first_phase_score_threshold(3.0);
+    EXPECT_EQ(3.0, f1.first_phase_score_threshold().get());
+    f1.raise_first_phase_score_threshold(-HUGE_VAL);
+    EXPECT_EQ(3.0, f1.first_phase_score_threshold().get());
+}
+
+TEST(MatchLoopCommunicatorTest, require_that_first_phase_score_threshold_is_shared_across_threads) {
+    constexpr size_t      num_threads = 8;
+    MatchLoopCommunicator f1(num_threads, 3);
+    auto                  task = [&f1](Nexus& ctx) {
+        auto thread_id = ctx.thread_id();
+        for (size_t i = 0; i < 1000; ++i) {
+            f1.raise_first_phase_score_threshold(double(i * num_threads + thread_id));
+        }
+    };
+    Nexus::run(num_threads, task);
+    EXPECT_EQ(double(999 * num_threads + num_threads - 1), f1.first_phase_score_threshold().get());
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
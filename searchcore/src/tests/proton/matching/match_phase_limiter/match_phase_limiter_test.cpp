@@ -542,4 +542,32 @@ TEST(MatchPhaseLimiterTest, require_that_range_term_is_used_to_adjust_limiter) {
     verifyRangeIsReflectedInLimiter("7.7", "100.3", f.f1FieldSpec, f);
 }
 
+TEST(MatchPhaseLimiterTest, require_that_degradation_params_can_be_derived_from_sort_spec) {
+    search::attribute::test::MockAttributeManager attrManager;
+    Config                                        fast_search(BasicType::INT64);
+    fast_search.setFastSearch(true);
+    attrManager.addAttribute(search::AttributeFactory::createAttribute("fast", fast_search));
+    attrManager.addAttribute(search::AttributeFactory::createAttribute("slow", Config(BasicType::INT64)));
+    Config fast_double(BasicType::DOUBLE);
+    fast_double.setFastSearch(true);
+    attrManager.addAttribute(search::AttributeFactory::createAttribute("double", fast_double));
+    auto              attributes = attrManager.createContext();
+    DegradationParams defaults("", 0, true, 0.2, 0.1, 1.0);
+    auto              params = DegradationParams::from_sort_spec("-fast +slow", 50, *attributes, defaults);
+    EXPECT_TRUE(params.enabled());
+    EXPECT_EQ("fast", params.attribute);
+    EXPECT_EQ(50u, params.max_hits);
+    EXPECT_TRUE(params.descending);
+    EXPECT_EQ(0.2, params.max_filter_coverage);
+    params = DegradationParams::from_sort_spec("+fast", 50, *attributes, defaults);
+    EXPECT_TRUE(params.enabled());
+    EXPECT_FALSE(params.descending);
+    EXPECT_FALSE(DegradationParams::from_sort_spec("+slow -fast", 50, *attributes, defaults).enabled());
+    EXPECT_FALSE(DegradationParams::from_sort_spec("+double", 50, *attributes, defaults).enabled());
+    EXPECT_FALSE(DegradationParams::from_sort_spec("+unknown", 50, *attributes, defaults).enabled());
+    EXPECT_FALSE(DegradationParams::from_sort_spec("+lowercase(fast)", 50, *attributes, defaults).enabled());
+    EXPECT_FALSE(DegradationParams::from_sort_spec("-[rank]", 50, *attributes, defaults).enabled());
+    EXPECT_FALSE(DegradationParams::from_sort_spec("", 50, *attributes, defaults).enabled());
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -18,6 +18,7 @@ TEST(MatchingStatsTest, requireThatDocCountsAddUp) {
     EXPECT_EQ(0u, stats.approximate_nns_timed_out_queries());
     EXPECT_EQ(0u, stats.queries());
     EXPECT_EQ(0u, stats.limited_queries());
+    EXPECT_EQ(0u, stats.profiled_queries());
     {
         MatchingStats rhs;
         EXPECT_EQ(&rhs.docidSpaceCovered(10000), &rhs);
@@ -30,6 +31,7 @@ TEST(MatchingStatsTest, requireThatDocCountsAddUp) {
         EXPECT_EQ(&rhs.approximate_nns_timed_out_queries(23), &rhs);
         EXPECT_EQ(&rhs.queries(2), &rhs);
         EXPECT_EQ(&rhs.limited_queries(1), &rhs);
+        EXPECT_EQ(&rhs.profiled_queries(1), &rhs);
         EXPECT_EQ(&stats.add(rhs), &stats);
     }
     EXPECT_EQ(10000u, stats.docidSpaceCovered());
@@ -42,6 +44,7 @@ TEST(MatchingStatsTest, requireThatDocCountsAddUp) {
     EXPECT_EQ(23u, stats.approximate_nns_timed_out_queries());
     EXPECT_EQ(2u, stats.queries());
     EXPECT_EQ(1u, stats.limited_queries());
+    EXPECT_EQ(1u, stats.profiled_queries());
     EXPECT_EQ(&stats.add(MatchingStats()
                              .docidSpaceCovered(10000)
                              .docsMatched(1000)
@@ -52,7 +55,8 @@ TEST(MatchingStatsTest, requireThatDocCountsAddUp) {
                              .approximate_nns_nodes_visited(13)
                              .approximate_nns_timed_out_queries(14)
                              .queries(2)
-                             .limited_queries(1)),
+                             .limited_queries(1)
+                             .profiled_queries(1)),
               &stats);
     EXPECT_EQ(20000u, stats.docidSpaceCovered());
     EXPECT_EQ(2000u, stats.docsMatched());
@@ -64,6 +68,7 @@ TEST(MatchingStatsTest, requireThatDocCountsAddUp) {
     EXPECT_EQ(37u, stats.approximate_nns_timed_out_queries());
     EXPECT_EQ(4u, stats.queries());
     EXPECT_EQ(2u, stats.limited_queries());
+    EXPECT_EQ(2u, stats.profiled_queries());
 }
 
 TEST(MatchingStatsTest, requireThatAverageTimesAreRecorded) {
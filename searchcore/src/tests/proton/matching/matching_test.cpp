@@ -4,6 +4,7 @@
 #include <vespa/eval/eval/simple_value.h>
 #include <vespa/eval/eval/tensor_spec.h>
 #include <vespa/eval/eval/value_codec.h>
+#include <vespa/searchcommon/attribute/config.h>
 #include <vespa/searchcore/proton/bucketdb/bucket_db_owner.h>
 #include <vespa/searchcore/proton/documentmetastore/documentmetastore.h>
 #include <vespa/searchcore/proton/matching/fakesearchcontext.h>
@@ -17,7 +18,9 @@
 #include <vespa/searchlib/aggregation/aggregation.h>
 #include <vespa/searchlib/aggregation/grouping.h>
 #include <vespa/searchlib/aggregation/perdocexpression.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
 #include <vespa/searchlib/attribute/extendableattributes.h>
+#include <vespa/searchlib/attribute/integerbase.h>
 #include <vespa/searchlib/engine/docsumreply.h>
 #include <vespa/searchlib/engine/docsumrequest.h>
 #include <vespa/searchlib/engine/searchreply.h>
@@ -131,6 +134,18 @@ IAttributeContext& MatchingTestSharedState::attribute_context() {
             assert(docid + 1 == NUM_DOCS);
             _attribute_context->add(attr);
         }
+        {
+            search::attribute::Config cfg(BasicType::INT32);
+            cfg.setFastSearch(true);
+            auto attr = AttributeFactory::createAttribute("a4", cfg);
+            attr->addDocs(NUM_DOCS);
+            auto& int_attr = dynamic_cast<IntegerAttribute&>(*attr);
+            for (uint32_t i = 1; i < NUM_DOCS; ++i) {
+                int_attr.update(i, i); // value = docid
+            }
+            attr->commit();
+            _attribute_context->add(attr);
+        }
     }
     return *_attribute_context;
 }
@@ -499,7 +514,7 @@ struct MyWorld {
         search::queryeval::QuerySetupStats setup_stats;
         auto                               mtf =
             matcher->create_match_tools_factory(req, searchContext, attributeContext, metaStore, overrides, ttb(),
-                                                nullptr, setup_stats, searchContext.getDocIdLimit(), true);
+                                                nullptr, setup_stats, searchContext.getDocIdLimit(), "", 0, true);
         auto diversity = mtf->createDiversifier(HeapSize::lookup(config));
         EXPECT_EQ(expectDiverse, static_cast<bool>(diversity));
     }
@@ -511,21 +526,27 @@ struct MyWorld {
         search::queryeval::QuerySetupStats setup_stats;
         auto                               mtf =
             matcher->create_match_tools_factory(*request, searchContext, attributeContext, metaStore, overrides,
-                                                ttb(), nullptr, setup_stats, searchContext.getDocIdLimit(), true);
+                                                ttb(), nullptr, setup_stats, searchContext.getDocIdLimit(), "", 0,
+                                                true);
         MatchTools::UP match_tools = mtf->createMatchTools();
         match_tools->setup_first_phase(nullptr);
         return match_tools->match_data().get_termwise_limit();
     }
 
     SearchReply::UP performSearch(const SearchRequest& req, size_t threads) {
-        Matcher::SP                    matcher = createMatcher();
+        return performSearch(createMatcher(), req, threads, 0);
+    }
+
+    SearchReply::UP performSearch(const Matcher::SP& matcher, const SearchRequest& req, size_t threads,
+                                  search::SerialNum serial_num) {
         SearchSession::OwnershipBundle owned_objects(
             {std::make_unique<MockAttributeContext>(), std::make_unique<FakeSearchContext>()},
             std::make_shared<MySearchHandler>(matcher));
         assert(threads <= MatchingTestSharedState::max_threads);
         vespalib::LimitedThreadBundleWrapper threadBundle(shared_state.thread_bundle(), threads);
         SearchReply::UP reply = matcher->match(req, threadBundle, searchContext, attributeContext, *sessionManager,
-                                               metaStore, metaStore.getBucketDB(), std::move(owned_objects));
+                                               metaStore, metaStore.getBucketDB(), serial_num,
+                                               std::move(owned_objects));
         matchingStats.add(matcher->getStats());
         return reply;
     }
@@ -842,6 +863,30 @@ TEST_F(MatchingTest, require_that_ranking_is_performed_with_multi_threaded_match
     }
 }
 
+TEST_F(MatchingTest, require_that_shared_first_phase_score_threshold_keeps_best_hits_with_multi_threaded_matcher) {
+    for (size_t threads = 1; threads <= 16; ++threads) {
+        MyWorld plain(shared_state());
+        plain.basicSetup(10, 10);
+        plain.verbose_a1_result("all");
+        MyWorld shared(shared_state());
+        shared.basicSetup(10, 10);
+        shared.verbose_a1_result("all");
+        shared.set_property(indexproperties::hitcollector::ShareFirstPhaseScoreThreshold::NAME, "true");
+        SearchRequest::SP request = MyWorld::createSimpleRequest("a1", "all");
+        SearchReply::UP   expect = plain.performSearch(*request, threads);
+        SearchReply::UP   reply = shared.performSearch(*request, threads);
+        EXPECT_EQ(985u, shared.matchingStats.docsMatched());
+        // no iterator in this query skips documents using the threshold
+        EXPECT_EQ(expect->totalHitCount, reply->totalHitCount);
+        ASSERT_EQ(10u, reply->hits.size());
+        ASSERT_EQ(expect->hits.size(), reply->hits.size());
+        for (size_t i = 0; i < reply->hits.size(); ++i) {
+            EXPECT_EQ(expect->hits[i].gid, reply->hits[i].gid);
+            EXPECT_EQ(expect->hits[i].metric, reply->hits[i].metric);
+        }
+    }
+}
+
 TEST_F(MatchingTest, require_that_reranking_is_performed_with_multi_threaded_matcher) {
     for (size_t threads = 1; threads <= 16; ++threads) {
         MyWorld world(shared_state());
@@ -1085,6 +1130,88 @@ TEST_F(MatchingTest, require_that_search_session_can_be_cached) {
     EXPECT_EQ("a", session->getSessionId());
 }
 
+TEST_F(MatchingTest, require_that_result_cache_is_disabled_by_default) {
+    MyWorld world(shared_state());
+    world.basicSetup();
+    EXPECT_EQ(nullptr, world.createMatcher()->get_result_cache());
+}
+
+TEST_F(MatchingTest, require_that_repeated_query_is_answered_from_result_cache) {
+    MyWorld world(shared_state());
+    world.basicSetup();
+    world.basicResults();
+    world.set_property(indexproperties::matching::ResultCacheSize::NAME, "10");
+    Matcher::SP matcher = world.createMatcher();
+    ASSERT_NE(nullptr, matcher->get_result_cache());
+    SearchRequest::SP request = MyWorld::createSimpleRequest("f1", "spread");
+    SearchReply::UP   first = world.performSearch(matcher, *request, 1, 5);
+    SearchReply::UP   second = world.performSearch(matcher, *request, 1, 5);
+    ASSERT_EQ(9u, first->hits.size());
+    ASSERT_EQ(first->hits.size(), second->hits.size());
+    for (size_t i = 0; i < first->hits.size(); ++i) {
+        EXPECT_EQ(first->hits[i].gid, second->hits[i].gid);
+        EXPECT_EQ(first->hits[i].metric, second->hits[i].metric);
+    }
+    EXPECT_EQ(first->totalHitCount, second->totalHitCount);
+    EXPECT_EQ(first->coverage.getCovered(), second->coverage.getCovered());
+    EXPECT_EQ(9u, world.matchingStats.docsMatched());
+    EXPECT_EQ(2u, world.matchingStats.queries());
+    auto stats = matcher->get_result_cache()->get_stats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_EQ(1u, stats.inserts);
+}
+
+TEST_F(MatchingTest, require_that_result_cache_is_invalidated_by_feed_serial_number) {
+    MyWorld world(shared_state());
+    world.basicSetup();
+    world.basicResults();
+    world.set_property(indexproperties::matching::ResultCacheSize::NAME, "10");
+    Matcher::SP       matcher = world.createMatcher();
+    SearchRequest::SP request = MyWorld::createSimpleRequest("f1", "spread");
+    world.performSearch(matcher, *request, 1, 5);
+    world.performSearch(matcher, *request, 1, 6);
+    EXPECT_EQ(18u, world.matchingStats.docsMatched());
+    auto stats = matcher->get_result_cache()->get_stats();
+    EXPECT_EQ(0u, stats.hits);
+    EXPECT_EQ(1u, stats.invalidated);
+    EXPECT_EQ(2u, stats.inserts);
+}
+
+TEST_F(MatchingTest, require_that_result_cache_key_depends_on_request) {
+    MyWorld world(shared_state());
+    world.basicSetup();
+    world.basicResults();
+    world.set_property(indexproperties::matching::ResultCacheSize::NAME, "10");
+    Matcher::SP       matcher = world.createMatcher();
+    SearchRequest::SP request = MyWorld::createSimpleRequest("f1", "spread");
+    world.performSearch(matcher, *request, 1, 5);
+    request->maxhits = 5;
+    EXPECT_EQ(5u, world.performSearch(matcher, *request, 1, 5)->hits.size());
+    request->propertiesMap.lookupCreate(search::MapNames::RANK).add("foo", "bar");
+    world.performSearch(matcher, *request, 1, 5);
+    world.performSearch(matcher, *MyWorld::createSimpleRequest("f1", "foo"), 1, 5);
+    auto stats = matcher->get_result_cache()->get_stats();
+    EXPECT_EQ(0u, stats.hits);
+    EXPECT_EQ(4u, matcher->get_result_cache()->size());
+}
+
+TEST_F(MatchingTest, require_that_session_and_trace_requests_bypass_result_cache) {
+    MyWorld world(shared_state());
+    world.basicSetup();
+    world.basicResults();
+    world.set_property(indexproperties::matching::ResultCacheSize::NAME, "10");
+    Matcher::SP       matcher = world.createMatcher();
+    SearchRequest::SP request = MyWorld::createSimpleRequest("f1", "spread");
+    request->sessionId.push_back('a');
+    world.performSearch(matcher, *request, 1, 5);
+    request->sessionId.clear();
+    request->setTraceLevel(1, 1);
+    world.performSearch(matcher, *request, 1, 5);
+    auto stats = matcher->get_result_cache()->get_stats();
+    EXPECT_EQ(0u, stats.hits + stats.misses + stats.inserts);
+}
+
 TEST_F(MatchingTest, require_that_summary_features_can_be_renamed) {
     MyWorld world(shared_state());
     world.basicSetup();
@@ -1189,7 +1316,7 @@ TEST_F(MatchingTest, require_that_getSummaryFeatures_prefers_cached_query_setup)
 }
 
 TEST_F(MatchingTest, require_that_match_params_are_set_up_straight_with_ranking_on) {
-    MatchParams p(10, 2, 4, 0.7, 0.75, 0, 1, true, true);
+    MatchParams p(10, 2, 4, 0.7, 0.75, 0, 1, true, true, false);
     ASSERT_EQ(10u, p.numDocs);
     ASSERT_EQ(2u, p.heapSize);
     ASSERT_EQ(4u, p.arraySize);
@@ -1200,7 +1327,7 @@ TEST_F(MatchingTest, require_that_match_params_are_set_up_straight_with_ranking_
 }
 
 TEST_F(MatchingTest, require_that_match_params_can_turn_off_rank_score_drop_limits) {
-    MatchParams p(10, 2, 4, std::nullopt, std::nullopt, 0, 1, true, true);
+    MatchParams p(10, 2, 4, std::nullopt, std::nullopt, 0, 1, true, true, false);
     ASSERT_EQ(10u, p.numDocs);
     ASSERT_EQ(2u, p.heapSize);
     ASSERT_EQ(4u, p.arraySize);
@@ -1212,7 +1339,7 @@ TEST_F(MatchingTest, require_that_match_params_can_turn_off_rank_score_drop_limi
 
 TEST_F(MatchingTest,
        require_that_match_params_are_set_up_straight_with_ranking_on_arraySize_is_atleast_the_size_of_heapSize) {
-    MatchParams p(10, 6, 4, 0.7, std::nullopt, 1, 1, true, true);
+    MatchParams p(10, 6, 4, 0.7, std::nullopt, 1, 1, true, true, false);
     ASSERT_EQ(10u, p.numDocs);
     ASSERT_EQ(6u, p.heapSize);
     ASSERT_EQ(6u, p.arraySize);
@@ -1225,7 +1352,7 @@ TEST_F(MatchingTest,
 TEST_F(
     MatchingTest,
     require_that_match_params_are_set_up_straight_with_ranking_on_arraySize_is_atleast_the_size_of_hits_plus_offset) {
-    MatchParams p(10, 6, 4, 0.7, std::nullopt, 4, 4, true, true);
+    MatchParams p(10, 6, 4, 0.7, std::nullopt, 4, 4, true, true, false);
     ASSERT_EQ(10u, p.numDocs);
     ASSERT_EQ(6u, p.heapSize);
     ASSERT_EQ(8u, p.arraySize);
@@ -1235,7 +1362,7 @@ TEST_F(
 }
 
 TEST_F(MatchingTest, require_that_match_params_are_capped_by_numDocs) {
-    MatchParams p(1, 6, 4, 0.7, std::nullopt, 4, 4, true, true);
+    MatchParams p(1, 6, 4, 0.7, std::nullopt, 4, 4, true, true, false);
     ASSERT_EQ(1u, p.numDocs);
     ASSERT_EQ(1u, p.heapSize);
     ASSERT_EQ(1u, p.arraySize);
@@ -1245,7 +1372,7 @@ TEST_F(MatchingTest, require_that_match_params_are_capped_by_numDocs) {
 }
 
 TEST_F(MatchingTest, require_that_match_params_are_capped_by_numDocs_and_hits_adjusted_down) {
-    MatchParams p(5, 6, 4, 0.7, std::nullopt, 4, 4, true, true);
+    MatchParams p(5, 6, 4, 0.7, std::nullopt, 4, 4, true, true, false);
     ASSERT_EQ(5u, p.numDocs);
     ASSERT_EQ(5u, p.heapSize);
     ASSERT_EQ(5u, p.arraySize);
@@ -1255,7 +1382,7 @@ TEST_F(MatchingTest, require_that_match_params_are_capped_by_numDocs_and_hits_ad
 }
 
 TEST_F(MatchingTest, require_that_match_params_are_set_up_straight_with_ranking_off_array_and_heap_size_is_0) {
-    MatchParams p(10, 6, 4, 0.7, std::nullopt, 4, 4, true, false);
+    MatchParams p(10, 6, 4, 0.7, std::nullopt, 4, 4, true, false, false);
     ASSERT_EQ(10u, p.numDocs);
     ASSERT_EQ(0u, p.heapSize);
     ASSERT_EQ(0u, p.arraySize);
@@ -1264,6 +1391,15 @@ TEST_F(MatchingTest, require_that_match_params_are_set_up_straight_with_ranking_
     ASSERT_EQ(4u, p.hits);
 }
 
+TEST_F(MatchingTest, require_that_shared_first_phase_score_threshold_needs_rank_scores) {
+    EXPECT_TRUE(MatchParams(10, 2, 4, std::nullopt, std::nullopt, 0, 1, true, true, true)
+                    .share_first_phase_score_threshold);
+    EXPECT_FALSE(MatchParams(10, 2, 4, std::nullopt, std::nullopt, 0, 1, true, true, false)
+                     .share_first_phase_score_threshold);
+    EXPECT_FALSE(MatchParams(10, 2, 4, std::nullopt, std::nullopt, 0, 1, true, false, true)
+                     .share_first_phase_score_threshold);
+}
+
 TEST_F(MatchingTest, require_that_match_phase_limiting_works) {
     for (int s = 0; s <= 1; ++s) {
         for (int i = 0; i <= 6; ++i) {
@@ -1325,6 +1461,52 @@ TEST_F(MatchingTest, require_that_match_phase_limiting_works) {
     }
 }
 
+TEST_F(MatchingTest, require_that_sort_order_can_drive_match_phase_limiting) {
+    auto expect_gid = [](uint32_t docid) {
+        return document::DocumentId(vespalib::make_string("id:ns:searchdocument::%u", docid)).getGlobalId();
+    };
+    for (int i = 0; i <= 2; ++i) {
+        bool    enable = (i != 0);
+        bool    use_grouping = (i == 2);
+        MyWorld world(shared_state());
+        world.basicSetup();
+        world.verbose_a1_result("all");
+        world.add_match_phase_limiting_result("a4", 128, true, {948, 951, 963, 987, 991, 994, 997});
+        if (enable) {
+            world.set_property(DegradationSortOrder::NAME, "true");
+        }
+        SearchRequest::SP request = MyWorld::createSimpleRequest("a1", "all");
+        request->sortSpec = "-a4";
+        if (use_grouping) {
+            vespalib::nbostream     buf;
+            vespalib::NBOSerializer os(buf);
+            uint32_t                n = 1;
+            os << n;
+            Grouping grequest;
+            grequest.setRoot(Group().addResult(SumAggregationResult().setExpression(createAttr())));
+            grequest.serialize(os);
+            request->groupSpec.assign(buf.data(), buf.data() + buf.size());
+        }
+        SearchReply::UP reply = world.performSearch(*request, 75);
+        ASSERT_EQ(10u, reply->hits.size());
+        if (enable && !use_grouping) {
+            EXPECT_TRUE(reply->coverage.wasDegradedByMatchPhase());
+            EXPECT_GT(985u, reply->totalHitCount);
+            EXPECT_EQ(expect_gid(997), reply->hits[0].gid);
+            EXPECT_EQ(expect_gid(994), reply->hits[1].gid);
+            EXPECT_EQ(expect_gid(991), reply->hits[2].gid);
+            EXPECT_EQ(expect_gid(987), reply->hits[3].gid);
+        } else {
+            EXPECT_FALSE(reply->coverage.wasDegradedByMatchPhase());
+            EXPECT_EQ(985u, reply->totalHitCount);
+            EXPECT_EQ(expect_gid(999), reply->hits[0].gid);
+            EXPECT_EQ(expect_gid(998), reply->hits[1].gid);
+            EXPECT_EQ(expect_gid(997), reply->hits[2].gid);
+            EXPECT_EQ(expect_gid(996), reply->hits[3].gid);
+        }
+    }
+}
+
 TEST_F(MatchingTest, require_that_arithmetic_used_for_rank_drop_limit_works) {
     double small = -HUGE_VAL;
     double limit = -std::numeric_limits<feature_t>::quiet_NaN();
@@ -0,0 +1,114 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcore/proton/matching/profile_samples.h>
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+#include <tuple>
+#include <vector>
+
+using namespace proton::matching;
+using vespalib::Slime;
+using vespalib::slime::Cursor;
+
+namespace {
+
+void make_report(Cursor& obj, double total_ms, const std::vector<std::tuple<std::string, int64_t, double>>& roots) {
+    obj.setString("profiler", "flat");
+    obj.setLong("topn", 32);
+    obj.setDouble("total_time_ms", total_ms);
+    Cursor& arr = obj.setArray("roots");
+    for (const auto& [name, count, self_ms] : roots) {
+        Cursor& root = arr.addObject();
+        root.setString("name", name);
+        root.setLong("count", count);
+        root.setDouble("self_time_ms", self_ms);
+    }
+}
+
+ProfileSamples::Query make_query(double seek_ms, double unpack_ms) {
+    ProfileSamples::Query query;
+    for (size_t thread = 0; thread < 2; ++thread) {
+        Slime slime;
+        make_report(slime.setObject(), seek_ms + unpack_ms, {{"seek", 10, seek_ms}, {"unpack", 5, unpack_ms}});
+        query.add_report("match", slime.get());
+    }
+    return query;
+}
+
+} // namespace
+
+TEST(ProfileSamplesTest, time_is_mapped_to_power_of_two_microsecond_buckets) {
+    EXPECT_EQ(0u, ProfileSamples::bucket_of(0.0));
+    EXPECT_EQ(0u, ProfileSamples::bucket_of(0.0009));
+    EXPECT_EQ(1u, ProfileSamples::bucket_of(0.001));
+    EXPECT_EQ(2u, ProfileSamples::bucket_of(0.002));
+    EXPECT_EQ(2u, ProfileSamples::bucket_of(0.0039));
+    EXPECT_EQ(3u, ProfileSamples::bucket_of(0.004));
+    EXPECT_EQ(11u, ProfileSamples::bucket_of(1.5));
+    EXPECT_EQ(ProfileSamples::num_buckets - 1, ProfileSamples::bucket_of(1e9));
+}
+
+TEST(ProfileSamplesTest, query_reports_are_summed_over_threads) {
+    ProfileSamples samples;
+    samples.add(make_query(1.0, 0.25));
+    EXPECT_EQ(1u, samples.queries());
+    const auto* seek = samples.lookup("match", "seek");
+    ASSERT_TRUE(seek != nullptr);
+    EXPECT_EQ(1u, seek->queries);
+    EXPECT_EQ(20u, seek->count);
+    EXPECT_DOUBLE_EQ(2.0, seek->time_ms);
+    EXPECT_EQ(1u, seek->histogram[ProfileSamples::bucket_of(2.0)]);
+    const auto* total = samples.lookup("match", ProfileSamples::phase_total);
+    ASSERT_TRUE(total != nullptr);
+    EXPECT_DOUBLE_EQ(2.5, total->time_ms);
+    EXPECT_TRUE(samples.lookup("match", "unknown") == nullptr);
+    EXPECT_TRUE(samples.lookup("first_phase", "seek") == nullptr);
+}
+
+TEST(ProfileSamplesTest, missing_reports_are_ignored) {
+    ProfileSamples::Query query;
+    Slime slime;
+    query.add_report("first_phase", slime.get());
+    ProfileSamples samples;
+    samples.add(query);
+    EXPECT_EQ(1u, samples.queries());
+    EXPECT_TRUE(samples.lookup("first_phase", ProfileSamples::phase_total) == nullptr);
+}
+
+TEST(ProfileSamplesTest, samples_can_be_merged) {
+    ProfileSamples a;
+    ProfileSamples b;
+    a.add(make_query(1.0, 0.25));
+    b.add(make_query(0.001, 0.25));
+    b.add(make_query(1.0, 0.25));
+    a.merge(b);
+    EXPECT_EQ(3u, a.queries());
+    const auto* seek = a.lookup("match", "seek");
+    ASSERT_TRUE(seek != nullptr);
+    EXPECT_EQ(3u, seek->queries);
+    EXPECT_EQ(60u, seek->count);
+    EXPECT_EQ(2u, seek->histogram[ProfileSamples::bucket_of(2.0)]);
+    EXPECT_EQ(1u, seek->histogram[ProfileSamples::bucket_of(0.002)]);
+}
+
+TEST(ProfileSamplesTest, samples_are_converted_to_slime) {
+    ProfileSamples samples;
+    samples.add(make_query(0.001, 0.0));
+    Slime slime;
+    samples.to_slime(slime.setObject());
+    const auto& root = slime.get();
+    EXPECT_EQ(1, root["queries"].asLong());
+    const auto& seek = root["phases"]["match"]["seek"];
+    EXPECT_EQ(1, seek["queries"].asLong());
+    EXPECT_EQ(20, seek["count"].asLong());
+    EXPECT_DOUBLE_EQ(0.002, seek["time_ms"].asDouble());
+    // trailing empty buckets are not reported
+    ASSERT_EQ(3u, seek["histogram_us"].entries());
+    EXPECT_EQ(0, seek["histogram_us"][0].asLong());
+    EXPECT_EQ(0, seek["histogram_us"][1].asLong());
+    EXPECT_EQ(1, seek["histogram_us"][2].asLong());
+    EXPECT_EQ(1u, root["phases"]["match"]["unpack"]["histogram_us"].entries());
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
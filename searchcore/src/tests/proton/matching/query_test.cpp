@@ -642,6 +642,89 @@ TEST(QueryTest, requireThatQueryGluesEverythingTogether) {
     ASSERT_TRUE(search);
 }
 
+using EqualityFilters = std::vector<std::pair<std::string, int64_t>>;
+
+EqualityFilters nearest_neighbor_equality_filters(QueryBuilder<ProtonNodeTypes>& builder) {
+    auto  serializedQueryTree = StackDumpCreator::createSerializedQueryTree(*builder.build());
+    Query query;
+    query.buildTree(*serializedQueryTree, "", ViewResolver(), plain_index_env);
+    vector<const ITermData*> term_data;
+    query.extractTerms(term_data);
+    for (const auto* data : term_data) {
+        if (auto* nn_term = dynamic_cast<const search::query::NearestNeighborTerm*>(data)) {
+            return nn_term->get_equality_filters();
+        }
+    }
+    ADD_FAILURE() << "No nearest neighbor term found";
+    return {};
+}
+
+void add_nearest_neighbor_term(QueryBuilder<ProtonNodeTypes>& builder) {
+    builder.add_nearest_neighbor_term("query_tensor", "tensor", 3, Weight(1), 10, true);
+}
+
+TEST(QueryTest, nearest_neighbor_term_is_annotated_with_sibling_equality_filters) {
+    QueryBuilder<ProtonNodeTypes> builder;
+    builder.addAnd(3);
+    builder.addNumberTerm("10", "tenant", 1, Weight(0));
+    add_nearest_neighbor_term(builder);
+    builder.addNumberTerm("[1;5]", "year", 2, Weight(0));
+    EXPECT_EQ((EqualityFilters{{"tenant", 10}}), nearest_neighbor_equality_filters(builder));
+}
+
+TEST(QueryTest, nearest_neighbor_term_inherits_equality_filters_from_enclosing_and) {
+    QueryBuilder<ProtonNodeTypes> builder;
+    builder.addAnd(2);
+    builder.addNumberTerm("-10", "tenant", 1, Weight(0));
+    builder.addAnd(2);
+    builder.addNumberTerm("3", "category", 2, Weight(0));
+    add_nearest_neighbor_term(builder);
+    EXPECT_EQ((EqualityFilters{{"tenant", -10}, {"category", 3}}), nearest_neighbor_equality_filters(builder));
+}
+
+TEST(QueryTest, nearest_neighbor_term_inherits_equality_filters_through_first_child_of_rank_and_andnot) {
+    QueryBuilder<ProtonNodeTypes> builder;
+    builder.addRank(2);
+    builder.addAndNot(2);
+    builder.addAnd(2);
+    builder.addNumberTerm("10", "tenant", 1, Weight(0));
+    add_nearest_neighbor_term(builder);
+    builder.addNumberTerm("11", "tenant", 2, Weight(0));
+    builder.addStringTerm(string_term, field, 4, Weight(1));
+    EXPECT_EQ((EqualityFilters{{"tenant", 10}}), nearest_neighbor_equality_filters(builder));
+}
+
+TEST(QueryTest, nearest_neighbor_term_is_not_annotated_with_filters_that_not_all_hits_satisfy) {
+    {
+        QueryBuilder<ProtonNodeTypes> builder;
+        builder.addOr(2);
+        builder.addNumberTerm("10", "tenant", 1, Weight(0));
+        add_nearest_neighbor_term(builder);
+        EXPECT_EQ(EqualityFilters(), nearest_neighbor_equality_filters(builder));
+    }
+    {
+        QueryBuilder<ProtonNodeTypes> builder;
+        builder.addAnd(2);
+        builder.addNumberTerm("10", "tenant", 1, Weight(0));
+        builder.addOr(2);
+        add_nearest_neighbor_term(builder);
+        builder.addStringTerm(string_term, field, 4, Weight(1));
+        EXPECT_EQ(EqualityFilters(), nearest_neighbor_equality_filters(builder));
+    }
+}
+
+TEST(QueryTest, nearest_neighbor_term_in_rank_only_child_uses_filters_of_its_own_and) {
+    QueryBuilder<ProtonNodeTypes> builder;
+    builder.addRank(2);
+    builder.addAnd(2);
+    builder.addNumberTerm("11", "tenant", 1, Weight(0));
+    builder.addStringTerm(string_term, field, 4, Weight(1));
+    builder.addAnd(2);
+    builder.addNumberTerm("10", "tenant", 2, Weight(0));
+    add_nearest_neighbor_term(builder);
+    EXPECT_EQ((EqualityFilters{{"tenant", 10}}), nearest_neighbor_equality_filters(builder));
+}
+
 void checkQueryAddsLocation(const string& loc_in, const string& loc_out) {
     fef_test::IndexEnvironment index_environment;
     index_environment.addField(FieldType::INDEX, CollectionType::SINGLE, field);
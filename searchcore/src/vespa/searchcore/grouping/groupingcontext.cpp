@@ -2,6 +2,7 @@
 
 #include "groupingcontext.h"
 
+#include <vespa/searchlib/aggregation/columnar_grouper.h>
 #include <vespa/searchlib/aggregation/hitsaggregationresult.h>
 #include <vespa/searchlib/aggregation/predicates.h>
 #include <vespa/searchlib/common/bitvector.h>
@@ -11,6 +12,7 @@ LOG_SETUP(".searchcore/grouping.groupingcontext");
 
 namespace search::grouping {
 
+using aggregation::ColumnarGrouper;
 using aggregation::CountFS4Hits;
 using aggregation::FS4HitSetDistributionKey;
 
@@ -81,47 +83,56 @@ bool GroupingContext::needRanking() const noexcept {
     return true;
 }
 
-void GroupingContext::aggregate(Grouping& grouping, uint32_t docId, HitRank rank) const {
+void GroupingContext::aggregate(Grouping& grouping, ColumnarGrouper* columnar, uint32_t docId, HitRank rank) const {
     if (_validLids.testBit(docId)) {
-        grouping.aggregate(docId, rank);
+        if (columnar != nullptr) {
+            columnar->aggregate(docId, rank);
+        } else {
+            grouping.aggregate(docId, rank);
+        }
     }
 }
 
-unsigned int GroupingContext::aggregateRanked(Grouping& grouping, const RankedHit* rankedHit,
-                                              unsigned int len) const {
+unsigned int GroupingContext::aggregateRanked(Grouping& grouping, ColumnarGrouper* columnar,
+                                              const RankedHit* rankedHit, unsigned int len) const {
     unsigned int i(0);
     for (; (i < len) && !hasExpired(); i++) {
-        aggregate(grouping, rankedHit[i].getDocId(), rankedHit[i].getRank());
+        aggregate(grouping, columnar, rankedHit[i].getDocId(), rankedHit[i].getRank());
     }
     return i;
 }
 
-void GroupingContext::aggregate(Grouping& grouping, const BitVector* bVec, unsigned int lidLimit) const {
+void GroupingContext::aggregate(Grouping& grouping, ColumnarGrouper* columnar, const BitVector* bVec,
+                                unsigned int lidLimit) const {
     for (uint32_t d(bVec->getFirstTrueBit()); (d < lidLimit) && !hasExpired(); d = bVec->getNextTrueBit(d + 1)) {
-        aggregate(grouping, d, 0.0);
+        aggregate(grouping, columnar, d, 0.0);
     }
 }
-void GroupingContext::aggregate(Grouping& grouping, const BitVector* bVec, unsigned int lidLimit,
-                                unsigned int topN) const {
+void GroupingContext::aggregate(Grouping& grouping, ColumnarGrouper* columnar, const BitVector* bVec,
+                                unsigned int lidLimit, unsigned int topN) const {
     for (uint32_t d(bVec->getFirstTrueBit()), i(0); (d < lidLimit) && (i < topN) && !hasExpired();
          d = bVec->getNextTrueBit(d + 1), i++)
     {
-        aggregate(grouping, d, 0.0);
+        aggregate(grouping, columnar, d, 0.0);
     }
 }
 
 void GroupingContext::aggregate(Grouping& grouping, const RankedHit* rankedHit, unsigned int len,
                                 const BitVector* bVec) const {
     grouping.preAggregate(false);
-    uint32_t count = aggregateRanked(grouping, rankedHit, grouping.getMaxN(len));
+    auto     columnar = ColumnarGrouper::try_create(grouping);
+    uint32_t count = aggregateRanked(grouping, columnar.get(), rankedHit, grouping.getMaxN(len));
     if (bVec != nullptr) {
         int64_t topN = grouping.getTopN();
         if (topN > count) {
-            aggregate(grouping, bVec, bVec->size(), topN - count);
+            aggregate(grouping, columnar.get(), bVec, bVec->size(), topN - count);
         } else {
-            aggregate(grouping, bVec, bVec->size());
+            aggregate(grouping, columnar.get(), bVec, bVec->size());
         }
     }
+    if (columnar) {
+        columnar->finish();
+    }
     grouping.postProcess();
 }
 
@@ -130,7 +141,11 @@ void GroupingContext::aggregate(Grouping& grouping, const RankedHit* rankedHit,
     grouping.preAggregate(isOrdered);
     search::aggregation::HitsAggregationResult::SetOrdered pred;
     grouping.select(pred, pred);
-    aggregateRanked(grouping, rankedHit, grouping.getMaxN(len));
+    auto columnar = ColumnarGrouper::try_create(grouping);
+    aggregateRanked(grouping, columnar.get(), rankedHit, grouping.getMaxN(len));
+    if (columnar) {
+        columnar->finish();
+    }
     grouping.postProcess();
 }
 
@@ -8,6 +8,10 @@
 #include <atomic>
 #include <vector>
 
+namespace search::aggregation {
+class ColumnarGrouper;
+}
+
 namespace search::grouping {
 
 /**
@@ -115,10 +119,13 @@ public:
 private:
     void aggregate(Grouping& grouping, const RankedHit* rankedHit, unsigned int len, const BitVector* bv) const;
     void aggregate(Grouping& grouping, const RankedHit* rankedHit, unsigned int len) const;
-    void aggregate(Grouping& grouping, uint32_t docId, HitRank rank) const;
-    unsigned int aggregateRanked(Grouping& grouping, const RankedHit* rankedHit, unsigned int len) const;
-    void aggregate(Grouping& grouping, const BitVector* bv, unsigned int lidLimit) const;
-    void aggregate(Grouping& grouping, const BitVector* bv, unsigned int, unsigned int topN) const;
+    using ColumnarGrouper = search::aggregation::ColumnarGrouper;
+    void aggregate(Grouping& grouping, ColumnarGrouper* columnar, uint32_t docId, HitRank rank) const;
+    unsigned int aggregateRanked(Grouping& grouping, ColumnarGrouper* columnar, const RankedHit* rankedHit,
+                                 unsigned int len) const;
+    void aggregate(Grouping& grouping, ColumnarGrouper* columnar, const BitVector* bv, unsigned int lidLimit) const;
+    void aggregate(Grouping& grouping, ColumnarGrouper* columnar, const BitVector* bv, unsigned int,
+                   unsigned int topN) const;
     const BitVector&                _validLids;
     const std::atomic<steady_time>& _now_ref;
     steady_time                     _timeOfDoom;
@@ -4,6 +4,7 @@
 
 #include "i_attribute_manager.h"
 
+#include <vespa/searchcommon/attribute/config.h>
 #include <vespa/searchlib/attribute/attributevector.h>
 #include <vespa/vespalib/util/isequencedtaskexecutor.h>
 
@@ -20,7 +21,7 @@ AttributeExecutor::AttributeExecutor(std::shared_ptr<IAttributeManager> mgr, std
 AttributeExecutor::~AttributeExecutor() = default;
 
 void AttributeExecutor::run_sync(std::function<void()> task) const {
-    std::string        name(_attr->getNamePrefix());
+    std::string        name(executor_name(*_attr));
     auto&              writer = _mgr->getAttributeFieldWriter();
     std::promise<void> promise;
     auto               future = promise.get_future();
@@ -32,4 +33,18 @@ void AttributeExecutor::run_sync(std::function<void()> task) const {
     future.wait();
 }
 
+std::string_view AttributeExecutor::executor_name(const AttributeVector& attr) {
+    const auto& partition_attribute = nearest_neighbor_partition_attribute(attr);
+    return partition_attribute.empty() ? attr.getNamePrefix() : std::string_view(partition_attribute);
+}
+
+const std::string& AttributeExecutor::nearest_neighbor_partition_attribute(const AttributeVector& attr) {
+    static const std::string empty;
+    const auto&              cfg = attr.getConfig();
+    if (cfg.basicType() == search::attribute::BasicType::Type::TENSOR && cfg.hnsw_index_params().has_value()) {
+        return cfg.hnsw_index_params().value().partition_attribute();
+    }
+    return empty;
+}
+
 } // namespace proton
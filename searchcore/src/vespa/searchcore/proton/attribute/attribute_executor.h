@@ -5,6 +5,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 
 namespace search {
 class AttributeVector;
@@ -27,6 +28,15 @@ public:
     ~AttributeExecutor();
     void run_sync(std::function<void()> task) const;
     const search::AttributeVector& get_attr() const noexcept { return *_attr; }
+
+    /*
+     * Returns the name used to select the attribute field writer executor for the given attribute.
+     * A tensor attribute with a nearest neighbor index partitioned by another attribute shares the
+     * executor of that attribute, as the partition of a document is looked up when it is indexed.
+     */
+    static std::string_view executor_name(const search::AttributeVector& attr);
+    // Returns the name of the attribute partitioning the nearest neighbor index of the given attribute, or empty.
+    static const std::string& nearest_neighbor_partition_attribute(const search::AttributeVector& attr);
 };
 
 } // namespace proton
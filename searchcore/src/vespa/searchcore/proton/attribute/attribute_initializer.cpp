@@ -193,6 +193,8 @@ bool AttributeInitializer::loadAttribute(const AttributeVectorSP& attr, search::
     } else {
         attr->set_reserved_doc_values();
         attr->commit(CommitParam(serialNum, CommitParam::UpdateStats::SKIP));
+        // The next flush can save a delta on top of the loaded snapshot
+        attr->start_tracking_changes(serialNum);
         EventLogger::loadAttributeComplete(_documentSubDbName, attr->getName(), timer.elapsed());
         MemoryUsageLogger::log("finish load attribute", label);
     }
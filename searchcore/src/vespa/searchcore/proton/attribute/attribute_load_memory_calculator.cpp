@@ -19,7 +19,9 @@ size_t get_transient_memory_usage(bool old_enumerated, bool new_fast_search, con
                                   uint64_t total_value_count) noexcept {
     if (new_fast_search) {
         if (old_enumerated) {
-            return sizeof(search::attribute::LoadedEnumAttribute) * total_value_count;
+            // Large vectors of loaded enums are sorted in parallel via a temporary copy
+            size_t copies = (total_value_count >= search::attribute::parallel_sort_loaded_enums_limit) ? 2 : 1;
+            return sizeof(search::attribute::LoadedEnumAttribute) * total_value_count * copies;
         } else {
             switch (config.basicType().type()) {
             case BasicType::Type::INT8:
@@ -2,6 +2,7 @@
 
 #include "attribute_writer.h"
 
+#include "attribute_executor.h"
 #include "attributemanager.h"
 #include "document_field_extractor.h"
 #include "ifieldupdatecallback.h"
@@ -14,8 +15,10 @@
 #include <vespa/searchcommon/attribute/attribute_utils.h>
 #include <vespa/searchcommon/attribute/config.h>
 #include <vespa/searchcore/proton/common/attribute_updater.h>
+#include <vespa/searchlib/attribute/executor_thread_bundle.h>
 #include <vespa/searchlib/attribute/imported_attribute_vector.h>
 #include <vespa/searchlib/tensor/prepare_result.h>
+#include <vespa/searchlib/tensor/tensor_attribute.h>
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/destructor_callbacks.h>
 #include <vespa/vespalib/util/gate.h>
@@ -60,7 +63,8 @@ AttributeWriter::WriteField::WriteField(AttributeVector& attribute)
     : _fieldPath(),
       _attribute(attribute),
       _structFieldAttribute(false),
-      _use_two_phase_put(use_two_phase_put_for_attribute(attribute)) {
+      _use_two_phase_put(use_two_phase_put_for_attribute(attribute)),
+      _partitioned_tensors() {
     const std::string& name = attribute.getName();
     _structFieldAttribute = search::attribute::isStructFieldAttribute(name);
 }
@@ -109,6 +113,17 @@ void AttributeWriter::WriteContext::add(AttributeVector& attr) {
     }
 }
 
+bool AttributeWriter::WriteContext::add_partitioned_tensor(const AttributeVector& partition_attr,
+                                                           TensorAttribute&       tensor) {
+    for (auto& field : _fields) {
+        if (&field.getAttribute() == &partition_attr) {
+            field.add_partitioned_tensor(tensor);
+            return true;
+        }
+    }
+    return false;
+}
+
 void AttributeWriter::WriteContext::consider_build_field_paths(const Document& doc) const {
     auto data_type = doc.getDataType();
     if (_data_type != data_type) {
@@ -124,14 +139,15 @@ void AttributeWriter::WriteContext::consider_build_field_paths(const Document& d
 }
 
 AttributeWriter::AttributeWithInfo::AttributeWithInfo()
-    : attribute(), executor_id(), use_two_phase_put_for_assign_updates(false) {
+    : attribute(), executor_id(), use_two_phase_put_for_assign_updates(false), partitioned_tensors() {
 }
 
 AttributeWriter::AttributeWithInfo::AttributeWithInfo(search::AttributeVector* attribute_in,
                                                       ExecutorId               executor_id_in)
     : attribute(attribute_in),
       executor_id(executor_id_in),
-      use_two_phase_put_for_assign_updates(use_two_phase_put_for_attribute(*attribute_in)) {
+      use_two_phase_put_for_assign_updates(use_two_phase_put_for_attribute(*attribute_in)),
+      partitioned_tensors() {
 }
 
 namespace {
@@ -243,19 +259,24 @@ using AttrUpdates = std::vector<std::pair<AttributeVector*, const FieldUpdate*>>
 struct BatchUpdateTask : public vespalib::Executor::Task {
 
     BatchUpdateTask(SerialNum serialNum, DocumentIdT lid)
-        : vespalib::Executor::Task(), _serialNum(serialNum), _lid(lid), _onWriteDone() {}
+        : vespalib::Executor::Task(), _serialNum(serialNum), _lid(lid), _updates(), _partition_changed(),
+          _onWriteDone() {}
     ~BatchUpdateTask() override;
 
     void run() override {
         for (const auto& update : _updates) {
             applyUpdateToAttribute(_serialNum, *update.second, _lid, *update.first);
         }
+        for (auto* tensor : _partition_changed) {
+            tensor->nearest_neighbor_partition_changed(_lid);
+        }
     }
 
-    SerialNum                         _serialNum;
-    DocumentIdT                       _lid;
-    AttrUpdates                       _updates;
-    vespalib::IDestructorCallback::SP _onWriteDone;
+    SerialNum                                     _serialNum;
+    DocumentIdT                                   _lid;
+    AttrUpdates                                   _updates;
+    std::vector<search::tensor::TensorAttribute*> _partition_changed;
+    vespalib::IDestructorCallback::SP             _onWriteDone;
 };
 
 BatchUpdateTask::~BatchUpdateTask() = default;
@@ -265,6 +286,7 @@ class FieldContext {
     ExecutorId       _executorId;
     AttributeVector* _attr;
     bool             _use_two_phase_put;
+    bool             _partitioned;
 
 public:
     FieldContext(ISequencedTaskExecutor& writer, AttributeVector* attr);
@@ -277,9 +299,10 @@ public:
 
 FieldContext::FieldContext(ISequencedTaskExecutor& writer, AttributeVector* attr)
     : _name(attr->getName()),
-      _executorId(writer.getExecutorIdFromName(attr->getNamePrefix())),
+      _executorId(writer.getExecutorIdFromName(AttributeExecutor::executor_name(*attr))),
       _attr(attr),
-      _use_two_phase_put(use_two_phase_put_for_attribute(*attr)) {
+      _use_two_phase_put(use_two_phase_put_for_attribute(*attr)),
+      _partitioned(!AttributeExecutor::nearest_neighbor_partition_attribute(*attr).empty()) {
 }
 
 FieldContext::~FieldContext() = default;
@@ -288,6 +311,9 @@ bool FieldContext::operator<(const FieldContext& rhs) const noexcept {
     if (_executorId != rhs._executorId) {
         return _executorId < rhs._executorId;
     }
+    if (_partitioned != rhs._partitioned) {
+        return rhs._partitioned;
+    }
     return _name < rhs._name;
 }
 
@@ -317,12 +343,15 @@ void PutTask::run() {
     _wc.consider_build_field_paths(_doc);
     DocumentFieldExtractor field_extractor(_doc);
     const auto&            fields = _wc.getFields();
-    for (auto field : fields) {
+    for (const auto& field : fields) {
         if (_allAttributes || field.isStructFieldAttribute()) {
             AttributeVector& attr = field.getAttribute();
             if (attr.getStatus().getLastSyncToken() < _serialNum) {
                 auto fv = field_extractor.getFieldValue(field.getFieldPath());
                 applyPutToAttribute(_serialNum, fv, _lid, attr, _onWriteDone);
+                for (auto* tensor : field.partitioned_tensors()) {
+                    tensor->nearest_neighbor_partition_changed(_lid);
+                }
             }
         }
     }
@@ -463,7 +492,7 @@ public:
         : _writeCtx(writeCtx), _serialNum(serialNum), _lidsToRemove(lidsToRemove), _onWriteDone(onWriteDone) {}
     ~BatchRemoveTask() override;
     void run() override {
-        for (auto field : _writeCtx.getFields()) {
+        for (const auto& field : _writeCtx.getFields()) {
             auto& attr = field.getAttribute();
             if (attr.getStatus().getLastSyncToken() < _serialNum) {
                 for (auto lidToRemove : _lidsToRemove) {
@@ -501,6 +530,11 @@ void CommitTask::run() {
     for (auto& field : fields) {
         AttributeVector& attr = field.getAttribute();
         applyCommit(_param, _onWriteDone, attr);
+        // Partitions are updated using the committed values of the partition attribute, and
+        // before the tensor attributes (handled later by the same executor) are committed.
+        for (auto* tensor : field.partitioned_tensors()) {
+            tensor->update_nearest_neighbor_partitions();
+        }
     }
 }
 
@@ -570,12 +604,55 @@ AttributeWriter::AttributeWriter(proton::IAttributeManager::SP mgr)
       _attrMap() {
     setupWriteContexts();
     setupAttributeMapping();
+    setup_nearest_neighbor_partitions();
 }
 
 void AttributeWriter::setupAttributeMapping() {
     for (auto attr : getWritableAttributes()) {
-        _attrMap[attr->getName()] =
-            AttributeWithInfo(attr, _attributeFieldWriter.getExecutorIdFromName(attr->getNamePrefix()));
+        auto id = _attributeFieldWriter.getExecutorIdFromName(AttributeExecutor::executor_name(*attr));
+        _attrMap[attr->getName()] = AttributeWithInfo(attr, id);
+    }
+}
+
+void AttributeWriter::setup_nearest_neighbor_partitions() {
+    for (auto attr : getWritableAttributes()) {
+        const auto& partition_name = AttributeExecutor::nearest_neighbor_partition_attribute(*attr);
+        if (partition_name.empty()) {
+            continue;
+        }
+        auto tensor_guard = _mgr->getAttribute(attr->getName());
+        auto partition_guard = _mgr->getAttribute(partition_name);
+        if (!partition_guard || !partition_guard->valid() || !(*partition_guard)->isIntegerType() ||
+            (*partition_guard)->hasMultiValue())
+        {
+            LOG(warning, "Nearest neighbor index of attribute '%s' is not partitioned: '%s' is not a single value "
+                         "integer attribute", attr->getName().c_str(), partition_name.c_str());
+            continue;
+        }
+        std::shared_ptr<search::AttributeVector> tensor_attr = tensor_guard->getSP();
+        auto* tensor = dynamic_cast<TensorAttribute*>(tensor_attr.get());
+        auto* partition_writable = _mgr->getWritableAttribute(partition_name);
+        if (tensor == nullptr || partition_writable == nullptr) {
+            continue;
+        }
+        // Documents are moved between partitions when the partition attribute is changed and committed.
+        for (auto& wc : _writeContexts) {
+            if (wc.add_partitioned_tensor(*partition_writable, *tensor)) {
+                break;
+            }
+        }
+        auto found = _attrMap.find(partition_name);
+        if (found != _attrMap.end()) {
+            found->second.partitioned_tensors.push_back(tensor);
+        }
+        std::shared_ptr<const search::attribute::IAttributeVector> partition_attr = partition_guard->getSP();
+        // The partitions are built in parallel using the shared executor, as when loading the hnsw index.
+        _attributeFieldWriter.executeLambda(
+            _attributeFieldWriter.getExecutorIdFromName(partition_name),
+            [tensor_attr, tensor, partition_attr, &shared_executor = _shared_executor]() {
+                search::attribute::ExecutorThreadBundle thread_bundle(shared_executor);
+                tensor->set_nearest_neighbor_partition_attribute(partition_attr, thread_bundle);
+            });
     }
 }
 
@@ -673,7 +750,11 @@ void AttributeWriter::update(SerialNum serialNum, const DocumentUpdate& upd, Doc
             _shared_executor.execute(CpuUsage::wrap(std::move(prepare_task), CpuUsage::Category::WRITE));
             _attributeFieldWriter.executeTask(found->second.executor_id, std::move(complete_task));
         } else {
-            args[found->second.executor_id.getId()]->_updates.emplace_back(attrp, &fupd);
+            auto& task = *args[found->second.executor_id.getId()];
+            task._updates.emplace_back(attrp, &fupd);
+            for (auto* tensor : found->second.partitioned_tensors) {
+                task._partition_changed.push_back(tensor);
+            }
             LOG(debug, "About to apply update for docId %u in attribute vector '%s'.", lid, attrp->getName().c_str());
         }
     }
@@ -688,7 +769,7 @@ void AttributeWriter::update(SerialNum serialNum, const DocumentUpdate& upd, Doc
 }
 
 void AttributeWriter::heartBeat(SerialNum serialNum, const OnWriteDoneType& onDone) {
-    for (auto entry : _attrMap) {
+    for (const auto& entry : _attrMap) {
         _attributeFieldWriter.execute(entry.second.executor_id, [serialNum, attr = entry.second.attribute, onDone]() {
             (void)onDone;
             applyHeartBeat(serialNum, *attr);
@@ -715,7 +796,7 @@ void AttributeWriter::onReplayDone(uint32_t docIdLimit) {
     vespalib::Gate gate;
     {
         auto on_write_done = std::make_shared<GateCallback>(gate);
-        for (auto entry : _attrMap) {
+        for (const auto& entry : _attrMap) {
             _attributeFieldWriter.execute(entry.second.executor_id,
                                           [docIdLimit, attr = entry.second.attribute, on_write_done]() {
                                               (void)on_write_done;
@@ -730,7 +811,7 @@ void AttributeWriter::compactLidSpace(uint32_t wantedLidLimit, SerialNum serialN
     vespalib::Gate gate;
     {
         auto on_write_done = std::make_shared<GateCallback>(gate);
-        for (auto entry : _attrMap) {
+        for (const auto& entry : _attrMap) {
             _attributeFieldWriter.execute(entry.second.executor_id, [wantedLidLimit, serialNum,
                                                                      attr = entry.second.attribute, on_write_done]() {
                 (void)on_write_done;
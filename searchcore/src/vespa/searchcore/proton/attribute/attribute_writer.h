@@ -12,6 +12,10 @@ namespace document {
 class DocumentType;
 }
 
+namespace search::tensor {
+class TensorAttribute;
+}
+
 namespace proton {
 
 /**
@@ -25,6 +29,7 @@ private:
     using DataType = document::DataType;
     using DocumentType = document::DocumentType;
     using FieldValue = document::FieldValue;
+    using TensorAttribute = search::tensor::TensorAttribute;
     const IAttributeManager::SP       _mgr;
     vespalib::ISequencedTaskExecutor& _attributeFieldWriter;
     vespalib::Executor&               _shared_executor;
@@ -35,10 +40,11 @@ public:
      * Represents an attribute vector for a field and details about how to write to it.
      */
     class WriteField {
-        mutable FieldPath _fieldPath;
-        AttributeVector&  _attribute;
-        bool              _structFieldAttribute; // in array/map of struct
-        bool              _use_two_phase_put;
+        mutable FieldPath             _fieldPath;
+        AttributeVector&              _attribute;
+        bool                          _structFieldAttribute; // in array/map of struct
+        bool                          _use_two_phase_put;
+        std::vector<TensorAttribute*> _partitioned_tensors; // Tensors with nearest neighbor index partitioned by this
 
     public:
         WriteField(AttributeVector& attribute);
@@ -48,6 +54,8 @@ public:
         void buildFieldPath(const DocumentType& docType) const;
         bool isStructFieldAttribute() const { return _structFieldAttribute; }
         bool use_two_phase_put() const { return _use_two_phase_put; }
+        void add_partitioned_tensor(TensorAttribute& tensor) { _partitioned_tensors.push_back(&tensor); }
+        const std::vector<TensorAttribute*>& partitioned_tensors() const noexcept { return _partitioned_tensors; }
     };
 
     /**
@@ -69,6 +77,7 @@ public:
         WriteContext& operator=(WriteContext&& rhs) noexcept;
         void consider_build_field_paths(const Document& doc) const;
         void add(AttributeVector& attr);
+        bool add_partitioned_tensor(const AttributeVector& partition_attr, TensorAttribute& tensor);
         ExecutorId getExecutorId() const { return _executorId; }
         const std::vector<WriteField>& getFields() const { return _fields; }
         bool hasStructFieldAttribute() const { return _hasStructFieldAttribute; }
@@ -79,9 +88,10 @@ public:
     };
 
     struct AttributeWithInfo {
-        search::AttributeVector* attribute;
-        ExecutorId               executor_id;
-        bool                     use_two_phase_put_for_assign_updates;
+        search::AttributeVector*      attribute;
+        ExecutorId                    executor_id;
+        bool                          use_two_phase_put_for_assign_updates;
+        std::vector<TensorAttribute*> partitioned_tensors;
 
         AttributeWithInfo();
         AttributeWithInfo(search::AttributeVector* attribute_in, ExecutorId executor_id_in);
@@ -95,6 +105,7 @@ private:
 
     void setupWriteContexts();
     void setupAttributeMapping();
+    void setup_nearest_neighbor_partitions();
     void internalPut(SerialNum serialNum, const Document& doc, DocumentIdT lid, bool allAttributes,
                      const OnWriteDoneType& onWriteDone);
     void internalRemove(SerialNum serialNum, DocumentIdT lid, const OnWriteDoneType& onWriteDone);
@@ -3,6 +3,7 @@
 #include "attributemanager.h"
 
 #include "attribute_directory.h"
+#include "attribute_executor.h"
 #include "attribute_factory.h"
 #include "attribute_manager_reconfig.h"
 #include "attribute_type_matcher.h"
@@ -79,7 +80,7 @@ std::shared_ptr<ShrinkLidSpaceFlushTarget> allocShrinker(const AttributeVector::
     using Component = IFlushTarget::Component;
 
     auto shrinkwrap = std::make_shared<ThreadedCompactableLidSpace>(
-        attr, executor, executor.getExecutorIdFromName(attr->getNamePrefix()));
+        attr, executor, executor.getExecutorIdFromName(AttributeExecutor::executor_name(*attr)));
     const std::string& name = attr->getName();
     auto               dir = diskLayout.createAttributeDir(name);
     search::SerialNum  shrinkSerialNum = estimateShrinkSerialNum(*attr);
@@ -175,7 +176,7 @@ AttributeManager::transferExistingAttributes(const AttributeManager& currMgr, Sp
                 auto shrinker = wrap->getShrinker();
                 assert(shrinker);
                 addAttribute(AttributeWrap::normalAttribute(av), shrinker);
-                auto id = _attributeFieldWriter.getExecutorIdFromName(av->getNamePrefix());
+                auto id = _attributeFieldWriter.getExecutorIdFromName(AttributeExecutor::executor_name(*av));
                 auto cfg = aspec.getConfig();
                 _attributeFieldWriter.execute(id, [av, cfg, gateCallback]() {
                     (void)gateCallback;
@@ -527,8 +528,8 @@ void AttributeManager::asyncForEachAttribute(std::shared_ptr<IConstAttributeFunc
             continue;
         }
         AttributeVector::SP attrsp = attr.second.getAttribute();
-        _attributeFieldWriter.execute(_attributeFieldWriter.getExecutorIdFromName(attrsp->getNamePrefix()),
-                                      [attrsp, func]() { (*func)(*attrsp); });
+        auto id = _attributeFieldWriter.getExecutorIdFromName(AttributeExecutor::executor_name(*attrsp));
+        _attributeFieldWriter.execute(id, [attrsp, func]() { (*func)(*attrsp); });
     }
 }
 
@@ -539,11 +540,11 @@ void AttributeManager::asyncForEachAttribute(std::shared_ptr<IAttributeFunctor>
             continue;
         }
         AttributeVector::SP attrsp = attr.second.getAttribute();
-        _attributeFieldWriter.execute(_attributeFieldWriter.getExecutorIdFromName(attrsp->getNamePrefix()),
-                                      [attrsp, func, onDone]() {
-                                          (void)onDone;
-                                          (*func)(*attrsp);
-                                      });
+        auto id = _attributeFieldWriter.getExecutorIdFromName(AttributeExecutor::executor_name(*attrsp));
+        _attributeFieldWriter.execute(id, [attrsp, func, onDone]() {
+            (void)onDone;
+            (*func)(*attrsp);
+        });
     }
 }
 
@@ -553,7 +554,7 @@ void AttributeManager::asyncForAttribute(std::string_view name, std::unique_ptr<
         return;
     }
     AttributeVector::SP attrsp = itr->second.getAttribute();
-    string              attrName(attrsp->getNamePrefix());
+    string              attrName(AttributeExecutor::executor_name(*attrsp));
     _attributeFieldWriter.execute(_attributeFieldWriter.getExecutorIdFromName(attrName),
                                   [attr = std::move(attrsp), func = std::move(func)]() { (*func)(*attr); });
 }
@@ -2,6 +2,8 @@
 
 #include "filter_attribute_manager.h"
 
+#include "attribute_executor.h"
+
 #include <vespa/searchcommon/attribute/i_attribute_functor.h>
 #include <vespa/searchcorespi/common/resource_usage.h>
 #include <vespa/searchlib/attribute/attribute_read_guard.h>
@@ -165,8 +167,8 @@ void FilterAttributeManager::asyncForEachAttribute(std::shared_ptr<IConstAttribu
         search::AttributeVector::SP attrsp = guard.getSP();
         // Name must be extracted in document db master thread or attribute
         // writer thread
-        attributeFieldWriter.execute(attributeFieldWriter.getExecutorIdFromName(attrsp->getNamePrefix()),
-                                     [attrsp, func]() { (*func)(*attrsp); });
+        auto id = attributeFieldWriter.getExecutorIdFromName(AttributeExecutor::executor_name(*attrsp));
+        attributeFieldWriter.execute(id, [attrsp, func]() { (*func)(*attrsp); });
     }
 }
 
@@ -179,11 +181,11 @@ void FilterAttributeManager::asyncForEachAttribute(std::shared_ptr<IAttributeFun
         search::AttributeVector::SP attrsp = guard.getSP();
         // Name must be extracted in document db master thread or attribute
         // writer thread
-        attributeFieldWriter.execute(attributeFieldWriter.getExecutorIdFromName(attrsp->getNamePrefix()),
-                                     [attrsp, func, onDone]() {
-                                         (void)onDone;
-                                         (*func)(*attrsp);
-                                     });
+        auto id = attributeFieldWriter.getExecutorIdFromName(AttributeExecutor::executor_name(*attrsp));
+        attributeFieldWriter.execute(id, [attrsp, func, onDone]() {
+            (void)onDone;
+            (*func)(*attrsp);
+        });
     }
 }
 
@@ -193,7 +195,7 @@ void FilterAttributeManager::asyncForAttribute(std::string_view name, std::uniqu
         return;
     }
     vespalib::ISequencedTaskExecutor& attributeFieldWriter = getAttributeFieldWriter();
-    std::string_view                  attrName = (*attr)->getNamePrefix();
+    std::string_view                  attrName = AttributeExecutor::executor_name(**attr);
     attributeFieldWriter.execute(attributeFieldWriter.getExecutorIdFromName(attrName),
                                  [attr = std::move(attr), func = std::move(func)]() mutable { (*func)(**attr); });
 }
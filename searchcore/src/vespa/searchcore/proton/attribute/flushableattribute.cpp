@@ -3,6 +3,7 @@
 #include "flushableattribute.h"
 
 #include "attribute_directory.h"
+#include "attribute_executor.h"
 #include "attributedisklayout.h"
 
 #include <vespa/searchcommon/attribute/config.h>
@@ -47,7 +48,11 @@ private:
     uint64_t                                    _syncToken;
     std::string                                 _flushFile;
     std::unique_ptr<AttributeDirectory::Writer> _writer;
+    std::string                                 _delta_base_dir; // empty unless saving a delta
+    uint64_t                                    _delta_base_size_on_disk;
 
+    std::unique_ptr<search::AttributeSaver> init_delta_save();
+    bool link_delta_base();
     bool saveAttribute(); // not updating snap info.
 public:
     Flusher(FlushableAttribute& fattr, uint64_t syncToken, std::unique_ptr<AttributeDirectory::Writer> writer);
@@ -64,19 +69,78 @@ public:
 
 FlushableAttribute::Flusher::Flusher(FlushableAttribute& fattr, SerialNum syncToken,
                                      std::unique_ptr<AttributeDirectory::Writer> writer)
-    : _fattr(fattr), _saveTarget(), _saver(), _syncToken(syncToken), _flushFile(""), _writer(std::move(writer)) {
+    : _fattr(fattr),
+      _saveTarget(),
+      _saver(),
+      _syncToken(syncToken),
+      _flushFile(""),
+      _writer(std::move(writer)),
+      _delta_base_dir(),
+      _delta_base_size_on_disk(0) {
     fattr._attr->commit(CommitParam(syncToken, CommitParam::UpdateStats::SKIP));
     AttributeVector& attr = *_fattr._attr;
     // Called by attribute field writer executor
     _flushFile = _writer->getSnapshotDir(_syncToken) + "/" + attr.getName();
-    _saver = attr.initSave(_flushFile);
+    _saver = init_delta_save();
+    if (!_saver) {
+        _saver = attr.initSave(_flushFile);
+    }
     assert(_saver);
+    attr.start_tracking_changes(_syncToken);
 }
 
 FlushableAttribute::Flusher::~Flusher() = default;
 
+/*
+ * A delta snapshot has hard links to the files in the previous snapshot,
+ * i.e. the last full save and the deltas saved on top of it, and a new
+ * delta with the documents changed since the previous snapshot.
+ */
+std::unique_ptr<search::AttributeSaver> FlushableAttribute::Flusher::init_delta_save() {
+    AttributeVector& attr = *_fattr._attr;
+    uint32_t         max_delta_flushes = attr.getConfig().max_delta_flushes();
+    SerialNum        base_serial = _fattr.getFlushedSerialNum();
+    if (max_delta_flushes == 0 || base_serial == 0) {
+        return {};
+    }
+    std::string base_dir = _writer->getSnapshotDir(base_serial);
+    std::string base_file = base_dir + "/" + attr.getName();
+    uint32_t    num_deltas = 0;
+    while (std::filesystem::exists(AttributeVector::get_delta_file_name(base_file, num_deltas + 1) + ".dat")) {
+        ++num_deltas;
+    }
+    if (num_deltas >= max_delta_flushes) {
+        return {};
+    }
+    auto saver = attr.init_delta_save(AttributeVector::get_delta_file_name(_flushFile, num_deltas + 1), base_serial);
+    if (saver) {
+        _delta_base_dir = base_dir;
+    }
+    return saver;
+}
+
+bool FlushableAttribute::Flusher::link_delta_base() {
+    std::filesystem::path snapshot_dir(vespalib::dirname(_flushFile));
+    try {
+        for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::path(_delta_base_dir))) {
+            if (entry.is_regular_file()) {
+                std::filesystem::create_hard_link(entry.path(), snapshot_dir / entry.path().filename());
+                _delta_base_size_on_disk += entry.file_size();
+            }
+        }
+    } catch (const std::filesystem::filesystem_error& e) {
+        LOG(warning, "Could not link files from '%s' to '%s': %s", _delta_base_dir.c_str(), snapshot_dir.c_str(),
+            e.what());
+        return false;
+    }
+    return true;
+}
+
 bool FlushableAttribute::Flusher::saveAttribute() {
     std::filesystem::create_directory(std::filesystem::path(vespalib::dirname(_flushFile)));
+    if (!_delta_base_dir.empty() && !link_delta_base()) {
+        return false;
+    }
     SerialNumFileHeaderContext fileHeaderContext(_fattr._fileHeaderContext, _syncToken);
     bool                       saveSuccess = true;
     auto                       create_time = std::chrono::steady_clock::now();
@@ -90,14 +154,14 @@ bool FlushableAttribute::Flusher::saveAttribute() {
             search::AttributeFileSaveTarget saveTarget(_fattr._tuneFileAttributes, fileHeaderContext);
             saveSuccess = _saver->save(saveTarget);
             if (saveSuccess) {
-                _fattr._attr->set_size_on_disk(saveTarget.size_on_disk());
+                _fattr._attr->set_size_on_disk(_delta_base_size_on_disk + saveTarget.size_on_disk());
                 _fattr._attr->set_last_flush_duration(CreateAndFreezeTimes::make_flush_duration(create_time));
             }
             _saver.reset();
         } else {
             saveSuccess = _saveTarget.writeToFile(_fattr._tuneFileAttributes, fileHeaderContext);
             if (saveSuccess) {
-                _fattr._attr->set_size_on_disk(_saveTarget.size_on_disk());
+                _fattr._attr->set_size_on_disk(_delta_base_size_on_disk + _saveTarget.size_on_disk());
                 _fattr._attr->set_last_flush_duration(CreateAndFreezeTimes::make_flush_duration(create_time));
             }
         }
@@ -217,8 +281,8 @@ IFlushTarget::Task::UP FlushableAttribute::initFlush(SerialNum currentSerial, st
     // Called by document db executor
     std::promise<IFlushTarget::Task::UP> promise;
     std::future<IFlushTarget::Task::UP>  future = promise.get_future();
-    _attributeFieldWriter.execute(_attributeFieldWriter.getExecutorIdFromName(_attr->getNamePrefix()),
-                                  [&]() { promise.set_value(internalInitFlush(currentSerial)); });
+    auto id = _attributeFieldWriter.getExecutorIdFromName(AttributeExecutor::executor_name(*_attr));
+    _attributeFieldWriter.execute(id, [&]() { promise.set_value(internalInitFlush(currentSerial)); });
     return future.get();
 }
 
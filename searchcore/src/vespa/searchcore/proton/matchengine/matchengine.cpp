@@ -45,7 +45,8 @@ namespace proton {
 using namespace vespalib::slime;
 using vespalib::CpuUsage;
 
-MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async)
+MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async,
+                         bool numaPinning)
     : _lock(),
       _distributionKey(distributionKey),
       _async(async),
@@ -55,7 +56,7 @@ MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t di
       _executor(std::max(size_t(1), numThreads / threadsPerSearch),
                 CpuUsage::wrap(match_engine_executor, CpuUsage::Category::READ)),
       _threadBundlePool(std::max(size_t(1), threadsPerSearch),
-                        CpuUsage::wrap(match_engine_thread_bundle, CpuUsage::Category::READ)),
+                        CpuUsage::wrap(match_engine_thread_bundle, CpuUsage::Category::READ), numaPinning),
       _nodeUp(false),
       _nodeMaintenance(false) {
 }
@@ -49,8 +49,11 @@ public:
      * @param threadsPerSearch number of threads used for each search
      * @param distributionKey distributionkey of this node.
      * @param async if query is dispatched to threadpool
+     * @param numaPinning if the threads used for each search are pinned to NUMA nodes
      */
-    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async);
+    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async, bool numaPinning);
+    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async)
+        : MatchEngine(numThreads, threadsPerSearch, distributionKey, async, false) {}
     MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey)
         : MatchEngine(numThreads, threadsPerSearch, distributionKey, true) {}
 
@@ -74,6 +74,7 @@ private:
         auto*         wand = new WeakAndBlueprint(n.getTargetNumHits(),
                                                   _requestContext.get_create_blueprint_params().weakand_stop_word_strategy,
                                                   is_search_multi_threaded());
+        wand->set_use_block_max(_requestContext.get_create_blueprint_params().weakand_block_max);
         Blueprint::UP result(wand);
         for (auto node : n.getChildren()) {
             uint32_t weight = getWeightFromNode(*node).percent();
@@ -24,7 +24,8 @@ MatchLoopCommunicator::MatchLoopCommunicator(size_t threads, size_t topN, std::u
       _estimate_match_frequency(threads),
       _get_second_phase_work(threads, topN, _best_scores, _best_dropped, std::move(diversifier), object_store,
                              std::move(before_second_phase)),
-      _complete_second_phase(threads, topN, _best_scores, _best_dropped) {
+      _complete_second_phase(threads, topN, _best_scores, _best_dropped),
+      _first_phase_score_threshold() {
 }
 
 MatchLoopCommunicator::~MatchLoopCommunicator() = default;
@@ -43,6 +44,10 @@ MatchLoopCommunicator::complete_second_phase(TaggedHits my_results, size_t threa
     return _complete_second_phase.rendezvous(std::move(my_results), thread_id);
 }
 
+void MatchLoopCommunicator::raise_first_phase_score_threshold(double score) {
+    _first_phase_score_threshold.raise(score);
+}
+
 void MatchLoopCommunicator::EstimateMatchFrequency::mingle() {
     double freqSum = 0.0;
     for (size_t i = 0; i < size(); ++i) {
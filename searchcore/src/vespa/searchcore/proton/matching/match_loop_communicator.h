@@ -6,6 +6,7 @@
 
 #include <vespa/searchlib/fef/objectstore.h>
 #include <vespa/searchlib/queryeval/idiversifier.h>
+#include <vespa/searchlib/queryeval/shared_score_threshold.h>
 #include <vespa/vespalib/util/rendezvous.h>
 
 #include <functional>
@@ -21,6 +22,7 @@ private:
     using FirstPhaseRankLookup = search::features::FirstPhaseRankLookup;
     using IDiversifier = search::queryeval::IDiversifier;
     using IObjectStore = search::fef::IObjectStore;
+    using SharedScoreThreshold = search::queryeval::SharedScoreThreshold;
     struct BestDropped {
         bool              valid = false;
         search::feature_t score = 0.0;
@@ -69,6 +71,7 @@ private:
     EstimateMatchFrequency _estimate_match_frequency;
     GetSecondPhaseWork     _get_second_phase_work;
     CompleteSecondPhase    _complete_second_phase;
+    SharedScoreThreshold   _first_phase_score_threshold;
 
 public:
     MatchLoopCommunicator(size_t threads, size_t topN);
@@ -79,6 +82,8 @@ public:
     double estimate_match_frequency(const Matches& matches) override;
     TaggedHits get_second_phase_work(SortedHitSequence sortedHits, size_t thread_id) override;
     std::pair<Hits, RangePair> complete_second_phase(TaggedHits my_results, size_t thread_id) override;
+    void raise_first_phase_score_threshold(double score) override;
+    const SharedScoreThreshold& first_phase_score_threshold() const noexcept { return _first_phase_score_threshold; }
 };
 
 } // namespace proton::matching
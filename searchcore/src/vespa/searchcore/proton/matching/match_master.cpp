@@ -13,6 +13,7 @@
 #include <vespa/searchlib/engine/trace.h>
 #include <vespa/vespalib/data/slime/cursor.h>
 #include <vespa/vespalib/data/slime/inserter.h>
+#include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/util/issue.h>
 #include <vespa/vespalib/util/thread_bundle.h>
 
@@ -48,6 +49,9 @@ struct TimedMatchLoopCommunicator final : IMatchLoopCommunicator {
         elapsed = timer.elapsed();
         return result;
     }
+    void raise_first_phase_score_threshold(double score) override {
+        communicator.raise_first_phase_score_threshold(score);
+    }
 };
 
 DocidRangeScheduler::UP createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, uint32_t numDocs) {
@@ -80,7 +84,8 @@ auto make_reply(const MatchToolsFactory& mtf, ResultProcessor& processor, Thread
 ResultProcessor::Result::UP MatchMaster::match(search::engine::Trace& trace, const MatchParams& params,
                                                ThreadBundle& threadBundle, const MatchToolsFactory& mtf,
                                                ResultProcessor& resultProcessor, uint32_t distributionKey,
-                                               uint32_t numSearchPartitions) {
+                                               uint32_t numSearchPartitions,
+                                               ProfileSamples::Query* profile_sample) {
     vespalib::Timer             query_latency_time;
     vespalib::DualMergeDirector mergeDirector(threadBundle.size());
     /*
@@ -92,6 +97,9 @@ ResultProcessor::Result::UP MatchMaster::match(search::engine::Trace& trace, con
         [&mtf]() noexcept { mtf.query().set_matching_phase(MatchingPhase::SECOND_PHASE); });
     TimedMatchLoopCommunicator timedCommunicator(communicator);
     DocidRangeScheduler::UP    scheduler = createScheduler(threadBundle.size(), numSearchPartitions, params.numDocs);
+    if (params.share_first_phase_score_threshold) {
+        mtf.query().set_first_phase_score_threshold(&communicator.first_phase_score_threshold());
+    }
 
     std::vector<MatchThread::UP> threadState;
     for (size_t i = 0; i < threadBundle.size(); ++i) {
@@ -99,10 +107,14 @@ ResultProcessor::Result::UP MatchMaster::match(search::engine::Trace& trace, con
                                                : static_cast<IMatchLoopCommunicator&>(communicator);
         threadState.emplace_back(std::make_unique<MatchThread>(i, threadBundle.size(), params, mtf, com, *scheduler,
                                                                resultProcessor, mergeDirector, distributionKey,
-                                                               trace));
+                                                               trace, profile_sample != nullptr));
     }
     resultProcessor.prepareThreadContextCreation(threadBundle.size());
     threadBundle.run(threadState);
+    if (params.share_first_phase_score_threshold) {
+        // the threshold does not outlive the communicator
+        mtf.query().set_first_phase_score_threshold(nullptr);
+    }
     auto   reply = make_reply(mtf, resultProcessor, threadBundle, threadState[0]->extract_result());
     double query_time_s = vespalib::to_s(query_latency_time.elapsed());
     double rerank_time_s = vespalib::to_s(timedCommunicator.elapsed);
@@ -114,6 +126,11 @@ ResultProcessor::Result::UP MatchMaster::match(search::engine::Trace& trace, con
         _stats.merge_partition(matchThread.get_thread_stats(), i);
         inserter.handle_thread(matchThread.getTrace());
         matchThread.get_issues().for_each_message([](const auto& msg) { Issue::report(Issue(msg)); });
+        if (const auto* report = matchThread.get_profile_report(); report && profile_sample) {
+            for (const char* phase : {"match", "first_phase", "second_phase"}) {
+                profile_sample->add_report(phase, report->get()[phase]);
+            }
+        }
     }
     _stats.queryLatency(query_time_s);
     _stats.matchTime(match_time_s - rerank_time_s);
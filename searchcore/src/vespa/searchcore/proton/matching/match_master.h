@@ -3,6 +3,7 @@
 #pragma once
 
 #include "matching_stats.h"
+#include "profile_samples.h"
 #include "result_processor.h"
 
 namespace vespalib {
@@ -32,7 +33,8 @@ public:
     ResultProcessor::Result::UP match(search::engine::Trace& trace, const MatchParams& params,
                                       vespalib::ThreadBundle& threadBundle, const MatchToolsFactory& mtf,
                                       ResultProcessor& resultProcessor, uint32_t distributionKey,
-                                      uint32_t numSearchPartitions);
+                                      uint32_t numSearchPartitions,
+                                      ProfileSamples::Query* profile_sample = nullptr);
 
     static MatchingStats getStats(MatchMaster&& rhs) { return std::move(rhs._stats); }
 };
@@ -18,7 +18,8 @@ uint32_t computeArraySize(uint32_t hitsPlussOffset, uint32_t heapSize, uint32_t
 MatchParams::MatchParams(uint32_t numDocs_in, uint32_t heapSize_in, uint32_t arraySize_in,
                          std::optional<search::feature_t> first_phase_rank_score_drop_limit_in,
                          std::optional<search::feature_t> second_phase_rank_score_drop_limit_in, uint32_t offset_in,
-                         uint32_t hits_in, bool hasFinalRank, bool needRanking)
+                         uint32_t hits_in, bool hasFinalRank, bool needRanking,
+                         bool share_first_phase_score_threshold_in)
     : numDocs(numDocs_in),
       heapSize((hasFinalRank && needRanking) ? std::min(numDocs_in, heapSize_in) : 0),
       arraySize((needRanking && ((heapSize_in + arraySize_in) > 0))
@@ -28,7 +29,8 @@ MatchParams::MatchParams(uint32_t numDocs_in, uint32_t heapSize_in, uint32_t arr
       hits(std::min(numDocs_in - offset, hits_in)),
       diversity_want_hits(heapSize_in),
       first_phase_rank_score_drop_limit(first_phase_rank_score_drop_limit_in),
-      second_phase_rank_score_drop_limit(second_phase_rank_score_drop_limit_in) {
+      second_phase_rank_score_drop_limit(second_phase_rank_score_drop_limit_in),
+      share_first_phase_score_threshold(share_first_phase_score_threshold_in && (arraySize != 0)) {
 }
 
 } // namespace proton::matching
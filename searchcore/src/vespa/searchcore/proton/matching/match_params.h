@@ -22,11 +22,12 @@ struct MatchParams {
     const uint32_t                         diversity_want_hits;
     const std::optional<search::feature_t> first_phase_rank_score_drop_limit;
     const std::optional<search::feature_t> second_phase_rank_score_drop_limit;
+    const bool                             share_first_phase_score_threshold;
 
     MatchParams(uint32_t numDocs_in, uint32_t heapSize_in, uint32_t arraySize_in,
                 std::optional<search::feature_t> first_phase_rank_drop_limit_in,
                 std::optional<search::feature_t> second_phase_rank_score_drop_limit_in, uint32_t offset_in,
-                uint32_t hits_in, bool hasFinalRank, bool needRanking);
+                uint32_t hits_in, bool hasFinalRank, bool needRanking, bool share_first_phase_score_threshold_in);
     bool save_rank_scores() const noexcept { return (arraySize != 0); }
 };
 
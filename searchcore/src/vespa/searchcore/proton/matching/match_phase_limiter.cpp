@@ -2,6 +2,8 @@
 
 #include "match_phase_limiter.h"
 
+#include <vespa/searchcommon/attribute/iattributecontext.h>
+#include <vespa/searchcommon/attribute/iattributevector.h>
 #include <vespa/searchlib/queryeval/andsearchstrict.h>
 #include <vespa/vespalib/data/slime/cursor.h>
 
@@ -61,6 +63,43 @@ void LimitedSearch::visitMembers(vespalib::ObjectVisitor& visitor) const {
     visit(visitor, "second", getSecond());
 }
 
+namespace {
+
+// Extract the primary sort key when it is a plain attribute (no sort function or special key)
+bool primary_sort_attribute(std::string_view spec, std::string& attribute, bool& descending) {
+    size_t pos = spec.find_first_not_of(' ');
+    if ((pos == std::string_view::npos) || ((spec[pos] != '+') && (spec[pos] != '-'))) {
+        return false;
+    }
+    descending = (spec[pos] == '-');
+    size_t end = spec.find_first_of(" ,()[", ++pos);
+    if ((end != std::string_view::npos) && (spec[end] != ' ')) {
+        return false;
+    }
+    attribute = spec.substr(pos, end - pos);
+    return !attribute.empty();
+}
+
+} // namespace
+
+DegradationParams DegradationParams::from_sort_spec(const std::string& sort_spec, size_t wanted_hits,
+                                                    const search::attribute::IAttributeContext& attributes,
+                                                    const DegradationParams&                    defaults) {
+    DegradationParams result(defaults);
+    result.attribute.clear();
+    result.max_hits = wanted_hits;
+    std::string attribute;
+    bool        descending = false;
+    if (primary_sort_attribute(sort_spec, attribute, descending)) {
+        const auto* attr = attributes.getAttribute(attribute);
+        if ((attr != nullptr) && attr->getIsFastSearch() && !attr->hasMultiValue() && attr->isIntegerType()) {
+            result.attribute = attribute;
+            result.descending = descending;
+        }
+    }
+    return result;
+}
+
 MatchPhaseLimiter::MatchPhaseLimiter(uint32_t docIdLimit, const RangeQueryLocator& rangeQueryLocator,
                                      Searchable& searchable_attributes, IRequestContext& requestContext,
                                      const DegradationParams& degradation, const DiversityParams& diversity)
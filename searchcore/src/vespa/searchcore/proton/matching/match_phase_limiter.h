@@ -9,6 +9,10 @@
 
 #include <atomic>
 
+namespace search::attribute {
+class IAttributeContext;
+}
+
 namespace proton::matching {
 
 class RangeQueryLocator;
@@ -98,6 +102,18 @@ struct DegradationParams {
     double      max_filter_coverage;
     double      sample_percentage;
     double      post_filter_multiplier;
+
+    /**
+     * Create degradation params limiting the match phase in the order
+     * of the primary sort key of a query, so that only about
+     * 'wanted_hits' hits early in sort order are matched. This is only
+     * possible when the primary sort key is a plain single value
+     * integer fast-search attribute; otherwise the returned params are
+     * disabled. The remaining settings are taken from 'defaults'.
+     **/
+    static DegradationParams from_sort_spec(const std::string& sort_spec, size_t wanted_hits,
+                                            const search::attribute::IAttributeContext& attributes,
+                                            const DegradationParams&                    defaults);
 };
 
 /**
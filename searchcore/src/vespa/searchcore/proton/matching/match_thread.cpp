@@ -11,12 +11,14 @@
 #include <vespa/searchlib/attribute/attribute_operation.h>
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/engine/trace.h>
+#include <vespa/searchlib/fef/batch_rank_evaluator.h>
 #include <vespa/searchlib/fef/rank_program.h>
 #include <vespa/searchlib/queryeval/andnotsearch.h>
 #include <vespa/searchlib/queryeval/multibitvectoriterator.h>
 #include <vespa/searchlib/queryeval/profiled_iterator.h>
 #include <vespa/vespalib/data/slime/cursor.h>
 #include <vespa/vespalib/data/slime/inserter.h>
+#include <vespa/vespalib/data/slime/slime.h>
 
 #include <limits>
 
@@ -26,6 +28,7 @@ LOG_SETUP(".proton.matching.match_thread");
 namespace proton::matching {
 
 using search::attribute::AttributeOperation;
+using search::fef::BatchRankEvaluator;
 using search::fef::BlueprintResolver;
 using search::fef::FeatureResolver;
 using search::fef::LazyValue;
@@ -38,6 +41,12 @@ using search::queryeval::SortedHitSequence;
 
 namespace {
 
+// flat profile keeping the 32 most expensive tasks, used when sampling queries for profiling
+constexpr int32_t sampled_profile_depth = -32;
+
+// number of ranked hits between each time the first phase score threshold is published
+constexpr uint32_t score_threshold_update_interval = 128;
+
 struct WaitTimer {
     double&         wait_time_s;
     vespalib::Timer wait_time;
@@ -94,19 +103,30 @@ void fillPartialResult(ResultProcessor::Context& context, size_t totalHits, size
 
 //-----------------------------------------------------------------------------
 
-MatchThread::Context::Context(std::optional<double> first_phase_rank_score_drop_limit, MatchTools& tools,
+MatchThread::Context::Context(std::optional<double> first_phase_rank_score_drop_limit,
+                              IMatchLoopCommunicator* score_threshold_communicator, MatchTools& tools,
                               HitCollector& hits, uint32_t num_threads)
     : matches(0),
       _matches_limit(tools.match_limiter().sample_hits_per_thread(num_threads)),
       _score_feature(get_score_feature(tools.rank_program())),
+      _batch(BatchRankEvaluator::try_create(_score_feature)),
+      _batch_docids(),
       _first_phase_rank_score_drop_limit(first_phase_rank_score_drop_limit.value_or(0.0 /* ignored */)),
+      _score_threshold_communicator(score_threshold_communicator),
+      _score_threshold_countdown((score_threshold_communicator != nullptr) ? score_threshold_update_interval
+                                                                             : std::numeric_limits<uint32_t>::max()),
       _hits(hits),
       _doom(tools.getDoom()),
       dropped() {
+    if (_batch) {
+        _batch_docids.reserve(BatchRankEvaluator::block_size);
+    }
 }
 
-template <MatchThread::RankDropLimitE use_rank_drop_limit> void MatchThread::Context::rankHit(uint32_t docId) {
-    double score = _score_feature.as_number(docId);
+MatchThread::Context::~Context() = default;
+
+template <MatchThread::RankDropLimitE use_rank_drop_limit>
+void MatchThread::Context::addScoredHit(uint32_t docId, double score) {
     // convert NaN and Inf scores to -Inf
     if (__builtin_expect(std::isnan(score) || std::isinf(score), false)) {
         score = -HUGE_VAL;
@@ -120,6 +140,49 @@ template <MatchThread::RankDropLimitE use_rank_drop_limit> void MatchThread::Con
     } else {
         _hits.addHit(docId, score);
     }
+    if (__builtin_expect(--_score_threshold_countdown == 0, false)) {
+        publish_score_threshold();
+    }
+}
+
+// Documents scoring at or below the lowest score kept by any thread's
+// hit collector can not be among the globally best ranked hits. Search
+// iterators given the shared threshold use it to skip such documents.
+void MatchThread::Context::publish_score_threshold() {
+    if (_score_threshold_communicator != nullptr) {
+        _score_threshold_communicator->raise_first_phase_score_threshold(_hits.get_min_kept_score());
+        _score_threshold_countdown = score_threshold_update_interval;
+    } else {
+        _score_threshold_countdown = std::numeric_limits<uint32_t>::max();
+    }
+}
+
+template <MatchThread::RankDropLimitE use_rank_drop_limit> void MatchThread::Context::rankBatch() {
+    auto scores = _batch->evaluate(_batch_docids);
+    for (size_t i = 0; i < _batch_docids.size(); ++i) {
+        addScoredHit<use_rank_drop_limit>(_batch_docids[i], scores[i]);
+    }
+    _batch_docids.clear();
+}
+
+// When the first phase score can be calculated in batch, hits are
+// buffered and ranked a block at a time. Buffered hits must be
+// flushed before the hit collector is used.
+template <MatchThread::RankDropLimitE use_rank_drop_limit> void MatchThread::Context::rankHit(uint32_t docId) {
+    if (_batch) {
+        _batch_docids.push_back(docId);
+        if (_batch_docids.size() == BatchRankEvaluator::block_size) {
+            rankBatch<use_rank_drop_limit>();
+        }
+    } else {
+        addScoredHit<use_rank_drop_limit>(docId, _score_feature.as_number(docId));
+    }
+}
+
+template <MatchThread::RankDropLimitE use_rank_drop_limit> void MatchThread::Context::flushRankedHits() {
+    if (!_batch_docids.empty()) {
+        rankBatch<use_rank_drop_limit>();
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -192,6 +255,9 @@ uint32_t MatchThread::inner_match_loop(Context& context, MatchTools& tools, Doci
             docId = Strategy::seek_next(*search, docId + 1);
         }
     }
+    if (do_rank) {
+        context.flushRankedHits<use_rank_drop_limit>();
+    }
     return docId;
 }
 
@@ -201,7 +267,9 @@ void MatchThread::match_loop(MatchTools& tools, HitCollector& hits) {
     bool               softDoomed = false;
     uint32_t           docsCovered = 0;
     vespalib::duration overtime(vespalib::duration::zero());
-    Context            context(matchParams.first_phase_rank_score_drop_limit, tools, hits, num_threads);
+    Context            context(matchParams.first_phase_rank_score_drop_limit,
+                               matchParams.share_first_phase_score_threshold ? &communicator : nullptr, tools, hits,
+                               num_threads);
     for (DocidRange docid_range = scheduler.first_range(thread_id); !docid_range.empty();
          docid_range = scheduler.next_range(thread_id))
     {
@@ -425,7 +493,7 @@ void MatchThread::processResult(const Doom& doom, search::ResultSet::UP result,
 MatchThread::MatchThread(size_t thread_id_in, size_t num_threads_in, const MatchParams& mp,
                          const MatchToolsFactory& mtf, IMatchLoopCommunicator& com, DocidRangeScheduler& sched,
                          ResultProcessor& rp, vespalib::DualMergeDirector& md, uint32_t distributionKey,
-                         const Trace& parent_trace)
+                         const Trace& parent_trace, bool sample_profile)
     : thread_id(thread_id_in),
       num_threads(num_threads_in),
       matchParams(mp),
@@ -446,6 +514,7 @@ MatchThread::MatchThread(size_t thread_id_in, size_t num_threads_in, const Match
       match_profiler(),
       first_phase_profiler(),
       second_phase_profiler(),
+      profile_report(),
       my_issues() {
     if (trace->getLevel() > 0) {
         if (int32_t depth = trace->match_profile_depth(); depth != 0) {
@@ -457,9 +526,17 @@ MatchThread::MatchThread(size_t thread_id_in, size_t num_threads_in, const Match
         if (int32_t depth = trace->second_phase_profile_depth(); depth != 0) {
             second_phase_profiler = std::make_unique<vespalib::ExecutionProfiler>(depth);
         }
+    } else if (sample_profile) {
+        // flat profiles are cheap to collect and to aggregate across queries
+        match_profiler = std::make_unique<vespalib::ExecutionProfiler>(sampled_profile_depth);
+        first_phase_profiler = std::make_unique<vespalib::ExecutionProfiler>(sampled_profile_depth);
+        second_phase_profiler = std::make_unique<vespalib::ExecutionProfiler>(sampled_profile_depth);
+        profile_report = std::make_unique<vespalib::Slime>();
     }
 }
 
+MatchThread::~MatchThread() = default;
+
 void MatchThread::run() {
     vespalib::Timer total_time;
     vespalib::Timer match_time(total_time);
@@ -489,6 +566,14 @@ void MatchThread::run() {
     trace->addEvent(4, "Start thread merge");
     mergeDirector.dualMerge(thread_id, *resultContext->result, resultContext->groupingSource);
     trace->addEvent(4, "MatchThread::run Done");
+    if (profile_report) {
+        auto describe = [](const std::string& name) { return BlueprintResolver::describe_feature(name); };
+        auto& obj = profile_report->setObject();
+        match_profiler->report(obj.setObject("match"));
+        first_phase_profiler->report(obj.setObject("first_phase"), describe);
+        second_phase_profiler->report(obj.setObject("second_phase"), describe);
+        return;
+    }
     if (match_profiler) {
         match_profiler->report(trace->createCursor("match_profiling"));
     }
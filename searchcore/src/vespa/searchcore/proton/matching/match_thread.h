@@ -17,14 +17,19 @@
 #include <vespa/vespalib/util/execution_profiler.h>
 #include <vespa/vespalib/util/runnable.h>
 
+namespace vespalib {
+class Slime;
+}
+
 namespace search::engine {
 class Trace;
 class RelativeTime;
 } // namespace search::engine
 
 namespace search::fef {
+class BatchRankEvaluator;
 class RankProgram;
-}
+} // namespace search::fef
 
 namespace search::queryeval {
 class SearchIterator;
@@ -73,13 +78,17 @@ private:
     std::unique_ptr<vespalib::ExecutionProfiler> match_profiler;
     std::unique_ptr<vespalib::ExecutionProfiler> first_phase_profiler;
     std::unique_ptr<vespalib::ExecutionProfiler> second_phase_profiler;
+    std::unique_ptr<vespalib::Slime>             profile_report; // set when sampled for profiling
     UniqueIssues                                 my_issues;
 
     class Context {
     public:
-        Context(std::optional<double> first_phase_rank_score_drop_limit, MatchTools& tools, HitCollector& hits,
+        Context(std::optional<double> first_phase_rank_score_drop_limit,
+                IMatchLoopCommunicator* score_threshold_communicator, MatchTools& tools, HitCollector& hits,
                 uint32_t num_threads) __attribute__((noinline));
+        ~Context();
         template <RankDropLimitE use_rank_drop_limit> void rankHit(uint32_t docId);
+        template <RankDropLimitE use_rank_drop_limit> void flushRankedHits();
         void addHit(uint32_t docId) { _hits.addHit(docId, search::zero_rank_value); }
         bool isBelowLimit() const { return matches < _matches_limit; }
         bool isAtLimit() const { return matches == _matches_limit; }
@@ -88,11 +97,19 @@ private:
         uint32_t matches;
 
     private:
-        uint32_t      _matches_limit;
-        LazyValue     _score_feature;
-        double        _first_phase_rank_score_drop_limit;
-        HitCollector& _hits;
-        const Doom    _doom;
+        template <RankDropLimitE use_rank_drop_limit> void addScoredHit(uint32_t docId, double score);
+        template <RankDropLimitE use_rank_drop_limit> void rankBatch() __attribute__((noinline));
+        void publish_score_threshold() __attribute__((noinline));
+
+        uint32_t                                         _matches_limit;
+        LazyValue                                        _score_feature;
+        std::unique_ptr<search::fef::BatchRankEvaluator> _batch;
+        std::vector<uint32_t>                            _batch_docids;
+        double                                           _first_phase_rank_score_drop_limit;
+        IMatchLoopCommunicator*                          _score_threshold_communicator;
+        uint32_t                                         _score_threshold_countdown;
+        HitCollector&                                    _hits;
+        const Doom                                       _doom;
 
     public:
         std::vector<uint32_t> dropped;
@@ -134,13 +151,17 @@ private:
 public:
     MatchThread(size_t thread_id_in, size_t num_threads_in, const MatchParams& mp, const MatchToolsFactory& mtf,
                 IMatchLoopCommunicator& com, DocidRangeScheduler& sched, ResultProcessor& rp,
-                vespalib::DualMergeDirector& md, uint32_t distributionKey, const Trace& parent_trace);
+                vespalib::DualMergeDirector& md, uint32_t distributionKey, const Trace& parent_trace,
+                bool sample_profile);
+    ~MatchThread() override;
     void run() override;
     const MatchingStats::Partition& get_thread_stats() const { return thread_stats; }
     double get_match_time() const { return match_time_s; }
     std::unique_ptr<PartialResult> extract_result();
     const Trace& getTrace() const { return *trace; }
     const UniqueIssues& get_issues() const { return my_issues; }
+    // flat profiler reports ("match", "first_phase", "second_phase") for a sampled query, nullptr otherwise
+    const vespalib::Slime* get_profile_report() const { return profile_report.get(); }
 };
 
 } // namespace proton::matching
@@ -154,7 +154,8 @@ MatchToolsFactory::MatchToolsFactory(
     const IDocumentMetaStore& metaStore, const IIndexEnvironment& indexEnv, const RankSetup& rankSetup,
     const Properties& rankProperties, const Properties& featureOverrides, vespalib::ThreadBundle& thread_bundle,
     const search::IDocumentMetaStoreContext::IReadGuard::SP* metaStoreReadGuard,
-    search::queryeval::QuerySetupStats& setup_stats, uint32_t maxNumHits, bool is_search)
+    search::queryeval::QuerySetupStats& setup_stats, uint32_t maxNumHits, const std::string& sortSpec,
+    uint32_t wantedHits, bool is_search)
     : _queryLimiter(queryLimiter),
       _create_blueprint_params(extract_create_blueprint_params(
           rankSetup, rankProperties, metaStore.getNumActiveLids(), searchContext.getDocIdLimit())),
@@ -228,10 +229,16 @@ MatchToolsFactory::MatchToolsFactory(
         _diversityParams = extractDiversityParams(_rankSetup, rankProperties);
         std::string attribute = DegradationAttribute::lookup(rankProperties, _rankSetup.getDegradationAttribute());
         DegradationParams degradationParams = extractDegradationParams(_rankSetup, attribute, rankProperties);
+        if (!degradationParams.enabled() && is_search && !sortSpec.empty() &&
+            DegradationSortOrder::check(rankProperties, DegradationSortOrder::check(indexEnv.getProperties())))
+        {
+            degradationParams =
+                DegradationParams::from_sort_spec(sortSpec, wantedHits, attributeContext, degradationParams);
+        }
 
         if (degradationParams.enabled()) {
             trace.addEvent(5, "Setup match phase limiter");
-            const search::fef::FieldInfo* fieldInfo = indexEnv.getFieldByName(attribute);
+            const search::fef::FieldInfo* fieldInfo = indexEnv.getFieldByName(degradationParams.attribute);
             // Falling back to the "no field" id means no query item can match,
             // which is what we want when the degradation attribute is unknown.
             uint32_t field_id = fieldInfo != nullptr ? fieldInfo->id() : search::fef::FieldInfo::no_field().id();
@@ -352,6 +359,7 @@ CreateBlueprintParams MatchToolsFactory::extract_create_blueprint_params(const R
         WeakAndStopWordDropLimit::lookup(rank_properties, rank_setup.get_weakand_stop_word_drop_limit());
     bool weakand_allow_drop_all =
         WeakAndAllowDropAll::lookup(rank_properties, rank_setup.get_weakand_allow_drop_all());
+    bool weakand_block_max = WeakAndBlockMax::lookup(rank_properties, rank_setup.get_weakand_block_max());
     auto filter_threshold = FilterThreshold::lookup(rank_properties);
 
     // Note that we count the reserved docid 0 as active.
@@ -368,7 +376,8 @@ CreateBlueprintParams MatchToolsFactory::extract_create_blueprint_params(const R
             fuzzy_matching_algorithm,
             StopWordStrategy(weakand_stop_word_adjust_limit, weakand_stop_word_drop_limit, docid_limit,
                              weakand_allow_drop_all),
-            filter_threshold};
+            filter_threshold,
+            weakand_block_max};
 }
 
 AttributeOperationTask::AttributeOperationTask(const RequestContext& requestContext, std::string_view attribute,
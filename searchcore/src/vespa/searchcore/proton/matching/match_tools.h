@@ -162,7 +162,8 @@ public:
                       const IIndexEnvironment& indexEnv, const RankSetup& rankSetup, const Properties& rankProperties,
                       const Properties& featureOverrides, vespalib::ThreadBundle& thread_bundle,
                       const search::IDocumentMetaStoreContext::IReadGuard::SP* metaStoreReadGuard,
-                      search::queryeval::QuerySetupStats& setup_stats, uint32_t maxNumHits, bool is_search);
+                      search::queryeval::QuerySetupStats& setup_stats, uint32_t maxNumHits,
+                      const std::string& sortSpec, uint32_t wantedHits, bool is_search);
     ~MatchToolsFactory();
     bool valid() const { return _valid; }
     const MaybeMatchPhaseLimiter& match_limiter() const { return *_match_limiter; }
@@ -48,6 +48,7 @@ using search::fef::indexproperties::hitcollector::ArraySize;
 using search::fef::indexproperties::hitcollector::FirstPhaseRankScoreDropLimit;
 using search::fef::indexproperties::hitcollector::HeapSize;
 using search::fef::indexproperties::hitcollector::SecondPhaseRankScoreDropLimit;
+using search::fef::indexproperties::hitcollector::ShareFirstPhaseScoreThreshold;
 using search::queryeval::Blueprint;
 using search::queryeval::SearchIterator;
 using vespalib::Doom;
@@ -120,7 +121,11 @@ Matcher::Matcher(const search::index::Schema& schema, Properties props, const st
       _startTime(my_clock::now()),
       _now_ref(now_ref),
       _queryLimiter(queryLimiter),
-      _distributionKey(distributionKey) {
+      _distributionKey(distributionKey),
+      _resultCache(),
+      _profileSampleInterval(trace::ProfileSampleInterval::lookup(_indexEnv.getProperties())),
+      _profileSampleSeq(0),
+      _profileSamples() {
     search::features::setup_search_features(_blueprintFactory);
     search::fef::test::setup_fef_test_plugin(_blueprintFactory);
     _rankSetup = std::make_shared<search::fef::RankSetup>(_blueprintFactory, _indexEnv);
@@ -129,6 +134,11 @@ Matcher::Matcher(const search::index::Schema& schema, Properties props, const st
         throw vespalib::IllegalArgumentException(
             fmt("failed to compile rank setup :\n%s", _rankSetup->getJoinedWarnings().c_str()), VESPA_STRLOC);
     }
+    uint32_t resultCacheSize = ResultCacheSize::lookup(_indexEnv.getProperties());
+    if (resultCacheSize > 0) {
+        _resultCache = std::make_unique<ResultCache>(
+            resultCacheSize, vespalib::from_s(ResultCacheMaxAge::lookup(_indexEnv.getProperties())));
+    }
 }
 
 Matcher::~Matcher() = default;
@@ -140,11 +150,17 @@ MatchingStats Matcher::getStats() {
     return stats;
 }
 
+ProfileSamples Matcher::get_profile_samples() {
+    std::lock_guard<std::mutex> guard(_statsLock);
+    return _profileSamples;
+}
+
 std::unique_ptr<MatchToolsFactory> Matcher::create_match_tools_factory(
     const search::engine::Request& request, ISearchContext& searchContext, IAttributeContext& attrContext,
     const search::IDocumentMetaStore& metaStore, const Properties& feature_overrides,
     vespalib::ThreadBundle& thread_bundle, const IDocumentMetaStoreContext::IReadGuard::SP* metaStoreReadGuard,
-    search::queryeval::QuerySetupStats& setup_stats, uint32_t maxHits, bool is_search) const {
+    search::queryeval::QuerySetupStats& setup_stats, uint32_t maxHits, const std::string& sortSpec,
+    uint32_t wantedHits, bool is_search) const {
     const Properties& rankProperties = request.propertiesMap.rankProperties();
     bool   softTimeoutEnabled = softtimeout::Enabled::lookup(rankProperties, _rankSetup->getSoftTimeoutEnabled());
     bool   hasFactorOverride = softtimeout::Factor::isPresent(rankProperties);
@@ -181,7 +197,8 @@ std::unique_ptr<MatchToolsFactory> Matcher::create_match_tools_factory(
     return std::make_unique<MatchToolsFactory>(_queryLimiter, doom, ann_deadline_config, searchContext, attrContext,
                                                request.trace(), queryTree, request.location, _viewResolver, metaStore,
                                                _indexEnv, *_rankSetup, rankProperties, feature_overrides,
-                                               thread_bundle, metaStoreReadGuard, setup_stats, maxHits, is_search);
+                                               thread_bundle, metaStoreReadGuard, setup_stats, maxHits, sortSpec,
+                                               wantedHits, is_search);
 }
 
 size_t Matcher::computeNumThreadsPerSearch(Blueprint::HitEstimate hits, const Properties& rankProperties) const {
@@ -265,12 +282,28 @@ void initCoverage(Coverage& coverage, const search::IDocumentMetaStore& metaStor
 SearchReply::UP Matcher::match(const SearchRequest& request, vespalib::ThreadBundle& threadBundle,
                                ISearchContext& searchContext, IAttributeContext& attrContext,
                                SessionManager& sessionMgr, const search::IDocumentMetaStore& metaStore,
-                               const bucketdb::BucketDBOwner&   bucketdb,
+                               const bucketdb::BucketDBOwner& bucketdb, search::SerialNum serialNum,
                                SearchSession::OwnershipBundle&& owned_objects) {
     vespalib::Timer                                    total_matching_time;
     MatchingStats                                      my_stats;
     std::shared_ptr<search::queryeval::QueryEvalStats> queryeval_stats;
-    SearchReply::UP                                    reply = std::make_unique<SearchReply>();
+    SearchReply::UP                                    reply;
+
+    std::string              resultCacheKey;
+    ResultCache::DataVersion dataVersion;
+    bool                     useResultCache = _resultCache && ResultCache::can_cache(request);
+    if (useResultCache) {
+        resultCacheKey = ResultCache::make_key(request);
+        dataVersion = ResultCache::DataVersion(serialNum, metaStore, searchContext.getDocIdLimit());
+        reply = _resultCache->lookup(resultCacheKey, dataVersion, request.getStartTime());
+        if (reply) {
+            my_stats.queries(1).queryLatency(vespalib::to_s(total_matching_time.elapsed()));
+            updateStats(my_stats, request, reply->coverage, false);
+            return reply;
+        }
+    }
+
+    reply = std::make_unique<SearchReply>();
     initCoverage(reply->coverage, metaStore, bucketdb);
 
     bool isDoomExplicit = false;
@@ -308,9 +341,12 @@ SearchReply::UP Matcher::match(const SearchRequest& request, vespalib::ThreadBun
 
         // Collect more detailed statistics from query setup
         search::queryeval::QuerySetupStats setup_stats;
-        MatchToolsFactory::UP              mtf = create_match_tools_factory(
+        // Grouping needs all matches, so only plain sorted queries may limit matching by sort order
+        const std::string     limit_sort_spec = request.groupSpec.empty() ? request.sortSpec : std::string();
+        MatchToolsFactory::UP mtf = create_match_tools_factory(
             request, searchContext, attrContext, metaStore, *feature_overrides, threadBundle,
-            &owned_objects.readGuard, setup_stats, searchContext.getDocIdLimit(), true);
+            &owned_objects.readGuard, setup_stats, searchContext.getDocIdLimit(), limit_sort_spec,
+            request.offset + request.maxhits, true);
         isDoomExplicit = mtf->get_request_context().getDoom().isExplicitSoftDoom();
         trace_setup_stats(6, request.trace(), setup_stats);
         traceQuery(6, request.trace(), mtf->query());
@@ -336,12 +372,17 @@ SearchReply::UP Matcher::match(const SearchRequest& request, vespalib::ThreadBun
             FirstPhaseRankScoreDropLimit::lookup(rankProperties, _rankSetup->get_first_phase_rank_score_drop_limit());
         auto second_phase_rank_score_drop_limit = SecondPhaseRankScoreDropLimit::lookup(
             rankProperties, _rankSetup->get_second_phase_rank_score_drop_limit());
+        // hits below the shared threshold may still be needed for sorting and grouping
+        bool share_first_phase_score_threshold =
+            ShareFirstPhaseScoreThreshold::lookup(rankProperties, _rankSetup->get_share_first_phase_score_threshold()) &&
+            request.sortSpec.empty() && groupingContext.empty();
 
         MatchParams params(searchContext.getDocIdLimit(), heapSize, arraySize, first_phase_rank_score_drop_limit,
                            second_phase_rank_score_drop_limit, request.offset, request.maxhits,
                            !_rankSetup->getSecondPhaseRank().empty(),
                            willNeedRanking(request, groupingContext, first_phase_rank_score_drop_limit,
-                                           mtf->query().needs_ranking()));
+                                           mtf->query().needs_ranking()),
+                           share_first_phase_score_threshold);
 
         ResultProcessor rp(attrContext, metaStore, sessionMgr, groupingContext, sessionId, request.sortSpec,
                            params.offset, params.hits);
@@ -353,9 +394,19 @@ SearchReply::UP Matcher::match(const SearchRequest& request, vespalib::ThreadBun
         if (limitedThreadBundle.size() > 1) {
             attrContext.enableMultiThreadSafe();
         }
+        // traced queries are profiled on request; others are sampled if enabled
+        bool sample_profile = (_profileSampleInterval > 0) && (request.trace().getLevel() == 0) &&
+                              ((_profileSampleSeq.fetch_add(1, std::memory_order_relaxed) % _profileSampleInterval) == 0);
+        ProfileSamples::Query profile_sample;
         ResultProcessor::Result::UP result =
-            master.match(request.trace(), params, limitedThreadBundle, *mtf, rp, _distributionKey, numParts);
+            master.match(request.trace(), params, limitedThreadBundle, *mtf, rp, _distributionKey, numParts,
+                         sample_profile ? &profile_sample : nullptr);
         my_stats = MatchMaster::getStats(std::move(master));
+        if (sample_profile) {
+            my_stats.profiled_queries(1);
+            std::lock_guard<std::mutex> guard(_statsLock);
+            _profileSamples.add(profile_sample);
+        }
         my_stats.add_query_setup_stats(setup_stats);
         reply = std::move(result->_reply);
         updateCoverage(reply->coverage, mtf->match_limiter(), my_stats, metaStore, bucketdb);
@@ -365,6 +416,10 @@ SearchReply::UP Matcher::match(const SearchRequest& request, vespalib::ThreadBun
             numThreadsPerSearch, _rankSetup->getNumThreadsPerSearch(), mtf->estimate().estHits, reply->totalHitCount,
             request.ranking.c_str());
 
+        if (useResultCache && ResultCache::can_cache(*reply)) {
+            _resultCache->insert(resultCacheKey, dataVersion, request.getStartTime(), *reply);
+        }
+
         if (shouldCacheSearchSession && ((result->_numFs4Hits != 0) || shouldCacheGroupingSession)) {
             auto session = std::make_shared<SearchSession>(sessionId, request.getStartTime(), request.getTimeOfDoom(),
                                                            std::move(mtf), std::move(owned_objects));
@@ -465,7 +520,8 @@ DocsumMatcher::UP Matcher::create_docsum_matcher(const DocsumRequest& req, ISear
     search::queryeval::QuerySetupStats setup_stats;
     MatchToolsFactory::UP              mtf =
         create_match_tools_factory(req, search_ctx, attr_ctx, meta, req.propertiesMap.featureOverrides(),
-                                   vespalib::ThreadBundle::trivial(), nullptr, setup_stats, docs.size(), false);
+                                   vespalib::ThreadBundle::trivial(), nullptr, setup_stats, docs.size(), "", 0,
+                                   false);
     if (!mtf->valid()) {
         LOG(warning, "could not initialize docsum matching: %s",
             (expectedSessionCached) ? "session has expired" : "invalid query");
@@ -5,7 +5,9 @@
 #include "docsum_matcher.h"
 #include "indexenvironment.h"
 #include "matching_stats.h"
+#include "profile_samples.h"
 #include "querylimiter.h"
+#include "result_cache.h"
 #include "search_session.h"
 #include "viewresolver.h"
 
@@ -79,6 +81,10 @@ private:
     const std::atomic<steady_time>& _now_ref;
     QueryLimiter&                   _queryLimiter;
     uint32_t                        _distributionKey;
+    std::unique_ptr<ResultCache>    _resultCache;
+    uint32_t                        _profileSampleInterval;
+    std::atomic<uint64_t>           _profileSampleSeq;
+    ProfileSamples                  _profileSamples;
 
     size_t computeNumThreadsPerSearch(search::queryeval::Blueprint::HitEstimate hits,
                                       const Properties&                         rankProperties) const;
@@ -113,6 +119,12 @@ public:
      **/
     MatchingStats getStats();
 
+    /**
+     * Get the execution profiles aggregated over the queries sampled
+     * for profiling since this matcher was created.
+     **/
+    ProfileSamples get_profile_samples();
+
     /**
      * Create the low-level tools needed to perform matching. This
      * function is exposed for testing purposes.
@@ -121,7 +133,8 @@ public:
         const search::engine::Request& request, ISearchContext& searchContext, IAttributeContext& attrContext,
         const search::IDocumentMetaStore& metaStore, const Properties& feature_overrides,
         vespalib::ThreadBundle& thread_bundle, const IDocumentMetaStoreContext::IReadGuard::SP* metaStoreReadGuard,
-        search::queryeval::QuerySetupStats& setup_stats, uint32_t maxHits, bool is_search) const;
+        search::queryeval::QuerySetupStats& setup_stats, uint32_t maxHits, const std::string& sortSpec,
+        uint32_t wantedHits, bool is_search) const;
 
     /**
      * Perform a search against this matcher.
@@ -133,11 +146,13 @@ public:
      * @param attrContext abstract view of attribute data
      * @param sessionManager multilevel grouping session cache
      * @param metaStore the document meta store used to map from lid to gid
+     * @param serialNum feed serial number, used to invalidate the result cache
      **/
     std::unique_ptr<search::engine::SearchReply>
     match(const SearchRequest& request, vespalib::ThreadBundle& threadBundle, ISearchContext& searchContext,
           IAttributeContext& attrContext, SessionManager& sessionManager, const search::IDocumentMetaStore& metaStore,
-          const bucketdb::BucketDBOwner& bucketdb, SearchSession::OwnershipBundle&& owned_objects);
+          const bucketdb::BucketDBOwner& bucketdb, search::SerialNum serialNum,
+          SearchSession::OwnershipBundle&& owned_objects);
 
     /**
      * Perform matching for the documents in the given docsum request
@@ -184,6 +199,11 @@ public:
     DocsumMatcher::UP create_docsum_matcher(const DocsumRequest& req, ISearchContext& search_ctx,
                                             IAttributeContext& attr_ctx, SessionManager& session_manager) const;
 
+    /**
+     * @return the result cache of this rank profile, or nullptr if disabled
+     **/
+    const ResultCache* get_result_cache() const noexcept { return _resultCache.get(); }
+
     /**
      * @return true if this rankprofile has summary-features enabled
      **/
@@ -25,6 +25,7 @@ constexpr double             MAX_CHANGE_FACTOR = 5;
 MatchingStats::MatchingStats(double prev_soft_doom_factor) noexcept
     : _queries(0),
       _limited_queries(0),
+      _profiled_queries(0),
       _docidSpaceCovered(0),
       _docsMatched(0),
       _docsRanked(0),
@@ -82,6 +83,7 @@ MatchingStats& MatchingStats::add_query_eval_stats(const search::queryeval::Quer
 MatchingStats& MatchingStats::add(const MatchingStats& rhs) noexcept {
     _queries += rhs._queries;
     _limited_queries += rhs._limited_queries;
+    _profiled_queries += rhs._profiled_queries;
 
     _docidSpaceCovered += rhs._docidSpaceCovered;
     _docsMatched += rhs._docsMatched;
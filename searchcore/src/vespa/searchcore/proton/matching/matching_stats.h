@@ -147,6 +147,7 @@ public:
 private:
     size_t _queries;
     size_t _limited_queries;
+    size_t _profiled_queries;
     size_t _docidSpaceCovered;
     size_t _docsMatched;
     size_t _docsRanked;
@@ -189,6 +190,12 @@ public:
     }
     size_t limited_queries() const { return _limited_queries; }
 
+    MatchingStats& profiled_queries(size_t value) {
+        _profiled_queries = value;
+        return *this;
+    }
+    size_t profiled_queries() const { return _profiled_queries; }
+
     MatchingStats& docidSpaceCovered(size_t value) {
         _docidSpaceCovered = value;
         return *this;
@@ -0,0 +1,111 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "profile_samples.h"
+
+#include <vespa/vespalib/data/slime/cursor.h>
+#include <vespa/vespalib/data/slime/inspector.h>
+
+#include <cmath>
+
+using vespalib::slime::Cursor;
+using vespalib::slime::Inspector;
+
+namespace proton::matching {
+
+ProfileSamples::Query::Query() = default;
+ProfileSamples::Query::~Query() = default;
+
+void ProfileSamples::Query::add_report(const std::string& phase, const Inspector& report) {
+    if (!report.valid()) {
+        return;
+    }
+    auto& tasks = _phases[phase];
+    auto& total = tasks[phase_total];
+    total.count += 1;
+    total.time_ms += report["total_time_ms"].asDouble();
+    const Inspector& roots = report["roots"];
+    for (size_t i = 0; i < roots.entries(); ++i) {
+        auto& task = tasks[roots[i]["name"].asString().make_string()];
+        task.count += roots[i]["count"].asLong();
+        task.time_ms += roots[i]["self_time_ms"].asDouble();
+    }
+}
+
+ProfileSamples::ProfileSamples() : _queries(0), _phases() {
+}
+
+ProfileSamples::ProfileSamples(const ProfileSamples&) = default;
+ProfileSamples& ProfileSamples::operator=(const ProfileSamples&) = default;
+ProfileSamples::~ProfileSamples() = default;
+
+size_t ProfileSamples::bucket_of(double time_ms) noexcept {
+    double time_us = time_ms * 1000.0;
+    if (!(time_us >= 1.0)) {
+        return 0;
+    }
+    return std::min(num_buckets - 1, size_t(1 + std::ilogb(time_us)));
+}
+
+const ProfileSamples::Task* ProfileSamples::lookup(const std::string& phase, const std::string& task) const {
+    auto phase_pos = _phases.find(phase);
+    if (phase_pos == _phases.end()) {
+        return nullptr;
+    }
+    auto task_pos = phase_pos->second.find(task);
+    return (task_pos != phase_pos->second.end()) ? &task_pos->second : nullptr;
+}
+
+void ProfileSamples::add(const Query& query) {
+    ++_queries;
+    for (const auto& [phase, tasks] : query._phases) {
+        auto& my_tasks = _phases[phase];
+        for (const auto& [name, total] : tasks) {
+            auto& task = my_tasks[name];
+            task.queries += 1;
+            task.count += total.count;
+            task.time_ms += total.time_ms;
+            task.histogram[bucket_of(total.time_ms)] += 1;
+        }
+    }
+}
+
+void ProfileSamples::merge(const ProfileSamples& rhs) {
+    _queries += rhs._queries;
+    for (const auto& [phase, tasks] : rhs._phases) {
+        auto& my_tasks = _phases[phase];
+        for (const auto& [name, rhs_task] : tasks) {
+            auto& task = my_tasks[name];
+            task.queries += rhs_task.queries;
+            task.count += rhs_task.count;
+            task.time_ms += rhs_task.time_ms;
+            for (size_t i = 0; i < num_buckets; ++i) {
+                task.histogram[i] += rhs_task.histogram[i];
+            }
+        }
+    }
+}
+
+void ProfileSamples::to_slime(Cursor& obj) const {
+    obj.setLong("queries", _queries);
+    Cursor& phases = obj.setObject("phases");
+    for (const auto& [phase, tasks] : _phases) {
+        Cursor& tasks_obj = phases.setObject(phase);
+        for (const auto& [name, task] : tasks) {
+            Cursor& task_obj = tasks_obj.setObject(name);
+            task_obj.setLong("queries", task.queries);
+            task_obj.setLong("count", task.count);
+            task_obj.setDouble("time_ms", task.time_ms);
+            Cursor& histogram = task_obj.setArray("histogram_us");
+            // skip trailing empty buckets, bucket i has upper limit 2^i us
+            size_t used = num_buckets;
+            while ((used > 0) && (task.histogram[used - 1] == 0)) {
+                --used;
+            }
+            for (size_t i = 0; i < used; ++i) {
+                histogram.addLong(task.histogram[i]);
+            }
+        }
+    }
+}
+
+} // namespace proton::matching
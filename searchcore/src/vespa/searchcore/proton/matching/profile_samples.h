@@ -0,0 +1,78 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace vespalib::slime {
+struct Cursor;
+struct Inspector;
+} // namespace vespalib::slime
+
+namespace proton::matching {
+
+/**
+ * Aggregated execution profiles for a sample of the queries run with
+ * a rank profile (see the 'vespa.trace.profile_sample_interval' rank
+ * property). For each phase (match, first_phase, second_phase) and
+ * task (search iterator or feature executor), the total count and
+ * self time is tracked, together with a histogram of the self time
+ * spent on the task per sampled query.
+ **/
+class ProfileSamples {
+public:
+    // bucket 0 is [0, 1) us, bucket i is [2^(i-1), 2^i) us, the last bucket is open ended
+    static constexpr size_t num_buckets = 24;
+    using Histogram = std::array<uint64_t, num_buckets>;
+
+    struct Task {
+        uint64_t  queries;
+        uint64_t  count;
+        double    time_ms;
+        Histogram histogram;
+        Task() noexcept : queries(0), count(0), time_ms(0.0), histogram() {}
+    };
+
+    /**
+     * The profile of a single query, summed over the (flat) profiler
+     * reports from all match threads.
+     **/
+    class Query {
+    private:
+        friend ProfileSamples;
+        struct Total {
+            uint64_t count = 0;
+            double   time_ms = 0.0;
+        };
+        std::map<std::string, std::map<std::string, Total>> _phases;
+
+    public:
+        Query();
+        ~Query();
+        void add_report(const std::string& phase, const vespalib::slime::Inspector& report);
+    };
+
+private:
+    using TaskMap = std::map<std::string, Task>;
+    uint64_t                       _queries;
+    std::map<std::string, TaskMap> _phases;
+
+public:
+    static constexpr const char* phase_total = "[total]";
+
+    ProfileSamples();
+    ProfileSamples(const ProfileSamples&);
+    ProfileSamples& operator=(const ProfileSamples&);
+    ~ProfileSamples();
+    static size_t bucket_of(double time_ms) noexcept;
+    uint64_t queries() const noexcept { return _queries; }
+    const Task* lookup(const std::string& phase, const std::string& task) const;
+    void add(const Query& query);
+    void merge(const ProfileSamples& rhs);
+    void to_slime(vespalib::slime::Cursor& obj) const;
+};
+
+} // namespace proton::matching
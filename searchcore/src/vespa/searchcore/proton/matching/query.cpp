@@ -26,6 +26,7 @@
 #include <vespa/vespalib/util/issue.h>
 #include <vespa/vespalib/util/thread_bundle.h>
 
+#include <charconv>
 #include <queue>
 
 #include <vespa/log/log.h>
@@ -43,7 +44,9 @@ using search::fef::ITermData;
 using search::fef::MatchData;
 using search::fef::MatchDataLayout;
 using search::query::LocationTerm;
+using search::query::NearestNeighborTerm;
 using search::query::Node;
+using search::query::NumberTerm;
 using search::query::QueryTreeCreator;
 using search::query::TemplateTermVisitor;
 using search::query::Weight;
@@ -56,6 +59,7 @@ using search::queryeval::IRequestContext;
 using search::queryeval::MatchingPhase;
 using search::queryeval::RankBlueprint;
 using search::queryeval::SearchIterator;
+using search::queryeval::SharedScoreThreshold;
 using std::string;
 using std::vector;
 using vespalib::Issue;
@@ -113,6 +117,45 @@ std::vector<LocationTerm*> find_location_terms(Node* tree) {
     return locations;
 }
 
+using EqualityFilters = std::vector<std::pair<string, int64_t>>;
+
+bool is_integer_equality(const NumberTerm& term, int64_t& value) {
+    const string& str = term.getTerm();
+    auto          res = std::from_chars(str.data(), str.data() + str.size(), value);
+    return (res.ec == std::errc()) && (res.ptr == str.data() + str.size());
+}
+
+// Annotates nearest neighbor terms with the integer equality filters that all hits must satisfy,
+// i.e. number terms that are siblings in an AND, or in an AND that is the first child of a RANK or
+// ANDNOT, on the path from the root. A partitioned nearest neighbor index uses this to select a partition.
+void annotate_nearest_neighbor_terms(Node* node, EqualityFilters filters) {
+    if (auto* nn_term = dynamic_cast<NearestNeighborTerm*>(node)) {
+        for (const auto& [field_name, value] : filters) {
+            nn_term->add_equality_filter(field_name, value);
+        }
+    } else if (auto* and_node = dynamic_cast<search::query::And*>(node)) {
+        for (Node* child : and_node->getChildren()) {
+            auto*   term = dynamic_cast<NumberTerm*>(child);
+            int64_t value = 0;
+            if (term != nullptr && is_integer_equality(*term, value)) {
+                filters.emplace_back(term->getView(), value);
+            }
+        }
+        for (Node* child : and_node->getChildren()) {
+            annotate_nearest_neighbor_terms(child, filters);
+        }
+    } else if (node->isIntermediate()) {
+        auto& children = static_cast<search::query::Intermediate*>(node)->getChildren();
+        bool  first_child_inherits = (dynamic_cast<search::query::Rank*>(node) != nullptr) ||
+                                    (dynamic_cast<search::query::AndNot*>(node) != nullptr) ||
+                                    (dynamic_cast<search::query::LabelWrapper*>(node) != nullptr);
+        for (size_t i = 0; i < children.size(); ++i) {
+            annotate_nearest_neighbor_terms(children[i], (i == 0 && first_child_inherits) ? filters
+                                                                                         : EqualityFilters());
+        }
+    }
+}
+
 GeoLocationSpec parse_location_string(const string& str) {
     GeoLocationSpec empty;
     if (str.empty()) {
@@ -209,6 +252,7 @@ bool Query::buildTree(const SerializedQueryTree& queryTree, const string& locati
         _query_tree = UnpackingIteratorsOptimizer::optimize(std::move(_query_tree), bool(_whiteListBlueprint));
         ResolveViewVisitor resolve_visitor(resolver, indexEnv);
         _query_tree->accept(resolve_visitor);
+        annotate_nearest_neighbor_terms(_query_tree.get(), EqualityFilters());
         NeedsRankingVisitor need_ranking_visitor;
         _query_tree->accept(need_ranking_visitor);
         _needs_ranking = need_ranking_visitor.needs_ranking();
@@ -258,6 +302,7 @@ void Query::optimize(InFlow in_flow, bool sort_by_cost, bool keep_order) {
 }
 
 void Query::fetchPostings(const ExecuteInfo& executeInfo) {
+    _blueprint->prefetchPostings();
     _blueprint->fetchPostings(executeInfo);
 }
 
@@ -402,6 +447,10 @@ void Query::set_matching_phase(MatchingPhase matching_phase) const noexcept {
     _blueprint->set_matching_phase(matching_phase);
 }
 
+void Query::set_first_phase_score_threshold(const SharedScoreThreshold* threshold) const noexcept {
+    _blueprint->set_first_phase_score_threshold(threshold);
+}
+
 Blueprint::HitEstimate Query::estimate() const {
     return _blueprint->getState().estimate();
 }
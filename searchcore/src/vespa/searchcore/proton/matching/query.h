@@ -142,6 +142,7 @@ public:
 
     void freeze();
     void set_matching_phase(search::queryeval::MatchingPhase matching_phase) const noexcept;
+    void set_first_phase_score_threshold(const search::queryeval::SharedScoreThreshold* threshold) const noexcept;
 
     /**
      * Create the actual search iterator tree used to find matches.
@@ -0,0 +1,137 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "result_cache.h"
+
+#include <vespa/searchlib/common/idocumentmetastore.h>
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/searchlib/fef/properties.h>
+
+#include <vespa/vespalib/stllike/lrucache_map.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+using search::fef::Properties;
+using search::fef::Property;
+
+namespace proton::matching {
+
+namespace {
+
+void append(std::string& key, std::string_view value) {
+    uint32_t len = value.size();
+    key.append(reinterpret_cast<const char*>(&len), sizeof(len));
+    key.append(value);
+}
+
+// Properties are stored in a hash map; sort keys to make the
+// serialized form independent of insertion order.
+struct PropertiesCollector : search::fef::IPropertiesVisitor {
+    std::vector<std::pair<std::string_view, Property>> props;
+    void visitProperty(const Property::Value& key, const Property& values) override {
+        props.emplace_back(key, values);
+    }
+};
+
+void append(std::string& key, const Properties& properties) {
+    PropertiesCollector collector;
+    properties.visitProperties(collector);
+    std::sort(collector.props.begin(), collector.props.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    append(key, std::to_string(collector.props.size()));
+    for (const auto& [name, values] : collector.props) {
+        append(key, name);
+        append(key, std::to_string(values.size()));
+        for (uint32_t i = 0; i < values.size(); ++i) {
+            append(key, values.getAt(i));
+        }
+    }
+}
+
+} // namespace
+
+ResultCache::DataVersion::DataVersion(search::SerialNum serial_num_in, const search::IDocumentMetaStore& meta_store,
+                                      uint32_t docid_limit_in) noexcept
+    : serial_num(serial_num_in),
+      generation(meta_store.getCurrentGeneration()),
+      docid_limit(docid_limit_in),
+      active_lids(meta_store.getNumActiveLids()) {
+}
+
+ResultCache::ResultCache(size_t max_entries, vespalib::duration max_age)
+    : _lock(), _cache(max_entries), _max_age(max_age), _stats() {
+}
+
+ResultCache::~ResultCache() = default;
+
+bool ResultCache::can_cache(const SearchRequest& request) {
+    return request.sessionId.empty() && (request.trace().getLevel() == 0) &&
+           (request.propertiesMap.trace().numKeys() == 0);
+}
+
+bool ResultCache::can_cache(const SearchReply& reply) {
+    const auto& coverage = reply.coverage;
+    return !coverage.wasDegradedByMatchPhase() && !coverage.wasDegradedByTimeout() &&
+           !coverage.was_degraded_by_ann_timeout() && (coverage.getCovered() == coverage.getActive());
+}
+
+std::string ResultCache::make_key(const SearchRequest& request) {
+    std::string key;
+    append(key, request.getSerializedQueryTree().cache_key());
+    append(key, std::to_string(request.offset));
+    append(key, std::to_string(request.maxhits));
+    append(key, request.sortSpec);
+    append(key, std::string_view(request.groupSpec.data(), request.groupSpec.size()));
+    append(key, request.location);
+    append(key, request.propertiesMap.rankProperties());
+    append(key, request.propertiesMap.featureOverrides());
+    append(key, request.propertiesMap.matchProperties());
+    append(key, request.propertiesMap.modelOverrides());
+    return key;
+}
+
+std::unique_ptr<SearchReply> ResultCache::lookup(const std::string& key, const DataVersion& version,
+                                                 vespalib::steady_time now) {
+    std::shared_ptr<const SearchReply> reply;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        Entry*                      entry = _cache.find_and_ref(key);
+        if (entry == nullptr) {
+            ++_stats.misses;
+            return {};
+        }
+        if (!(entry->version == version) || (now - entry->created > _max_age)) {
+            _cache.erase(key);
+            ++_stats.invalidated;
+            ++_stats.misses;
+            return {};
+        }
+        ++_stats.hits;
+        reply = entry->reply;
+    }
+    // Copy outside the lock; the cached reply is immutable
+    return std::make_unique<SearchReply>(*reply);
+}
+
+void ResultCache::insert(const std::string& key, const DataVersion& version, vespalib::steady_time now,
+                         const SearchReply& reply) {
+    auto                        copy = std::make_shared<const SearchReply>(reply);
+    std::lock_guard<std::mutex> guard(_lock);
+    _cache.insert(key, Entry{version, now, std::move(copy)});
+    ++_stats.inserts;
+}
+
+size_t ResultCache::size() const {
+    std::lock_guard<std::mutex> guard(_lock);
+    return _cache.size();
+}
+
+ResultCache::Stats ResultCache::get_stats() const {
+    std::lock_guard<std::mutex> guard(_lock);
+    return _stats;
+}
+
+} // namespace proton::matching
@@ -0,0 +1,102 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/common/serialnum.h>
+#include <vespa/vespalib/stllike/lrucache_map.h>
+#include <vespa/vespalib/util/generation.h>
+#include <vespa/vespalib/util/time.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace search {
+struct IDocumentMetaStore;
+}
+namespace search::engine {
+class SearchRequest;
+class SearchReply;
+} // namespace search::engine
+
+namespace proton::matching {
+
+/**
+ * Cache of search replies produced by a single Matcher (rank
+ * profile), used to answer identical queries arriving close in time
+ * (dashboards, pagination) without running the match loop again.
+ *
+ * A cached reply is only used if the data it was produced from is
+ * unchanged. This is tracked by the feed serial number together with
+ * the generation, docid limit and number of active lids of the
+ * document meta store. Changes that are not reflected by these (e.g.
+ * bucket activation, or a feed operation that is not yet visible
+ * when the reply is cached) are bounded by the max age of entries.
+ **/
+class ResultCache {
+public:
+    struct DataVersion {
+        search::SerialNum    serial_num;
+        vespalib::Generation generation;
+        uint32_t             docid_limit;
+        uint32_t             active_lids;
+        DataVersion() noexcept : serial_num(0), generation(), docid_limit(0), active_lids(0) {}
+        DataVersion(search::SerialNum serial_num_in, const search::IDocumentMetaStore& meta_store,
+                    uint32_t docid_limit_in) noexcept;
+        bool operator==(const DataVersion& rhs) const noexcept = default;
+    };
+
+    struct Stats {
+        size_t hits;
+        size_t misses;
+        size_t inserts;
+        size_t invalidated;
+        Stats() noexcept : hits(0), misses(0), inserts(0), invalidated(0) {}
+    };
+
+private:
+    using SearchReply = search::engine::SearchReply;
+    struct Entry {
+        DataVersion                        version;
+        vespalib::steady_time              created;
+        std::shared_ptr<const SearchReply> reply;
+    };
+    using Cache = vespalib::lrucache_map<vespalib::LruParam<std::string, Entry>>;
+
+    mutable std::mutex _lock;
+    Cache              _cache;
+    vespalib::duration _max_age;
+    Stats              _stats;
+
+public:
+    ResultCache(size_t max_entries, vespalib::duration max_age);
+    ~ResultCache();
+
+    /**
+     * Requests using search/grouping sessions or tracing can not be
+     * answered from the cache, as their side effects are needed.
+     **/
+    static bool can_cache(const search::engine::SearchRequest& request);
+    /**
+     * Only replies with full coverage are cached; a degraded reply
+     * (soft timeout, match phase limiting) depends on timing.
+     **/
+    static bool can_cache(const SearchReply& reply);
+    /**
+     * Key covering everything in the request that affects the reply
+     * of a given rank profile: the query tree, hit window, sorting,
+     * grouping, location and the rank, feature, match and model
+     * properties.
+     **/
+    static std::string make_key(const search::engine::SearchRequest& request);
+
+    // Returns a copy of the cached reply, or nullptr on miss.
+    std::unique_ptr<SearchReply> lookup(const std::string& key, const DataVersion& version,
+                                        vespalib::steady_time now);
+    void insert(const std::string& key, const DataVersion& version, vespalib::steady_time now,
+                const SearchReply& reply);
+    size_t size() const;
+    Stats get_stats() const;
+};
+
+} // namespace proton::matching
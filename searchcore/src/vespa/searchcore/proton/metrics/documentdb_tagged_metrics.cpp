@@ -166,6 +166,7 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::RankProfileMetrics
                                     "Number of nodes visited in approximate nearest-neighbor search", this),
       queries("queries", {}, "Number of queries executed", this),
       limitedQueries("limited_queries", {}, "Number of queries limited in match phase", this),
+      profiledQueries("profiled_queries", {}, "Number of queries sampled for execution profiling", this),
       approximate_nns_timed_out_queries("approximate_nns_timed_out_queries", {},
                                         "Number of queries hitting the approximate nearest-neighbor search timeout",
                                         this),
@@ -222,6 +223,7 @@ void DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::update(const
     approximate_nns_nodes_visited.inc(stats.approximate_nns_nodes_visited());
     queries.inc(stats.queries());
     limitedQueries.inc(stats.limited_queries());
+    profiledQueries.inc(stats.profiled_queries());
     approximate_nns_timed_out_queries.inc(stats.approximate_nns_timed_out_queries());
     softDoomedQueries.inc(stats.softDoomed());
     softDoomFactor.set(stats.softDoomFactor());
@@ -137,6 +137,7 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet {
             metrics::LongCountMetric     approximate_nns_nodes_visited;
             metrics::LongCountMetric     queries;
             metrics::LongCountMetric     limitedQueries;
+            metrics::LongCountMetric     profiledQueries;
             metrics::LongCountMetric     approximate_nns_timed_out_queries;
             metrics::LongCountMetric     softDoomedQueries;
             metrics::DoubleValueMetric   softDoomFactor;
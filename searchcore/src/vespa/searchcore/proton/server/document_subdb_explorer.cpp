@@ -2,6 +2,8 @@
 
 #include "document_subdb_explorer.h"
 
+#include "matchers_explorer.h"
+
 #include <vespa/searchcore/proton/attribute/attribute_manager_explorer.h>
 #include <vespa/searchcore/proton/attribute/attribute_writer_explorer.h>
 #include <vespa/searchcore/proton/docsummary/document_store_explorer.h>
@@ -21,6 +23,7 @@ const std::string DOCUMENT_STORE = "documentstore";
 const std::string ATTRIBUTE = "attribute";
 const std::string ATTRIBUTE_WRITER = "attributewriter";
 const std::string INDEX = "index";
+const std::string MATCHERS = "matchers";
 
 } // namespace
 
@@ -43,6 +46,9 @@ std::vector<std::string> DocumentSubDBExplorer::get_children_names() const {
     if (_subDb.getIndexManager()) {
         children.push_back(INDEX);
     }
+    if (_subDb.getMatchers()) {
+        children.push_back(MATCHERS);
+    }
     return children;
 }
 
@@ -69,6 +75,11 @@ std::unique_ptr<StateExplorer> DocumentSubDBExplorer::get_child(std::string_view
         if (idxMgr) {
             return std::make_unique<IndexManagerExplorer>(std::move(idxMgr));
         }
+    } else if (name == MATCHERS) {
+        auto matchers = _subDb.getMatchers();
+        if (matchers) {
+            return std::make_unique<MatchersExplorer>(std::move(matchers));
+        }
     }
     return {};
 }
@@ -47,6 +47,7 @@ class IDocumentRetriever;
 class IFeedView;
 class IIndexWriter;
 class IReplayConfig;
+class Matchers;
 class ISearchHandler;
 class ISummaryAdapter;
 class ISummaryManager;
@@ -138,6 +139,8 @@ public:
     virtual std::shared_ptr<IDocumentRetriever> getDocumentRetriever() = 0;
 
     virtual matching::MatchingStats getMatcherStats(const std::string& rankProfile) const = 0;
+    // The matchers (one per rank profile) used by this sub database, or nullptr if it is not searchable
+    virtual std::shared_ptr<Matchers> getMatchers() const = 0;
     virtual void close() = 0;
     virtual std::shared_ptr<IDocumentDBReference> getDocumentDBReference() = 0;
     virtual void tearDownReferences(IDocumentDBReferenceResolver& resolver) = 0;
@@ -49,6 +49,14 @@ MatchingStats Matchers::getStats(const std::string& name) const {
     return it != _rpmap.end() ? it->second->getStats() : MatchingStats();
 }
 
+std::map<std::string, matching::ProfileSamples> Matchers::get_profile_samples() const {
+    std::map<std::string, matching::ProfileSamples> result;
+    for (const auto& entry : _rpmap) {
+        result.emplace(entry.first, entry.second->get_profile_samples());
+    }
+    return result;
+}
+
 std::shared_ptr<Matcher> Matchers::lookup(const std::string& name) const {
     auto found = _rpmap.find(name);
     if (found == _rpmap.end()) {
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/searchcore/proton/matching/matching_stats.h>
+#include <vespa/searchcore/proton/matching/profile_samples.h>
 #include <vespa/searchlib/fef/ranking_assets_repo.h>
 #include <vespa/vespalib/stllike/hash_map.h>
 
@@ -31,6 +32,7 @@ public:
     void add(const std::string& name, std::shared_ptr<matching::Matcher> matcher);
     matching::MatchingStats getStats() const;
     matching::MatchingStats getStats(const std::string& name) const;
+    std::map<std::string, matching::ProfileSamples> get_profile_samples() const;
     std::shared_ptr<matching::Matcher> lookup(const std::string& name) const;
     const search::fef::RankingAssetsRepo& get_ranking_assets_repo() const noexcept { return _ranking_assets_repo; }
 };
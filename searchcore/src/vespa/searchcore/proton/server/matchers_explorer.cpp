@@ -0,0 +1,30 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "matchers_explorer.h"
+
+#include "matchers.h"
+
+#include <vespa/vespalib/data/slime/cursor.h>
+
+using vespalib::slime::Cursor;
+using vespalib::slime::Inserter;
+
+namespace proton {
+
+MatchersExplorer::MatchersExplorer(std::shared_ptr<const Matchers> matchers) : _matchers(std::move(matchers)) {
+}
+
+void MatchersExplorer::get_state(const Inserter& inserter, bool full) const {
+    Cursor& object = inserter.insertObject();
+    Cursor& profiles = object.setObject("rank_profiles");
+    for (const auto& [name, samples] : _matchers->get_profile_samples()) {
+        Cursor& profile = profiles.setObject(name);
+        if (full) {
+            samples.to_slime(profile.setObject("profile_samples"));
+        } else {
+            profile.setLong("profiled_queries", samples.queries());
+        }
+    }
+}
+
+} // namespace proton
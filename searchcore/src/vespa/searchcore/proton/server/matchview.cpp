@@ -39,13 +39,15 @@ using matching::SessionManager;
 
 MatchView::MatchView(Matchers::SP matchers, std::shared_ptr<IndexSearchable> indexSearchable,
                      std::shared_ptr<IAttributeManager> attrMgr, SessionManager& sessionMgr,
-                     IDocumentMetaStoreContext::SP metaStore, DocIdLimit& docIdLimit)
+                     IDocumentMetaStoreContext::SP metaStore, DocIdLimit& docIdLimit,
+                     const IGetSerialNum& getSerialNum)
     : _matchers(std::move(matchers)),
       _indexSearchable(std::move(indexSearchable)),
       _attrMgr(std::move(attrMgr)),
       _sessionMgr(sessionMgr),
       _metaStore(std::move(metaStore)),
-      _docIdLimit(docIdLimit) {
+      _docIdLimit(docIdLimit),
+      _getSerialNum(getSerialNum) {
 }
 
 MatchView::~MatchView() = default;
@@ -69,7 +71,7 @@ std::unique_ptr<SearchReply> MatchView::match(std::shared_ptr<const ISearchHandl
     const search::IDocumentMetaStore& dms = owned_objects.readGuard->get();
     const bucketdb::BucketDBOwner&    bucketDB = _metaStore->get().getBucketDB();
     return matcher->match(req, threadBundle, search_ctx, attribute_ctx, _sessionMgr, dms, bucketDB,
-                          std::move(owned_objects));
+                          _getSerialNum.getSerialNum(), std::move(owned_objects));
 }
 
 } // namespace proton
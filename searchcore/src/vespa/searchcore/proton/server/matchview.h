@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "igetserialnum.h"
 #include "matchers.h"
 
 #include <vespa/searchcore/proton/common/docid_limit.h>
@@ -34,6 +35,7 @@ class MatchView {
     SessionManager&                                 _sessionMgr;
     std::shared_ptr<IDocumentMetaStoreContext>      _metaStore;
     DocIdLimit&                                     _docIdLimit;
+    const IGetSerialNum&                            _getSerialNum;
 
     size_t getNumDocs() const { return _metaStore->get().getNumActiveLids(); }
 
@@ -44,7 +46,8 @@ public:
 
     MatchView(std::shared_ptr<Matchers> matchers, std::shared_ptr<searchcorespi::IndexSearchable> indexSearchable,
               std::shared_ptr<IAttributeManager> attrMgr, SessionManager& sessionMgr,
-              std::shared_ptr<IDocumentMetaStoreContext> metaStore, DocIdLimit& docIdLimit);
+              std::shared_ptr<IDocumentMetaStoreContext> metaStore, DocIdLimit& docIdLimit,
+              const IGetSerialNum& getSerialNum);
     ~MatchView();
 
     const std::shared_ptr<Matchers>& getMatchers() const noexcept { return _matchers; }
@@ -55,6 +58,7 @@ public:
     SessionManager& getSessionManager() const noexcept { return _sessionMgr; }
     const std::shared_ptr<IDocumentMetaStoreContext>& getDocumentMetaStore() const noexcept { return _metaStore; }
     DocIdLimit& getDocIdLimit() const noexcept { return _docIdLimit; }
+    const IGetSerialNum& getSerialNum() const noexcept { return _getSerialNum; }
 
     // Throws on error.
     std::shared_ptr<matching::Matcher> getMatcher(const std::string& rankProfile) const;
@@ -48,6 +48,7 @@
 #include <vespa/searchlib/attribute/interlock.h>
 #include <vespa/searchlib/common/packets.h>
 #include <vespa/searchlib/diskindex/posting_list_cache.h>
+#include <vespa/searchlib/queryeval/flow_calibrator.h>
 #include <vespa/searchlib/transactionlog/trans_log_server_explorer.h>
 #include <vespa/searchlib/transactionlog/translogserverapp.h>
 #include <vespa/searchlib/util/disk_space_calculator.h>
@@ -82,6 +83,8 @@ using search::DiskSpaceCalculator;
 using search::diskindex::IPostingListCache;
 using search::diskindex::PostingListCache;
 using search::engine::MonitorReply;
+using search::queryeval::flow::FlowCalibrator;
+using search::queryeval::flow::FlowCostTable;
 using search::transactionlog::DomainStats;
 using searchcorespi::common::IResourceUsageProvider;
 using searchcorespi::common::ResourceUsage;
@@ -132,6 +135,20 @@ void setFS4Compression(const ProtonConfig& proton) {
     fs4.SetCompressionType(convert(proton.packetcompresstype));
 }
 
+void setup_flow_cost_table(const ProtonConfig& proton) {
+    FlowCostTable table;
+    if (!proton.search.flow.costtable.empty()) {
+        table = FlowCostTable::load(proton.search.flow.costtable);
+    }
+    if (proton.search.flow.calibrate) {
+        table = FlowCalibrator().calibrate(table);
+    }
+    FlowCostTable::set(table);
+    if (table != FlowCostTable()) {
+        LOG(info, "Using flow cost table for query planning: %s", table.to_json().c_str());
+    }
+}
+
 DiskMemUsageSampler::Config diskMemUsageSamplerConfig(const ProtonConfig& proton, const vespalib::HwInfo& hwInfo) {
     // If user configures disk size to be 0, let proton resample the disk size periodically.
     bool should_resample_disk_capacity = (proton.hwinfo.disk.size == 0);
@@ -361,6 +378,7 @@ void Proton::init(const BootstrapConfig::SP& configSnapshot) {
 
     setBucketCheckSumType(protonConfig);
     setFS4Compression(protonConfig);
+    setup_flow_cost_table(protonConfig);
     _write_filter = std::make_shared<ResourceUsageWriteFilter>(hwInfo);
     _resource_usage_notifier = std::make_shared<ResourceUsageNotifier>(*_write_filter);
     _posting_list_cache = make_posting_list_cache(protonConfig);
@@ -369,7 +387,8 @@ void Proton::init(const BootstrapConfig::SP& configSnapshot) {
     _metricsEngine->addMetricsHook(*_metricsHook);
     _fileHeaderContext.setClusterName(protonConfig.clustername, protonConfig.basedir);
     _matchEngine = std::make_unique<MatchEngine>(protonConfig.numsearcherthreads, getNumThreadsPerSearch(),
-                                                 protonConfig.distributionkey, protonConfig.search.async);
+                                                 protonConfig.distributionkey, protonConfig.search.async,
+                                                 protonConfig.search.numa.pinning);
     _matchEngine->set_issue_forwarding(protonConfig.forwardIssues);
     _distributionKey = protonConfig.distributionkey;
     _summaryEngine = std::make_unique<SummaryEngine>(protonConfig.numsummarythreads, protonConfig.docsum.async);
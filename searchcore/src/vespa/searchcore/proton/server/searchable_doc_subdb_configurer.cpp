@@ -55,7 +55,8 @@ void SearchableDocSubDBConfigurer::reconfigureMatchView(const std::shared_ptr<Ma
                                                         const std::shared_ptr<IAttributeManager>& attrMgr) {
     auto curr = _searchView.get();
     auto matchView = std::make_shared<MatchView>(matchers, indexSearchable, attrMgr, curr->getSessionManager(),
-                                                 curr->getDocumentMetaStore(), curr->getDocIdLimit());
+                                                 curr->getDocumentMetaStore(), curr->getDocIdLimit(),
+                                                 curr->getSerialNum());
     reconfigureSearchView(matchView);
 }
 
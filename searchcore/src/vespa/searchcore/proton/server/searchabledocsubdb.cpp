@@ -191,7 +191,7 @@ void SearchableDocSubDB::initViews(const DocumentDBConfig& configSnapshot) {
     const IIndexManager::SP& indexMgr = getIndexManager();
     Matchers::SP             matchers = _configurer.createMatchers(configSnapshot);
     auto matchView = std::make_shared<MatchView>(std::move(matchers), indexMgr->getSearchable(), attrMgr,
-                                                 _owner.session_manager(), _metaStoreCtx, _docIdLimit);
+                                                 _owner.session_manager(), _metaStoreCtx, _docIdLimit, _getSerialNum);
     _rSearchView.set(
         SearchView::create(getSummaryManager()->createSummarySetup(
                                configSnapshot.getSummaryConfig(), configSnapshot.getJuniperrcConfig(),
@@ -296,6 +296,10 @@ MatchingStats SearchableDocSubDB::getMatcherStats(const std::string& rankProfile
     return _rSearchView.get()->getMatcherStats(rankProfile);
 }
 
+std::shared_ptr<Matchers> SearchableDocSubDB::getMatchers() const {
+    return _rSearchView.get()->getMatchers();
+}
+
 void SearchableDocSubDB::close() {
     _realGidToLidChangeHandler->close();
     Parent::close();
@@ -38,6 +38,7 @@ public:
         return _matchView->getDocumentMetaStore();
     }
     DocIdLimit& getDocIdLimit() const noexcept { return _matchView->getDocIdLimit(); }
+    const IGetSerialNum& getSerialNum() const noexcept { return _matchView->getSerialNum(); }
     matching::MatchingStats getMatcherStats(const std::string& rankProfile) const {
         return _matchView->getMatcherStats(rankProfile);
     }
@@ -501,6 +501,10 @@ MatchingStats StoreOnlyDocSubDB::getMatcherStats(const std::string& rankProfile)
     return {};
 }
 
+std::shared_ptr<Matchers> StoreOnlyDocSubDB::getMatchers() const {
+    return {};
+}
+
 void StoreOnlyDocSubDB::close() {
     assert(_writeService.master().isCurrentThread());
     search::IDocumentStore& store(_rSummaryMgr->getBackingStore());
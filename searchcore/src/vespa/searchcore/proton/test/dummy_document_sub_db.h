@@ -79,6 +79,7 @@ struct DummyDocumentSubDb : public IDocumentSubDB {
     search::IndexStats get_index_stats(bool) const override { return {}; }
     std::shared_ptr<IDocumentRetriever> getDocumentRetriever() override { return {}; }
     matching::MatchingStats getMatcherStats(const std::string&) const override { return {}; }
+    std::shared_ptr<Matchers> getMatchers() const override { return {}; }
     std::shared_ptr<IDocumentDBReference> getDocumentDBReference() override { return {}; }
 
     PendingLidTrackerBase& getUncommittedLidsTracker() override { return _pendingLidTracker; }
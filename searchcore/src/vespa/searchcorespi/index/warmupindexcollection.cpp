@@ -261,6 +261,7 @@ void WarmupTask::run() {
         LOG(debug, "Warming up %s", _bluePrint->asString().c_str());
         uint32_t dummy_docid_limit = 1337;
         _bluePrint->basic_plan(true, dummy_docid_limit);
+        _bluePrint->prefetchPostings();
         _bluePrint->fetchPostings(search::queryeval::ExecuteInfo::FULL);
         _matchData = _mdl.createMatchData();
         SearchIterator::UP it(_bluePrint->createSearch(*_matchData));
@@ -0,0 +1,106 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/queryeval/flow_calibrator.h>
+#include <vespa/vespalib/util/exception.h>
+#include <vespa/vespalib/util/signalhandler.h>
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <iostream>
+
+#include <vespa/log/log.h>
+LOG_SETUP("vespa-calibrate-flow-costs");
+
+using search::queryeval::flow::FlowCalibrator;
+using search::queryeval::flow::FlowCostTable;
+
+class Application {
+private:
+    FlowCalibrator::Params _params;
+    std::string            _base_file_name;
+
+    int parseOpts(int argc, char** argv);
+    void usage(const char* self);
+
+public:
+    Application();
+    ~Application();
+    int main(int argc, char** argv);
+};
+
+Application::Application() : _params(), _base_file_name() {
+}
+
+Application::~Application() = default;
+
+void Application::usage(const char* self) {
+    printf("Tool for calibrating the cost table used by query planning on this machine.\n");
+    printf("The calibrated table is written to stdout as json, and can be used by proton\n");
+    printf("by setting search.flow.costtable to the path of a file containing it.\n");
+    printf("Usage: %s [options]\n", self);
+    printf("\n");
+    printf("The options are:\n");
+    printf("-b file        Base table (json) with factors that are not calibrated.\n");
+    printf("-d docs        Number of documents in the synthetic corpus (default %u).\n", _params.docid_limit);
+    printf("-c children    Number of children for heap based iterators (default %u).\n", _params.num_heap_children);
+    printf("-t seconds     Time budget for each benchmarked case (default %g).\n", _params.budget_s);
+    printf("-h             Shows this help page.\n");
+}
+
+int Application::parseOpts(int argc, char** argv) {
+    int c = '?';
+    while ((c = getopt(argc, argv, "b:d:c:t:h")) != -1) {
+        switch (c) {
+        case 'b':
+            _base_file_name = optarg;
+            break;
+        case 'd':
+            _params.docid_limit = atoi(optarg) + 1;
+            break;
+        case 'c':
+            _params.num_heap_children = atoi(optarg);
+            break;
+        case 't':
+            _params.budget_s = atof(optarg);
+            break;
+        case 'h':
+            usage(argv[0]);
+            return EXIT_SUCCESS;
+        default:
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (_params.docid_limit < 1000 || _params.num_heap_children < 2 || _params.num_heap_children > 50 ||
+        _params.budget_s <= 0.0) {
+        std::cerr << "Invalid calibration parameters." << std::endl;
+        return EXIT_FAILURE;
+    }
+    return ~(EXIT_SUCCESS | EXIT_FAILURE);
+}
+
+int Application::main(int argc, char** argv) {
+    int ret = parseOpts(argc, argv);
+    if (ret == EXIT_FAILURE || ret == EXIT_SUCCESS) {
+        return ret;
+    }
+    FlowCostTable base;
+    if (!_base_file_name.empty()) {
+        try {
+            base = FlowCostTable::load(_base_file_name);
+        } catch (vespalib::Exception& e) {
+            std::cerr << e.getMessage() << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    auto table = FlowCalibrator(_params).calibrate(base);
+    std::cout << table.to_json() << std::endl;
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char** argv) {
+    vespalib::SignalHandler::PIPE.ignore();
+    Application app;
+    return app.main(argc, argv);
+}
@@ -25,6 +25,7 @@ public class ForceLoad {
                 "CountAggregationResult",
                 "AverageAggregationResult",
                 "ExpressionCountAggregationResult",
+                "HeavyHittersAggregationResult",
                 "hll.SparseSketch",
                 "hll.NormalSketch"
         };
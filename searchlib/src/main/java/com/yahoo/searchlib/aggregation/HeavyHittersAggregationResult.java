@@ -0,0 +1,169 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+package com.yahoo.searchlib.aggregation;
+
+import com.yahoo.searchlib.expression.IntegerResultNode;
+import com.yahoo.searchlib.expression.ResultNode;
+import com.yahoo.vespa.objects.Deserializer;
+import com.yahoo.vespa.objects.ObjectVisitor;
+import com.yahoo.vespa.objects.Serializer;
+
+import java.util.ArrayList;
+import java.util.Comparator;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Objects;
+
+/**
+ * This is an aggregated result holding the most frequent values of an expression (heavy hitters), tracked with
+ * bounded memory by a Space-Saving sketch. The count of each value is an upper bound on its frequency, and
+ * count - error is a lower bound. Sketches from different search nodes are merged into an approximate global
+ * top list.
+ */
+public class HeavyHittersAggregationResult extends AggregationResult {
+
+    public static final int classId = registerClass(0x4000 + 183, HeavyHittersAggregationResult.class, HeavyHittersAggregationResult::new);
+    public static final int DEFAULT_MAX_ENTRIES = 100;
+
+    private static final Comparator<Entry> BY_COUNT = Comparator.comparingLong(Entry::count).reversed()
+            .thenComparing(Entry::hash, Long::compareUnsigned);
+
+    /** A tracked value, with its estimated count and the maximal overestimation of that count. */
+    public record Entry(long hash, long count, long error, ResultNode value) {
+    }
+
+    private int maxEntries;
+    private Map<Long, Entry> entries = new LinkedHashMap<>();
+
+    /** Constructor used for deserialization. */
+    public HeavyHittersAggregationResult() {
+        this(DEFAULT_MAX_ENTRIES);
+    }
+
+    /** Constructs an instance tracking at most the given number of values. */
+    public HeavyHittersAggregationResult(int maxEntries) {
+        if (maxEntries < 1) throw new IllegalArgumentException("maxEntries must be positive: " + maxEntries);
+        this.maxEntries = maxEntries;
+    }
+
+    public int getMaxEntries() {
+        return maxEntries;
+    }
+
+    /** Returns the tracked values with the highest counts, highest first. */
+    public List<Entry> getHeavyHitters() {
+        List<Entry> result = new ArrayList<>(entries.values());
+        result.sort(BY_COUNT);
+        return result;
+    }
+
+    /** Adds a tracked value, as found by a search node. For testing. */
+    public HeavyHittersAggregationResult addEntry(long hash, long count, long error, ResultNode value) {
+        entries.put(hash, new Entry(hash, count, error, value));
+        return this;
+    }
+
+    private long minCount() {
+        if (entries.size() < maxEntries) return 0;
+        return entries.values().stream().mapToLong(Entry::count).min().orElse(0);
+    }
+
+    @Override
+    public ResultNode getRank() {
+        return new IntegerResultNode(entries.values().stream().mapToLong(Entry::count).max().orElse(0));
+    }
+
+    @Override
+    protected void onMerge(AggregationResult result) {
+        HeavyHittersAggregationResult other = (HeavyHittersAggregationResult) result;
+        long lhsMin = minCount();
+        long rhsMin = other.minCount();
+        List<Entry> merged = new ArrayList<>(entries.size() + other.entries.size());
+        for (Entry entry : entries.values()) {
+            Entry match = other.entries.get(entry.hash());
+            if (match != null) {
+                merged.add(new Entry(entry.hash(), entry.count() + match.count(), entry.error() + match.error(), entry.value()));
+            } else {
+                merged.add(new Entry(entry.hash(), entry.count() + rhsMin, entry.error() + rhsMin, entry.value()));
+            }
+        }
+        for (Entry entry : other.entries.values()) {
+            if ( ! entries.containsKey(entry.hash())) {
+                merged.add(new Entry(entry.hash(), entry.count() + lhsMin, entry.error() + lhsMin, entry.value()));
+            }
+        }
+        maxEntries = Math.max(maxEntries, other.maxEntries);
+        merged.sort(BY_COUNT);
+        entries = new LinkedHashMap<>();
+        for (Entry entry : merged.subList(0, Math.min(merged.size(), maxEntries))) {
+            entries.put(entry.hash(), entry);
+        }
+    }
+
+    @Override
+    protected int onGetClassId() {
+        return classId;
+    }
+
+    @Override
+    protected void onSerialize(Serializer buf) {
+        super.onSerialize(buf);
+        buf.putInt(null, maxEntries);
+        buf.putInt(null, entries.size());
+        for (Entry entry : entries.values()) {
+            buf.putLong(null, entry.hash());
+            buf.putLong(null, entry.count());
+            buf.putLong(null, entry.error());
+            serializeOptional(buf, entry.value());
+        }
+    }
+
+    @Override
+    protected void onDeserialize(Deserializer buf) {
+        super.onDeserialize(buf);
+        maxEntries = buf.getInt(null);
+        int numEntries = buf.getInt(null);
+        entries = new LinkedHashMap<>();
+        for (int i = 0; i < numEntries; i++) {
+            long hash = buf.getLong(null);
+            long count = buf.getLong(null);
+            long error = buf.getLong(null);
+            ResultNode value = (ResultNode) deserializeOptional(buf);
+            entries.put(hash, new Entry(hash, count, error, value));
+        }
+    }
+
+    @Override
+    protected boolean equalsAggregation(AggregationResult obj) {
+        HeavyHittersAggregationResult other = (HeavyHittersAggregationResult) obj;
+        return maxEntries == other.maxEntries && entries.equals(other.entries);
+    }
+
+    @Override
+    public HeavyHittersAggregationResult clone() {
+        HeavyHittersAggregationResult obj = (HeavyHittersAggregationResult) super.clone();
+        obj.entries = new LinkedHashMap<>();
+        for (Entry entry : entries.values()) {
+            ResultNode value = (entry.value() != null) ? (ResultNode) entry.value().clone() : null;
+            obj.entries.put(entry.hash(), new Entry(entry.hash(), entry.count(), entry.error(), value));
+        }
+        return obj;
+    }
+
+    @Override
+    public void visitMembers(ObjectVisitor visitor) {
+        super.visitMembers(visitor);
+        visitor.visit("maxEntries", maxEntries);
+        List<Entry> heavyHitters = getHeavyHitters();
+        for (int i = 0; i < heavyHitters.size(); i++) {
+            visitor.visit("value[" + i + "]", heavyHitters.get(i).value());
+            visitor.visit("count[" + i + "]", heavyHitters.get(i).count());
+            visitor.visit("error[" + i + "]", heavyHitters.get(i).error());
+        }
+    }
+
+    @Override
+    public int hashCode() {
+        return Objects.hash(super.hashCode(), maxEntries, entries);
+    }
+}
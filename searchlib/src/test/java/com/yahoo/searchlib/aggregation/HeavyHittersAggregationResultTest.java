@@ -0,0 +1,59 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+package com.yahoo.searchlib.aggregation;
+
+import com.yahoo.searchlib.expression.StringResultNode;
+import com.yahoo.vespa.objects.BufferSerializer;
+import org.junit.Test;
+
+import java.util.List;
+
+import static org.junit.Assert.assertEquals;
+
+public class HeavyHittersAggregationResultTest {
+
+    @Test
+    public void requireThatSketchesAreMerged() {
+        HeavyHittersAggregationResult a = new HeavyHittersAggregationResult(2)
+                .addEntry(1, 10, 0, new StringResultNode("x"))
+                .addEntry(2, 4, 0, new StringResultNode("y"));
+        HeavyHittersAggregationResult b = new HeavyHittersAggregationResult(2)
+                .addEntry(1, 3, 0, new StringResultNode("x"))
+                .addEntry(3, 6, 0, new StringResultNode("z"));
+        a.onMerge(b);
+
+        List<HeavyHittersAggregationResult.Entry> top = a.getHeavyHitters();
+        assertEquals(2, top.size());
+        assertEquals(new HeavyHittersAggregationResult.Entry(1, 13, 0, new StringResultNode("x")), top.get(0));
+        // "z" is missing from a, and is assumed to have the smallest count of a
+        assertEquals(new HeavyHittersAggregationResult.Entry(3, 10, 4, new StringResultNode("z")), top.get(1));
+        assertEquals(13, a.getRank().getInteger());
+    }
+
+    @Test
+    public void requireThatMergeIntoNonFullSketchKeepsCounts() {
+        HeavyHittersAggregationResult a = new HeavyHittersAggregationResult(3);
+        HeavyHittersAggregationResult b = new HeavyHittersAggregationResult(3)
+                .addEntry(7, 2, 0, new StringResultNode("x"))
+                .addEntry(8, 1, 0, new StringResultNode("y"));
+        a.onMerge(b);
+        assertEquals(b.getHeavyHitters(), a.getHeavyHitters());
+    }
+
+    @Test
+    public void requireThatSerializationDeserializationMatch() {
+        HeavyHittersAggregationResult from = new HeavyHittersAggregationResult(5)
+                .addEntry(-1, 7, 2, new StringResultNode("x"))
+                .addEntry(42, 3, 0, new StringResultNode("y"));
+        HeavyHittersAggregationResult to = new HeavyHittersAggregationResult();
+
+        BufferSerializer buffer = new BufferSerializer();
+        from.serialize(buffer);
+        buffer.flip();
+        to.deserialize(buffer);
+
+        assertEquals(5, to.getMaxEntries());
+        assertEquals(from.getHeavyHitters(), to.getHeavyHitters());
+        assertEquals(from, to);
+    }
+
+}
@@ -230,6 +230,24 @@ TEST(AttributeManagerTest, require_that_config_can_be_converted) {
         a.paged = true;
         EXPECT_TRUE(CC::convert(a).paged());
     }
+    {
+        CACA a;
+        EXPECT_EQ(0u, CC::convert(a).range_buckets());
+        a.rangebuckets = 32;
+        EXPECT_EQ(32u, CC::convert(a).range_buckets());
+    }
+    {
+        CACA a;
+        EXPECT_EQ(0u, CC::convert(a).max_delta_flushes());
+        a.maxdeltaflushes = 4;
+        EXPECT_EQ(4u, CC::convert(a).max_delta_flushes());
+    }
+    {
+        CACA a;
+        EXPECT_FALSE(CC::convert(a).get_dictionary_config().get_trigram_index());
+        a.dictionary.trigramindex = true;
+        EXPECT_TRUE(CC::convert(a).get_dictionary_config().get_trigram_index());
+    }
     { // tensor
         CACA a;
         a.datatype = CACAD::TENSOR;
@@ -262,6 +280,8 @@ TEST(AttributeManagerTest, require_that_config_can_be_converted) {
         EXPECT_EQ(16u, params.max_links_per_node());
         EXPECT_EQ(200u, params.neighbors_to_explore_at_insert());
         EXPECT_TRUE(params.multi_threaded_indexing());
+        EXPECT_EQ(0u, params.traversal_quantization_bits());
+        EXPECT_EQ("", params.partition_attribute());
     }
     { // hnsw index params (enabled)
         auto dm_in = AttributesConfig::Attribute::Distancemetric::ANGULAR;
@@ -272,6 +292,8 @@ TEST(AttributeManagerTest, require_that_config_can_be_converted) {
         a.index.hnsw.maxlinkspernode = 32;
         a.index.hnsw.neighborstoexploreatinsert = 300;
         a.index.hnsw.multithreadedindexing = false;
+        a.index.hnsw.traversalquantizationbits = 2;
+        a.index.hnsw.partitionattribute = "tenant";
         auto out = ConfigConverter::convert(a);
         EXPECT_TRUE(out.hnsw_index_params().has_value());
         const auto& params = out.hnsw_index_params().value();
@@ -279,6 +301,8 @@ TEST(AttributeManagerTest, require_that_config_can_be_converted) {
         EXPECT_EQ(300u, params.neighbors_to_explore_at_insert());
         EXPECT_TRUE(params.distance_metric() == dm_out);
         EXPECT_FALSE(params.multi_threaded_indexing());
+        EXPECT_EQ(2u, params.traversal_quantization_bits());
+        EXPECT_EQ("tenant", params.partition_attribute());
     }
     { // hnsw index params (disabled)
         CACA a;
@@ -0,0 +1,201 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/enum_trigram_index.h>
+#include <vespa/searchlib/attribute/enumstore.h>
+#include <vespa/searchlib/attribute/search_context.h>
+#include <vespa/searchlib/attribute/stringbase.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchlib/queryeval/executeinfo.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using search::AttributeFactory;
+using search::AttributeVector;
+using search::DictionaryConfig;
+using search::EnumStoreT;
+using search::QueryTermSimple;
+using search::StringAttribute;
+using search::attribute::BasicType;
+using search::attribute::CollectionType;
+using search::attribute::Config;
+using search::attribute::EnumTrigramIndex;
+using search::attribute::SearchContextParams;
+using search::fef::TermFieldMatchData;
+using search::queryeval::ExecuteInfo;
+using vespalib::datastore::EntryRef;
+
+namespace {
+
+using Query = EnumTrigramIndex::Query;
+
+std::vector<EntryRef> find_candidates(const EnumTrigramIndex& index, const std::optional<Query>& query) {
+    EXPECT_TRUE(query.has_value());
+    return query ? index.find_candidates(*query) : std::vector<EntryRef>();
+}
+
+TEST(EnumTrigramIndexTest, buckets_are_case_folded_and_unique) {
+    EXPECT_EQ(0u, EnumTrigramIndex::get_buckets("ab").size());
+    EXPECT_EQ(1u, EnumTrigramIndex::get_buckets("abc").size());
+    EXPECT_EQ(2u, EnumTrigramIndex::get_buckets("abcd").size());
+    EXPECT_EQ(1u, EnumTrigramIndex::get_buckets("aaaaaa").size());
+    EXPECT_EQ(EnumTrigramIndex::get_buckets("abc"), EnumTrigramIndex::get_buckets("AbC"));
+    EXPECT_EQ(EnumTrigramIndex::get_buckets("\xc3\xa6\xc3\xb8\xc3\xa5"),
+              EnumTrigramIndex::get_buckets("\xc3\x86\xc3\x98\xc3\x85"));
+}
+
+TEST(EnumTrigramIndexTest, regex_query_uses_required_literal_runs) {
+    EXPECT_EQ(2u, EnumTrigramIndex::make_regex_query("foo.*bar")->buckets.size());
+    EXPECT_EQ(3u, EnumTrigramIndex::make_regex_query("^hello$")->buckets.size());
+    EXPECT_EQ(1u, EnumTrigramIndex::make_regex_query("(foo)bar")->buckets.size());
+    EXPECT_EQ(2u, EnumTrigramIndex::make_regex_query("ab*cdef")->buckets.size());
+    EXPECT_EQ(1u, EnumTrigramIndex::make_regex_query("ab?cde")->buckets.size());
+    EXPECT_EQ(5u, EnumTrigramIndex::make_regex_query("foo\\.bar")->buckets.size());
+    auto query = EnumTrigramIndex::make_regex_query("foo.*bar");
+    EXPECT_EQ(query->buckets.size(), query->min_hits);
+}
+
+TEST(EnumTrigramIndexTest, regex_query_is_not_made_when_no_literal_run_is_required) {
+    EXPECT_FALSE(EnumTrigramIndex::make_regex_query("foo|bar").has_value());
+    EXPECT_FALSE(EnumTrigramIndex::make_regex_query("ab.cd").has_value());
+    EXPECT_FALSE(EnumTrigramIndex::make_regex_query("abc{2}de").has_value());
+    EXPECT_FALSE(EnumTrigramIndex::make_regex_query("(foo)\\1").has_value());
+    EXPECT_FALSE(EnumTrigramIndex::make_regex_query("fo[o").has_value());
+}
+
+TEST(EnumTrigramIndexTest, fuzzy_query_allows_three_missing_trigrams_per_edit) {
+    auto query = EnumTrigramIndex::make_fuzzy_query("abcdefgh", 1);
+    ASSERT_TRUE(query.has_value());
+    EXPECT_EQ(6u, query->buckets.size());
+    EXPECT_EQ(3u, query->min_hits);
+    EXPECT_FALSE(EnumTrigramIndex::make_fuzzy_query("abcdefgh", 2).has_value());
+    EXPECT_FALSE(EnumTrigramIndex::make_fuzzy_query("abcd", 1).has_value());
+}
+
+TEST(EnumTrigramIndexTest, candidates_follow_added_and_removed_values) {
+    EnumTrigramIndex index;
+    index.add(EntryRef(1), "foobar");
+    index.add(EntryRef(2), "foobaz");
+    index.add(EntryRef(3), "xfooybarx");
+    index.add(EntryRef(4), "something");
+    index.freeze();
+    EXPECT_EQ((std::vector<EntryRef>{EntryRef(1), EntryRef(3)}),
+              find_candidates(index, EnumTrigramIndex::make_regex_query("foo.*bar")));
+    EXPECT_EQ((std::vector<EntryRef>{EntryRef(1), EntryRef(2)}),
+              find_candidates(index, EnumTrigramIndex::make_fuzzy_query("fooba", 0)));
+    index.remove(EntryRef(1), "foobar");
+    index.freeze();
+    EXPECT_EQ((std::vector<EntryRef>{EntryRef(3)}),
+              find_candidates(index, EnumTrigramIndex::make_regex_query("foo.*bar")));
+    EXPECT_LT(0u, index.get_memory_usage().allocatedBytes());
+}
+
+TEST(EnumTrigramIndexTest, build_adds_all_visited_values) {
+    EnumTrigramIndex index;
+    index.add(EntryRef(7), "stale");
+    index.build([](const EnumTrigramIndex::ValueCallback& callback) {
+        callback(EntryRef(1), "foobar");
+        callback(EntryRef(2), "barfoo");
+    });
+    index.freeze();
+    EXPECT_EQ((std::vector<EntryRef>{EntryRef(1), EntryRef(2)}),
+              find_candidates(index, EnumTrigramIndex::make_regex_query("foo")));
+    EXPECT_EQ((std::vector<EntryRef>{}), find_candidates(index, EnumTrigramIndex::make_regex_query("stale")));
+}
+
+/*
+ * Runs the same regex and fuzzy searches against a fast-search string
+ * attribute with and without a trigram index.
+ */
+class AttributeFixture {
+    std::shared_ptr<AttributeVector> _plain;
+    std::shared_ptr<AttributeVector> _indexed;
+
+    static Config make_config(bool trigram_index) {
+        Config cfg(BasicType::STRING, CollectionType::SINGLE, true);
+        cfg.set_dictionary_config(
+            DictionaryConfig(DictionaryConfig::Type::BTREE, DictionaryConfig::Match::UNCASED, trigram_index));
+        return cfg;
+    }
+
+public:
+    explicit AttributeFixture(uint32_t num_docs)
+        : _plain(AttributeFactory::createAttribute("plain", make_config(false))),
+          _indexed(AttributeFactory::createAttribute("indexed", make_config(true))) {
+        for (auto* attr : {_plain.get(), _indexed.get()}) {
+            attr->addDocs(num_docs);
+            attr->commit();
+        }
+    }
+
+    void set(uint32_t docid, const std::string& value) {
+        for (auto* attr : {_plain.get(), _indexed.get()}) {
+            dynamic_cast<StringAttribute&>(*attr).update(docid, value);
+        }
+    }
+
+    void commit() {
+        _plain->commit();
+        _indexed->commit();
+    }
+
+    const EnumTrigramIndex* trigram_index() const {
+        using StringEnumStore = EnumStoreT<const char*>;
+        EXPECT_EQ(nullptr, dynamic_cast<const StringEnumStore&>(*_plain->getEnumStoreBase()).get_trigram_index());
+        return dynamic_cast<const StringEnumStore&>(*_indexed->getEnumStoreBase()).get_trigram_index();
+    }
+
+    static std::vector<uint32_t> search(const AttributeVector& attr, const std::string& term,
+                                        QueryTermSimple::Type type) {
+        auto ctx = attr.getSearch(std::make_unique<QueryTermSimple>(term, type), SearchContextParams());
+        TermFieldMatchData md;
+        ctx->fetchPostings(ExecuteInfo::FULL, true);
+        auto itr = ctx->createIterator(&md, true);
+        itr->initRange(1, attr.getCommittedDocIdLimit());
+        std::vector<uint32_t> result;
+        for (itr->seek(1); !itr->isAtEnd(); itr->seek(itr->getDocId() + 1)) {
+            result.push_back(itr->getDocId());
+        }
+        return result;
+    }
+
+    void verify(const std::string& term, QueryTermSimple::Type type, size_t min_expected_hits) const {
+        SCOPED_TRACE(term);
+        auto expected = search(*_plain, term, type);
+        EXPECT_LE(min_expected_hits, expected.size());
+        EXPECT_EQ(expected, search(*_indexed, term, type));
+    }
+};
+
+TEST(EnumTrigramIndexTest, regex_and_fuzzy_search_give_same_result_with_trigram_index) {
+    constexpr uint32_t num_docs = 2000;
+    AttributeFixture   f(num_docs);
+    for (uint32_t docid = 1; docid < num_docs; ++docid) {
+        f.set(docid, "value" + std::to_string(docid * 7919 % 1000) + ((docid % 10 == 0) ? "FooBar" : "xyz"));
+    }
+    f.commit();
+    const auto* index = f.trigram_index();
+    ASSERT_NE(nullptr, index);
+    auto verify_searches = [&f]() {
+        f.verify("foo.*bar", QueryTermSimple::Type::REGEXP, 1);
+        f.verify("^value12[0-9]", QueryTermSimple::Type::REGEXP, 1);
+        f.verify("e99+xyz", QueryTermSimple::Type::REGEXP, 0);
+        f.verify("value123xyz", QueryTermSimple::Type::FUZZYTERM, 1);
+        f.verify("valeu450foobar", QueryTermSimple::Type::FUZZYTERM, 1);
+    };
+    verify_searches();
+
+    // Replaced values are removed from the index, and new values are added
+    for (uint32_t docid = 1; docid < num_docs; docid += 3) {
+        f.set(docid, "other" + std::to_string(docid) + "foobar");
+    }
+    f.commit();
+    EXPECT_EQ(index, f.trigram_index());
+    verify_searches();
+    f.verify("other1.*foobar", QueryTermSimple::Type::REGEXP, 1);
+}
+
+} // namespace
+
+GTEST_MAIN_RUN_ALL_TESTS()
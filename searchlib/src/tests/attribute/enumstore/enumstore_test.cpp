@@ -1,8 +1,10 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/searchlib/attribute/enum_store_loaders.h>
+#include <vespa/searchlib/attribute/executor_thread_bundle.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/test/memory_allocator_observer.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 
 #include <vespa/searchlib/attribute/enumstore.hpp>
 
@@ -608,6 +610,34 @@ TYPED_TEST(LoaderTest, store_is_instantiated_with_non_enumerated_loader) {
     this->expect_posting_idx(3, 103);
 }
 
+TEST(EnumStoreTest, parallel_sort_of_loaded_enums_matches_sort_in_calling_thread) {
+    using attribute::LoadedEnumAttribute;
+    attribute::LoadedEnumAttributeVector loaded;
+    for (uint32_t docid = 0; docid < 256 * 1024; ++docid) {
+        // Enum 0 is present in all documents, to check that a dominating value is split across partitions
+        for (uint32_t i = 0; i < 5; ++i) {
+            uint32_t e = (i == 0) ? 0 : 1 + (docid * 7919 + i * 104729) % 1000;
+            loaded.emplace_back(e, docid, i);
+        }
+    }
+    ASSERT_LE(attribute::parallel_sort_loaded_enums_limit, loaded.size());
+    auto exp_loaded = loaded;
+    attribute::sortLoadedByEnum(exp_loaded);
+    vespalib::ThreadStackExecutor   executor(4);
+    attribute::ExecutorThreadBundle thread_bundle(executor, 4);
+    attribute::sortLoadedByEnum(loaded, thread_bundle);
+    ASSERT_EQ(exp_loaded.size(), loaded.size());
+    EXPECT_TRUE(std::is_sorted(loaded.begin(), loaded.end(), LoadedEnumAttribute::EnumCompare()));
+    size_t mismatches = 0;
+    for (size_t i = 0; i < loaded.size(); ++i) {
+        if (loaded[i].getEnum() != exp_loaded[i].getEnum() || loaded[i].getDocId() != exp_loaded[i].getDocId() ||
+            loaded[i].getWeight() != exp_loaded[i].getWeight()) {
+            ++mismatches;
+        }
+    }
+    EXPECT_EQ(0u, mismatches);
+}
+
 template <typename EnumStoreTypeAndDictionaryType> class EnumStoreDictionaryTest : public ::testing::Test {
 public:
     using EnumStoreType = typename EnumStoreTypeAndDictionaryType::EnumStoreType;
@@ -0,0 +1,210 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/floatbase.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/attribute/numeric_range_buckets.h>
+#include <vespa/searchlib/attribute/search_context.h>
+#include <vespa/searchlib/attribute/singlenumericpostattribute.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchlib/queryeval/executeinfo.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+
+using search::AttributeFactory;
+using search::AttributeVector;
+using search::EnumAttribute;
+using search::FloatingPointAttributeTemplate;
+using search::IntegerAttributeTemplate;
+using search::QueryTermSimple;
+using search::SingleValueNumericPostingAttribute;
+using search::attribute::BasicType;
+using search::attribute::CollectionType;
+using search::attribute::Config;
+using search::attribute::NumericRangeBuckets;
+using search::attribute::SearchContextParams;
+using search::fef::TermFieldMatchData;
+using search::queryeval::ExecuteInfo;
+
+namespace {
+
+using IntBuckets = NumericRangeBuckets<int32_t>;
+
+std::vector<IntBuckets::ValueCount> make_value_counts(std::vector<std::pair<int32_t, uint32_t>> value_counts) {
+    return value_counts;
+}
+
+TEST(NumericRangeBucketsTest, lower_bounds_split_documents_evenly) {
+    auto value_counts = make_value_counts({{1, 10}, {2, 10}, {3, 10}, {4, 10}, {5, 10}, {6, 10}, {7, 10}, {8, 10}});
+    EXPECT_EQ((std::vector<int32_t>{3, 5, 7}), IntBuckets::select_lower_bounds(value_counts, 4));
+    EXPECT_EQ((std::vector<int32_t>{5}), IntBuckets::select_lower_bounds(value_counts, 2));
+    EXPECT_EQ((std::vector<int32_t>{}), IntBuckets::select_lower_bounds(value_counts, 1));
+}
+
+TEST(NumericRangeBucketsTest, fewer_buckets_are_used_when_a_value_dominates) {
+    auto value_counts = make_value_counts({{1, 100}, {2, 1}, {3, 1}});
+    EXPECT_EQ((std::vector<int32_t>{2, 3}), IntBuckets::select_lower_bounds(value_counts, 4));
+}
+
+TEST(NumericRangeBucketsTest, values_are_mapped_to_buckets_in_dictionary_order) {
+    vespalib::GenerationHolder   holder;
+    NumericRangeBuckets<double>  buckets({1.0, 2.0}, 64, 64, holder);
+    EXPECT_EQ(3u, buckets.num_buckets());
+    EXPECT_EQ(0u, buckets.bucket_of(std::numeric_limits<double>::quiet_NaN()));
+    EXPECT_EQ(0u, buckets.bucket_of(-1e300));
+    EXPECT_EQ(0u, buckets.bucket_of(0.5));
+    EXPECT_EQ(1u, buckets.bucket_of(1.0));
+    EXPECT_EQ(1u, buckets.bucket_of(1.5));
+    EXPECT_EQ(2u, buckets.bucket_of(2.0));
+    EXPECT_EQ(2u, buckets.bucket_of(1e300));
+    EXPECT_EQ(2.0, buckets.lower_bound(2));
+}
+
+TEST(NumericRangeBucketsTest, bits_follow_value_changes_and_growth_triggers_rebuild) {
+    vespalib::GenerationHolder holder;
+    IntBuckets                 buckets({10}, 1000, 1000, holder);
+    for (uint32_t docid = 1; docid <= 64; ++docid) {
+        buckets.add(docid, 5);
+    }
+    buckets.finish_build();
+    EXPECT_EQ(64u, buckets.get_bits(0).countTrueBits());
+    buckets.remove(7, 5);
+    buckets.add(7, 10);
+    EXPECT_FALSE(buckets.get_bits(0).testBit(7));
+    EXPECT_TRUE(buckets.get_bits(1).testBit(7));
+    for (uint32_t docid = 100; docid < 355; ++docid) {
+        buckets.add(docid, 20);
+    }
+    EXPECT_EQ(256u, buckets.get_bits(1).countTrueBits());
+    EXPECT_FALSE(buckets.should_rebuild());
+    buckets.add(355, 20);
+    EXPECT_TRUE(buckets.should_rebuild());
+    buckets.resize(200, 1000);
+    EXPECT_EQ(200u, buckets.get_bits(1).size());
+    EXPECT_EQ(101u, buckets.get_bits(1).countTrueBits());
+}
+
+/*
+ * Runs the same range searches against a fast-search attribute with
+ * and without range buckets, and against a model of the values.
+ */
+template <typename AttributeType> class AttributeFixture {
+    using ValueType = typename AttributeType::BaseType;
+    using PostingAttribute = SingleValueNumericPostingAttribute<EnumAttribute<AttributeType>>;
+
+    std::shared_ptr<AttributeVector> _plain;
+    std::shared_ptr<AttributeVector> _bucketed;
+    std::vector<ValueType>           _values;
+
+public:
+    AttributeFixture(BasicType type, uint32_t num_docs)
+        : _plain(AttributeFactory::createAttribute("plain", Config(type, CollectionType::SINGLE, true))),
+          _bucketed(AttributeFactory::createAttribute(
+              "bucketed", Config(type, CollectionType::SINGLE, true).set_range_buckets(8))),
+          _values(num_docs) {
+        for (auto* attr : {_plain.get(), _bucketed.get()}) {
+            attr->addDocs(num_docs);
+            attr->commit();
+        }
+    }
+
+    void set(uint32_t docid, ValueType value) {
+        _values[docid] = value;
+        for (auto* attr : {_plain.get(), _bucketed.get()}) {
+            dynamic_cast<AttributeType&>(*attr).update(docid, value);
+        }
+    }
+
+    void commit() {
+        _plain->commit();
+        _bucketed->commit();
+    }
+
+    const NumericRangeBuckets<ValueType>* range_buckets() const {
+        EXPECT_EQ(nullptr, dynamic_cast<const PostingAttribute&>(*_plain).get_range_buckets());
+        return dynamic_cast<const PostingAttribute&>(*_bucketed).get_range_buckets();
+    }
+
+    static std::vector<uint32_t> search(const AttributeVector& attr, ValueType low, ValueType high) {
+        std::string term = "[" + std::to_string(low) + ";" + std::to_string(high) + "]";
+        auto        ctx =
+            attr.getSearch(std::make_unique<QueryTermSimple>(term, QueryTermSimple::Type::WORD), SearchContextParams());
+        TermFieldMatchData md;
+        ctx->fetchPostings(ExecuteInfo::FULL, true);
+        auto itr = ctx->createIterator(&md, true);
+        itr->initRange(1, attr.getCommittedDocIdLimit());
+        std::vector<uint32_t> result;
+        for (itr->seek(1); !itr->isAtEnd(); itr->seek(itr->getDocId() + 1)) {
+            result.push_back(itr->getDocId());
+        }
+        return result;
+    }
+
+    void verify_range(ValueType low, ValueType high) const {
+        SCOPED_TRACE(std::to_string(low) + ".." + std::to_string(high));
+        std::vector<uint32_t> expected;
+        for (uint32_t docid = 1; docid < _values.size(); ++docid) {
+            if ((_values[docid] >= low) && (_values[docid] <= high)) {
+                expected.push_back(docid);
+            }
+        }
+        EXPECT_EQ(expected, search(*_plain, low, high));
+        EXPECT_EQ(expected, search(*_bucketed, low, high));
+    }
+};
+
+template <typename AttributeType, typename ValueType> void verify_range_search(BasicType type, ValueType scale) {
+    constexpr uint32_t              num_docs = 4000;
+    AttributeFixture<AttributeType> f(type, num_docs);
+    for (uint32_t docid = 1; docid < num_docs; ++docid) {
+        f.set(docid, ValueType((int64_t(docid) * 7919) % 2000 - 1000) * scale);
+    }
+    f.commit();
+    const auto* buckets = f.range_buckets();
+    ASSERT_NE(nullptr, buckets);
+    EXPECT_EQ(8u, buckets->num_buckets());
+    auto verify_ranges = [&f, scale]() {
+        f.verify_range(-1000 * scale, 1000 * scale);
+        f.verify_range(-500 * scale, 500 * scale);
+        f.verify_range(-3 * scale, 700 * scale);
+        f.verify_range(100 * scale, 101 * scale);
+        f.verify_range(-2000 * scale, -1500 * scale);
+        f.verify_range(1500 * scale, 3000 * scale);
+    };
+    verify_ranges();
+
+    // Move documents between buckets
+    for (uint32_t docid = 1; docid < num_docs; docid += 3) {
+        f.set(docid, ValueType((int64_t(docid) * 31) % 1000) * scale);
+    }
+    f.commit();
+    EXPECT_EQ(buckets, f.range_buckets());
+    verify_ranges();
+
+    // Values above all bucket bounds grow the last bucket until the buckets are rebuilt
+    for (uint32_t docid = 1; docid < num_docs; ++docid) {
+        if ((docid % 4) != 0) {
+            f.set(docid, ValueType(2000 + docid % 500) * scale);
+        }
+    }
+    f.commit();
+    EXPECT_NE(buckets, f.range_buckets());
+    verify_ranges();
+    f.verify_range(2100 * scale, 2400 * scale);
+}
+
+TEST(NumericRangeBucketsTest, range_search_on_integer_attribute_uses_buckets) {
+    verify_range_search<IntegerAttributeTemplate<int32_t>, int32_t>(BasicType::INT32, 1);
+}
+
+TEST(NumericRangeBucketsTest, range_search_on_floating_point_attribute_uses_buckets) {
+    verify_range_search<FloatingPointAttributeTemplate<double>, double>(BasicType::DOUBLE, 0.25);
+}
+
+} // namespace
+
+GTEST_MAIN_RUN_ALL_TESTS()
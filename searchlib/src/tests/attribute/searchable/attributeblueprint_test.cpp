@@ -248,6 +248,15 @@ AttributeVector::SP make_tensor_attribute(const std::string& name, const std::st
     return AttributeFactory::createAttribute(name, cfg);
 }
 
+AttributeVector::SP make_partitioned_tensor_attribute(const std::string& name, const std::string& tensor_spec,
+                                                     const std::string& partition_attribute) {
+    Config cfg(BasicType::TENSOR, CollectionType::SINGLE);
+    cfg.setTensorType(ValueType::from_spec(tensor_spec));
+    cfg.set_distance_metric(DistanceMetric::Euclidean);
+    cfg.set_hnsw_index_params(HnswIndexParams(16, 100, DistanceMetric::Euclidean, false, 0, partition_attribute));
+    return AttributeFactory::createAttribute(name, cfg);
+}
+
 AttributeVector::SP make_int_attribute(const std::string& name) {
     Config cfg(BasicType::INT32, CollectionType::SINGLE);
     return AttributeFactory::createAttribute(name, cfg);
@@ -305,11 +314,14 @@ public:
     void set_query_tensor(const TensorSpec& tensor_spec) {
         request_ctx.set_query_tensor("query_tensor", tensor_spec);
     }
-    Blueprint::UP create_blueprint() {
+    Blueprint::UP create_blueprint(const std::vector<std::pair<std::string, int64_t>>& equality_filters = {}) {
         query::NearestNeighborTerm::HnswParams hnsw_params;
         hnsw_params.distance_threshold = 100100.25;
         hnsw_params.explore_additional_hits = 33;
         query::NearestNeighborTerm term("query_tensor", attr_name, 0, Weight(0), 7, true, hnsw_params);
+        for (const auto& [field_name, value] : equality_filters) {
+            term.add_equality_filter(field_name, value);
+        }
         return BlueprintFactoryFixture::create_blueprint(term);
     }
 };
@@ -338,6 +350,26 @@ TEST(AttributeBlueprintTest, nearest_neighbor_blueprint_is_created_by_attribute_
     expect_nearest_neighbor_blueprint("tensor<float>(x[2])", x_2_double, x_2_double);
 }
 
+std::optional<int64_t> partition_key(AttributeVector::SP                                 attr,
+                                     const std::vector<std::pair<std::string, int64_t>>& equality_filters) {
+    NearestNeighborFixture f(std::move(attr));
+    f.set_query_tensor(TensorSpec("tensor(x[2])").add({{"x", 0}}, 3).add({{"x", 1}}, 5));
+    auto result = f.create_blueprint(equality_filters);
+    return downcast<const NearestNeighborBlueprint>(*result).get_partition_key();
+}
+
+TEST(AttributeBlueprintTest, nearest_neighbor_blueprint_selects_partition_from_equality_filter) {
+    auto partitioned = [] { return make_partitioned_tensor_attribute(field, "tensor(x[2])", "tenant"); };
+    EXPECT_EQ(std::optional<int64_t>(10), partition_key(partitioned(), {{"tenant", 10}}));
+    EXPECT_EQ(std::optional<int64_t>(10), partition_key(partitioned(), {{"other", 7}, {"tenant", 10}}));
+    EXPECT_EQ(std::nullopt, partition_key(partitioned(), {{"other", 7}}));
+    EXPECT_EQ(std::nullopt, partition_key(partitioned(), {}));
+    // The index is not partitioned
+    EXPECT_EQ(std::nullopt, partition_key(make_partitioned_tensor_attribute(field, "tensor(x[2])", ""),
+                                          {{"tenant", 10}}));
+    EXPECT_EQ(std::nullopt, partition_key(make_tensor_attribute(field, "tensor(x[2])"), {{"tenant", 10}}));
+}
+
 void expect_empty_blueprint(AttributeVector::SP attr, const TensorSpec& query_tensor,
                             bool insert_query_tensor = true) {
     NearestNeighborFixture f(attr);
@@ -184,16 +184,21 @@ private:
     using Entry = std::pair<uint32_t, DoubleVector>;
     using EntryVector = std::vector<Entry>;
 
-    const DocVectorAccess& _vectors;
-    EntryVector            _adds;
-    EntryVector            _removes;
-    mutable EntryVector    _prepare_adds;
-    EntryVector            _complete_adds;
-    Generation             _transfer_gen;
-    Generation             _trim_gen;
-    mutable size_t         _memory_usage_cnt;
-    int                    _index_value;
-    GenerationHandler      _generation_handler;
+    const DocVectorAccess&                    _vectors;
+    EntryVector                               _adds;
+    EntryVector                               _removes;
+    mutable EntryVector                       _prepare_adds;
+    EntryVector                               _complete_adds;
+    Generation                                _transfer_gen;
+    Generation                                _trim_gen;
+    mutable size_t                            _memory_usage_cnt;
+    int                                       _index_value;
+    GenerationHandler                         _generation_handler;
+    mutable uint32_t                          _top_k_searches;
+    mutable uint32_t                          _top_k_with_filter_searches;
+    std::unique_ptr<MockNearestNeighborIndex> _partition;
+    int64_t                                   _partition_key;
+    uint32_t                                  _partition_num_docs;
 
 public:
     explicit MockNearestNeighborIndex(const DocVectorAccess& vectors)
@@ -206,7 +211,12 @@ public:
           _trim_gen(Generation::make_invalid()),
           _memory_usage_cnt(0),
           _index_value(0),
-          _generation_handler() {}
+          _generation_handler(),
+          _top_k_searches(0),
+          _top_k_with_filter_searches(0),
+          _partition(),
+          _partition_key(0),
+          _partition_num_docs(0) {}
     void clear() {
         _adds.clear();
         _removes.clear();
@@ -244,6 +254,14 @@ public:
     Generation get_transfer_gen() const { return _transfer_gen; }
     Generation get_trim_gen() const { return _trim_gen; }
     size_t memory_usage_cnt() const { return _memory_usage_cnt; }
+    uint32_t top_k_searches() const { return _top_k_searches; }
+    uint32_t top_k_with_filter_searches() const { return _top_k_with_filter_searches; }
+    MockNearestNeighborIndex& add_partition(int64_t key, uint32_t num_docs) {
+        _partition = std::make_unique<MockNearestNeighborIndex>(_vectors);
+        _partition->_partition_num_docs = num_docs;
+        _partition_key = key;
+        return *_partition;
+    }
 
     void add_document(uint32_t docid) override {
         auto vector = _vectors.get_vector(docid, 0).typify<double>();
@@ -309,6 +327,7 @@ public:
                                      uint32_t explore_k, double exploration_slack, bool prefetch_tensors,
                                      const vespalib::Deadline& doom, double distance_threshold) const override {
         std::this_thread::sleep_for(1ms); // Make sure that test does not fail because it ran too fast
+        ++_top_k_searches;
         if (doom.is_missed()) {
             return {};
         }
@@ -330,6 +349,7 @@ public:
                                                  const vespalib::Deadline& doom,
                                                  double                    distance_threshold) const override {
         std::this_thread::sleep_for(1ms); // Make sure that test does not fail because it ran too fast
+        ++_top_k_with_filter_searches;
         if (doom.is_missed()) {
             return {};
         }
@@ -357,6 +377,10 @@ public:
     }
 
     uint32_t check_consistency(uint32_t) const noexcept override { return 0; }
+    const NearestNeighborIndex* get_partition(int64_t key) const override {
+        return (_partition && key == _partition_key) ? _partition.get() : nullptr;
+    }
+    uint32_t get_partition_num_docs() const noexcept override { return _partition_num_docs; }
 };
 
 class MockNearestNeighborIndexFactory : public NearestNeighborIndexFactory {
@@ -364,11 +388,13 @@ class MockNearestNeighborIndexFactory : public NearestNeighborIndexFactory {
     std::unique_ptr<NearestNeighborIndex>
     make(const DocVectorAccess& vectors, size_t vector_size, bool multi_vector_index, CellType cell_type,
          const search::attribute::HnswIndexParams&                   params,
-         const std::optional<search::attribute::QuantizationParams>& quant_params) const override {
+         const std::optional<search::attribute::QuantizationParams>& quant_params,
+         const std::shared_ptr<vespalib::alloc::MemoryAllocator>&    memory_allocator) const override {
         (void)vector_size;
         (void)params;
         (void)multi_vector_index;
         (void)quant_params;
+        (void)memory_allocator;
         assert(cell_type == CellType::DOUBLE);
         return std::make_unique<MockNearestNeighborIndex>(vectors);
     }
@@ -1667,6 +1693,63 @@ TEST(TensorAttributeTest, NN_blueprint_updates_pending_index_search_after_filter
     EXPECT_FALSE(bp->pending_index_search());
 }
 
+std::shared_ptr<GlobalFilter> make_filter(std::initializer_list<uint32_t> docids) {
+    auto filter = search::BitVector::create(1, 11);
+    for (uint32_t docid : docids) {
+        filter->setBit(docid);
+    }
+    filter->invalidateCachedCount();
+    return GlobalFilter::create(std::move(filter));
+}
+
+TEST(TensorAttributeTest, NN_blueprint_searches_partition_of_small_tenant_below_global_filter_lower_limit) {
+    NearestNeighborBlueprintFixture f;
+    auto&                           partition = f.mock_index().add_partition(10, 2);
+    auto                            bp = f.make_blueprint(true, 0.2);
+    bp->set_partition_key(10);
+    // The limits are scaled by the share of the corpus in the partition
+    Blueprint::GlobalFilterLimits limits;
+    EXPECT_TRUE(bp->want_global_filter(limits));
+    EXPECT_DOUBLE_EQ(0.2 * 2 / 11, limits.lower_limit.value());
+    EXPECT_DOUBLE_EQ(1.0 * 2 / 11, limits.upper_limit.value());
+    // The filter matches 2/11 of the corpus, but all documents in the partition
+    auto tenant_filter = make_filter({3, 4});
+    bp->set_global_filter(*tenant_filter, 2.0 / 11);
+    EXPECT_TRUE(bp->pending_index_search());
+    EXPECT_TRUE(bp->filter_restates_partition());
+    bp->perform_index_search(vespalib::Deadline::never(), f.stats());
+    EXPECT_EQ(NNBA::INDEX_TOP_K, bp->get_algorithm());
+    EXPECT_EQ(1u, partition.top_k_searches());
+    EXPECT_EQ(0u, partition.top_k_with_filter_searches());
+    EXPECT_EQ(0u, f.mock_index().top_k_searches());
+    EXPECT_EQ(0u, f.mock_index().top_k_with_filter_searches());
+}
+
+TEST(TensorAttributeTest, NN_blueprint_uses_hit_ratio_in_partition_to_select_algorithm) {
+    NearestNeighborBlueprintFixture f;
+    auto&                           partition = f.mock_index().add_partition(10, 4);
+    auto                            bp = f.make_blueprint(true, 0.2);
+    bp->set_partition_key(10);
+    // 1/4 of the partition is above the lower limit, while 1/11 of the corpus is below it
+    auto filter = make_filter({3});
+    bp->set_global_filter(*filter, 1.0 / 11);
+    EXPECT_TRUE(bp->pending_index_search());
+    EXPECT_FALSE(bp->filter_restates_partition());
+    EXPECT_EQ(1u, bp->getState().estimate().estHits);
+    bp->perform_index_search(vespalib::Deadline::never(), f.stats());
+    EXPECT_EQ(NNBA::INDEX_TOP_K_WITH_FILTER, bp->get_algorithm());
+    EXPECT_EQ(1u, partition.top_k_with_filter_searches());
+    EXPECT_EQ(0u, f.mock_index().top_k_with_filter_searches());
+
+    // 1/10 of a larger partition is below the lower limit
+    f.mock_index().add_partition(10, 10);
+    bp = f.make_blueprint(true, 0.2);
+    bp->set_partition_key(10);
+    bp->set_global_filter(*filter, 1.0 / 11);
+    EXPECT_FALSE(bp->pending_index_search());
+    EXPECT_EQ(NNBA::EXACT_FALLBACK, bp->get_algorithm());
+}
+
 TEST(TensorAttributeTest, NN_blueprint_wants_global_filter_when_having_index) {
     NearestNeighborBlueprintFixture f;
     auto                            bp = f.make_blueprint();
@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/roaring_bitvector.h>
 
 #include <benchmark/benchmark.h>
 
@@ -121,6 +122,35 @@ BENCHMARK_DEFINE_F(BitVectorBenchmark, get_next_true_bit_scan_with_all_bits_set)
     state.SetItemsProcessed(state.range() * state.iterations());
 }
 
+namespace {
+
+// random bits with 1 in 'one_in' set (16: roaring as large as plain, 64: where a global filter is made compact)
+std::unique_ptr<BitVector> make_random_bits(size_t n, size_t one_in) {
+    auto             bv = BitVector::create(n);
+    std::minstd_rand prng;
+    prng.seed(1);
+    std::uniform_int_distribution<size_t> dist(0, one_in - 1); // closed interval
+    for (size_t i = 0; i < n; ++i) {
+        if (dist(prng) == 0) {
+            bv->setBit(i);
+        }
+    }
+    bv->invalidateCachedCount();
+    return bv;
+}
+
+} // namespace
+
+void test_bit_in_plain(benchmark::State& state, size_t one_in) {
+    auto bv = make_random_bits(state.range(), one_in);
+    do_benchmark_fn_in_state_bit_range(state, [&](size_t bit_idx) { return bv->testBit(bit_idx); });
+}
+
+void test_bit_in_roaring(benchmark::State& state, size_t one_in) {
+    auto bv = RoaringBitVector::create(*make_random_bits(state.range(), one_in));
+    do_benchmark_fn_in_state_bit_range(state, [&](size_t bit_idx) { return bv->testBit(bit_idx); });
+}
+
 BENCHMARK_REGISTER_F(BitVectorBenchmark, or_speed)->RangeMultiplier(4)->Range(1024, 8 << 22);
 BENCHMARK_REGISTER_F(BitVectorBenchmark, count_speed)->RangeMultiplier(4)->Range(1024, 8 << 22);
 // Test with large bit vectors to determine effect of last level cache misses
@@ -138,6 +168,12 @@ BENCHMARK_REGISTER_F(BitVectorBenchmark, get_next_true_bit_scan_with_all_bits_se
     ->RangeMultiplier(8)
     ->Range(1024, 8 << 22);
 
+// Compare bit lookups (as done for each nearest neighbor candidate) in a plain and a compact global filter
+BENCHMARK_CAPTURE(test_bit_in_plain, one_in_16, 16)->RangeMultiplier(8)->Range(1 << 20, 8 << 25);
+BENCHMARK_CAPTURE(test_bit_in_roaring, one_in_16, 16)->RangeMultiplier(8)->Range(1 << 20, 8 << 25);
+BENCHMARK_CAPTURE(test_bit_in_plain, one_in_64, 64)->RangeMultiplier(8)->Range(1 << 20, 8 << 25);
+BENCHMARK_CAPTURE(test_bit_in_roaring, one_in_64, 64)->RangeMultiplier(8)->Range(1 << 20, 8 << 25);
+
 } // namespace search
 
 BENCHMARK_MAIN();
@@ -0,0 +1,155 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/roaring_bitvector.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/rand48.h>
+
+#include <algorithm>
+#include <set>
+
+using namespace search;
+
+namespace {
+
+constexpr uint32_t chunk_size = RoaringBitVector::chunk_size;
+
+std::vector<uint32_t> sparse_docids(uint32_t limit, uint32_t step) {
+    std::vector<uint32_t> result;
+    for (uint32_t docid = 1; docid < limit; docid += step) {
+        result.push_back(docid);
+    }
+    return result;
+}
+
+std::vector<uint32_t> run_docids(uint32_t first, uint32_t last) {
+    std::vector<uint32_t> result;
+    for (uint32_t docid = first; docid <= last; ++docid) {
+        result.push_back(docid);
+    }
+    return result;
+}
+
+std::vector<uint32_t> random_docids(uint32_t limit, uint32_t per_mille, long seed) {
+    vespalib::Rand48 rnd;
+    rnd.srand48(seed);
+    std::vector<uint32_t> result;
+    for (uint32_t docid = 1; docid < limit; ++docid) {
+        if ((rnd.lrand48() % 1000) < per_mille) {
+            result.push_back(docid);
+        }
+    }
+    return result;
+}
+
+std::vector<uint32_t> true_bits(const RoaringBitVector& bits) {
+    std::vector<uint32_t> result;
+    bits.foreach_truebit([&result](uint32_t docid) { result.push_back(docid); });
+    return result;
+}
+
+void verify(const std::vector<uint32_t>& expect, const RoaringBitVector& bits) {
+    EXPECT_EQ(expect, true_bits(bits));
+    EXPECT_EQ(expect.size(), bits.countTrueBits());
+    std::set<uint32_t> expect_set(expect.begin(), expect.end());
+    for (uint32_t docid = bits.getStartIndex(); docid < bits.size(); ++docid) {
+        ASSERT_EQ(expect_set.contains(docid), bits.testBit(docid)) << docid;
+        auto next = expect_set.lower_bound(docid);
+        ASSERT_EQ((next != expect_set.end()) ? *next : bits.size(), bits.getNextTrueBit(docid)) << docid;
+    }
+    EXPECT_EQ(bits.size(), bits.getNextTrueBit(bits.size()));
+}
+
+TEST(RoaringBitVectorTest, require_that_empty_vector_has_no_bits) {
+    auto bits = RoaringBitVector::create(std::vector<uint32_t>(), 1, 1000);
+    EXPECT_EQ(1u, bits->getStartIndex());
+    EXPECT_EQ(1000u, bits->size());
+    verify({}, *bits);
+}
+
+TEST(RoaringBitVectorTest, require_that_sparse_dense_and_clustered_chunks_are_handled) {
+    std::vector<uint32_t> docids = sparse_docids(chunk_size, 97);           // array container
+    auto                  dense = random_docids(2 * chunk_size, 500, 42); // bitmap container
+    for (uint32_t docid : dense) {
+        if (docid >= chunk_size) {
+            docids.push_back(docid);
+        }
+    }
+    auto runs = run_docids((3 * chunk_size) + 10, (4 * chunk_size) + 20000); // run containers
+    docids.insert(docids.end(), runs.begin(), runs.end());
+    docids.push_back((6 * chunk_size) - 1);
+    auto bits = RoaringBitVector::create(docids, 1, 6 * chunk_size);
+    verify(docids, *bits);
+}
+
+TEST(RoaringBitVectorTest, require_that_sparse_vector_is_smaller_than_bitvector) {
+    uint32_t limit = 100 * chunk_size;
+    auto     bits = RoaringBitVector::create(sparse_docids(limit, 1000), 1, limit);
+    EXPECT_LT(bits->get_allocated_bytes() * 10, limit / 8);
+    auto runs = RoaringBitVector::create(run_docids(1, limit - 1), 1, limit);
+    EXPECT_LT(runs->get_allocated_bytes() * 10, limit / 8);
+}
+
+TEST(RoaringBitVectorTest, require_that_vector_can_be_created_from_bitvector) {
+    auto docids = random_docids(3 * chunk_size, 30, 7);
+    auto plain = BitVector::create(1, 3 * chunk_size);
+    for (uint32_t docid : docids) {
+        plain->setBit(docid);
+    }
+    plain->invalidateCachedCount();
+    auto bits = RoaringBitVector::create(*plain);
+    EXPECT_EQ(1u, bits->getStartIndex());
+    EXPECT_EQ(3 * chunk_size, bits->size());
+    verify(docids, *bits);
+}
+
+TEST(RoaringBitVectorTest, require_that_builder_skips_empty_chunks) {
+    std::vector<uint32_t>     docids = {3, (2 * chunk_size) + 7, (2 * chunk_size) + 8, (5 * chunk_size) + 1};
+    RoaringBitVector::Builder builder(1, 6 * chunk_size);
+    for (uint32_t docid : docids) {
+        builder.set(docid);
+    }
+    auto bits = builder.build();
+    verify(docids, *bits);
+    EXPECT_FALSE(bits->testBit(10 * chunk_size));
+}
+
+TEST(RoaringBitVectorTest, require_that_and_and_or_give_same_result_as_sets) {
+    uint32_t limit = 4 * chunk_size;
+    for (uint32_t a_per_mille : {2, 200, 900}) {
+        for (uint32_t b_per_mille : {3, 100, 999}) {
+            SCOPED_TRACE(a_per_mille);
+            SCOPED_TRACE(b_per_mille);
+            auto a_docids = random_docids(limit, a_per_mille, 1);
+            auto b_docids = random_docids(limit, b_per_mille, 2);
+            auto a = RoaringBitVector::create(a_docids, 1, limit);
+            auto b = RoaringBitVector::create(b_docids, 1, limit);
+            std::vector<uint32_t> expect_and;
+            std::vector<uint32_t> expect_or;
+            std::set_intersection(a_docids.begin(), a_docids.end(), b_docids.begin(), b_docids.end(),
+                                  std::back_inserter(expect_and));
+            std::set_union(a_docids.begin(), a_docids.end(), b_docids.begin(), b_docids.end(),
+                           std::back_inserter(expect_or));
+            EXPECT_EQ(expect_and, true_bits(*RoaringBitVector::and_of(*a, *b)));
+            EXPECT_EQ(expect_or, true_bits(*RoaringBitVector::or_of(*a, *b)));
+        }
+    }
+}
+
+TEST(RoaringBitVectorTest, require_that_or_of_disjoint_ranges_covers_both) {
+    auto a = RoaringBitVector::create(std::vector<uint32_t>{1, 5, 100}, 1, 101);
+    auto b = RoaringBitVector::create(std::vector<uint32_t>{101, 200000}, 101, 200001);
+    auto c = RoaringBitVector::or_of(*a, *b);
+    EXPECT_EQ(1u, c->getStartIndex());
+    EXPECT_EQ(200001u, c->size());
+    EXPECT_EQ((std::vector<uint32_t>{1, 5, 100, 101, 200000}), true_bits(*c));
+}
+
+TEST(RoaringBitVectorTest, require_that_compact_representation_is_preferred_for_few_hits) {
+    EXPECT_TRUE(RoaringBitVector::is_compact_preferred(1000, 1000000));
+    EXPECT_FALSE(RoaringBitVector::is_compact_preferred(100000, 1000000));
+}
+
+} // namespace
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -269,6 +269,7 @@ Blueprint::UP DiskIndexTest::create_blueprint(const FieldSpec& field, const sear
     auto                         b = _index->createBlueprint(_requestContext, field, term, mdl);
     EXPECT_TRUE(mdl.empty());
     b->basic_plan(true, docid_limit);
+    b->prefetchPostings();
     b->fetchPostings(search::queryeval::ExecuteInfo::FULL);
     return b;
 }
@@ -277,7 +278,8 @@ void DiskIndexTest::requireThatWeCanReadPostingList(const IOSettings& io_setting
     { // field 'f1'
         auto  r = _index->lookup(0, "w1");
         auto& field_index = _index->get_field_index(0);
-        auto  h = field_index.read_posting_list(r);
+        field_index.prefetch_posting_list(r);
+        auto h = field_index.read_posting_list(r);
         if (field_index.is_posting_list_cache_enabled()) {
             EXPECT_GT(96, h._allocSize);
         }
@@ -77,6 +77,8 @@ uint32_t           minChunkDocs = 256_Ki;
 constexpr uint64_t disable_features_size_flush = std::numeric_limits<uint64_t>::max();
 constexpr uint64_t force_features_size_flush = 2; // Unrealistic low for testing, 1 document per chunk
 uint64_t           features_size_flush_bits = disable_features_size_flush;
+bool               packed_doc_ids = false;
+bool               block_max_features = false;
 
 std::string dirprefix = "index/";
 
@@ -104,6 +106,14 @@ void enable_features_size_flush() {
     features_size_flush_bits = force_features_size_flush;
 }
 
+void set_packed_doc_ids(bool value) {
+    packed_doc_ids = value;
+}
+
+void set_block_max_features(bool value) {
+    block_max_features = value;
+}
+
 const char* bool_to_str(bool val) {
     return (val ? "true" : "false");
 }
@@ -194,7 +204,9 @@ WrappedFieldWriter::WrappedFieldWriter(const std::string& namepref, bool dynamic
       _schema(),
       _indexId() {
     schema::CollectionType ct(CollectionType::SINGLE);
-    _schema.addIndexField(Schema::IndexField("field1", DataType::STRING, ct));
+    _schema.addIndexField(Schema::IndexField("field1", DataType::STRING, ct)
+                              .set_packed_doc_ids(packed_doc_ids)
+                              .set_block_max_features(block_max_features));
     _indexId = _schema.getIndexFieldId("field1");
 }
 
@@ -538,6 +550,13 @@ void testFieldWriterVariants(FakeWordSet& wordSet, uint32_t docIdLimit, bool ver
     testFieldWriterVariant(wordSet, docIdLimit, "newchunk4", true, false, verbose);
     testFieldWriterVariant(wordSet, docIdLimit, "newchunk5", false, false, verbose);
     testFieldWriterVariant(wordSet, docIdLimit, "newchunkcf4", true, true, verbose);
+    set_block_max_features(true);
+    testFieldWriterVariant(wordSet, docIdLimit, "newchunkcfbm4", true, true, verbose);
+    set_block_max_features(false);
+    set_packed_doc_ids(true);
+    testFieldWriterVariant(wordSet, docIdLimit, "newchunkpd4", true, false, verbose);
+    testFieldWriterVariant(wordSet, docIdLimit, "newchunkcfpd4", true, true, verbose);
+    set_packed_doc_ids(false);
     enable_features_size_flush();
     testFieldWriterVariant(wordSet, docIdLimit, "newfs4", true, false, verbose);
     testFieldWriterVariant(wordSet, docIdLimit, "newfs5", false, false, verbose);
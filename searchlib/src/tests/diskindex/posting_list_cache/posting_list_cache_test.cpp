@@ -131,4 +131,27 @@ TEST_F(PostingListCacheTest, repeated_bitvector_lookup_gives_hit) {
     EXPECT_EQ(PostingListCache::bitvector_element_size() + bv->get_allocated_bytes(true), stats.memory_used);
 }
 
+TEST_F(PostingListCacheTest, contains_does_not_read_on_miss) {
+    _key.bit_length = 24 * 8;
+    _bv_key.lookup_result.idx = 1;
+    EXPECT_FALSE(_cache.contains(_key));
+    EXPECT_FALSE(_cache.contains(_bv_key));
+    (void)read();
+    (void)read_bv();
+    EXPECT_TRUE(_cache.contains(_key));
+    EXPECT_TRUE(_cache.contains(_bv_key));
+    _key.bit_offset = 1000;
+    _bv_key.lookup_result.idx = 2;
+    EXPECT_FALSE(_cache.contains(_key));
+    EXPECT_FALSE(_cache.contains(_bv_key));
+    auto stats = _cache.get_stats();
+    EXPECT_EQ(1, stats.misses);
+    EXPECT_EQ(0, stats.hits);
+    EXPECT_EQ(1, stats.elements);
+    stats = _cache.get_bitvector_stats();
+    EXPECT_EQ(1, stats.misses);
+    EXPECT_EQ(0, stats.hits);
+    EXPECT_EQ(1, stats.elements);
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
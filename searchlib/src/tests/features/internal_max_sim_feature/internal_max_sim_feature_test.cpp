@@ -0,0 +1,178 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/eval/simple_value.h>
+#include <vespa/eval/eval/tensor_spec.h>
+#include <vespa/eval/eval/value_codec.h>
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/attributevector.h>
+#include <vespa/searchlib/features/internal_max_sim_feature.h>
+#include <vespa/searchlib/features/setup.h>
+#include <vespa/searchlib/fef/test/ftlib.h>
+#include <vespa/searchlib/fef/test/indexenvironment.h>
+#include <vespa/searchlib/tensor/tensor_attribute.h>
+#include <vespa/searchlib/test/ft_test_app_base.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/objects/nbostream.h>
+
+using search::AttributeFactory;
+using search::AttributeVector;
+using search::tensor::TensorAttribute;
+using vespalib::eval::SimpleValue;
+using vespalib::eval::TensorSpec;
+using vespalib::eval::Value;
+using vespalib::eval::ValueType;
+using namespace search::fef;
+using namespace search::fef::indexproperties;
+using namespace search::fef::test;
+using namespace search::features;
+
+using AVC = search::attribute::Config;
+using AVBT = search::attribute::BasicType;
+using AVCT = search::attribute::CollectionType;
+using CollectionType = FieldInfo::CollectionType;
+using DataType = FieldInfo::DataType;
+using FTA = FtTestAppBase;
+
+namespace {
+
+const std::string max_sim_expr = "reduce(reduce(reduce(query(qt)*attribute(docattr),sum,x),max,dt),sum,qt)";
+
+TensorSpec make_doc_tensor(const std::string& type) {
+    if (ValueType::from_spec(type).is_dense()) {
+        return TensorSpec(type)
+            .add({{"dt", 0}, {"x", 0}}, 1)
+            .add({{"dt", 0}, {"x", 1}}, 2)
+            .add({{"dt", 1}, {"x", 0}}, 3)
+            .add({{"dt", 1}, {"x", 1}}, -1);
+    }
+    return TensorSpec(type)
+        .add({{"dt", "a"}, {"x", 0}}, 1)
+        .add({{"dt", "a"}, {"x", 1}}, 2)
+        .add({{"dt", "b"}, {"x", 0}}, 3)
+        .add({{"dt", "b"}, {"x", 1}}, -1);
+}
+
+TensorSpec make_query_tensor(const std::string& type) {
+    return TensorSpec(type)
+        .add({{"qt", "x"}, {"x", 0}}, 1)
+        .add({{"qt", "x"}, {"x", 1}}, 1)
+        .add({{"qt", "y"}, {"x", 0}}, 0)
+        .add({{"qt", "y"}, {"x", 1}}, 1);
+}
+
+} // namespace
+
+struct SetupFixture {
+    InternalMaxSimBlueprint blueprint;
+    IndexEnvironment        indexEnv;
+    SetupFixture() : blueprint(), indexEnv() {
+        addAttribute("docattr", "tensor<float>(dt{},x[2])");
+        addAttribute("vector", "tensor<float>(x[2])");
+        type::QueryFeature::set(indexEnv.getProperties(), "qt", "tensor<float>(qt{},x[2])");
+        type::QueryFeature::set(indexEnv.getProperties(), "qt3", "tensor<float>(qt{},x[3])");
+    }
+    void addAttribute(const std::string& name, const std::string& type) {
+        indexEnv.addField(FieldType::ATTRIBUTE, CollectionType::SINGLE, name);
+        indexEnv.getFields().back().set_data_type(DataType::TENSOR);
+        type::Attribute::set(indexEnv.getProperties(), name, type);
+    }
+};
+
+TEST(InternalMaxSimFeatureTest, require_that_blueprint_can_be_created) {
+    SetupFixture f;
+    EXPECT_TRUE(FTA::assertCreateInstance(f.blueprint, "internalMaxSim"));
+}
+
+TEST(InternalMaxSimFeatureTest, require_that_setup_succeeds_with_matching_tensor_types) {
+    SetupFixture f;
+    FTA::FT_SETUP_OK(f.blueprint, f.indexEnv, StringList().add("docattr").add("qt").add("qt").add("dt").add("x"),
+                     StringList(), StringList().add("scalar"));
+}
+
+TEST(InternalMaxSimFeatureTest, require_that_setup_fails_if_attribute_is_not_a_vector_list) {
+    SetupFixture f;
+    FTA::FT_SETUP_FAIL(f.blueprint, f.indexEnv, StringList().add("vector").add("qt").add("qt").add("dt").add("x"));
+}
+
+TEST(InternalMaxSimFeatureTest, require_that_setup_fails_if_dimensions_do_not_match) {
+    SetupFixture f;
+    FTA::FT_SETUP_FAIL(f.blueprint, f.indexEnv, StringList().add("docattr").add("qt").add("qt").add("dt").add("y"));
+    FTA::FT_SETUP_FAIL(f.blueprint, f.indexEnv, StringList().add("docattr").add("qt").add("dt").add("qt").add("x"));
+}
+
+TEST(InternalMaxSimFeatureTest, require_that_setup_fails_if_vector_sizes_differ) {
+    SetupFixture f;
+    FTA::FT_SETUP_FAIL(f.blueprint, f.indexEnv, StringList().add("docattr").add("qt3").add("qt").add("dt").add("x"));
+}
+
+struct ExecFixture {
+    BlueprintFactory factory;
+    FtFeatureTest    test;
+    ExecFixture(const std::string& attr_type, const std::string& query_type, const std::string& feature)
+        : factory(), test(factory, feature) {
+        setup_search_features(factory);
+        setupAttributeVectors(attr_type);
+        setupQueryEnvironment(query_type);
+        test.getIndexEnv().getProperties().add("rankingExpression(max_sim).rankingScript", max_sim_expr);
+        EXPECT_TRUE(test.setup());
+    }
+    void setupAttributeVectors(const std::string& attr_type) {
+        test.getIndexEnv().getBuilder().addField(FieldType::ATTRIBUTE, CollectionType::SINGLE, DataType::TENSOR,
+                                                 "docattr");
+        type::Attribute::set(test.getIndexEnv().getProperties(), "docattr", attr_type);
+        AVC config(AVBT::TENSOR, AVCT::SINGLE);
+        config.setTensorType(ValueType::from_spec(attr_type));
+        auto attr = AttributeFactory::createAttribute("docattr", config);
+        attr->addReservedDoc();
+        attr->addDocs(2);
+        attr->clearDoc(1);
+        attr->clearDoc(2);
+        attr->commit();
+        test.getIndexEnv().getAttributeMap().add(attr);
+        auto& tensor_attr = dynamic_cast<TensorAttribute&>(*attr);
+        tensor_attr.setTensor(1, *SimpleValue::from_spec(make_doc_tensor(attr_type)));
+        attr->commit();
+    }
+    void setupQueryEnvironment(const std::string& query_type) {
+        type::QueryFeature::set(test.getIndexEnv().getProperties(), "qt", query_type);
+        vespalib::nbostream stream;
+        encode_value(*SimpleValue::from_spec(make_query_tensor(query_type)), stream);
+        test.getQueryEnv().getProperties().add("qt", std::string_view(stream.peek(), stream.size()));
+    }
+    bool evaluatesTo(feature_t expected, uint32_t docid = 1) { return test.execute(expected, 0.0, docid); }
+};
+
+// doc vectors a: [1,2], b: [3,-1]
+// query vectors x: [1,1] -> max(3,2) = 3, y: [0,1] -> max(2,-1) = 2
+TEST(InternalMaxSimFeatureTest, require_that_executor_returns_sum_of_max_dot_products) {
+    ExecFixture f("tensor<float>(dt{},x[2])", "tensor<float>(qt{},x[2])", "internalMaxSim(docattr,qt,qt,dt,x)");
+    EXPECT_TRUE(f.evaluatesTo(5.0));
+}
+
+TEST(InternalMaxSimFeatureTest, require_that_executor_returns_0_for_document_without_tensor) {
+    ExecFixture f("tensor<float>(dt{},x[2])", "tensor<float>(qt{},x[2])", "internalMaxSim(docattr,qt,qt,dt,x)");
+    EXPECT_TRUE(f.evaluatesTo(0.0, 2));
+}
+
+TEST(InternalMaxSimFeatureTest, require_that_executor_handles_different_cell_types) {
+    ExecFixture f1("tensor<float>(dt{},x[2])", "tensor(qt{},x[2])", "internalMaxSim(docattr,qt,qt,dt,x)");
+    EXPECT_TRUE(f1.evaluatesTo(5.0));
+    ExecFixture f2("tensor<bfloat16>(dt{},x[2])", "tensor<float>(qt{},x[2])", "internalMaxSim(docattr,qt,qt,dt,x)");
+    EXPECT_TRUE(f2.evaluatesTo(5.0));
+    ExecFixture f3("tensor<int8>(dt{},x[2])", "tensor<int8>(qt{},x[2])", "internalMaxSim(docattr,qt,qt,dt,x)");
+    EXPECT_TRUE(f3.evaluatesTo(5.0));
+}
+
+TEST(InternalMaxSimFeatureTest, require_that_executor_handles_dense_token_dimensions) {
+    ExecFixture f("tensor<float>(dt[2],x[2])", "tensor<float>(qt{},x[2])", "internalMaxSim(docattr,qt,qt,dt,x)");
+    EXPECT_TRUE(f.evaluatesTo(5.0));
+}
+
+TEST(InternalMaxSimFeatureTest, require_that_ranking_expression_gives_same_result_as_intrinsic_feature) {
+    ExecFixture f("tensor<float>(dt{},x[2])", "tensor<float>(qt{},x[2])", "rankingExpression(max_sim)");
+    EXPECT_TRUE(f.evaluatesTo(5.0));
+    EXPECT_TRUE(f.evaluatesTo(0.0, 2));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,96 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/eval/function.h>
+#include <vespa/searchlib/features/max_sim_replacer.h>
+#include <vespa/searchlib/features/rankingexpression/feature_name_extractor.h>
+#include <vespa/searchlib/fef/blueprint.h>
+#include <vespa/searchlib/fef/test/indexenvironment.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP("max_sim_replacer_test");
+
+using search::features::MaxSimReplacer;
+using search::features::rankingexpression::ExpressionReplacer;
+using search::features::rankingexpression::FeatureNameExtractor;
+using search::fef::Blueprint;
+using search::fef::FeatureExecutor;
+using search::fef::FeatureType;
+using search::fef::IDumpFeatureVisitor;
+using search::fef::IIndexEnvironment;
+using search::fef::IQueryEnvironment;
+using search::fef::test::IndexEnvironment;
+using vespalib::eval::Function;
+
+struct MyBlueprint : Blueprint {
+    bool& was_used;
+    MyBlueprint(bool& was_used_out) : Blueprint("my_bp"), was_used(was_used_out) {}
+    void visitDumpFeatures(const IIndexEnvironment&, IDumpFeatureVisitor&) const override {}
+    Blueprint::UP createInstance() const override { return std::make_unique<MyBlueprint>(was_used); }
+    bool setup(const IIndexEnvironment&, const std::vector<std::string>& params) override {
+        EXPECT_EQ(getName(), "my_bp(foo,bar,qt,dt,x)");
+        EXPECT_EQ(5, params.size());
+        if (params.size() != 5) {
+            return false;
+        }
+        EXPECT_EQ(params[0], "foo");
+        EXPECT_EQ(params[1], "bar");
+        EXPECT_EQ(params[2], "qt");
+        EXPECT_EQ(params[3], "dt");
+        EXPECT_EQ(params[4], "x");
+        describeOutput("out", "my output", FeatureType::number());
+        was_used = true;
+        return true;
+    }
+    FeatureExecutor& createExecutor(const IQueryEnvironment&, vespalib::Stash&) const override {
+        LOG_ABORT("should not be reached");
+    }
+};
+
+bool replaced(const std::string& expr) {
+    bool                   was_used = false;
+    ExpressionReplacer::UP replacer = MaxSimReplacer::create(std::make_unique<MyBlueprint>(was_used));
+    auto                   rank_function = Function::parse(expr, FeatureNameExtractor());
+    EXPECT_TRUE(!rank_function->has_error()) << "parse error: " << rank_function->dump();
+    auto result = replacer->maybe_replace(*rank_function, IndexEnvironment());
+    EXPECT_EQ(bool(result), was_used);
+    return was_used;
+}
+
+TEST(MaxSimReplacerTest, require_that_matching_expression_with_appropriate_inputs_is_replaced) {
+    EXPECT_TRUE(replaced("reduce(reduce(reduce(query(bar)*attribute(foo),sum,x),max,dt),sum,qt)"));
+}
+
+TEST(MaxSimReplacerTest, require_that_expression_using_tensor_join_with_lambda_can_also_be_replaced) {
+    EXPECT_TRUE(replaced("reduce(reduce(reduce(join(query(bar),attribute(foo),f(a,b)(a*b)),sum,x),max,dt),sum,qt)"));
+}
+
+TEST(MaxSimReplacerTest, require_that_parameter_ordering_does_not_matter) {
+    EXPECT_TRUE(replaced("reduce(reduce(reduce(attribute(foo)*query(bar),sum,x),max,dt),sum,qt)"));
+    EXPECT_TRUE(replaced("reduce(reduce(reduce(join(query(bar),attribute(foo),f(a,b)(b*a)),sum,x),max,dt),sum,qt)"));
+}
+
+TEST(MaxSimReplacerTest, require_that_matching_expression_with_unrelated_inputs_is_not_replaced) {
+    EXPECT_TRUE(!replaced("reduce(reduce(reduce(foo*bar,sum,x),max,dt),sum,qt)"));
+    EXPECT_TRUE(!replaced("reduce(reduce(reduce(query(foo)*query(bar),sum,x),max,dt),sum,qt)"));
+}
+
+TEST(MaxSimReplacerTest, require_that_reduce_operations_must_match) {
+    EXPECT_TRUE(!replaced("reduce(reduce(reduce(query(bar)*attribute(foo),max,x),max,dt),sum,qt)"));
+    EXPECT_TRUE(!replaced("reduce(reduce(reduce(query(bar)*attribute(foo),sum,x),sum,dt),sum,qt)"));
+    EXPECT_TRUE(!replaced("reduce(reduce(reduce(query(bar)*attribute(foo),sum,x),max,dt),max,qt)"));
+    EXPECT_TRUE(!replaced("reduce(reduce(query(bar)*attribute(foo),sum,x),max,dt)"));
+}
+
+TEST(MaxSimReplacerTest, require_that_join_operation_must_match) {
+    EXPECT_TRUE(!replaced("reduce(reduce(reduce(query(bar)+attribute(foo),sum,x),max,dt),sum,qt)"));
+    EXPECT_TRUE(!replaced("reduce(reduce(reduce(join(query(bar),attribute(foo),f(a,b)(a*a)),sum,x),max,dt),sum,qt)"));
+}
+
+TEST(MaxSimReplacerTest, require_that_each_reduce_uses_a_single_distinct_dimension) {
+    EXPECT_TRUE(!replaced("reduce(reduce(reduce(query(bar)*attribute(foo),sum,x),max,dt),sum,dt)"));
+    EXPECT_TRUE(!replaced("reduce(reduce(reduce(query(bar)*attribute(foo),sum,x,y),max,dt),sum,qt)"));
+    EXPECT_TRUE(!replaced("reduce(reduce(reduce(query(bar)*attribute(foo),sum,x),max),sum,qt)"));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -2099,6 +2099,17 @@ TEST_F(ProdFeaturesTest, test_ranking_expression) {
             ASSERT_TRUE(ft.setup());
             EXPECT_TRUE(ft.execute(13.0));
         }
+        {
+            // test compiled expression reading attribute inputs directly
+            std::string   my_expr("attribute(sint)+attribute(slong)*query(w)+attribute(sdouble)+"
+                                  "attribute(sfloat).count+attribute(aint,0)");
+            FtFeatureTest ft(_factory, getExpression(my_expr));
+            ft.getIndexEnv().getProperties().add(indexproperties::eval::FuseAttributeInputs::NAME, "true");
+            ft.getQueryEnv().getProperties().add("w", "2");
+            setupForAttributeTest(ft);
+            ASSERT_TRUE(ft.setup());
+            EXPECT_TRUE(ft.execute(10.0 + 20.0 * 2 + 67.5 + 1.0 + 20.0));
+        }
     }
 }
 
@@ -234,6 +234,14 @@ TEST(PropertiesTest, test_stuff) {
             p.add("vespa.eval.use_fast_forest", "true");
             EXPECT_EQ(eval::UseFastForest::check(p), true);
         }
+        { // vespa.eval.fuse_attribute_inputs
+            EXPECT_EQ(eval::FuseAttributeInputs::NAME, std::string("vespa.eval.fuse_attribute_inputs"));
+            EXPECT_EQ(eval::FuseAttributeInputs::DEFAULT_VALUE, false);
+            Properties p;
+            EXPECT_EQ(eval::FuseAttributeInputs::check(p), false);
+            p.add("vespa.eval.fuse_attribute_inputs", "true");
+            EXPECT_EQ(eval::FuseAttributeInputs::check(p), true);
+        }
         { // vespa.rank.firstphase
             EXPECT_EQ(rank::FirstPhase::NAME, std::string("vespa.rank.firstphase"));
             EXPECT_EQ(rank::FirstPhase::DEFAULT_VALUE, std::string("nativeRank"));
@@ -420,6 +428,16 @@ TEST(PropertiesTest, test_stuff) {
             EXPECT_EQ(std::optional<search::feature_t>(123456789.12345),
                       hitcollector::FirstPhaseRankScoreDropLimit::lookup(p));
         }
+        { // vespa.hitcollector.sharefirstphasescorethreshold
+            EXPECT_EQ(std::string("vespa.hitcollector.sharefirstphasescorethreshold"),
+                      hitcollector::ShareFirstPhaseScoreThreshold::NAME);
+            EXPECT_FALSE(hitcollector::ShareFirstPhaseScoreThreshold::DEFAULT_VALUE);
+            Properties p;
+            EXPECT_FALSE(hitcollector::ShareFirstPhaseScoreThreshold::lookup(p));
+            EXPECT_TRUE(hitcollector::ShareFirstPhaseScoreThreshold::lookup(p, true));
+            p.add("vespa.hitcollector.sharefirstphasescorethreshold", "true");
+            EXPECT_TRUE(hitcollector::ShareFirstPhaseScoreThreshold::lookup(p));
+        }
         { // vespa.fieldweight.
             EXPECT_EQ(FieldWeight::BASE_NAME, std::string("vespa.fieldweight."));
             EXPECT_EQ(FieldWeight::DEFAULT_VALUE, 100u);
@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/searchlib/features/rankingexpressionfeature.h>
 #include <vespa/searchlib/features/valuefeature.h>
+#include <vespa/searchlib/fef/batch_rank_evaluator.h>
 #include <vespa/searchlib/fef/blueprintfactory.h>
 #include <vespa/searchlib/fef/indexproperties.h>
 #include <vespa/searchlib/fef/matchdatalayout.h>
@@ -145,6 +146,11 @@ struct Fixture {
         }
         return 31212.0;
     }
+    std::unique_ptr<BatchRankEvaluator> make_batch() {
+        auto result = program.get_seeds();
+        EXPECT_EQ(1u, result.num_features());
+        return BatchRankEvaluator::try_create(result.resolve(0));
+    }
     std::map<std::string, double> all(uint32_t docid = default_docid) {
         auto                          result = program.get_seeds();
         std::map<std::string, double> result_map;
@@ -428,6 +434,55 @@ TEST(RankProgramTest, fast_forest_gbdt_evaluation_is_pure) {
     EXPECT_EQ(f1.final_executor_name(), "search::features::FastForestExecutor");
 }
 
+TEST(RankProgramTest, compiled_ranking_expression_can_be_evaluated_in_batch) {
+    Fixture f1;
+    f1.lazy_expressions(false).add_expr("rank", "docid*value(2)+value(1)").compile();
+    auto batch = f1.make_batch();
+    ASSERT_TRUE(batch);
+    std::vector<uint32_t> docids = {3, 5, 8};
+    auto                  scores = batch->evaluate(docids);
+    EXPECT_EQ((std::vector<double>{7.0, 11.0, 17.0}), std::vector<double>(scores.begin(), scores.end()));
+    scores = batch->evaluate(std::span<const uint32_t>(docids).first(1));
+    EXPECT_EQ((std::vector<double>{7.0}), std::vector<double>(scores.begin(), scores.end()));
+    EXPECT_EQ(f1.get(8), 17.0);
+}
+
+TEST(RankProgramTest, fast_forest_gbdt_can_be_evaluated_in_batch) {
+    Fixture f1;
+    f1.use_fast_forest().add_expr("rank", "if(docid<5,1,2)+if(value(2)<1,10,20)").compile();
+    EXPECT_EQ(f1.final_executor_name(), "search::features::FastForestExecutor");
+    auto batch = f1.make_batch();
+    ASSERT_TRUE(batch);
+    std::vector<uint32_t> docids = {3, 7};
+    auto                  scores = batch->evaluate(docids);
+    EXPECT_EQ((std::vector<double>{21.0, 22.0}), std::vector<double>(scores.begin(), scores.end()));
+}
+
+TEST(RankProgramTest, batch_evaluation_requires_all_executors_to_support_it) {
+    Fixture f1;
+    f1.add("mysum(docid,value(1))").compile();
+    EXPECT_FALSE(f1.make_batch());
+    Fixture f2;
+    f2.lazy_expressions(true).add_expr("rank", "docid+value(1)").compile();
+    EXPECT_FALSE(f2.make_batch());
+    Fixture f3;
+    f3.lazy_expressions(false).add_expr("rank", "docid+ivalue(1)").compile();
+    EXPECT_FALSE(f3.make_batch());
+}
+
+TEST(RankProgramTest, const_features_are_not_evaluated_in_batch) {
+    Fixture f1;
+    f1.lazy_expressions(false).add_expr("rank", "value(7)").compile();
+    EXPECT_FALSE(f1.make_batch());
+}
+
+TEST(RankProgramTest, profiled_rank_program_is_not_evaluated_in_batch) {
+    Fixture           f1;
+    ExecutionProfiler profiler(64);
+    f1.lazy_expressions(false).add_expr("rank", "docid+value(1)").compile(&profiler);
+    EXPECT_FALSE(f1.make_batch());
+}
+
 TEST(RankProgramTest, rank_program_can_be_profiled) {
     Fixture           f1;
     ExecutionProfiler profiler(64);
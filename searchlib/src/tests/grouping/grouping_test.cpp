@@ -2,7 +2,9 @@
 
 #include <vespa/searchcommon/common/undefinedvalues.h>
 #include <vespa/searchlib/aggregation/aggregation.h>
+#include <vespa/searchlib/aggregation/columnar_grouper.h>
 #include <vespa/searchlib/aggregation/fs4hit.h>
+#include <vespa/searchlib/aggregation/heavy_hitters_aggregation_result.h>
 #include <vespa/searchlib/aggregation/hitsaggregationresult.h>
 #include <vespa/searchlib/aggregation/modifiers.h>
 #include <vespa/searchlib/aggregation/perdocexpression.h>
@@ -566,6 +568,81 @@ TEST(GroupingTest, Verify_that_groups_are_tagged_with_the_appropriate_rank_value
     EXPECT_TRUE(testAggregation(ctx, request, expect));
 }
 
+namespace {
+
+Grouping make_columnar_request(int64_t max_groups) {
+    Grouping request;
+    request.setFirstLevel(0)
+        .setLastLevel(1)
+        .setRoot(Group().addAggregationResult(createAggr<CountAggregationResult>(MU<AttributeNode>("int"))))
+        .addLevel(std::move(GroupingLevel()
+                                .setMaxGroups(max_groups)
+                                .setExpression(MU<AttributeNode>("key"))
+                                .addAggregationResult(createAggr<CountAggregationResult>(MU<AttributeNode>("int")))
+                                .addAggregationResult(createAggr<SumAggregationResult>(MU<AttributeNode>("int")))
+                                .addAggregationResult(createAggr<SumAggregationResult>(MU<AttributeNode>("float")))
+                                .addAggregationResult(createAggr<MinAggregationResult>(MU<AttributeNode>("int")))
+                                .addAggregationResult(createAggr<MaxAggregationResult>(MU<AttributeNode>("float")))
+                                .addAggregationResult(createAggr<AverageAggregationResult>(MU<AttributeNode>("int")))));
+    return request;
+}
+
+} // namespace
+
+TEST(GroupingTest, columnar_grouping_gives_same_result_as_general_grouping) {
+    AggregationContext ctx;
+    ctx.add(IntAttrBuilder("key").add(3).add(1).add(3).add(2).add(1).add(3).sp());
+    ctx.add(IntAttrBuilder("int").add(10).add(-4).add(7).add(5).add(2).add(undefinedInteger).sp());
+    ctx.add(FloatAttrBuilder("float").add(1.5).add(2.25).add(-3.0).add(0.5).add(7.0).add(4.0).sp());
+    ctx.result().add(0, 5).add(1, 10).add(2, 15).add(3, 10).add(4, 20).add(5, 5);
+    for (int64_t max_groups : {-1, 2}) {
+        SCOPED_TRACE(max_groups);
+        Grouping general = make_columnar_request(max_groups);
+        ctx.setup(general);
+        general.preAggregate(true);
+        for (uint32_t i = 0; i < ctx.result().size(); ++i) {
+            general.aggregate(ctx.result().hits()[i].getDocId(), ctx.result().hits()[i].getRank());
+        }
+        general.postProcess();
+
+        Grouping columnar = make_columnar_request(max_groups);
+        ctx.setup(columnar);
+        columnar.preAggregate(true);
+        auto grouper = ColumnarGrouper::try_create(columnar);
+        ASSERT_TRUE(grouper);
+        for (uint32_t i = 0; i < ctx.result().size(); ++i) {
+            grouper->aggregate(ctx.result().hits()[i].getDocId(), ctx.result().hits()[i].getRank());
+        }
+        grouper->finish();
+        columnar.postProcess();
+
+        EXPECT_EQ(general.getRoot().asString(), columnar.getRoot().asString());
+        EXPECT_EQ((max_groups == -1) ? 3u : 2u, columnar.getRoot().getChildrenSize());
+    }
+}
+
+TEST(GroupingTest, columnar_grouping_is_not_used_for_unsupported_requests) {
+    AggregationContext ctx;
+    ctx.add(IntAttrBuilder("key").add(1).sp());
+    ctx.add(IntArrayAttrBuilder("array").add(std::vector<int64_t>{1, 2}).sp());
+    ctx.add(FloatAttrBuilder("float").add(1.5).sp());
+    ctx.add(StringAttrBuilder("string").add("foo").sp());
+    auto try_create = [&ctx](ExpressionNode::UP key, ExpressionNode::UP aggr) {
+        Grouping request;
+        request.setFirstLevel(0).setLastLevel(1).addLevel(
+            std::move(GroupingLevel().setExpression(std::move(key)).addAggregationResult(std::move(aggr))));
+        ctx.setup(request);
+        request.preAggregate(false);
+        return static_cast<bool>(ColumnarGrouper::try_create(request));
+    };
+    EXPECT_TRUE(try_create(MU<AttributeNode>("key"), createAggr<SumAggregationResult>(MU<AttributeNode>("float"))));
+    EXPECT_FALSE(try_create(MU<AttributeNode>("array"), createAggr<SumAggregationResult>(MU<AttributeNode>("key"))));
+    EXPECT_FALSE(try_create(MU<AttributeNode>("float"), createAggr<SumAggregationResult>(MU<AttributeNode>("key"))));
+    EXPECT_FALSE(try_create(MU<AttributeNode>("key"), createAggr<SumAggregationResult>(MU<AttributeNode>("array"))));
+    EXPECT_FALSE(try_create(MU<AttributeNode>("key"), createAggr<SumAggregationResult>(MU<AttributeNode>("string"))));
+    EXPECT_FALSE(try_create(MU<AttributeNode>("key"), createAggr<XorAggregationResult>(MU<AttributeNode>("key"))));
+}
+
 TEST(GroupingTest, testAggregationGroupCapping) {
     AggregationContext ctx;
     ctx.add(IntAttrBuilder("attr").add(1).add(2).add(3).add(4).add(5).add(6).add(7).add(8).add(9).sp());
@@ -1579,6 +1656,48 @@ TEST(GroupingTest, testCount) {
     EXPECT_TRUE(testAggregation(ctx, request, expect));
 }
 
+Grouping aggregate_heavy_hitters(const std::vector<const char*>& values, uint32_t max_entries) {
+    AggregationContext ctx;
+    StringAttrBuilder  attr("foo");
+    for (uint32_t docid = 0; docid < values.size(); ++docid) {
+        attr.add(values[docid]);
+        ctx.result().add(docid);
+    }
+    ctx.add(attr.sp());
+    Grouping request;
+    request.setRoot(
+        Group().addResult(HeavyHittersAggregationResult(max_entries).setExpression(MU<AttributeNode>("foo"))));
+    ctx.setup(request);
+    request.aggregate(ctx.result().hits(), ctx.result().size());
+    // Pass the partial result through the wire format, as between content node and dispatcher
+    nbostream     os;
+    NBOSerializer nos(os);
+    request.serialize(nos);
+    Grouping result;
+    result.deserialize(nos);
+    return result;
+}
+
+TEST(GroupingTest, heavy_hitters_are_aggregated_and_merged) {
+    Grouping a = aggregate_heavy_hitters({"x", "x", "x", "y", "z"}, 2);
+    Grouping b = aggregate_heavy_hitters({"x", "y", "y", "y"}, 2);
+    a.merge(b);
+    const auto& result = static_cast<const HeavyHittersAggregationResult&>(a.getRoot().getAggregationResult(0));
+    EXPECT_EQ(2u, result.max_entries());
+    auto top = result.sketch().top(2);
+    ASSERT_EQ(2u, top.size());
+    // exact counts are x: 4 and y: 4, which are within the error bounds of the estimates
+    for (const auto* entry : top) {
+        char        buf[32];
+        auto        ref = entry->value->getString({buf, sizeof(buf)});
+        std::string value(ref.c_str(), ref.size());
+        EXPECT_TRUE(value == "x" || value == "y") << value;
+        EXPECT_LE(entry->count - entry->error, 4u);
+        EXPECT_GE(entry->count, 4u);
+    }
+    EXPECT_EQ(top[0]->count, result.getRank().getInteger());
+}
+
 TEST(GroupingTest, testFS4HitCollection) {
     { // aggregation
         AggregationContext ctx;
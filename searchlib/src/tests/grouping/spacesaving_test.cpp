@@ -0,0 +1,134 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+// Unit tests for the space-saving heavy hitter sketch.
+
+#include <vespa/searchlib/grouping/spacesaving.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/objects/nboserializer.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+
+#include <map>
+
+using vespalib::NBOSerializer;
+using vespalib::nbostream;
+using namespace search;
+
+namespace {
+
+using Sketch = SpaceSaving<int64_t>;
+
+void add(Sketch& sketch, int64_t value, size_t times = 1) {
+    for (size_t i = 0; i < times; ++i) {
+        sketch.add(value, [value]() { return value; });
+    }
+}
+
+std::map<int64_t, uint64_t> counts(const Sketch& sketch) {
+    std::map<int64_t, uint64_t> result;
+    for (const auto& entry : sketch.entries()) {
+        result[entry.value] = entry.count;
+    }
+    return result;
+}
+
+TEST(SpaceSavingTest, require_that_values_are_counted_exactly_below_capacity) {
+    Sketch sketch(4);
+    add(sketch, 1, 5);
+    add(sketch, 2, 3);
+    add(sketch, 3, 1);
+    EXPECT_EQ(3u, sketch.size());
+    EXPECT_FALSE(sketch.full());
+    EXPECT_EQ(0u, sketch.min_count());
+    EXPECT_EQ(5u, sketch.max_count());
+    EXPECT_EQ((std::map<int64_t, uint64_t>{{1, 5}, {2, 3}, {3, 1}}), counts(sketch));
+    auto top = sketch.top(2);
+    ASSERT_EQ(2u, top.size());
+    EXPECT_EQ(1, top[0]->value);
+    EXPECT_EQ(2, top[1]->value);
+    EXPECT_EQ(0u, top[0]->error);
+}
+
+TEST(SpaceSavingTest, require_that_new_value_takes_over_the_smallest_counter) {
+    Sketch sketch(2);
+    add(sketch, 1, 5);
+    add(sketch, 2, 2);
+    add(sketch, 3);
+    EXPECT_EQ(2u, sketch.size());
+    EXPECT_EQ((std::map<int64_t, uint64_t>{{1, 5}, {3, 3}}), counts(sketch));
+    EXPECT_EQ(5u, sketch.max_count());
+    auto top = sketch.top(2);
+    EXPECT_EQ(3, top[1]->value);
+    EXPECT_EQ(2u, top[1]->error);
+    add(sketch, 3, 3);
+    EXPECT_EQ(6u, sketch.max_count());
+}
+
+TEST(SpaceSavingTest, require_that_frequent_values_are_found_in_a_long_stream) {
+    Sketch   sketch(10);
+    uint64_t total = 0;
+    for (int64_t i = 0; i < 10000; ++i) {
+        add(sketch, i);                  // noise, each value seen once
+        add(sketch, 1000000 + (i % 3)); // three heavy hitters
+        total += 2;
+    }
+    auto top = sketch.top(3);
+    ASSERT_EQ(3u, top.size());
+    for (const auto* entry : top) {
+        EXPECT_GE(entry->value, 1000000);
+        EXPECT_GE(entry->count - entry->error, 3333u);
+        EXPECT_LE(entry->error, total / sketch.capacity());
+    }
+}
+
+TEST(SpaceSavingTest, require_that_sketches_can_be_merged) {
+    Sketch a(2);
+    Sketch b(2);
+    add(a, 1, 10);
+    add(a, 2, 4);
+    add(b, 1, 3);
+    add(b, 3, 6);
+    a.merge(b);
+    EXPECT_EQ(2u, a.size());
+    auto top = a.top(2);
+    EXPECT_EQ(1, top[0]->value);
+    EXPECT_EQ(13u, top[0]->count);
+    EXPECT_EQ(13u, a.max_count());
+    EXPECT_EQ(0u, top[0]->error);
+    // value 3 is missing from 'a', and is assumed to have a's smallest count (4)
+    EXPECT_EQ(3, top[1]->value);
+    EXPECT_EQ(10u, top[1]->count);
+    EXPECT_EQ(4u, top[1]->error);
+}
+
+TEST(SpaceSavingTest, require_that_merge_into_empty_sketch_gives_same_counts) {
+    Sketch a(3);
+    Sketch b(3);
+    add(b, 7, 2);
+    add(b, 8, 1);
+    a.merge(b);
+    EXPECT_EQ(counts(b), counts(a));
+}
+
+TEST(SpaceSavingTest, require_that_sketch_can_be_serialized_and_deserialized) {
+    Sketch sketch(3);
+    add(sketch, 1, 4);
+    add(sketch, 2, 2);
+    add(sketch, 3, 1);
+    add(sketch, 4, 1);
+    nbostream     stream;
+    NBOSerializer serializer(stream);
+    sketch.serialize(serializer);
+    Sketch copy(1);
+    copy.deserialize(serializer);
+    EXPECT_EQ(3u, copy.capacity());
+    EXPECT_EQ(counts(sketch), counts(copy));
+    EXPECT_EQ(sketch.min_count(), copy.min_count());
+    EXPECT_EQ(4u, copy.max_count());
+    add(sketch, 1);
+    add(copy, 1);
+    EXPECT_EQ(counts(sketch), counts(copy));
+}
+
+} // namespace
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -477,6 +477,24 @@ TEST(HitCollectorTest, require_that_result_set_is_merged_correctly_with_second_p
     checkResult(*rs, expRh);
 }
 
+TEST(HitCollectorTest, require_that_min_kept_score_is_available_when_hit_vector_is_full) {
+    HitCollector hc(1000, 3);
+    auto         no_threshold = -std::numeric_limits<feature_t>::infinity();
+    hc.addHit(1, 10.0);
+    hc.addHit(2, 5.0);
+    hc.addHit(3, 7.0);
+    EXPECT_EQ(no_threshold, hc.get_min_kept_score());
+    hc.addHit(4, 1.0);
+    EXPECT_EQ(5.0, hc.get_min_kept_score());
+    hc.addHit(5, 8.0);
+    EXPECT_EQ(7.0, hc.get_min_kept_score());
+    HitCollector unranked(1000, 0);
+    for (uint32_t docid = 1; docid < 10; ++docid) {
+        unranked.addHit(docid, 1.0);
+    }
+    EXPECT_EQ(no_threshold, unranked.get_min_kept_score());
+}
+
 TEST(HitCollectorTest, require_that_hits_can_be_added_out_of_order) {
     HitCollector           hc(1000, 100);
     std::vector<RankedHit> expRh;
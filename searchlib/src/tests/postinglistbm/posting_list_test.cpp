@@ -125,4 +125,20 @@ TEST_F(PostingListTest, verify_posting_list_iterators_over_weighted_set_field) {
     run();
 }
 
+TEST_F(PostingListTest, block_max_weak_and_over_posting_lists_with_block_max_features) {
+    setup(false, false);
+    std::unique_ptr<FPFactory>   factory(getFPFactory("Zc4SkipPosOccBE.cf.bm", word_set.getSchema()));
+    std::vector<const FakeWord*> words{word4.get(), word5.get()};
+    factory->setup(words);
+    auto posting4 = factory->make(*word4);
+    auto posting5 = factory->make(*word5);
+    int  or_hits = FakeMatchLoop::or_pair_posting_scan(*posting4, *posting5, num_docs);
+    // No pruning when target hits exceeds number of matching documents
+    EXPECT_EQ(or_hits,
+              FakeMatchLoop::weak_and_pair_posting_scan_with_unpack(*posting4, *posting5, num_docs, num_docs, true));
+    int bm_hits = FakeMatchLoop::weak_and_pair_posting_scan_with_unpack(*posting4, *posting5, num_docs, 100, true);
+    EXPECT_LE(100, bm_hits);
+    EXPECT_GT(or_hits, bm_hits);
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
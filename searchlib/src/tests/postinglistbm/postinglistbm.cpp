@@ -65,7 +65,7 @@ void usage() {
            "[-l <numLoops>] "
            "[-s <stride>] "
            "[-t <postingType>] "
-           "[-o {direct, and, or}] "
+           "[-o {direct, and, or, weakand, weakand-bm}] "
            "[-u] "
            "[-w <numWordsPerClass>]\n");
 }
@@ -170,9 +170,13 @@ int PostingListBM::main(int argc, char** argv) {
                 _operatorType = StressRunner::OperatorType::And;
             } else if (operatorType == "or") {
                 _operatorType = StressRunner::OperatorType::Or;
+            } else if (operatorType == "weakand") {
+                _operatorType = StressRunner::OperatorType::WeakAnd;
+            } else if (operatorType == "weakand-bm") {
+                _operatorType = StressRunner::OperatorType::WeakAndBlockMax;
             } else {
                 printf("Bad operator type: '%s'\n", operatorType.c_str());
-                printf("Supported types: direct, and, or\n");
+                printf("Supported types: direct, and, or, weakand, weakand-bm\n");
                 return 1;
             }
             break;
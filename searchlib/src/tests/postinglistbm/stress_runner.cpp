@@ -121,6 +121,15 @@ public:
     OrStressWorker(StressMaster& master, uint32_t id);
 };
 
+class WeakAndStressWorker : public StressWorker {
+private:
+    bool _block_max;
+    void run_task(const FakePosting& f1, const FakePosting& f2, uint32_t doc_id_limit, bool unpack) override;
+
+public:
+    WeakAndStressWorker(StressMaster& master, uint32_t id, bool block_max);
+};
+
 StressMaster::StressMaster(vespalib::Rand48& rnd, FakeWordSet& wordSet, const std::vector<std::string>& postingTypes,
                            StressRunner::OperatorType operatorType, uint32_t loops, uint32_t skipCommonPairsRate,
                            uint32_t numTasks, uint32_t stride, bool unpack)
@@ -280,6 +289,10 @@ double StressMaster::runWorkers(const std::string& postingFormat) {
             _workers.push_back(std::make_unique<AndStressWorker>(*this, i));
         } else if (_operatorType == StressRunner::OperatorType::Or) {
             _workers.push_back(std::make_unique<OrStressWorker>(*this, i));
+        } else if (_operatorType == StressRunner::OperatorType::WeakAnd) {
+            _workers.push_back(std::make_unique<WeakAndStressWorker>(*this, i, false));
+        } else if (_operatorType == StressRunner::OperatorType::WeakAndBlockMax) {
+            _workers.push_back(std::make_unique<WeakAndStressWorker>(*this, i, true));
         }
     }
 
@@ -354,6 +367,15 @@ void OrStressWorker::run_task(const FakePosting& f1, const FakePosting& f2, uint
     }
 }
 
+WeakAndStressWorker::WeakAndStressWorker(StressMaster& master, uint32_t id, bool block_max)
+    : StressWorker(master, id), _block_max(block_max) {
+}
+
+void WeakAndStressWorker::run_task(const FakePosting& f1, const FakePosting& f2, uint32_t doc_id_limit, bool) {
+    // Unpack is needed to raise the score threshold
+    FakeMatchLoop::weak_and_pair_posting_scan_with_unpack(f1, f2, doc_id_limit, 100, _block_max);
+}
+
 void StressRunner::run(vespalib::Rand48& rnd, FakeWordSet& wordSet, const std::vector<std::string>& postingTypes,
                        OperatorType operatorType, uint32_t loops, uint32_t skipCommonPairsRate, uint32_t numTasks,
                        uint32_t stride, bool unpack) {
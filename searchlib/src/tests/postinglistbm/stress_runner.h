@@ -17,7 +17,7 @@ namespace postinglistbm {
 
 class StressRunner {
 public:
-    enum class OperatorType { Direct, And, Or };
+    enum class OperatorType { Direct, And, Or, WeakAnd, WeakAndBlockMax };
 
     static void run(vespalib::Rand48& rnd, search::fakedata::FakeWordSet& wordSet,
                     const std::vector<std::string>& postingTypes, OperatorType operatorType, uint32_t loops,
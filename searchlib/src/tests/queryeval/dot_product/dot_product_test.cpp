@@ -7,8 +7,10 @@
 #include <vespa/searchlib/queryeval/emptysearch.h>
 #include <vespa/searchlib/queryeval/fake_requestcontext.h>
 #include <vespa/searchlib/queryeval/fake_result.h>
+#include <vespa/searchlib/queryeval/fake_search.h>
 #include <vespa/searchlib/queryeval/fake_searchable.h>
 #include <vespa/searchlib/queryeval/field_spec.h>
+#include <vespa/searchlib/queryeval/shared_score_threshold.h>
 #include <vespa/searchlib/test/weightedchildrenverifiers.h>
 #include <vespa/vespalib/gtest/gtest.h>
 
@@ -138,6 +140,50 @@ struct MockFixture {
 
 MockFixture::~MockFixture() = default;
 
+// children: "a" matches all documents with a low score, "b" and "c" match a single document each
+struct ThresholdFixture {
+    TermFieldMatchData    tfmd;
+    std::vector<int32_t>  weights;
+    SharedScoreThreshold  threshold;
+    SearchIterator::UP    search;
+    ThresholdFixture(bool use_threshold) : tfmd(), weights({1, 10, 50}), threshold(), search() {
+        FakeResult a;
+        for (uint32_t docid = 1; docid < 10; ++docid) {
+            a.doc(docid).weight(1).pos(0);
+        }
+        std::vector<FakeResult> results = {a, FakeResult().doc(5).weight(10).pos(0),
+                                           FakeResult().doc(7).weight(1).pos(0)};
+        std::vector<feature_t>  max_scores = {1.0, 100.0, 50.0};
+        MatchData::UP           md(MatchData::makeTestInstance(results.size(), results.size()));
+        std::vector<SearchIterator*>     children;
+        std::vector<TermFieldMatchData*> childMatch;
+        for (size_t i = 0; i < results.size(); ++i) {
+            TermFieldMatchDataArray tfmda;
+            tfmda.add(md->resolveTermField(i));
+            children.push_back(new FakeSearch("tag", "field", "term", results[i], tfmda));
+            childMatch.push_back(md->resolveTermField(i));
+        }
+        search = DotProductSearch::create(children, tfmd, false, childMatch, weights, std::move(md),
+                                          use_threshold ? &threshold : nullptr, std::move(max_scores));
+        search->initFullRange();
+    }
+    ~ThresholdFixture();
+    // returns the next hit and its score, raising the threshold to 'raise_to' first
+    std::pair<uint32_t, feature_t> next(uint32_t docid, double raise_to) {
+        threshold.raise(raise_to);
+        if (!search->seek(docid)) {
+            if (search->isAtEnd()) {
+                return {search::endDocId, 0.0};
+            }
+            docid = search->getDocId();
+        }
+        search->unpack(docid);
+        return {docid, tfmd.getRawScore()};
+    }
+};
+
+ThresholdFixture::~ThresholdFixture() = default;
+
 void verifySimple(const FakeResult& expect, DP& ws) {
     FakeSearchable index;
     setupFakeSearchable(index);
@@ -282,6 +328,35 @@ TEST(DotProductTest, test_eager_matching_children) {
     verifyEagerMatching(search, mock);
 }
 
+TEST(DotProductTest, test_all_hits_are_produced_without_score_threshold) {
+    ThresholdFixture f(false);
+    for (uint32_t docid = 1; docid < 10; ++docid) {
+        EXPECT_EQ(docid, f.next(docid, 1000.0).first);
+    }
+}
+
+TEST(DotProductTest, test_documents_not_scoring_above_score_threshold_are_skipped) {
+    ThresholdFixture f(true);
+    EXPECT_EQ(std::make_pair(1u, 1.0), f.next(1, 0.5));
+    EXPECT_EQ(std::make_pair(2u, 1.0), f.next(2, 0.5));
+    // "a" is no longer essential, only documents matched by "b" or "c" are candidates
+    EXPECT_EQ(std::make_pair(5u, 101.0), f.next(3, 10.0));
+    EXPECT_EQ(std::make_pair(7u, 51.0), f.next(6, 10.0));
+    EXPECT_EQ(search::endDocId, f.next(8, 10.0).first);
+}
+
+TEST(DotProductTest, test_candidates_are_scored_against_raised_score_threshold) {
+    ThresholdFixture f(true);
+    EXPECT_EQ(std::make_pair(5u, 101.0), f.next(1, 10.0));
+    // only "b" is essential, and it has no more documents
+    EXPECT_EQ(search::endDocId, f.next(6, 60.0).first);
+}
+
+TEST(DotProductTest, test_search_is_at_end_when_no_document_can_score_above_score_threshold) {
+    ThresholdFixture f(true);
+    EXPECT_EQ(search::endDocId, f.next(1, 151.0).first);
+}
+
 class IteratorChildrenVerifier : public search::test::IteratorChildrenVerifier {
 private:
     SearchIterator::UP create(const std::vector<SearchIterator*>& children) const override {
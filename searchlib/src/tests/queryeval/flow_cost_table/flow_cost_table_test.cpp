@@ -0,0 +1,89 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/queryeval/flow_calibrator.h>
+#include <vespa/searchlib/queryeval/flow_cost_table.h>
+#include <vespa/searchlib/queryeval/flow_tuning.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/exceptions.h>
+
+using namespace search::queryeval;
+using namespace search::queryeval::flow;
+
+// Installs a cost table for the lifetime of the guard
+class BindTable {
+    FlowCostTable _prev;
+
+public:
+    explicit BindTable(const FlowCostTable& table) : _prev(FlowCostTable::get()) { FlowCostTable::set(table); }
+    ~BindTable() { FlowCostTable::set(_prev); }
+};
+
+TEST(FlowCostTableTest, default_table_matches_hand_tuned_constants) {
+    BindTable bind(FlowCostTable{});
+    EXPECT_DOUBLE_EQ(heap_cost(0.5, 16), 2.0);
+    EXPECT_DOUBLE_EQ(intermediate_activation_cost(), 0.5);
+    EXPECT_DOUBLE_EQ(lookup_cost(2), 3.0);
+    EXPECT_DOUBLE_EQ(reverse_hash_lookup(), 1.0);
+    EXPECT_DOUBLE_EQ(btree_strict_cost(0.25), 0.25);
+    EXPECT_DOUBLE_EQ(btree_cost(0.25), 2.0 * (0.25 + 0.2 * 0.25));
+    EXPECT_DOUBLE_EQ(bitvector_cost(), 1.0);
+    EXPECT_DOUBLE_EQ(bitvector_strict_cost(0.5), 0.75);
+    EXPECT_DOUBLE_EQ(disk_index_strict_cost(0.5), 0.75);
+    EXPECT_DOUBLE_EQ(strict_cost_diff(0.1, 0.6), 0.1);
+}
+
+TEST(FlowCostTableTest, active_table_is_used_by_cost_functions) {
+    FlowCostTable table;
+    table.heap = 2.0;
+    table.lookup_indirection = 3.0;
+    table.bitvector_strict = 0.5;
+    table.strict_cost_diff = 0.4;
+    BindTable bind(table);
+    EXPECT_DOUBLE_EQ(heap_cost(0.5, 16), 4.0);
+    EXPECT_DOUBLE_EQ(lookup_cost(2), 7.0);
+    EXPECT_DOUBLE_EQ(bitvector_strict_cost(0.5), 0.25);
+    EXPECT_DOUBLE_EQ(strict_cost_diff(0.1, 0.6), 0.2);
+}
+
+TEST(FlowCostTableTest, table_can_be_converted_to_and_from_json) {
+    FlowCostTable table;
+    table.heap = 1.25;
+    table.disk_index_strict = 3.5;
+    auto json = table.to_json();
+    EXPECT_NE(json.find("\"disk_index_strict\""), std::string::npos);
+    EXPECT_EQ(FlowCostTable::from_json(json), table);
+    EXPECT_NE(FlowCostTable::from_json(json), FlowCostTable());
+}
+
+TEST(FlowCostTableTest, missing_factors_keep_default_values) {
+    auto table = FlowCostTable::from_json("{\"bitvector\": 0.75, \"unknown\": 5.0}");
+    FlowCostTable expect;
+    expect.bitvector = 0.75;
+    EXPECT_EQ(table, expect);
+}
+
+TEST(FlowCostTableTest, invalid_json_is_rejected) {
+    EXPECT_THROW(FlowCostTable::from_json("{\"heap\": "), vespalib::IllegalArgumentException);
+    EXPECT_THROW(FlowCostTable::from_json("[1.0, 2.0]"), vespalib::IllegalArgumentException);
+}
+
+TEST(FlowCostTableTest, calibrated_table_has_sane_factors) {
+    FlowCalibrator::Params params;
+    params.docid_limit = 20'000;
+    params.num_heap_children = 4;
+    params.budget_s = 0.001;
+    FlowCostTable base;
+    base.disk_index_strict = 2.5;
+    auto table = FlowCalibrator(params).calibrate(base);
+    EXPECT_DOUBLE_EQ(table.btree_strict, 1.0);
+    EXPECT_DOUBLE_EQ(table.disk_index_strict, 2.5);
+    EXPECT_DOUBLE_EQ(table.strict_cost_diff, base.strict_cost_diff);
+    EXPECT_DOUBLE_EQ(table.reverse_hash_lookup, base.reverse_hash_lookup);
+    for (double factor : {table.heap, table.intermediate_activation, table.lookup, table.lookup_indirection,
+                          table.non_strict_of_strict, table.bitvector, table.bitvector_strict}) {
+        EXPECT_GT(factor, 0.0);
+        EXPECT_LT(factor, 1000.0);
+    }
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
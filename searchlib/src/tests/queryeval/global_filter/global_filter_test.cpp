@@ -204,6 +204,21 @@ TEST(GlobalFilterTest, multi_threaded_global_filter_works_with_docid_limit_0) {
     verify(*filter, 2, 1);
 }
 
+TEST(GlobalFilterTest, global_filter_with_few_hits_is_compressed) {
+    SimpleThreadBundle thread_bundle(3);
+    auto               blueprint = create_blueprint(1000, 100000);
+    auto               filter = GlobalFilter::create(*blueprint, 100000, thread_bundle);
+    EXPECT_THAT(vespalib::getClassName(*filter), HasSubstr("RoaringBitVectorFilter"));
+    verify(*filter, 1000, 100000);
+}
+
+TEST(GlobalFilterTest, global_filter_with_many_hits_is_not_compressed) {
+    auto blueprint = create_blueprint(2, 1000);
+    auto filter = GlobalFilter::create(*blueprint, 1000, ThreadBundle::trivial());
+    EXPECT_THAT(vespalib::getClassName(*filter), Not(HasSubstr("Roaring")));
+    verify(*filter, 2, 1000);
+}
+
 TEST(GlobalFilterTest, global_filter_matching_any_document_becomes_invalid) {
     SimpleThreadBundle  thread_bundle(7);
     AlwaysTrueBlueprint blueprint;
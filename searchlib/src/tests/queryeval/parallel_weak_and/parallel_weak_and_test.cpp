@@ -3,6 +3,7 @@
 #include <vespa/searchlib/queryeval/docid_with_weight_search_iterator.h>
 #include <vespa/searchlib/queryeval/fake_requestcontext.h>
 #include <vespa/searchlib/queryeval/fake_searchable.h>
+#include <vespa/searchlib/queryeval/shared_score_threshold.h>
 #include <vespa/searchlib/queryeval/simpleresult.h>
 #include <vespa/searchlib/queryeval/test/eagerchild.h>
 #include <vespa/searchlib/queryeval/test/leafspec.h>
@@ -248,6 +249,17 @@ struct AlgoScoreThresholdFixture : public FixtureBase {
     }
 };
 
+struct AlgoSharedScoreThresholdFixture : public FixtureBase {
+    SharedScoreThreshold threshold;
+    explicit AlgoSharedScoreThresholdFixture(double first_phase_score_threshold) : FixtureBase(3, 1), threshold() {
+        threshold.raise(first_phase_score_threshold);
+        spec.matchParams.firstPhaseScoreThreshold = &threshold;
+        spec.leaf(LeafSpec("A", 1).doc(1, 10).doc(2, 30));
+        spec.leaf(LeafSpec("B", 2).doc(1, 20).doc(3, 40));
+        prepare();
+    }
+};
+
 struct AlgoLargeScoresFixture : public FixtureBase {
     explicit AlgoLargeScoresFixture(score_t scoreThreshold) : FixtureBase(3, 1, scoreThreshold) {
         spec.leaf(LeafSpec("A", 60000).doc(1, 60000).doc(2, 70000));
@@ -404,6 +416,17 @@ TEST(ParallelWeakAndTest, require_that_algorithm_uses_initial_score_threshold_ca
     EXPECT_EQ(FakeResult(), f.result);
 }
 
+TEST(ParallelWeakAndTest, require_that_algorithm_uses_shared_first_phase_score_threshold) {
+    AlgoSharedScoreThresholdFixture f1(29.5);
+    AlgoSharedScoreThresholdFixture f2(30.0);
+    AlgoSharedScoreThresholdFixture f3(49.5);
+    AlgoSharedScoreThresholdFixture f4(50.0);
+    EXPECT_EQ(FakeResult().doc(1).score(1 * 10 + 2 * 20).doc(2).score(1 * 30).doc(3).score(2 * 40), f1.result);
+    EXPECT_EQ(FakeResult().doc(1).score(1 * 10 + 2 * 20).doc(3).score(2 * 40), f2.result);
+    EXPECT_EQ(FakeResult().doc(1).score(1 * 10 + 2 * 20).doc(3).score(2 * 40), f3.result);
+    EXPECT_EQ(FakeResult().doc(3).score(2 * 40), f4.result);
+}
+
 TEST(ParallelWeakAndTest, require_that_algorithm_handles_large_scores) {
     AlgoLargeScoresFixture f(60000L * 70000L);
     EXPECT_EQ(FakeResult().doc(1).score(60000L * 60000L + 70000L * 80000L).doc(3).score(70000L * 90000L), f.result);
@@ -586,6 +609,26 @@ TEST(ParallelWeakAndTest, require_that_docid_limit_is_propagated_to_search_itera
     EXPECT_EQ(4050u, wand->getMatchParams().docIdLimit);
 }
 
+TEST(ParallelWeakAndTest, require_that_first_phase_score_threshold_is_only_propagated_in_first_phase) {
+    BlueprintFixture     f;
+    SharedScoreThreshold threshold;
+    Node::UP             term = f.spec.createNode();
+    Blueprint::UP        bp = f.blueprint(*term);
+    bp->set_first_phase_score_threshold(&threshold);
+    bp->basic_plan(true, 100);
+    bp->fetchPostings(ExecuteInfo::FULL);
+    MatchData::UP      md(MatchData::makeTestInstance(1, 1));
+    SearchIterator::UP itr = bp->createSearch(*md);
+    const auto*        wand = dynamic_cast<ParallelWeakAndSearch*>(itr.get());
+    ASSERT_TRUE(wand != nullptr);
+    EXPECT_EQ(&threshold, wand->getMatchParams().firstPhaseScoreThreshold);
+    bp->set_matching_phase(MatchingPhase::SECOND_PHASE);
+    itr = bp->createSearch(*md);
+    wand = dynamic_cast<ParallelWeakAndSearch*>(itr.get());
+    ASSERT_TRUE(wand != nullptr);
+    EXPECT_EQ(nullptr, wand->getMatchParams().firstPhaseScoreThreshold);
+}
+
 TEST(ParallelWeakAndTest, require_that_terms_are_sorted_for_maximum_skipping) {
     BlueprintHitsFixture f1(50, 50, 100);
     BlueprintHitsFixture f2(60, 50, 100);
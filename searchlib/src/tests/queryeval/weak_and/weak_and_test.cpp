@@ -1,4 +1,5 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/searchlib/queryeval/i_block_max_iterator.h>
 #include <vespa/searchlib/queryeval/matching_phase.h>
 #include <vespa/searchlib/queryeval/simpleresult.h>
 #include <vespa/searchlib/queryeval/test/eagerchild.h>
@@ -9,6 +10,8 @@
 #include <vespa/searchlib/test/weightedchildrenverifiers.h>
 #include <vespa/vespalib/gtest/gtest.h>
 
+#include <random>
+
 using namespace search::fef;
 using namespace search::queryeval;
 using namespace search::queryeval::test;
@@ -230,6 +233,132 @@ TEST(WeakAndTest, require_that_the_selected_adjust_word_must_match_when_using_st
               spec.getHistory());
 }
 
+namespace {
+
+constexpr uint32_t block_max_docid_limit = 2000;
+
+using Posting = std::pair<uint32_t, uint32_t>; // docid, num_occs
+
+/*
+ * Posting list with block max information for blocks of block_size postings.
+ * block_size 0 means that the blocks are present, but their bounds are unknown.
+ */
+class BlockMaxChild : public SearchIterator, public IBlockMaxIterator {
+    const std::vector<Posting>& _postings;
+    uint32_t                    _block_size;
+    size_t                      _pos;
+    uint32_t&                   _scored;
+
+public:
+    BlockMaxChild(const std::vector<Posting>& postings, uint32_t block_size, uint32_t& scored)
+        : SearchIterator(), _postings(postings), _block_size(block_size), _pos(0), _scored(scored) {}
+    void initRange(uint32_t begin, uint32_t end) override {
+        SearchIterator::initRange(begin, end);
+        _pos = 0;
+    }
+    void doSeek(uint32_t docid) override {
+        while (_pos < _postings.size() && _postings[_pos].first < docid) {
+            ++_pos;
+        }
+        if (_pos < _postings.size()) {
+            setDocId(_postings[_pos].first);
+        } else {
+            setAtEnd();
+        }
+    }
+    void doUnpack(uint32_t) override {}
+    Trinary is_strict() const override { return Trinary::True; }
+    bool has_block_max_info() const noexcept override { return true; }
+    BlockInfo get_block_info(uint32_t docid) override {
+        size_t idx = _pos;
+        while (idx < _postings.size() && _postings[idx].first < docid) {
+            ++idx;
+        }
+        if (idx == _postings.size()) {
+            return {search::endDocId - 1, 0};
+        }
+        if (_block_size == 0) {
+            return {_postings[idx].first, unknown_max_num_occs};
+        }
+        size_t   block_end = std::min(_postings.size(), (idx / _block_size + 1) * _block_size);
+        uint32_t max_num_occs = 0;
+        for (size_t i = idx; i < block_end; ++i) {
+            max_num_occs = std::max(max_num_occs, _postings[i].second);
+        }
+        return {_postings[block_end - 1].first, max_num_occs};
+    }
+    uint32_t get_num_occs() const noexcept override {
+        ++_scored;
+        return _postings[_pos].second;
+    }
+};
+
+struct BlockMaxWandFixture {
+    std::vector<std::vector<Posting>> postings;
+    uint32_t                          scored;
+    BlockMaxWandFixture() : postings(), scored(0) {
+        std::mt19937 gen(42);
+        for (double density : {0.5, 0.2, 0.05}) {
+            std::bernoulli_distribution     match(density);
+            std::uniform_int_distribution<> num_occs(1, 8);
+            auto&                           list = postings.emplace_back();
+            for (uint32_t docid = 1; docid < block_max_docid_limit; ++docid) {
+                if (match(gen)) {
+                    list.emplace_back(docid, num_occs(gen));
+                }
+            }
+        }
+    }
+    ~BlockMaxWandFixture();
+    wand::Terms make_terms(uint32_t block_size) {
+        wand::Terms terms;
+        for (const auto& list : postings) {
+            terms.emplace_back(new BlockMaxChild(list, block_size, scored), 100, list.size());
+        }
+        return terms;
+    }
+    SimpleResult search(uint32_t block_size, uint32_t n, bool block_max, bool strict) {
+        SharedWeakAndPriorityQueue scores(n);
+        wand::MatchParams match_params(scores, wand::StopWordStrategy::none(), 1, block_max_docid_limit);
+        auto              terms = make_terms(block_size);
+        auto search = block_max ? WeakAndSearch::create_block_max(terms, match_params, n, strict, false)
+                                : WeakAndSearch::create(terms, match_params, n, strict, false);
+        scored = 0;
+        SimpleResult hits;
+        hits.search(*search, block_max_docid_limit);
+        return hits;
+    }
+};
+
+BlockMaxWandFixture::~BlockMaxWandFixture() = default;
+
+} // namespace
+
+TEST(WeakAndTest, require_that_block_max_wand_gives_same_hits_as_wand_when_heap_is_not_full) {
+    BlockMaxWandFixture f;
+    for (bool strict : {false, true}) {
+        auto expect = f.search(8, 10000, false, strict);
+        EXPECT_LT(1000u, expect.getHitCount());
+        EXPECT_EQ(expect, f.search(8, 10000, true, strict));
+        EXPECT_EQ(expect, f.search(0, 10000, true, strict));
+    }
+}
+
+TEST(WeakAndTest, require_that_block_max_wand_skips_blocks_without_losing_hits) {
+    BlockMaxWandFixture f;
+    for (bool strict : {false, true}) {
+        // Unknown block bounds means every candidate document is scored
+        auto     expect = f.search(0, 20, true, strict);
+        uint32_t scored_without_block_bounds = f.scored;
+        EXPECT_LT(20u, expect.getHitCount());
+        EXPECT_GT(f.search(0, 10000, true, strict).getHitCount(), expect.getHitCount());
+        EXPECT_EQ(expect, f.search(1, 20, true, strict));
+        EXPECT_GT(scored_without_block_bounds, f.scored);
+        EXPECT_EQ(expect, f.search(8, 20, true, strict));
+        EXPECT_EQ(expect, f.search(64, 20, true, strict));
+    }
+}
+
 class IteratorChildrenVerifier : public search::test::IteratorChildrenVerifier {
 public:
     IteratorChildrenVerifier();
@@ -100,6 +100,9 @@ TEST(AttributeConfigTest, DictionaryConfig) {
 
     EXPECT_EQ(Type::HASH, DictionaryConfig(Type::HASH).getType());
     EXPECT_EQ(Type::BTREE_AND_HASH, DictionaryConfig(Type::BTREE_AND_HASH).getType());
+    EXPECT_FALSE(DictionaryConfig().get_trigram_index());
+    EXPECT_TRUE(DictionaryConfig(Type::BTREE, Match::CASED, true).get_trigram_index());
+    EXPECT_NE(DictionaryConfig(Type::BTREE, Match::UNCASED, true), DictionaryConfig(Type::BTREE, Match::UNCASED));
 
     EXPECT_EQ(DictionaryConfig(Type::BTREE), DictionaryConfig(Type::BTREE));
     EXPECT_EQ(DictionaryConfig(Type::HASH), DictionaryConfig(Type::HASH));
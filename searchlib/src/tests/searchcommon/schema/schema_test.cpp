@@ -34,6 +34,8 @@ void assertIndexField(const Schema::IndexField& exp, const Schema::IndexField& a
     assertField(exp, act);
     EXPECT_EQ(exp.getAvgElemLen(), act.getAvgElemLen());
     EXPECT_EQ(exp.use_interleaved_features(), act.use_interleaved_features());
+    EXPECT_EQ(exp.use_packed_doc_ids(), act.use_packed_doc_ids());
+    EXPECT_EQ(exp.use_block_max_features(), act.use_block_max_features());
 }
 
 void assertSet(const Schema::FieldSet& exp, const Schema::FieldSet& act) {
@@ -142,7 +144,9 @@ TEST(SchemaTest, test_load_and_save) {
         EXPECT_EQ(3u, s.getNumIndexFields());
         assertIndexField(SIF("a", SDT::STRING), s.getIndexField(0));
         assertIndexField(SIF("b", SDT::INT64), s.getIndexField(1));
-        assertIndexField(SIF("c", SDT::STRING).set_interleaved_features(true), s.getIndexField(2));
+        assertIndexField(
+            SIF("c", SDT::STRING).set_interleaved_features(true).set_packed_doc_ids(true).set_block_max_features(true),
+            s.getIndexField(2));
 
         EXPECT_EQ(9u, s.getNumAttributeFields());
         assertField(SAF("a", SDT::STRING, SCT::SINGLE), s.getAttributeField(0));
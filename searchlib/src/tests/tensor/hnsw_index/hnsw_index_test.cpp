@@ -21,9 +21,13 @@
 #include <vespa/vespalib/net/http/state_explorer.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/util/fake_deadline.h>
+#include <vespa/vespalib/util/mmap_file_allocator.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
 
 #include <vespa/searchlib/tensor/hnsw_index_loader.hpp>
 
+#include <atomic>
+#include <filesystem>
 #include <type_traits>
 #include <vector>
 
@@ -49,12 +53,12 @@ template <typename FloatType> class MyDocVectorAccess : public DocVectorAccess {
 private:
     using Vector = std::vector<FloatType>;
     using ArrayRef = std::span<const FloatType>;
-    mutable std::vector<Vector> _vectors;
-    SubspaceType                _subspace_type;
-    EmptySubspace               _empty;
-    mutable uint32_t            _get_vector_count;
-    mutable uint32_t            _schedule_clear_tensor;
-    mutable uint32_t            _cleared_tensor_docid;
+    mutable std::vector<Vector>   _vectors;
+    SubspaceType                  _subspace_type;
+    EmptySubspace                 _empty;
+    mutable std::atomic<uint32_t> _get_vector_count;
+    mutable uint32_t              _schedule_clear_tensor;
+    mutable uint32_t              _cleared_tensor_docid;
 
 public:
     MyDocVectorAccess()
@@ -1084,6 +1088,87 @@ TYPED_TEST(HnswIndexTest, inconsistent_index) {
     this->expect_level_0(5, {4});
 }
 
+TYPED_TEST(HnswIndexTest, documents_can_be_added_in_bulk_using_thread_bundle) {
+    auto generator = std::make_unique<LevelGenerator>();
+    this->level_generator = generator.get();
+    this->index = std::make_unique<TypeParam>(this->vectors, this->dff(), std::move(generator),
+                                              HnswIndexConfig(16, 8, 100, 0, true));
+    this->vectors.clear();
+    constexpr uint32_t    grid_size = 30;
+    std::vector<uint32_t> docids;
+    for (uint32_t x = 0; x < grid_size; ++x) {
+        for (uint32_t y = 0; y < grid_size; ++y) {
+            uint32_t docid = 1 + x * grid_size + y;
+            this->vectors.set(docid, {float(x), float(y)});
+            docids.push_back(docid);
+        }
+    }
+    vespalib::SimpleThreadBundle thread_bundle(4);
+    this->index->add_documents(docids, thread_bundle);
+    this->commit();
+    EXPECT_EQ(docids.size(), this->get_active_nodes());
+    EXPECT_EQ(0, this->index->check_consistency(docids.size() + 1));
+    uint32_t found_self = 0;
+    for (uint32_t docid : docids) {
+        NearestNeighborIndex::Stats stats;
+        auto df = this->index->distance_function_factory().for_query_vector(this->vectors.get_vector(docid, 0));
+        auto hits = this->index->find_top_k(stats, 1, *df, 50, 0.0, false, this->_doom->get_deadline(), 10000.0);
+        if (!hits.empty() && hits[0].docid == docid) {
+            ++found_self;
+        }
+    }
+    // Documents prepared in the same batch are not linked directly to each other, but the graph is still navigable
+    EXPECT_LE(docids.size() * 0.95, found_self);
+}
+
+using HnswSingleIndexTest = HnswIndexTest<HnswIndex<HnswIndexType::SINGLE>>;
+
+TEST_F(HnswSingleIndexTest, quantized_traversal_reranks_candidates_with_full_precision_distances) {
+    auto generator = std::make_unique<LevelGenerator>();
+    level_generator = generator.get();
+    index = std::make_unique<HnswIndex<HnswIndexType::SINGLE>>(
+        vectors, dff_real(), std::move(generator), HnswIndexConfig(5, 2, 10, 0, true),
+        std::make_unique<HnswQuantizedTraversal>(search::attribute::DistanceMetric::Euclidean, 2, 4));
+    ASSERT_NE(nullptr, index->quantized_traversal());
+    auto memory_usage_before = memory_usage();
+    for (uint32_t docid = 1; docid < 10; ++docid) {
+        add_document(docid);
+    }
+    EXPECT_LT(memory_usage_before.usedBytes(), memory_usage().usedBytes());
+    expect_top_3_by_docid("{3,3}", {3, 3}, {1, 2, 3});
+    expect_top_3_by_docid("{7,3}", {7, 3}, {5, 6, 9});
+
+    std::vector<float>          qv = {3, 3};
+    vespalib::eval::TypedCells  qv_cells(std::span<const float>(qv.data(), qv.size()));
+    NearestNeighborIndex::Stats stats;
+    auto                        df = index->distance_function_factory().for_query_vector(qv_cells);
+    auto hits = index->find_top_k(stats, 3, *df, 100, 0.0, false, _doom->get_deadline(), 10000.0);
+    ASSERT_EQ(3, hits.size());
+    EXPECT_EQ(NearestNeighborIndex::Neighbor(1, 2.0), hits[0]);
+    EXPECT_EQ(NearestNeighborIndex::Neighbor(2, 1.0), hits[1]);
+    EXPECT_EQ(NearestNeighborIndex::Neighbor(3, 1.0), hits[2]);
+}
+
+TEST_F(HnswSingleIndexTest, link_arrays_can_be_allocated_in_memory_mapped_file) {
+    std::filesystem::remove_all("mmap_links");
+    auto links_allocator = std::make_shared<vespalib::alloc::MmapFileAllocator>("mmap_links");
+    auto generator = std::make_unique<LevelGenerator>();
+    level_generator = generator.get();
+    index = std::make_unique<HnswIndex<HnswIndexType::SINGLE>>(
+        vectors, dff_real(), std::move(generator), HnswIndexConfig(5, 2, 10, 0, true),
+        std::make_unique<HnswQuantizedTraversal>(search::attribute::DistanceMetric::Euclidean, 2, 4),
+        links_allocator);
+    for (uint32_t docid = 1; docid < 10; ++docid) {
+        add_document(docid);
+    }
+    EXPECT_LT(0, links_allocator->get_end_offset());
+    expect_top_3_by_docid("{3,3}", {3, 3}, {1, 2, 3});
+    expect_top_3_by_docid("{7,3}", {7, 3}, {5, 6, 9});
+    index.reset();
+    links_allocator.reset();
+    std::filesystem::remove_all("mmap_links");
+}
+
 using HnswMultiIndexTest = HnswIndexTest<HnswIndex<HnswIndexType::MULTI>>;
 
 namespace {
@@ -0,0 +1,260 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/searchcommon/attribute/hnsw_index_params.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/queryeval/global_filter.h>
+#include <vespa/searchlib/tensor/default_nearest_neighbor_index_factory.h>
+#include <vespa/searchlib/tensor/doc_vector_access.h>
+#include <vespa/searchlib/tensor/nearest_neighbor_index_partition.h>
+#include <vespa/searchlib/tensor/partitioned_nearest_neighbor_index.h>
+#include <vespa/searchlib/tensor/subspace_type.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/fake_deadline.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
+
+#include <vector>
+
+using search::AttributeFactory;
+using search::AttributeVector;
+using search::IntegerAttribute;
+using search::attribute::BasicType;
+using search::attribute::Config;
+using search::attribute::DistanceMetric;
+using search::attribute::HnswIndexParams;
+using search::queryeval::GlobalFilter;
+using vespalib::eval::CellType;
+using vespalib::eval::TypedCells;
+using vespalib::eval::ValueType;
+using namespace search::tensor;
+
+namespace {
+
+class MyDocVectorAccess : public DocVectorAccess {
+    std::vector<std::vector<float>> _vectors;
+    SubspaceType                    _subspace_type;
+
+public:
+    MyDocVectorAccess() : _vectors(), _subspace_type(ValueType::from_spec("tensor<float>(x[2])")) {}
+    void set(uint32_t docid, std::vector<float> vector) {
+        if (docid >= _vectors.size()) {
+            _vectors.resize(docid + 1);
+        }
+        _vectors[docid] = std::move(vector);
+    }
+    TypedCells get_vector(uint32_t docid, uint32_t subspace) const noexcept override {
+        return get_vectors(docid).cells(subspace);
+    }
+    VectorBundle get_vectors(uint32_t docid) const noexcept override {
+        const auto& vector = _vectors[docid];
+        return {vector.data(), static_cast<uint32_t>(vector.size() / 2), _subspace_type};
+    }
+};
+
+} // namespace
+
+class PartitionedNearestNeighborIndexTest : public ::testing::Test {
+protected:
+    MyDocVectorAccess                     _vectors;
+    std::shared_ptr<AttributeVector>      _tenant;
+    std::unique_ptr<NearestNeighborIndex> _index;
+    vespalib::FakeDeadline                _doom;
+
+    PartitionedNearestNeighborIndexTest()
+        : _vectors(),
+          _tenant(AttributeFactory::createAttribute("tenant", Config(BasicType::INT64))),
+          _index(),
+          _doom() {
+        HnswIndexParams params(16, 100, DistanceMetric::Euclidean, false, 0, "tenant");
+        _index = DefaultNearestNeighborIndexFactory().make(_vectors, 2, false, CellType::FLOAT, params,
+                                                           std::nullopt, {});
+        _tenant->addReservedDoc();
+    }
+    ~PartitionedNearestNeighborIndexTest() override;
+
+    // Document i has the vector (i, 0)
+    void set_doc(uint32_t docid, int64_t tenant) {
+        _vectors.set(docid, {static_cast<float>(docid), 0.0f});
+        while (_tenant->getNumDocs() <= docid) {
+            uint32_t added = 0;
+            _tenant->addDoc(added);
+        }
+        dynamic_cast<IntegerAttribute&>(*_tenant).update(docid, tenant);
+        _tenant->commit();
+    }
+    // Even documents have tenant 10, odd documents have tenant 11
+    void add_doc(uint32_t docid) {
+        set_doc(docid, 10 + (docid % 2));
+        _index->add_document(docid);
+        commit();
+    }
+    void add_doc_two_phase(uint32_t docid) {
+        set_doc(docid, 10 + (docid % 2));
+        auto prepared = _index->prepare_add_document(docid, _vectors.get_vectors(docid),
+                                                     _index->make_generation_read_guard());
+        _index->complete_add_document(docid, std::move(prepared));
+        commit();
+    }
+    // Partitions are updated when the partition attribute is committed, before the tensor attribute is committed.
+    void commit() {
+        _index->update_partitions();
+        _index->inc_generation();
+        _index->reclaim_unused_memory();
+    }
+    void set_partition_attribute(const std::vector<uint32_t>& docids,
+                                 vespalib::ThreadBundle&      thread_bundle = vespalib::ThreadBundle::trivial()) {
+        _index->set_partition_attribute(_tenant, docids, thread_bundle);
+        commit();
+    }
+    static std::vector<uint32_t> to_docids(const std::vector<NearestNeighborIndex::Neighbor>& hits) {
+        std::vector<uint32_t> result;
+        for (const auto& hit : hits) {
+            result.push_back(hit.docid);
+        }
+        return result;
+    }
+    std::vector<uint32_t> top_3(const NearestNeighborIndex& index) {
+        std::vector<float>          query = {0.0f, 0.0f};
+        NearestNeighborIndex::Stats stats;
+        auto df = _index->distance_function_factory().for_query_vector(TypedCells(std::span<const float>(query)));
+        return to_docids(index.find_top_k(stats, 3, *df, 100, 0.0, false, _doom.get_deadline(), 10000.0));
+    }
+    std::vector<uint32_t> top_3(int64_t tenant) {
+        auto partition = _index->get_partition(tenant);
+        return (partition != nullptr) ? top_3(*partition) : std::vector<uint32_t>{99};
+    }
+    std::vector<uint32_t> top_3_with_filter(int64_t tenant, const GlobalFilter& filter) {
+        std::vector<float>          query = {0.0f, 0.0f};
+        NearestNeighborIndex::Stats stats;
+        auto df = _index->distance_function_factory().for_query_vector(TypedCells(std::span<const float>(query)));
+        auto partition = _index->get_partition(tenant);
+        return to_docids(partition->find_top_k_with_filter(stats, 3, *df, filter, false, 0.01, 100, 0.0, false,
+                                                           _doom.get_deadline(), 10000.0));
+    }
+    const NearestNeighborIndexPartition& partition(int64_t tenant) {
+        return dynamic_cast<const NearestNeighborIndexPartition&>(*_index->get_partition(tenant));
+    }
+};
+
+PartitionedNearestNeighborIndexTest::~PartitionedNearestNeighborIndexTest() = default;
+
+TEST_F(PartitionedNearestNeighborIndexTest, factory_creates_partitioned_index_when_partition_attribute_is_configured) {
+    EXPECT_NE(nullptr, dynamic_cast<PartitionedNearestNeighborIndex*>(_index.get()));
+    EXPECT_EQ("tenant", _index->partition_attribute());
+}
+
+TEST_F(PartitionedNearestNeighborIndexTest, partitions_are_built_when_partition_attribute_is_set) {
+    for (uint32_t docid = 1; docid <= 10; ++docid) {
+        add_doc(docid);
+    }
+    EXPECT_EQ(nullptr, _index->get_partition(10));
+    EXPECT_EQ((std::vector<uint32_t>{1, 2, 3}), top_3(*_index));
+    set_partition_attribute({1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+    EXPECT_EQ(2u, dynamic_cast<PartitionedNearestNeighborIndex&>(*_index).num_partitions());
+    EXPECT_EQ((std::vector<uint32_t>{2, 4, 6}), top_3(10));
+    EXPECT_EQ((std::vector<uint32_t>{1, 3, 5}), top_3(11));
+    EXPECT_EQ((std::vector<uint32_t>{1, 2, 3}), top_3(*_index));
+}
+
+TEST_F(PartitionedNearestNeighborIndexTest, unknown_partition_is_empty) {
+    add_doc(1);
+    set_partition_attribute({1});
+    EXPECT_EQ(std::vector<uint32_t>(), top_3(12));
+}
+
+TEST_F(PartitionedNearestNeighborIndexTest, documents_are_added_to_and_removed_from_partitions) {
+    set_partition_attribute({});
+    for (uint32_t docid = 1; docid <= 6; ++docid) {
+        add_doc_two_phase(docid);
+    }
+    EXPECT_EQ((std::vector<uint32_t>{2, 4, 6}), top_3(10));
+    EXPECT_EQ((std::vector<uint32_t>{1, 3, 5}), top_3(11));
+    _index->remove_document(1);
+    commit();
+    EXPECT_EQ((std::vector<uint32_t>{3, 5}), top_3(11));
+    EXPECT_EQ((std::vector<uint32_t>{2, 3, 4}), top_3(*_index));
+}
+
+TEST_F(PartitionedNearestNeighborIndexTest, changed_partition_is_used_when_document_is_added_again) {
+    for (uint32_t docid = 1; docid <= 4; ++docid) {
+        add_doc(docid);
+    }
+    set_partition_attribute({1, 2, 3, 4});
+    _index->remove_document(3);
+    set_doc(3, 10);
+    _index->add_document(3);
+    commit();
+    EXPECT_EQ((std::vector<uint32_t>{2, 3, 4}), top_3(10));
+    EXPECT_EQ((std::vector<uint32_t>{1}), top_3(11));
+}
+
+TEST_F(PartitionedNearestNeighborIndexTest, document_is_moved_to_new_partition_when_partition_attribute_changes) {
+    for (uint32_t docid = 1; docid <= 4; ++docid) {
+        add_doc(docid);
+    }
+    set_partition_attribute({1, 2, 3, 4});
+    // Partial update of the partition attribute, the tensor is not changed
+    set_doc(3, 10);
+    _index->partition_attribute_changed(3);
+    commit();
+    EXPECT_EQ((std::vector<uint32_t>{2, 3, 4}), top_3(10));
+    EXPECT_EQ((std::vector<uint32_t>{1}), top_3(11));
+    EXPECT_EQ(3u, partition(10).size());
+    EXPECT_EQ(1u, partition(11).size());
+}
+
+TEST_F(PartitionedNearestNeighborIndexTest, partitions_use_compact_local_ids) {
+    for (uint32_t docid = 1; docid <= 100; ++docid) {
+        add_doc(docid);
+    }
+    set_partition_attribute({});
+    set_doc(1000, 12);
+    _index->add_document(1000);
+    set_doc(1001, 12);
+    _index->add_document(1001);
+    commit();
+    EXPECT_EQ(2u, partition(12).size());
+    EXPECT_EQ(3u, partition(12).get_local_id_limit());
+    EXPECT_EQ((std::vector<uint32_t>{1000, 1001}), top_3(12));
+    // Freed local ids are reused after a hold cycle
+    _index->remove_document(1000);
+    commit();
+    EXPECT_EQ(1u, _index->get_partition(12)->get_partition_num_docs());
+    set_doc(1002, 12);
+    _index->add_document(1002);
+    commit();
+    EXPECT_EQ(3u, partition(12).get_local_id_limit());
+    EXPECT_EQ((std::vector<uint32_t>{1001, 1002}), top_3(12));
+}
+
+TEST_F(PartitionedNearestNeighborIndexTest, global_filter_is_mapped_to_local_ids_in_partition) {
+    for (uint32_t docid = 1; docid <= 10; ++docid) {
+        add_doc(docid);
+    }
+    set_partition_attribute({1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+    auto filter = GlobalFilter::create(std::vector<uint32_t>{3, 4, 8, 10}, 11);
+    EXPECT_EQ((std::vector<uint32_t>{4, 8, 10}), top_3_with_filter(10, *filter));
+    EXPECT_EQ((std::vector<uint32_t>{3}), top_3_with_filter(11, *filter));
+}
+
+TEST_F(PartitionedNearestNeighborIndexTest, partitions_are_built_in_parallel_using_thread_bundle) {
+    std::vector<uint32_t> docids;
+    for (uint32_t docid = 1; docid <= 40; ++docid) {
+        set_doc(docid, 10 + (docid % 8));
+        _index->add_document(docid);
+        docids.push_back(docid);
+    }
+    commit();
+    vespalib::SimpleThreadBundle thread_bundle(4);
+    set_partition_attribute(docids, thread_bundle);
+    EXPECT_EQ(8u, dynamic_cast<PartitionedNearestNeighborIndex&>(*_index).num_partitions());
+    for (int64_t tenant = 10; tenant < 18; ++tenant) {
+        EXPECT_EQ(5u, partition(tenant).size());
+        EXPECT_EQ(6u, partition(tenant).get_local_id_limit());
+    }
+    EXPECT_EQ((std::vector<uint32_t>{8, 16, 24}), top_3(10));
+    EXPECT_EQ((std::vector<uint32_t>{1, 9, 17}), top_3(11));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
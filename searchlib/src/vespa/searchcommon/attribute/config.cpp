@@ -34,6 +34,8 @@ Config::Config(BasicType bt, CollectionType ct, bool fastSearch_) noexcept
       _match(Match::UNCASED),
       _dictionary(),
       _maxUnCommittedMemory(MAX_UNCOMMITTED_MEMORY),
+      _range_buckets(0),
+      _max_delta_flushes(0),
       _growStrategy(),
       _compactionStrategy(),
       _predicateParams(),
@@ -51,7 +53,8 @@ Config::~Config() = default;
 bool Config::operator==(const Config& b) const noexcept {
     return _basicType == b._basicType && _type == b._type && _fastSearch == b._fastSearch &&
            _isFilter == b._isFilter && _fastAccess == b._fastAccess && _mutable == b._mutable && _paged == b._paged &&
-           _maxUnCommittedMemory == b._maxUnCommittedMemory && _match == b._match && _dictionary == b._dictionary &&
+           _maxUnCommittedMemory == b._maxUnCommittedMemory && _range_buckets == b._range_buckets &&
+           _max_delta_flushes == b._max_delta_flushes && _match == b._match && _dictionary == b._dictionary &&
            _growStrategy == b._growStrategy && _compactionStrategy == b._compactionStrategy &&
            _predicateParams == b._predicateParams &&
            (_basicType.type() != BasicType::Type::TENSOR ||
@@ -67,6 +67,18 @@ public:
      */
     bool fastAccess() const noexcept { return _fastAccess; }
 
+    /**
+     * Number of value range buckets kept as bitvectors to speed up range
+     * search in a single value numeric fast-search attribute. 0 disables.
+     */
+    uint32_t range_buckets() const noexcept { return _range_buckets; }
+
+    /**
+     * Max number of delta flushes between two full flushes of a single
+     * value numeric attribute without fast-search. 0 disables.
+     */
+    uint32_t max_delta_flushes() const noexcept { return _max_delta_flushes; }
+
     const GrowStrategy& getGrowStrategy() const { return _growStrategy; }
     const CompactionStrategy& getCompactionStrategy() const { return _compactionStrategy; }
     const DictionaryConfig& get_dictionary_config() const { return _dictionary; }
@@ -115,6 +127,14 @@ public:
         _fastAccess = v;
         return *this;
     }
+    Config& set_range_buckets(uint32_t value) {
+        _range_buckets = value;
+        return *this;
+    }
+    Config& set_max_delta_flushes(uint32_t value) {
+        _max_delta_flushes = value;
+        return *this;
+    }
     Config& setGrowStrategy(const GrowStrategy& gs) {
         _growStrategy = gs;
         return *this;
@@ -153,6 +173,8 @@ private:
     Match                              _match;
     DictionaryConfig                   _dictionary;
     uint64_t                           _maxUnCommittedMemory;
+    uint32_t                           _range_buckets;
+    uint32_t                           _max_delta_flushes;
     GrowStrategy                       _growStrategy;
     CompactionStrategy                 _compactionStrategy;
     PredicateParams                    _predicateParams;
@@ -4,6 +4,8 @@
 
 #include "distance_metric.h"
 
+#include <string>
+
 namespace search::attribute {
 
 /**
@@ -17,24 +19,37 @@ private:
     // This is always the same as in the attribute config, and is duplicated here to simplify usage.
     DistanceMetric _distance_metric;
     bool           _multi_threaded_indexing;
+    // Number of bits (1-4) per cell in quantized vector codes used for graph traversal during search.
+    // 0 means that traversal uses the full precision vectors in the tensor attribute.
+    uint8_t _traversal_quantization_bits;
+    // Name of an integer attribute used to partition the index in one graph per distinct value.
+    // Empty means that the index is not partitioned.
+    std::string _partition_attribute;
 
 public:
     HnswIndexParams(uint32_t max_links_per_node_in, uint32_t neighbors_to_explore_at_insert_in,
-                    DistanceMetric distance_metric_in, bool multi_threaded_indexing_in = false) noexcept
+                    DistanceMetric distance_metric_in, bool multi_threaded_indexing_in = false,
+                    uint8_t traversal_quantization_bits_in = 0, std::string partition_attribute_in = "") noexcept
         : _max_links_per_node(max_links_per_node_in),
           _neighbors_to_explore_at_insert(neighbors_to_explore_at_insert_in),
           _distance_metric(distance_metric_in),
-          _multi_threaded_indexing(multi_threaded_indexing_in) {}
+          _multi_threaded_indexing(multi_threaded_indexing_in),
+          _traversal_quantization_bits(traversal_quantization_bits_in),
+          _partition_attribute(std::move(partition_attribute_in)) {}
 
     uint32_t max_links_per_node() const { return _max_links_per_node; }
     uint32_t neighbors_to_explore_at_insert() const { return _neighbors_to_explore_at_insert; }
     DistanceMetric distance_metric() const { return _distance_metric; }
     bool multi_threaded_indexing() const { return _multi_threaded_indexing; }
+    uint8_t traversal_quantization_bits() const { return _traversal_quantization_bits; }
+    const std::string& partition_attribute() const { return _partition_attribute; }
 
     bool operator==(const HnswIndexParams& rhs) const {
         return (_max_links_per_node == rhs._max_links_per_node &&
                 _neighbors_to_explore_at_insert == rhs._neighbors_to_explore_at_insert &&
-                _distance_metric == rhs._distance_metric && _multi_threaded_indexing == rhs._multi_threaded_indexing);
+                _distance_metric == rhs._distance_metric && _multi_threaded_indexing == rhs._multi_threaded_indexing &&
+                _traversal_quantization_bits == rhs._traversal_quantization_bits &&
+                _partition_attribute == rhs._partition_attribute);
     }
 };
 
@@ -8,7 +8,11 @@
 namespace search {
 
 std::ostream& operator<<(std::ostream& os, const DictionaryConfig& cfg) {
-    return os << cfg.getType() << "," << cfg.getMatch();
+    os << cfg.getType() << "," << cfg.getMatch();
+    if (cfg.get_trigram_index()) {
+        os << ",TRIGRAM_INDEX";
+    }
+    return os;
 }
 
 std::ostream& operator<<(std::ostream& os, DictionaryConfig::Type type) {
@@ -14,16 +14,23 @@ class DictionaryConfig {
 public:
     enum class Type : uint8_t { BTREE, HASH, BTREE_AND_HASH };
     enum class Match : uint8_t { CASED, UNCASED };
-    DictionaryConfig() noexcept : _type(Type::BTREE), _match(Match::UNCASED) {}
-    DictionaryConfig(Type type) noexcept : _type(type), _match(Match::UNCASED) {}
-    DictionaryConfig(Type type, Match match) noexcept : _type(type), _match(match) {}
+    DictionaryConfig() noexcept : _type(Type::BTREE), _match(Match::UNCASED), _trigram_index(false) {}
+    DictionaryConfig(Type type) noexcept : _type(type), _match(Match::UNCASED), _trigram_index(false) {}
+    DictionaryConfig(Type type, Match match) noexcept : _type(type), _match(match), _trigram_index(false) {}
+    DictionaryConfig(Type type, Match match, bool trigram_index) noexcept
+        : _type(type), _match(match), _trigram_index(trigram_index) {}
     Type getType() const { return _type; }
     Match getMatch() const { return _match; }
-    bool operator==(const DictionaryConfig& b) const { return (_type == b._type) && (_match == b._match); }
+    // Whether a trigram index over the dictionary values is used for regex and fuzzy search on strings
+    bool get_trigram_index() const { return _trigram_index; }
+    bool operator==(const DictionaryConfig& b) const {
+        return (_type == b._type) && (_match == b._match) && (_trigram_index == b._trigram_index);
+    }
 
 private:
     Type  _type : 4;
     Match _match : 4;
+    bool  _trigram_index;
 };
 
 std::ostream& operator<<(std::ostream& os, const DictionaryConfig& cfg);
@@ -98,17 +98,21 @@ bool Schema::Field::operator!=(const Field& rhs) const noexcept {
 }
 
 Schema::IndexField::IndexField(std::string_view name, DataType dt) noexcept
-    : Field(name, dt), _avgElemLen(512), _interleaved_features(false) {
+    : Field(name, dt), _avgElemLen(512), _interleaved_features(false), _packed_doc_ids(false),
+      _block_max_features(false) {
 }
 
 Schema::IndexField::IndexField(std::string_view name, DataType dt, CollectionType ct) noexcept
-    : Field(name, dt, ct), _avgElemLen(512), _interleaved_features(false) {
+    : Field(name, dt, ct), _avgElemLen(512), _interleaved_features(false), _packed_doc_ids(false),
+      _block_max_features(false) {
 }
 
 Schema::IndexField::IndexField(const config::StringVector& lines)
     : Field(lines),
       _avgElemLen(ConfigParser::parse<int32_t>("averageelementlen", lines, 512)),
-      _interleaved_features(ConfigParser::parse<bool>("interleavedfeatures", lines, false)) {
+      _interleaved_features(ConfigParser::parse<bool>("interleavedfeatures", lines, false)),
+      _packed_doc_ids(ConfigParser::parse<bool>("packeddocids", lines, false)),
+      _block_max_features(ConfigParser::parse<bool>("blockmaxfeatures", lines, false)) {
 }
 
 Schema::IndexField::IndexField(const IndexField&) noexcept = default;
@@ -120,6 +124,8 @@ void Schema::IndexField::write(vespalib::asciistream& os, std::string_view prefi
     Field::write(os, prefix);
     os << prefix << "averageelementlen " << static_cast<int32_t>(_avgElemLen) << "\n";
     os << prefix << "interleavedfeatures " << (_interleaved_features ? "true" : "false") << "\n";
+    os << prefix << "packeddocids " << (_packed_doc_ids ? "true" : "false") << "\n";
+    os << prefix << "blockmaxfeatures " << (_block_max_features ? "true" : "false") << "\n";
 
     // TODO: Remove prefix, phrases and positions when breaking downgrade is no longer an issue.
     os << prefix << "prefix false" << "\n";
@@ -129,12 +135,14 @@ void Schema::IndexField::write(vespalib::asciistream& os, std::string_view prefi
 
 bool Schema::IndexField::operator==(const IndexField& rhs) const noexcept {
     return Field::operator==(rhs) && _avgElemLen == rhs._avgElemLen &&
-           _interleaved_features == rhs._interleaved_features;
+           _interleaved_features == rhs._interleaved_features && _packed_doc_ids == rhs._packed_doc_ids &&
+           _block_max_features == rhs._block_max_features;
 }
 
 bool Schema::IndexField::operator!=(const IndexField& rhs) const noexcept {
     return Field::operator!=(rhs) || _avgElemLen != rhs._avgElemLen ||
-           _interleaved_features != rhs._interleaved_features;
+           _interleaved_features != rhs._interleaved_features || _packed_doc_ids != rhs._packed_doc_ids ||
+           _block_max_features != rhs._block_max_features;
 }
 
 Schema::FieldSet::FieldSet(const config::StringVector& lines)
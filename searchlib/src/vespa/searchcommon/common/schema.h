@@ -73,6 +73,8 @@ public:
     private:
         uint32_t _avgElemLen;
         bool     _interleaved_features;
+        bool     _packed_doc_ids;
+        bool     _block_max_features;
 
     public:
         IndexField(std::string_view name, DataType dt) noexcept;
@@ -94,11 +96,21 @@ public:
             _interleaved_features = value;
             return *this;
         }
+        IndexField& set_packed_doc_ids(bool value) noexcept {
+            _packed_doc_ids = value;
+            return *this;
+        }
+        IndexField& set_block_max_features(bool value) noexcept {
+            _block_max_features = value;
+            return *this;
+        }
 
         void write(vespalib::asciistream& os, std::string_view prefix) const override;
 
         uint32_t getAvgElemLen() const noexcept { return _avgElemLen; }
         bool use_interleaved_features() const noexcept { return _interleaved_features; }
+        bool use_packed_doc_ids() const noexcept { return _packed_doc_ids; }
+        bool use_block_max_features() const noexcept { return _block_max_features; }
 
         bool operator==(const IndexField& rhs) const noexcept;
         bool operator!=(const IndexField& rhs) const noexcept;
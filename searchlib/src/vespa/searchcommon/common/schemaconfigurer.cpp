@@ -102,7 +102,9 @@ void SchemaBuilder::build(const IndexschemaConfig& cfg, Schema& schema) {
         schema.addIndexField(
             Schema::IndexField(f.name, convertIndexDataType(f.datatype), convertIndexCollectionType(f.collectiontype))
                 .setAvgElemLen(f.averageelementlen)
-                .set_interleaved_features(f.interleavedfeatures));
+                .set_interleaved_features(f.interleavedfeatures)
+                .set_packed_doc_ids(f.packeddocids)
+                .set_block_max_features(f.blockmaxfeatures));
     }
     for (size_t i = 0; i < cfg.fieldset.size(); ++i) {
         const IndexschemaConfig::Fieldset& fs = cfg.fieldset[i];
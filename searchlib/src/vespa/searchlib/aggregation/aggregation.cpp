@@ -232,6 +232,9 @@ void MinAggregationResult::onReset() {
 
 AverageAggregationResult::AverageAggregationResult() : AggregationResult(), _sum(FloatResultNode(0.0)), _count(0) {
 }
+AverageAggregationResult::AverageAggregationResult(NumericResultNode::UP sum, uint64_t count)
+    : AggregationResult(), _sum(sum.release()), _count(count) {
+}
 AverageAggregationResult::~AverageAggregationResult() = default;
 
 void AverageAggregationResult::onMerge(const AggregationResult& b) {
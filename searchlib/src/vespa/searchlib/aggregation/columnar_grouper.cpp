@@ -0,0 +1,291 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "columnar_grouper.h"
+
+#include "aggregation.h"
+#include "grouping.h"
+
+#include <vespa/searchcommon/attribute/iattributevector.h>
+#include <vespa/searchlib/expression/attributenode.h>
+#include <vespa/searchlib/expression/floatresultnode.h>
+#include <vespa/searchlib/expression/integerresultnode.h>
+
+#include <vespa/vespalib/stllike/hash_map.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+using search::attribute::IAttributeVector;
+using search::expression::AttributeNode;
+using search::expression::ExpressionNode;
+using search::expression::FloatResultNode;
+using search::expression::Int64ResultNode;
+using search::expression::NumericResultNode;
+using search::expression::ResultNode;
+using search::expression::SingleResultNode;
+
+namespace search::aggregation {
+
+namespace {
+
+// The attribute of a plain (single value) attribute expression, nullptr otherwise
+const IAttributeVector* single_value_attribute(const ExpressionNode* node) {
+    if ((node == nullptr) || (node->getClass().id() != AttributeNode::classId)) {
+        return nullptr;
+    }
+    const auto& attr_node = static_cast<const AttributeNode&>(*node);
+    const auto* attr = attr_node.getAttribute();
+    if ((attr == nullptr) || attr_node.hasMultiValue() || attr->hasMultiValue()) {
+        return nullptr;
+    }
+    return attr;
+}
+
+const IAttributeVector* numeric_attribute(const ExpressionNode* node) {
+    const auto* attr = single_value_attribute(node);
+    return ((attr != nullptr) && (attr->isIntegerType() || attr->isFloatingPointType())) ? attr : nullptr;
+}
+
+template <typename NodeType> std::unique_ptr<NodeType> make_node(const NodeType& type, const ResultNode& value) {
+    std::unique_ptr<NodeType> node(static_cast<NodeType*>(type.getClass().create()));
+    node->set(value);
+    return node;
+}
+
+} // namespace
+
+ColumnarGrouper::Column::Column(Kind kind, const IAttributeVector* attr, bool is_float) noexcept
+    : _kind(kind), _attr(attr), _is_float(is_float), _ints(), _floats(), _counts() {
+}
+
+ColumnarGrouper::Column::Column(Column&&) noexcept = default;
+ColumnarGrouper::Column::~Column() = default;
+
+void ColumnarGrouper::Column::add_slot() {
+    switch (_kind) {
+    case Kind::COUNT:
+        _counts.push_back(0);
+        break;
+    case Kind::SUM:
+        if (_is_float) {
+            _floats.push_back(0.0);
+        } else {
+            _ints.push_back(0);
+        }
+        break;
+    case Kind::MIN:
+        if (_is_float) {
+            _floats.push_back(std::numeric_limits<double>::max());
+        } else {
+            _ints.push_back(std::numeric_limits<int64_t>::max());
+        }
+        break;
+    case Kind::MAX:
+        if (_is_float) {
+            _floats.push_back(-std::numeric_limits<double>::max());
+        } else {
+            _ints.push_back(std::numeric_limits<int64_t>::min());
+        }
+        break;
+    case Kind::AVERAGE:
+        _floats.push_back(0.0);
+        _counts.push_back(0);
+        break;
+    }
+}
+
+void ColumnarGrouper::Column::aggregate(uint32_t slot, DocId docid) {
+    // Comparisons and summation order are the same as for the result nodes used by the general path
+    switch (_kind) {
+    case Kind::COUNT:
+        ++_counts[slot];
+        break;
+    case Kind::SUM:
+        if (_is_float) {
+            _floats[slot] += _attr->getFloat(docid);
+        } else {
+            _ints[slot] = static_cast<int64_t>(static_cast<uint64_t>(_ints[slot]) +
+                                               static_cast<uint64_t>(_attr->getInt(docid)));
+        }
+        break;
+    case Kind::MIN:
+        if (_is_float) {
+            double value = _attr->getFloat(docid);
+            if (value < _floats[slot]) {
+                _floats[slot] = value;
+            }
+        } else {
+            _ints[slot] = std::min(_ints[slot], static_cast<int64_t>(_attr->getInt(docid)));
+        }
+        break;
+    case Kind::MAX:
+        if (_is_float) {
+            double value = _attr->getFloat(docid);
+            if (value > _floats[slot]) {
+                _floats[slot] = value;
+            }
+        } else {
+            _ints[slot] = std::max(_ints[slot], static_cast<int64_t>(_attr->getInt(docid)));
+        }
+        break;
+    case Kind::AVERAGE:
+        _floats[slot] += _is_float ? _attr->getFloat(docid) : static_cast<double>(_attr->getInt(docid));
+        ++_counts[slot];
+        break;
+    }
+}
+
+void ColumnarGrouper::Column::merge_into(uint32_t slot, AggregationResult& result) const {
+    if (_kind == Kind::COUNT) {
+        result.merge(CountAggregationResult(_counts[slot]));
+        return;
+    }
+    if (_kind == Kind::AVERAGE) {
+        result.merge(AverageAggregationResult(std::make_unique<FloatResultNode>(_floats[slot]), _counts[slot]));
+        return;
+    }
+    std::unique_ptr<ResultNode> value;
+    if (_is_float) {
+        value = std::make_unique<FloatResultNode>(_floats[slot]);
+    } else {
+        value = std::make_unique<Int64ResultNode>(_ints[slot]);
+    }
+    if (_kind == Kind::SUM) {
+        result.merge(SumAggregationResult(make_node(static_cast<SumAggregationResult&>(result).getSum(), *value)));
+    } else if (_kind == Kind::MIN) {
+        result.merge(MinAggregationResult(*make_node(static_cast<MinAggregationResult&>(result).getMin(), *value)));
+    } else {
+        result.merge(MaxAggregationResult(*make_node(static_cast<MaxAggregationResult&>(result).getMax(), *value)));
+    }
+}
+
+ColumnarGrouper::Columns::Columns() noexcept : _columns() {
+}
+
+ColumnarGrouper::Columns::~Columns() = default;
+
+bool ColumnarGrouper::Columns::init(const Group& group) {
+    for (size_t i = 0; i < group.getAggrSize(); ++i) {
+        const AggregationResult& aggr = group.getAggregationResult(i);
+        const ExpressionNode*    expr = aggr.getExpression();
+        uint32_t                 class_id = aggr.getClass().id();
+        if (class_id == CountAggregationResult::classId) {
+            if ((expr != nullptr) && ((expr->getResult() == nullptr) || expr->getResult()->isMultiValue())) {
+                return false;
+            }
+            _columns.emplace_back(Kind::COUNT, nullptr, false);
+            continue;
+        }
+        const IAttributeVector* attr = numeric_attribute(expr);
+        if (attr == nullptr) {
+            return false;
+        }
+        bool is_float = attr->isFloatingPointType();
+        if (class_id == SumAggregationResult::classId) {
+            _columns.emplace_back(Kind::SUM, attr, is_float);
+        } else if (class_id == MinAggregationResult::classId) {
+            _columns.emplace_back(Kind::MIN, attr, is_float);
+        } else if (class_id == MaxAggregationResult::classId) {
+            _columns.emplace_back(Kind::MAX, attr, is_float);
+        } else if (class_id == AverageAggregationResult::classId) {
+            _columns.emplace_back(Kind::AVERAGE, attr, is_float);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ColumnarGrouper::Columns::add_slot() {
+    for (auto& column : _columns) {
+        column.add_slot();
+    }
+}
+
+void ColumnarGrouper::Columns::merge_into(uint32_t slot, Group& group) const {
+    for (size_t i = 0; i < _columns.size(); ++i) {
+        _columns[i].merge_into(slot, group.getAggregationResult(i));
+    }
+}
+
+ColumnarGrouper::ColumnarGrouper(Grouping& grouping, const IAttributeVector& key_attr)
+    : _grouping(grouping),
+      _key_attr(key_attr),
+      _key_is_enum(key_attr.hasEnum()),
+      _slot_of(),
+      _first_doc(),
+      _rank(),
+      _root_columns(),
+      _group_columns() {
+}
+
+ColumnarGrouper::~ColumnarGrouper() = default;
+
+std::unique_ptr<ColumnarGrouper> ColumnarGrouper::try_create(Grouping& grouping) {
+    if ((grouping.getLevels().size() != 1) || (grouping.getFirstLevel() != 0) || (grouping.getLastLevel() != 1) ||
+        (grouping.getRoot().getChildrenSize() != 0))
+    {
+        return {};
+    }
+    const GroupingLevel& level = grouping.getLevels()[0];
+    if (level.isFrozen() || level.hasFilter()) {
+        return {};
+    }
+    const IAttributeVector* key_attr = single_value_attribute(level.getExpression().getRoot());
+    if ((key_attr == nullptr) || !(key_attr->hasEnum() || key_attr->isIntegerType())) {
+        return {};
+    }
+    std::unique_ptr<ColumnarGrouper> result(new ColumnarGrouper(grouping, *key_attr));
+    if (!result->_root_columns.init(grouping.getRoot()) || !result->_group_columns.init(level.getGroupPrototype())) {
+        return {};
+    }
+    result->_root_columns.add_slot();
+    return result;
+}
+
+int64_t ColumnarGrouper::key(DocId docid) const {
+    return _key_is_enum ? static_cast<int64_t>(_key_attr.getEnum(docid)) : _key_attr.getInt(docid);
+}
+
+uint32_t ColumnarGrouper::slot(DocId docid, HitRank rank) {
+    int64_t group_key = key(docid);
+    auto    found = _slot_of.find(group_key);
+    if (found != _slot_of.end()) {
+        _rank[found->second] = std::max(_rank[found->second], rank);
+        return found->second;
+    }
+    if (!_grouping.getLevels()[0].allowMoreGroups(_first_doc.size())) {
+        return NO_SLOT;
+    }
+    uint32_t new_slot = _first_doc.size();
+    _slot_of[group_key] = new_slot;
+    _first_doc.push_back(docid);
+    _rank.push_back(std::isnan(rank) ? -HUGE_VAL : rank);
+    _group_columns.add_slot();
+    return new_slot;
+}
+
+void ColumnarGrouper::aggregate(DocId docid, HitRank rank) {
+    _root_columns.aggregate(0, docid);
+    uint32_t group_slot = slot(docid, rank);
+    if (group_slot != NO_SLOT) {
+        _group_columns.aggregate(group_slot, docid);
+    }
+}
+
+void ColumnarGrouper::finish() {
+    Group&               root = _grouping.root();
+    const GroupingLevel& level = _grouping.getLevels()[0];
+    const auto&          selector = level.getExpression();
+    _root_columns.merge_into(0, root);
+    for (uint32_t i = 0; i < _first_doc.size(); ++i) {
+        // The group id is the result of the (general) grouping expression for the first hit in the group
+        selector.execute(_first_doc[i], _rank[i]);
+        Group* group = root.groupSingle(*selector.getResult(), _rank[i], level);
+        assert(group != nullptr);
+        _group_columns.merge_into(i, *group);
+    }
+}
+
+} // namespace search::aggregation
@@ -0,0 +1,111 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/searchlib/common/hitrank.h>
+#include <vespa/searchlib/expression/expressionnode.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+
+#include <memory>
+#include <vector>
+
+namespace search::attribute {
+class IAttributeVector;
+}
+
+namespace search::aggregation {
+
+class AggregationResult;
+class Group;
+class Grouping;
+
+/**
+ * Fast path for the most common grouping request shape: a single
+ * level grouping on a single value attribute, with count, sum, min,
+ * max and average of single value numeric attributes as outputs (in
+ * the groups and in the root).
+ *
+ * Instead of evaluating expression trees and looking up the group by
+ * its result node for each hit, the group is found by the enum handle
+ * (or integer value) of the attribute, and the outputs are accumulated
+ * in flat arrays indexed by group. The groups are materialized into
+ * the group tree (with the same ids, ranks and results as the general
+ * path would give) when all hits have been aggregated.
+ **/
+class ColumnarGrouper {
+private:
+    using IAttributeVector = attribute::IAttributeVector;
+    using DocId = expression::DocId;
+
+    enum class Kind { COUNT, SUM, MIN, MAX, AVERAGE };
+
+    class Column {
+    private:
+        Kind                    _kind;
+        const IAttributeVector* _attr;
+        bool                    _is_float;
+        std::vector<int64_t>    _ints;
+        std::vector<double>     _floats;
+        std::vector<uint64_t>   _counts;
+
+    public:
+        Column(Kind kind, const IAttributeVector* attr, bool is_float) noexcept;
+        Column(Column&&) noexcept;
+        ~Column();
+        void add_slot();
+        void aggregate(uint32_t slot, DocId docid);
+        void merge_into(uint32_t slot, AggregationResult& result) const;
+    };
+
+    class Columns {
+    private:
+        std::vector<Column> _columns;
+
+    public:
+        Columns() noexcept;
+        ~Columns();
+        bool init(const Group& group);
+        void add_slot();
+        void aggregate(uint32_t slot, DocId docid) {
+            for (auto& column : _columns) {
+                column.aggregate(slot, docid);
+            }
+        }
+        void merge_into(uint32_t slot, Group& group) const;
+    };
+
+    Grouping&                             _grouping;
+    const IAttributeVector&               _key_attr;
+    bool                                  _key_is_enum;
+    vespalib::hash_map<int64_t, uint32_t> _slot_of;
+    std::vector<DocId>                    _first_doc;
+    std::vector<HitRank>                  _rank;
+    Columns                               _root_columns;
+    Columns                               _group_columns;
+
+    ColumnarGrouper(Grouping& grouping, const IAttributeVector& key_attr);
+    int64_t key(DocId docid) const;
+    uint32_t slot(DocId docid, HitRank rank);
+
+public:
+    static constexpr uint32_t NO_SLOT = -1;
+
+    ColumnarGrouper(const ColumnarGrouper&) = delete;
+    ColumnarGrouper& operator=(const ColumnarGrouper&) = delete;
+    ~ColumnarGrouper();
+
+    /**
+     * Create a columnar grouper for the given grouping if it has a
+     * supported shape. Must be called after preAggregate.
+     **/
+    static std::unique_ptr<ColumnarGrouper> try_create(Grouping& grouping);
+
+    void aggregate(DocId docid, HitRank rank);
+
+    /**
+     * Move the aggregated results into the group tree. Must be called
+     * before postProcess.
+     **/
+    void finish();
+};
+
+} // namespace search::aggregation
@@ -2,6 +2,7 @@
 
 #include "grouping.h"
 
+#include "columnar_grouper.h"
 #include "hitsaggregationresult.h"
 
 #include <vespa/searchlib/attribute/stringbase.h>
@@ -241,8 +242,16 @@ void Grouping::aggregate(const RankedHit* rankedHit, unsigned int len) {
     preAggregate(isOrdered);
     HitsAggregationResult::SetOrdered pred;
     select(pred, pred);
+    auto columnar = ColumnarGrouper::try_create(*this);
     for (unsigned int i(0), m(getMaxN(len)); i < m; i++) {
-        aggregate(rankedHit[i].getDocId(), rankedHit[i].getRank());
+        if (columnar) {
+            columnar->aggregate(rankedHit[i].getDocId(), rankedHit[i].getRank());
+        } else {
+            aggregate(rankedHit[i].getDocId(), rankedHit[i].getRank());
+        }
+    }
+    if (columnar) {
+        columnar->finish();
     }
     postProcess();
 }
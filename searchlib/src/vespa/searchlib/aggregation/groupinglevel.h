@@ -147,6 +147,7 @@ public:
     int64_t getMaxGroups() const noexcept { return _maxGroups; }
     int64_t getPrecision() const noexcept { return _precision; }
     bool isFrozen() const noexcept { return _frozen; }
+    bool hasFilter() const noexcept { return static_cast<bool>(_filter.get()); }
     bool allowMoreGroups(size_t sz) const noexcept {
         return (!_frozen && (!_isOrdered || (sz < (uint64_t)_precision)));
     }
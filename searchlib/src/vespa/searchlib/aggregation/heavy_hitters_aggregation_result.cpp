@@ -0,0 +1,84 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include "heavy_hitters_aggregation_result.h"
+
+#include <vespa/searchlib/expression/resultvector.h>
+
+#include <vespa/vespalib/objects/deserializer.hpp>
+#include <vespa/vespalib/objects/serializer.hpp>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+
+#include <format>
+
+namespace search::aggregation {
+
+using expression::ResultNodeVector;
+using vespalib::Deserializer;
+using vespalib::Serializer;
+
+IMPLEMENT_IDENTIFIABLE_NS2(search, aggregation, HeavyHittersAggregationResult, AggregationResult);
+
+HeavyHittersAggregationResult::HeavyHittersAggregationResult()
+    : HeavyHittersAggregationResult(default_max_entries) {
+}
+
+HeavyHittersAggregationResult::HeavyHittersAggregationResult(uint32_t max_entries)
+    : AggregationResult(), _sketch(max_entries), _rank() {
+}
+
+HeavyHittersAggregationResult::~HeavyHittersAggregationResult() = default;
+
+void HeavyHittersAggregationResult::add(const ResultNode& value) {
+    _sketch.add(value.hash(), [&value]() { return ResultNode::CP(value); });
+}
+
+void HeavyHittersAggregationResult::update_rank() {
+    _rank.set(_sketch.max_count());
+}
+
+void HeavyHittersAggregationResult::onMerge(const AggregationResult& b) {
+    _sketch.merge(static_cast<const HeavyHittersAggregationResult&>(b)._sketch);
+    update_rank();
+}
+
+void HeavyHittersAggregationResult::onAggregate(const ResultNode& result) {
+    if (result.isMultiValue()) {
+        const auto& rv = static_cast<const ResultNodeVector&>(result);
+        for (size_t i = 0; i < rv.size(); ++i) {
+            add(rv.get(i));
+        }
+    } else {
+        add(result);
+    }
+    update_rank();
+}
+
+void HeavyHittersAggregationResult::onReset() {
+    _sketch = Sketch(_sketch.capacity());
+    _rank.set(0);
+}
+
+Serializer& HeavyHittersAggregationResult::onSerialize(Serializer& os) const {
+    AggregationResult::onSerialize(os);
+    _sketch.serialize(os);
+    return os;
+}
+
+Deserializer& HeavyHittersAggregationResult::onDeserialize(Deserializer& is) {
+    AggregationResult::onDeserialize(is);
+    _sketch.deserialize(is);
+    update_rank();
+    return is;
+}
+
+void HeavyHittersAggregationResult::visitMembers(vespalib::ObjectVisitor& visitor) const {
+    AggregationResult::visitMembers(visitor);
+    visit(visitor, "maxEntries", _sketch.capacity());
+    auto top = _sketch.top(_sketch.size());
+    for (size_t i = 0; i < top.size(); ++i) {
+        visit(visitor, std::format("value[{}]", i), top[i]->value.get());
+        visit(visitor, std::format("count[{}]", i), top[i]->count);
+        visit(visitor, std::format("error[{}]", i), top[i]->error);
+    }
+}
+
+} // namespace search::aggregation
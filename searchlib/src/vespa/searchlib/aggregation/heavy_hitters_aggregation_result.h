@@ -0,0 +1,45 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "aggregationresult.h"
+
+#include <vespa/searchlib/expression/integerresultnode.h>
+#include <vespa/searchlib/grouping/spacesaving.h>
+
+namespace search::aggregation {
+
+/*
+ * Aggregator that tracks the most frequent values of an expression
+ * (heavy hitters) with bounded memory, using a Space-Saving sketch
+ * with 'max_entries' counters. This gives the top values of a high
+ * cardinality expression without building a group per value. The
+ * sketch is serialized, so partial results from content nodes are
+ * merged into an approximate global top list. The rank is the
+ * (estimated) count of the most frequent value.
+ */
+class HeavyHittersAggregationResult : public AggregationResult {
+public:
+    using Sketch = SpaceSaving<ResultNode::CP>;
+    static constexpr uint32_t default_max_entries = 100;
+
+private:
+    Sketch                      _sketch;
+    expression::Int64ResultNode _rank;
+
+    void add(const ResultNode& value);
+    void update_rank();
+    const ResultNode& onGetRank() const override { return _rank; }
+    void onPrepare(const ResultNode&) override {}
+
+public:
+    DECLARE_AGGREGATIONRESULT(HeavyHittersAggregationResult);
+    HeavyHittersAggregationResult();
+    explicit HeavyHittersAggregationResult(uint32_t max_entries);
+    ~HeavyHittersAggregationResult() override;
+
+    void visitMembers(vespalib::ObjectVisitor& visitor) const override;
+    uint32_t max_entries() const noexcept { return _sketch.capacity(); }
+    const Sketch& sketch() const noexcept { return _sketch; }
+};
+
+} // namespace search::aggregation
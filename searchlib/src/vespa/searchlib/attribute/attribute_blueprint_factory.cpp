@@ -41,6 +41,8 @@
 #include <vespa/searchlib/queryeval/weighted_set_term_blueprint.h>
 #include <vespa/searchlib/queryeval/weighted_set_term_search.h>
 #include <vespa/searchlib/tensor/dense_tensor_attribute.h>
+#include <vespa/searchlib/tensor/distance_calculator.h>
+#include <vespa/searchlib/tensor/nearest_neighbor_index.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/issue.h>
 #include <vespa/vespalib/util/regexp.h>
@@ -450,6 +452,7 @@ private:
     const IDocidWithWeightPostingStore&            _attr;
     vespalib::datastore::EntryRef                  _dictionary_snapshot;
     MatchingPhase                                  _matching_phase;
+    const queryeval::SharedScoreThreshold*         _first_phase_score_threshold;
 
 public:
     DirectWandBlueprint(const FieldSpec& field, const IDocidWithWeightPostingStore& attr, uint32_t scoresToTrack,
@@ -464,7 +467,8 @@ public:
           _terms(),
           _attr(attr),
           _dictionary_snapshot(_attr.get_dictionary_snapshot()),
-          _matching_phase(MatchingPhase::FIRST_PHASE) {
+          _matching_phase(MatchingPhase::FIRST_PHASE),
+          _first_phase_score_threshold(nullptr) {
         _weights.reserve(size_hint);
         _terms.reserve(size_hint);
     }
@@ -508,15 +512,22 @@ public:
             return std::make_unique<queryeval::EmptySearch>();
         }
         bool readonly_scores_heap = (_matching_phase != MatchingPhase::FIRST_PHASE);
+        // the shared threshold only bounds the first phase score when it is calculated from our raw score
+        const queryeval::SharedScoreThreshold* first_phase_score_threshold =
+            (readonly_scores_heap || tfmda[0]->isNotNeeded()) ? nullptr : _first_phase_score_threshold;
         return queryeval::ParallelWeakAndSearch::create(
             *tfmda[0],
             queryeval::ParallelWeakAndSearch::MatchParams(*_scores, _scoreThreshold, _thresholdBoostFactor,
-                                                          _scoresAdjustFrequency, get_docid_limit()),
+                                                          _scoresAdjustFrequency, get_docid_limit(),
+                                                          first_phase_score_threshold),
             _weights, _terms, _attr, strict(), readonly_scores_heap);
     }
     std::unique_ptr<SearchIterator> createFilterSearchImpl(FilterConstraint constraint) const override;
     bool always_needs_unpack() const override { return true; }
     void set_matching_phase(MatchingPhase matching_phase) noexcept override;
+    void set_first_phase_score_threshold(const queryeval::SharedScoreThreshold* threshold) noexcept override {
+        _first_phase_score_threshold = threshold;
+    }
 };
 
 DirectWandBlueprint::~DirectWandBlueprint() = default;
@@ -774,8 +785,18 @@ public:
                 .prefetch_tensors = hnsw_params.prefetch_tensors.value_or(params.prefetch_tensors),
                 .target_hits_max_adjustment_factor =
                     hnsw_params.target_hits_max_adjustment_factor.value_or(params.target_hits_max_adjustment_factor)};
-            setResult(std::make_unique<queryeval::NearestNeighborBlueprint>(
-                _field, std::move(calc), n.get_target_num_hits(), n.get_allow_approximate(), blueprint_hnsw_params));
+            const auto* nns_index = calc->attribute_tensor().nearest_neighbor_index();
+            auto        blueprint = std::make_unique<queryeval::NearestNeighborBlueprint>(
+                _field, std::move(calc), n.get_target_num_hits(), n.get_allow_approximate(), blueprint_hnsw_params);
+            if (nns_index != nullptr && !nns_index->partition_attribute().empty()) {
+                for (const auto& [field_name, value] : n.get_equality_filters()) {
+                    if (field_name == nns_index->partition_attribute()) {
+                        blueprint->set_partition_key(value);
+                        break;
+                    }
+                }
+            }
+            setResult(std::move(blueprint));
         } catch (const vespalib::IllegalArgumentException& ex) {
             return fail_nearest_neighbor_term(n, ex.getMessage());
         }
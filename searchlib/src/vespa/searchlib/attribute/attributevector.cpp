@@ -550,6 +550,22 @@ std::unique_ptr<AttributeSaver> AttributeVector::onInitSave(std::string_view) {
     return std::unique_ptr<AttributeSaver>();
 }
 
+std::unique_ptr<AttributeSaver> AttributeVector::init_delta_save(std::string_view fileName, uint64_t base_serial) {
+    commit(CommitParam::UpdateStats::FORCE);
+    return onInitDeltaSave(fileName, base_serial);
+}
+
+std::unique_ptr<AttributeSaver> AttributeVector::onInitDeltaSave(std::string_view, uint64_t) {
+    return {};
+}
+
+void AttributeVector::start_tracking_changes(uint64_t) {
+}
+
+std::string AttributeVector::get_delta_file_name(std::string_view baseFileName, uint32_t delta) {
+    return std::string(baseFileName) + ".delta." + std::to_string(delta);
+}
+
 bool AttributeVector::hasActiveEnumGuards() {
     std::unique_lock<std::shared_mutex> lock(_enumLock, std::defer_lock);
     for (size_t i = 0; i < 1000; ++i) {
@@ -498,6 +498,21 @@ public:
     std::unique_ptr<AttributeSaver> initSave(std::string_view fileName);
 
     virtual std::unique_ptr<AttributeSaver> onInitSave(std::string_view fileName);
+
+    /**
+     * Returns a saver for the documents changed since this attribute vector
+     * was loaded from or saved to the snapshot with the given serial number,
+     * or nullptr if a delta relative to that snapshot cannot be saved.
+     * The delta is loaded on top of the snapshot by onLoad().
+     */
+    std::unique_ptr<AttributeSaver> init_delta_save(std::string_view fileName, uint64_t base_serial);
+    virtual std::unique_ptr<AttributeSaver> onInitDeltaSave(std::string_view fileName, uint64_t base_serial);
+
+    // Start tracking changed documents relative to the snapshot with the given serial number
+    virtual void start_tracking_changes(uint64_t base_serial);
+
+    // Base file name of delta number 1, 2, ... saved on top of the attribute vector with the given base file name
+    static std::string get_delta_file_name(std::string_view baseFileName, uint32_t delta);
     virtual uint64_t getEstimatedSaveByteSize() const;
     [[nodiscard]] virtual size_t reserved_memory_for_flush(bool slow_disk) const noexcept;
 
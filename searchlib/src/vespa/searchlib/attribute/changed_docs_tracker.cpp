@@ -0,0 +1,59 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "changed_docs_tracker.h"
+
+#include <algorithm>
+
+namespace search::attribute {
+
+namespace {
+
+constexpr size_t min_compact_limit = 4096;
+
+}
+
+ChangedDocsTracker::ChangedDocsTracker() noexcept
+    : _docs(), _base_serial(), _max_docs(0), _compact_limit(min_compact_limit) {
+}
+
+ChangedDocsTracker::~ChangedDocsTracker() = default;
+
+void ChangedDocsTracker::compact() {
+    std::sort(_docs.begin(), _docs.end());
+    _docs.erase(std::unique(_docs.begin(), _docs.end()), _docs.end());
+    if (_docs.size() > _max_docs) {
+        stop();
+    } else {
+        _compact_limit = std::max(min_compact_limit, 2 * _docs.size());
+    }
+}
+
+void ChangedDocsTracker::start(uint64_t base_serial, uint32_t max_docs) {
+    _docs.clear();
+    _base_serial = base_serial;
+    _max_docs = max_docs;
+    _compact_limit = min_compact_limit;
+}
+
+void ChangedDocsTracker::stop() {
+    std::vector<uint32_t>().swap(_docs);
+    _base_serial.reset();
+    _compact_limit = min_compact_limit;
+}
+
+std::optional<std::vector<uint32_t>> ChangedDocsTracker::take(uint64_t base_serial) {
+    if (_base_serial != base_serial) {
+        stop();
+        return std::nullopt;
+    }
+    compact();
+    if (!_base_serial.has_value()) {
+        return std::nullopt;
+    }
+    std::vector<uint32_t> result;
+    result.swap(_docs);
+    stop();
+    return result;
+}
+
+} // namespace search::attribute
@@ -0,0 +1,50 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace search::attribute {
+
+/**
+ * Tracks the documents changed in an attribute vector since it was loaded
+ * from or saved to the snapshot with a given serial number, so that the
+ * next flush can save only those documents as a delta to that snapshot.
+ *
+ * Tracking stops when more than max_docs documents have changed, since a
+ * full flush is then cheaper to load than a large delta.
+ */
+class ChangedDocsTracker {
+    std::vector<uint32_t>   _docs;
+    std::optional<uint64_t> _base_serial;
+    uint32_t                _max_docs;
+    size_t                  _compact_limit;
+
+    void compact();
+
+public:
+    ChangedDocsTracker() noexcept;
+    ~ChangedDocsTracker();
+
+    void start(uint64_t base_serial, uint32_t max_docs);
+    void stop();
+    bool active() const noexcept { return _base_serial.has_value(); }
+    void add(uint32_t docid) {
+        if (_base_serial.has_value()) {
+            _docs.push_back(docid);
+            if (_docs.size() >= _compact_limit) {
+                compact();
+            }
+        }
+    }
+
+    /**
+     * Stops tracking and returns the sorted unique changed documents if
+     * they are tracked relative to the snapshot with the given serial number.
+     */
+    std::optional<std::vector<uint32_t>> take(uint64_t base_serial);
+};
+
+} // namespace search::attribute
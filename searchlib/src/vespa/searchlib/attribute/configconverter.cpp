@@ -4,6 +4,8 @@
 
 #include <vespa/searchcommon/attribute/config.h>
 
+#include <algorithm>
+
 using namespace vespa::config::search;
 
 namespace search::attribute {
@@ -72,7 +74,7 @@ DictionaryConfig::Match convert(AttributesConfig::Attribute::Dictionary::Match m
 }
 
 DictionaryConfig convert_dictionary(const AttributesConfig::Attribute::Dictionary& dictionary) {
-    return {convert(dictionary.type), convert(dictionary.match)};
+    return {convert(dictionary.type), convert(dictionary.match), dictionary.trigramindex};
 }
 
 Config::Match convertMatch(AttributesConfig::Attribute::Match match_cfg) {
@@ -100,6 +102,8 @@ Config ConfigConverter::convert(const AttributesConfig::Attribute& cfg) {
     retval.setMutable(cfg.ismutable);
     retval.setPaged(cfg.paged);
     retval.setMaxUnCommittedMemory(cfg.maxuncommittedmemory);
+    retval.set_range_buckets(std::max(cfg.rangebuckets, 0));
+    retval.set_max_delta_flushes(std::max(cfg.maxdeltaflushes, 0));
     predicateParams.setArity(cfg.arity);
     predicateParams.setBounds(cfg.lowerbound, cfg.upperbound);
     predicateParams.setDensePostingListThreshold(cfg.densepostinglistthreshold);
@@ -135,7 +139,9 @@ Config ConfigConverter::convert(const AttributesConfig::Attribute& cfg) {
     if (cfg.index.hnsw.enabled) {
         retval.set_hnsw_index_params(HnswIndexParams(cfg.index.hnsw.maxlinkspernode,
                                                      cfg.index.hnsw.neighborstoexploreatinsert, dm,
-                                                     cfg.index.hnsw.multithreadedindexing));
+                                                     cfg.index.hnsw.multithreadedindexing,
+                                                     cfg.index.hnsw.traversalquantizationbits,
+                                                     cfg.index.hnsw.partitionattribute));
     }
     if (retval.basicType().type() == BasicType::Type::TENSOR) {
         if (!cfg.tensortype.empty()) {
@@ -35,6 +35,8 @@ private:
     const IAttributeVector&                        _iattr;
     const PostingStoreType&                        _attr;
     vespalib::datastore::EntryRef                  _dictionary_snapshot;
+    queryeval::MatchingPhase                       _matching_phase;
+    const queryeval::SharedScoreThreshold*         _first_phase_score_threshold;
 
     using IteratorType = typename PostingStoreType::IteratorType;
     using IteratorWeights = std::variant<std::reference_wrapper<const std::vector<int32_t>>, std::vector<int32_t>>;
@@ -91,6 +93,12 @@ public:
         LeafBlueprint::visitMembers(visitor);
         visit_attribute(visitor, _iattr);
     }
+    void set_matching_phase(queryeval::MatchingPhase matching_phase) noexcept override {
+        _matching_phase = matching_phase;
+    }
+    void set_first_phase_score_threshold(const queryeval::SharedScoreThreshold* threshold) noexcept override {
+        _first_phase_score_threshold = threshold;
+    }
 };
 
 } // namespace search::attribute
@@ -34,7 +34,9 @@ DirectMultiTermBlueprint<PostingStoreType, SearchType>::DirectMultiTermBlueprint
       _terms(),
       _iattr(iattr),
       _attr(attr),
-      _dictionary_snapshot(_attr.get_dictionary_snapshot()) {
+      _dictionary_snapshot(_attr.get_dictionary_snapshot()),
+      _matching_phase(queryeval::MatchingPhase::FIRST_PHASE),
+      _first_phase_score_threshold(nullptr) {
     set_allow_termwise_eval(true);
     _weights.reserve(size_hint);
     _terms.reserve(size_hint);
@@ -158,6 +160,21 @@ DirectMultiTermBlueprint<PostingStoreType, SearchType>::create_search_helper(
         // In this case we should only have btree iterators.
         assert(btree_iterators.size() == _terms.size());
         assert(weights.index() == 0);
+        if constexpr (SearchType::supports_score_threshold) {
+            if (!filter_search && (_matching_phase == queryeval::MatchingPhase::FIRST_PHASE) &&
+                (_first_phase_score_threshold != nullptr))
+            {
+                std::vector<feature_t> max_scores;
+                max_scores.reserve(num_children);
+                for (size_t i = 0; i < num_children; ++i) {
+                    max_scores.push_back(
+                        SearchType::max_child_score(_weights[i], _terms[i].min_weight, _terms[i].max_weight));
+                }
+                return SearchType::create(tfmd, field_is_filter, std::get<0>(weights).get(),
+                                          std::move(btree_iterators), _first_phase_score_threshold,
+                                          std::move(max_scores));
+            }
+        }
         return SearchType::create(tfmd, field_is_filter, std::get<0>(weights).get(), std::move(btree_iterators));
     }
 }
@@ -2,6 +2,7 @@
 
 #include "enum_store_loaders.h"
 
+#include "executor_thread_bundle.h"
 #include "i_enum_store.h"
 #include "i_enum_store_dictionary.h"
 
@@ -87,7 +88,8 @@ EnumeratedPostingsLoader::EnumeratedPostingsLoader(IEnumStore& store)
     : EnumeratedLoaderBase(store),
       _loaded_enums(),
       _posting_indexes(),
-      _has_btree_dictionary(_store.get_dictionary().get_has_btree_dictionary()) {
+      _has_btree_dictionary(_store.get_dictionary().get_has_btree_dictionary()),
+      _executor(nullptr) {
 }
 
 EnumeratedPostingsLoader::~EnumeratedPostingsLoader() = default;
@@ -96,6 +98,15 @@ bool EnumeratedPostingsLoader::is_folded_change(Index lhs, Index rhs) const {
     return !_has_btree_dictionary || _store.is_folded_change(lhs, rhs);
 }
 
+void EnumeratedPostingsLoader::sort_loaded_enums() {
+    if (_executor != nullptr) {
+        attribute::ExecutorThreadBundle thread_bundle(*_executor);
+        attribute::sortLoadedByEnum(_loaded_enums, thread_bundle);
+    } else {
+        attribute::sortLoadedByEnum(_loaded_enums);
+    }
+}
+
 void EnumeratedPostingsLoader::set_ref_count(Index idx, uint32_t ref_count) {
     _store.set_ref_count(idx, ref_count);
 }
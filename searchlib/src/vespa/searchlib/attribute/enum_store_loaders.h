@@ -9,6 +9,10 @@ namespace search {
 class IEnumStore;
 }
 
+namespace vespalib {
+class Executor;
+}
+
 namespace search::enumstore {
 
 /**
@@ -67,6 +71,7 @@ private:
     attribute::LoadedEnumAttributeVector _loaded_enums;
     EntryRefVector                       _posting_indexes;
     bool                                 _has_btree_dictionary;
+    vespalib::Executor*                  _executor;
 
 public:
     EnumeratedPostingsLoader(IEnumStore& store);
@@ -77,7 +82,9 @@ public:
     ~EnumeratedPostingsLoader();
     attribute::LoadedEnumAttributeVector& get_loaded_enums() { return _loaded_enums; }
     void reserve_loaded_enums(size_t num_values) { _loaded_enums.reserve(num_values); }
-    void sort_loaded_enums() { attribute::sortLoadedByEnum(_loaded_enums); }
+    // Executor used to sort the loaded enums in parallel, or nullptr to sort them in the calling thread
+    void set_executor(vespalib::Executor* executor) noexcept { _executor = executor; }
+    void sort_loaded_enums();
     bool is_folded_change(Index lhs, Index rhs) const;
     void set_ref_count(Index idx, uint32_t ref_count);
     std::span<EntryRef> initialize_empty_posting_indexes();
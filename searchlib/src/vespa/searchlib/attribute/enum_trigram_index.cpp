@@ -0,0 +1,408 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "enum_trigram_index.h"
+
+#include <vespa/vespalib/btree/btreenode.hpp>
+#include <vespa/vespalib/datastore/unique_store_remapper.h>
+#include <vespa/vespalib/text/lowercase.h>
+#include <vespa/vespalib/text/utf8.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+
+namespace search::attribute {
+
+namespace {
+
+/*
+ * Lowercase the code point. The kelvin sign and long s are also mapped
+ * to their ascii counterparts, since case insensitive regex matching
+ * treats them as equal.
+ */
+uint32_t fold(uint32_t c) noexcept {
+    c = vespalib::LowerCase::convert(c);
+    if (c == 0x212a) {
+        return 'k';
+    }
+    if (c == 0x17f) {
+        return 's';
+    }
+    return c;
+}
+
+uint32_t bucket_of(uint32_t c0, uint32_t c1, uint32_t c2) noexcept {
+    uint64_t key = (uint64_t(c0) << 42) ^ (uint64_t(c1) << 21) ^ uint64_t(c2);
+    return (key * 0x9e3779b97f4a7c15ul) >> (64 - EnumTrigramIndex::bucket_bits);
+}
+
+void sort_unique(std::vector<uint32_t>& v) {
+    std::sort(v.begin(), v.end());
+    v.erase(std::unique(v.begin(), v.end()), v.end());
+}
+
+void add_buckets(std::string_view value, std::vector<uint32_t>& buckets) {
+    vespalib::Utf8Reader reader(value);
+    uint32_t             c0 = 0;
+    uint32_t             c1 = 0;
+    uint32_t             num_chars = 0;
+    while (reader.hasMore()) {
+        uint32_t c2 = fold(reader.getChar());
+        if (++num_chars >= 3) {
+            buckets.push_back(bucket_of(c0, c1, c2));
+        }
+        c0 = c1;
+        c1 = c2;
+    }
+}
+
+// Start of the last utf-8 encoded character in a non-empty run
+size_t last_char_start(const std::string& run) {
+    size_t pos = run.size() - 1;
+    while (pos > 0 && (static_cast<unsigned char>(run[pos]) & 0xc0) == 0x80) {
+        --pos;
+    }
+    return pos;
+}
+
+// Position after the group or character class starting at pos, or npos if not terminated
+size_t skip_nested(std::string_view pattern, size_t pos) {
+    uint32_t depth = 0;
+    bool     in_class = false;
+    for (; pos < pattern.size(); ++pos) {
+        char c = pattern[pos];
+        if (c == '\\') {
+            ++pos;
+        } else if (in_class) {
+            if (c == '[' && pos + 1 < pattern.size() && pattern[pos + 1] == ':') {
+                pos = pattern.find(":]", pos);
+                if (pos == std::string_view::npos) {
+                    return pos;
+                }
+                ++pos;
+            } else if (c == ']') {
+                in_class = false;
+                if (depth == 0) {
+                    return pos + 1;
+                }
+            }
+        } else if (c == '[') {
+            in_class = true;
+            if (pos + 1 < pattern.size() && pattern[pos + 1] == '^') {
+                ++pos;
+            }
+            if (pos + 1 < pattern.size() && pattern[pos + 1] == ']') {
+                ++pos;
+            }
+        } else if (c == '(') {
+            ++depth;
+        } else if (c == ')') {
+            if (depth == 0 || --depth == 0) {
+                return pos + 1;
+            }
+        }
+    }
+    return std::string_view::npos;
+}
+
+/*
+ * Collect the literal runs that every match of the pattern contains. Only
+ * the top level concatenation is considered; groups, classes and escapes
+ * other than escaped punctuation end the current run.
+ */
+std::optional<std::vector<std::string>> required_literal_runs(std::string_view pattern) {
+    std::vector<std::string> runs;
+    std::string              run;
+    bool                     last_is_literal = false;
+    auto                     end_run = [&runs, &run, &last_is_literal]() {
+        if (!run.empty()) {
+            runs.push_back(run);
+            run.clear();
+        }
+        last_is_literal = false;
+    };
+    for (size_t pos = 0; pos < pattern.size();) {
+        char c = pattern[pos];
+        switch (c) {
+        case '|':
+            return std::nullopt;
+        case '(':
+        case '[':
+            end_run();
+            pos = skip_nested(pattern, pos);
+            if (pos == std::string_view::npos) {
+                return std::nullopt;
+            }
+            continue;
+        case '*':
+        case '?':
+        case '{':
+            if (last_is_literal) {
+                run.resize(last_char_start(run));
+            }
+            end_run();
+            if (c == '{') {
+                pos = pattern.find('}', pos);
+                if (pos == std::string_view::npos) {
+                    return std::nullopt;
+                }
+            }
+            ++pos;
+            continue;
+        case '+':
+            if (last_is_literal) {
+                // The repeated character is required, but may be followed by more of the same
+                std::string last = run.substr(last_char_start(run));
+                end_run();
+                run = last;
+                last_is_literal = true;
+            }
+            ++pos;
+            continue;
+        case '.':
+        case '^':
+        case '$':
+            end_run();
+            ++pos;
+            continue;
+        case '\\':
+            if (pos + 1 >= pattern.size()) {
+                return std::nullopt;
+            }
+            c = pattern[pos + 1];
+            if (static_cast<unsigned char>(c) < 0x80 && !std::isalnum(static_cast<unsigned char>(c))) {
+                run.push_back(c);
+                last_is_literal = true;
+                pos += 2;
+                continue;
+            }
+            if (c == 'd' || c == 'D' || c == 'w' || c == 'W' || c == 's' || c == 'S' || c == 'b' || c == 'B') {
+                end_run();
+                pos += 2;
+                continue;
+            }
+            // Escaped code points, unicode classes and quoted text are not handled
+            return std::nullopt;
+        default:
+            break;
+        }
+        // Start of a literal character, possibly multi-byte
+        size_t len = 1;
+        while (pos + len < pattern.size() && (static_cast<unsigned char>(pattern[pos + len]) & 0xc0) == 0x80) {
+            ++len;
+        }
+        run.append(pattern.substr(pos, len));
+        last_is_literal = true;
+        pos += len;
+    }
+    end_run();
+    return runs;
+}
+
+} // namespace
+
+EnumTrigramIndex::EnumTrigramIndex() : _lists(), _buckets(num_buckets) {
+}
+
+EnumTrigramIndex::~EnumTrigramIndex() {
+    _lists.disableFreeLists();
+    _lists.disable_entry_hold_list();
+    clear();
+    _lists.reclaim_all_memory();
+}
+
+std::vector<uint32_t> EnumTrigramIndex::get_buckets(std::string_view value) {
+    std::vector<uint32_t> result;
+    add_buckets(value, result);
+    sort_unique(result);
+    return result;
+}
+
+std::optional<EnumTrigramIndex::Query> EnumTrigramIndex::make_regex_query(std::string_view pattern) {
+    auto runs = required_literal_runs(pattern);
+    if (!runs) {
+        return std::nullopt;
+    }
+    Query query;
+    for (const auto& run : *runs) {
+        add_buckets(run, query.buckets);
+    }
+    sort_unique(query.buckets);
+    if (query.buckets.empty()) {
+        return std::nullopt;
+    }
+    query.min_hits = query.buckets.size();
+    return query;
+}
+
+std::optional<EnumTrigramIndex::Query> EnumTrigramIndex::make_fuzzy_query(std::string_view term, uint32_t max_edits) {
+    Query query;
+    query.buckets = get_buckets(term);
+    if (query.buckets.size() <= 3 * max_edits) {
+        return std::nullopt;
+    }
+    query.min_hits = query.buckets.size() - 3 * max_edits;
+    return query;
+}
+
+void EnumTrigramIndex::apply(uint32_t bucket, const std::vector<ListStore::KeyDataType>& additions,
+                             const std::vector<uint32_t>& removals) {
+    EntryRef ref = _buckets[bucket].load_relaxed();
+    _lists.apply(ref, additions.data(), additions.data() + additions.size(), removals.data(),
+                 removals.data() + removals.size());
+    _buckets[bucket].store_release(ref);
+}
+
+void EnumTrigramIndex::add(EntryRef ref, const char* value) {
+    std::vector<ListStore::KeyDataType> additions(1, ListStore::KeyDataType(ref.ref(), {}));
+    for (uint32_t bucket : get_buckets(value)) {
+        apply(bucket, additions, {});
+    }
+}
+
+void EnumTrigramIndex::remove(EntryRef ref, const char* value) {
+    std::vector<uint32_t> removals(1, ref.ref());
+    for (uint32_t bucket : get_buckets(value)) {
+        apply(bucket, {}, removals);
+    }
+}
+
+void EnumTrigramIndex::remap(const EnumIndexRemapper& remapper) {
+    const auto&                         filter = remapper.get_entry_ref_filter();
+    std::vector<ListStore::KeyDataType> additions;
+    std::vector<uint32_t>               removals;
+    for (uint32_t bucket = 0; bucket < num_buckets; ++bucket) {
+        additions.clear();
+        removals.clear();
+        _lists.foreach_unfrozen_key(_buckets[bucket].load_relaxed(), [&](uint32_t key) {
+            EntryRef old_ref(key);
+            if (filter.has(old_ref)) {
+                removals.push_back(key);
+                additions.emplace_back(remapper.remap(old_ref).ref(), vespalib::btree::BTreeNoLeafData());
+            }
+        });
+        if (!removals.empty()) {
+            std::sort(additions.begin(), additions.end(),
+                      [](const auto& lhs, const auto& rhs) { return lhs._key < rhs._key; });
+            apply(bucket, additions, removals);
+        }
+    }
+}
+
+void EnumTrigramIndex::clear() {
+    for (auto& bucket : _buckets) {
+        EntryRef ref = bucket.load_relaxed();
+        if (ref.valid()) {
+            bucket.store_release(EntryRef());
+            _lists.clear(ref);
+        }
+    }
+}
+
+void EnumTrigramIndex::build(const ValueVisitor& foreach_value) {
+    clear();
+    std::vector<size_t> bucket_sizes(num_buckets);
+    foreach_value([&bucket_sizes](EntryRef, const char* value) {
+        for (uint32_t bucket : get_buckets(value)) {
+            ++bucket_sizes[bucket];
+        }
+    });
+    std::vector<std::pair<uint32_t, uint32_t>> entries;
+    std::vector<ListStore::KeyDataType>        additions;
+    for (uint32_t first = 0; first < num_buckets;) {
+        uint32_t last = first;
+        size_t   num_entries = 0;
+        do {
+            num_entries += bucket_sizes[last++];
+        } while (last < num_buckets && num_entries + bucket_sizes[last] <= build_batch_size);
+        entries.clear();
+        entries.reserve(num_entries);
+        foreach_value([first, last, &entries](EntryRef ref, const char* value) {
+            for (uint32_t bucket : get_buckets(value)) {
+                if (bucket >= first && bucket < last) {
+                    entries.emplace_back(bucket, ref.ref());
+                }
+            }
+        });
+        std::sort(entries.begin(), entries.end());
+        for (auto it = entries.begin(); it != entries.end();) {
+            uint32_t bucket = it->first;
+            additions.clear();
+            for (; it != entries.end() && it->first == bucket; ++it) {
+                additions.emplace_back(it->second, vespalib::btree::BTreeNoLeafData());
+            }
+            apply(bucket, additions, {});
+        }
+        first = last;
+    }
+}
+
+size_t EnumTrigramIndex::estimate_candidates(const Query& query) const {
+    std::vector<size_t> sizes;
+    sizes.reserve(query.buckets.size());
+    for (uint32_t bucket : query.buckets) {
+        sizes.push_back(_lists.frozenSize(_buckets[bucket].load_acquire()));
+    }
+    std::sort(sizes.begin(), sizes.end());
+    size_t num_seed_lists = sizes.size() - query.min_hits + 1;
+    size_t result = 0;
+    for (size_t i = 0; i < num_seed_lists; ++i) {
+        result += sizes[i];
+    }
+    return result;
+}
+
+std::vector<EnumTrigramIndex::EntryRef> EnumTrigramIndex::find_candidates(const Query& query) const {
+    assert(query.min_hits > 0 && query.min_hits <= query.buckets.size());
+    std::vector<std::pair<size_t, EntryRef>> lists;
+    lists.reserve(query.buckets.size());
+    for (uint32_t bucket : query.buckets) {
+        EntryRef ref = _buckets[bucket].load_acquire();
+        lists.emplace_back(_lists.frozenSize(ref), ref);
+    }
+    std::sort(lists.begin(), lists.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    /*
+     * A value with at least min_hits of the buckets must be present in one
+     * of the (num lists - min_hits + 1) smallest lists.
+     */
+    size_t                num_seed_lists = lists.size() - query.min_hits + 1;
+    std::vector<uint32_t> seeds;
+    for (size_t i = 0; i < num_seed_lists; ++i) {
+        _lists.foreach_frozen_key(lists[i].second, [&seeds](uint32_t key) { seeds.push_back(key); });
+    }
+    if (num_seed_lists > 1) {
+        sort_unique(seeds);
+    }
+    std::vector<ListStore::ConstIterator> iterators;
+    iterators.reserve(lists.size());
+    for (const auto& list : lists) {
+        iterators.push_back(_lists.beginFrozen(list.second));
+    }
+    std::vector<EntryRef> result;
+    for (uint32_t key : seeds) {
+        uint32_t hits = 0;
+        for (size_t i = 0; i < iterators.size() && hits + (iterators.size() - i) >= query.min_hits; ++i) {
+            auto& itr = iterators[i];
+            if (itr.valid() && itr.getKey() < key) {
+                itr.seek(key);
+            }
+            if (itr.valid() && itr.getKey() == key) {
+                ++hits;
+            }
+        }
+        if (hits >= query.min_hits) {
+            result.emplace_back(key);
+        }
+    }
+    return result;
+}
+
+vespalib::MemoryUsage EnumTrigramIndex::get_memory_usage() const {
+    auto   result = _lists.getMemoryUsage();
+    size_t bucket_bytes = _buckets.capacity() * sizeof(AtomicEntryRef);
+    result.incAllocatedBytes(bucket_bytes);
+    result.incUsedBytes(bucket_bytes);
+    return result;
+}
+
+} // namespace search::attribute
@@ -0,0 +1,119 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "i_enum_store.h"
+
+#include <vespa/vespalib/btree/btreestore.h>
+#include <vespa/vespalib/datastore/atomic_entry_ref.h>
+#include <vespa/vespalib/util/generation.h>
+#include <vespa/vespalib/util/memoryusage.h>
+
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace search::attribute {
+
+/**
+ * Trigram index over the unique values in a string enum store, used to
+ * narrow down the dictionary entries that must be checked by regex and
+ * fuzzy term searches.
+ *
+ * Each value is split into trigrams of case folded code points, and each
+ * trigram is hashed to one of a fixed number of buckets. A bucket has a
+ * list of the enum indexes of the values with a trigram in that bucket.
+ * Hash collisions only add candidates, and all candidates are checked
+ * against the query term afterwards, so a candidate set is always a
+ * superset of the matching values.
+ *
+ * The lists are stored in a btree store and updated in place by the
+ * writer, using the same generation handling as posting lists. The
+ * bucket table has a fixed size and never moves.
+ */
+class EnumTrigramIndex {
+public:
+    using AtomicEntryRef = vespalib::datastore::AtomicEntryRef;
+    using EntryRef = vespalib::datastore::EntryRef;
+    using EnumIndexRemapper = IEnumStore::EnumIndexRemapper;
+    using Generation = vespalib::Generation;
+    using ValueCallback = std::function<void(EntryRef, const char*)>;
+    using ValueVisitor = std::function<void(const ValueCallback&)>;
+    using ListStore = vespalib::btree::BTreeStore<uint32_t, vespalib::btree::BTreeNoLeafData,
+                                                  vespalib::btree::NoAggregated, std::less<uint32_t>,
+                                                  vespalib::btree::BTreeDefaultTraits>;
+    static constexpr uint32_t bucket_bits = 18;
+    static constexpr uint32_t num_buckets = 1u << bucket_bits;
+    // Max number of (bucket, enum index) pairs sorted at a time when building the index
+    static constexpr size_t build_batch_size = 1u << 25;
+
+    /**
+     * The buckets of a query term, and how many of them a value must
+     * have to possibly match the term.
+     */
+    struct Query {
+        std::vector<uint32_t> buckets;
+        uint32_t              min_hits = 0;
+    };
+
+private:
+    ListStore                   _lists;
+    std::vector<AtomicEntryRef> _buckets;
+
+    void apply(uint32_t bucket, const std::vector<ListStore::KeyDataType>& additions,
+               const std::vector<uint32_t>& removals);
+
+public:
+    EnumTrigramIndex();
+    EnumTrigramIndex(const EnumTrigramIndex&) = delete;
+    EnumTrigramIndex& operator=(const EnumTrigramIndex&) = delete;
+    ~EnumTrigramIndex();
+
+    // The sorted buckets of the trigrams in the given value
+    static std::vector<uint32_t> get_buckets(std::string_view value);
+
+    /**
+     * Query for values that can have a partial match for the regex. Only
+     * literal runs that are required by every match of the pattern are
+     * used. No query is returned when the pattern has no such run of at
+     * least three characters.
+     */
+    static std::optional<Query> make_regex_query(std::string_view pattern);
+
+    /**
+     * Query for values that can be within max_edits of the term, or have
+     * a prefix within max_edits of the term. Each edit destroys at most
+     * three trigrams of the term.
+     */
+    static std::optional<Query> make_fuzzy_query(std::string_view term, uint32_t max_edits);
+
+    void add(EntryRef ref, const char* value);
+    void remove(EntryRef ref, const char* value);
+    void remap(const EnumIndexRemapper& remapper);
+    void clear();
+
+    /**
+     * Rebuild the index from all values in the enum store. The visitor
+     * calls the callback for each value, and is called once per batch
+     * of buckets to limit the memory used by the build.
+     */
+    void build(const ValueVisitor& foreach_value);
+
+    /**
+     * Estimated number of candidates that must be checked for the query,
+     * which is the size of the smallest lists that all candidates must
+     * be present in.
+     */
+    size_t estimate_candidates(const Query& query) const;
+
+    // Sorted enum indexes of the values that can match the query
+    std::vector<EntryRef> find_candidates(const Query& query) const;
+
+    void freeze() { _lists.freeze(); }
+    void assign_generation(Generation current_gen) { _lists.assign_generation(current_gen); }
+    void reclaim_memory(Generation oldest_used_gen) { _lists.reclaim_memory(oldest_used_gen); }
+    vespalib::MemoryUsage get_memory_usage() const;
+};
+
+} // namespace search::attribute
@@ -22,6 +22,10 @@
 
 #include <cmath>
 
+namespace search::attribute {
+class EnumTrigramIndex;
+}
+
 namespace search {
 
 /**
@@ -52,15 +56,17 @@ public:
     using EntryComparator = vespalib::datastore::EntryComparator;
 
 private:
-    UniqueStoreType                    _store;
-    IEnumStoreDictionary*              _dict;
-    bool                               _is_folded;
-    ComparatorType                     _foldedComparator;
-    enumstore::EnumStoreCompactionSpec _compaction_spec;
-    EntryType                          _default_value;
-    AtomicIndex                        _default_value_ref;
+    UniqueStoreType                              _store;
+    IEnumStoreDictionary*                        _dict;
+    bool                                         _is_folded;
+    ComparatorType                               _foldedComparator;
+    enumstore::EnumStoreCompactionSpec           _compaction_spec;
+    EntryType                                    _default_value;
+    AtomicIndex                                  _default_value_ref;
+    std::unique_ptr<attribute::EnumTrigramIndex> _trigram_index;
 
     void free_value_if_unused(Index idx, IndexList& unused) override;
+    void add_to_trigram_index(Index idx, EntryType value);
 
     const vespalib::datastore::UniqueStoreEntryBase& get_entry_base(Index idx) const {
         return _store.get_allocator().get_wrapped(idx);
@@ -104,7 +110,7 @@ public:
 
     ssize_t load_unique_values(const void* src, size_t available, IndexVector& idx) override;
 
-    void freeze_dictionary() { _store.freeze(); }
+    void freeze_dictionary();
 
     IEnumStoreDictionary& get_dictionary() override { return *_dict; }
     const IEnumStoreDictionary& get_dictionary() const override { return *_dict; }
@@ -206,6 +212,11 @@ public:
     const vespalib::datastore::DataStoreT<IEnumStore::InternalIndex>& get_data_store() const noexcept {
         return _store.get_data_store();
     }
+    // Trigram index over the values, only present for strings with a btree posting dictionary when enabled
+    const attribute::EnumTrigramIndex* get_trigram_index() const noexcept { return _trigram_index.get(); }
+    // Rebuild the trigram index from the dictionary, used after loading the dictionary
+    void build_trigram_index();
+    vespalib::MemoryUsage get_trigram_index_memory_usage() const;
 };
 
 template <> void EnumStoreT<const char*>::write_value(BufferWriter& writer, Index idx) const;
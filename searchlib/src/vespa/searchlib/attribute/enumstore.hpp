@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "enum_trigram_index.h"
 #include "enumcomparator.h"
 #include "enumstore.h"
 
@@ -45,10 +46,26 @@ template <typename EntryT> void EnumStoreT<EntryT>::free_value_if_unused(Index i
     const auto& entry = get_entry_base(idx);
     if (entry.get_ref_count() == 0) {
         unused.push_back(idx);
+        if constexpr (has_string_type) {
+            if (_trigram_index) {
+                _trigram_index->remove(idx, get_value(idx));
+            }
+        }
         _store.get_allocator().hold(idx);
     }
 }
 
+template <typename EntryT> void EnumStoreT<EntryT>::add_to_trigram_index(Index idx, EntryType value) {
+    if constexpr (has_string_type) {
+        if (_trigram_index) {
+            _trigram_index->add(idx, value);
+        }
+    } else {
+        (void)idx;
+        (void)value;
+    }
+}
+
 template <typename EntryT>
 ssize_t EnumStoreT<EntryT>::load_unique_values_internal(const void* src, size_t available, IndexVector& idx) {
     size_t      left = available;
@@ -88,10 +105,14 @@ EnumStoreT<EntryT>::EnumStoreT(bool has_postings, const DictionaryConfig& dict_c
       _foldedComparator(make_optionally_folded_comparator(is_folded())),
       _compaction_spec(),
       _default_value(default_value),
-      _default_value_ref() {
+      _default_value_ref(),
+      _trigram_index() {
     _store.set_dictionary(make_enum_store_dictionary(*this, has_postings, dict_cfg, allocate_comparator(),
                                                      allocate_optionally_folded_comparator(is_folded())));
     _dict = static_cast<IEnumStoreDictionary*>(&_store.get_dictionary());
+    if (has_string_type && has_postings && dict_cfg.get_trigram_index() && _dict->get_has_btree_dictionary()) {
+        _trigram_index = std::make_unique<attribute::EnumTrigramIndex>();
+    }
     setup_default_value_ref();
 }
 
@@ -108,11 +129,26 @@ template <typename EntryT> vespalib::AddressSpace EnumStoreT<EntryT>::get_values
 
 template <typename EntryT> void EnumStoreT<EntryT>::assign_generation(Generation current_gen) {
     _store.assign_generation(current_gen);
+    if (_trigram_index) {
+        _trigram_index->freeze();
+        _trigram_index->assign_generation(current_gen);
+    }
 }
 
 template <typename EntryT> void EnumStoreT<EntryT>::reclaim_memory(Generation oldest_used_gen) {
     // remove generations in the range [0, firstUsed>
     _store.reclaim_memory(oldest_used_gen);
+    if (_trigram_index) {
+        _trigram_index->reclaim_memory(oldest_used_gen);
+    }
+}
+
+template <typename EntryT> void EnumStoreT<EntryT>::freeze_dictionary() {
+    // New values must be visible in the trigram index before they are visible in the dictionary
+    if (_trigram_index) {
+        _trigram_index->freeze();
+    }
+    _store.freeze();
 }
 
 template <typename EntryT>
@@ -137,6 +173,7 @@ template <typename EntryT> IEnumStore::Index EnumStoreT<EntryT>::BatchUpdater::i
         cmp, [this, &value]() -> EntryRef { return _store._store.get_allocator().allocate(value); });
     if (result.inserted()) {
         _possibly_unused.push_back(result.ref());
+        _store.add_to_trigram_index(result.ref(), value);
     }
     return result.ref();
 }
@@ -179,7 +216,11 @@ template <typename EntryT> void EnumStoreT<EntryT>::free_unused_values(IndexList
 }
 
 template <typename EntryT> IEnumStore::Index EnumStoreT<EntryT>::insert(EntryType value) {
-    return _store.add(value).ref();
+    auto result = _store.add(value);
+    if (result.inserted()) {
+        add_to_trigram_index(result.ref(), value);
+    }
+    return result.ref();
 }
 
 template <typename EntryT> void EnumStoreT<EntryT>::clear_default_value_ref() {
@@ -226,6 +267,9 @@ EnumStoreT<EntryT>::compact_worst_values(CompactionSpec            compaction_sp
         if (ref.valid() && remapper->get_entry_ref_filter().has(ref)) {
             _default_value_ref.store_release(remapper->remap(ref));
         }
+        if (_trigram_index) {
+            _trigram_index->remap(*remapper);
+        }
     }
     return remapper;
 }
@@ -246,6 +290,24 @@ bool EnumStoreT<EntryT>::consider_compact_dictionary(const CompactionStrategy& c
     return false;
 }
 
+template <typename EntryT> void EnumStoreT<EntryT>::build_trigram_index() {
+    if constexpr (has_string_type) {
+        if (_trigram_index) {
+            const auto& dictionary = _dict->get_posting_dictionary();
+            _trigram_index->build([this, &dictionary](const attribute::EnumTrigramIndex::ValueCallback& callback) {
+                for (auto itr = dictionary.begin(); itr.valid(); ++itr) {
+                    Index idx(itr.getKey().load_relaxed());
+                    callback(idx, get_value(idx));
+                }
+            });
+        }
+    }
+}
+
+template <typename EntryT> vespalib::MemoryUsage EnumStoreT<EntryT>::get_trigram_index_memory_usage() const {
+    return _trigram_index ? _trigram_index->get_memory_usage() : vespalib::MemoryUsage();
+}
+
 template <typename EntryT> std::unique_ptr<IEnumStore::Enumerator> EnumStoreT<EntryT>::make_enumerator() {
     return std::make_unique<Enumerator>(*_dict, _store.get_data_store(), false);
 }
@@ -0,0 +1,39 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "executor_thread_bundle.h"
+
+#include <vespa/vespalib/util/count_down_latch.h>
+#include <vespa/vespalib/util/cpu_usage.h>
+#include <vespa/vespalib/util/executor.h>
+#include <vespa/vespalib/util/lambdatask.h>
+
+#include <thread>
+
+using vespalib::CpuUsage;
+
+namespace search::attribute {
+
+ExecutorThreadBundle::ExecutorThreadBundle(vespalib::Executor& executor)
+    : ExecutorThreadBundle(executor, std::max(1u, std::thread::hardware_concurrency())) {
+}
+
+void ExecutorThreadBundle::run(vespalib::Runnable* const* targets, size_t cnt) {
+    if (cnt == 0) {
+        return;
+    }
+    vespalib::CountDownLatch latch(cnt - 1);
+    for (size_t i = 0; i + 1 < cnt; ++i) {
+        auto task = vespalib::makeLambdaTask([target = targets[i], &latch]() {
+            target->run();
+            latch.countDown();
+        });
+        auto rejected = _executor.execute(CpuUsage::wrap(std::move(task), CpuUsage::Category::SETUP));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    targets[cnt - 1]->run();
+    latch.await();
+}
+
+} // namespace search::attribute
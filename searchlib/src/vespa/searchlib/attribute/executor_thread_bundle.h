@@ -0,0 +1,30 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/thread_bundle.h>
+
+namespace vespalib {
+class Executor;
+}
+
+namespace search::attribute {
+
+/**
+ * Thread bundle running its targets as tasks in the shared executor, with the last target run by
+ * the calling thread. Used to split the work of loading a single attribute vector.
+ */
+class ExecutorThreadBundle : public vespalib::ThreadBundle {
+public:
+    ExecutorThreadBundle(vespalib::Executor& executor, size_t size) : _executor(executor), _size(size) {}
+    // Thread bundle with one thread per core
+    explicit ExecutorThreadBundle(vespalib::Executor& executor);
+    size_t size() const override { return _size; }
+    void run(vespalib::Runnable* const* targets, size_t cnt) override;
+
+private:
+    vespalib::Executor& _executor;
+    size_t              _size;
+};
+
+} // namespace search::attribute
@@ -3,13 +3,139 @@
 #include "loadedenumvalue.h"
 
 #include <vespa/searchlib/common/sort.h>
+#include <vespa/vespalib/util/runnable.h>
+#include <vespa/vespalib/util/thread_bundle.h>
+
+#include <algorithm>
 
 namespace search::attribute {
 
+namespace {
+
+using EnumRadix = LoadedEnumAttribute::EnumRadix;
+using EnumCompare = LoadedEnumAttribute::EnumCompare;
+
+// Number of sampled keys per partition when selecting splitters
+constexpr size_t samples_per_partition = 64;
+
+void radix_sort_loaded(LoadedEnumAttribute* data, size_t size) {
+    ShiftBasedRadixSorter<LoadedEnumAttribute, EnumRadix, EnumCompare, 56>::radix_sort(EnumRadix(), EnumCompare(),
+                                                                                       data, size, 16);
+}
+
+std::vector<uint64_t> select_splitters(const LoadedEnumAttributeVector& loaded, size_t num_parts) {
+    size_t                num_samples = num_parts * samples_per_partition;
+    std::vector<uint64_t> samples;
+    samples.reserve(num_samples);
+    for (size_t i = 0; i < num_samples; ++i) {
+        samples.push_back(EnumRadix()(loaded[(i * loaded.size()) / num_samples]));
+    }
+    std::sort(samples.begin(), samples.end());
+    std::vector<uint64_t> splitters;
+    splitters.reserve(num_parts - 1);
+    for (size_t part = 1; part < num_parts; ++part) {
+        splitters.push_back(samples[part * samples_per_partition]);
+    }
+    return splitters;
+}
+
+/*
+ * Partitions a range of the loaded enums. The first pass counts the
+ * values per partition, and the second pass copies the values to their
+ * partitions, starting at the given offsets.
+ */
+class PartitionPart : public vespalib::Runnable {
+    const LoadedEnumAttribute*   _begin;
+    const LoadedEnumAttribute*   _end;
+    const std::vector<uint64_t>& _splitters;
+    std::vector<size_t>          _counts;
+    LoadedEnumAttribute*         _dst;
+
+    size_t partition_of(const LoadedEnumAttribute& value) const {
+        return std::upper_bound(_splitters.begin(), _splitters.end(), EnumRadix()(value)) - _splitters.begin();
+    }
+
+public:
+    PartitionPart(const LoadedEnumAttribute* begin, const LoadedEnumAttribute* end,
+                  const std::vector<uint64_t>& splitters)
+        : _begin(begin),
+          _end(end),
+          _splitters(splitters),
+          _counts(splitters.size() + 1, 0),
+          _dst(nullptr) {}
+    std::vector<size_t>& counts() noexcept { return _counts; }
+    void set_dst(LoadedEnumAttribute* dst) noexcept { _dst = dst; }
+    void run() override {
+        if (_dst == nullptr) {
+            for (auto* itr = _begin; itr != _end; ++itr) {
+                ++_counts[partition_of(*itr)];
+            }
+        } else {
+            for (auto* itr = _begin; itr != _end; ++itr) {
+                _dst[_counts[partition_of(*itr)]++] = *itr;
+            }
+        }
+    }
+};
+
+class SortPart : public vespalib::Runnable {
+    LoadedEnumAttribute* _begin;
+    LoadedEnumAttribute* _end;
+
+public:
+    SortPart(LoadedEnumAttribute* begin, LoadedEnumAttribute* end) : _begin(begin), _end(end) {}
+    void run() override { radix_sort_loaded(_begin, _end - _begin); }
+};
+
+} // namespace
+
 void sortLoadedByEnum(LoadedEnumAttributeVector& loaded) {
-    ShiftBasedRadixSorter<LoadedEnumAttribute, LoadedEnumAttribute::EnumRadix, LoadedEnumAttribute::EnumCompare,
-                          56>::radix_sort(LoadedEnumAttribute::EnumRadix(), LoadedEnumAttribute::EnumCompare(),
-                                          loaded.data(), loaded.size(), 16);
+    radix_sort_loaded(loaded.data(), loaded.size());
+}
+
+void sortLoadedByEnum(LoadedEnumAttributeVector& loaded, vespalib::ThreadBundle& thread_bundle) {
+    size_t num_parts = thread_bundle.size();
+    if (loaded.size() < parallel_sort_loaded_enums_limit || num_parts < 2) {
+        sortLoadedByEnum(loaded);
+        return;
+    }
+    auto                       splitters = select_splitters(loaded, num_parts);
+    std::vector<PartitionPart> partition_parts;
+    partition_parts.reserve(num_parts);
+    for (size_t part = 0; part < num_parts; ++part) {
+        partition_parts.emplace_back(loaded.data() + (part * loaded.size()) / num_parts,
+                                     loaded.data() + ((part + 1) * loaded.size()) / num_parts, splitters);
+    }
+    thread_bundle.run(partition_parts);
+
+    // Turn the counts into offsets, with the values from each input range placed after those of the previous range
+    std::vector<size_t> partition_offsets(num_parts + 1, 0);
+    size_t              offset = 0;
+    for (size_t partition = 0; partition < num_parts; ++partition) {
+        partition_offsets[partition] = offset;
+        for (auto& part : partition_parts) {
+            size_t count = part.counts()[partition];
+            part.counts()[partition] = offset;
+            offset += count;
+        }
+    }
+    partition_offsets[num_parts] = offset;
+    LoadedEnumAttributeVector partitioned(loaded.size());
+    for (auto& part : partition_parts) {
+        part.set_dst(partitioned.data());
+    }
+    thread_bundle.run(partition_parts);
+    partition_parts.clear();
+    LoadedEnumAttributeVector().swap(loaded);
+
+    std::vector<SortPart> sort_parts;
+    sort_parts.reserve(num_parts);
+    for (size_t partition = 0; partition < num_parts; ++partition) {
+        sort_parts.emplace_back(partitioned.data() + partition_offsets[partition],
+                                partitioned.data() + partition_offsets[partition + 1]);
+    }
+    thread_bundle.run(sort_parts);
+    loaded.swap(partitioned);
 }
 
 } // namespace search::attribute
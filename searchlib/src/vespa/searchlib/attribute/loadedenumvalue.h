@@ -8,6 +8,10 @@
 #include <limits>
 #include <span>
 
+namespace vespalib {
+class ThreadBundle;
+}
+
 namespace search::attribute {
 
 /**
@@ -104,4 +108,16 @@ public:
 
 void sortLoadedByEnum(LoadedEnumAttributeVector& loaded);
 
+// Min number of loaded enums before they are sorted in parallel
+constexpr size_t parallel_sort_loaded_enums_limit = 1024 * 1024;
+
+/**
+ * Sort loaded enums using the threads in the thread bundle. The values
+ * are partitioned on sampled splitters into a temporary vector of the
+ * same size, and each partition is then sorted by its own thread.
+ * Falls back to sorting in the calling thread when there are fewer than
+ * parallel_sort_loaded_enums_limit values.
+ */
+void sortLoadedByEnum(LoadedEnumAttributeVector& loaded, vespalib::ThreadBundle& thread_bundle);
+
 } // namespace search::attribute
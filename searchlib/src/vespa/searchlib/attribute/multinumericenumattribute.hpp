@@ -56,7 +56,7 @@ void MultiValueNumericEnumAttribute<B, M>::loadAllAtOnce(AttributeReader& attrRe
 }
 
 template <typename B, typename M>
-bool MultiValueNumericEnumAttribute<B, M>::onLoadEnumerated(ReaderBase& attrReader) {
+bool MultiValueNumericEnumAttribute<B, M>::onLoadEnumerated(ReaderBase& attrReader, vespalib::Executor* executor) {
     auto udatBuffer = attribute::LoadUtils::loadUDAT(*this);
 
     uint32_t numDocs = attrReader.getNumIdx() - 1;
@@ -73,6 +73,7 @@ bool MultiValueNumericEnumAttribute<B, M>::onLoadEnumerated(ReaderBase& attrRead
 
     if (this->hasPostings()) {
         auto loader = this->getEnumStore().make_enumerated_postings_loader();
+        loader.set_executor(executor);
         loader.load_unique_values(udatBuffer->buffer(), udatBuffer->size());
         loader.build_enum_value_remapping();
         this->load_enumerated_data(attrReader, loader, numValues);
@@ -89,7 +90,7 @@ bool MultiValueNumericEnumAttribute<B, M>::onLoadEnumerated(ReaderBase& attrRead
     return true;
 }
 
-template <typename B, typename M> bool MultiValueNumericEnumAttribute<B, M>::onLoad(vespalib::Executor*) {
+template <typename B, typename M> bool MultiValueNumericEnumAttribute<B, M>::onLoad(vespalib::Executor* executor) {
     AttributeReader attrReader(*this);
     bool            ok(attrReader.getHasLoadData());
 
@@ -104,7 +105,7 @@ template <typename B, typename M> bool MultiValueNumericEnumAttribute<B, M>::onL
     this->setCreateSerialNum(attrReader.getCreateSerialNum());
 
     if (attrReader.getEnumerated()) {
-        return onLoadEnumerated(attrReader);
+        return onLoadEnumerated(attrReader, executor);
     }
 
     size_t   numDocs = attrReader.getNumIdx() - 1;
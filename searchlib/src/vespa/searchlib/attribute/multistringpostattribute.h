@@ -80,7 +80,10 @@ public:
         return forwardedOnAddDoc(doc, this->_mvMapping.getNumKeys(), this->_mvMapping.getCapacityKeys());
     }
 
-    void load_posting_lists(LoadedVector& loaded) override { handle_load_posting_lists(loaded); }
+    void load_posting_lists(LoadedVector& loaded) override {
+        handle_load_posting_lists(loaded);
+        this->_enumStore.build_trigram_index();
+    }
 
     attribute::IPostingListAttributeBase* getIPostingListAttributeBase() override { return this; }
 
@@ -88,6 +91,7 @@ public:
 
     void load_posting_lists_and_update_enum_store(enumstore::EnumeratedPostingsLoader& loader) override {
         handle_load_posting_lists_and_update_enum_store(loader);
+        this->_enumStore.build_trigram_index();
     }
 };
 
@@ -64,6 +64,7 @@ template <typename B, typename T>
 void MultiValueStringPostingAttributeT<B, T>::mergeMemoryStats(vespalib::MemoryUsage& total) {
     auto& compaction_strategy = this->getConfig().getCompactionStrategy();
     total.merge(this->_posting_store.update_stat(compaction_strategy));
+    total.merge(this->_enumStore.get_trigram_index_memory_usage());
 }
 
 template <typename B, typename T>
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "numeric_range_buckets.h"
 #include "postinglistsearchcontext.h"
 
 namespace search::attribute {
@@ -13,13 +14,18 @@ private:
     using Parent = PostingSearchContext<BaseSC, PostingListSearchContextT<DataT>, AttrT>;
     using BaseType = typename AttrT::T;
     using Params = attribute::SearchContextParams;
+    using RangeBuckets = NumericRangeBuckets<BaseType>;
+    using DictionaryConstIterator = PostingListSearchContext::DictionaryConstIterator;
     using Parent::_enumStore;
     using Parent::_high;
     using Parent::_low;
     using Parent::_toBeSearched;
-    Params _params;
+    Params              _params;
+    const RangeBuckets* _range_buckets;
 
     void getIterators(bool shouldApplyRangeLimit);
+    // First dictionary entry in the given bucket or a later bucket
+    DictionaryConstIterator bucket_start(uint32_t bucket) const;
     bool valid() const override { return this->isValid(); }
 
     HitEstimate calc_hit_estimate() const override {
@@ -39,11 +45,13 @@ private:
         }
     }
 
+    void fillBitVector(const ExecuteInfo& exec_info) override;
     bool use_posting_lists_when_non_strict(const ExecuteInfo& info) const override;
     size_t calc_estimated_hits_in_range() const override;
 
 public:
-    NumericPostingSearchContext(BaseSC&& base_sc, const Params& params, const AttrT& toBeSearched);
+    NumericPostingSearchContext(BaseSC&& base_sc, const Params& params, const AttrT& toBeSearched,
+                                const RangeBuckets* range_buckets = nullptr);
     const Params& params() const { return _params; }
 };
 
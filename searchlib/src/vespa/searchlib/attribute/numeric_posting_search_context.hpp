@@ -7,10 +7,13 @@
 namespace search::attribute {
 
 template <typename BaseSC, typename AttrT, typename DataT>
-NumericPostingSearchContext<BaseSC, AttrT, DataT>::NumericPostingSearchContext(BaseSC&&      base_sc,
-                                                                               const Params& params_in,
-                                                                               const AttrT&  toBeSearched)
-    : Parent(std::move(base_sc), params_in.useBitVector(), toBeSearched), _params(params_in) {
+NumericPostingSearchContext<BaseSC, AttrT, DataT>::NumericPostingSearchContext(BaseSC&&            base_sc,
+                                                                               const Params&       params_in,
+                                                                               const AttrT&        toBeSearched,
+                                                                               const RangeBuckets* range_buckets)
+    : Parent(std::move(base_sc), params_in.useBitVector(), toBeSearched),
+      _params(params_in),
+      _range_buckets(range_buckets) {
     if (valid()) {
         if (_low == _high) {
             auto comp = _enumStore.make_comparator(_low);
@@ -52,6 +55,58 @@ void NumericPostingSearchContext<BaseSC, AttrT, DataT>::getIterators(bool should
     }
 }
 
+template <typename BaseSC, typename AttrT, typename DataT>
+typename NumericPostingSearchContext<BaseSC, AttrT, DataT>::DictionaryConstIterator
+NumericPostingSearchContext<BaseSC, AttrT, DataT>::bucket_start(uint32_t bucket) const {
+    DictionaryConstIterator itr(vespalib::btree::BTreeNode::Ref(), this->_frozenDictionary.getAllocator());
+    if (bucket == 0) {
+        itr.begin(this->_frozenDictionary.getRoot());
+    } else if (bucket < _range_buckets->num_buckets()) {
+        auto comp = _enumStore.make_comparator(_range_buckets->lower_bound(bucket));
+        itr.lower_bound(this->_frozenDictionary.getRoot(), vespalib::datastore::AtomicEntryRef(), comp);
+    }
+    return itr;
+}
+
+template <typename BaseSC, typename AttrT, typename DataT>
+void NumericPostingSearchContext<BaseSC, AttrT, DataT>::fillBitVector(const ExecuteInfo& exec_info) {
+    if (_range_buckets == nullptr) {
+        PostingListSearchContextT<DataT>::fillBitVector(exec_info);
+        return;
+    }
+    // Find the buckets [first, last> having all their dictionary entries inside the range.
+    // Iterator positions are compared by distance, as the end iterator is not normalized.
+    const auto& lower = this->_lowerDictItr;
+    const auto& upper = this->_upperDictItr;
+    uint32_t    num_buckets = _range_buckets->num_buckets();
+    uint32_t    first = _range_buckets->bucket_of(_enumStore.get_value(lower.getKey().load_acquire()));
+    auto        first_start = bucket_start(first);
+    if ((first_start - lower) < 0) {
+        first_start = bucket_start(++first);
+    }
+    uint32_t last = first;
+    auto     last_start = first_start;
+    while (last < num_buckets) {
+        auto next_start = bucket_start(last + 1);
+        if ((upper - next_start) < 0) {
+            break;
+        }
+        ++last;
+        last_start = next_start;
+    }
+    if (first == last) {
+        PostingListSearchContextT<DataT>::fillBitVector(exec_info);
+        return;
+    }
+    BitVector* bv = this->_merger.getBitVector();
+    for (uint32_t bucket = first; bucket < last; ++bucket) {
+        bv->orWith(_range_buckets->get_bits(bucket));
+    }
+    // Only the posting lists in the partially covered buckets at the edges are merged
+    this->fill_bit_vector_range(exec_info, lower, first_start);
+    this->fill_bit_vector_range(exec_info, last_start, upper);
+}
+
 template <typename BaseSC, typename AttrT, typename DataT>
 bool NumericPostingSearchContext<BaseSC, AttrT, DataT>::use_posting_lists_when_non_strict(
     const queryeval::ExecuteInfo& info) const {
@@ -0,0 +1,124 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "numeric_range_buckets.h"
+
+#include <vespa/vespalib/datastore/unique_store_comparator.h>
+
+#include <algorithm>
+
+namespace search::attribute {
+
+namespace {
+
+template <typename T> struct Less {
+    bool operator()(const T& lhs, const T& rhs) const noexcept {
+        return vespalib::datastore::UniqueStoreComparatorHelper<T>::less(lhs, rhs);
+    }
+};
+
+template <typename T> class HeldNumericRangeBuckets : public vespalib::GenerationHeldBase {
+    std::unique_ptr<NumericRangeBuckets<T>> _buckets;
+
+public:
+    explicit HeldNumericRangeBuckets(std::unique_ptr<NumericRangeBuckets<T>> buckets)
+        : GenerationHeldBase(buckets->get_memory_usage().allocatedBytes()), _buckets(std::move(buckets)) {}
+    ~HeldNumericRangeBuckets() override = default;
+};
+
+} // namespace
+
+template <typename T>
+NumericRangeBuckets<T>::NumericRangeBuckets(std::vector<T> lower_bounds, uint32_t size, uint32_t capacity,
+                                            GenerationHolder& holder)
+    : _lower_bounds(std::move(lower_bounds)), _bits(), _rebuild_limit(0) {
+    _bits.reserve(_lower_bounds.size() + 1);
+    for (size_t i = 0; i <= _lower_bounds.size(); ++i) {
+        _bits.emplace_back(std::make_unique<GrowableBitVector>(size, capacity, holder));
+    }
+}
+
+template <typename T> NumericRangeBuckets<T>::~NumericRangeBuckets() = default;
+
+template <typename T>
+std::vector<T> NumericRangeBuckets<T>::select_lower_bounds(std::span<const ValueCount> value_counts,
+                                                           uint32_t                    num_buckets) {
+    uint64_t total = 0;
+    for (const auto& value_count : value_counts) {
+        if (!isUndefined(value_count.first)) {
+            total += value_count.second;
+        }
+    }
+    std::vector<T> result;
+    uint64_t       seen = 0;
+    for (const auto& value_count : value_counts) {
+        if (isUndefined(value_count.first)) {
+            continue;
+        }
+        if ((result.size() + 1 < num_buckets) && (seen > 0) &&
+            (seen * num_buckets >= total * (result.size() + 1))) {
+            result.push_back(value_count.first);
+        }
+        seen += value_count.second;
+    }
+    return result;
+}
+
+template <typename T> uint32_t NumericRangeBuckets<T>::bucket_of(T value) const noexcept {
+    return std::upper_bound(_lower_bounds.begin(), _lower_bounds.end(), value, Less<T>()) - _lower_bounds.begin();
+}
+
+template <typename T> void NumericRangeBuckets<T>::resize(uint32_t size, uint32_t capacity) {
+    for (auto& bits : _bits) {
+        if (bits->writer().size() > size) {
+            bits->shrink(size);
+        }
+        if (bits->writer().capacity() < capacity) {
+            bits->reserve(capacity);
+        }
+        if (bits->writer().size() < size) {
+            bits->extend(size);
+        }
+    }
+}
+
+template <typename T> void NumericRangeBuckets<T>::finish_build() {
+    uint32_t max_count = min_docs_per_bucket;
+    for (const auto& bits : _bits) {
+        max_count = std::max(max_count, bits->writer().countTrueBits());
+    }
+    _rebuild_limit = max_count * max_growth;
+}
+
+template <typename T> bool NumericRangeBuckets<T>::should_rebuild() const {
+    for (const auto& bits : _bits) {
+        if (bits->reader().countTrueBits() > _rebuild_limit) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T> vespalib::MemoryUsage NumericRangeBuckets<T>::get_memory_usage() const {
+    vespalib::MemoryUsage result;
+    size_t bytes = sizeof(NumericRangeBuckets) + _lower_bounds.capacity() * sizeof(T);
+    for (const auto& bits : _bits) {
+        bytes += sizeof(GrowableBitVector) + bits->extraByteSize();
+    }
+    result.incAllocatedBytes(bytes);
+    result.incUsedBytes(bytes);
+    return result;
+}
+
+template <typename T>
+vespalib::GenerationHeldBase::UP NumericRangeBuckets<T>::make_held(std::unique_ptr<NumericRangeBuckets> buckets) {
+    return std::make_unique<HeldNumericRangeBuckets<T>>(std::move(buckets));
+}
+
+template class NumericRangeBuckets<int8_t>;
+template class NumericRangeBuckets<int16_t>;
+template class NumericRangeBuckets<int32_t>;
+template class NumericRangeBuckets<int64_t>;
+template class NumericRangeBuckets<float>;
+template class NumericRangeBuckets<double>;
+
+} // namespace search::attribute
@@ -0,0 +1,95 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchcommon/common/undefinedvalues.h>
+#include <vespa/searchlib/common/growablebitvector.h>
+#include <vespa/vespalib/util/generationholder.h>
+#include <vespa/vespalib/util/memoryusage.h>
+
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace search::attribute {
+
+/**
+ * Bitvectors for contiguous value ranges (buckets) of a single value
+ * numeric attribute with posting lists, used to speed up wide range
+ * searches.
+ *
+ * The bucket boundaries are selected from the value distribution when
+ * the buckets are built, so that each bucket holds about the same number
+ * of documents. The first and last buckets are open ended, and every
+ * value belongs to exactly one bucket. The bitvector of a bucket has the
+ * bits set for the documents that have a value in that bucket. It is
+ * updated in place by the writer, like bitvector posting lists in the
+ * posting store. Documents with an undefined value are never matched by
+ * a range and are left out.
+ *
+ * A range search ORs the bitvectors of the buckets that are fully
+ * covered by the range, and only merges posting lists for the values in
+ * the partially covered buckets at the edges of the range.
+ */
+template <typename T> class NumericRangeBuckets {
+public:
+    using GenerationHolder = vespalib::GenerationHolder;
+    using ValueCount = std::pair<T, uint32_t>;
+    // Smallest bucket size used for the rebuild limit, avoiding frequent rebuilds while there are few documents
+    static constexpr uint32_t min_docs_per_bucket = 64;
+    // A bucket growing to this many times the largest bucket size at build time triggers a rebuild
+    static constexpr uint32_t max_growth = 4;
+
+private:
+    std::vector<T>                                  _lower_bounds; // of bucket 1 and up
+    std::vector<std::unique_ptr<GrowableBitVector>> _bits;
+    uint32_t                                        _rebuild_limit;
+
+public:
+    NumericRangeBuckets(std::vector<T> lower_bounds, uint32_t size, uint32_t capacity, GenerationHolder& holder);
+    NumericRangeBuckets(const NumericRangeBuckets&) = delete;
+    NumericRangeBuckets& operator=(const NumericRangeBuckets&) = delete;
+    ~NumericRangeBuckets();
+
+    /**
+     * Select the lower bounds of buckets 1 and up, given the values in
+     * sorted order and the number of documents having each value. Fewer
+     * buckets than asked for are used when a few values dominate, or
+     * when there are no values yet.
+     */
+    static std::vector<T> select_lower_bounds(std::span<const ValueCount> value_counts, uint32_t num_buckets);
+
+    uint32_t num_buckets() const noexcept { return _bits.size(); }
+    uint32_t bucket_of(T value) const noexcept;
+    // The smallest value in the given bucket, which must not be the first one
+    T lower_bound(uint32_t bucket) const noexcept { return _lower_bounds[bucket - 1]; }
+    const BitVector& get_bits(uint32_t bucket) const noexcept { return _bits[bucket]->reader(); }
+
+    void add(uint32_t docid, T value) {
+        if (!isUndefined(value)) {
+            _bits[bucket_of(value)]->writer().setBitAndMaintainCount(docid);
+        }
+    }
+    void remove(uint32_t docid, T value) {
+        if (!isUndefined(value)) {
+            _bits[bucket_of(value)]->writer().clearBitAndMaintainCount(docid);
+        }
+    }
+    void resize(uint32_t size, uint32_t capacity);
+
+    // Called when all documents have been added to new buckets
+    void finish_build();
+
+    /**
+     * Whether the buckets should be rebuilt, because a bucket has grown
+     * far beyond the largest bucket size when they were built.
+     */
+    bool should_rebuild() const;
+    vespalib::MemoryUsage get_memory_usage() const;
+
+    // Wrap replaced buckets to keep them alive until readers are done with them
+    static vespalib::GenerationHeldBase::UP make_held(std::unique_ptr<NumericRangeBuckets> buckets);
+};
+
+} // namespace search::attribute
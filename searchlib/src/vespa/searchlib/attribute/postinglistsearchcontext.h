@@ -113,6 +113,9 @@ protected:
     void lookupSingle();
     virtual void fillArray();
     virtual void fillBitVector(const ExecuteInfo&);
+    // Add the posting lists for the dictionary entries in [from, to> to the merged bitvector
+    void fill_bit_vector_range(const ExecuteInfo& exec_info, const DictionaryConstIterator& from,
+                               const DictionaryConstIterator& to);
 
     void fetchPostings(const ExecuteInfo& exec, bool strict) override;
     // this will be called instead of the fetchPostings function in some cases
@@ -104,16 +104,26 @@ template <typename DataT> struct PostingListSearchContextT<DataT>::FillPart : pu
 };
 
 template <typename DataT> void PostingListSearchContextT<DataT>::fillBitVector(const ExecuteInfo& exec_info) {
+    fill_bit_vector_range(exec_info, _lowerDictItr, _upperDictItr);
+}
+
+template <typename DataT>
+void PostingListSearchContextT<DataT>::fill_bit_vector_range(const ExecuteInfo&             exec_info,
+                                                             const DictionaryConstIterator& from,
+                                                             const DictionaryConstIterator& to) {
     vespalib::ThreadBundle& thread_bundle = exec_info.thread_bundle();
-    size_t                  num_iter = _upperDictItr - _lowerDictItr;
+    size_t                  num_iter = to - from;
     size_t                  num_threads = std::min(thread_bundle.size(), num_iter);
+    if (num_threads == 0) {
+        return;
+    }
 
     uint32_t              per_thread = num_iter / num_threads;
     uint32_t              rest_docs = num_iter % num_threads;
     std::vector<FillPart> parts;
     parts.reserve(num_threads);
     BitVector* master = _merger.getBitVector();
-    parts.emplace_back(exec_info.doom(), _posting_store, _lowerDictItr, per_thread + (rest_docs > 0), master,
+    parts.emplace_back(exec_info.doom(), _posting_store, from, per_thread + (rest_docs > 0), master,
                        _merger.getDocIdLimit());
     for (size_t i(1); i < num_threads; i++) {
         size_t num_this_thread = per_thread + (i < rest_docs);
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "changed_docs_tracker.h"
 #include "floatbase.h"
 #include "integerbase.h"
 #include "search_context.h"
@@ -27,7 +28,10 @@ private:
 
     using B::getGenerationHolder;
 
-    DataVector _data;
+    DataVector                    _data;
+    attribute::ChangedDocsTracker _changed_docs;
+
+    bool load_deltas();
 
     T getFromEnum(EnumHandle e) const override {
         (void)e;
@@ -115,6 +119,8 @@ public:
     void clearDocs(DocId lidLow, DocId lidLimit, bool in_shrink_lid_space) override;
     void onShrinkLidSpace() override;
     std::unique_ptr<AttributeSaver> onInitSave(std::string_view fileName) override;
+    std::unique_ptr<AttributeSaver> onInitDeltaSave(std::string_view fileName, uint64_t base_serial) override;
+    void start_tracking_changes(uint64_t base_serial) override;
     [[nodiscard]] size_t reserved_memory_for_flush(bool slow_disk) const noexcept override;
 };
 
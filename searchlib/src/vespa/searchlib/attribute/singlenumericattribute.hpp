@@ -13,6 +13,10 @@
 
 #include <vespa/searchcommon/attribute/config.h>
 #include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchlib/util/fileutil.h>
+#include <vespa/vespalib/util/exceptions.h>
+
+#include <filesystem>
 
 namespace search {
 
@@ -25,7 +29,9 @@ SingleValueNumericAttribute<B>::SingleValueNumericAttribute(const std::string& b
 template <typename B>
 SingleValueNumericAttribute<B>::SingleValueNumericAttribute(const std::string&             baseFileName,
                                                             const AttributeVector::Config& c)
-    : B(baseFileName, c), _data(c.getGrowStrategy(), getGenerationHolder(), this->get_initial_alloc()) {
+    : B(baseFileName, c),
+      _data(c.getGrowStrategy(), getGenerationHolder(), this->get_initial_alloc()),
+      _changed_docs() {
 }
 
 template <typename B> SingleValueNumericAttribute<B>::~SingleValueNumericAttribute() {
@@ -39,6 +45,7 @@ template <typename B> void SingleValueNumericAttribute<B>::onCommit() {
         // apply updates
         typename B::ValueModifier valueGuard(this->getValueModifier());
         for (const auto& change : this->_changes.getInsertOrder()) {
+            _changed_docs.add(change._doc);
             if (change._type == ChangeBase::UPDATE) {
                 vespalib::atomic::store_ref_relaxed(_data[change._doc], change._data);
             } else if (change._type >= ChangeBase::ADD && change._type <= ChangeBase::DIV) {
@@ -121,8 +128,12 @@ template <typename B> bool SingleValueNumericAttribute<B>::onLoad(vespalib::Exec
 
     this->setCreateSerialNum(attrReader.getCreateSerialNum());
 
-    if (attrReader.getEnumerated())
-        return onLoadEnumerated(attrReader);
+    if (attrReader.getEnumerated()) {
+        if (!onLoadEnumerated(attrReader)) {
+            return false;
+        }
+        return load_deltas();
+    }
 
     const size_t sz(attrReader.getDataCount());
     getGenerationHolder().reclaim_all();
@@ -136,7 +147,62 @@ template <typename B> bool SingleValueNumericAttribute<B>::onLoad(vespalib::Exec
     B::setCommittedDocIdLimit(sz);
     this->set_size_on_disk(attrReader.size_on_disk());
     this->set_last_flush_duration(attrReader.flush_duration());
+    return load_deltas();
+}
 
+/*
+ * A delta data file has a (docid, value) record for each document changed
+ * since the previous save, and its header has the doc id limit at the
+ * time of the delta save. Returns false if a delta file has a bad header,
+ * is truncated or has a docid outside the doc id limit, which is checked
+ * before any of its records are applied.
+ */
+template <typename B> bool SingleValueNumericAttribute<B>::load_deltas() {
+    constexpr size_t record_size = sizeof(uint32_t) + sizeof(T);
+    uint64_t         size_on_disk = this->size_on_disk();
+    for (uint32_t delta = 1;; ++delta) {
+        std::string delta_file_name = AttributeVector::get_delta_file_name(this->getBaseFileName(), delta);
+        if (!std::filesystem::exists(std::filesystem::path(delta_file_name + ".dat"))) {
+            break;
+        }
+        fileutil::LoadedBuffer::UP buffer;
+        try {
+            buffer = FileUtil::loadFile(delta_file_name + ".dat");
+        } catch (const vespalib::IllegalStateException&) {
+            return false;
+        }
+        auto header = attribute::AttributeHeader::extractTags(buffer->getHeader(), delta_file_name);
+        uint32_t    doc_id_limit = header.getNumDocs();
+        const char* records = buffer->c_str();
+        if ((buffer->size() % record_size) != 0) {
+            return false;
+        }
+        for (size_t offset = 0; offset < buffer->size(); offset += record_size) {
+            uint32_t docid;
+            memcpy(&docid, records + offset, sizeof(docid));
+            if (docid >= doc_id_limit) {
+                return false;
+            }
+        }
+        if (doc_id_limit < _data.size()) {
+            _data.shrink(doc_id_limit);
+        }
+        _data.unsafe_reserve(doc_id_limit);
+        while (_data.size() < doc_id_limit) {
+            _data.push_back(B::defaultValue());
+        }
+        for (size_t offset = 0; offset < buffer->size(); offset += record_size) {
+            uint32_t docid;
+            T        value;
+            memcpy(&docid, records + offset, sizeof(docid));
+            memcpy(&value, records + offset + sizeof(docid), sizeof(value));
+            _data[docid] = value;
+        }
+        B::setNumDocs(doc_id_limit);
+        B::setCommittedDocIdLimit(doc_id_limit);
+        size_on_disk += buffer->size_on_disk();
+    }
+    this->set_size_on_disk(size_on_disk);
     return true;
 }
 
@@ -190,6 +256,39 @@ std::unique_ptr<AttributeSaver> SingleValueNumericAttribute<B>::onInitSave(std::
                                                               numDocs * sizeof(T));
 }
 
+template <typename B>
+std::unique_ptr<AttributeSaver> SingleValueNumericAttribute<B>::onInitDeltaSave(std::string_view fileName,
+                                                                                uint64_t         base_serial) {
+    auto changed_docs = _changed_docs.take(base_serial);
+    if (!changed_docs.has_value()) {
+        return {};
+    }
+    const uint32_t numDocs(this->getCommittedDocIdLimit());
+    constexpr size_t  record_size = sizeof(uint32_t) + sizeof(T);
+    std::vector<char> records;
+    records.reserve(changed_docs->size() * record_size);
+    for (uint32_t docid : *changed_docs) {
+        if (docid < numDocs) {
+            T value = _data[docid];
+            records.insert(records.end(), reinterpret_cast<const char*>(&docid),
+                           reinterpret_cast<const char*>(&docid) + sizeof(docid));
+            records.insert(records.end(), reinterpret_cast<const char*>(&value),
+                           reinterpret_cast<const char*>(&value) + sizeof(value));
+        }
+    }
+    return std::make_unique<SingleValueNumericAttributeSaver>(this->createAttributeHeader(fileName), records.data(),
+                                                              records.size());
+}
+
+template <typename B> void SingleValueNumericAttribute<B>::start_tracking_changes(uint64_t base_serial) {
+    if (this->getConfig().max_delta_flushes() > 0) {
+        // A delta with more than 1/8 of the documents is not worth loading on top of a full save
+        _changed_docs.start(base_serial, std::max(this->getCommittedDocIdLimit() / 8, 1u));
+    } else {
+        _changed_docs.stop();
+    }
+}
+
 template <typename B>
 size_t SingleValueNumericAttribute<B>::reserved_memory_for_flush(bool slow_disk) const noexcept {
     uint32_t committedDocIdLimit = this->getCommittedDocIdLimit();
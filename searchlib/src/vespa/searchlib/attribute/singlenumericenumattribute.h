@@ -55,7 +55,7 @@ public:
     void onCommit() override;
     bool onLoad(vespalib::Executor* executor) override;
 
-    bool onLoadEnumerated(ReaderBase& attrReader);
+    bool onLoadEnumerated(ReaderBase& attrReader, vespalib::Executor* executor);
 
     std::unique_ptr<attribute::SearchContext> getSearch(QueryTermSimpleUP                     term,
                                                         const attribute::SearchContextParams& params) const override;
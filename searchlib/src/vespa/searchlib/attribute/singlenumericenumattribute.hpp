@@ -68,7 +68,8 @@ template <typename B> void SingleValueNumericEnumAttribute<B>::onCommit() {
     _currDocValues.clear();
 }
 
-template <typename B> bool SingleValueNumericEnumAttribute<B>::onLoadEnumerated(ReaderBase& attrReader) {
+template <typename B>
+bool SingleValueNumericEnumAttribute<B>::onLoadEnumerated(ReaderBase& attrReader, vespalib::Executor* executor) {
     auto udatBuffer = attribute::LoadUtils::loadUDAT(*this);
 
     uint64_t numValues = attrReader.getEnumCount();
@@ -80,6 +81,7 @@ template <typename B> bool SingleValueNumericEnumAttribute<B>::onLoadEnumerated(
     this->set_last_flush_duration(attrReader.flush_duration());
     if (this->hasPostings()) {
         auto loader = this->getEnumStore().make_enumerated_postings_loader();
+        loader.set_executor(executor);
         loader.load_unique_values(udatBuffer->buffer(), udatBuffer->size());
         loader.build_enum_value_remapping();
         this->load_enumerated_data(attrReader, loader, numValues);
@@ -96,7 +98,7 @@ template <typename B> bool SingleValueNumericEnumAttribute<B>::onLoadEnumerated(
     return true;
 }
 
-template <typename B> bool SingleValueNumericEnumAttribute<B>::onLoad(vespalib::Executor*) {
+template <typename B> bool SingleValueNumericEnumAttribute<B>::onLoad(vespalib::Executor* executor) {
     PrimitiveReader<T> attrReader(*this);
     bool               ok(attrReader.getHasLoadData());
 
@@ -111,7 +113,7 @@ template <typename B> bool SingleValueNumericEnumAttribute<B>::onLoad(vespalib::
     this->setCreateSerialNum(attrReader.getCreateSerialNum());
 
     if (attrReader.getEnumerated()) {
-        return onLoadEnumerated(attrReader);
+        return onLoadEnumerated(attrReader, executor);
     }
 
     const uint32_t                                       numDocs(attrReader.getDataCount());
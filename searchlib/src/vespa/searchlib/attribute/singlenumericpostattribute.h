@@ -4,10 +4,13 @@
 
 #include "i_docid_posting_store.h"
 #include "numeric_direct_posting_store_adapter.h"
+#include "numeric_range_buckets.h"
 #include "postinglistattribute.h"
 #include "postinglistsearchcontext.h"
 #include "singlenumericenumattribute.h"
 
+#include <atomic>
+
 namespace search {
 
 /**
@@ -42,6 +45,7 @@ private:
     using PostingMap = typename PostingParent::PostingMap;
     using PostingStore = typename PostingParent::PostingStore;
     using QueryTermSimpleUP = AttributeVector::QueryTermSimpleUP;
+    using RangeBuckets = attribute::NumericRangeBuckets<T>;
     using SelfType = SingleValueNumericPostingAttribute<B>;
     using ValueModifier = typename B::BaseClass::ValueModifier;
 
@@ -54,6 +58,9 @@ private:
     using DirectPostingStoreAdapterType =
         attribute::NumericDirectPostingStoreAdapter<IDocidPostingStore, PostingStore, EnumStore>;
     DirectPostingStoreAdapterType _posting_store_adapter;
+    // Owned and updated by the writer, readers use _range_buckets_view
+    std::unique_ptr<RangeBuckets>    _range_buckets;
+    std::atomic<const RangeBuckets*> _range_buckets_view;
 
     void freezeEnumDictionary() override;
     void mergeMemoryStats(vespalib::MemoryUsage& total) override;
@@ -62,6 +69,9 @@ private:
                            const std::map<DocId, EnumIndex>& currEnumIndices, PostingMap& changePost);
 
     void applyValueChanges(EnumStoreBatchUpdater& updater) override;
+    void consider_build_range_buckets();
+    void resize_range_buckets(DocId doc);
+    void forwardedShrinkLidSpace(uint32_t newSize) override;
 
 public:
     SingleValueNumericPostingAttribute(const std::string& name, const AttributeVector::Config& cfg);
@@ -75,10 +85,17 @@ public:
 
     const IDocidPostingStore* as_docid_posting_store() const override;
 
+    // Value range buckets used by range search, nullptr if not enabled in config or not built yet
+    const RangeBuckets* get_range_buckets() const noexcept {
+        return _range_buckets_view.load(std::memory_order_acquire);
+    }
+
     bool onAddDoc(DocId doc) override {
+        resize_range_buckets(doc);
         return forwardedOnAddDoc(doc, this->_enumIndices.size(), this->_enumIndices.capacity());
     }
     void onAddDocs(DocId docIdLimit) override {
+        resize_range_buckets(docIdLimit);
         forwardedOnAddDoc(docIdLimit, this->_enumIndices.size(), this->_enumIndices.capacity());
     }
 
@@ -22,7 +22,9 @@ SingleValueNumericPostingAttribute<B>::SingleValueNumericPostingAttribute(const
                                                                           const AttributeVector::Config& c)
     : SingleValueNumericEnumAttribute<B>(name, c),
       PostingParent(*this, this->getEnumStore()),
-      _posting_store_adapter(this->get_posting_store(), this->_enumStore, this->getIsFilter()) {
+      _posting_store_adapter(this->get_posting_store(), this->_enumStore, this->getIsFilter()),
+      _range_buckets(),
+      _range_buckets_view(nullptr) {
 }
 
 template <typename B> void SingleValueNumericPostingAttribute<B>::freezeEnumDictionary() {
@@ -32,6 +34,9 @@ template <typename B> void SingleValueNumericPostingAttribute<B>::freezeEnumDict
 template <typename B> void SingleValueNumericPostingAttribute<B>::mergeMemoryStats(vespalib::MemoryUsage& total) {
     auto& compaction_strategy = this->getConfig().getCompactionStrategy();
     total.merge(this->_posting_store.update_stat(compaction_strategy));
+    if (_range_buckets) {
+        total.merge(_range_buckets->get_memory_usage());
+    }
 }
 
 template <typename B>
@@ -50,6 +55,7 @@ template <typename B>
 void SingleValueNumericPostingAttribute<B>::makePostingChange(const vespalib::datastore::EntryComparator& cmpa,
                                                               const std::map<DocId, EnumIndex>& currEnumIndices,
                                                               PostingMap&                       changePost) {
+    RangeBuckets* range_buckets = _range_buckets.get();
     for (const auto& elem : currEnumIndices) {
         uint32_t  docId = elem.first;
         EnumIndex oldIdx = this->_enumIndices[docId].load_relaxed();
@@ -62,6 +68,13 @@ void SingleValueNumericPostingAttribute<B>::makePostingChange(const vespalib::da
         if (oldIdx.valid()) {
             changePost[EnumPostingPair(oldIdx, &cmpa)].remove(docId);
         }
+
+        if (range_buckets != nullptr) {
+            if (oldIdx.valid()) {
+                range_buckets->remove(docId, this->_enumStore.get_value(oldIdx));
+            }
+            range_buckets->add(docId, this->_enumStore.get_value(newIdx));
+        }
     }
 }
 
@@ -102,6 +115,55 @@ template <typename B> void SingleValueNumericPostingAttribute<B>::applyValueChan
 
     this->updatePostings(changePost);
     SingleValueNumericEnumAttribute<B>::applyValueChanges(updater);
+    consider_build_range_buckets();
+}
+
+template <typename B> void SingleValueNumericPostingAttribute<B>::consider_build_range_buckets() {
+    uint32_t                    num_buckets = this->getConfig().range_buckets();
+    const IEnumStoreDictionary& dictionary = this->_enumStore.get_dictionary();
+    if ((num_buckets < 2) || !dictionary.get_has_btree_dictionary()) {
+        return;
+    }
+    if (_range_buckets && !_range_buckets->should_rebuild()) {
+        return;
+    }
+    std::vector<typename RangeBuckets::ValueCount> value_counts;
+    value_counts.reserve(dictionary.get_num_uniques());
+    for (auto itr = dictionary.get_posting_dictionary().begin(); itr.valid(); ++itr) {
+        value_counts.emplace_back(this->_enumStore.get_value(itr.getKey().load_relaxed()),
+                                  _posting_store.size(itr.getData().load_relaxed()));
+    }
+    uint32_t size = this->_enumIndices.size();
+    auto     lower_bounds = RangeBuckets::select_lower_bounds(value_counts, num_buckets);
+    auto     buckets = std::make_unique<RangeBuckets>(std::move(lower_bounds), size, this->_enumIndices.capacity(),
+                                                  this->getGenerationHolder());
+    for (uint32_t docId = 0; docId < size; ++docId) {
+        EnumIndex idx = this->_enumIndices[docId].load_relaxed();
+        if (idx.valid()) {
+            buckets->add(docId, this->_enumStore.get_value(idx));
+        }
+    }
+    buckets->finish_build();
+    _range_buckets_view.store(buckets.get(), std::memory_order_release);
+    if (_range_buckets) {
+        this->getGenerationHolder().insert(RangeBuckets::make_held(std::move(_range_buckets)));
+    }
+    _range_buckets = std::move(buckets);
+}
+
+template <typename B> void SingleValueNumericPostingAttribute<B>::resize_range_buckets(DocId doc) {
+    if (_range_buckets) {
+        size_t size = std::max(size_t(doc) + 1, this->_enumIndices.size());
+        size_t capacity = std::max(size_t(doc) + 1, this->_enumIndices.capacity());
+        _range_buckets->resize(size, capacity);
+    }
+}
+
+template <typename B> void SingleValueNumericPostingAttribute<B>::forwardedShrinkLidSpace(uint32_t newSize) {
+    PostingParent::forwardedShrinkLidSpace(newSize);
+    if (_range_buckets) {
+        _range_buckets->resize(newSize, newSize);
+    }
 }
 
 template <typename B>
@@ -125,7 +187,7 @@ SingleValueNumericPostingAttribute<B>::getSearch(QueryTermSimple::UP
     using SC = attribute::NumericPostingSearchContext<BaseSC, SelfType, vespalib::btree::BTreeNoLeafData>;
     auto   docid_limit = this->getCommittedDocIdLimit();
     BaseSC base_sc(std::move(qTerm), *this, this->_enumIndices.make_read_view(docid_limit), this->_enumStore);
-    return std::make_unique<SC>(std::move(base_sc), params, *this);
+    return std::make_unique<SC>(std::move(base_sc), params, *this, get_range_buckets());
 }
 
 template <typename B>
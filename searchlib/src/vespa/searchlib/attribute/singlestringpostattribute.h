@@ -85,7 +85,10 @@ public:
         forwardedOnAddDoc(lidLimit, this->_enumIndices.size(), this->_enumIndices.capacity());
     }
 
-    void load_posting_lists(LoadedVector& loaded) override { handle_load_posting_lists(loaded); }
+    void load_posting_lists(LoadedVector& loaded) override {
+        handle_load_posting_lists(loaded);
+        this->_enumStore.build_trigram_index();
+    }
 
     attribute::IPostingListAttributeBase* getIPostingListAttributeBase() override { return this; }
 
@@ -93,6 +96,7 @@ public:
 
     void load_posting_lists_and_update_enum_store(enumstore::EnumeratedPostingsLoader& loader) override {
         handle_load_posting_lists_and_update_enum_store(loader);
+        this->_enumStore.build_trigram_index();
     }
 };
 
@@ -2,9 +2,12 @@
 
 #pragma once
 
+#include "enum_trigram_index.h"
 #include "posting_list_folded_search_context.h"
 #include "postinglistsearchcontext.h"
 
+#include <optional>
+
 namespace search::attribute {
 
 template <typename BaseSC, typename AttrT, typename DataT>
@@ -12,9 +15,16 @@ class StringPostingSearchContext
     : public PostingSearchContext<BaseSC, PostingListFoldedSearchContextT<DataT>, AttrT> {
 private:
     using ExecuteInfo = queryeval::ExecuteInfo;
-    using Parent = PostingSearchContext<BaseSC, PostingListFoldedSearchContextT<DataT>, AttrT>;
+    using FoldedParent = PostingListFoldedSearchContextT<DataT>;
+    using Parent = PostingSearchContext<BaseSC, FoldedParent, AttrT>;
     using RegexpUtil = vespalib::RegexpUtil;
+    using TrigramQuery = EnumTrigramIndex::Query;
     using Parent::_enumStore;
+    // Only use the trigram index when scanning the dictionary range means checking this many times more values
+    static constexpr uint32_t min_scanned_values_per_trigram_candidate = 4;
+
+    std::optional<TrigramQuery> _trigram_query;
+
     // Note: Steps iterator one or more steps when not using dictionary entry
     bool use_dictionary_entry(PostingListSearchContext::DictionaryConstIterator& it) const override;
     // Note: Uses copy of dictionary iterator to avoid stepping original.
@@ -22,6 +32,8 @@ private:
         return use_dictionary_entry(it);
     }
     bool use_posting_lists_when_non_strict(const ExecuteInfo& info) const override;
+    void setup_trigram_query();
+    size_t calc_estimated_hits_in_range() const override;
 
 public:
     StringPostingSearchContext(BaseSC&& base_sc, bool useBitVector, const AttrT& toBeSearched);
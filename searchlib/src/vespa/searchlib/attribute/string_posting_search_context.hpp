@@ -5,12 +5,14 @@
 #include "posting_list_folded_search_context.hpp"
 #include "string_posting_search_context.h"
 
+#include <algorithm>
+
 namespace search::attribute {
 
 template <typename BaseSC, typename AttrT, typename DataT>
 StringPostingSearchContext<BaseSC, AttrT, DataT>::StringPostingSearchContext(BaseSC&& base_sc, bool useBitVector,
                                                                              const AttrT& toBeSearched)
-    : Parent(std::move(base_sc), useBitVector, toBeSearched) {
+    : Parent(std::move(base_sc), useBitVector, toBeSearched), _trigram_query() {
     if (this->valid()) {
         if (this->isPrefix()) {
             auto comp = _enumStore.make_folded_comparator_prefix(this->queryTerm()->getTerm());
@@ -37,10 +39,64 @@ StringPostingSearchContext<BaseSC, AttrT, DataT>::StringPostingSearchContext(Bas
             } else {
                 this->_uniqueValues = 0;
             }
+        } else if (this->_uniqueValues > 1u) {
+            setup_trigram_query();
         }
     }
 }
 
+template <typename BaseSC, typename AttrT, typename DataT>
+void StringPostingSearchContext<BaseSC, AttrT, DataT>::setup_trigram_query() {
+    const auto* trigram_index = _enumStore.get_trigram_index();
+    if (trigram_index == nullptr) {
+        return;
+    }
+    const auto* term = this->queryTerm();
+    if (this->isRegex()) {
+        _trigram_query = EnumTrigramIndex::make_regex_query(term->getTerm());
+    } else if (this->isFuzzy()) {
+        _trigram_query = EnumTrigramIndex::make_fuzzy_query(term->getTerm(), term->fuzzy_max_edit_distance());
+    }
+    if (_trigram_query && (trigram_index->estimate_candidates(*_trigram_query) *
+                           min_scanned_values_per_trigram_candidate) >= this->_uniqueValues)
+    {
+        _trigram_query.reset();
+    }
+}
+
+template <typename BaseSC, typename AttrT, typename DataT>
+size_t StringPostingSearchContext<BaseSC, AttrT, DataT>::calc_estimated_hits_in_range() const {
+    if (!_trigram_query) {
+        return FoldedParent::calc_estimated_hits_in_range();
+    }
+    /*
+     * Check the values given by the trigram index instead of scanning the
+     * dictionary range. Values sharing a posting list (folded dictionary)
+     * give the same posting list, and values not yet in the frozen
+     * dictionary give no posting list.
+     */
+    auto  candidates = _enumStore.get_trigram_index()->find_candidates(*_trigram_query);
+    auto  frozen_root = this->_frozenDictionary.getRoot();
+    auto& posting_indexes = this->_posting_indexes;
+    for (auto candidate : candidates) {
+        const char* value = _enumStore.get_value(IEnumStore::Index(candidate));
+        if (this->match(value)) {
+            auto cmp = _enumStore.make_folded_comparator(value);
+            auto pidx = this->_dictionary.find_posting_list(cmp, frozen_root).second;
+            if (pidx.valid()) {
+                posting_indexes.emplace_back(pidx);
+            }
+        }
+    }
+    std::sort(posting_indexes.begin(), posting_indexes.end());
+    posting_indexes.erase(std::unique(posting_indexes.begin(), posting_indexes.end()), posting_indexes.end());
+    size_t sum = 0;
+    for (auto pidx : posting_indexes) {
+        sum += this->_posting_store.frozenSize(pidx);
+    }
+    return sum;
+}
+
 template <typename BaseSC, typename AttrT, typename DataT>
 bool StringPostingSearchContext<BaseSC, AttrT, DataT>::use_dictionary_entry(
     PostingListSearchContext::DictionaryConstIterator& it) const {
@@ -164,7 +164,7 @@ bool StringAttribute::apply(DocId, const ArithmeticValueUpdate&) {
     return false;
 }
 
-bool StringAttribute::onLoadEnumerated(ReaderBase& attrReader) {
+bool StringAttribute::onLoadEnumerated(ReaderBase& attrReader, vespalib::Executor* executor) {
     auto udatBuffer = attribute::LoadUtils::loadUDAT(*this);
 
     bool     hasIdx(attrReader.hasIdx());
@@ -188,6 +188,7 @@ bool StringAttribute::onLoadEnumerated(ReaderBase& attrReader) {
 
     if (hasPostings()) {
         auto loader = this->getEnumStoreBase()->make_enumerated_postings_loader();
+        loader.set_executor(executor);
         loader.load_unique_values(udatBuffer->buffer(), udatBuffer->size());
         loader.build_enum_value_remapping();
         load_enumerated_data(attrReader, loader, numValues);
@@ -204,7 +205,7 @@ bool StringAttribute::onLoadEnumerated(ReaderBase& attrReader) {
     return true;
 }
 
-bool StringAttribute::onLoad(vespalib::Executor*) {
+bool StringAttribute::onLoad(vespalib::Executor* executor) {
     ReaderBase attrReader(*this);
     bool       ok(attrReader.getHasLoadData());
 
@@ -219,7 +220,7 @@ bool StringAttribute::onLoad(vespalib::Executor*) {
     setCreateSerialNum(attrReader.getCreateSerialNum());
 
     assert(attrReader.getEnumerated());
-    return onLoadEnumerated(attrReader);
+    return onLoadEnumerated(attrReader, executor);
 }
 
 bool StringAttribute::onAddDoc(DocId) {
@@ -68,7 +68,7 @@ protected:
     const Change _defaultValue;
     bool onLoad(vespalib::Executor* executor) override;
 
-    bool onLoadEnumerated(ReaderBase& attrReader);
+    bool onLoadEnumerated(ReaderBase& attrReader, vespalib::Executor* executor);
 
     bool onAddDoc(DocId doc) override;
 
@@ -187,3 +187,4 @@
 #define CID_search_expression_IsTruePredicateNode SEARCHLIB_CID(180)
 #define CID_search_expression_GeoDistanceFunctionNode SEARCHLIB_CID(181)
 #define CID_search_expression_PositionDocumentFieldNode SEARCHLIB_CID(182)
+#define CID_search_aggregation_HeavyHittersAggregationResult SEARCHLIB_CID(183)
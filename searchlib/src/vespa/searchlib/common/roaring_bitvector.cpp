@@ -0,0 +1,321 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "roaring_bitvector.h"
+
+#include <vespa/vespalib/hwaccelerated/functions.h>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+namespace search {
+
+namespace hwaccelerated = vespalib::hwaccelerated;
+
+namespace {
+
+constexpr uint32_t bitmap_bytes = RoaringBitVector::bitmap_words * sizeof(uint64_t);
+
+// First position >= pos with a set bit (or a cleared bit if 'flip' is all ones), chunk_size if none
+uint32_t next_bit(const uint64_t* bitmap, uint32_t pos, uint64_t flip) noexcept {
+    if (pos >= RoaringBitVector::chunk_size) {
+        return RoaringBitVector::chunk_size;
+    }
+    uint32_t i = pos / 64;
+    uint64_t word = (bitmap[i] ^ flip) & (~uint64_t(0) << (pos % 64));
+    while (word == 0) {
+        if (++i == RoaringBitVector::bitmap_words) {
+            return RoaringBitVector::chunk_size;
+        }
+        word = bitmap[i] ^ flip;
+    }
+    return (i * 64) + __builtin_ctzl(word);
+}
+
+void set_range(uint64_t* bitmap, uint32_t first, uint32_t last) noexcept {
+    for (uint32_t i = first / 64; i <= last / 64; ++i) {
+        uint64_t mask = ~uint64_t(0);
+        if (i == first / 64) {
+            mask &= (~uint64_t(0) << (first % 64));
+        }
+        if (i == last / 64) {
+            mask &= (~uint64_t(0) >> (63 - (last % 64)));
+        }
+        bitmap[i] |= mask;
+    }
+}
+
+uint32_t key_of(uint32_t idx) noexcept {
+    return idx >> RoaringBitVector::chunk_bits;
+}
+
+} // namespace
+
+RoaringBitVector::Container::Container() noexcept : kind(Kind::ARRAY), count(0), values(), words() {
+}
+
+RoaringBitVector::Container::Container(Container&&) noexcept = default;
+RoaringBitVector::Container::Container(const Container&) = default;
+RoaringBitVector::Container& RoaringBitVector::Container::operator=(Container&&) noexcept = default;
+RoaringBitVector::Container::~Container() = default;
+
+RoaringBitVector::Container RoaringBitVector::Container::make(const uint64_t* bitmap) {
+    Container result;
+    result.count = hwaccelerated::population_count(bitmap, bitmap_words);
+    uint32_t num_runs = 0;
+    uint64_t carry = 0;
+    for (uint32_t i = 0; i < bitmap_words; ++i) {
+        num_runs += __builtin_popcountl(bitmap[i] & ~((bitmap[i] << 1) | carry));
+        carry = bitmap[i] >> 63;
+    }
+    size_t array_bytes = (result.count <= max_array_size) ? (result.count * sizeof(uint16_t)) : bitmap_bytes;
+    size_t run_bytes = num_runs * 2 * sizeof(uint16_t);
+    if (run_bytes < std::min(array_bytes, size_t(bitmap_bytes))) {
+        result.kind = Kind::RUN;
+        result.values.reserve(num_runs * 2);
+        for (uint32_t first = next_bit(bitmap, 0, 0); first < chunk_size;) {
+            uint32_t end = next_bit(bitmap, first, ~uint64_t(0));
+            result.values.push_back(first);
+            result.values.push_back(end - 1);
+            first = next_bit(bitmap, end, 0);
+        }
+    } else if (result.count <= max_array_size) {
+        result.kind = Kind::ARRAY;
+        result.values.reserve(result.count);
+        for (uint32_t i = 0; i < bitmap_words; ++i) {
+            for (uint64_t word = bitmap[i]; word != 0; word &= (word - 1)) {
+                result.values.push_back((i * 64) + __builtin_ctzl(word));
+            }
+        }
+    } else {
+        result.kind = Kind::BITMAP;
+        result.words.assign(bitmap, bitmap + bitmap_words);
+    }
+    return result;
+}
+
+RoaringBitVector::Container RoaringBitVector::Container::make_array(std::vector<uint16_t> values) {
+    assert(values.size() <= max_array_size);
+    Container result;
+    result.kind = Kind::ARRAY;
+    result.count = values.size();
+    result.values = std::move(values);
+    return result;
+}
+
+bool RoaringBitVector::Container::array_contains(uint32_t low) const noexcept {
+    // branch free binary search, array containers are never empty
+    const uint16_t* base = values.data();
+    size_t          n = values.size();
+    while (n > 1) {
+        size_t half = n / 2;
+        base = (base[half] <= low) ? (base + half) : base;
+        n -= half;
+    }
+    return (*base == low);
+}
+
+uint32_t RoaringBitVector::Container::next(uint32_t low) const noexcept {
+    switch (kind) {
+    case Kind::ARRAY: {
+        auto pos = std::lower_bound(values.begin(), values.end(), low);
+        return (pos != values.end()) ? *pos : chunk_size;
+    }
+    case Kind::BITMAP:
+        return next_bit(words.data(), low, 0);
+    case Kind::RUN: {
+        // first run with last >= low
+        size_t lo = 0;
+        size_t hi = values.size() / 2;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (values[(2 * mid) + 1] < low) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return (lo < values.size() / 2) ? std::max(low, uint32_t(values[2 * lo])) : chunk_size;
+    }
+    }
+    return chunk_size;
+}
+
+void RoaringBitVector::Container::to_bitmap(uint64_t* bitmap) const noexcept {
+    switch (kind) {
+    case Kind::ARRAY:
+        for (uint16_t value : values) {
+            bitmap[value / 64] |= (uint64_t(1) << (value % 64));
+        }
+        break;
+    case Kind::BITMAP:
+        std::copy(words.begin(), words.end(), bitmap);
+        break;
+    case Kind::RUN:
+        for (size_t i = 0; i < values.size(); i += 2) {
+            set_range(bitmap, values[i], values[i + 1]);
+        }
+        break;
+    }
+}
+
+size_t RoaringBitVector::Container::allocated_bytes() const noexcept {
+    return (values.capacity() * sizeof(uint16_t)) + (words.capacity() * sizeof(uint64_t));
+}
+
+RoaringBitVector::Builder::Builder(Index start, Index end)
+    : _result(new RoaringBitVector(start, end)),
+      _bitmap(bitmap_words, 0),
+      _key(0),
+      _empty(true) {
+}
+
+RoaringBitVector::Builder::~Builder() = default;
+
+void RoaringBitVector::Builder::flush() {
+    if (!_empty) {
+        _result->add(_key, Container::make(_bitmap.data()));
+        std::fill(_bitmap.begin(), _bitmap.end(), 0);
+        _empty = true;
+    }
+}
+
+RoaringBitVector::UP RoaringBitVector::Builder::build() {
+    flush();
+    return std::move(_result);
+}
+
+RoaringBitVector::RoaringBitVector(Index start, Index end) noexcept
+    : _start(start), _end(std::max(start, end)), _count(0), _keys(), _containers(), _chunk_containers() {
+}
+
+RoaringBitVector::~RoaringBitVector() = default;
+
+void RoaringBitVector::add(uint32_t key, Container container) {
+    assert(_keys.empty() || (_keys.back() < key));
+    if (container.count > 0) {
+        _count += container.count;
+        _chunk_containers.resize(key + 1, no_container);
+        _chunk_containers[key] = _containers.size();
+        _keys.push_back(key);
+        _containers.push_back(std::move(container));
+    }
+}
+
+RoaringBitVector::Index RoaringBitVector::getNextTrueBit(Index start) const noexcept {
+    if (start >= _end) {
+        return _end;
+    }
+    size_t i = std::lower_bound(_keys.begin(), _keys.end(), key_of(start)) - _keys.begin();
+    for (; i < _keys.size(); ++i) {
+        uint32_t low = (_keys[i] == key_of(start)) ? (start & (chunk_size - 1)) : 0;
+        uint32_t next = _containers[i].next(low);
+        if (next < chunk_size) {
+            return std::min((Index(_keys[i]) << chunk_bits) | next, _end);
+        }
+    }
+    return _end;
+}
+
+size_t RoaringBitVector::get_allocated_bytes() const noexcept {
+    size_t result = sizeof(RoaringBitVector) + (_keys.capacity() * sizeof(uint32_t)) +
+                    (_containers.capacity() * sizeof(Container)) +
+                    (_chunk_containers.capacity() * sizeof(uint32_t));
+    for (const auto& container : _containers) {
+        result += container.allocated_bytes();
+    }
+    return result;
+}
+
+RoaringBitVector::UP RoaringBitVector::create(const BitVector& bits) {
+    Builder builder(bits.getStartIndex(), bits.size());
+    bits.foreach_truebit([&builder](uint32_t idx) { builder.set(idx); }, bits.getStartIndex());
+    return builder.build();
+}
+
+RoaringBitVector::UP RoaringBitVector::create(std::span<const uint32_t> docids, Index start, Index end) {
+    Builder builder(start, end);
+    for (uint32_t docid : docids) {
+        assert((docid >= start) && (docid < end));
+        builder.set(docid);
+    }
+    return builder.build();
+}
+
+RoaringBitVector::UP RoaringBitVector::and_of(const RoaringBitVector& a, const RoaringBitVector& b) {
+    UP                    result(new RoaringBitVector(std::max(a._start, b._start), std::min(a._end, b._end)));
+    std::vector<uint64_t> lhs(bitmap_words);
+    std::vector<uint64_t> rhs(bitmap_words);
+    size_t                i = 0;
+    size_t                j = 0;
+    while ((i < a._keys.size()) && (j < b._keys.size())) {
+        if (a._keys[i] < b._keys[j]) {
+            ++i;
+        } else if (b._keys[j] < a._keys[i]) {
+            ++j;
+        } else {
+            const Container& x = a._containers[i];
+            const Container& y = b._containers[j];
+            if ((x.kind == Kind::ARRAY) || (y.kind == Kind::ARRAY)) {
+                const Container&      array = (x.kind == Kind::ARRAY) ? x : y;
+                const Container&      other = (x.kind == Kind::ARRAY) ? y : x;
+                std::vector<uint16_t> values;
+                for (uint16_t value : array.values) {
+                    if (other.test(value)) {
+                        values.push_back(value);
+                    }
+                }
+                result->add(a._keys[i], Container::make_array(std::move(values)));
+            } else {
+                std::fill(lhs.begin(), lhs.end(), 0);
+                std::fill(rhs.begin(), rhs.end(), 0);
+                x.to_bitmap(lhs.data());
+                y.to_bitmap(rhs.data());
+                hwaccelerated::and_bit(lhs.data(), rhs.data(), bitmap_bytes);
+                result->add(a._keys[i], Container::make(lhs.data()));
+            }
+            ++i;
+            ++j;
+        }
+    }
+    return result;
+}
+
+RoaringBitVector::UP RoaringBitVector::or_of(const RoaringBitVector& a, const RoaringBitVector& b) {
+    UP                    result(new RoaringBitVector(std::min(a._start, b._start), std::max(a._end, b._end)));
+    std::vector<uint64_t> lhs(bitmap_words);
+    std::vector<uint64_t> rhs(bitmap_words);
+    size_t                i = 0;
+    size_t                j = 0;
+    while ((i < a._keys.size()) || (j < b._keys.size())) {
+        if ((j == b._keys.size()) || ((i < a._keys.size()) && (a._keys[i] < b._keys[j]))) {
+            result->add(a._keys[i], a._containers[i]);
+            ++i;
+        } else if ((i == a._keys.size()) || (b._keys[j] < a._keys[i])) {
+            result->add(b._keys[j], b._containers[j]);
+            ++j;
+        } else {
+            const Container& x = a._containers[i];
+            const Container& y = b._containers[j];
+            if ((x.kind == Kind::ARRAY) && (y.kind == Kind::ARRAY) && ((x.count + y.count) <= max_array_size)) {
+                std::vector<uint16_t> values;
+                values.reserve(x.count + y.count);
+                std::set_union(x.values.begin(), x.values.end(), y.values.begin(), y.values.end(),
+                               std::back_inserter(values));
+                result->add(a._keys[i], Container::make_array(std::move(values)));
+            } else {
+                std::fill(lhs.begin(), lhs.end(), 0);
+                std::fill(rhs.begin(), rhs.end(), 0);
+                x.to_bitmap(lhs.data());
+                y.to_bitmap(rhs.data());
+                hwaccelerated::or_bit(lhs.data(), rhs.data(), bitmap_bytes);
+                result->add(a._keys[i], Container::make(lhs.data()));
+            }
+            ++i;
+            ++j;
+        }
+    }
+    return result;
+}
+
+} // namespace search
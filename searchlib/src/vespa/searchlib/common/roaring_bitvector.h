@@ -0,0 +1,182 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "bitvector.h"
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace search {
+
+/**
+ * Immutable compressed bitvector with the same [start, end) range and
+ * bit lookup/iteration contract as BitVector.
+ *
+ * The docid space is split into chunks of 2^16 bits, and each non-empty
+ * chunk is stored in the smallest of three container types: a sorted
+ * array of set bits (sparse chunks), a plain bitmap (dense chunks) or a
+ * list of runs of set bits (clustered chunks). Empty chunks take no
+ * space. This makes sparse and clustered sets take a fraction of the
+ * size()/8 bytes needed by a BitVector. Bitmap containers are combined
+ * with the accelerated bit operations used by BitVector. Bit lookups
+ * find the container of a chunk directly from its key.
+ **/
+class RoaringBitVector {
+public:
+    using Index = BitVector::Index;
+    using UP = std::unique_ptr<RoaringBitVector>;
+    static constexpr uint32_t chunk_bits = 16;
+    static constexpr uint32_t chunk_size = 1u << chunk_bits;
+    static constexpr uint32_t bitmap_words = chunk_size / 64;
+    static constexpr uint32_t max_array_size = 4096;
+
+private:
+    enum class Kind : uint8_t { ARRAY, BITMAP, RUN };
+
+    struct Container {
+        Kind                  kind;
+        uint32_t              count;
+        std::vector<uint16_t> values; // ARRAY: set bits, RUN: (first, last) pairs
+        std::vector<uint64_t> words;  // BITMAP
+
+        Container() noexcept;
+        Container(Container&&) noexcept;
+        Container(const Container&);
+        Container& operator=(Container&&) noexcept;
+        ~Container();
+        static Container make(const uint64_t* bitmap);
+        static Container make_array(std::vector<uint16_t> values);
+        uint32_t next(uint32_t low) const noexcept;
+        bool array_contains(uint32_t low) const noexcept;
+        bool test(uint32_t low) const noexcept {
+            switch (kind) {
+            case Kind::BITMAP:
+                return ((words[low / 64] >> (low % 64)) & 1) != 0;
+            case Kind::ARRAY:
+                return array_contains(low);
+            case Kind::RUN:
+                break;
+            }
+            return next(low) == low;
+        }
+        void to_bitmap(uint64_t* bitmap) const noexcept;
+        size_t allocated_bytes() const noexcept;
+        template <typename FunctionType> void for_each(Index base, FunctionType func) const;
+    };
+
+    static constexpr uint32_t no_container = -1;
+
+    Index                  _start;
+    Index                  _end;
+    Index                  _count;
+    std::vector<uint32_t>  _keys;
+    std::vector<Container> _containers;
+    std::vector<uint32_t>  _chunk_containers; // index into _containers for each chunk key, or no_container
+
+    RoaringBitVector(Index start, Index end) noexcept;
+    void add(uint32_t key, Container container);
+
+public:
+    /**
+     * Builds a RoaringBitVector from bits set in increasing order. Only
+     * a single chunk is kept as a bitmap while building.
+     **/
+    class Builder {
+    private:
+        UP                    _result;
+        std::vector<uint64_t> _bitmap;
+        uint32_t              _key;
+        bool                  _empty;
+
+        void flush();
+
+    public:
+        Builder(Index start, Index end);
+        ~Builder();
+        void set(uint32_t idx) {
+            if ((idx >> chunk_bits) != _key) {
+                flush();
+                _key = idx >> chunk_bits;
+            }
+            uint32_t low = idx & (chunk_size - 1);
+            _bitmap[low / 64] |= (uint64_t(1) << (low % 64));
+            _empty = false;
+        }
+        UP build();
+    };
+
+    RoaringBitVector(const RoaringBitVector&) = delete;
+    RoaringBitVector& operator=(const RoaringBitVector&) = delete;
+    ~RoaringBitVector();
+
+    Index getStartIndex() const noexcept { return _start; }
+    Index size() const noexcept { return _end; }
+    Index countTrueBits() const noexcept { return _count; }
+    bool testBit(Index idx) const noexcept {
+        uint32_t key = idx >> chunk_bits;
+        if (key >= _chunk_containers.size()) {
+            return false;
+        }
+        uint32_t pos = _chunk_containers[key];
+        return (pos != no_container) && _containers[pos].test(idx & (chunk_size - 1));
+    }
+
+    /**
+     * Get next bit set in the bitvector (inclusive start), or size()
+     * if there are no more bits set.
+     */
+    Index getNextTrueBit(Index start) const noexcept;
+
+    template <typename FunctionType> void foreach_truebit(FunctionType func) const {
+        for (size_t i = 0; i < _keys.size(); ++i) {
+            _containers[i].for_each(Index(_keys[i]) << chunk_bits, func);
+        }
+    }
+
+    size_t get_allocated_bytes() const noexcept;
+
+    static UP create(const BitVector& bits);
+    // 'docids' must be sorted and within [start, end)
+    static UP create(std::span<const uint32_t> docids, Index start, Index end);
+    static UP and_of(const RoaringBitVector& a, const RoaringBitVector& b);
+    static UP or_of(const RoaringBitVector& a, const RoaringBitVector& b);
+
+    /**
+     * Whether a result with the given estimated number of hits is
+     * expected to be (much) smaller as a RoaringBitVector than as a
+     * BitVector covering 'docid_limit' bits. At 1/16 of the bits set
+     * both take the same space while a bit lookup is several times
+     * slower, so at most a quarter of that is required.
+     */
+    static bool is_compact_preferred(uint32_t est_hits, uint32_t docid_limit) noexcept {
+        return (uint64_t(est_hits) * 4 * (chunk_size / max_array_size)) < docid_limit;
+    }
+};
+
+template <typename FunctionType> void RoaringBitVector::Container::for_each(Index base, FunctionType func) const {
+    switch (kind) {
+    case Kind::ARRAY:
+        for (uint16_t value : values) {
+            func(base + value);
+        }
+        break;
+    case Kind::BITMAP:
+        for (uint32_t i = 0; i < bitmap_words; ++i) {
+            for (uint64_t word = words[i]; word != 0; word &= (word - 1)) {
+                func(base + (i * 64) + __builtin_ctzl(word));
+            }
+        }
+        break;
+    case Kind::RUN:
+        for (size_t i = 0; i < values.size(); i += 2) {
+            for (Index idx = base + values[i]; idx <= base + values[i + 1]; ++idx) {
+                func(idx);
+            }
+        }
+        break;
+    }
+}
+
+} // namespace search
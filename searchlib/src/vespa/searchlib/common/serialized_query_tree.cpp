@@ -58,6 +58,18 @@ std::unique_ptr<QueryStackIterator> SerializedQueryTree::makeIterator() const {
     }
 }
 
+std::string SerializedQueryTree::cache_key() const {
+    std::string key;
+    if (_protoQueryTree) {
+        key = "p";
+        key.append(_protoQueryTree->SerializeAsString());
+    } else {
+        key = "s";
+        key.append(_stackDump.data(), _stackDump.size());
+    }
+    return key;
+}
+
 const SerializedQueryTree& SerializedQueryTree::empty() {
     static SerializedQueryTreeSP empty_instance = fromStackDump(std::vector<char>());
     return *empty_instance;
@@ -5,6 +5,7 @@
 #include <vespa/searchlib/query/query_stack_iterator.h>
 
 #include <memory>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -30,6 +31,9 @@ public:
     static SerializedQueryTreeSP fromStackDump(std::string_view stackDumpRef);
     static SerializedQueryTreeSP fromProtobuf(std::unique_ptr<ProtobufQueryTree> protoQueryTree);
     std::unique_ptr<QueryStackIterator> makeIterator() const;
+    // Binary representation that is equal for equal query trees
+    // received in the same format, usable as (part of) a cache key.
+    std::string cache_key() const;
     // use for testing only:
     std::string_view getStackRef() const noexcept { return std::string_view(_stackDump.data(), _stackDump.size()); }
 
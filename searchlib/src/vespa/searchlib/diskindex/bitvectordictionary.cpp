@@ -121,6 +121,14 @@ std::unique_ptr<const BitVector> BitVectorDictionary::read_bitvector(BitVectorDi
     return read_bitvector(lookup_result, read_stats);
 }
 
+void BitVectorDictionary::prefetch_bitvector(BitVectorDictionaryLookupResult lookup_result) const {
+    if (!lookup_result.valid()) {
+        return;
+    }
+    auto range = get_bitvector_file_range(lookup_result);
+    _datFile->willNeed(range.start_offset, range.size());
+}
+
 PostingListFileRange
 BitVectorDictionary::get_bitvector_file_range(index::BitVectorDictionaryLookupResult lookup_result) const {
     if (!lookup_result.valid()) {
@@ -75,6 +75,10 @@ public:
     std::unique_ptr<const BitVector> read_bitvector(index::BitVectorDictionaryLookupResult lookup_result,
                                                     ReadStats&                             read_stats);
     std::unique_ptr<const BitVector> read_bitvector(index::BitVectorDictionaryLookupResult lookup_result);
+    /**
+     * Start asynchronous readahead of the associated bit vector if lookup result is valid.
+     **/
+    void prefetch_bitvector(index::BitVectorDictionaryLookupResult lookup_result) const;
     index::PostingListFileRange get_bitvector_file_range(index::BitVectorDictionaryLookupResult lookup_result) const;
 
     uint32_t getDocIdLimit() const noexcept { return _docIdLimit; }
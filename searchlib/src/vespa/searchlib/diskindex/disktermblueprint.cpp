@@ -76,6 +76,17 @@ void DiskTermBlueprint::log_posting_list_read() const {
         range.size());
 }
 
+void DiskTermBlueprint::prefetchPostings() {
+    if (_fetchPostingsDone) {
+        return;
+    }
+    if (use_bitvector() && _bitvector_lookup_result.valid()) {
+        _field_index.prefetch_bit_vector(_bitvector_lookup_result);
+    } else {
+        _field_index.prefetch_posting_list(_lookupRes);
+    }
+}
+
 void DiskTermBlueprint::fetchPostings(const queryeval::ExecuteInfo& execInfo) {
     (void)execInfo;
     if (!_fetchPostingsDone) {
@@ -56,6 +56,7 @@ public:
     std::unique_ptr<queryeval::SearchIterator>
     createLeafSearch(const fef::TermFieldMatchDataArray& tfmda) const override;
 
+    void prefetchPostings() override;
     void fetchPostings(const queryeval::ExecuteInfo& execInfo) override;
 
     std::unique_ptr<queryeval::SearchIterator> createFilterSearchImpl(FilterConstraint) const override;
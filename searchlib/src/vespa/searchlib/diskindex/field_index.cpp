@@ -196,6 +196,23 @@ PostingListHandle FieldIndex::read_posting_list(const DictionaryLookupResult& lo
     return result;
 }
 
+void FieldIndex::prefetch_posting_list(const DictionaryLookupResult& lookup_result) const {
+    auto file = _posting_file.get();
+    if (file == nullptr || lookup_result.counts._bitLength == 0) {
+        return;
+    }
+    if (!file->getMemoryMapped() && _posting_list_cache_enabled) {
+        IPostingListCache::Key key;
+        key.file_id = _file_id;
+        key.bit_offset = lookup_result.bitOffset;
+        key.bit_length = lookup_result.counts._bitLength;
+        if (_posting_list_cache->contains(key)) {
+            return; // Served from cache, no disk read to prepare for
+        }
+    }
+    file->prefetch_posting_list(lookup_result);
+}
+
 BitVectorDictionaryLookupResult FieldIndex::lookup_bit_vector(const DictionaryLookupResult& lookup_result) const {
     if (!_bit_vector_dict || !lookup_result.valid()) {
         return {};
@@ -236,6 +253,21 @@ std::shared_ptr<const BitVector> FieldIndex::read_bit_vector(BitVectorDictionary
     return result;
 }
 
+void FieldIndex::prefetch_bit_vector(BitVectorDictionaryLookupResult lookup_result) const {
+    if (!_bit_vector_dict || !lookup_result.valid()) {
+        return;
+    }
+    if (!_bit_vector_dict->get_memory_mapped() && _bitvector_cache_enabled) {
+        IPostingListCache::BitVectorKey key;
+        key.file_id = _file_id;
+        key.lookup_result = lookup_result;
+        if (_posting_list_cache->contains(key)) {
+            return; // Served from cache, no disk read to prepare for
+        }
+    }
+    _bit_vector_dict->prefetch_bitvector(lookup_result);
+}
+
 std::unique_ptr<search::queryeval::SearchIterator>
 FieldIndex::create_iterator(const DictionaryLookupResult& lookup_result, const index::PostingListHandle& handle,
                             const search::fef::TermFieldMatchDataArray& tfmda) const {
@@ -82,6 +82,8 @@ public:
                                                         bool                                         trim) const;
     index::PostingListHandle read(const IPostingListCache::Key& key, IPostingListCache::Context& ctx) const override;
     index::PostingListHandle read_posting_list(const search::index::DictionaryLookupResult& lookup_result) const;
+    // Start asynchronous readahead of posting list, to be read later using read_posting_list()
+    void prefetch_posting_list(const search::index::DictionaryLookupResult& lookup_result) const;
     PostingListFileRange
     get_posting_list_file_range(const search::index::DictionaryLookupResult& lookup_result) const {
         return _posting_file->get_posting_list_file_range(lookup_result);
@@ -93,6 +95,8 @@ public:
     std::shared_ptr<const BitVector> read(const IPostingListCache::BitVectorKey& key,
                                           IPostingListCache::Context&            ctx) const override;
     std::shared_ptr<const BitVector> read_bit_vector(index::BitVectorDictionaryLookupResult lookup_result) const;
+    // Start asynchronous readahead of bit vector, to be read later using read_bit_vector()
+    void prefetch_bit_vector(index::BitVectorDictionaryLookupResult lookup_result) const;
     PostingListFileRange get_bitvector_file_range(index::BitVectorDictionaryLookupResult lookup_result) const {
         return _bit_vector_dict->get_bitvector_file_range(lookup_result);
     }
@@ -7,6 +7,7 @@
 #include "pagedict4file.h"
 #include "zcposocc.h"
 
+#include <vespa/searchcommon/common/schema.h>
 #include <vespa/vespalib/util/error.h>
 
 #include <filesystem>
@@ -62,6 +63,12 @@ bool FieldWriter::open(uint32_t minSkipDocs, uint32_t minChunkDocs, uint64_t fea
     }
     if (encode_interleaved_features) {
         params.set("interleaved_features", encode_interleaved_features);
+        if (schema.getIndexField(indexId).use_block_max_features()) {
+            params.set("block_max_features", true);
+        }
+    }
+    if (schema.getIndexField(indexId).use_packed_doc_ids()) {
+        params.set("packed_doc_ids", true);
     }
 
     _dictFile = std::make_unique<PageDict4FileSeqWrite>();
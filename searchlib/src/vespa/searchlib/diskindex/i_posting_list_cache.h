@@ -59,6 +59,9 @@ public:
     virtual ~IPostingListCache() = default;
     virtual search::index::PostingListHandle read(const Key& key, Context& ctx) const = 0;
     virtual std::shared_ptr<const BitVector> read(const BitVectorKey& key, Context& ctx) const = 0;
+    // Tell if an entry is cached, without reading it on a miss and without altering the LRU order.
+    virtual bool contains(const Key& key) const = 0;
+    virtual bool contains(const BitVectorKey& key) const = 0;
     virtual vespalib::CacheStats get_stats() const = 0;
     virtual vespalib::CacheStats get_bitvector_stats() const = 0;
     virtual bool enabled_for_posting_lists() const noexcept = 0;
@@ -0,0 +1,124 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "packed_doc_id_block.h"
+
+#include "zc_decoder.h"
+#include "zcbuf.h"
+
+#include <vespa/vespalib/hwaccelerated/functions.h>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace search::diskindex {
+
+namespace {
+
+constexpr uint32_t block_size = PackedDocIdBlock::block_size;
+constexpr uint32_t lanes = 4;
+
+static_assert(std::endian::native == std::endian::little, "packed doc id blocks are decoded with native loads");
+
+} // namespace
+
+PackedDocIdBlockEncoder::PackedDocIdBlockEncoder(bool encode_interleaved_features) noexcept
+    : _doc_id_deltas(),
+      _field_lengths(),
+      _num_occs(),
+      _size(0),
+      _encode_interleaved_features(encode_interleaved_features) {
+}
+
+PackedDocIdBlockEncoder::~PackedDocIdBlockEncoder() = default;
+
+void PackedDocIdBlockEncoder::write_packed(ZcBuf& zc_buf, const std::array<uint32_t, block_size>& values) {
+    uint32_t max_value = *std::max_element(values.begin(), values.end());
+    uint32_t bit_width = std::bit_width(max_value);
+    std::array<uint32_t, lanes * 32> words{};
+    for (uint32_t i = 0; i < block_size; ++i) {
+        uint32_t lane = i % lanes;
+        uint32_t bit_pos = (i / lanes) * bit_width;
+        uint32_t word = bit_pos / 32;
+        uint32_t shift = bit_pos % 32;
+        words[word * lanes + lane] |= values[i] << shift;
+        if (shift + bit_width > 32) {
+            words[(word + 1) * lanes + lane] |= values[i] >> (32 - shift);
+        }
+    }
+    zc_buf.write_byte(bit_width);
+    for (uint32_t i = 0; i < lanes * bit_width; ++i) {
+        uint32_t word = words[i];
+        for (uint32_t byte = 0; byte < sizeof(uint32_t); ++byte, word >>= 8) {
+            zc_buf.write_byte(word & 0xff);
+        }
+    }
+}
+
+void PackedDocIdBlockEncoder::flush(ZcBuf& zc_buf) {
+    assert(_size > 0);
+    zc_buf.write_byte(_size - 1);
+    if (full()) {
+        write_packed(zc_buf, _doc_id_deltas);
+        if (_encode_interleaved_features) {
+            write_packed(zc_buf, _field_lengths);
+            write_packed(zc_buf, _num_occs);
+        }
+    } else {
+        for (uint32_t i = 0; i < _size; ++i) {
+            zc_buf.encode32(_doc_id_deltas[i]);
+            if (_encode_interleaved_features) {
+                zc_buf.encode32(_field_lengths[i]);
+                zc_buf.encode32(_num_occs[i]);
+            }
+        }
+    }
+    _size = 0;
+}
+
+PackedDocIdBlockDecoder::PackedDocIdBlockDecoder() noexcept : _doc_ids(), _field_lengths(), _num_occs(), _size(0) {
+}
+
+PackedDocIdBlockDecoder::~PackedDocIdBlockDecoder() = default;
+
+const uint8_t* PackedDocIdBlockDecoder::read_packed(const uint8_t* src, uint32_t* dest) noexcept {
+    uint32_t bit_width = *src++;
+    vespalib::hwaccelerated::unpack_bits_128(src, bit_width, dest);
+    return src + lanes * sizeof(uint32_t) * bit_width;
+}
+
+const uint8_t* PackedDocIdBlockDecoder::decode(const uint8_t* src, uint32_t prev_doc_id,
+                                               bool decode_interleaved_features) noexcept {
+    _size = static_cast<uint32_t>(*src++) + 1;
+    if (_size == block_size) {
+        src = read_packed(src, _doc_ids.data());
+        if (decode_interleaved_features) {
+            src = read_packed(src, _field_lengths.data());
+            src = read_packed(src, _num_occs.data());
+        }
+    } else {
+        ZcDecoder zc_decoder(src);
+        for (uint32_t i = 0; i < _size; ++i) {
+            _doc_ids[i] = zc_decoder.decode32();
+            if (decode_interleaved_features) {
+                _field_lengths[i] = zc_decoder.decode32();
+                _num_occs[i] = zc_decoder.decode32();
+            }
+        }
+        src = zc_decoder.get_cur();
+    }
+    uint32_t doc_id = prev_doc_id;
+    for (uint32_t i = 0; i < _size; ++i) {
+        doc_id += _doc_ids[i] + 1;
+        _doc_ids[i] = doc_id;
+    }
+    if (decode_interleaved_features) {
+        for (uint32_t i = 0; i < _size; ++i) {
+            ++_field_lengths[i];
+            ++_num_occs[i];
+        }
+    }
+    return src;
+}
+
+} // namespace search::diskindex
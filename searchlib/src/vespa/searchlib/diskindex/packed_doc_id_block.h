@@ -0,0 +1,89 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace search::diskindex {
+
+class ZcBuf;
+
+/*
+ * Block based layout for the document id deltas (and interleaved features) in posting lists
+ * with skip info, used instead of one zc encoded value per document when the posting list
+ * file has the "packed_doc_ids" header tag set.
+ *
+ * A block starts with a byte containing the number of documents in the block minus one.
+ * A full block (block_size documents) then contains one packed stream per value kind: doc id
+ * delta minus one, and for interleaved features also field length minus one and number of
+ * occurrences minus one. Each stream is a bit width byte followed by 4 * bit width 32-bit
+ * little endian words in the layout decoded by vespalib::hwaccelerated::unpack_bits_128().
+ * A partial block (last block in a posting list chunk) stores the same values zc encoded.
+ *
+ * L1 skip entries are written at every block boundary, thus skipping always lands on
+ * the start of a block.
+ */
+struct PackedDocIdBlock {
+    static constexpr uint32_t block_size = 128;
+};
+
+/*
+ * Class for collecting and writing blocks of document id deltas and interleaved features.
+ */
+class PackedDocIdBlockEncoder {
+    std::array<uint32_t, PackedDocIdBlock::block_size> _doc_id_deltas;
+    std::array<uint32_t, PackedDocIdBlock::block_size> _field_lengths;
+    std::array<uint32_t, PackedDocIdBlock::block_size> _num_occs;
+    uint32_t                                           _size;
+    const bool                                         _encode_interleaved_features;
+
+    static void write_packed(ZcBuf& zc_buf, const std::array<uint32_t, PackedDocIdBlock::block_size>& values);
+
+public:
+    explicit PackedDocIdBlockEncoder(bool encode_interleaved_features) noexcept;
+    ~PackedDocIdBlockEncoder();
+    // Values are already adjusted, i.e. doc id delta minus one etc.
+    void add(uint32_t doc_id_delta, uint32_t field_length, uint32_t num_occs) noexcept {
+        _doc_id_deltas[_size] = doc_id_delta;
+        _field_lengths[_size] = field_length;
+        _num_occs[_size] = num_occs;
+        ++_size;
+    }
+    bool full() const noexcept { return _size == PackedDocIdBlock::block_size; }
+    bool empty() const noexcept { return _size == 0; }
+    void flush(ZcBuf& zc_buf);
+};
+
+/*
+ * Class for decoding a block of document ids and interleaved features. Document ids are
+ * stored as absolute values after decoding.
+ */
+class PackedDocIdBlockDecoder {
+    std::array<uint32_t, PackedDocIdBlock::block_size> _doc_ids;
+    std::array<uint32_t, PackedDocIdBlock::block_size> _field_lengths;
+    std::array<uint32_t, PackedDocIdBlock::block_size> _num_occs;
+    uint32_t                                           _size;
+
+    static const uint8_t* read_packed(const uint8_t* src, uint32_t* dest) noexcept;
+
+public:
+    PackedDocIdBlockDecoder() noexcept;
+    ~PackedDocIdBlockDecoder();
+    // Decode the block starting at src, returning the start of the next block.
+    const uint8_t* decode(const uint8_t* src, uint32_t prev_doc_id, bool decode_interleaved_features) noexcept;
+    void clear() noexcept { _size = 0; }
+    uint32_t size() const noexcept { return _size; }
+    uint32_t doc_id(uint32_t idx) const noexcept { return _doc_ids[idx]; }
+    uint32_t field_length(uint32_t idx) const noexcept { return _field_lengths[idx]; }
+    uint32_t num_occs(uint32_t idx) const noexcept { return _num_occs[idx]; }
+    // Returns index of first document at or after idx with document id >= doc_id, or size() if none.
+    uint32_t seek(uint32_t idx, uint32_t doc_id) const noexcept {
+        while (idx < _size && _doc_ids[idx] < doc_id) {
+            ++idx;
+        }
+        return idx;
+    }
+};
+
+} // namespace search::diskindex
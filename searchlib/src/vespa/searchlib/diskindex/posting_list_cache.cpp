@@ -117,6 +117,14 @@ std::shared_ptr<const BitVector> PostingListCache::read(const BitVectorKey& key,
     return _bitvector_cache->read(key, ctx);
 }
 
+bool PostingListCache::contains(const Key& key) const {
+    return _cache->hasKey(key);
+}
+
+bool PostingListCache::contains(const BitVectorKey& key) const {
+    return _bitvector_cache->hasKey(key);
+}
+
 vespalib::CacheStats PostingListCache::get_stats() const {
     return _cache->get_stats();
 }
@@ -72,6 +72,8 @@ public:
     ~PostingListCache() override;
     search::index::PostingListHandle read(const Key& key, Context& ctx) const override;
     std::shared_ptr<const BitVector> read(const BitVectorKey& key, Context& ctx) const override;
+    bool contains(const Key& key) const override;
+    bool contains(const BitVectorKey& key) const override;
     vespalib::CacheStats get_stats() const override;
     vespalib::CacheStats get_bitvector_stats() const override;
     bool enabled_for_posting_lists() const noexcept override;
@@ -16,6 +16,8 @@ struct Zc4PostingParams {
     bool     _dynamic_k;
     bool     _encode_features;
     bool     _encode_interleaved_features;
+    bool     _encode_block_max;      // L1 skip entries contain max num_occs for the skipped block
+    bool     _encode_packed_doc_ids; // Doc ids (and interleaved features) are stored in packed blocks
 
     Zc4PostingParams(uint32_t min_skip_docs, uint32_t min_chunk_docs, uint32_t doc_id_limit, bool dynamic_k,
                      bool encode_features, bool encode_interleaved_features)
@@ -24,7 +26,9 @@ struct Zc4PostingParams {
           _doc_id_limit(doc_id_limit),
           _dynamic_k(dynamic_k),
           _encode_features(encode_features),
-          _encode_interleaved_features(encode_interleaved_features) {}
+          _encode_interleaved_features(encode_interleaved_features),
+          _encode_block_max(false),
+          _encode_packed_doc_ids(false) {}
 };
 
 } // namespace search::diskindex
@@ -6,6 +6,7 @@
 
 #include <vespa/searchlib/index/docidandfeatures.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cinttypes>
 
@@ -49,27 +50,63 @@ void Zc4PostingReaderBase::NoSkipBase::check_end(uint32_t last_doc_id) {
     assert(_zc_decoder.at_end());
 }
 
-Zc4PostingReaderBase::NoSkip::NoSkip() : NoSkipBase(), _field_length(1), _num_occs(1) {
+Zc4PostingReaderBase::NoSkip::NoSkip()
+    : NoSkipBase(),
+      _field_length(1),
+      _num_occs(1),
+      _block_max_num_occs(0),
+      _decode_packed_doc_ids(false),
+      _packed_block_idx(0),
+      _packed_block() {
 }
 
 Zc4PostingReaderBase::NoSkip::~NoSkip() = default;
 
+void Zc4PostingReaderBase::NoSkip::setup(DecodeContext& decode_context, uint32_t size, uint32_t doc_id) {
+    NoSkipBase::setup(decode_context, size, doc_id);
+    _packed_block.clear();
+    _packed_block_idx = 0;
+}
+
+void Zc4PostingReaderBase::NoSkip::read_packed(bool decode_interleaved_features) {
+    if (_packed_block_idx == _packed_block.size()) {
+        assert(_zc_decoder.before_end());
+        _zc_decoder.set_cur(_packed_block.decode(_zc_decoder.get_cur(), _doc_id, decode_interleaved_features));
+        _packed_block_idx = 0;
+        // L1 skip entries refer to the position after the previous block
+        _doc_id_pos = _zc_decoder.pos();
+    }
+    _doc_id = _packed_block.doc_id(_packed_block_idx);
+    if (decode_interleaved_features) {
+        _field_length = _packed_block.field_length(_packed_block_idx);
+        _num_occs = _packed_block.num_occs(_packed_block_idx);
+    }
+    ++_packed_block_idx;
+    _block_max_num_occs = std::max(_block_max_num_occs, _num_occs);
+}
+
 void Zc4PostingReaderBase::NoSkip::read(bool decode_interleaved_features) {
+    if (_decode_packed_doc_ids) {
+        read_packed(decode_interleaved_features);
+        return;
+    }
     assert(_zc_decoder.before_end());
     _doc_id += (_zc_decoder.decode32() + 1);
     if (decode_interleaved_features) {
         _field_length = _zc_decoder.decode32() + 1;
         _num_occs = _zc_decoder.decode32() + 1;
     }
+    _block_max_num_occs = std::max(_block_max_num_occs, _num_occs);
     _doc_id_pos = _zc_decoder.pos();
 }
 
 void Zc4PostingReaderBase::NoSkip::check_not_end(uint32_t last_doc_id) {
     assert(_doc_id < last_doc_id);
-    assert(_zc_decoder.before_end());
+    assert(_zc_decoder.before_end() || _packed_block_idx < _packed_block.size());
 }
 
-Zc4PostingReaderBase::L1Skip::L1Skip() : NoSkipBase(), _l1_skip_pos(0) {
+Zc4PostingReaderBase::L1Skip::L1Skip()
+    : NoSkipBase(), _l1_skip_pos(0), _block_max_num_occs(0), _decode_block_max(false) {
 }
 
 void Zc4PostingReaderBase::L1Skip::setup(DecodeContext& decode_context, uint32_t size, uint32_t doc_id,
@@ -104,7 +141,24 @@ void Zc4PostingReaderBase::L1Skip::check(const Zc4PostingReaderBase& rb, const s
     }
 }
 
+void Zc4PostingReaderBase::L1Skip::check_block_max(const Zc4PostingReaderBase& rb, NoSkip& no_skip) {
+    if (_decode_block_max && !_zc_buf.empty()) {
+        if (_block_max_num_occs != no_skip.get_block_max_num_occs()) {
+            LOG(error,
+                "Inconsistency in posting list file '%s', word '%s', docid %u, block max num_occs != "
+                "no_skip.get_block_max_num_occs() (%u != %u)",
+                rb._readContext.get_file_name().c_str(), rb._word.c_str(), _doc_id, _block_max_num_occs,
+                no_skip.get_block_max_num_occs());
+        }
+        assert(_block_max_num_occs == no_skip.get_block_max_num_occs());
+    }
+    no_skip.reset_block_max();
+}
+
 void Zc4PostingReaderBase::L1Skip::next_skip_entry() {
+    if (_decode_block_max) {
+        _block_max_num_occs = _zc_decoder.decode32() + 1;
+    }
     _doc_id += (_zc_decoder.decode32() + 1);
 }
 
@@ -189,6 +243,7 @@ void Zc4PostingReaderBase::read_common_word_doc_id(DecodeContext64Base& decode_c
     if (_no_skip.get_doc_id() >= _l1_skip.get_doc_id()) {
         _no_skip.set_features_pos(decode_context.getReadOffset());
         _l1_skip.check(*this, l1_name, _no_skip, true, _posting_params._encode_features);
+        _l1_skip.check_block_max(*this, _no_skip);
         if (_no_skip.get_doc_id() >= _l2_skip.get_doc_id()) {
             _l2_skip.check(*this, l2_name, _l1_skip, true, _posting_params._encode_features);
             if (_no_skip.get_doc_id() >= _l3_skip.get_doc_id()) {
@@ -206,6 +261,7 @@ void Zc4PostingReaderBase::read_common_word_doc_id(DecodeContext64Base& decode_c
     _no_skip.read(_posting_params._encode_interleaved_features);
     if (_residue == 1) {
         _no_skip.check_end(_last_doc_id);
+        _l1_skip.check_block_max(*this, _no_skip);
         _l1_skip.check_end(_last_doc_id);
         _l2_skip.check_end(_last_doc_id);
         _l3_skip.check_end(_last_doc_id);
@@ -232,7 +288,10 @@ void Zc4PostingReaderBase::read_word_start_with_skip(DecodeContext64Base&    dec
         assert(_num_docs == _counts._numDocs);
     }
     uint32_t prev_doc_id = _no_skip.get_doc_id();
+    _no_skip.set_decode_packed_doc_ids(_posting_params._encode_packed_doc_ids);
     _no_skip.setup(decode_context, header._doc_ids_size, prev_doc_id);
+    _no_skip.reset_block_max();
+    _l1_skip.set_decode_block_max(_posting_params._encode_block_max);
     _l1_skip.setup(decode_context, header._l1_skip_size, prev_doc_id, _last_doc_id);
     _l2_skip.setup(decode_context, header._l2_skip_size, prev_doc_id, _last_doc_id);
     _l3_skip.setup(decode_context, header._l3_skip_size, prev_doc_id, _last_doc_id);
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "packed_doc_id_block.h"
 #include "zc4_posting_params.h"
 #include "zc_decoder_validator.h"
 #include "zcbuf.h"
@@ -43,30 +44,44 @@ protected:
     };
     class NoSkip : public NoSkipBase {
     protected:
-        uint32_t _field_length;
-        uint32_t _num_occs;
+        uint32_t                _field_length;
+        uint32_t                _num_occs;
+        uint32_t                _block_max_num_occs; // max num_occs for documents since last L1 skip entry
+        bool                    _decode_packed_doc_ids;
+        uint32_t                _packed_block_idx;
+        PackedDocIdBlockDecoder _packed_block;
+
+        void read_packed(bool decode_interleaved_features);
 
     public:
         NoSkip();
         ~NoSkip();
+        void setup(DecodeContext& decode_context, uint32_t size, uint32_t doc_id);
         void read(bool decode_interleaved_features);
         void check_not_end(uint32_t last_doc_id);
         uint32_t get_field_length() const { return _field_length; }
         uint32_t get_num_occs() const { return _num_occs; }
+        uint32_t get_block_max_num_occs() const { return _block_max_num_occs; }
+        void reset_block_max() { _block_max_num_occs = 0; }
         void set_field_length(uint32_t field_length) { _field_length = field_length; }
         void set_num_occs(uint32_t num_occs) { _num_occs = num_occs; }
+        void set_decode_packed_doc_ids(bool decode_packed_doc_ids) { _decode_packed_doc_ids = decode_packed_doc_ids; }
     };
     // Helper class for L1 skip info
     class L1Skip : public NoSkipBase {
     protected:
         uint32_t _l1_skip_pos;
+        uint32_t _block_max_num_occs;
+        bool     _decode_block_max;
 
     public:
         L1Skip();
         void setup(DecodeContext& decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id);
         void check(const Zc4PostingReaderBase& rb, const std::string& level_name, const NoSkipBase& no_skip,
                    bool top_level, bool decode_features);
+        void check_block_max(const Zc4PostingReaderBase& rb, NoSkip& no_skip);
         void next_skip_entry();
+        void set_decode_block_max(bool decode_block_max) { _decode_block_max = decode_block_max; }
         uint32_t get_l1_skip_pos() const { return _l1_skip_pos; }
     };
     class L2Skip : public L1Skip {
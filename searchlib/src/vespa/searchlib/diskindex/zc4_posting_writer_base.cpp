@@ -3,10 +3,12 @@
 #include "zc4_posting_writer_base.h"
 
 #include "features_size_flush.h"
+#include "packed_doc_id_block.h"
 
 #include <vespa/searchlib/index/postinglistcounts.h>
 #include <vespa/searchlib/index/postinglistparams.h>
 
+#include <algorithm>
 #include <cassert>
 
 using search::index::PostingListCounts;
@@ -27,6 +29,8 @@ public:
     DocIdEncoder() : _doc_id(0u), _doc_id_pos(0u), _feature_pos(0u) {}
 
     void write(ZcBuf& zc_buf, const DocIdAndFeatureSize& doc_id_and_feature_size, bool encode_interleaved_features);
+    void write_packed(ZcBuf& zc_buf, PackedDocIdBlockEncoder& block,
+                      const DocIdAndFeatureSize& doc_id_and_feature_size, bool encode_interleaved_features);
     void set_doc_id(uint32_t doc_id) { _doc_id = doc_id; }
     uint32_t get_doc_id() const { return _doc_id; }
     uint32_t get_doc_id_pos() const { return _doc_id_pos; }
@@ -37,17 +41,27 @@ class L1SkipEncoder : public DocIdEncoder {
 protected:
     uint32_t   _stride_check;
     uint32_t   _l1_skip_pos;
+    uint32_t   _block_max_num_occs; // max num_occs for documents since last skip entry
     const bool _encode_features;
+    const bool _encode_block_max;
+
+    void encode_block_max(ZcBuf& zc_buf);
 
 public:
-    L1SkipEncoder(bool encode_features)
-        : DocIdEncoder(), _stride_check(0u), _l1_skip_pos(0u), _encode_features(encode_features) {}
+    L1SkipEncoder(bool encode_features, bool encode_block_max)
+        : DocIdEncoder(),
+          _stride_check(0u),
+          _l1_skip_pos(0u),
+          _block_max_num_occs(0u),
+          _encode_features(encode_features),
+          _encode_block_max(encode_block_max) {}
 
     void encode_skip(ZcBuf& zc_buf, const DocIdEncoder& doc_id_encoder);
     void write_skip(ZcBuf& zc_buf, const DocIdEncoder& doc_id_encoder);
     bool should_write_skip(uint32_t stride) { return ++_stride_check >= stride; }
     void dec_stride_check() { --_stride_check; }
     void write_partial_skip(ZcBuf& zc_buf, uint32_t doc_id);
+    void update_block_max(uint32_t num_occs) { _block_max_num_occs = std::max(_block_max_num_occs, num_occs); }
     uint32_t get_l1_skip_pos() const { return _l1_skip_pos; }
 };
 
@@ -56,7 +70,7 @@ protected:
     uint32_t _l2_skip_pos;
 
 public:
-    L2SkipEncoder(bool encode_features) : L1SkipEncoder(encode_features), _l2_skip_pos(0u) {}
+    L2SkipEncoder(bool encode_features) : L1SkipEncoder(encode_features, false), _l2_skip_pos(0u) {}
 
     void encode_skip(ZcBuf& zc_buf, const L1SkipEncoder& l1_skip);
     void write_skip(ZcBuf& zc_buf, const L1SkipEncoder& l1_skip);
@@ -98,6 +112,25 @@ void DocIdEncoder::write(ZcBuf& zc_buf, const DocIdAndFeatureSize& doc_id_and_fe
     _doc_id_pos = zc_buf.size();
 }
 
+void DocIdEncoder::write_packed(ZcBuf& zc_buf, PackedDocIdBlockEncoder& block,
+                                const DocIdAndFeatureSize& doc_id_and_feature_size, bool encode_interleaved_features) {
+    _feature_pos += doc_id_and_feature_size._features_size;
+    if (encode_interleaved_features) {
+        assert(doc_id_and_feature_size._field_length > 0);
+        assert(doc_id_and_feature_size._num_occs > 0);
+        block.add(doc_id_and_feature_size._doc_id - _doc_id - 1, doc_id_and_feature_size._field_length - 1,
+                  doc_id_and_feature_size._num_occs - 1);
+    } else {
+        block.add(doc_id_and_feature_size._doc_id - _doc_id - 1, 0, 0);
+    }
+    _doc_id = doc_id_and_feature_size._doc_id;
+    if (block.full()) {
+        block.flush(zc_buf);
+    }
+    // Skip entries are only written at block boundaries, where this is the position after the flushed block
+    _doc_id_pos = zc_buf.size();
+}
+
 void L1SkipEncoder::encode_skip(ZcBuf& zc_buf, const DocIdEncoder& doc_id_encoder) {
     _stride_check = 0;
     // doc id
@@ -115,13 +148,24 @@ void L1SkipEncoder::encode_skip(ZcBuf& zc_buf, const DocIdEncoder& doc_id_encode
     }
 }
 
+void L1SkipEncoder::encode_block_max(ZcBuf& zc_buf) {
+    if (_encode_block_max) {
+        // Block max is placed before the doc id to be available when the skip entry doc id is decoded
+        assert(_block_max_num_occs > 0);
+        zc_buf.encode32(_block_max_num_occs - 1);
+        _block_max_num_occs = 0;
+    }
+}
+
 void L1SkipEncoder::write_skip(ZcBuf& zc_buf, const DocIdEncoder& doc_id_encoder) {
+    encode_block_max(zc_buf);
     encode_skip(zc_buf, doc_id_encoder);
     _l1_skip_pos = zc_buf.size();
 }
 
 void L1SkipEncoder::write_partial_skip(ZcBuf& zc_buf, uint32_t doc_id) {
     if (zc_buf.size() > 0) {
+        encode_block_max(zc_buf);
         zc_buf.encode32(doc_id - _doc_id - 1);
     }
 }
@@ -172,6 +216,8 @@ Zc4PostingWriterBase::Zc4PostingWriterBase(PostingListCounts& counts)
       _writePos(0),
       _dynamicK(false),
       _encode_interleaved_features(false),
+      _encode_block_max(false),
+      _encode_packed_doc_ids(false),
       _features_size_flush_bits(256_Mi),
       _zcDocIds(),
       _l1Skip(),
@@ -193,8 +239,11 @@ Zc4PostingWriterBase::~Zc4PostingWriterBase() = default;
 #define L4SKIPSTRIDE 8
 
 void Zc4PostingWriterBase::calc_skip_info(bool encode_features) {
-    DocIdEncoder  doc_id_encoder;
-    L1SkipEncoder l1_skip_encoder(encode_features);
+    DocIdEncoder            doc_id_encoder;
+    PackedDocIdBlockEncoder packed_block(_encode_interleaved_features);
+    // With packed doc ids, each L1 skip entry points to the start of a block
+    const uint32_t l1_skip_stride = _encode_packed_doc_ids ? PackedDocIdBlock::block_size : L1SKIPSTRIDE;
+    L1SkipEncoder l1_skip_encoder(encode_features, get_encode_block_max());
     L2SkipEncoder l2_skip_encoder(encode_features);
     L3SkipEncoder l3_skip_encoder(encode_features);
     L4SkipEncoder l4_skip_encoder(encode_features);
@@ -208,7 +257,7 @@ void Zc4PostingWriterBase::calc_skip_info(bool encode_features) {
         l4_skip_encoder.set_doc_id(doc_id);
     }
     for (const auto& doc_id_and_feature_size : _docIds) {
-        if (l1_skip_encoder.should_write_skip(L1SKIPSTRIDE)) {
+        if (l1_skip_encoder.should_write_skip(l1_skip_stride)) {
             l1_skip_encoder.write_skip(_l1Skip, doc_id_encoder);
             if (l2_skip_encoder.should_write_skip(L2SKIPSTRIDE)) {
                 l2_skip_encoder.write_skip(_l2Skip, l1_skip_encoder);
@@ -220,7 +269,16 @@ void Zc4PostingWriterBase::calc_skip_info(bool encode_features) {
                 }
             }
         }
-        doc_id_encoder.write(_zcDocIds, doc_id_and_feature_size, _encode_interleaved_features);
+        if (_encode_packed_doc_ids) {
+            doc_id_encoder.write_packed(_zcDocIds, packed_block, doc_id_and_feature_size,
+                                        _encode_interleaved_features);
+        } else {
+            doc_id_encoder.write(_zcDocIds, doc_id_and_feature_size, _encode_interleaved_features);
+        }
+        l1_skip_encoder.update_block_max(doc_id_and_feature_size._num_occs);
+    }
+    if (!packed_block.empty()) {
+        packed_block.flush(_zcDocIds);
     }
     // Extra partial entries for skip tables to simplify iterator during search
     l1_skip_encoder.write_partial_skip(_l1Skip, doc_id_encoder.get_doc_id());
@@ -242,6 +300,8 @@ void Zc4PostingWriterBase::set_posting_list_params(const PostingListParams& para
     params.get("minChunkDocs", _minChunkDocs);
     params.get("minSkipDocs", _minSkipDocs);
     params.get("interleaved_features", _encode_interleaved_features);
+    params.get("block_max_features", _encode_block_max);
+    params.get("packed_doc_ids", _encode_packed_doc_ids);
     params.get(tags::FEATURES_SIZE_FLUSH_BITS, _features_size_flush_bits);
 }
 
@@ -23,6 +23,7 @@ public:
     ZcDecoder(const uint8_t* cur) noexcept : _cur(cur) {}
 
     void set_cur(const uint8_t* cur) noexcept { _cur = cur; }
+    const uint8_t* get_cur() const noexcept { return _cur; }
 
     uint64_t decode42() noexcept {
         const uint8_t* cur = _cur;
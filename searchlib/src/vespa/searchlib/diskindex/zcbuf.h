@@ -40,6 +40,7 @@ public:
     size_t size() const { return _buffer.size(); }
 
     void encode32(uint32_t num) { internal_encode(num); }
+    void write_byte(uint8_t byte) { _buffer.push_back(byte); }
 
     void encode42(uint64_t num) {
         assert(num <= encode42_max);
@@ -85,15 +85,21 @@ std::unique_ptr<search::queryeval::SearchIterator> create_zc_posocc_iterator(
         }
     } else {
         if (posting_params._dynamic_k) {
-            return std::make_unique<ZcPosOccIterator<bigEndian, true>>(
+            auto itr = std::make_unique<ZcPosOccIterator<bigEndian, true>>(
                 start, bit_length, posting_params._doc_id_limit, posting_params._encode_features,
                 posting_params._encode_interleaved_features, unpack_normal_features, unpack_interleaved_features,
                 posting_params._min_chunk_docs, counts, &fields_params, std::move(match_data));
+            itr->set_decode_block_max(posting_params._encode_block_max);
+            itr->set_decode_packed_doc_ids(posting_params._encode_packed_doc_ids);
+            return itr;
         } else {
-            return std::make_unique<ZcPosOccIterator<bigEndian, false>>(
+            auto itr = std::make_unique<ZcPosOccIterator<bigEndian, false>>(
                 start, bit_length, posting_params._doc_id_limit, posting_params._encode_features,
                 posting_params._encode_interleaved_features, unpack_normal_features, unpack_interleaved_features,
                 posting_params._min_chunk_docs, counts, &fields_params, std::move(match_data));
+            itr->set_decode_block_max(posting_params._encode_block_max);
+            itr->set_decode_packed_doc_ids(posting_params._encode_packed_doc_ids);
+            return itr;
         }
     }
 }
@@ -35,6 +35,8 @@ namespace {
 std::string myId4("Zc.4");
 std::string myId5("Zc.5");
 std::string interleaved_features("interleaved_features");
+std::string block_max_features("block_max_features");
+std::string packed_doc_ids("packed_doc_ids");
 
 PostingListFileRange get_file_range(const DictionaryLookupResult& lookup_result, uint64_t header_bit_size) {
     uint64_t start_offset = (lookup_result.bitOffset + header_bit_size) >> 3;
@@ -134,6 +136,14 @@ PostingListHandle ZcPosOccRandRead::read_posting_list(const DictionaryLookupResu
     return handle;
 }
 
+void ZcPosOccRandRead::prefetch_posting_list(const DictionaryLookupResult& lookup_result) const {
+    if (lookup_result.counts._bitLength == 0) {
+        return;
+    }
+    auto file_range = get_file_range(lookup_result, _headerBitSize);
+    _file->willNeed(file_range.start_offset, file_range.size() + decode_prefetch_size);
+}
+
 void ZcPosOccRandRead::consider_trim_posting_list(const DictionaryLookupResult& lookup_result,
                                                   PostingListHandle& handle, double bloat_factor) const {
     if (lookup_result.counts._bitLength == 0 || _memoryMapped) {
@@ -228,6 +238,12 @@ template <typename DecodeContext> void ZcPosOccRandRead::readHeader(const std::s
     if (header.hasTag(interleaved_features) && (header.getTag(interleaved_features).asInteger() != 0)) {
         _posting_params._encode_interleaved_features = true;
     }
+    if (header.hasTag(block_max_features) && (header.getTag(block_max_features).asInteger() != 0)) {
+        _posting_params._encode_block_max = true;
+    }
+    if (header.hasTag(packed_doc_ids) && (header.getTag(packed_doc_ids).asInteger() != 0)) {
+        _posting_params._encode_packed_doc_ids = true;
+    }
     // Read feature decoding specific subheader
     d.readHeader(header, "features.");
     // Align on 64-bit unit
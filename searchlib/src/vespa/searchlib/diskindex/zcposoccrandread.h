@@ -47,6 +47,7 @@ public:
      * Read (possibly partial) posting list into handle.
      */
     PostingListHandle read_posting_list(const DictionaryLookupResult& lookup_result) override;
+    void prefetch_posting_list(const DictionaryLookupResult& lookup_result) const override;
     void consider_trim_posting_list(const DictionaryLookupResult& lookup_result, PostingListHandle& handle,
                                     double bloat_factor) const override;
     PostingListFileRange get_posting_list_file_range(const DictionaryLookupResult& lookup_result) const override;
@@ -20,6 +20,8 @@ namespace {
 std::string myId5("Zc.5");
 std::string myId4("Zc.4");
 std::string interleaved_features("interleaved_features");
+std::string block_max_features("block_max_features");
+std::string packed_doc_ids("packed_doc_ids");
 
 } // namespace
 
@@ -101,6 +103,8 @@ void Zc4PostingSeqRead::getParams(PostingListParams& params) {
     }
     params.set("minSkipDocs", _reader.get_posting_params()._min_skip_docs);
     params.set(interleaved_features, _reader.get_posting_params()._encode_interleaved_features);
+    params.set(block_max_features, _reader.get_posting_params()._encode_block_max);
+    params.set(packed_doc_ids, _reader.get_posting_params()._encode_packed_doc_ids);
 }
 
 void Zc4PostingSeqRead::getFeatureParams(PostingListParams& params) {
@@ -141,6 +145,12 @@ void Zc4PostingSeqRead::readHeader() {
     if (header.hasTag(interleaved_features) && (header.getTag(interleaved_features).asInteger() != 0)) {
         posting_params._encode_interleaved_features = true;
     }
+    if (header.hasTag(block_max_features) && (header.getTag(block_max_features).asInteger() != 0)) {
+        posting_params._encode_block_max = true;
+    }
+    if (header.hasTag(packed_doc_ids) && (header.getTag(packed_doc_ids).asInteger() != 0)) {
+        posting_params._encode_packed_doc_ids = true;
+    }
     assert(header.getTag("endian").asString() == "big");
     // Read feature decoding specific subheader
     d.readHeader(header, "features.");
@@ -188,6 +198,8 @@ void Zc4PostingSeqWrite::makeHeader(const FileHeaderContext& fileHeaderContext)
     header.putTag(Tag("format.0", myId));
     header.putTag(Tag("format.1", f.getIdentifier()));
     header.putTag(Tag("interleaved_features", _writer.get_encode_interleaved_features() ? 1 : 0));
+    header.putTag(Tag("block_max_features", _writer.get_encode_block_max() ? 1 : 0));
+    header.putTag(Tag("packed_doc_ids", _writer.get_encode_packed_doc_ids() ? 1 : 0));
     header.putTag(Tag("numWords", 0));
     header.putTag(Tag("minChunkDocs", _writer.get_min_chunk_docs()));
     header.putTag(Tag("docIdLimit", _writer.get_docid_limit()));
@@ -291,6 +303,8 @@ void Zc4PostingSeqWrite::getParams(PostingListParams& params) {
     }
     params.set("minSkipDocs", _writer.get_min_skip_docs());
     params.set(interleaved_features, _writer.get_encode_interleaved_features());
+    params.set(block_max_features, _writer.get_encode_block_max());
+    params.set(packed_doc_ids, _writer.get_encode_packed_doc_ids());
 }
 
 void Zc4PostingSeqWrite::setFeatureParams(const PostingListParams& params) {
@@ -188,6 +188,7 @@ ZcPostingIteratorBase::ZcPostingIteratorBase(TermFieldMatchDataArray matchData,
       _l2(),
       _l3(),
       _l4(),
+      _block_max_l1(),
       _chunk(),
       _featuresSize(0),
       _hasMore(false),
@@ -197,7 +198,10 @@ ZcPostingIteratorBase::ZcPostingIteratorBase(TermFieldMatchDataArray matchData,
       _unpack_interleaved_features(unpack_interleaved_features),
       _chunkNo(0),
       _field_length(0),
-      _num_occs(0) {
+      _num_occs(0),
+      _decode_packed_doc_ids(false),
+      _packed_block_idx(0),
+      _packed_block() {
 }
 
 template <bool bigEndian>
@@ -306,6 +310,7 @@ template <bool bigEndian> void ZcPostingIterator<bigEndian>::readWordStart(uint3
     _l2.postSetup(_l1);
     _l3.postSetup(_l2);
     _l4.postSetup(_l3);
+    _block_max_l1 = _l1;
     d.setByteCompr(bcompr);
     _hasMore = hasMore;
     // Save information about start of next chunk
@@ -490,10 +495,34 @@ void ZcPostingIteratorBase::doL1SkipSeek(uint32_t docId) {
     clearUnpacked();
 }
 
+void ZcPostingIteratorBase::do_packed_seek(uint32_t docId) {
+    if (getDocId() >= docId) {
+        return;
+    }
+    uint32_t idx = _packed_block_idx;
+    uint32_t skipped = 0;
+    for (;;) {
+        uint32_t next_idx = _packed_block.seek(idx, docId);
+        skipped += next_idx - idx;
+        if (next_idx < _packed_block.size()) [[likely]] {
+            idx = next_idx;
+            break;
+        }
+        next_packed_block(_packed_block.doc_id(next_idx - 1));
+        idx = 0;
+    }
+    addNeedUnpack(skipped);
+    set_packed_doc(idx);
+}
+
 void ZcPostingIteratorBase::doSeek(uint32_t docId) {
     if (docId > _l1._skipDocId) {
         doL1SkipSeek(docId);
     }
+    if (_decode_packed_doc_ids) {
+        do_packed_seek(docId);
+        return;
+    }
     uint32_t oDocId = getDocId();
 #if DEBUG_ZCPOSTING_ASSERT
     assert(oDocId <= _l1._skipDocId);
@@ -534,6 +563,27 @@ void ZcPostingIteratorBase::doSeek(uint32_t docId) {
     return;
 }
 
+queryeval::IBlockMaxIterator::BlockInfo ZcPostingIteratorBase::get_block_info(uint32_t doc_id) {
+    if (doc_id <= _l1._skipDocId) {
+        return {_l1._skipDocId, _l1._block_max_num_occs};
+    }
+    if (doc_id > _chunk._lastDocId) {
+        if (_hasMore) {
+            // Skip info for next chunk is not available yet
+            return {doc_id, unknown_max_num_occs};
+        }
+        return {search::endDocId - 1, 0u};
+    }
+    if (_block_max_l1._skipDocId < _l1._skipDocId) {
+        _block_max_l1 = _l1;
+    }
+    while (doc_id > _block_max_l1._skipDocId) {
+        _block_max_l1.decodeSkipEntry(_decode_normal_features);
+        _block_max_l1.nextDocId();
+    }
+    return {_block_max_l1._skipDocId, _block_max_l1._block_max_num_occs};
+}
+
 template <bool bigEndian> void ZcPostingIterator<bigEndian>::doUnpack(uint32_t docId) {
     if (!_matchData.valid()) {
         return;
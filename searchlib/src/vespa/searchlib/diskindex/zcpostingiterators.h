@@ -2,10 +2,12 @@
 
 #pragma once
 
+#include "packed_doc_id_block.h"
 #include "zc_decoder.h"
 
 #include <vespa/searchlib/bitcompression/compression.h>
 #include <vespa/searchlib/index/postinglistfile.h>
+#include <vespa/searchlib/queryeval/i_block_max_iterator.h>
 #include <vespa/searchlib/queryeval/iterators.h>
 
 namespace search::diskindex {
@@ -26,7 +28,8 @@ private:
     Position _start;
 };
 
-template <bool bigEndian> class ZcRareWordPostingIteratorBase : public ZcIteratorBase {
+template <bool bigEndian>
+class ZcRareWordPostingIteratorBase : public ZcIteratorBase, public queryeval::IBlockMaxIterator {
 private:
     using ParentClass = ZcIteratorBase;
 
@@ -50,6 +53,12 @@ public:
 
     void doUnpack(uint32_t docId) override;
     void rewind(Position start) override;
+    // No skip info, only the number of occurrences for the current document is available
+    bool has_block_max_info() const noexcept override { return false; }
+    BlockInfo get_block_info(uint32_t) override { return {search::endDocId - 1, unknown_max_num_occs}; }
+    uint32_t get_num_occs() const noexcept override {
+        return _decode_interleaved_features ? _num_occs : unknown_max_num_occs;
+    }
 };
 
 template <bool dynamic_k> class ZcPostingDocIdKParam;
@@ -100,7 +109,7 @@ public:
     void readWordStart(uint32_t docIdLimit) override;
 };
 
-class ZcPostingIteratorBase : public ZcIteratorBase {
+class ZcPostingIteratorBase : public ZcIteratorBase, public queryeval::IBlockMaxIterator {
 protected:
     ZcDecoder      _zc_decoder;       // docid deltas
     const uint8_t* _zc_decoder_start; // start of docid deltas
@@ -114,17 +123,28 @@ protected:
         const uint8_t* _docIdPos;
         uint64_t       _skipFeaturePos;
         const uint8_t* _zc_decoder_start;
-
-        L1Skip() : _skipDocId(0), _zc_decoder(), _docIdPos(nullptr), _skipFeaturePos(0), _zc_decoder_start(nullptr) {}
+        uint32_t       _block_max_num_occs; // max num_occs for block ending at _skipDocId
+        bool           _decode_block_max;   // only set for L1 skip info
+
+        L1Skip()
+            : _skipDocId(0),
+              _zc_decoder(),
+              _docIdPos(nullptr),
+              _skipFeaturePos(0),
+              _zc_decoder_start(nullptr),
+              _block_max_num_occs(unknown_max_num_occs),
+              _decode_block_max(false) {}
 
         void setup(uint32_t prevDocId, uint32_t lastDocId, const uint8_t*& bcompr, uint32_t skipSize) {
             if (skipSize != 0) {
                 _zc_decoder.set_cur(_zc_decoder_start = bcompr);
                 bcompr += skipSize;
-                _skipDocId = prevDocId + 1 + _zc_decoder.decode32();
+                _skipDocId = prevDocId;
+                nextDocId();
             } else {
                 _zc_decoder.set_cur(_zc_decoder_start = nullptr);
                 _skipDocId = lastDocId;
+                _block_max_num_occs = unknown_max_num_occs;
             }
             _skipFeaturePos = 0;
         }
@@ -135,7 +155,12 @@ protected:
                 _skipFeaturePos += (1 + _zc_decoder.decode42());
             }
         }
-        void nextDocId() { _skipDocId += (1 + _zc_decoder.decode32()); }
+        void nextDocId() {
+            if (_decode_block_max) {
+                _block_max_num_occs = 1 + _zc_decoder.decode32();
+            }
+            _skipDocId += (1 + _zc_decoder.decode32());
+        }
     };
 
     // Helper class for L2 skip info
@@ -205,6 +230,7 @@ protected:
     L2Skip    _l2;
     L3Skip    _l3;
     L4Skip    _l4;
+    L1Skip    _block_max_l1; // Separate L1 skip cursor for block max lookups, ahead of _l1
     ChunkSkip _chunk;
     uint64_t  _featuresSize;
     bool      _hasMore;
@@ -216,7 +242,28 @@ protected:
     uint32_t  _field_length;
     uint32_t  _num_occs;
 
+    bool                    _decode_packed_doc_ids;
+    uint32_t                _packed_block_idx; // Index of current document in _packed_block
+    PackedDocIdBlockDecoder _packed_block;     // Current block when doc ids are packed
+
+    void set_packed_doc(uint32_t idx) {
+        _packed_block_idx = idx;
+        setDocId(_packed_block.doc_id(idx));
+        if (_decode_interleaved_features) {
+            _field_length = _packed_block.field_length(idx);
+            _num_occs = _packed_block.num_occs(idx);
+        }
+    }
+    void next_packed_block(uint32_t prevDocId) {
+        _zc_decoder.set_cur(_packed_block.decode(_zc_decoder.get_cur(), prevDocId, _decode_interleaved_features));
+    }
     void nextDocId(uint32_t prevDocId) {
+        if (_decode_packed_doc_ids) {
+            // Skip info and start of chunk always refer to the start of a block
+            next_packed_block(prevDocId);
+            set_packed_doc(0);
+            return;
+        }
         uint32_t docId = prevDocId + 1 + _zc_decoder.decode32();
         setDocId(docId);
         if (_decode_interleaved_features) {
@@ -230,12 +277,20 @@ protected:
     VESPA_DLL_LOCAL void doL3SkipSeek(uint32_t docId);
     VESPA_DLL_LOCAL void doL2SkipSeek(uint32_t docId);
     VESPA_DLL_LOCAL void doL1SkipSeek(uint32_t docId);
+    VESPA_DLL_LOCAL void do_packed_seek(uint32_t docId);
     void doSeek(uint32_t docId) override;
 
 public:
     ZcPostingIteratorBase(fef::TermFieldMatchDataArray matchData, Position start, uint32_t docIdLimit,
                           bool decode_normal_features, bool decode_interleaved_features, bool unpack_normal_features,
                           bool unpack_interleaved_features);
+    void set_decode_block_max(bool decode_block_max) { _l1._decode_block_max = decode_block_max; }
+    void set_decode_packed_doc_ids(bool decode_packed_doc_ids) { _decode_packed_doc_ids = decode_packed_doc_ids; }
+    bool has_block_max_info() const noexcept override { return _l1._decode_block_max; }
+    BlockInfo get_block_info(uint32_t doc_id) override;
+    uint32_t get_num_occs() const noexcept override {
+        return _decode_interleaved_features ? _num_occs : unknown_max_num_occs;
+    }
 };
 
 template <bool bigEndian> class ZcPostingIterator : public ZcPostingIteratorBase {
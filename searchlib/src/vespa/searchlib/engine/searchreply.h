@@ -94,7 +94,7 @@ public:
 
     SearchReply();
     ~SearchReply();
-    SearchReply(const SearchReply& rhs); // for test only
+    SearchReply(const SearchReply& rhs); // request and issues are not copied
 
     void setDistributionKey(uint32_t key) { _distributionKey = key; }
     uint32_t getDistributionKey() const { return _distributionKey; }
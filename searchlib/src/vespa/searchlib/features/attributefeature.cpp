@@ -18,6 +18,8 @@
 #include <vespa/searchlib/tensor/direct_tensor_attribute.h>
 #include <vespa/vespalib/util/issue.h>
 
+#include <algorithm>
+
 #include <vespa/log/log.h>
 LOG_SETUP(".features.attributefeature");
 
@@ -86,6 +88,12 @@ template <> feature_t considerUndefined<ConstCharPtr>(ConstCharPtr value, BasicT
     return util::getAsFeature(value);
 }
 
+template <typename T> feature_t read_single_attribute(const void* attribute, uint32_t docId) {
+    typename T::LoadedValueType v = static_cast<const T*>(attribute)->getFast(docId);
+    return __builtin_expect(attribute::isUndefined(v), false) ? attribute::getUndefined<feature_t>()
+                                                              : util::getAsFeature(v);
+}
+
 /**
  * Implements the executor for fetching values from a single or array attribute vector
  */
@@ -100,6 +108,7 @@ public:
      * @param attribute The attribute vector to use.
      */
     explicit SingleAttributeExecutor(const T& attribute) : _attribute(attribute) {}
+    const T& get_attribute() const noexcept { return _attribute; }
     void handle_bind_outputs(std::span<fef::NumberOrObject> outputs_in) override {
         fef::FeatureExecutor::handle_bind_outputs(outputs_in);
         auto o = outputs().get_bound();
@@ -108,6 +117,9 @@ public:
         o[3].as_number = 1; // count
     }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(std::span<const uint32_t> docids, std::span<const feature_t* const> inputs,
+                       std::span<feature_t* const> outputs) override;
 };
 
 class BoolAttributeExecutor final : public fef::FeatureExecutor {
@@ -117,6 +129,13 @@ private:
 public:
     explicit BoolAttributeExecutor(const IAttributeVector& attribute) : _attribute(attribute) {}
     void execute(uint32_t docId) override { outputs().set_number(0, _attribute.getFloat(docId)); }
+    bool supports_batch() const override { return true; }
+    void execute_batch(std::span<const uint32_t> docids, std::span<const feature_t* const>,
+                       std::span<feature_t* const> out) override {
+        for (size_t i = 0; i < docids.size(); ++i) {
+            out[0][i] = _attribute.getFloat(docids[i]);
+        }
+    }
 };
 
 /**
@@ -207,11 +226,21 @@ public:
 };
 
 template <typename T> void SingleAttributeExecutor<T>::execute(uint32_t docId) {
-    typename T::LoadedValueType v = _attribute.getFast(docId);
-    // value
     auto o = outputs().get_bound();
-    o[0].as_number = __builtin_expect(attribute::isUndefined(v), false) ? attribute::getUndefined<feature_t>()
-                                                                        : util::getAsFeature(v);
+    o[0].as_number = read_single_attribute<T>(&_attribute, docId); // value
+}
+
+template <typename T>
+void SingleAttributeExecutor<T>::execute_batch(std::span<const uint32_t> docids, std::span<const feature_t* const>,
+                                               std::span<feature_t* const> out) {
+    for (size_t i = 0; i < docids.size(); ++i) {
+        out[0][i] = read_single_attribute<T>(&_attribute, docids[i]);
+    }
+    // weight, contains and count are the same for all documents
+    auto o = outputs().get_bound();
+    for (size_t idx = 1; idx < out.size(); ++idx) {
+        std::fill_n(out[idx], docids.size(), o[idx].as_number);
+    }
 }
 
 template <typename BaseType> void ArrayAttributeExecutor<BaseType>::execute(uint32_t docId) {
@@ -447,8 +476,28 @@ bool isSingleValueBoolField(const fef::FieldInfo& fInfo) {
            (fInfo.get_data_type() == schema::DataType::BOOL);
 }
 
+template <typename T>
+std::optional<SingleAttributeReader> try_make_single_attribute_reader(const FeatureExecutor& executor) {
+    using AttrType = SingleValueNumericAttribute<T>;
+    if (auto single = dynamic_cast<const SingleAttributeExecutor<AttrType>*>(&executor)) {
+        return SingleAttributeReader{&single->get_attribute(), read_single_attribute<AttrType>};
+    }
+    return std::nullopt;
+}
+
 } // namespace
 
+std::optional<SingleAttributeReader> make_single_attribute_reader(const FeatureExecutor& executor) {
+    std::optional<SingleAttributeReader> reader;
+    if (!(reader = try_make_single_attribute_reader<IntegerAttributeTemplate<int8_t>>(executor)) &&
+        !(reader = try_make_single_attribute_reader<IntegerAttributeTemplate<int32_t>>(executor)) &&
+        !(reader = try_make_single_attribute_reader<IntegerAttributeTemplate<int64_t>>(executor)) &&
+        !(reader = try_make_single_attribute_reader<FloatingPointAttributeTemplate<float>>(executor))) {
+        reader = try_make_single_attribute_reader<FloatingPointAttributeTemplate<double>>(executor);
+    }
+    return reader;
+}
+
 AttributeBlueprint::AttributeBlueprint()
     : fef::Blueprint("attribute"),
       _attrName(),
@@ -5,8 +5,29 @@
 #include <vespa/eval/eval/value_type.h>
 #include <vespa/searchlib/fef/blueprint.h>
 
+#include <optional>
+
 namespace search::features {
 
+/**
+ * Reads the value output of an attribute feature for a single value
+ * numeric attribute directly from attribute memory, without running
+ * the executor or touching its outputs.
+ */
+struct SingleAttributeReader {
+    using ReadFunction = feature_t (*)(const void* attribute, uint32_t docid);
+    const void*  attribute;
+    ReadFunction read;
+    feature_t operator()(uint32_t docid) const { return read(attribute, docid); }
+};
+
+/**
+ * Returns a reader for the given executor if it is an attribute
+ * executor for a single value numeric attribute, or nullopt otherwise
+ * (including when the executor is wrapped, e.g. to apply overrides).
+ */
+std::optional<SingleAttributeReader> make_single_attribute_reader(const fef::FeatureExecutor& executor);
+
 /**
  * Implements the blueprint for the attribute executor.
  *
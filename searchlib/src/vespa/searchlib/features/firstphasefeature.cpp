@@ -7,6 +7,8 @@
 #include <vespa/searchlib/fef/properties.h>
 #include <vespa/vespalib/util/stash.h>
 
+#include <algorithm>
+
 using namespace search::fef;
 
 namespace search::features {
@@ -15,7 +17,12 @@ void FirstPhaseExecutor::execute(uint32_t) {
     outputs().set_number(0, inputs().get_number(0));
 }
 
-FirstPhaseBlueprint::FirstPhaseBlueprint() : Blueprint("firstPhase") {
+void FirstPhaseExecutor::execute_batch(std::span<const uint32_t> docids, std::span<const feature_t* const> in,
+                                       std::span<feature_t* const> out) {
+    std::copy_n(in[0], docids.size(), out[0]);
+}
+
+FirstPhaseBlueprint::FirstPhaseBlueprint() : Blueprint("firstPhase"), _is_number(true) {
     // empty
 }
 
@@ -33,6 +40,7 @@ bool FirstPhaseBlueprint::setup(const IIndexEnvironment& env, const ParameterLis
             defineInput(indexproperties::rank::FirstPhase::lookup(env.getProperties()), AcceptInput::ANY))
     {
         describeOutput("score", "The ranking score for first phase.", maybe_input.value());
+        _is_number = !maybe_input.value().is_object();
         return true;
     } else {
         return false;
@@ -40,7 +48,7 @@ bool FirstPhaseBlueprint::setup(const IIndexEnvironment& env, const ParameterLis
 }
 
 FeatureExecutor& FirstPhaseBlueprint::createExecutor(const IQueryEnvironment&, vespalib::Stash& stash) const {
-    return stash.create<FirstPhaseExecutor>();
+    return stash.create<FirstPhaseExecutor>(_is_number);
 }
 
 } // namespace search::features
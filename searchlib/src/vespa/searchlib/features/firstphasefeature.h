@@ -10,15 +10,25 @@ namespace search::features {
  * Implements the executor outputting the first phase ranking.
  */
 class FirstPhaseExecutor : public fef::FeatureExecutor {
+private:
+    bool _is_number;
+
 public:
+    explicit FirstPhaseExecutor(bool is_number) : _is_number(is_number) {}
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return _is_number; }
+    void execute_batch(std::span<const uint32_t> docids, std::span<const feature_t* const> inputs,
+                       std::span<feature_t* const> outputs) override;
 };
 
 /**
  * Implements the blueprint for the first phase feature.
  */
 class FirstPhaseBlueprint : public fef::Blueprint {
+private:
+    bool _is_number;
+
 public:
     FirstPhaseBlueprint();
     void visitDumpFeatures(const fef::IIndexEnvironment& env, fef::IDumpFeatureVisitor& visitor) const override;
@@ -0,0 +1,285 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "internal_max_sim_feature.h"
+
+#include "valuefeature.h"
+
+#include <vespa/eval/eval/int8float.h>
+#include <vespa/eval/eval/value.h>
+#include <vespa/searchcommon/attribute/iattributevector.h>
+#include <vespa/searchlib/fef/featureexecutor.h>
+#include <vespa/searchlib/fef/indexproperties.h>
+#include <vespa/searchlib/fef/properties.h>
+#include <vespa/searchlib/tensor/i_tensor_attribute.h>
+#include <vespa/searchlib/tensor/vector_bundle.h>
+#include <vespa/vespalib/hwaccelerated/functions.h>
+#include <vespa/vespalib/util/bfloat16.h>
+#include <vespa/vespalib/util/issue.h>
+#include <vespa/vespalib/util/stash.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace search::fef;
+using search::fef::indexproperties::type::Attribute;
+using search::tensor::ITensorAttribute;
+using vespalib::BFloat16;
+using vespalib::Issue;
+using vespalib::eval::CellType;
+using vespalib::eval::get_cell_type;
+using vespalib::eval::Int8Float;
+using vespalib::eval::TypedCells;
+using vespalib::eval::Value;
+using vespalib::eval::ValueType;
+
+namespace search::features {
+
+namespace {
+
+const double* cast(const double* p) noexcept {
+    return p;
+}
+const float* cast(const float* p) noexcept {
+    return p;
+}
+const BFloat16* cast(const BFloat16* p) noexcept {
+    return p;
+}
+const int8_t* cast(const Int8Float* p) noexcept {
+    return reinterpret_cast<const int8_t*>(p);
+}
+
+template <typename CT> double dot_product(const CT* a, const CT* b, size_t size) noexcept {
+    return vespalib::hwaccelerated::dot_product(cast(a), cast(b), size);
+}
+
+template <typename CT, typename ST> void convert(std::span<const ST> src, CT* dst) noexcept {
+    for (size_t i = 0; i < src.size(); ++i) {
+        dst[i] = static_cast<CT>(src[i]);
+    }
+}
+
+// Converts 'count' cells starting at 'offset' to the computation cell type
+template <typename CT> void convert(TypedCells cells, size_t offset, size_t count, CT* dst) noexcept {
+    switch (cells.type) {
+    case CellType::DOUBLE:
+        return convert(cells.unsafe_typify<double>().subspan(offset, count), dst);
+    case CellType::FLOAT:
+        return convert(cells.unsafe_typify<float>().subspan(offset, count), dst);
+    case CellType::BFLOAT16:
+        return convert(cells.unsafe_typify<BFloat16>().subspan(offset, count), dst);
+    case CellType::INT8:
+        return convert(cells.unsafe_typify<Int8Float>().subspan(offset, count), dst);
+    }
+}
+
+/**
+ * Calculates the sum over all query vectors of the max dot product
+ * with any document vector. CT is the cell type used for the dot
+ * products. Query cells are converted once per query. Document cells
+ * of another type are converted block by block into a buffer owned
+ * by the executor, so nothing is allocated per document. Each block
+ * of document vectors is matched against all query vectors while it
+ * is hot in the cache.
+ */
+template <typename CT> class MaxSimExecutor final : public FeatureExecutor {
+    static constexpr size_t block_size = 16;
+    const ITensorAttribute& _attribute;
+    const size_t            _vector_size;
+    const size_t            _num_query_vectors;
+    std::vector<CT>         _query;
+    std::vector<double>     _max;
+    std::vector<CT>         _block;
+
+    const CT* get_block(TypedCells cells, size_t first, size_t count) noexcept {
+        size_t offset = first * _vector_size;
+        if (cells.type == get_cell_type<CT>()) {
+            return cells.unsafe_typify<CT>().data() + offset;
+        }
+        if constexpr (std::is_same_v<CT, float> || std::is_same_v<CT, double>) {
+            convert(cells, offset, count * _vector_size, _block.data());
+        }
+        return _block.data();
+    }
+
+public:
+    MaxSimExecutor(const ITensorAttribute& attribute, TypedCells query, size_t vector_size)
+        : _attribute(attribute),
+          _vector_size(vector_size),
+          _num_query_vectors(query.size / vector_size),
+          _query(_num_query_vectors * vector_size),
+          _max(_num_query_vectors),
+          _block(block_size * vector_size) {
+        if (query.type == get_cell_type<CT>()) {
+            auto cells = query.unsafe_typify<CT>();
+            std::copy(cells.begin(), cells.begin() + _query.size(), _query.begin());
+        } else if constexpr (std::is_same_v<CT, float> || std::is_same_v<CT, double>) {
+            convert(query, 0, _query.size(), _query.data());
+        }
+    }
+
+    void execute(uint32_t docid) override {
+        std::fill(_max.begin(), _max.end(), std::numeric_limits<double>::lowest());
+        bool found = false;
+        auto vectors = _attribute.get_vectors(docid);
+        for (uint32_t subspace = 0; subspace < vectors.subspaces(); ++subspace) {
+            TypedCells cells = vectors.cells(subspace);
+            size_t     num_doc_vectors = cells.size / _vector_size;
+            for (size_t first = 0; first < num_doc_vectors; first += block_size) {
+                size_t    count = std::min(block_size, num_doc_vectors - first);
+                const CT* block = get_block(cells, first, count);
+                for (size_t q = 0; q < _num_query_vectors; ++q) {
+                    const CT* query = _query.data() + q * _vector_size;
+                    double    max = _max[q];
+                    for (size_t d = 0; d < count; ++d) {
+                        max = std::max(max, dot_product(query, block + d * _vector_size, _vector_size));
+                    }
+                    _max[q] = max;
+                }
+                found = true;
+            }
+        }
+        double result = 0.0;
+        if (found) {
+            for (double max : _max) {
+                result += max;
+            }
+        }
+        outputs().set_number(0, result);
+    }
+};
+
+// Dot products are calculated in the common cell type when query and
+// document cell types are equal, otherwise in float (or double if
+// either side is double).
+FeatureExecutor& create_executor(const ITensorAttribute& attribute, TypedCells query, size_t vector_size,
+                                 vespalib::Stash& stash) {
+    CellType doc_cell_type = attribute.getTensorType().cell_type();
+    if (query.type == doc_cell_type) {
+        switch (doc_cell_type) {
+        case CellType::DOUBLE:
+            return stash.create<MaxSimExecutor<double>>(attribute, query, vector_size);
+        case CellType::FLOAT:
+            return stash.create<MaxSimExecutor<float>>(attribute, query, vector_size);
+        case CellType::BFLOAT16:
+            return stash.create<MaxSimExecutor<BFloat16>>(attribute, query, vector_size);
+        case CellType::INT8:
+            return stash.create<MaxSimExecutor<Int8Float>>(attribute, query, vector_size);
+        }
+    }
+    if ((query.type == CellType::DOUBLE) || (doc_cell_type == CellType::DOUBLE)) {
+        return stash.create<MaxSimExecutor<double>>(attribute, query, vector_size);
+    }
+    return stash.create<MaxSimExecutor<float>>(attribute, query, vector_size);
+}
+
+// The type must have an outer (token) dimension and an inner indexed
+// (vector) dimension, with the cells of each vector stored
+// contiguously.
+bool is_vector_list(const ValueType& type, const std::string& outer, const std::string& inner) {
+    size_t npos = ValueType::Dimension::npos;
+    size_t outer_idx = type.dimension_index(outer);
+    size_t inner_idx = type.dimension_index(inner);
+    if ((type.dimensions().size() != 2) || (outer_idx == npos) || (inner_idx == npos)) {
+        return false;
+    }
+    const auto& inner_dim = type.dimensions()[inner_idx];
+    if (!inner_dim.is_indexed() || inner_dim.is_trivial()) {
+        return false;
+    }
+    return type.dimensions()[outer_idx].is_mapped() || (inner_idx > outer_idx);
+}
+
+} // namespace
+
+InternalMaxSimBlueprint::InternalMaxSimBlueprint()
+    : Blueprint("internalMaxSim"),
+      _attribute(),
+      _attrKey(),
+      _attrType(ValueType::error_type()),
+      _queryValue(),
+      _defaultQueryValue(),
+      _vectorSize(0) {
+}
+
+InternalMaxSimBlueprint::~InternalMaxSimBlueprint() = default;
+
+void InternalMaxSimBlueprint::visitDumpFeatures(const IIndexEnvironment&, IDumpFeatureVisitor&) const {
+}
+
+Blueprint::UP InternalMaxSimBlueprint::createInstance() const {
+    return std::make_unique<InternalMaxSimBlueprint>();
+}
+
+ParameterDescriptions InternalMaxSimBlueprint::getDescriptions() const {
+    return ParameterDescriptions()
+        .desc()
+        .attribute(ParameterDataTypeSet::tensor_type_set(), ParameterCollection::SINGLE)
+        .string()
+        .string()
+        .string()
+        .string();
+}
+
+bool InternalMaxSimBlueprint::setup(const IIndexEnvironment& env, const ParameterList& params) {
+    _attribute = params[0].getValue();
+    _attrKey = createAttributeKey(_attribute);
+    const std::string& query = params[1].getValue();
+    const std::string& query_dim = params[2].getValue();
+    const std::string& doc_dim = params[3].getValue();
+    const std::string& vector_dim = params[4].getValue();
+    try {
+        _queryValue = QueryValue::from_config(query, env);
+        _defaultQueryValue = _queryValue.make_default_value(env);
+    } catch (const InvalidValueTypeException& ex) {
+        return fail("invalid query type: '%s'", ex.type_str().c_str());
+    } catch (const InvalidTensorValueException& ex) {
+        return fail("could not create default query tensor value of type '%s' from the expression '%s'",
+                    _queryValue.type().to_spec().c_str(), ex.expr().c_str());
+    }
+    _attrType = ValueType::from_spec(Attribute::lookup(env.getProperties(), _attribute));
+    const ValueType& query_type = _queryValue.type();
+    if (!is_vector_list(query_type, query_dim, vector_dim)) {
+        return fail("query tensor type '%s' does not have token dimension '%s' and vector dimension '%s'",
+                    query_type.to_spec().c_str(), query_dim.c_str(), vector_dim.c_str());
+    }
+    if (!is_vector_list(_attrType, doc_dim, vector_dim)) {
+        return fail("attribute tensor type '%s' does not have token dimension '%s' and vector dimension '%s'",
+                    _attrType.to_spec().c_str(), doc_dim.c_str(), vector_dim.c_str());
+    }
+    _vectorSize = query_type.dimensions()[query_type.dimension_index(vector_dim)].size;
+    if (_attrType.dimensions()[_attrType.dimension_index(vector_dim)].size != _vectorSize) {
+        return fail("vector dimension '%s' has different size in query and attribute", vector_dim.c_str());
+    }
+    describeOutput("scalar", "Internal executor for optimized execution of late interaction (MaxSim) expressions");
+    return true;
+}
+
+void InternalMaxSimBlueprint::prepareSharedState(const IQueryEnvironment& env, IObjectStore& store) const {
+    lookupAndStoreAttribute(_attrKey, _attribute, env, store);
+    _queryValue.prepare_shared_state(env, store);
+}
+
+FeatureExecutor& InternalMaxSimBlueprint::createExecutor(const IQueryEnvironment& env, vespalib::Stash& stash) const {
+    const auto*             attribute = lookupAttribute(_attrKey, _attribute, env);
+    const ITensorAttribute* tensor_attribute = (attribute != nullptr) ? attribute->asTensorAttribute() : nullptr;
+    if (tensor_attribute == nullptr) {
+        Issue::report("intrinsic max_sim feature: The tensor attribute '%s' was not found, returning default value.",
+                      _attribute.c_str());
+        return stash.create<SingleZeroValueExecutor>();
+    }
+    if (tensor_attribute->getTensorType() != _attrType) {
+        Issue::report("intrinsic max_sim feature: The tensor attribute '%s' has tensor type '%s', while the feature "
+                      "executor expects type '%s'. Returning default value.",
+                      _attribute.c_str(), tensor_attribute->getTensorType().to_spec().c_str(),
+                      _attrType.to_spec().c_str());
+        return stash.create<SingleZeroValueExecutor>();
+    }
+    const Value* query = _queryValue.lookup_value(env.getObjectStore());
+    if (query == nullptr) {
+        query = _defaultQueryValue.get();
+    }
+    return create_executor(*tensor_attribute, query->cells(), _vectorSize, stash);
+}
+
+} // namespace search::features
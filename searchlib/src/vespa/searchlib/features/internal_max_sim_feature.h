@@ -0,0 +1,60 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/value_type.h>
+#include <vespa/searchlib/fef/blueprint.h>
+#include <vespa/searchlib/fef/query_value.h>
+
+namespace vespalib::eval {
+struct Value;
+}
+
+namespace search::features {
+
+/**
+ * Feature for the specific replacement of the late interaction
+ * (MaxSim) expression:
+ *
+ *      reduce(
+ *          reduce(
+ *              reduce(query(Q) * attribute(A), sum, V),
+ *              max,
+ *              D
+ *          ),
+ *          sum,
+ *          T
+ *      )
+ *
+ * where Q is a query tensor with a token dimension T and a vector
+ * dimension V, and A is a tensor attribute with a token dimension D
+ * and the same vector dimension V (e.g. Q: tensor(T{},V[128]) and A:
+ * tensor(D{},V[128])). The document token vectors are read directly
+ * from the attribute store and the maximum dot product for each
+ * query token is computed with hardware accelerated kernels, without
+ * creating temporary tensors for each document.
+ *
+ * Parameters: attribute, query, T, D, V.
+ */
+class InternalMaxSimBlueprint : public fef::Blueprint {
+private:
+    std::string                            _attribute;
+    std::string                            _attrKey;
+    vespalib::eval::ValueType              _attrType;
+    fef::QueryValue                        _queryValue;
+    std::unique_ptr<vespalib::eval::Value> _defaultQueryValue;
+    size_t                                 _vectorSize;
+
+public:
+    InternalMaxSimBlueprint();
+    ~InternalMaxSimBlueprint() override;
+
+    fef::ParameterDescriptions getDescriptions() const override;
+    fef::Blueprint::UP createInstance() const override;
+    bool setup(const fef::IIndexEnvironment& env, const fef::ParameterList& params) override;
+    void prepareSharedState(const fef::IQueryEnvironment& queryEnv, fef::IObjectStore& objectStore) const override;
+    fef::FeatureExecutor& createExecutor(const fef::IQueryEnvironment& env, vespalib::Stash& stash) const override;
+    void visitDumpFeatures(const fef::IIndexEnvironment& env, fef::IDumpFeatureVisitor& visitor) const override;
+};
+
+} // namespace search::features
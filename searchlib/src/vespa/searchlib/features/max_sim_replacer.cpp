@@ -0,0 +1,113 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "max_sim_replacer.h"
+
+#include <vespa/eval/eval/basic_nodes.h>
+#include <vespa/eval/eval/function.h>
+#include <vespa/eval/eval/operator_nodes.h>
+#include <vespa/eval/eval/tensor_nodes.h>
+#include <vespa/searchlib/features/rankingexpression/intrinsic_blueprint_adapter.h>
+
+namespace search::features {
+
+using fef::Blueprint;
+using fef::IIndexEnvironment;
+using rankingexpression::ExpressionReplacer;
+using rankingexpression::IntrinsicBlueprintAdapter;
+using rankingexpression::IntrinsicExpression;
+using vespalib::eval::Aggr;
+using vespalib::eval::Function;
+using vespalib::eval::nodes::as;
+using vespalib::eval::nodes::Mul;
+using vespalib::eval::nodes::Node;
+using vespalib::eval::nodes::Symbol;
+using vespalib::eval::nodes::TensorJoin;
+using vespalib::eval::nodes::TensorReduce;
+
+namespace {
+
+bool match_params(const Node& a, const Node& b) {
+    auto sym_a = as<Symbol>(a);
+    auto sym_b = as<Symbol>(b);
+    if (!sym_a || !sym_b) {
+        return false;
+    }
+    return ((sym_a->id() == 0) && (sym_b->id() == 1)) || ((sym_a->id() == 1) && (sym_b->id() == 0));
+}
+
+bool match_prod(const Node& node) {
+    if (auto join = as<TensorJoin>(node)) {
+        const Node& root = join->lambda().root();
+        if (!as<Mul>(root) || !match_params(root.get_child(0), root.get_child(1))) {
+            return false;
+        }
+    } else if (!as<Mul>(node)) {
+        return false;
+    }
+    return match_params(node.get_child(0), node.get_child(1));
+}
+
+const Node* match_reduce(const Node& node, Aggr aggr, std::string& dim) {
+    auto reduce = as<TensorReduce>(node);
+    if (!reduce || (reduce->aggr() != aggr) || (reduce->dimensions().size() != 1)) {
+        return nullptr;
+    }
+    dim = reduce->dimensions()[0];
+    return &reduce->get_child(0);
+}
+
+struct MatchInputs {
+    std::string attribute;
+    std::string query;
+    MatchInputs() : attribute(), query() {}
+    void process(const std::string& param) {
+        std::string wrapper;
+        std::string body;
+        std::string error;
+        if (Function::unwrap(param, wrapper, body, error)) {
+            if (wrapper == "attribute") {
+                attribute = body;
+            } else if (wrapper == "query") {
+                query = body;
+            }
+        }
+    }
+    bool matched() const { return (!attribute.empty() && !query.empty()); }
+};
+
+struct MaxSimReplacerImpl : ExpressionReplacer {
+    Blueprint::UP proto;
+    explicit MaxSimReplacerImpl(Blueprint::UP proto_in) : proto(std::move(proto_in)) {}
+    IntrinsicExpression::UP maybe_replace(const Function& function, const IIndexEnvironment& env) const override {
+        std::string query_dim;
+        std::string doc_dim;
+        std::string vector_dim;
+        if (function.num_params() != 2) {
+            return {};
+        }
+        const Node* node = match_reduce(function.root(), Aggr::SUM, query_dim);
+        node = node ? match_reduce(*node, Aggr::MAX, doc_dim) : nullptr;
+        node = node ? match_reduce(*node, Aggr::SUM, vector_dim) : nullptr;
+        if (!node || !match_prod(*node) || (query_dim == doc_dim) || (query_dim == vector_dim) ||
+            (doc_dim == vector_dim))
+        {
+            return {};
+        }
+        MatchInputs match_inputs;
+        match_inputs.process(function.param_name(0));
+        match_inputs.process(function.param_name(1));
+        if (!match_inputs.matched()) {
+            return {};
+        }
+        return IntrinsicBlueprintAdapter::try_create(
+            *proto, env, {match_inputs.attribute, match_inputs.query, query_dim, doc_dim, vector_dim});
+    }
+};
+
+} // namespace
+
+ExpressionReplacer::UP MaxSimReplacer::create(Blueprint::UP proto) {
+    return std::make_unique<MaxSimReplacerImpl>(std::move(proto));
+}
+
+} // namespace search::features
@@ -0,0 +1,36 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "internal_max_sim_feature.h"
+
+#include <vespa/searchlib/features/rankingexpression/expression_replacer.h>
+
+namespace search::features {
+
+/**
+ * ExpressionReplacer that will replace late interaction (MaxSim)
+ * expressions on the form:
+ *
+ *      reduce(
+ *          reduce(
+ *              reduce(query(Q) * attribute(A), sum, V),
+ *              max,
+ *              D
+ *          ),
+ *          sum,
+ *          T
+ *      )
+ *
+ * (the product may also be written as join with f(x,y)(x*y)) with a
+ * parameterized (A, Q, T, D, V) adaption of the given blueprint
+ * (default: InternalMaxSimBlueprint). Tensor types are validated by
+ * the blueprint; the expression is left as is if they do not fit.
+ **/
+struct MaxSimReplacer {
+    using ExpressionReplacer = rankingexpression::ExpressionReplacer;
+    static ExpressionReplacer::UP create(fef::Blueprint::UP proto);
+    static ExpressionReplacer::UP create() { return create(std::make_unique<InternalMaxSimBlueprint>()); }
+};
+
+} // namespace search::features
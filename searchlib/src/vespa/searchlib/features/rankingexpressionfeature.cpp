@@ -2,6 +2,7 @@
 
 #include "rankingexpressionfeature.h"
 
+#include "attributefeature.h"
 #include "utils.h"
 
 #include <vespa/eval/eval/fast_value.h>
@@ -11,6 +12,8 @@
 #include <vespa/searchlib/fef/properties.h>
 #include <vespa/vespalib/util/stringfmt.h>
 
+#include <algorithm>
+
 #include <vespa/log/log.h>
 LOG_SETUP(".features.rankingexpression");
 
@@ -52,11 +55,15 @@ private:
     const FastForest&       _forest;
     FastForest::Context::UP _ctx;
     std::span<float>        _params;
+    std::vector<float>      _batch_params; // column-wise parameters for batch evaluation
 
 public:
     FastForestExecutor(std::span<float> param_space, const FastForest& forest);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(std::span<const uint32_t> docids, std::span<const feature_t* const> inputs,
+                       std::span<feature_t* const> outputs) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -65,7 +72,7 @@ public:
  * Implements the executor for compiled ranking expressions
  **/
 class CompiledRankingExpressionExecutor : public fef::FeatureExecutor {
-private:
+protected:
     typedef double (*arr_function)(const double*);
     arr_function        _ranking_function;
     std::vector<double> _params;
@@ -74,6 +81,34 @@ public:
     CompiledRankingExpressionExecutor(const CompiledFunction& compiled_function);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(std::span<const uint32_t> docids, std::span<const feature_t* const> inputs,
+                       std::span<feature_t* const> outputs) override;
+};
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Implements the executor for compiled ranking expressions where
+ * single value numeric attribute inputs are read directly from
+ * attribute memory instead of through their feature executors, and
+ * constant inputs (like query features) are loaded only once.
+ **/
+class FusedCompiledRankingExpressionExecutor : public CompiledRankingExpressionExecutor {
+private:
+    struct AttributeParam {
+        uint32_t              idx;
+        SingleAttributeReader reader;
+    };
+    std::vector<AttributeParam> _attribute_params;
+    std::vector<uint32_t>       _input_params;
+
+protected:
+    void handle_bind_inputs(std::span<const fef::LazyValue> inputs) override;
+
+public:
+    FusedCompiledRankingExpressionExecutor(const CompiledFunction& compiled_function);
+    void execute(uint32_t docId) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -143,7 +178,7 @@ public:
 //-----------------------------------------------------------------------------
 
 FastForestExecutor::FastForestExecutor(std::span<float> param_space, const FastForest& forest)
-    : _forest(forest), _ctx(_forest.create_context()), _params(param_space) {
+    : _forest(forest), _ctx(_forest.create_context()), _params(param_space), _batch_params() {
 }
 
 void FastForestExecutor::execute(uint32_t) {
@@ -160,6 +195,20 @@ void FastForestExecutor::execute(uint32_t) {
     outputs().set_number(0, _forest.eval(*_ctx, &_params[0]));
 }
 
+void FastForestExecutor::execute_batch(std::span<const uint32_t> docids, std::span<const feature_t* const> in,
+                                       std::span<feature_t* const> out) {
+    if (_batch_params.empty()) {
+        _batch_params.resize(_params.size() * FastForest::max_batch_size);
+    }
+    for (size_t first = 0; first < docids.size(); first += FastForest::max_batch_size) {
+        size_t num_docs = std::min(FastForest::max_batch_size, docids.size() - first);
+        for (size_t i = 0; i < _params.size(); ++i) {
+            std::copy_n(in[i] + first, num_docs, _batch_params.data() + (i * num_docs));
+        }
+        _forest.eval_batch(*_ctx, _batch_params.data(), num_docs, out[0] + first);
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 CompiledRankingExpressionExecutor::CompiledRankingExpressionExecutor(const CompiledFunction& compiled_function)
@@ -180,6 +229,53 @@ void CompiledRankingExpressionExecutor::execute(uint32_t) {
     outputs().set_number(0, _ranking_function(_params.data()));
 }
 
+void CompiledRankingExpressionExecutor::execute_batch(std::span<const uint32_t> docids,
+                                                      std::span<const feature_t* const> in,
+                                                      std::span<feature_t* const>       out) {
+    for (size_t doc = 0; doc < docids.size(); ++doc) {
+        for (size_t i = 0; i < _params.size(); ++i) {
+            _params[i] = in[i][doc];
+        }
+        out[0][doc] = _ranking_function(_params.data());
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+FusedCompiledRankingExpressionExecutor::FusedCompiledRankingExpressionExecutor(
+    const CompiledFunction& compiled_function)
+    : CompiledRankingExpressionExecutor(compiled_function), _attribute_params(), _input_params() {
+}
+
+void FusedCompiledRankingExpressionExecutor::handle_bind_inputs(std::span<const fef::LazyValue> inputs) {
+    _attribute_params.clear();
+    _input_params.clear();
+    for (uint32_t i = 0; i < inputs.size(); ++i) {
+        const fef::LazyValue& input = inputs[i];
+        if (input.is_const()) {
+            _params[i] = input.get_raw()->as_number;
+            continue;
+        }
+        if (input.get_raw() == input.get_executor()->outputs().get_raw(0)) {
+            if (auto reader = make_single_attribute_reader(*input.get_executor())) {
+                _attribute_params.push_back(AttributeParam{i, reader.value()});
+                continue;
+            }
+        }
+        _input_params.push_back(i);
+    }
+}
+
+void FusedCompiledRankingExpressionExecutor::execute(uint32_t docId) {
+    for (const auto& param : _attribute_params) {
+        _params[param.idx] = param.reader(docId);
+    }
+    for (uint32_t idx : _input_params) {
+        _params[idx] = inputs().get_number(idx);
+    }
+    outputs().set_number(0, _ranking_function(_params.data()));
+}
+
 //-----------------------------------------------------------------------------
 
 namespace {
@@ -239,7 +335,8 @@ RankingExpressionBlueprint::RankingExpressionBlueprint(rankingexpression::Expres
       _interpreted_function(),
       _compile_token(),
       _input_is_object(),
-      _should_unbox(false) {
+      _should_unbox(false),
+      _fuse_attribute_inputs(false) {
 }
 
 RankingExpressionBlueprint::~RankingExpressionBlueprint() = default;
@@ -330,6 +427,8 @@ bool RankingExpressionBlueprint::setup(const fef::IIndexEnvironment& env, const
                     _compile_token = CompileCache::compile(*rank_function, PassParams::LAZY);
                 } else {
                     _compile_token = CompileCache::compile(*rank_function, PassParams::ARRAY);
+                    _fuse_attribute_inputs =
+                        fef::indexproperties::eval::FuseAttributeInputs::check(env.getProperties());
                 }
             }
         } else {
@@ -374,6 +473,9 @@ fef::FeatureExecutor& RankingExpressionBlueprint::createExecutor(const fef::IQue
     }
     assert(_compile_token.get() != nullptr); // will be nullptr for VERIFY_SETUP feature motivation
     if (_compile_token->get().pass_params() == PassParams::ARRAY) {
+        if (_fuse_attribute_inputs) {
+            return stash.create<FusedCompiledRankingExpressionExecutor>(_compile_token->get());
+        }
         return stash.create<CompiledRankingExpressionExecutor>(_compile_token->get());
     } else {
         assert(_compile_token->get().pass_params() == PassParams::LAZY);
@@ -24,6 +24,7 @@ private:
     vespalib::eval::CompileCache::Token::UP    _compile_token;
     std::vector<char>                          _input_is_object;
     bool                                       _should_unbox;
+    bool                                       _fuse_attribute_inputs;
 
 public:
     RankingExpressionBlueprint();
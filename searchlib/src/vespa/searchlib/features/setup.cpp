@@ -37,6 +37,7 @@
 #include "matchesfeature.h"
 #include "matchfeature.h"
 #include "max_reduce_prod_join_replacer.h"
+#include "max_sim_replacer.h"
 #include "native_dot_product_feature.h"
 #include "nativeattributematchfeature.h"
 #include "nativefieldmatchfeature.h"
@@ -73,6 +74,7 @@
 #include <vespa/searchlib/features/rankingexpression/expression_replacer.h>
 
 using search::features::MaxReduceProdJoinReplacer;
+using search::features::MaxSimReplacer;
 using search::features::rankingexpression::ListExpressionReplacer;
 using search::fef::Blueprint;
 
@@ -153,6 +155,7 @@ void setup_search_features(fef::IBlueprintRegistry& registry) {
     // Ranking Expression
     auto replacers = std::make_unique<ListExpressionReplacer>();
     replacers->add(MaxReduceProdJoinReplacer::create());
+    replacers->add(MaxSimReplacer::create());
     registry.addPrototype(std::make_shared<RankingExpressionBlueprint>(std::move(replacers)));
 }
 
@@ -0,0 +1,91 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "batch_rank_evaluator.h"
+
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/vespalib/stllike/hash_set.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace search::fef {
+
+namespace {
+
+using ExecutorSet = vespalib::hash_set<const FeatureExecutor*>;
+
+// Collect the executors needed by 'executor' (and itself) in dependency order
+bool collect(FeatureExecutor* executor, ExecutorSet& seen, std::vector<FeatureExecutor*>& order) {
+    if (seen.find(executor) != seen.end()) {
+        return true;
+    }
+    seen.insert(executor);
+    if (!executor->supports_batch()) {
+        return false;
+    }
+    for (const auto& input : executor->inputs().get_bound()) {
+        if (!input.is_const() && !collect(input.get_executor(), seen, order)) {
+            return false;
+        }
+    }
+    order.push_back(executor);
+    return true;
+}
+
+} // namespace
+
+BatchRankEvaluator::BatchRankEvaluator() : _columns(), _steps(), _result(nullptr) {
+}
+
+BatchRankEvaluator::~BatchRankEvaluator() = default;
+
+feature_t* BatchRankEvaluator::make_column() {
+    return _columns.emplace_back(block_size, 0.0).data();
+}
+
+std::unique_ptr<BatchRankEvaluator> BatchRankEvaluator::try_create(const LazyValue& value) {
+    if (value.is_const()) {
+        return {};
+    }
+    ExecutorSet                   seen;
+    std::vector<FeatureExecutor*> order;
+    if (!collect(value.get_executor(), seen, order)) {
+        return {};
+    }
+    std::unique_ptr<BatchRankEvaluator>                          result(new BatchRankEvaluator());
+    vespalib::hash_map<const NumberOrObject*, const feature_t*> column_of;
+    for (FeatureExecutor* executor : order) {
+        Step& step = result->_steps.emplace_back(executor);
+        for (const auto& input : executor->inputs().get_bound()) {
+            if (input.is_const()) {
+                feature_t* column = result->make_column();
+                std::fill_n(column, block_size, input.get_raw()->as_number);
+                step.inputs.push_back(column);
+            } else {
+                auto pos = column_of.find(input.get_raw());
+                assert(pos != column_of.end());
+                step.inputs.push_back(pos->second);
+            }
+        }
+        const auto& outputs = executor->outputs();
+        for (size_t out_idx = 0; out_idx < outputs.size(); ++out_idx) {
+            feature_t* column = result->make_column();
+            column_of[outputs.get_raw(out_idx)] = column;
+            step.outputs.push_back(column);
+        }
+    }
+    auto pos = column_of.find(value.get_raw());
+    assert(pos != column_of.end());
+    result->_result = pos->second;
+    return result;
+}
+
+std::span<const feature_t> BatchRankEvaluator::evaluate(std::span<const uint32_t> docids) {
+    assert(docids.size() <= block_size);
+    for (auto& step : _steps) {
+        step.executor->execute_batch(docids, step.inputs, step.outputs);
+    }
+    return {_result, docids.size()};
+}
+
+} // namespace search::fef
@@ -0,0 +1,61 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "featureexecutor.h"
+
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace search::fef {
+
+/**
+ * Calculates a number feature from a RankProgram for a block of
+ * documents at a time.
+ *
+ * The non-constant executors the feature depends on are run once per
+ * block in dependency order, each filling columnar outputs with one
+ * value per document instead of the per-document output values used
+ * for lazy evaluation. Constant inputs are expanded to columns up
+ * front. This is only possible when all these executors support
+ * batch execution; try_create returns nullptr otherwise, and the
+ * feature must be calculated one document at a time.
+ **/
+class BatchRankEvaluator {
+public:
+    static constexpr size_t block_size = 64;
+
+private:
+    struct Step {
+        FeatureExecutor*              executor;
+        std::vector<const feature_t*> inputs;
+        std::vector<feature_t*>       outputs;
+        explicit Step(FeatureExecutor* executor_in) noexcept : executor(executor_in), inputs(), outputs() {}
+    };
+    std::vector<std::vector<feature_t>> _columns;
+    std::vector<Step>                   _steps;
+    const feature_t*                    _result;
+
+    BatchRankEvaluator();
+    feature_t* make_column();
+
+public:
+    BatchRankEvaluator(const BatchRankEvaluator&) = delete;
+    BatchRankEvaluator& operator=(const BatchRankEvaluator&) = delete;
+    ~BatchRankEvaluator();
+
+    /**
+     * Create a batch evaluator for the given (non-constant) number
+     * feature if all executors it depends on support batch execution.
+     **/
+    static std::unique_ptr<BatchRankEvaluator> try_create(const LazyValue& value);
+
+    /**
+     * Calculate the feature for the given documents (at most
+     * block_size). The result is valid until the next call.
+     **/
+    std::span<const feature_t> evaluate(std::span<const uint32_t> docids);
+};
+
+} // namespace search::fef
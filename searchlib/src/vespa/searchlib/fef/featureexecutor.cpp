@@ -4,6 +4,9 @@
 
 #include <vespa/vespalib/util/classname.h>
 
+#include <vespa/log/log.h>
+LOG_SETUP(".fef.featureexecutor");
+
 namespace search::fef {
 
 FeatureExecutor::FeatureExecutor() = default;
@@ -16,6 +19,15 @@ bool FeatureExecutor::isPure() {
     return false;
 }
 
+bool FeatureExecutor::supports_batch() const {
+    return false;
+}
+
+void FeatureExecutor::execute_batch(std::span<const uint32_t>, std::span<const feature_t* const>,
+                                    std::span<feature_t* const>) {
+    LOG_ABORT("should not be reached");
+}
+
 void FeatureExecutor::handle_bind_inputs(std::span<const LazyValue>) {
 }
 
@@ -29,6 +29,8 @@ public:
     LazyValue(const NumberOrObject* value, FeatureExecutor* executor) : _value(value), _executor(executor) {}
     bool is_const() const { return (_executor == nullptr); }
     bool is_same(const LazyValue& rhs) const { return ((_value == rhs._value) && (_executor == rhs._executor)); }
+    const NumberOrObject* get_raw() const { return _value; }
+    FeatureExecutor* get_executor() const { return _executor; }
     inline double as_number(uint32_t docid) const;
     inline vespalib::eval::Value::CREF as_object(uint32_t docid) const;
 };
@@ -52,6 +54,7 @@ public:
         void bind(std::span<const LazyValue> inputs) { _inputs = inputs; }
         inline feature_t get_number(size_t idx) const;
         inline vespalib::eval::Value::CREF get_object(size_t idx) const;
+        std::span<const LazyValue> get_bound() const { return _inputs; }
         size_t size() const { return _inputs.size(); }
     };
 
@@ -132,6 +135,32 @@ public:
      **/
     virtual bool isPure();
 
+    /**
+     * Check if this feature executor can calculate its outputs for a
+     * block of documents at a time (see execute_batch). This is
+     * implemented to return false by default. Executors returning
+     * true must only have number inputs and outputs and must not use
+     * match data, as the match data will only be unpacked for the
+     * last document in the block.
+     *
+     * @return true if this feature executor supports batch execution
+     **/
+    virtual bool supports_batch() const;
+
+    /**
+     * Execute this feature executor for a block of documents. Each
+     * input and output is a column with one value per document in
+     * the block. This is only called if supports_batch returns true.
+     * Note that batch execution does not touch the per-document input
+     * and output values used by lazy_execute.
+     *
+     * @param docids the local document ids being evaluated
+     * @param inputs one column of input values per input
+     * @param outputs one column of output values per output
+     **/
+    virtual void execute_batch(std::span<const uint32_t> docids, std::span<const feature_t* const> inputs,
+                               std::span<feature_t* const> outputs);
+
     /**
      * Make sure this executor has been executed for the given
      * document.
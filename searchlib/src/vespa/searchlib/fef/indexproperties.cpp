@@ -90,6 +90,12 @@ bool UseFastForest::check(const Properties& props) {
     return lookupBool(props, NAME, DEFAULT_VALUE);
 }
 
+const std::string FuseAttributeInputs::NAME("vespa.eval.fuse_attribute_inputs");
+const bool        FuseAttributeInputs::DEFAULT_VALUE(false);
+bool FuseAttributeInputs::check(const Properties& props) {
+    return lookupBool(props, NAME, DEFAULT_VALUE);
+}
+
 } // namespace eval
 
 namespace rank {
@@ -331,6 +337,28 @@ uint32_t NumSearchPartitions::lookup(const Properties& props, uint32_t defaultVa
     return lookupUint32(props, NAME, defaultValue);
 }
 
+const std::string ResultCacheSize::NAME("vespa.matching.resultcache.size");
+const uint32_t    ResultCacheSize::DEFAULT_VALUE(0);
+
+uint32_t ResultCacheSize::lookup(const Properties& props) {
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t ResultCacheSize::lookup(const Properties& props, uint32_t defaultValue) {
+    return lookupUint32(props, NAME, defaultValue);
+}
+
+const std::string ResultCacheMaxAge::NAME("vespa.matching.resultcache.maxage");
+const double      ResultCacheMaxAge::DEFAULT_VALUE(1.0);
+
+double ResultCacheMaxAge::lookup(const Properties& props) {
+    return lookup(props, DEFAULT_VALUE);
+}
+
+double ResultCacheMaxAge::lookup(const Properties& props, double defaultValue) {
+    return lookupDouble(props, NAME, defaultValue);
+}
+
 const std::string MinHitsPerThread::NAME("vespa.matching.minhitsperthread");
 const uint32_t    MinHitsPerThread::DEFAULT_VALUE(0);
 
@@ -393,6 +421,15 @@ bool WeakAndAllowDropAll::lookup(const Properties& props, bool defaultValue) {
     return lookupBool(props, NAME, defaultValue);
 }
 
+const std::string WeakAndBlockMax::NAME("vespa.matching.weakand.block_max");
+const bool        WeakAndBlockMax::DEFAULT_VALUE(false);
+bool WeakAndBlockMax::lookup(const Properties& props) {
+    return lookup(props, DEFAULT_VALUE);
+}
+bool WeakAndBlockMax::lookup(const Properties& props, bool defaultValue) {
+    return lookupBool(props, NAME, defaultValue);
+}
+
 const std::string           FilterThreshold::NAME("vespa.matching.filter_threshold");
 const std::optional<double> FilterThreshold::DEFAULT_VALUE(std::nullopt);
 std::optional<double> FilterThreshold::lookup(const search::fef::Properties& props) {
@@ -624,6 +661,9 @@ const double      DegradationMaxFilterCoverage::DEFAULT_VALUE(0.2);
 const std::string DegradationPostFilterMultiplier::NAME("vespa.matchphase.degradation.postfiltermultiplier");
 const double      DegradationPostFilterMultiplier::DEFAULT_VALUE(1.0);
 
+const std::string DegradationSortOrder::NAME("vespa.matchphase.degradation.sortorder");
+const bool        DegradationSortOrder::DEFAULT_VALUE(false);
+
 const std::string DiversityAttribute::NAME("vespa.matchphase.diversity.attribute");
 const std::string DiversityAttribute::DEFAULT_VALUE("");
 
@@ -660,6 +700,10 @@ double DegradationPostFilterMultiplier::lookup(const Properties& props, double d
     return lookupDouble(props, NAME, defaultValue);
 }
 
+bool DegradationSortOrder::check(const Properties& props, bool fallback) {
+    return lookupBool(props, NAME, fallback);
+}
+
 std::string DiversityAttribute::lookup(const Properties& props, const std::string& defaultValue) {
     return lookupString(props, NAME, defaultValue);
 }
@@ -691,6 +735,17 @@ uint32_t Level::lookup(const Properties& props, uint32_t defaultValue) {
     return lookupUint32(props, NAME, defaultValue);
 }
 
+const std::string ProfileSampleInterval::NAME("vespa.trace.profile_sample_interval");
+const uint32_t    ProfileSampleInterval::DEFAULT_VALUE(0);
+
+uint32_t ProfileSampleInterval::lookup(const Properties& props) {
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t ProfileSampleInterval::lookup(const Properties& props, uint32_t defaultValue) {
+    return lookupUint32(props, NAME, defaultValue);
+}
+
 } // namespace trace
 
 namespace hitcollector {
@@ -755,6 +810,17 @@ std::optional<feature_t> SecondPhaseRankScoreDropLimit::lookup(const Properties&
     return lookup_opt_double(props, NAME, default_value);
 }
 
+const std::string ShareFirstPhaseScoreThreshold::NAME("vespa.hitcollector.sharefirstphasescorethreshold");
+const bool        ShareFirstPhaseScoreThreshold::DEFAULT_VALUE(false);
+
+bool ShareFirstPhaseScoreThreshold::lookup(const Properties& props) {
+    return lookup(props, DEFAULT_VALUE);
+}
+
+bool ShareFirstPhaseScoreThreshold::lookup(const Properties& props, bool default_value) {
+    return lookupBool(props, NAME, default_value);
+}
+
 } // namespace hitcollector
 
 const std::string FieldWeight::BASE_NAME("vespa.fieldweight.");
@@ -41,6 +41,14 @@ struct UseFastForest {
     static bool check(const Properties& props);
 };
 
+// let compiled expressions read single value numeric attribute inputs
+// directly from attribute memory and load constant inputs once per query
+struct FuseAttributeInputs {
+    static const std::string NAME;
+    static const bool        DEFAULT_VALUE;
+    static bool check(const Properties& props);
+};
+
 } // namespace eval
 
 namespace rank {
@@ -289,6 +297,32 @@ struct NumSearchPartitions {
     static uint32_t lookup(const Properties& props, uint32_t defaultValue);
 };
 
+/**
+ * Property for the max number of query results cached by the rank
+ * profile. Identical queries (same query tree, hit window, sorting,
+ * grouping and rank properties) are answered from the cache as long
+ * as the document data is unchanged. The default value 0 disables
+ * the cache.
+ **/
+struct ResultCacheSize {
+    static const std::string NAME;
+    static const uint32_t    DEFAULT_VALUE;
+    static uint32_t lookup(const Properties& props);
+    static uint32_t lookup(const Properties& props, uint32_t defaultValue);
+};
+
+/**
+ * Property for the max age (in seconds) of a cached query result.
+ * Bounds how long a result may be reused when only document
+ * content that is not tracked by the cache invalidation has changed.
+ **/
+struct ResultCacheMaxAge {
+    static const std::string NAME;
+    static const double      DEFAULT_VALUE;
+    static double lookup(const Properties& props);
+    static double lookup(const Properties& props, double defaultValue);
+};
+
 /**
  * Property to control fallback to not building a global filter
  * for a query with a blueprint that wants a global filter. If the
@@ -428,6 +462,19 @@ struct WeakAndAllowDropAll {
     static bool lookup(const Properties& props, bool defaultValue);
 };
 
+/**
+ * Use block-max weakAnd when the posting lists contain per block max
+ * number of occurrences. Terms are then scored using term frequency,
+ * allowing blocks of documents that cannot beat the current threshold
+ * to be skipped.
+ **/
+struct WeakAndBlockMax {
+    static const std::string NAME;
+    static const bool        DEFAULT_VALUE;
+    static bool lookup(const Properties& props);
+    static bool lookup(const Properties& props, bool defaultValue);
+};
+
 /**
  * Property to extract the filter threshold settings for a query (see search::fef::FilterThreshold for details).
  * The per field filter threshold has precedence over the overall filter threshold.
@@ -615,6 +662,19 @@ struct DegradationPostFilterMultiplier {
     static double lookup(const Properties& props, double defaultValue);
 };
 
+/**
+ * Property for using the primary sort key of a sorted query for graceful degradation during match phase
+ * when no degradation attribute is configured. The sort key must be a single value integer fast-search
+ * attribute. Only documents early in sort order are then matched, making the cost of queries like
+ * "newest 100 items matching X" proportional to the wanted hits rather than the number of matches.
+ **/
+struct DegradationSortOrder {
+    static const std::string NAME;
+    static const bool        DEFAULT_VALUE;
+    static bool check(const Properties& props) { return check(props, DEFAULT_VALUE); }
+    static bool check(const Properties& props, bool fallback);
+};
+
 /**
  * The name of the attribute used to ensure result diversity
  * during match phase limiting. If this property is "" (empty
@@ -666,6 +726,19 @@ struct Level {
     static uint32_t lookup(const Properties& props, uint32_t defaultValue);
 };
 
+/**
+ * Property for always-on sampled profiling. When set to N > 0, one in
+ * N queries using the rank profile are profiled (match, first phase
+ * and second phase), and the profiles are aggregated per rank profile.
+ * Queries with tracing enabled are not sampled.
+ **/
+struct ProfileSampleInterval {
+    static const std::string NAME;
+    static const uint32_t    DEFAULT_VALUE;
+    static uint32_t lookup(const Properties& props);
+    static uint32_t lookup(const Properties& props, uint32_t defaultValue);
+};
+
 } // namespace trace
 
 namespace hitcollector {
@@ -734,6 +807,25 @@ struct SecondPhaseRankScoreDropLimit {
     static std::optional<feature_t> lookup(const Properties& props, std::optional<double> default_value);
 };
 
+/**
+ * Property for sharing the first phase rank score threshold across
+ * match threads. When enabled, each thread publishes the lowest first
+ * phase score it keeps once its hit collector is full. The wand and
+ * dotProduct operators that a hit must match use the best published
+ * threshold to skip documents whose raw score can not exceed it.
+ * Only enable this when the first phase score of a hit never exceeds
+ * the raw score of these operators, e.g. with rawScore(field) as the
+ * first phase expression. Skipped documents are not counted as hits,
+ * so the total hit count becomes an estimate, like with wand. Not used
+ * for queries with sorting or grouping.
+ **/
+struct ShareFirstPhaseScoreThreshold {
+    static const std::string NAME;
+    static const bool        DEFAULT_VALUE;
+    static bool lookup(const Properties& props);
+    static bool lookup(const Properties& props, bool default_value);
+};
+
 } // namespace hitcollector
 
 /**
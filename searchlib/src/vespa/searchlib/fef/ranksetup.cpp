@@ -53,6 +53,7 @@ RankSetup::RankSetup(const BlueprintFactory& factory, const IIndexEnvironment& i
       _degradationPostFilterMultiplier(1.0),
       _first_phase_rank_score_drop_limit(),
       _second_phase_rank_score_drop_limit(),
+      _share_first_phase_score_threshold(hitcollector::ShareFirstPhaseScoreThreshold::DEFAULT_VALUE),
       _match_features(),
       _summaryFeatures(),
       _dumpFeatures(),
@@ -78,6 +79,7 @@ RankSetup::RankSetup(const BlueprintFactory& factory, const IIndexEnvironment& i
       _weakand_stop_word_adjust_limit(matching::WeakAndStopWordAdjustLimit::DEFAULT_VALUE),
       _weakand_stop_word_drop_limit(matching::WeakAndStopWordDropLimit::DEFAULT_VALUE),
       _weakand_allow_drop_all(matching::WeakAndAllowDropAll::DEFAULT_VALUE),
+      _weakand_block_max(matching::WeakAndBlockMax::DEFAULT_VALUE),
       _fuzzy_matching_algorithm(vespalib::FuzzyMatchingAlgorithm::DfaTable),
       _mutateOnMatch(),
       _mutateOnFirstPhase(),
@@ -129,6 +131,8 @@ void RankSetup::configure() {
         hitcollector::FirstPhaseRankScoreDropLimit::lookup(_indexEnv.getProperties()));
     set_second_phase_rank_score_drop_limit(
         hitcollector::SecondPhaseRankScoreDropLimit::lookup(_indexEnv.getProperties()));
+    set_share_first_phase_score_threshold(
+        hitcollector::ShareFirstPhaseScoreThreshold::lookup(_indexEnv.getProperties()));
     setSoftTimeoutEnabled(softtimeout::Enabled::lookup(_indexEnv.getProperties()));
     setSoftTimeoutTailCost(softtimeout::TailCost::lookup(_indexEnv.getProperties()));
     set_global_filter_lower_limit(matching::GlobalFilterLowerLimit::lookup(_indexEnv.getProperties()));
@@ -142,6 +146,7 @@ void RankSetup::configure() {
     set_weakand_stop_word_adjust_limit(matching::WeakAndStopWordAdjustLimit::lookup(_indexEnv.getProperties()));
     set_weakand_stop_word_drop_limit(matching::WeakAndStopWordDropLimit::lookup(_indexEnv.getProperties()));
     set_weakand_allow_drop_all(matching::WeakAndAllowDropAll::lookup(_indexEnv.getProperties()));
+    set_weakand_block_max(matching::WeakAndBlockMax::lookup(_indexEnv.getProperties()));
     _mutateOnMatch._attribute = mutate::on_match::Attribute::lookup(_indexEnv.getProperties());
     _mutateOnMatch._operation = mutate::on_match::Operation::lookup(_indexEnv.getProperties());
     _mutateOnFirstPhase._attribute = mutate::on_first_phase::Attribute::lookup(_indexEnv.getProperties());
@@ -63,6 +63,7 @@ private:
     double                           _degradationPostFilterMultiplier;
     std::optional<feature_t>         _first_phase_rank_score_drop_limit;
     std::optional<feature_t>         _second_phase_rank_score_drop_limit;
+    bool                             _share_first_phase_score_threshold;
     std::vector<std::string>         _match_features;
     std::vector<std::string>         _summaryFeatures;
     std::vector<std::string>         _dumpFeatures;
@@ -89,6 +90,7 @@ private:
     double                           _weakand_stop_word_adjust_limit;
     double                           _weakand_stop_word_drop_limit;
     bool                             _weakand_allow_drop_all;
+    bool                             _weakand_block_max;
     vespalib::FuzzyMatchingAlgorithm _fuzzy_matching_algorithm;
     MutateOperation                  _mutateOnMatch;
     MutateOperation                  _mutateOnFirstPhase;
@@ -331,6 +333,9 @@ public:
         return _second_phase_rank_score_drop_limit;
     }
 
+    void set_share_first_phase_score_threshold(bool value) { _share_first_phase_score_threshold = value; }
+    bool get_share_first_phase_score_threshold() const noexcept { return _share_first_phase_score_threshold; }
+
     /**
      * This method may be used to indicate that certain features
      * should be present in the search result.
@@ -403,6 +408,8 @@ public:
     double get_weakand_stop_word_drop_limit() const { return _weakand_stop_word_drop_limit; }
     void set_weakand_allow_drop_all(bool v) { _weakand_allow_drop_all = v; }
     bool get_weakand_allow_drop_all() const { return _weakand_allow_drop_all; }
+    void set_weakand_block_max(bool v) { _weakand_block_max = v; }
+    bool get_weakand_block_max() const { return _weakand_block_max; }
 
     /**
      * This method may be used to indicate that certain features
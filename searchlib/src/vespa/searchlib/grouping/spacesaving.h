@@ -0,0 +1,219 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/objects/deserializer.h>
+#include <vespa/vespalib/objects/serializer.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace search {
+
+/**
+ * Space-Saving sketch (Metwally et al.) tracking the most frequent
+ * values of a stream with a bounded number of counters.
+ *
+ * Values are identified by a 64-bit hash, and each counter keeps the
+ * value it was (re)assigned to. When all counters are in use, a new
+ * value takes over the counter with the lowest count, inheriting that
+ * count as its error. The count of a tracked value is an upper bound
+ * on its frequency, and count - error is a lower bound. Any value with
+ * a frequency above total / capacity is guaranteed to be tracked.
+ *
+ * Sketches built over disjoint streams can be merged; a value missing
+ * from a full sketch is assumed to have the minimum count of that
+ * sketch (both as count and as error), and the 'capacity' counters
+ * with the highest counts are kept.
+ */
+template <typename Value> class SpaceSaving {
+public:
+    struct Entry {
+        uint64_t hash;
+        uint64_t count;
+        uint64_t error;
+        Value    value;
+    };
+
+private:
+    uint32_t                               _capacity;
+    std::vector<Entry>                     _entries;
+    std::vector<uint32_t>                  _heap; // entry indexes, min-heap on count
+    std::vector<uint32_t>                  _heap_pos;
+    vespalib::hash_map<uint64_t, uint32_t> _index;
+    uint64_t                               _max_count;
+
+    uint64_t count_at(uint32_t pos) const noexcept { return _entries[_heap[pos]].count; }
+    void     swap_heap(uint32_t a, uint32_t b) noexcept {
+        std::swap(_heap[a], _heap[b]);
+        _heap_pos[_heap[a]] = a;
+        _heap_pos[_heap[b]] = b;
+    }
+    void sift_up(uint32_t pos) noexcept {
+        while ((pos > 0) && (count_at(pos) < count_at((pos - 1) / 2))) {
+            swap_heap(pos, (pos - 1) / 2);
+            pos = (pos - 1) / 2;
+        }
+    }
+    void sift_down(uint32_t pos) noexcept {
+        for (;;) {
+            uint32_t smallest = pos;
+            uint32_t left = 2 * pos + 1;
+            uint32_t right = left + 1;
+            if ((left < _heap.size()) && (count_at(left) < count_at(smallest))) {
+                smallest = left;
+            }
+            if ((right < _heap.size()) && (count_at(right) < count_at(smallest))) {
+                smallest = right;
+            }
+            if (smallest == pos) {
+                return;
+            }
+            swap_heap(pos, smallest);
+            pos = smallest;
+        }
+    }
+    void rebuild(std::vector<Entry> entries);
+
+public:
+    explicit SpaceSaving(uint32_t capacity)
+        : _capacity(capacity), _entries(), _heap(), _heap_pos(), _index(), _max_count(0) {}
+
+    uint32_t capacity() const noexcept { return _capacity; }
+    size_t size() const noexcept { return _entries.size(); }
+    bool full() const noexcept { return _entries.size() >= _capacity; }
+    const std::vector<Entry>& entries() const noexcept { return _entries; }
+
+    // The count assumed for values that are not tracked
+    uint64_t min_count() const noexcept { return (full() && !_heap.empty()) ? count_at(0) : 0; }
+    // The highest count of a tracked value, kept up to date as values are added
+    uint64_t max_count() const noexcept { return _max_count; }
+
+    /**
+     * Count one occurrence of the value with the given hash.
+     * 'make_value' is only called when a counter is (re)assigned.
+     */
+    template <typename MakeValue> void add(uint64_t hash, MakeValue&& make_value);
+    void merge(const SpaceSaving& rhs);
+
+    // The tracked entries with the highest counts, highest first
+    std::vector<const Entry*> top(size_t n) const;
+
+    void serialize(vespalib::Serializer& os) const;
+    void deserialize(vespalib::Deserializer& is);
+};
+
+template <typename Value>
+template <typename MakeValue>
+void SpaceSaving<Value>::add(uint64_t hash, MakeValue&& make_value) {
+    auto found = _index.find(hash);
+    if (found != _index.end()) {
+        uint64_t count = ++_entries[found->second].count;
+        _max_count = std::max(_max_count, count);
+        sift_down(_heap_pos[found->second]);
+    } else if (_entries.size() < _capacity) {
+        uint32_t idx = _entries.size();
+        _entries.push_back(Entry{hash, 1, 0, make_value()});
+        _index[hash] = idx;
+        _heap_pos.push_back(_heap.size());
+        _heap.push_back(idx);
+        _max_count = std::max(_max_count, uint64_t(1));
+        sift_up(_heap.size() - 1);
+    } else if (_capacity > 0) {
+        uint32_t idx = _heap[0];
+        Entry&   entry = _entries[idx];
+        _index.erase(entry.hash);
+        entry.hash = hash;
+        entry.error = entry.count;
+        ++entry.count;
+        _max_count = std::max(_max_count, entry.count);
+        entry.value = make_value();
+        _index[hash] = idx;
+        sift_down(0);
+    }
+}
+
+template <typename Value> void SpaceSaving<Value>::rebuild(std::vector<Entry> entries) {
+    if (entries.size() > _capacity) {
+        auto by_count = [](const Entry& a, const Entry& b) noexcept {
+            return (a.count > b.count) || ((a.count == b.count) && (a.hash < b.hash));
+        };
+        std::nth_element(entries.begin(), entries.begin() + _capacity, entries.end(), by_count);
+        entries.resize(_capacity);
+    }
+    _entries = std::move(entries);
+    _index.clear();
+    _heap.clear();
+    _heap_pos.clear();
+    _max_count = 0;
+    for (uint32_t i = 0; i < _entries.size(); ++i) {
+        _max_count = std::max(_max_count, _entries[i].count);
+        _index[_entries[i].hash] = i;
+        _heap.push_back(i);
+        _heap_pos.push_back(i);
+    }
+    for (uint32_t pos = _heap.size() / 2; pos-- > 0;) {
+        sift_down(pos);
+    }
+}
+
+template <typename Value> void SpaceSaving<Value>::merge(const SpaceSaving& rhs) {
+    uint64_t           lhs_min = min_count();
+    uint64_t           rhs_min = rhs.min_count();
+    std::vector<Entry> merged;
+    merged.reserve(_entries.size() + rhs._entries.size());
+    for (auto& entry : _entries) {
+        auto found = rhs._index.find(entry.hash);
+        if (found != rhs._index.end()) {
+            entry.count += rhs._entries[found->second].count;
+            entry.error += rhs._entries[found->second].error;
+        } else {
+            entry.count += rhs_min;
+            entry.error += rhs_min;
+        }
+        merged.push_back(std::move(entry));
+    }
+    for (const auto& entry : rhs._entries) {
+        if (_index.find(entry.hash) == _index.end()) {
+            merged.push_back(Entry{entry.hash, entry.count + lhs_min, entry.error + lhs_min, entry.value});
+        }
+    }
+    _capacity = std::max(_capacity, rhs._capacity);
+    rebuild(std::move(merged));
+}
+
+template <typename Value> std::vector<const typename SpaceSaving<Value>::Entry*> SpaceSaving<Value>::top(size_t n) const {
+    std::vector<const Entry*> result;
+    result.reserve(_entries.size());
+    for (const auto& entry : _entries) {
+        result.push_back(&entry);
+    }
+    std::sort(result.begin(), result.end(), [](const Entry* a, const Entry* b) noexcept {
+        return (a->count > b->count) || ((a->count == b->count) && (a->hash < b->hash));
+    });
+    if (result.size() > n) {
+        result.resize(n);
+    }
+    return result;
+}
+
+template <typename Value> void SpaceSaving<Value>::serialize(vespalib::Serializer& os) const {
+    os << _capacity << static_cast<uint32_t>(_entries.size());
+    for (const auto& entry : _entries) {
+        os << entry.hash << entry.count << entry.error << entry.value;
+    }
+}
+
+template <typename Value> void SpaceSaving<Value>::deserialize(vespalib::Deserializer& is) {
+    uint32_t num_entries = 0;
+    is >> _capacity >> num_entries;
+    std::vector<Entry> entries(num_entries);
+    for (auto& entry : entries) {
+        is >> entry.hash >> entry.count >> entry.error >> entry.value;
+    }
+    rebuild(std::move(entries));
+}
+
+} // namespace search
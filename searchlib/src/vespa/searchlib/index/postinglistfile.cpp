@@ -75,6 +75,10 @@ PostingListHandle PostingListFileRandReadPassThrough::read_posting_list(const Di
     return _lower->read_posting_list(lookup_result);
 }
 
+void PostingListFileRandReadPassThrough::prefetch_posting_list(const DictionaryLookupResult& lookup_result) const {
+    _lower->prefetch_posting_list(lookup_result);
+}
+
 void PostingListFileRandReadPassThrough::consider_trim_posting_list(const DictionaryLookupResult& lookup_result,
                                                                     PostingListHandle&            handle,
                                                                     double bloat_factor) const {
@@ -168,6 +168,11 @@ public:
      */
     virtual PostingListHandle read_posting_list(const DictionaryLookupResult& lookup_result) = 0;
 
+    /**
+     * Start asynchronous readahead of posting list, to be read later using read_posting_list().
+     */
+    virtual void prefetch_posting_list(const DictionaryLookupResult& lookup_result) const = 0;
+
     /**
      * Remove directio padding from posting list if bloat is excessive.
      */
@@ -213,6 +218,7 @@ public:
                    const search::fef::TermFieldMatchDataArray& matchData) const override;
 
     PostingListHandle read_posting_list(const DictionaryLookupResult& lookup_result) override;
+    void prefetch_posting_list(const DictionaryLookupResult& lookup_result) const override;
     void consider_trim_posting_list(const DictionaryLookupResult& lookup_result, PostingListHandle& handle,
                                     double bloat_factor) const override;
     PostingListFileRange get_posting_list_file_range(const DictionaryLookupResult& lookup_result) const override;
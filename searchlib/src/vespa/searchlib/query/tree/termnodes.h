@@ -150,6 +150,8 @@ private:
     uint32_t    _target_num_hits;
     bool        _allow_approximate;
     HnswParams  _hnsw_params;
+    // Integer equality filters (field name, value) that all hits of the enclosing query must satisfy.
+    std::vector<std::pair<std::string, int64_t>> _equality_filters;
 
 public:
     NearestNeighborTerm(std::string_view query_tensor_name, std::string field_name, int32_t id, Weight weight,
@@ -158,7 +160,8 @@ public:
           _query_tensor_name(query_tensor_name),
           _target_num_hits(target_num_hits),
           _allow_approximate(allow_approximate),
-          _hnsw_params(std::move(hnsw_params)) {}
+          _hnsw_params(std::move(hnsw_params)),
+          _equality_filters() {}
     ~NearestNeighborTerm() override;
     const std::string& get_query_tensor_name() const { return _query_tensor_name; }
     uint32_t get_target_num_hits() const { return _target_num_hits; }
@@ -168,6 +171,10 @@ public:
     double get_distance_threshold() const {
         return _hnsw_params.distance_threshold.value_or(std::numeric_limits<double>::infinity());
     }
+    void add_equality_filter(std::string field_name, int64_t value) {
+        _equality_filters.emplace_back(std::move(field_name), value);
+    }
+    const std::vector<std::pair<std::string, int64_t>>& get_equality_filters() const { return _equality_filters; }
 };
 
 class MultiTerm : public Node {
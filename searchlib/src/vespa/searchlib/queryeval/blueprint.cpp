@@ -185,6 +185,9 @@ void Blueprint::each_node_post_order(const std::function<void(Blueprint&)>& f) {
     f(*this);
 }
 
+void Blueprint::prefetchPostings() {
+}
+
 void Blueprint::basic_plan(InFlow in_flow, uint32_t docid_limit) {
     auto opts_guard = bind_opts(Options().sort_by_cost(true));
     setDocIdLimit(docid_limit);
@@ -219,6 +222,9 @@ void Blueprint::set_global_filter(const GlobalFilter&, double) {
 void Blueprint::set_lazy_filter(const GlobalFilter&) {
 }
 
+void Blueprint::set_first_phase_score_threshold(const SharedScoreThreshold*) noexcept {
+}
+
 const Blueprint& Blueprint::root() const {
     const Blueprint* bp = this;
     while (bp->_parent != nullptr) {
@@ -681,6 +687,12 @@ void IntermediateBlueprint::visitMembers(vespalib::ObjectVisitor& visitor) const
     visit(visitor, "children", _children);
 }
 
+void IntermediateBlueprint::prefetchPostings() {
+    for (const auto& child : _children) {
+        child->prefetchPostings();
+    }
+}
+
 void IntermediateBlueprint::fetchPostings(const ExecuteInfo& execInfo) {
     auto flow = my_flow(InFlow(strict(), execInfo.hit_rate()));
     for (const auto& child : _children) {
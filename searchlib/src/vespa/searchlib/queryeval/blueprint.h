@@ -52,6 +52,7 @@ class EmptyBlueprint;
 class AlwaysTrueBlueprint;
 class QueryEvalStats;
 class NearestNeighborBlueprint;
+class SharedScoreThreshold;
 
 /**
  * A Blueprint is an intermediate representation of a search. More
@@ -445,12 +446,24 @@ public:
     static FlowStats default_flow_stats(uint32_t docid_limit, uint32_t abs_est, size_t child_cnt);
     static FlowStats default_flow_stats(size_t child_cnt);
 
+    // Called on the whole tree before fetchPostings. Leafs backed by
+    // disk can use this to start reading all posting lists needed by
+    // the query at once, letting the reads done in fetchPostings
+    // overlap instead of waiting for each of them in turn.
+    virtual void prefetchPostings();
     virtual void fetchPostings(const ExecuteInfo& execInfo) = 0;
     virtual void freeze() = 0;
     bool frozen() const { return _frozen; }
 
     virtual void set_matching_phase(MatchingPhase matching_phase) noexcept = 0;
 
+    // A score threshold shared between match threads during first
+    // phase matching, or nullptr. Leafs whose raw score is an upper
+    // bound for the first phase score may skip documents scoring at
+    // or below it. Intermediates only pass it to children that all
+    // their hits must match.
+    virtual void set_first_phase_score_threshold(const SharedScoreThreshold* threshold) noexcept;
+
 protected:
     virtual SearchIteratorUP createSearchImpl(fef::MatchData& md) const = 0;
     virtual SearchIteratorUP createFilterSearchImpl(FilterConstraint constraint) const = 0;
@@ -596,6 +609,7 @@ public:
                                                       fef::MatchData&       md) const = 0;
 
     void visitMembers(vespalib::ObjectVisitor& visitor) const override;
+    void prefetchPostings() final;
     void fetchPostings(const ExecuteInfo& execInfo) final;
     void freeze() final;
     void set_matching_phase(MatchingPhase matching_phase) noexcept override;
@@ -22,6 +22,7 @@ struct CreateBlueprintParams {
     vespalib::FuzzyMatchingAlgorithm  fuzzy_matching_algorithm;
     queryeval::wand::StopWordStrategy weakand_stop_word_strategy;
     std::optional<double>             filter_threshold;
+    bool                              weakand_block_max;
 
     CreateBlueprintParams(double global_filter_lower_limit_in, double global_filter_upper_limit_in,
                           double filter_first_upper_limit_in, double filter_first_exploration_in,
@@ -29,7 +30,7 @@ struct CreateBlueprintParams {
                           double                            target_hits_max_adjustment_factor_in,
                           vespalib::FuzzyMatchingAlgorithm  fuzzy_matching_algorithm_in,
                           queryeval::wand::StopWordStrategy weakand_stop_word_strategy_in,
-                          std::optional<double>             filter_threshold_in)
+                          std::optional<double> filter_threshold_in, bool weakand_block_max_in)
         : global_filter_lower_limit(global_filter_lower_limit_in),
           global_filter_upper_limit(global_filter_upper_limit_in),
           filter_first_upper_limit(filter_first_upper_limit_in),
@@ -39,7 +40,8 @@ struct CreateBlueprintParams {
           target_hits_max_adjustment_factor(target_hits_max_adjustment_factor_in),
           fuzzy_matching_algorithm(fuzzy_matching_algorithm_in),
           weakand_stop_word_strategy(weakand_stop_word_strategy_in),
-          filter_threshold(filter_threshold_in) {}
+          filter_threshold(filter_threshold_in),
+          weakand_block_max(weakand_block_max_in) {}
 
     CreateBlueprintParams()
         : CreateBlueprintParams(fef::indexproperties::matching::GlobalFilterLowerLimit::DEFAULT_VALUE,
@@ -50,7 +52,8 @@ struct CreateBlueprintParams {
                                 fef::indexproperties::matching::TensorsPrefetch::DEFAULT_VALUE,
                                 fef::indexproperties::matching::TargetHitsMaxAdjustmentFactor::DEFAULT_VALUE,
                                 fef::indexproperties::matching::FuzzyAlgorithm::DEFAULT_VALUE,
-                                queryeval::wand::StopWordStrategy::none(), std::nullopt) {}
+                                queryeval::wand::StopWordStrategy::none(), std::nullopt,
+                                fef::indexproperties::matching::WeakAndBlockMax::DEFAULT_VALUE) {}
 };
 
 } // namespace search::queryeval
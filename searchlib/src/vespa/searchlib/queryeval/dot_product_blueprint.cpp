@@ -5,13 +5,21 @@
 #include "dot_product_search.h"
 #include "field_spec.hpp"
 #include "flow_tuning.h"
+#include "posting_info.h"
 
 #include <vespa/vespalib/objects/visit.hpp>
 
+#include <limits>
+
 namespace search::queryeval {
 
 DotProductBlueprint::DotProductBlueprint(const FieldSpec& field)
-    : ComplexLeafBlueprint(field), _layout(), _weights(), _terms() {
+    : ComplexLeafBlueprint(field),
+      _layout(),
+      _weights(),
+      _terms(),
+      _matching_phase(MatchingPhase::FIRST_PHASE),
+      _first_phase_score_threshold(nullptr) {
 }
 
 DotProductBlueprint::~DotProductBlueprint() = default;
@@ -65,6 +73,20 @@ SearchIterator::UP DotProductBlueprint::createLeafSearch(const search::fef::Term
         children[i] = _terms[i]->createSearch(*md).release();
     }
     bool field_is_filter = getState().fields()[0].isFilter();
+    if (_matching_phase == MatchingPhase::FIRST_PHASE && _first_phase_score_threshold != nullptr) {
+        // children without weight bounds can not be skipped
+        std::vector<feature_t> max_scores;
+        max_scores.reserve(children.size());
+        for (size_t i = 0; i < children.size(); ++i) {
+            const auto* min_max = dynamic_cast<const MinMaxPostingInfo*>(children[i]->getPostingInfo());
+            max_scores.push_back((min_max != nullptr) ? DotProductSearch::max_child_score(_weights[i],
+                                                                                          min_max->getMinWeight(),
+                                                                                          min_max->getMaxWeight())
+                                                      : std::numeric_limits<feature_t>::infinity());
+        }
+        return DotProductSearch::create(children, *tfmda[0], field_is_filter, childMatch, _weights, std::move(md),
+                                        _first_phase_score_threshold, std::move(max_scores));
+    }
     return DotProductSearch::create(children, *tfmda[0], field_is_filter, childMatch, _weights, std::move(md));
 }
 
@@ -72,6 +94,12 @@ SearchIterator::UP DotProductBlueprint::createFilterSearchImpl(FilterConstraint
     return create_or_filter(_terms, constraint);
 }
 
+void DotProductBlueprint::prefetchPostings() {
+    for (size_t i = 0; i < _terms.size(); ++i) {
+        _terms[i]->prefetchPostings();
+    }
+}
+
 void DotProductBlueprint::fetchPostings(const ExecuteInfo& execInfo) {
     for (size_t i = 0; i < _terms.size(); ++i) {
         _terms[i]->fetchPostings(execInfo);
@@ -13,9 +13,11 @@ class TermFieldMatchData;
 namespace search::queryeval {
 
 class DotProductBlueprint : public ComplexLeafBlueprint {
-    fef::MatchDataLayout       _layout;
-    std::vector<int32_t>       _weights;
-    std::vector<Blueprint::UP> _terms;
+    fef::MatchDataLayout        _layout;
+    std::vector<int32_t>        _weights;
+    std::vector<Blueprint::UP>  _terms;
+    MatchingPhase               _matching_phase;
+    const SharedScoreThreshold* _first_phase_score_threshold;
 
 public:
     explicit DotProductBlueprint(const FieldSpec& field);
@@ -40,7 +42,12 @@ public:
     SearchIteratorUP createFilterSearchImpl(FilterConstraint constraint) const override;
 
     void visitMembers(vespalib::ObjectVisitor& visitor) const override;
+    void prefetchPostings() override;
     void fetchPostings(const ExecuteInfo& execInfo) override;
+    void set_matching_phase(MatchingPhase matching_phase) noexcept override { _matching_phase = matching_phase; }
+    void set_first_phase_score_threshold(const SharedScoreThreshold* threshold) noexcept override {
+        _first_phase_score_threshold = threshold;
+    }
 };
 
 } // namespace search::queryeval
@@ -3,9 +3,13 @@
 #include "dot_product_search.h"
 
 #include "iterator_pack.h"
+#include "shared_score_threshold.h"
 
 #include <vespa/vespalib/objects/visit.h>
 
+#include <algorithm>
+#include <limits>
+
 using search::fef::MatchData;
 using search::fef::TermFieldMatchData;
 using vespalib::ObjectVisitor;
@@ -34,11 +38,84 @@ private:
     IteratorPack          _children;
     bool                  _field_is_filter;
 
+    // state used to skip documents not scoring above the shared threshold
+    const SharedScoreThreshold* _score_threshold;
+    std::vector<feature_t>      _max_scores;            // upper bound for the contribution of each child
+    std::vector<ref_t>          _by_max_score;          // children ordered by increasing max score
+    feature_t                   _threshold;             // last seen value of the shared threshold
+    uint32_t                    _num_non_essential;     // number of leading children in _by_max_score not in heap
+    feature_t                   _non_essential_max;     // sum of max scores for the non-essential children
+    uint32_t                    _scored_docid;          // document scored while seeking
+    feature_t                   _score;                 // score of _scored_docid
+
     void seek_child(ref_t child, uint32_t docId) { _termPos[child] = _children.seek(child, docId); }
 
+    feature_t child_score(ref_t child, uint32_t docId) {
+        double tmp = _weights[child];
+        tmp *= _children.get_weight(child, docId);
+        return tmp;
+    }
+
+    // Children whose max scores sum up to at most the threshold can
+    // not produce a hit on their own. Such non-essential children are
+    // taken out of the heap, and only seeked when scoring documents
+    // matched by the essential children.
+    void update_threshold() {
+        feature_t threshold = _score_threshold->get();
+        if (threshold <= _threshold) {
+            return;
+        }
+        _threshold = threshold;
+        uint32_t  num_non_essential = _num_non_essential;
+        feature_t non_essential_max = _non_essential_max;
+        while ((num_non_essential < _by_max_score.size()) &&
+               (non_essential_max + _max_scores[_by_max_score[num_non_essential]] <= threshold))
+        {
+            non_essential_max += _max_scores[_by_max_score[num_non_essential++]];
+        }
+        if (num_non_essential != _num_non_essential) {
+            _num_non_essential = num_non_essential;
+            _non_essential_max = non_essential_max;
+            // rebuild the heap from the remaining essential children
+            std::copy(_by_max_score.begin() + num_non_essential, _by_max_score.end(),
+                      _data_space.begin() + num_non_essential);
+            _data_begin = _data_space.data() + num_non_essential;
+            _data_stash = _data_begin;
+        }
+    }
+
+    // Score a document matched by the essential children, returns
+    // whether the score exceeds the threshold. Non-essential children
+    // are visited from the highest max score, and scoring stops when
+    // the threshold can not be exceeded.
+    bool score_candidate(uint32_t docId) {
+        feature_t score = 0.0;
+        while ((_data_begin < _data_stash) && _termPos[HEAP::front(_data_begin, _data_stash)] == docId) {
+            HEAP::pop(_data_begin, _data_stash--, _cmpDocId);
+            score += child_score(*_data_stash, docId);
+        }
+        feature_t max_score = score + _non_essential_max;
+        for (uint32_t i = _num_non_essential; (i > 0) && (max_score > _threshold); --i) {
+            const ref_t child = _by_max_score[i - 1];
+            max_score -= _max_scores[child];
+            if (_termPos[child] < docId) {
+                seek_child(child, docId);
+            }
+            if (_termPos[child] == docId) {
+                feature_t tmp = child_score(child, docId);
+                score += tmp;
+                max_score += tmp;
+            }
+        }
+        _scored_docid = docId;
+        _score = score;
+        return (max_score > _threshold);
+    }
+
 public:
     DotProductSearchImpl(TermFieldMatchData& tmd, bool field_is_filter, const std::vector<int32_t>& weights,
-                         IteratorPack&& iteratorPack)
+                         IteratorPack&& iteratorPack, const SharedScoreThreshold* score_threshold,
+                         std::vector<feature_t> max_scores)
         : _tmd(tmd),
           _weights(weights),
           _termPos(weights.size()),
@@ -48,7 +125,15 @@ public:
           _data_stash(nullptr),
           _data_end(nullptr),
           _children(std::move(iteratorPack)),
-          _field_is_filter(field_is_filter) {
+          _field_is_filter(field_is_filter),
+          _score_threshold(score_threshold),
+          _max_scores(std::move(max_scores)),
+          _by_max_score(),
+          _threshold(-std::numeric_limits<feature_t>::infinity()),
+          _num_non_essential(0),
+          _non_essential_max(0.0),
+          _scored_docid(0),
+          _score(0.0) {
         HEAP::require_left_heap();
         assert(_weights.size() > 0);
         assert(_weights.size() == _children.size());
@@ -56,6 +141,13 @@ public:
         for (size_t i = 0; i < weights.size(); ++i) {
             _data_space.push_back(i);
         }
+        if (_score_threshold != nullptr) {
+            assert(_max_scores.size() == _weights.size());
+            _by_max_score = _data_space;
+            std::stable_sort(_by_max_score.begin(), _by_max_score.end(),
+                             [this](ref_t a, ref_t b) noexcept { return (_max_scores[a] < _max_scores[b]); });
+            _data_space = _by_max_score;
+        }
         _data_begin = &_data_space[0];
         _data_end = _data_begin + _data_space.size();
         if (_field_is_filter || _tmd.isNotNeeded()) {
@@ -65,26 +157,41 @@ public:
     ~DotProductSearchImpl() override;
 
     void doSeek(uint32_t docId) override {
-        while (_data_stash < _data_end) {
-            seek_child(*_data_stash, docId);
-            HEAP::push(_data_begin, ++_data_stash, _cmpDocId);
+        if (_score_threshold != nullptr) {
+            update_threshold();
+            if (_data_begin == _data_end) {
+                setAtEnd();
+                return;
+            }
         }
-        while (_termPos[HEAP::front(_data_begin, _data_stash)] < docId) {
-            seek_child(HEAP::front(_data_begin, _data_stash), docId);
-            HEAP::adjust(_data_begin, _data_stash, _cmpDocId);
+        for (;;) {
+            while (_data_stash < _data_end) {
+                seek_child(*_data_stash, docId);
+                HEAP::push(_data_begin, ++_data_stash, _cmpDocId);
+            }
+            while (_termPos[HEAP::front(_data_begin, _data_stash)] < docId) {
+                seek_child(HEAP::front(_data_begin, _data_stash), docId);
+                HEAP::adjust(_data_begin, _data_stash, _cmpDocId);
+            }
+            uint32_t candidate = _termPos[HEAP::front(_data_begin, _data_stash)];
+            if ((_num_non_essential == 0) || isAtEnd(candidate) || score_candidate(candidate)) {
+                setDocId(candidate);
+                return;
+            }
+            docId = candidate + 1;
         }
-        setDocId(_termPos[HEAP::front(_data_begin, _data_stash)]);
     }
 
     void doUnpack(uint32_t docId) override {
         if (!_field_is_filter && !_tmd.isNotNeeded()) {
+            if (_scored_docid == docId) {
+                _tmd.setRawScore(docId, _score);
+                return;
+            }
             feature_t score = 0.0;
             while ((_data_begin < _data_stash) && _termPos[HEAP::front(_data_begin, _data_stash)] == docId) {
                 HEAP::pop(_data_begin, _data_stash--, _cmpDocId);
-                const ref_t child = *_data_stash;
-                double      tmp = _weights[child];
-                tmp *= _children.get_weight(child, docId);
-                score += tmp;
+                score += child_score(*_data_stash, docId);
             };
             _tmd.setRawScore(docId, score);
         } else {
@@ -102,6 +209,7 @@ public:
         while (_data_stash < _data_end) {
             HEAP::push(_data_begin, ++_data_stash, _cmpDocId);
         }
+        _scored_docid = 0;
     }
     Trinary is_strict() const final { return Trinary::True; }
 
@@ -145,9 +253,26 @@ SingleTermDotProductSearch::~SingleTermDotProductSearch() = default;
 
 //-----------------------------------------------------------------------------
 
+namespace {
+
+// the threshold bounds the dot product only when it is part of the rank score
+const SharedScoreThreshold* usable_score_threshold(const SharedScoreThreshold* score_threshold,
+                                                   const TermFieldMatchData& tmd, bool field_is_filter) noexcept {
+    return (field_is_filter || tmd.isNotNeeded()) ? nullptr : score_threshold;
+}
+
+} // namespace
+
+feature_t DotProductSearch::max_child_score(int32_t weight, int32_t min_weight, int32_t max_weight) noexcept {
+    double tmp = weight;
+    return std::max({0.0, tmp * min_weight, tmp * max_weight});
+}
+
 SearchIterator::UP DotProductSearch::create(const std::vector<SearchIterator*>& children, TermFieldMatchData& tmd,
                                             bool field_is_filter, const std::vector<TermFieldMatchData*>& childMatch,
-                                            const std::vector<int32_t>& weights, MatchData::UP md) {
+                                            const std::vector<int32_t>& weights, MatchData::UP md,
+                                            const SharedScoreThreshold* score_threshold,
+                                            std::vector<feature_t>      max_scores) {
     using ArrayHeapImpl = DotProductSearchImpl<vespalib::LeftArrayHeap, SearchIteratorPack>;
     using HeapImpl = DotProductSearchImpl<vespalib::LeftHeap, SearchIteratorPack>;
 
@@ -155,28 +280,36 @@ SearchIterator::UP DotProductSearch::create(const std::vector<SearchIterator*>&
         return std::make_unique<SingleTermDotProductSearch>(tmd, SearchIterator::UP(children[0]), *childMatch[0],
                                                             weights[0], std::move(md));
     }
+    score_threshold = usable_score_threshold(score_threshold, tmd, field_is_filter);
     if (childMatch.size() < 128) {
         return std::make_unique<ArrayHeapImpl>(tmd, field_is_filter, weights,
-                                               SearchIteratorPack(children, childMatch, std::move(md)));
+                                               SearchIteratorPack(children, childMatch, std::move(md)),
+                                               score_threshold, std::move(max_scores));
     }
     return std::make_unique<HeapImpl>(tmd, field_is_filter, weights,
-                                      SearchIteratorPack(children, childMatch, std::move(md)));
+                                      SearchIteratorPack(children, childMatch, std::move(md)), score_threshold,
+                                      std::move(max_scores));
 }
 
 //-----------------------------------------------------------------------------
 
 SearchIterator::UP DotProductSearch::create(TermFieldMatchData& tmd, bool field_is_filter,
                                             const std::vector<int32_t>&            weights,
-                                            std::vector<DocidWithWeightIterator>&& iterators) {
+                                            std::vector<DocidWithWeightIterator>&& iterators,
+                                            const SharedScoreThreshold*            score_threshold,
+                                            std::vector<feature_t>                 max_scores) {
     using ArrayHeapImpl = DotProductSearchImpl<vespalib::LeftArrayHeap, DocidWithWeightIteratorPack>;
     using HeapImpl = DotProductSearchImpl<vespalib::LeftHeap, DocidWithWeightIteratorPack>;
 
+    score_threshold = usable_score_threshold(score_threshold, tmd, field_is_filter);
     if (iterators.size() < 128) {
         return std::make_unique<ArrayHeapImpl>(tmd, field_is_filter, weights,
-                                               DocidWithWeightIteratorPack(std::move(iterators)));
+                                               DocidWithWeightIteratorPack(std::move(iterators)), score_threshold,
+                                               std::move(max_scores));
     }
     return std::make_unique<HeapImpl>(tmd, field_is_filter, weights,
-                                      DocidWithWeightIteratorPack(std::move(iterators)));
+                                      DocidWithWeightIteratorPack(std::move(iterators)), score_threshold,
+                                      std::move(max_scores));
 }
 
 //-----------------------------------------------------------------------------
@@ -15,10 +15,19 @@ class TermFieldMatchData;
 
 namespace search::queryeval {
 
+class SharedScoreThreshold;
+
 /**
  * Search iterator for a sparse dot product, based on a set of child
  * search iterators.
  *
+ * When given a shared score threshold, documents whose dot product
+ * can not exceed the threshold are skipped. Children are ordered by
+ * the upper bound of their contribution (max_scores), and the
+ * children with the lowest bounds that together can not exceed the
+ * threshold are only seeked to score documents matched by the other
+ * children.
+ *
  * This class is a base class for a set of different instantiations of
  * DotProductSearchImpl, defined in the .cpp-file.
  */
@@ -30,16 +39,25 @@ public:
     static constexpr bool filter_search = false;
     static constexpr bool require_btree_iterators = true;
     static constexpr bool supports_hash_filter = false;
+    static constexpr bool supports_score_threshold = true;
+
+    // Upper bound for the contribution of a child with the given
+    // query weight when its document weights are in [min_weight, max_weight].
+    static feature_t max_child_score(int32_t weight, int32_t min_weight, int32_t max_weight) noexcept;
 
     // TODO: use MultiSearch::Children to pass ownership
     static SearchIterator::UP create(const std::vector<SearchIterator*>& children,
                                      search::fef::TermFieldMatchData& tmd, bool field_is_filter,
                                      const std::vector<fef::TermFieldMatchData*>& childMatch,
-                                     const std::vector<int32_t>& weights, fef::MatchData::UP md);
+                                     const std::vector<int32_t>& weights, fef::MatchData::UP md,
+                                     const SharedScoreThreshold* score_threshold = nullptr,
+                                     std::vector<feature_t>      max_scores = {});
 
     static SearchIterator::UP create(search::fef::TermFieldMatchData& tmd, bool field_is_filter,
                                      const std::vector<int32_t>&            weights,
-                                     std::vector<DocidWithWeightIterator>&& iterators);
+                                     std::vector<DocidWithWeightIterator>&& iterators,
+                                     const SharedScoreThreshold*            score_threshold = nullptr,
+                                     std::vector<feature_t>                 max_scores = {});
 };
 
 } // namespace search::queryeval
@@ -107,6 +107,12 @@ void EquivBlueprint::visitMembers(vespalib::ObjectVisitor& visitor) const {
     visit(visitor, "terms", _terms);
 }
 
+void EquivBlueprint::prefetchPostings() {
+    for (size_t i = 0; i < _terms.size(); ++i) {
+        _terms[i]->prefetchPostings();
+    }
+}
+
 void EquivBlueprint::fetchPostings(const ExecuteInfo& execInfo) {
     for (size_t i = 0; i < _terms.size(); ++i) {
         _terms[i]->fetchPostings(execInfo);
@@ -33,6 +33,7 @@ public:
     SearchIteratorUP createFilterSearchImpl(FilterConstraint constraint) const override;
 
     void visitMembers(vespalib::ObjectVisitor& visitor) const override;
+    void prefetchPostings() override;
     void fetchPostings(const ExecuteInfo& execInfo) override;
     bool isEquiv() const noexcept final { return true; }
 
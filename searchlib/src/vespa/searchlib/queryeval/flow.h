@@ -1,6 +1,8 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #pragma once
+#include "flow_cost_table.h"
+
 #include <vespa/vespalib/util/small_vector.h>
 
 #include <algorithm>
@@ -125,7 +127,7 @@ template <typename ADAPTER> struct MinOrCost {
 // non-strict context as well as calculating the change in cost when
 // changing the order of strict iterators.
 inline double strict_cost_diff(double before, double after) {
-    return 0.2 * (after - before);
+    return FlowCostTable::get().strict_cost_diff * (after - before);
 }
 
 // estimate the cost of evaluating a strict child in a non-strict context
@@ -0,0 +1,327 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "flow_calibrator.h"
+
+#include "andsearch.h"
+#include "executeinfo.h"
+#include "orsearch.h"
+#include "weighted_set_term_search.h"
+
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/searchcommon/attribute/search_context_params.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/attributevector.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/attribute/search_context.h>
+#include <vespa/searchlib/attribute/stringbase.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/bitvectoriterator.h>
+#include <vespa/searchlib/fef/matchdatalayout.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".queryeval.flow_calibrator");
+
+using search::attribute::BasicType;
+using search::attribute::CollectionType;
+using search::attribute::Config;
+using search::attribute::SearchContextParams;
+using search::fef::MatchDataLayout;
+using search::fef::TermFieldMatchData;
+using vespalib::BenchmarkTimer;
+
+namespace search::queryeval::flow {
+
+namespace {
+
+// Hit ratios of the posting lists and bitvectors used to calibrate leaf iterators.
+constexpr std::array<double, 3> estimates = {0.01, 0.1, 0.5};
+// Hit ratio of each child of heap based iterators.
+constexpr double heap_child_estimate = 0.01;
+// Lower bound for calibrated factors, avoiding zero (or negative) costs due to measurement noise.
+constexpr double min_factor = 0.01;
+
+// Attribute values are 1 + index into estimates, then heap_child_value(i) for heap children and 0 for the rest.
+int64_t estimate_value(size_t i) noexcept {
+    return 1 + i;
+}
+
+int64_t heap_child_value(size_t i) noexcept {
+    return 1 + estimates.size() + i;
+}
+
+double mean(const std::vector<double>& values) {
+    return std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+}
+
+/**
+ * Synthetic attributes and bitvectors with known hit ratios, and
+ * factory functions for iterators searching them.
+ **/
+class Corpus {
+    uint32_t                                               _docid_limit;
+    std::mt19937                                           _gen;
+    std::vector<int64_t>                                   _values;
+    AttributeVector::SP                                    _btree;
+    AttributeVector::SP                                    _lookup;
+    AttributeVector::SP                                    _lookup_array;
+    AttributeVector::SP                                    _lookup_string;
+    std::vector<std::unique_ptr<BitVector>>                _bitvectors;
+    std::vector<std::unique_ptr<attribute::SearchContext>> _contexts;
+    TermFieldMatchData                                     _tfmd;
+
+    AttributeVector::SP make_attribute(const std::string& name, BasicType basic_type, CollectionType col_type,
+                                       bool fast_search) const;
+
+public:
+    Corpus(uint32_t docid_limit, uint32_t num_heap_children);
+    ~Corpus();
+    uint32_t docid_limit() const noexcept { return _docid_limit; }
+    const AttributeVector& btree() const noexcept { return *_btree; }
+    const AttributeVector& lookup() const noexcept { return *_lookup; }
+    const AttributeVector& lookup_array() const noexcept { return *_lookup_array; }
+    const AttributeVector& lookup_string() const noexcept { return *_lookup_string; }
+    SearchIterator::UP attribute_term(const AttributeVector& attr, int64_t value, bool strict,
+                                      TermFieldMatchData& tfmd);
+    SearchIterator::UP attribute_term(const AttributeVector& attr, int64_t value, bool strict) {
+        return attribute_term(attr, value, strict, _tfmd);
+    }
+    SearchIterator::UP bitvector_term(size_t i, bool strict) {
+        return BitVectorIterator::create(_bitvectors[i].get(), _docid_limit, _tfmd, strict);
+    }
+};
+
+Corpus::Corpus(uint32_t docid_limit, uint32_t num_heap_children)
+    : _docid_limit(docid_limit),
+      _gen(42),
+      _values(docid_limit, 0),
+      _btree(),
+      _lookup(),
+      _lookup_array(),
+      _lookup_string(),
+      _bitvectors(),
+      _contexts(),
+      _tfmd() {
+    std::vector<double> weights;
+    for (double est : estimates) {
+        weights.push_back(est);
+    }
+    for (uint32_t i = 0; i < num_heap_children; ++i) {
+        weights.push_back(heap_child_estimate);
+    }
+    double rest = 1.0 - std::accumulate(weights.begin(), weights.end(), 0.0);
+    assert(rest > 0.0);
+    weights.insert(weights.begin(), rest);
+    std::discrete_distribution<int64_t> value_dist(weights.begin(), weights.end());
+    for (uint32_t docid = 1; docid < docid_limit; ++docid) {
+        _values[docid] = value_dist(_gen);
+    }
+    _btree = make_attribute("btree", BasicType::INT32, CollectionType::SINGLE, true);
+    _lookup = make_attribute("lookup", BasicType::INT32, CollectionType::SINGLE, false);
+    _lookup_array = make_attribute("lookup_array", BasicType::INT32, CollectionType::ARRAY, false);
+    _lookup_string = make_attribute("lookup_string", BasicType::STRING, CollectionType::SINGLE, false);
+    std::uniform_real_distribution<double> hit_dist(0.0, 1.0);
+    for (double est : estimates) {
+        auto bv = BitVector::create(docid_limit);
+        for (uint32_t docid = 1; docid < docid_limit; ++docid) {
+            if (hit_dist(_gen) < est) {
+                bv->setBit(docid);
+            }
+        }
+        bv->invalidateCachedCount();
+        _bitvectors.push_back(std::move(bv));
+    }
+}
+
+Corpus::~Corpus() = default;
+
+AttributeVector::SP Corpus::make_attribute(const std::string& name, BasicType basic_type, CollectionType col_type,
+                                           bool fast_search) const {
+    auto attr = AttributeFactory::createAttribute(name, Config(basic_type, col_type, fast_search));
+    attr->addReservedDoc();
+    attr->addDocs(_docid_limit - 1);
+    auto* integer = dynamic_cast<IntegerAttribute*>(attr.get());
+    auto* string = dynamic_cast<StringAttribute*>(attr.get());
+    for (uint32_t docid = 1; docid < _docid_limit; ++docid) {
+        int64_t value = _values[docid];
+        if (integer != nullptr) {
+            if (col_type == CollectionType::SINGLE) {
+                integer->update(docid, value);
+            } else {
+                integer->append(docid, value, 1);
+            }
+        } else {
+            string->update(docid, std::to_string(value));
+        }
+    }
+    attr->commit(CommitParam::UpdateStats::FORCE);
+    return attr;
+}
+
+SearchIterator::UP Corpus::attribute_term(const AttributeVector& attr, int64_t value, bool strict,
+                                          TermFieldMatchData& tfmd) {
+    auto term = std::make_unique<QueryTermSimple>(std::to_string(value), QueryTermSimple::Type::WORD);
+    auto ctx = attr.getSearch(std::move(term), SearchContextParams());
+    ctx->fetchPostings(ExecuteInfo::FULL, strict);
+    auto itr = ctx->createIterator(&tfmd, strict);
+    _contexts.push_back(std::move(ctx));
+    return itr;
+}
+
+uint32_t run_strict(SearchIterator& itr, uint32_t docid_limit) {
+    uint32_t hits = 0;
+    itr.initRange(1, docid_limit);
+    for (uint32_t docid = itr.seekFirst(1); docid < docid_limit; docid = itr.seekNext(docid + 1)) {
+        ++hits;
+    }
+    return hits;
+}
+
+uint32_t run_non_strict(SearchIterator& itr, uint32_t docid_limit) {
+    uint32_t hits = 0;
+    itr.initRange(1, docid_limit);
+    for (uint32_t docid = 1; docid < docid_limit; ++docid) {
+        if (itr.seek(docid)) {
+            ++hits;
+        }
+    }
+    return hits;
+}
+
+// Returns the time (in seconds) used per document in the corpus.
+template <typename Function> double time_per_doc(Function&& function, uint32_t docid_limit, double budget_s) {
+    return BenchmarkTimer::benchmark(function, budget_s) / docid_limit;
+}
+
+double time_strict(SearchIterator& itr, uint32_t docid_limit, double budget_s) {
+    return time_per_doc([&]() { run_strict(itr, docid_limit); }, docid_limit, budget_s);
+}
+
+double time_non_strict(SearchIterator& itr, uint32_t docid_limit, double budget_s) {
+    return time_per_doc([&]() { run_non_strict(itr, docid_limit); }, docid_limit, budget_s);
+}
+
+} // namespace
+
+FlowCostTable FlowCalibrator::calibrate(const FlowCostTable& base) const {
+    Corpus   corpus(_params.docid_limit, _params.num_heap_children);
+    uint32_t docid_limit = corpus.docid_limit();
+    double   budget_s = _params.budget_s;
+    auto     actual_estimate = [docid_limit](SearchIterator& itr) {
+        return double(run_strict(itr, docid_limit)) / docid_limit;
+    };
+
+    // The cost unit: time per hit when iterating a btree posting list strictly.
+    std::vector<double> btree_strict_per_hit;
+    std::vector<double> btree_non_strict;
+    std::vector<double> bitvector_strict_per_hit;
+    std::vector<double> bitvector_non_strict;
+    std::vector<double> btree_estimates;
+    for (size_t i = 0; i < estimates.size(); ++i) {
+        auto   btree = corpus.attribute_term(corpus.btree(), estimate_value(i), true);
+        double btree_est = actual_estimate(*btree);
+        btree_estimates.push_back(btree_est);
+        btree_strict_per_hit.push_back(time_strict(*btree, docid_limit, budget_s) / btree_est);
+        btree_non_strict.push_back(time_non_strict(*btree, docid_limit, budget_s));
+        auto   bv_strict = corpus.bitvector_term(i, true);
+        double bv_est = actual_estimate(*bv_strict);
+        bitvector_strict_per_hit.push_back(time_strict(*bv_strict, docid_limit, budget_s) / bv_est);
+        auto bv = corpus.bitvector_term(i, false);
+        bitvector_non_strict.push_back(time_non_strict(*bv, docid_limit, budget_s));
+    }
+    double        unit = mean(btree_strict_per_hit);
+    FlowCostTable table = base;
+    table.btree_strict = 1.0;
+    table.bitvector_strict = std::max(min_factor, mean(bitvector_strict_per_hit) / unit);
+    table.bitvector = std::max(min_factor, mean(bitvector_non_strict) / unit);
+    std::vector<double> non_strict_of_strict;
+    for (size_t i = 0; i < estimates.size(); ++i) {
+        double est = btree_estimates[i];
+        double modeled = table.btree_strict * est + base.strict_cost_diff * (0.5 - est);
+        non_strict_of_strict.push_back(btree_non_strict[i] / unit / modeled);
+    }
+    table.non_strict_of_strict = std::max(min_factor, mean(non_strict_of_strict));
+
+    // Lookups in attributes without fast-search; one lookup per document.
+    auto lookup = corpus.attribute_term(corpus.lookup(), estimate_value(1), false);
+    auto lookup_array = corpus.attribute_term(corpus.lookup_array(), estimate_value(1), false);
+    auto lookup_string = corpus.attribute_term(corpus.lookup_string(), estimate_value(1), false);
+    table.lookup = std::max(min_factor, time_non_strict(*lookup, docid_limit, budget_s) / unit);
+    double indirect = (time_non_strict(*lookup_array, docid_limit, budget_s) +
+                       time_non_strict(*lookup_string, docid_limit, budget_s)) /
+                      2.0 / unit;
+    table.lookup_indirection = std::max(min_factor, indirect - table.lookup);
+
+    // Heap based iterators; the time not spent in the children is attributed to the heap.
+    uint32_t            num_children = _params.num_heap_children;
+    std::vector<double> heap;
+    auto                calc_heap = [&](SearchIterator& itr) {
+        double est = actual_estimate(itr);
+        double children_cost = num_children * heap_child_estimate * table.btree_strict;
+        double self_cost = time_strict(itr, docid_limit, budget_s) / unit - children_cost;
+        return self_cost / (est * std::log2(std::max(2u, num_children)));
+    };
+    {
+        MultiSearch::Children children;
+        for (uint32_t i = 0; i < num_children; ++i) {
+            children.push_back(corpus.attribute_term(corpus.btree(), heap_child_value(i), true));
+        }
+        auto or_search = OrSearch::create(std::move(children), true);
+        heap.push_back(calc_heap(*or_search));
+    }
+    {
+        MatchDataLayout layout;
+        std::vector<fef::TermFieldHandle> handles;
+        for (uint32_t i = 0; i < num_children; ++i) {
+            handles.push_back(layout.allocTermField(0));
+        }
+        auto                         md = layout.createMatchData();
+        std::vector<SearchIterator*> children;
+        for (uint32_t i = 0; i < num_children; ++i) {
+            children.push_back(corpus
+                                   .attribute_term(corpus.btree(), heap_child_value(i), true,
+                                                   *md->resolveTermField(handles[i]))
+                                   .release());
+        }
+        TermFieldMatchData  tfmd;
+        std::vector<int32_t> weights(num_children, 1);
+        auto wset = WeightedSetTermSearch::create(children, tfmd, true, weights, std::move(md));
+        heap.push_back(calc_heap(*wset));
+    }
+    table.heap = std::max(min_factor, mean(heap));
+
+    // Intermediate activation: non-strict AND compared to seeking the same children directly.
+    {
+        MultiSearch::Children children;
+        children.push_back(corpus.bitvector_term(2, false));
+        children.push_back(corpus.bitvector_term(1, false));
+        auto   and_search = AndSearch::create(std::move(children), false);
+        double and_time = time_non_strict(*and_search, docid_limit, budget_s);
+        auto   first = corpus.bitvector_term(2, false);
+        auto   second = corpus.bitvector_term(1, false);
+        double direct_time = time_per_doc(
+            [&]() {
+                first->initRange(1, docid_limit);
+                second->initRange(1, docid_limit);
+                for (uint32_t docid = 1; docid < docid_limit; ++docid) {
+                    if (first->seek(docid)) {
+                        second->seek(docid);
+                    }
+                }
+            },
+            docid_limit, budget_s);
+        table.intermediate_activation = std::max(min_factor, (and_time - direct_time) / unit);
+    }
+    LOG(debug, "calibrate: unit=%gns, table=%s", unit * 1e9, table.to_json().c_str());
+    return table;
+}
+
+} // namespace search::queryeval::flow
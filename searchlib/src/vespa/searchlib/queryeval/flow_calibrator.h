@@ -0,0 +1,44 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "flow_cost_table.h"
+
+#include <cstdint>
+
+namespace search::queryeval::flow {
+
+/**
+ * Calibrates a FlowCostTable for the local hardware by micro
+ * benchmarking the actual iterator implementations on synthetic
+ * data: btree posting lists and lookups in attributes, bitvectors,
+ * AND, OR and weighted set term.
+ *
+ * Measured times are normalized by the time per hit of strict btree
+ * posting list iteration, which defines the cost unit. Factors that
+ * are not measured (disk index posting lists, which need files on
+ * disk, and reverse hash lookups) or that are not hardware dependent
+ * (strict_cost_diff) keep the value of the table given as base.
+ *
+ * Calibration takes a few seconds with the default parameters.
+ **/
+class FlowCalibrator {
+public:
+    struct Params {
+        uint32_t docid_limit;
+        uint32_t num_heap_children;
+        double   budget_s; // time budget for each benchmarked case
+        Params() noexcept : docid_limit(1'000'000), num_heap_children(16), budget_s(0.1) {}
+    };
+
+private:
+    Params _params;
+
+public:
+    FlowCalibrator() noexcept : FlowCalibrator(Params()) {}
+    explicit FlowCalibrator(const Params& params) noexcept : _params(params) {}
+    FlowCostTable calibrate(const FlowCostTable& base) const;
+    FlowCostTable calibrate() const { return calibrate(FlowCostTable()); }
+};
+
+} // namespace search::queryeval::flow
@@ -0,0 +1,90 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "flow_cost_table.h"
+
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/util/exceptions.h>
+
+#include <array>
+#include <utility>
+
+using vespalib::IllegalArgumentException;
+using vespalib::Memory;
+using vespalib::Slime;
+using vespalib::slime::JsonFormat;
+
+namespace search::queryeval::flow {
+
+namespace {
+
+using Factor = double FlowCostTable::*;
+
+constexpr std::array<std::pair<const char*, Factor>, 11> factors = {{
+    {"strict_cost_diff", &FlowCostTable::strict_cost_diff},
+    {"heap", &FlowCostTable::heap},
+    {"intermediate_activation", &FlowCostTable::intermediate_activation},
+    {"lookup", &FlowCostTable::lookup},
+    {"lookup_indirection", &FlowCostTable::lookup_indirection},
+    {"reverse_hash_lookup", &FlowCostTable::reverse_hash_lookup},
+    {"non_strict_of_strict", &FlowCostTable::non_strict_of_strict},
+    {"btree_strict", &FlowCostTable::btree_strict},
+    {"bitvector", &FlowCostTable::bitvector},
+    {"bitvector_strict", &FlowCostTable::bitvector_strict},
+    {"disk_index_strict", &FlowCostTable::disk_index_strict},
+}};
+
+} // namespace
+
+FlowCostTable FlowCostTable::_active;
+
+FlowCostTable::FlowCostTable() noexcept
+    : strict_cost_diff(0.2),
+      heap(1.0),
+      intermediate_activation(0.5),
+      lookup(1.0),
+      lookup_indirection(1.0),
+      reverse_hash_lookup(1.0),
+      non_strict_of_strict(2.0),
+      btree_strict(1.0),
+      bitvector(1.0),
+      bitvector_strict(1.5),
+      disk_index_strict(1.5) {
+}
+
+void FlowCostTable::to_slime(vespalib::slime::Cursor& obj) const {
+    for (const auto& [name, factor] : factors) {
+        obj.setDouble(name, this->*factor);
+    }
+}
+
+std::string FlowCostTable::to_json() const {
+    Slime slime;
+    to_slime(slime.setObject());
+    return slime.toString();
+}
+
+FlowCostTable FlowCostTable::from_slime(const vespalib::slime::Inspector& obj) {
+    FlowCostTable table;
+    for (const auto& [name, factor] : factors) {
+        const auto& value = obj[name];
+        if (value.valid()) {
+            table.*factor = value.asDouble();
+        }
+    }
+    return table;
+}
+
+FlowCostTable FlowCostTable::from_json(std::string_view json) {
+    Slime slime;
+    if (JsonFormat::decode(Memory(json), slime) == 0 || slime.get().type().getId() != vespalib::slime::OBJECT::ID) {
+        throw IllegalArgumentException("Flow cost table is not a valid json object", VESPA_STRLOC);
+    }
+    return from_slime(slime.get());
+}
+
+FlowCostTable FlowCostTable::load(const std::string& file_name) {
+    return from_json(vespalib::File::readAll(file_name));
+}
+
+} // namespace search::queryeval::flow
@@ -0,0 +1,62 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace vespalib::slime {
+struct Cursor;
+struct Inspector;
+} // namespace vespalib::slime
+
+namespace search::queryeval::flow {
+
+/**
+ * Hardware dependent factors used by the query planning cost model
+ * (see flow.h and flow_tuning.h). All costs are relative to the
+ * strict cost of iterating a btree posting list (cost 1.0 per hit).
+ *
+ * The defaults were derived by running
+ * searchlib/src/tests/queryeval/iterator_benchmark on a few
+ * different machines. A table matching the local hardware can be
+ * produced by FlowCalibrator (at startup or offline with
+ * vespa-calibrate-flow-costs) and installed with set().
+ *
+ * The active table is process global. It must only be changed
+ * before query planning starts (e.g. during startup), as planning
+ * threads read it without synchronization.
+ **/
+struct FlowCostTable {
+    double strict_cost_diff;        // penalty per unit of estimate when switching between strict and non-strict
+    double heap;                    // strict heap based iterators: heap * est * log2(children)
+    double intermediate_activation; // own per document cost of intermediate iterators (AND, OR, ...)
+    double lookup;                  // non-strict lookup in an attribute without fast-search
+    double lookup_indirection;      // additional lookup cost per memory indirection (string, multi-value)
+    double reverse_hash_lookup;     // non-strict reverse lookup of a document value in a hash of terms
+    double non_strict_of_strict;    // multiplier for always strict iterators evaluated in a non-strict context
+    double btree_strict;            // strict btree posting list (memory index, fast-search attribute)
+    double bitvector;               // non-strict bitvector
+    double bitvector_strict;        // strict bitvector
+    double disk_index_strict;       // strict disk index posting list
+
+    FlowCostTable() noexcept;
+    bool operator==(const FlowCostTable& rhs) const noexcept = default;
+
+    void to_slime(vespalib::slime::Cursor& obj) const;
+    std::string to_json() const;
+    // Factors missing in the input keep their default value.
+    static FlowCostTable from_slime(const vespalib::slime::Inspector& obj);
+    // Throws vespalib::IllegalArgumentException if the input is not a valid json object.
+    static FlowCostTable from_json(std::string_view json);
+    // Throws if the file cannot be read or does not contain a valid json object.
+    static FlowCostTable load(const std::string& file_name);
+
+    static const FlowCostTable& get() noexcept { return _active; }
+    static void set(const FlowCostTable& table) noexcept { _active = table; }
+
+private:
+    static FlowCostTable _active;
+};
+
+} // namespace search::queryeval::flow
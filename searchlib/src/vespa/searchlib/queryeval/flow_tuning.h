@@ -2,6 +2,7 @@
 
 #pragma once
 #include "flow.h"
+#include "flow_cost_table.h"
 
 #include <vespa/searchcommon/attribute/basictype.h>
 #include <vespa/searchcommon/attribute/collectiontype.h>
@@ -28,6 +29,8 @@ namespace search::queryeval::flow {
  * 'estimate' (legacy) and 'cost with allowed force strict' (new).
  * 'max_speedup' indicates the gain of using the new cost model, while 'min_speedup' indicates the loss.
  * The constants and formulas are also adjusted to maximize speedup, while reducing loss.
+ * The resulting constants are the defaults of FlowCostTable, which can be re-calibrated
+ * for the local hardware using FlowCalibrator.
  * Tests used:
  *   - IteratorBenchmark::analyze_AND_filter_vs_IN
  *   - IteratorBenchmark::analyze_AND_filter_vs_OR
@@ -43,13 +46,13 @@ namespace search::queryeval::flow {
  *   - IteratorBenchmark::analyze_OR_strict
  */
 inline double heap_cost(double my_est, size_t num_children) {
-    return my_est * std::log2(std::max(size_t(1), num_children));
+    return FlowCostTable::get().heap * my_est * std::log2(std::max(size_t(1), num_children));
 }
 
 // The activation cost of an intermediate blueprint: the per-node cost of
 // invoking its own iterator, excluding the flow cost of its children.
 inline double intermediate_activation_cost() {
-    return 0.5;
+    return FlowCostTable::get().intermediate_activation;
 }
 
 /**
@@ -77,13 +80,14 @@ inline double estimate_when_unknown() {
 // Non-strict cost of lookup based matching in an attribute (not fast-search).
 // Test used: IteratorBenchmark::analyze_term_search_in_attributes_non_strict
 inline double lookup_cost(size_t num_indirections) {
-    return 1.0 + (num_indirections * 1.0);
+    const auto& table = FlowCostTable::get();
+    return table.lookup + (num_indirections * table.lookup_indirection);
 }
 
 // Non-strict cost of reverse lookup into a hash table (containing terms from a multi-term operator).
 // Test used: IteratorBenchmark::analyze_IN_non_strict
 inline double reverse_hash_lookup() {
-    return 1.0;
+    return FlowCostTable::get().reverse_hash_lookup;
 }
 
 // Strict cost of lookup based matching in an attribute (not fast-search).
@@ -104,18 +108,18 @@ inline double lookup_strict_cost(size_t num_indirections) {
  * as the latency (time) penalty is higher if choosing wrong.
  */
 inline double non_strict_cost_of_strict_iterator(double estimate, double strict_cost) {
-    return 2.0 * (strict_cost + strict_cost_diff(estimate, 0.5));
+    return FlowCostTable::get().non_strict_of_strict * (strict_cost + strict_cost_diff(estimate, 0.5));
 }
 
 // Strict cost of matching in a btree posting list (e.g. fast-search attribute or memory index field).
 // Test used: IteratorBenchmark::analyze_term_search_in_fast_search_attributes
 inline double btree_strict_cost(double my_est) {
-    return my_est;
+    return FlowCostTable::get().btree_strict * my_est;
 }
 
 // Strict cost of matching in merged btree posting lists (e.g. range or prefix)
 inline double btree_strict_cost(double my_est, double merge_factor) {
-    return my_est * merge_factor;
+    return btree_strict_cost(my_est) * merge_factor;
 }
 
 // Non-strict cost of matching in a btree posting list (e.g. fast-search attribute or memory index field).
@@ -126,19 +130,19 @@ inline double btree_cost(double my_est) {
 
 // Non-strict cost of matching in a bitvector.
 inline double bitvector_cost() {
-    return 1.0;
+    return FlowCostTable::get().bitvector;
 }
 
 // Strict cost of matching in a bitvector.
 // Test used: IteratorBenchmark::analyze_btree_vs_bitvector_iterators_strict
 inline double bitvector_strict_cost(double my_est) {
-    return 1.5 * my_est;
+    return FlowCostTable::get().bitvector_strict * my_est;
 }
 
 // Strict cost of matching in a disk index posting list.
 // Test used: IteratorBenchmark::analyze_term_search_in_disk_index
 inline double disk_index_strict_cost(double my_est) {
-    return 1.5 * my_est;
+    return FlowCostTable::get().disk_index_strict * my_est;
 }
 
 // Non-strict cost of matching in a disk index posting list.
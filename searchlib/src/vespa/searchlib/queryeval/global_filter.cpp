@@ -4,14 +4,17 @@
 
 #include "blueprint.h"
 #include "profiled_iterator.h"
+#include "searchiterator.h"
 
 #include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/roaring_bitvector.h>
 #include <vespa/searchlib/engine/trace.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/util/execution_profiler.h>
 #include <vespa/vespalib/util/require.h>
 #include <vespa/vespalib/util/thread_bundle.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 
@@ -55,6 +58,16 @@ struct BitVectorFilter : public GlobalFilter {
     bool check(uint32_t docid) const override { return vector->testBit(docid); }
 };
 
+struct RoaringBitVectorFilter : public GlobalFilter {
+    std::unique_ptr<RoaringBitVector> vector;
+    explicit RoaringBitVectorFilter(std::unique_ptr<RoaringBitVector> vector_in) noexcept
+        : vector(std::move(vector_in)) {}
+    bool is_active() const override { return true; }
+    uint32_t size() const override { return vector->size(); }
+    uint32_t count() const override { return vector->countTrueBits(); }
+    bool check(uint32_t docid) const override { return vector->testBit(docid); }
+};
+
 struct MultiBitVectorFilter : public GlobalFilter {
     std::vector<std::unique_ptr<BitVector>> vectors;
     std::vector<uint32_t>                   splits;
@@ -79,24 +92,47 @@ struct MultiBitVectorFilter : public GlobalFilter {
 };
 
 struct PartResult {
-    Trinary                    matches_any;
-    std::unique_ptr<BitVector> bits;
-    PartResult() : matches_any(Trinary::False), bits() {}
-    explicit PartResult(Trinary matches_any_in) : matches_any(matches_any_in), bits() {}
+    Trinary                           matches_any;
+    std::unique_ptr<BitVector>        bits;
+    std::unique_ptr<RoaringBitVector> compact_bits;
+    PartResult() : matches_any(Trinary::False), bits(), compact_bits() {}
+    explicit PartResult(Trinary matches_any_in) : matches_any(matches_any_in), bits(), compact_bits() {}
     explicit PartResult(std::unique_ptr<BitVector>&& bits_in)
-        : matches_any(Trinary::Undefined), bits(std::move(bits_in)) {}
+        : matches_any(Trinary::Undefined), bits(std::move(bits_in)), compact_bits() {}
+    explicit PartResult(std::unique_ptr<RoaringBitVector>&& compact_bits_in)
+        : matches_any(Trinary::Undefined), bits(), compact_bits(std::move(compact_bits_in)) {}
 };
 
+// same as SearchIterator::get_hits, but with a RoaringBitVector result
+std::unique_ptr<RoaringBitVector> get_compact_hits(SearchIterator& filter, uint32_t begin_id) {
+    RoaringBitVector::Builder builder(begin_id, filter.getEndId());
+    uint32_t                  docid = std::max(begin_id, filter.getDocId());
+    while (!filter.isAtEnd(docid)) {
+        if (filter.seek(docid)) {
+            builder.set(docid);
+        }
+        docid = std::max(docid + 1, filter.getDocId());
+    }
+    return builder.build();
+}
+
 struct MakePart : Runnable {
     Blueprint&                         blueprint;
     uint32_t                           begin;
     uint32_t                           end;
+    bool                               compact;
     PartResult                         result;
     std::unique_ptr<Trace>             trace;
     std::unique_ptr<ExecutionProfiler> profiler;
     MakePart(MakePart&&) = default;
-    MakePart(Blueprint& blueprint_in, uint32_t begin_in, uint32_t end_in, Trace* parent_trace)
-        : blueprint(blueprint_in), begin(begin_in), end(end_in), result(), trace(), profiler() {
+    MakePart(Blueprint& blueprint_in, uint32_t begin_in, uint32_t end_in, bool compact_in, Trace* parent_trace)
+        : blueprint(blueprint_in),
+          begin(begin_in),
+          end(end_in),
+          compact(compact_in),
+          result(),
+          trace(),
+          profiler() {
         if (parent_trace && parent_trace->getLevel() > 0) {
             trace = parent_trace->make_trace_up();
             if (int32_t profile_depth = trace->match_profile_depth(); profile_depth != 0) {
@@ -119,10 +155,15 @@ struct MakePart : Runnable {
                 filter = ProfiledIterator::profile(*profiler, std::move(filter));
             }
             filter->initRange(begin, end);
-            auto bits = filter->get_hits(begin);
-            // count bits in parallel and cache the results for later
-            bits->countTrueBits();
-            result = PartResult(std::move(bits));
+            if (compact) {
+                // collect hits straight into roaring containers, no plain bitvector for the part
+                result = PartResult(get_compact_hits(*filter, begin));
+            } else {
+                auto bits = filter->get_hits(begin);
+                // count bits in parallel and cache the results for later
+                bits->countTrueBits();
+                result = PartResult(std::move(bits));
+            }
         } else {
             result = PartResult(matches_any);
         }
@@ -189,9 +230,15 @@ std::shared_ptr<GlobalFilter> GlobalFilter::create(std::vector<std::unique_ptr<B
     return std::make_shared<MultiBitVectorFilter>(std::move(vectors), std::move(splits), total_size, total_count);
 }
 
+std::shared_ptr<GlobalFilter> GlobalFilter::create(std::unique_ptr<RoaringBitVector> vector) {
+    return std::make_shared<RoaringBitVectorFilter>(std::move(vector));
+}
+
 std::shared_ptr<GlobalFilter> GlobalFilter::create(Blueprint& blueprint, uint32_t docid_limit,
                                                    ThreadBundle& thread_bundle, Trace* trace) {
     uint32_t              num_threads = thread_bundle.size();
+    bool                  compact =
+        RoaringBitVector::is_compact_preferred(blueprint.getState().estimate().estHits, docid_limit);
     std::vector<MakePart> parts;
     parts.reserve(num_threads);
     uint32_t docid = 1;
@@ -199,7 +246,7 @@ std::shared_ptr<GlobalFilter> GlobalFilter::create(Blueprint& blueprint, uint32_
     uint32_t rest_docs = (docid_limit - docid) % num_threads;
     while (docid < docid_limit) {
         uint32_t part_size = per_thread + (parts.size() < rest_docs);
-        parts.emplace_back(blueprint, docid, docid + part_size, trace);
+        parts.emplace_back(blueprint, docid, docid + part_size, compact, trace);
         docid += part_size;
     }
     assert(parts.size() <= num_threads);
@@ -207,6 +254,7 @@ std::shared_ptr<GlobalFilter> GlobalFilter::create(Blueprint& blueprint, uint32_
     thread_bundle.run(parts);
     insert_traces(trace, parts);
     std::vector<std::unique_ptr<BitVector>> vectors;
+    std::unique_ptr<RoaringBitVector>       compact_vector;
     vectors.reserve(parts.size());
     for (MakePart& part : parts) {
         switch (part.result.matches_any) {
@@ -215,9 +263,18 @@ std::shared_ptr<GlobalFilter> GlobalFilter::create(Blueprint& blueprint, uint32_
         case Trinary::True:
             return create(); // filter not needed after all
         case Trinary::Undefined:
-            vectors.push_back(std::move(part.result.bits));
+            if (part.result.compact_bits) {
+                // parts cover disjoint docid ranges
+                compact_vector = compact_vector ? RoaringBitVector::or_of(*compact_vector, *part.result.compact_bits)
+                                                : std::move(part.result.compact_bits);
+            } else {
+                vectors.push_back(std::move(part.result.bits));
+            }
         }
     }
+    if (compact_vector) {
+        return create(std::move(compact_vector));
+    }
     if (vectors.size() == 1) {
         return create(std::move(vectors[0]));
     }
@@ -11,7 +11,8 @@ struct ThreadBundle;
 }
 namespace search {
 class BitVector;
-}
+class RoaringBitVector;
+} // namespace search
 
 namespace search::engine {
 class Trace;
@@ -27,6 +28,9 @@ class Blueprint;
  * white-list (documents that may possibly become hits have their bit
  * set, documents that are certain to be filtered away should have
  * theirs cleared).
+ *
+ * Filters created from a blueprint with a low hit estimate are kept
+ * as a compressed (roaring) bitvector instead of a plain one.
  **/
 class GlobalFilter : public std::enable_shared_from_this<GlobalFilter> {
 public:
@@ -46,6 +50,7 @@ public:
     static std::shared_ptr<GlobalFilter> create(const std::vector<uint32_t>& docids, uint32_t size);
     static std::shared_ptr<GlobalFilter> create(std::unique_ptr<BitVector> vector);
     static std::shared_ptr<GlobalFilter> create(std::vector<std::unique_ptr<BitVector>> vectors);
+    static std::shared_ptr<GlobalFilter> create(std::unique_ptr<RoaringBitVector> vector);
     static std::shared_ptr<GlobalFilter> create(Blueprint& blueprint, uint32_t docid_limit,
                                                 vespalib::ThreadBundle& thread_bundle, Trace* trace);
     static std::shared_ptr<GlobalFilter> create(Blueprint& blueprint, uint32_t docid_limit,
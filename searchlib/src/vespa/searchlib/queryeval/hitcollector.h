@@ -10,6 +10,7 @@
 #include <vespa/vespalib/util/sort.h>
 
 #include <algorithm>
+#include <limits>
 #include <optional>
 #include <vector>
 
@@ -148,6 +149,16 @@ public:
      **/
     void addHit(uint32_t docId, feature_t score) { _collector->collect(docId, score); }
 
+    /**
+     * Returns the lowest rank score stored among the n (=maxHitsSize)
+     * best hits once more than n hits have been added, or -inf
+     * otherwise. A hit scoring below this will not be among the n
+     * best hits. Only valid while adding hits.
+     **/
+    feature_t get_min_kept_score() const noexcept {
+        return (_hitsSortOrder == SortOrder::HEAP) ? _hits[0].second : -std::numeric_limits<feature_t>::infinity();
+    }
+
     /**
      * Returns a sorted sequence of hits that reference internal
      * data. The number of hits returned in the sequence is controlled
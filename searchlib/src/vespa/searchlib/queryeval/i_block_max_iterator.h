@@ -0,0 +1,47 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace search::queryeval {
+
+/*
+ * Interface class for search iterators that can provide an upper bound on the number
+ * of occurrences (term frequency) for the skip block containing a given document,
+ * without changing the position of the iterator.
+ *
+ * Used by block-max weakAnd to skip over blocks where the sum of the score upper bounds
+ * cannot reach the current threshold.
+ */
+class IBlockMaxIterator {
+public:
+    static constexpr uint32_t unknown_max_num_occs = std::numeric_limits<uint32_t>::max();
+
+    struct BlockInfo {
+        uint32_t last_doc_id;  // last document covered by the block
+        uint32_t max_num_occs; // upper bound on number of occurrences in block
+    };
+
+    /*
+     * Returns true if block information is available, i.e. the underlying posting list
+     * has been written with per block max number of occurrences.
+     */
+    virtual bool has_block_max_info() const noexcept = 0;
+
+    /*
+     * Get block information for the block containing doc_id. doc_id must not be lower
+     * than the current document id of the iterator. A block with max_num_occs set to
+     * unknown_max_num_occs should be scored using the global upper bound for the term.
+     */
+    virtual BlockInfo get_block_info(uint32_t doc_id) = 0;
+
+    /*
+     * Number of occurrences for the current document id of the iterator.
+     */
+    virtual uint32_t get_num_occs() const noexcept = 0;
+    virtual ~IBlockMaxIterator() = default;
+};
+
+} // namespace search::queryeval
@@ -199,6 +199,12 @@ std::shared_ptr<GlobalFilter> AndNotBlueprint::create_lazy_filter() const {
     return children[0]->create_lazy_filter();
 }
 
+void AndNotBlueprint::set_first_phase_score_threshold(const SharedScoreThreshold* threshold) noexcept {
+    if (childCnt() > 0) {
+        getChild(0).set_first_phase_score_threshold(threshold);
+    }
+}
+
 AnyFlow AndNotBlueprint::my_flow(InFlow in_flow) const {
     return AnyFlow::create<AndNotFlow>(in_flow);
 }
@@ -305,6 +311,12 @@ std::shared_ptr<GlobalFilter> AndBlueprint::create_lazy_filter() const {
     return GlobalFilter::create();
 }
 
+void AndBlueprint::set_first_phase_score_threshold(const SharedScoreThreshold* threshold) noexcept {
+    for (size_t i = 0; i < childCnt(); ++i) {
+        getChild(i).set_first_phase_score_threshold(threshold);
+    }
+}
+
 AnyFlow AndBlueprint::my_flow(InFlow in_flow) const {
     return AnyFlow::create<AndFlow>(in_flow);
 }
@@ -412,7 +424,8 @@ WeakAndBlueprint::WeakAndBlueprint(uint32_t n, wand::StopWordStrategy stop_word_
       _n(n),
       _stop_word_strategy(stop_word_strategy),
       _weights(),
-      _matching_phase(MatchingPhase::FIRST_PHASE) {
+      _matching_phase(MatchingPhase::FIRST_PHASE),
+      _use_block_max(false) {
 }
 
 WeakAndBlueprint::~WeakAndBlueprint() = default;
@@ -501,6 +514,9 @@ SearchIterator::UP WeakAndBlueprint::createIntermediateSearch(MultiSearch::Child
     bool              readonly_scores_heap = (_matching_phase != MatchingPhase::FIRST_PHASE);
     wand::MatchParams innerParams{*_scores, _stop_word_strategy, wand::DEFAULT_PARALLEL_WAND_SCORES_ADJUST_FREQUENCY,
                                   get_docid_limit()};
+    if (_use_block_max) {
+        return WeakAndSearch::create_block_max(terms, innerParams, _n, strict(), readonly_scores_heap);
+    }
     return WeakAndSearch::create(terms, innerParams, wand::Bm25TermFrequencyScorer(get_docid_limit()), _n, strict(),
                                  readonly_scores_heap);
 }
@@ -736,6 +752,12 @@ SearchIterator::UP RankBlueprint::createFilterSearchImpl(FilterConstraint constr
     return create_first_child_filter(get_children(), constraint);
 }
 
+void RankBlueprint::set_first_phase_score_threshold(const SharedScoreThreshold* threshold) noexcept {
+    if (childCnt() > 0) {
+        getChild(0).set_first_phase_score_threshold(threshold);
+    }
+}
+
 AnyFlow RankBlueprint::my_flow(InFlow in_flow) const {
     return AnyFlow::create<RankFlow>(in_flow);
 }
@@ -796,6 +818,13 @@ SearchIterator::UP SourceBlenderBlueprint::createFilterSearchImpl(FilterConstrai
     return create_atmost_or_filter(get_children(), constraint);
 }
 
+// each hit is matched by the child of the source it is selected from
+void SourceBlenderBlueprint::set_first_phase_score_threshold(const SharedScoreThreshold* threshold) noexcept {
+    for (size_t i = 0; i < childCnt(); ++i) {
+        getChild(i).set_first_phase_score_threshold(threshold);
+    }
+}
+
 bool SourceBlenderBlueprint::isCompatibleWith(const SourceBlenderBlueprint& other) const {
     return (&_selector == &other._selector);
 }
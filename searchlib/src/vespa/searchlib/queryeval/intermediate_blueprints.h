@@ -33,6 +33,7 @@ public:
     SearchIterator::UP createIntermediateSearch(MultiSearch::Children subSearches, fef::MatchData& md) const override;
     SearchIterator::UP createFilterSearchImpl(FilterConstraint constraint) const override;
     std::shared_ptr<GlobalFilter> create_lazy_filter() const override;
+    void set_first_phase_score_threshold(const SharedScoreThreshold* threshold) noexcept override;
 
 private:
     AnyFlow my_flow(InFlow in_flow) const override;
@@ -59,6 +60,7 @@ public:
     SearchIterator::UP createIntermediateSearch(MultiSearch::Children subSearches, fef::MatchData& md) const override;
     SearchIterator::UP createFilterSearchImpl(FilterConstraint constraint) const override;
     std::shared_ptr<GlobalFilter> create_lazy_filter() const override;
+    void set_first_phase_score_threshold(const SharedScoreThreshold* threshold) noexcept override;
 
 private:
     AnyFlow my_flow(InFlow in_flow) const override;
@@ -96,6 +98,7 @@ private:
     wand::StopWordStrategy                _stop_word_strategy;
     std::vector<uint32_t>                 _weights;
     MatchingPhase                         _matching_phase;
+    bool                                  _use_block_max;
 
     AnyFlow my_flow(InFlow in_flow) const override;
     FlowStats self_flow_stats(double est, size_t num_children) const override;
@@ -122,6 +125,8 @@ public:
     uint32_t getN() const noexcept { return _n; }
     const std::vector<uint32_t>& getWeights() const noexcept { return _weights; }
     void set_matching_phase(MatchingPhase matching_phase) noexcept override;
+    void set_use_block_max(bool use_block_max) noexcept { _use_block_max = use_block_max; }
+    bool get_use_block_max() const noexcept { return _use_block_max; }
 };
 
 //-----------------------------------------------------------------------------
@@ -196,6 +201,7 @@ public:
     bool isRank() const noexcept final { return true; }
     SearchIterator::UP createIntermediateSearch(MultiSearch::Children subSearches, fef::MatchData& md) const override;
     SearchIterator::UP createFilterSearchImpl(FilterConstraint constraint) const override;
+    void set_first_phase_score_threshold(const SharedScoreThreshold* threshold) noexcept override;
     uint8_t calculate_cost_tier() const override {
         return (childCnt() > 0) ? get_children()[0]->getState().cost_tier() : State::COST_TIER_NORMAL;
     }
@@ -222,6 +228,7 @@ public:
     void sort(Children& children, InFlow in_flow) const override;
     SearchIterator::UP createIntermediateSearch(MultiSearch::Children subSearches, fef::MatchData& md) const override;
     SearchIterator::UP createFilterSearchImpl(FilterConstraint constraint) const override;
+    void set_first_phase_score_threshold(const SharedScoreThreshold* threshold) noexcept override;
 
     /** check if this blueprint has the same source selector as the other */
     bool isCompatibleWith(const SourceBlenderBlueprint& other) const;
@@ -22,6 +22,7 @@ protected:
     void clearUnpacked() { _needUnpack = 1; }
     uint32_t getNeedUnpack() const { return _needUnpack; }
     void incNeedUnpack() { ++_needUnpack; }
+    void addNeedUnpack(uint32_t skipped) { _needUnpack += skipped; }
 
 public:
     RankedSearchIteratorBase(fef::TermFieldMatchDataArray matchData);
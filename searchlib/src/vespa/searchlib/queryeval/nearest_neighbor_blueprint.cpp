@@ -110,7 +110,11 @@ NearestNeighborBlueprint::NearestNeighborBlueprint(const queryeval::FieldSpec&
       _pending_index_search(false),
       _matching_phase(MatchingPhase::FIRST_PHASE),
       _ann_stats(),
-      _eval_stats() {
+      _eval_stats(),
+      _partition_key(),
+      _nns_index(nullptr),
+      _index_docs(0),
+      _filter_restates_partition(false) {
     _distance_heap.set_distance_threshold(_hnsw_params.distance_threshold);
     uint32_t est_hits = _attr_tensor.get_num_docs();
     setEstimate(HitEstimate(est_hits, false));
@@ -119,8 +123,17 @@ NearestNeighborBlueprint::NearestNeighborBlueprint(const queryeval::FieldSpec&
 bool NearestNeighborBlueprint::want_global_filter(GlobalFilterLimits& limits) const {
     auto nns_index = _attr_tensor.nearest_neighbor_index();
     if (nns_index && _approximate) {
-        limits.lower_limit = _hnsw_params.global_filter_lower_limit;
-        limits.upper_limit = _hnsw_params.global_filter_upper_limit;
+        // The limits apply to hit ratios in the searched partition, while the caller compares them with the
+        // hit ratio of the query in the whole corpus.
+        double partition_share = 1.0;
+        auto   search_index = select_index();
+        if (search_index != nns_index) {
+            partition_share = std::min(static_cast<double>(search_index->get_partition_num_docs()) /
+                                           std::max(_attr_tensor.get_num_docs(), 1u),
+                                       1.0);
+        }
+        limits.lower_limit = _hnsw_params.global_filter_lower_limit * partition_share;
+        limits.upper_limit = _hnsw_params.global_filter_upper_limit * partition_share;
         return true;
     }
     return false;
@@ -131,14 +144,27 @@ void NearestNeighborBlueprint::set_global_filter(const GlobalFilter& global_filt
     _pending_index_search = false;
     _global_filter = global_filter.shared_from_this();
     _global_filter_set = true;
+    _filter_restates_partition = false;
     auto nns_index = _attr_tensor.nearest_neighbor_index();
     if (_approximate && nns_index) {
-        uint32_t est_hits = _attr_tensor.get_num_docs();
+        _nns_index = select_index();
+        _index_docs = _attr_tensor.get_num_docs();
+        bool partition = (_nns_index != nns_index);
+        if (partition) {
+            // All hits are in the partition, so hit ratios are relative to its size instead of the whole corpus.
+            uint32_t partition_docs = std::max(_nns_index->get_partition_num_docs(), 1u);
+            estimated_hit_ratio = std::min(estimated_hit_ratio * _index_docs / partition_docs, 1.0);
+            _index_docs = partition_docs;
+        }
+        uint32_t est_hits = _index_docs;
         if (_global_filter->is_active()) { // pre-filtering case
             _global_filter_hits = _global_filter->count();
-            _global_filter_hit_ratio = static_cast<double>(_global_filter_hits.value()) / est_hits;
+            _global_filter_hit_ratio = static_cast<double>(_global_filter_hits.value()) / _index_docs;
             est_hits = std::min(est_hits, _global_filter_hits.value());
-            if (_global_filter_hit_ratio.value() < _hnsw_params.global_filter_lower_limit) {
+            if (partition && _global_filter_hits.value() >= _index_docs) {
+                // The filter only restates the partition key
+                _filter_restates_partition = true;
+            } else if (_global_filter_hit_ratio.value() < _hnsw_params.global_filter_lower_limit) {
                 _algorithm = Algorithm::EXACT_FALLBACK;
                 setEstimate(HitEstimate(est_hits, false));
             }
@@ -180,7 +206,7 @@ void NearestNeighborBlueprint::perform_index_search(const vespalib::Deadline&
         _ann_stats.time_allocated = deadline.time_left();
 
         vespalib::Timer timer;
-        perform_top_k(_attr_tensor.nearest_neighbor_index(), deadline);
+        perform_top_k(deadline);
         _ann_stats.time_used = timer.elapsed();
 
         _ann_stats.terminated_early = deadline.was_missed();
@@ -193,25 +219,37 @@ void NearestNeighborBlueprint::perform_index_search(const vespalib::Deadline&
     }
 }
 
-void NearestNeighborBlueprint::perform_top_k(const search::tensor::NearestNeighborIndex* nns_index,
-                                             const vespalib::Deadline&                   doom) {
+const search::tensor::NearestNeighborIndex* NearestNeighborBlueprint::select_index() const {
+    auto nns_index = _attr_tensor.nearest_neighbor_index();
+    if (nns_index && _partition_key.has_value()) {
+        // The global filter is still applied, as it might contain other restrictions than the partition key.
+        if (auto partition = nns_index->get_partition(_partition_key.value())) {
+            return partition;
+        }
+    }
+    return nns_index;
+}
+
+void NearestNeighborBlueprint::perform_top_k(const vespalib::Deadline& doom) {
     uint32_t    k = _adjusted_target_hits;
     const auto& df = _distance_calc->function();
+    const auto* nns_index = _nns_index;
+    bool        use_global_filter = _global_filter->is_active() && !_filter_restates_partition;
     _ann_stats.index_stats.reset();
     if (_lazy_filter && _lazy_filter->is_active()) { // Global filter might or might not be active
         std::shared_ptr<const GlobalFilter> use_filter = _lazy_filter;
-        if (_global_filter->is_active()) { // Both global filter and lazy filter
+        if (use_global_filter) { // Both global filter and lazy filter
             use_filter = FallbackFilter::create(*_global_filter, *_lazy_filter);
         }
         _lazy_filter_hits = use_filter->count();
-        _lazy_filter_hit_ratio = static_cast<double>(_lazy_filter_hits.value()) / _attr_tensor.get_num_docs();
+        _lazy_filter_hit_ratio = static_cast<double>(_lazy_filter_hits.value()) / _index_docs;
         _low_hit_ratio = _lazy_filter_hit_ratio.value() < _hnsw_params.filter_first_upper_limit;
         _found_hits = nns_index->find_top_k_with_filter(
             _ann_stats.index_stats, k, df, *use_filter, _low_hit_ratio, _hnsw_params.filter_first_exploration,
             k + _hnsw_params.explore_additional_hits, _hnsw_params.exploration_slack, _hnsw_params.prefetch_tensors,
             doom, _hnsw_params.distance_threshold);
         _algorithm = Algorithm::INDEX_TOP_K_WITH_FILTER;
-    } else if (_global_filter->is_active()) {
+    } else if (use_global_filter) {
         _low_hit_ratio = _global_filter_hit_ratio.value() < _hnsw_params.filter_first_upper_limit;
         _found_hits = nns_index->find_top_k_with_filter(
             _ann_stats.index_stats, k, df, *_global_filter, _low_hit_ratio, _hnsw_params.filter_first_exploration,
@@ -270,6 +308,9 @@ void NearestNeighborBlueprint::visitMembers(vespalib::ObjectVisitor& visitor) co
 
     visitor.visitBool("wanted_approximate", _approximate);
     visitor.visitBool("has_index", _attr_tensor.nearest_neighbor_index());
+    if (_partition_key.has_value()) {
+        visitor.visitInt("partition_key", _partition_key.value());
+    }
     visitor.visitString("algorithm", to_string(_algorithm));
     if (_algorithm == Algorithm::INDEX_TOP_K_WITH_FILTER) {
         visitor.visitBool("filter_first_heuristic_used", _low_hit_ratio);
@@ -292,6 +333,9 @@ void NearestNeighborBlueprint::visitMembers(vespalib::ObjectVisitor& visitor) co
     if (_global_filter_hit_ratio.has_value()) {
         visitor.visitFloat("hit_ratio", _global_filter_hit_ratio.value());
     }
+    if (_partition_key.has_value()) {
+        visitor.visitBool("restates_partition", _filter_restates_partition);
+    }
     visitor.closeStruct();
 
     visitor.openStruct("lazy_filter", "LazyFilter");
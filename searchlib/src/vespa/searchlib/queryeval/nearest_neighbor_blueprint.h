@@ -76,10 +76,15 @@ private:
     MatchingPhase                                               _matching_phase;
     AnnStats                                                    _ann_stats;
     std::shared_ptr<QueryEvalStats>                             _eval_stats;
+    std::optional<int64_t>                                      _partition_key;
+    const search::tensor::NearestNeighborIndex*                 _nns_index;  // index (or partition) to search
+    uint32_t                                                    _index_docs; // number of documents in _nns_index
+    bool                                                        _filter_restates_partition;
 
     static double convert_distance_threshold(double                                    distance_threshold,
                                              const search::tensor::DistanceCalculator& distance_calc);
-    void perform_top_k(const search::tensor::NearestNeighborIndex* nns_index, const vespalib::Deadline& doom);
+    void perform_top_k(const vespalib::Deadline& doom);
+    const search::tensor::NearestNeighborIndex* select_index() const;
 
 public:
     NearestNeighborBlueprint(const queryeval::FieldSpec&                         field,
@@ -107,6 +112,14 @@ public:
     Algorithm get_algorithm() const { return _algorithm; }
     double get_distance_threshold() const { return _hnsw_params.distance_threshold; }
     const HnswParams& get_hnsw_params() const { return _hnsw_params; }
+    // Set the value of the partition attribute of a partitioned index that all hits must have (from an
+    // equality filter in the query). The index search then uses the index of that partition, and hit ratios
+    // are calculated against the number of documents in the partition.
+    void set_partition_key(int64_t key) noexcept { _partition_key = key; }
+    const std::optional<int64_t>& get_partition_key() const noexcept { return _partition_key; }
+    // Whether the global filter matches all documents in the searched partition, so the partition is searched
+    // without it.
+    bool filter_restates_partition() const noexcept { return _filter_restates_partition; }
 
     double sort(InFlow in_flow) override;
     FlowStats calculate_flow_stats(uint32_t docid_limit) const override {
@@ -0,0 +1,30 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <atomic>
+#include <limits>
+
+namespace search::queryeval {
+
+/**
+ * A score threshold shared between match threads. Hits scoring at or
+ * below the threshold can not be among the best hits of the query.
+ * The threshold is only ever raised. It starts at -inf.
+ */
+class SharedScoreThreshold {
+private:
+    std::atomic<double> _score;
+
+public:
+    SharedScoreThreshold() noexcept : _score(-std::numeric_limits<double>::infinity()) {}
+    double get() const noexcept { return _score.load(std::memory_order_relaxed); }
+    // raise the threshold to the given score unless it is already higher
+    void raise(double score) noexcept {
+        double current = _score.load(std::memory_order_relaxed);
+        while ((score > current) && !_score.compare_exchange_weak(current, score, std::memory_order_relaxed)) {
+        }
+    }
+};
+
+} // namespace search::queryeval
@@ -88,6 +88,12 @@ SearchIterator::UP SimplePhraseBlueprint::createFilterSearchImpl(FilterConstrain
     return create_atmost_and_filter(_terms, constraint);
 }
 
+void SimplePhraseBlueprint::prefetchPostings() {
+    for (auto& term : _terms) {
+        term->prefetchPostings();
+    }
+}
+
 void SimplePhraseBlueprint::fetchPostings(const ExecuteInfo& execInfo) {
     for (auto& term : _terms) {
         term->fetchPostings(execInfo);
@@ -41,6 +41,7 @@ public:
     SearchIteratorUP createLeafSearch(const fef::TermFieldMatchDataArray& tfmda) const override;
     SearchIteratorUP createFilterSearchImpl(FilterConstraint constraint) const override;
     void visitMembers(vespalib::ObjectVisitor& visitor) const override;
+    void prefetchPostings() override;
     void fetchPostings(const ExecuteInfo& execInfo) override;
 };
 
@@ -25,7 +25,8 @@ ParallelWeakAndBlueprint::ParallelWeakAndBlueprint(FieldSpecBase field, uint32_t
       _layout(),
       _weights(),
       _terms(),
-      _matching_phase(MatchingPhase::FIRST_PHASE) {
+      _matching_phase(MatchingPhase::FIRST_PHASE),
+      _first_phase_score_threshold(nullptr) {
 }
 
 ParallelWeakAndBlueprint::~ParallelWeakAndBlueprint() = default;
@@ -80,10 +81,13 @@ ParallelWeakAndBlueprint::createLeafSearch(const search::fef::TermFieldMatchData
                            childState.estimate().estHits, childState.field(0).resolve(*childrenMatchData));
     }
     bool readonly_scores_heap = (_matching_phase != MatchingPhase::FIRST_PHASE);
+    // the shared threshold only bounds the first phase score when it is calculated from our raw score
+    const SharedScoreThreshold* first_phase_score_threshold =
+        (readonly_scores_heap || tfmda[0]->isNotNeeded()) ? nullptr : _first_phase_score_threshold;
     return ParallelWeakAndSearch::create(
         terms,
         ParallelWeakAndSearch::MatchParams(*_scores, _scoreThreshold, _thresholdBoostFactor, _scoresAdjustFrequency,
-                                           get_docid_limit()),
+                                           get_docid_limit(), first_phase_score_threshold),
         ParallelWeakAndSearch::RankParams(*tfmda[0], std::move(childrenMatchData)), strict(), readonly_scores_heap);
 }
 
@@ -91,6 +95,12 @@ std::unique_ptr<SearchIterator> ParallelWeakAndBlueprint::createFilterSearchImpl
     return create_atmost_or_filter(_terms, constraint);
 }
 
+void ParallelWeakAndBlueprint::prefetchPostings() {
+    for (const auto& _term : _terms) {
+        _term->prefetchPostings();
+    }
+}
+
 void ParallelWeakAndBlueprint::fetchPostings(const ExecuteInfo& execInfo) {
     for (const auto& _term : _terms) {
         _term->fetchPostings(execInfo);
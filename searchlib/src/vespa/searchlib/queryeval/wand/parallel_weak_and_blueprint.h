@@ -28,6 +28,7 @@ private:
     std::vector<int32_t>                  _weights;
     std::vector<Blueprint::UP>            _terms;
     MatchingPhase                         _matching_phase;
+    const SharedScoreThreshold*           _first_phase_score_threshold;
 
 public:
     ParallelWeakAndBlueprint(const ParallelWeakAndBlueprint&) = delete;
@@ -59,9 +60,13 @@ public:
     SearchIterator::UP createLeafSearch(const fef::TermFieldMatchDataArray& tfmda) const override;
     std::unique_ptr<SearchIterator> createFilterSearchImpl(FilterConstraint constraint) const override;
     void visitMembers(vespalib::ObjectVisitor& visitor) const override;
+    void prefetchPostings() override;
     void fetchPostings(const ExecuteInfo& execInfo) override;
     bool always_needs_unpack() const override;
     void set_matching_phase(MatchingPhase matching_phase) noexcept override;
+    void set_first_phase_score_threshold(const SharedScoreThreshold* threshold) noexcept override {
+        _first_phase_score_threshold = threshold;
+    }
 };
 
 } // namespace search::queryeval
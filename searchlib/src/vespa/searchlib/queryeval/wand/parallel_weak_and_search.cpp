@@ -5,8 +5,12 @@
 #include <vespa/searchlib/fef/matchdatalayout.h>
 #include <vespa/searchlib/queryeval/docid_with_weight_search_iterator.h>
 #include <vespa/searchlib/queryeval/monitoring_dump_iterator.h>
+#include <vespa/searchlib/queryeval/shared_score_threshold.h>
 #include <vespa/vespalib/objects/visit.h>
 
+#include <algorithm>
+#include <cmath>
+
 #include <vespa/log/log.h>
 LOG_SETUP(".queryeval.parallel_weak_and_search");
 
@@ -22,6 +26,13 @@ namespace {
 bool should_monitor_wand() {
     return LOG_WOULD_LOG(spam);
 }
+
+// wand scores are integers, so a score exceeds the first phase score
+// threshold exactly when it exceeds the floor of the threshold
+score_t to_wand_threshold(double first_phase_score_threshold) noexcept {
+    constexpr double limit = 0x1p62;
+    return score_t(std::clamp(std::floor(first_phase_score_threshold), -limit, limit));
+}
 } // namespace
 
 template <typename VectorizedTerms, typename FutureHeap, typename PastHeap, bool IS_STRICT>
@@ -90,6 +101,9 @@ public:
 
     void doSeek(uint32_t docid) override {
         updateThreshold(_matchParams.scores.getMinScore());
+        if (_matchParams.firstPhaseScoreThreshold != nullptr) {
+            updateThreshold(to_wand_threshold(_matchParams.firstPhaseScoreThreshold->get()));
+        }
         if (IS_STRICT) {
             seek_strict(docid);
         } else {
@@ -10,6 +10,8 @@
 
 namespace search::queryeval {
 
+class SharedScoreThreshold;
+
 /**
  * WAND search iterator that uses a shared heap between match threads.
  */
@@ -21,18 +23,21 @@ struct ParallelWeakAndSearch : public SearchIterator {
      * Params used to tweak the behavior of the WAND algorithm.
      */
     struct MatchParams {
-        WeakAndHeap&   scores;
-        score_t        scoreThreshold;
-        const uint32_t scoresAdjustFrequency;
-        const double   thresholdBoostFactor;
-        const docid_t  docIdLimit;
+        WeakAndHeap&                scores;
+        score_t                     scoreThreshold;
+        const uint32_t              scoresAdjustFrequency;
+        const double                thresholdBoostFactor;
+        const docid_t               docIdLimit;
+        const SharedScoreThreshold* firstPhaseScoreThreshold; // optional, raises the threshold while matching
         MatchParams(WeakAndHeap& scores_in, score_t scoreThreshold_in, double thresholdBoostFactor_in,
-                    uint32_t scoresAdjustFrequency_in, uint32_t docIdLimit_in) noexcept
+                    uint32_t scoresAdjustFrequency_in, uint32_t docIdLimit_in,
+                    const SharedScoreThreshold* firstPhaseScoreThreshold_in = nullptr) noexcept
             : scores(scores_in),
               scoreThreshold(scoreThreshold_in),
               scoresAdjustFrequency(scoresAdjustFrequency_in),
               thresholdBoostFactor(thresholdBoostFactor_in),
-              docIdLimit(docIdLimit_in) {}
+              docIdLimit(docIdLimit_in),
+              firstPhaseScoreThreshold(firstPhaseScoreThreshold_in) {}
     };
 
     /**
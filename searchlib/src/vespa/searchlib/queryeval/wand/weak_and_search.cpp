@@ -4,6 +4,7 @@
 
 #include "weak_and_heap.h"
 
+#include <vespa/searchlib/queryeval/i_block_max_iterator.h>
 #include <vespa/searchlib/queryeval/orsearch.h>
 #include <vespa/vespalib/util/left_right_heap.h>
 #include <vespa/vespalib/util/priority_queue.h>
@@ -123,6 +124,242 @@ public:
 template <typename FutureHeap, typename PastHeap, bool IS_STRICT>
 WeakAndSearchLR<FutureHeap, PastHeap, IS_STRICT>::~WeakAndSearchLR() = default;
 
+//-----------------------------------------------------------------------------
+
+/**
+ * Term frequency aware scoring used by block-max weakAnd. The score
+ * for a term is the bm25 max score scaled by tf / (tf + k1), thus
+ * a bound on the number of occurrences for a block of documents
+ * gives a bound on the term score for the block.
+ */
+class BlockMaxTermScorer {
+    static constexpr double k1 = 1.2;
+
+public:
+    static score_t calculate_score(score_t max_score, uint32_t num_occs) noexcept {
+        if (num_occs == IBlockMaxIterator::unknown_max_num_occs) {
+            return max_score;
+        }
+        double tf = num_occs;
+        return score_t(max_score * (tf / (tf + k1)));
+    }
+};
+
+/**
+ * WeakAnd using block-max WAND (Ding and Suel). Terms are kept
+ * ordered by current document id. When the sum of max scores reaches
+ * the threshold at a pivot document, the per block max number of
+ * occurrences from the posting lists is used to check if the blocks
+ * covering the pivot document can beat the threshold before any of
+ * the posting lists are moved to the pivot. If not, the blocks are
+ * skipped. Terms not exposing block max information are scored with
+ * their max score.
+ */
+template <bool IS_STRICT> class BlockMaxWeakAndSearch final : public WeakAndSearch {
+private:
+    VectorizedIteratorTerms         _terms;
+    std::vector<IBlockMaxIterator*> _block_max;
+    std::vector<ref_t>              _order; // terms ordered by current document id
+    score_t                         _threshold;
+    score_t                         _score; // score for current hit
+    MatchParams                     _matchParams;
+    std::vector<score_t>            _localScores;
+    const uint32_t                  _n;
+    const bool                      _readonly_scores_heap;
+
+    void setup_block_max() {
+        const auto& terms = _terms.input_terms();
+        _block_max.clear();
+        for (const auto& term : terms) {
+            _block_max.push_back(dynamic_cast<IBlockMaxIterator*>(term.search));
+        }
+    }
+    void sort_order() {
+        std::sort(_order.begin(), _order.end(),
+                  [this](ref_t a, ref_t b) noexcept { return _terms.docId(a) < _terms.docId(b); });
+    }
+    score_t block_max_score(ref_t ref, docid_t docid, docid_t& last_docid) {
+        IBlockMaxIterator* block_max = _block_max[ref];
+        if (block_max == nullptr) {
+            return _terms.maxScore(ref);
+        }
+        auto block_info = block_max->get_block_info(docid);
+        last_docid = std::min(last_docid, block_info.last_doc_id);
+        return BlockMaxTermScorer::calculate_score(_terms.maxScore(ref), block_info.max_num_occs);
+    }
+    score_t term_score(ref_t ref) const {
+        IBlockMaxIterator* block_max = _block_max[ref];
+        if (block_max == nullptr) {
+            return _terms.maxScore(ref);
+        }
+        return BlockMaxTermScorer::calculate_score(_terms.maxScore(ref), block_max->get_num_occs());
+    }
+    // Move terms [0, end) in docid order that are positioned before docid
+    void advance_terms(size_t end, docid_t docid) {
+        for (size_t i = 0; i < end; ++i) {
+            ref_t ref = _order[i];
+            if (_terms.docId(ref) < docid) {
+                _terms.docId(ref) = _terms.seek(ref, docid);
+            }
+        }
+        sort_order();
+    }
+
+    void seek_strict(docid_t docid) {
+        advance_terms(_order.size(), docid);
+        for (;;) {
+            // Find pivot term using max scores
+            score_t upper_bound = 0;
+            size_t  pivot = 0;
+            for (; pivot < _order.size() && _terms.docId(_order[pivot]) != search::endDocId; ++pivot) {
+                upper_bound += _terms.maxScore(_order[pivot]);
+                if (upper_bound >= _threshold) {
+                    break;
+                }
+            }
+            if (pivot == _order.size() || _terms.docId(_order[pivot]) == search::endDocId) {
+                setAtEnd();
+                return;
+            }
+            docid_t pivot_docid = _terms.docId(_order[pivot]);
+            while (pivot + 1 < _order.size() && _terms.docId(_order[pivot + 1]) == pivot_docid) {
+                ++pivot;
+            }
+            // Check block max bound for pivot document
+            docid_t last_docid = search::endDocId - 1;
+            score_t block_upper_bound = 0;
+            for (size_t i = 0; i <= pivot; ++i) {
+                block_upper_bound += block_max_score(_order[i], pivot_docid, last_docid);
+            }
+            docid_t next_docid;
+            if (block_upper_bound >= _threshold) {
+                if (_terms.docId(_order[0]) != pivot_docid) {
+                    advance_terms(pivot, pivot_docid);
+                    continue;
+                }
+                score_t score = 0;
+                for (size_t i = 0; i <= pivot; ++i) {
+                    score += term_score(_order[i]);
+                }
+                if (score >= _threshold) {
+                    _score = score;
+                    setDocId(pivot_docid);
+                    return;
+                }
+                next_docid = pivot_docid + 1;
+            } else {
+                // Skip blocks, bounded by next term not included in the bound
+                next_docid = last_docid + 1;
+                if (pivot + 1 < _order.size()) {
+                    next_docid = std::min(next_docid, _terms.docId(_order[pivot + 1]));
+                }
+            }
+            advance_terms(pivot + 1, next_docid);
+        }
+    }
+
+    void seek_unstrict(docid_t docid) {
+        docid_t last_docid = search::endDocId - 1;
+        score_t upper_bound = 0;
+        for (ref_t ref : _order) {
+            if (_terms.docId(ref) <= docid) {
+                upper_bound += block_max_score(ref, docid, last_docid);
+            }
+        }
+        if (upper_bound < _threshold) {
+            return;
+        }
+        score_t score = 0;
+        for (ref_t ref : _order) {
+            if (_terms.docId(ref) < docid) {
+                _terms.docId(ref) = _terms.seek(ref, docid);
+            }
+            if (_terms.docId(ref) == docid) {
+                score += term_score(ref);
+            }
+        }
+        if (score >= _threshold) {
+            _score = score;
+            setDocId(docid);
+        }
+    }
+    void updateThreshold(score_t newThreshold) {
+        if (newThreshold > _threshold) {
+            _threshold = newThreshold;
+        }
+    }
+
+public:
+    template <typename Scorer>
+    BlockMaxWeakAndSearch(const Terms& terms, const MatchParams& matchParams, const Scorer& scorer, uint32_t n,
+                          bool readonly_scores_heap)
+        : _terms(terms, scorer, matchParams.docid_limit, {}),
+          _block_max(),
+          _order(),
+          _threshold(BlockMaxTermScorer::calculate_score(
+              initial_wand_threshold(scorer, terms, matchParams.stop_words), 1)),
+          _score(0),
+          _matchParams(matchParams),
+          _localScores(),
+          _n(n),
+          _readonly_scores_heap(readonly_scores_heap) {
+        setup_block_max();
+        _order.reserve(_terms.size());
+        for (size_t i = 0; i < _terms.size(); ++i) {
+            _order.push_back(i);
+        }
+        _threshold = std::max(score_t(1), _threshold);
+        _localScores.reserve(_matchParams.scoresAdjustFrequency);
+    }
+    ~BlockMaxWeakAndSearch() override;
+    size_t get_num_terms() const override { return _terms.size(); }
+    int32_t get_term_weight(size_t idx) const override { return _terms.weight(idx); }
+    score_t get_max_score(size_t idx) const override { return _terms.maxScore(idx); }
+    const Terms& getTerms() const override { return _terms.input_terms(); }
+    uint32_t getN() const override { return _n; }
+    void transform_children(std::function<SearchIterator::UP(SearchIterator::UP)> f) override {
+        _terms.transform_children(std::move(f));
+        setup_block_max();
+    }
+    void doSeek(uint32_t docid) override {
+        updateThreshold(_matchParams.scores.getMinScore());
+        if (IS_STRICT) {
+            seek_strict(docid);
+        } else {
+            seek_unstrict(docid);
+        }
+    }
+    void doUnpack(uint32_t docid) override {
+        if (!_readonly_scores_heap) {
+            _localScores.push_back(_score);
+            if (_localScores.size() == _matchParams.scoresAdjustFrequency) {
+                _matchParams.scores.adjust(&_localScores[0], &_localScores[0] + _localScores.size());
+                _localScores.clear();
+            }
+        }
+        for (ref_t ref : _order) {
+            if (_terms.docId(ref) == docid) {
+                _terms.unpack(ref, docid);
+            }
+        }
+    }
+    void initRange(uint32_t begin, uint32_t end) override {
+        WeakAndSearch::initRange(begin, end);
+        _terms.iteratorPack().initRange(begin, end);
+        for (size_t i = 0; i < _terms.size(); ++i) {
+            _terms.docId(i) = _terms.iteratorPack().get_docid(i);
+        }
+        sort_order();
+        if (_n == 0) {
+            setAtEnd();
+        }
+    }
+    Trinary is_strict() const override { return IS_STRICT ? Trinary::True : Trinary::False; }
+};
+
+template <bool IS_STRICT> BlockMaxWeakAndSearch<IS_STRICT>::~BlockMaxWeakAndSearch() = default;
+
+
 //-----------------------------------------------------------------------------
 
 } // namespace wand
@@ -175,6 +412,29 @@ SearchIterator::UP WeakAndSearch::create(const Terms& terms, const MatchParams&
     return create(terms, params, wand::Bm25TermFrequencyScorer(params.docid_limit), n, strict, readonly_scores_heap);
 }
 
+bool WeakAndSearch::has_block_max_info(const Terms& terms) {
+    for (const auto& term : terms) {
+        const auto* block_max = dynamic_cast<const IBlockMaxIterator*>(term.search);
+        if (block_max != nullptr && block_max->has_block_max_info()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+SearchIterator::UP WeakAndSearch::create_block_max(const Terms& terms, const MatchParams& params, uint32_t n,
+                                                   bool strict, bool readonly_scores_heap) {
+    if (!has_block_max_info(terms)) {
+        return create(terms, params, n, strict, readonly_scores_heap);
+    }
+    wand::Bm25TermFrequencyScorer scorer(params.docid_limit);
+    if (strict) {
+        return std::make_unique<wand::BlockMaxWeakAndSearch<true>>(terms, params, scorer, n, readonly_scores_heap);
+    } else {
+        return std::make_unique<wand::BlockMaxWeakAndSearch<false>>(terms, params, scorer, n, readonly_scores_heap);
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 template SearchIterator::UP
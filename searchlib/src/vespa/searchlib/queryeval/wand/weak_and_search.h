@@ -30,6 +30,10 @@ struct WeakAndSearch : SearchIterator {
                                      uint32_t n, bool strict, bool readonly_scores_heap);
     static SearchIterator::UP create(const Terms& terms, const MatchParams& matchParams, uint32_t n, bool strict,
                                      bool readonly_scores_heap);
+    static bool has_block_max_info(const Terms& terms);
+    // Block-max variant, using term frequency aware scoring. Falls back to create() if no term has block max info.
+    static SearchIterator::UP create_block_max(const Terms& terms, const MatchParams& matchParams, uint32_t n,
+                                               bool strict, bool readonly_scores_heap);
 };
 
 } // namespace search::queryeval
@@ -135,6 +135,12 @@ WeightedSetTermBlueprint::create_matching_elements_search(const MatchingElements
     }
 }
 
+void WeightedSetTermBlueprint::prefetchPostings() {
+    for (const auto& _term : _terms) {
+        _term->prefetchPostings();
+    }
+}
+
 void WeightedSetTermBlueprint::fetchPostings(const ExecuteInfo& execInfo) {
     for (const auto& _term : _terms) {
         _term->fetchPostings(execInfo);
@@ -46,6 +46,7 @@ public:
     void visitMembers(vespalib::ObjectVisitor& visitor) const override;
 
 private:
+    void prefetchPostings() override;
     void fetchPostings(const ExecuteInfo& execInfo) override;
 };
 
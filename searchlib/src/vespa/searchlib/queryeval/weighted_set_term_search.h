@@ -39,6 +39,8 @@ public:
     static constexpr bool require_btree_iterators = false;
     // Whether this supports creating a hash filter iterator;
     static constexpr bool supports_hash_filter = true;
+    // Whether this can skip documents not scoring above a shared score threshold.
+    static constexpr bool supports_score_threshold = false;
 
     // TODO: pass ownership with unique_ptr
     static SearchIterator::UP create(const std::vector<SearchIterator*>& children,
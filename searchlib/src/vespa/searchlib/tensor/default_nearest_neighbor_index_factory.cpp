@@ -5,10 +5,14 @@
 #include "distance_function_factory.h"
 #include "hnsw_index.h"
 #include "inv_log_level_generator.h"
+#include "partitioned_nearest_neighbor_index.h"
 #include "random_level_generator.h"
 
 #include <vespa/searchcommon/attribute/config.h>
 
+#include <vespa/log/log.h>
+LOG_SETUP(".searchlib.tensor.default_nearest_neighbor_index_factory");
+
 namespace search::tensor {
 
 using vespalib::eval::ValueType;
@@ -23,23 +27,76 @@ RandomLevelGenerator::UP make_random_level_generator(uint32_t m) {
     return std::make_unique<InvLogLevelGenerator>(m);
 }
 
-} // namespace
+std::unique_ptr<HnswQuantizedTraversal> make_quantized_traversal(const search::attribute::HnswIndexParams& params,
+                                                                 size_t vector_size, bool multi_vector_index,
+                                                                 bool quantized_attribute) {
+    uint8_t bits = params.traversal_quantization_bits();
+    if (bits == 0) {
+        return {};
+    }
+    if (multi_vector_index || quantized_attribute || !HnswQuantizedTraversal::supports(params.distance_metric()) ||
+        bits > 4)
+    {
+        LOG(warning, "Quantized hnsw traversal (%u bits) is not supported for this tensor attribute, using full "
+                     "precision traversal", bits);
+        return {};
+    }
+    return std::make_unique<HnswQuantizedTraversal>(params.distance_metric(), vector_size, bits);
+}
 
 std::unique_ptr<NearestNeighborIndex>
-DefaultNearestNeighborIndexFactory::make(const DocVectorAccess& vectors, size_t vector_size, bool multi_vector_index,
-                                         vespalib::eval::CellType                            cell_type,
-                                         const search::attribute::HnswIndexParams&           params,
-                                         const std::optional<attribute::QuantizationParams>& quant_params) const {
+make_hnsw_index(const DocVectorAccess& vectors, size_t vector_size, bool multi_vector_index,
+                vespalib::eval::CellType cell_type, const search::attribute::HnswIndexParams& params,
+                const std::optional<attribute::QuantizationParams>&      quant_params,
+                const std::shared_ptr<vespalib::alloc::MemoryAllocator>& memory_allocator) {
     uint32_t        m = params.max_links_per_node();
     HnswIndexConfig cfg(m * 2, m, params.neighbors_to_explore_at_insert(), 10000, true);
     auto dist_ff = make_distance_function_factory(params.distance_metric(), cell_type, vector_size, quant_params);
+    auto quantized_traversal =
+        make_quantized_traversal(params, vector_size, multi_vector_index, quant_params.has_value());
     if (multi_vector_index) {
         return std::make_unique<HnswIndex<HnswIndexType::MULTI>>(vectors, std::move(dist_ff),
                                                                  make_random_level_generator(m), cfg);
     } else {
+        // Graph traversal only touches the link arrays and the quantized codes, and full precision
+        // vectors only for the final candidates; the link arrays can then live on disk as well.
+        std::shared_ptr<vespalib::alloc::MemoryAllocator> links_allocator;
+        if (quantized_traversal && memory_allocator) {
+            LOG(debug, "Using disk resident link arrays for hnsw index with quantized traversal");
+            links_allocator = memory_allocator;
+        }
         return std::make_unique<HnswIndex<HnswIndexType::SINGLE>>(vectors, std::move(dist_ff),
-                                                                  make_random_level_generator(m), cfg);
+                                                                  make_random_level_generator(m), cfg,
+                                                                  std::move(quantized_traversal),
+                                                                  std::move(links_allocator));
+    }
+}
+
+} // namespace
+
+std::unique_ptr<NearestNeighborIndex>
+DefaultNearestNeighborIndexFactory::make(const DocVectorAccess& vectors, size_t vector_size, bool multi_vector_index,
+                                         vespalib::eval::CellType                            cell_type,
+                                         const search::attribute::HnswIndexParams&           params,
+                                         const std::optional<attribute::QuantizationParams>&      quant_params,
+                                         const std::shared_ptr<vespalib::alloc::MemoryAllocator>& memory_allocator) const {
+    if (params.partition_attribute().empty()) {
+        return make_hnsw_index(vectors, vector_size, multi_vector_index, cell_type, params, quant_params,
+                               memory_allocator);
     }
+    // Partition indexes use full precision traversal, as query vectors are bound using the global index.
+    search::attribute::HnswIndexParams partition_params(params.max_links_per_node(),
+                                                        params.neighbors_to_explore_at_insert(),
+                                                        params.distance_metric(), params.multi_threaded_indexing());
+    auto global = make_hnsw_index(vectors, vector_size, multi_vector_index, cell_type, params, quant_params,
+                                  memory_allocator);
+    auto partition_factory = [vector_size, multi_vector_index, cell_type, partition_params,
+                              quant_params](const DocVectorAccess& local_vectors) {
+        return make_hnsw_index(local_vectors, vector_size, multi_vector_index, cell_type, partition_params,
+                               quant_params, {});
+    };
+    return std::make_unique<PartitionedNearestNeighborIndex>(params.partition_attribute(), vectors, std::move(global),
+                                                             std::move(partition_factory));
 }
 
 } // namespace search::tensor
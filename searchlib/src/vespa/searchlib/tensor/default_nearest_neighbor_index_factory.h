@@ -8,13 +8,18 @@ namespace search::tensor {
 
 /**
  * Factory that instantiates the production hnsw index.
+ *
+ * For a paged tensor attribute with quantized traversal, the index is disk resident: the link
+ * arrays are allocated in the memory mapped file of the attribute (next to the full precision
+ * vectors), while the nodes, level arrays and quantized codes used for navigation stay in memory.
  */
 class DefaultNearestNeighborIndexFactory : public NearestNeighborIndexFactory {
 public:
-    std::unique_ptr<NearestNeighborIndex> make(const DocVectorAccess& vectors, size_t vector_size,
-                                               bool multi_vector_index, vespalib::eval::CellType cell_type,
-                                               const search::attribute::HnswIndexParams& params,
-                                               const std::optional<attribute::QuantizationParams>& quant_params) const override;
+    std::unique_ptr<NearestNeighborIndex>
+    make(const DocVectorAccess& vectors, size_t vector_size, bool multi_vector_index,
+         vespalib::eval::CellType cell_type, const search::attribute::HnswIndexParams& params,
+         const std::optional<attribute::QuantizationParams>&      quant_params,
+         const std::shared_ptr<vespalib::alloc::MemoryAllocator>& memory_allocator) const override;
 };
 
 } // namespace search::tensor
@@ -10,12 +10,12 @@
 namespace search::tensor {
 
 template <HnswIndexType type>
-HnswGraph<type>::HnswGraph()
+HnswGraph<type>::HnswGraph(std::shared_ptr<vespalib::alloc::MemoryAllocator> links_allocator)
     : nodes(),
       nodes_size(1u),
       active_nodes(0u),
       levels_store(HnswIndex<type>::make_default_level_array_store_config(), {}),
-      links_store(HnswIndex<type>::make_default_link_array_store_config(), {}),
+      links_store(HnswIndex<type>::make_default_link_array_store_config(), std::move(links_allocator)),
       entry_nodeid_and_level(),
       _generation_handler(),
       _last_flush_duration(0) {
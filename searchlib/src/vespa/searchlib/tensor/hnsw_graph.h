@@ -13,6 +13,11 @@
 #include <vespa/vespalib/util/rcuvector.h>
 
 #include <chrono>
+#include <memory>
+
+namespace vespalib::alloc {
+class MemoryAllocator;
+}
 
 namespace search::tensor {
 
@@ -60,7 +65,8 @@ template <HnswIndexType type> struct HnswGraph {
     vespalib::GenerationHandler                         _generation_handler;
     mutable std::atomic<std::chrono::steady_clock::rep> _last_flush_duration;
 
-    HnswGraph();
+    // Link arrays are allocated with links_allocator if given (e.g. backed by a memory mapped file)
+    explicit HnswGraph(std::shared_ptr<vespalib::alloc::MemoryAllocator> links_allocator = {});
     ~HnswGraph();
 
     LevelsRef make_node(uint32_t nodeid, uint32_t docid, uint32_t subspace, uint32_t num_levels);
@@ -18,10 +18,13 @@
 #include <vespa/vespalib/util/deadline.h>
 #include <vespa/vespalib/util/memory_allocator.h>
 #include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/thread_bundle.h>
 #include <vespa/vespalib/util/time.h>
 
 #include <vespa/vespalib/datastore/array_store.hpp>
 
+#include <functional>
+
 #include <vespa/log/log.h>
 
 LOG_SETUP(".searchlib.tensor.hnsw_index");
@@ -46,6 +49,9 @@ constexpr float  alloc_grow_factor = 0.3;
 constexpr size_t             max_level_array_size = 16;
 constexpr size_t             max_link_array_size = 193;
 constexpr vespalib::duration MAX_COUNT_DURATION(1000ms);
+// Documents prepared in the same batch are not linked to each other; bound the batch
+// size by the number of nodes already in the graph to keep that fraction small.
+constexpr uint32_t active_nodes_per_bulk_add = 8;
 
 const std::string hnsw_max_squared_norm = "hnsw.max_squared_norm";
 
@@ -78,6 +84,50 @@ bool has_link_to(std::span<const uint32_t> links, uint32_t id) {
     return false;
 }
 
+// Prepares every num_threads'th document in a batch, starting at thread_id.
+// The writer thread is blocked until the batch is prepared, so no read guards are needed.
+struct PrepareAddTask : vespalib::Runnable {
+    const NearestNeighborIndex&                  index;
+    const DocVectorAccess&                       vectors;
+    std::span<const uint32_t>                    docids;
+    std::vector<std::unique_ptr<PrepareResult>>& prepared;
+    size_t                                       thread_id;
+    size_t                                       num_threads;
+    PrepareAddTask(const NearestNeighborIndex& index_in, const DocVectorAccess& vectors_in,
+                   std::span<const uint32_t> docids_in, std::vector<std::unique_ptr<PrepareResult>>& prepared_out,
+                   size_t thread_id_in, size_t num_threads_in) noexcept
+        : index(index_in),
+          vectors(vectors_in),
+          docids(docids_in),
+          prepared(prepared_out),
+          thread_id(thread_id_in),
+          num_threads(num_threads_in) {}
+    void run() override {
+        for (size_t i = thread_id; i < docids.size(); i += num_threads) {
+            prepared[i] = index.prepare_add_document(docids[i], vectors.get_vectors(docids[i]), GenerationGuard());
+        }
+    }
+};
+
+/*
+ * Wraps a loader and calls the given function when all data has been loaded.
+ */
+class CompletionNotifyingLoader : public NearestNeighborIndexLoader {
+    std::unique_ptr<NearestNeighborIndexLoader> _loader;
+    std::function<void()>                       _on_complete;
+
+public:
+    CompletionNotifyingLoader(std::unique_ptr<NearestNeighborIndexLoader> loader, std::function<void()> on_complete)
+        : _loader(std::move(loader)), _on_complete(std::move(on_complete)) {}
+    bool load_next() override {
+        if (_loader->load_next()) {
+            return true;
+        }
+        _on_complete();
+        return false;
+    }
+};
+
 struct PairDist {
     uint32_t id_first;
     uint32_t id_second;
@@ -306,9 +356,9 @@ double HnswIndex<type>::calc_distance(const BoundDistanceFunction& df, uint32_t
 }
 
 template <HnswIndexType type>
-double HnswIndex<type>::calc_distance(const BoundDistanceFunction& df, uint32_t rhs_docid,
-                                      uint32_t rhs_subspace) const {
-    auto rhs = get_vector(rhs_docid, rhs_subspace);
+double HnswIndex<type>::calc_distance(const BoundDistanceFunction& df, const DocVectorAccess& vectors,
+                                      uint32_t rhs_docid, uint32_t rhs_subspace) const {
+    auto rhs = vectors.get_vector(rhs_docid, rhs_subspace);
     return calc_distance_helper(df, rhs);
 }
 
@@ -337,7 +387,8 @@ uint32_t HnswIndex<type>::estimate_visited_nodes(uint32_t level, uint32_t nodeid
 
 template <HnswIndexType type>
 HnswCandidate HnswIndex<type>::find_nearest_in_layer(Stats& stats, const BoundDistanceFunction& df,
-                                                     const HnswCandidate& entry_point, uint32_t level) const {
+                                                     const DocVectorAccess& vectors, const HnswCandidate& entry_point,
+                                                     uint32_t level) const {
     HnswCandidate nearest = entry_point;
     bool          keep_searching = true;
     while (keep_searching) {
@@ -348,7 +399,7 @@ HnswCandidate HnswIndex<type>::find_nearest_in_layer(Stats& stats, const BoundDi
             auto     neighbor_ref = neighbor_node.levels_ref().load_acquire();
             uint32_t neighbor_docid = acquire_docid(neighbor_node, neighbor_nodeid);
             uint32_t neighbor_subspace = neighbor_node.acquire_subspace();
-            double   dist = calc_distance(df, neighbor_docid, neighbor_subspace);
+            double   dist = calc_distance(df, vectors, neighbor_docid, neighbor_subspace);
             stats.count_computed_distance();
             if (_graph.still_valid(neighbor_nodeid, neighbor_ref) && dist < nearest.distance) {
                 nearest = HnswCandidate(neighbor_nodeid, neighbor_docid, neighbor_ref, dist);
@@ -361,8 +412,8 @@ HnswCandidate HnswIndex<type>::find_nearest_in_layer(Stats& stats, const BoundDi
 
 template <HnswIndexType type>
 template <class VisitedTracker, class BestNeighbors>
-void HnswIndex<type>::search_layer_helper(Stats& stats, const BoundDistanceFunction& df, uint32_t neighbors_to_find,
-                                          double exploration_slack, bool prefetch_tensors,
+void HnswIndex<type>::search_layer_helper(Stats& stats, const BoundDistanceFunction& df, const DocVectorAccess& vectors,
+                                          uint32_t neighbors_to_find, double exploration_slack, bool prefetch_tensors,
                                           BestNeighbors& best_neighbors, uint32_t level, const GlobalFilter* filter,
                                           uint32_t nodeid_limit, const vespalib::Deadline* const deadline,
                                           uint32_t estimated_visited_nodes) const {
@@ -417,17 +468,17 @@ void HnswIndex<type>::search_layer_helper(Stats& stats, const BoundDistanceFunct
             const auto neighbor_subspace = neighbor_node.acquire_subspace();
 
             neighbor_link_metas.emplace_back(neighbor_nodeid, neighbor_ref, neighbor_docid, neighbor_subspace);
-            prefetch_docid(_vectors, neighbor_docid);
+            prefetch_docid(vectors, neighbor_docid);
         }
 
         if (prefetch_tensors) {
             for (const auto& link : neighbor_link_metas) {
-                prefetch_vector(_vectors, link.neighbor_docid);
+                prefetch_vector(vectors, link.neighbor_docid);
             }
         }
 
         for (const auto& link : neighbor_link_metas) {
-            double dist_to_input = calc_distance(df, link.neighbor_docid, link.neighbor_subspace);
+            double dist_to_input = calc_distance(df, vectors, link.neighbor_docid, link.neighbor_subspace);
             stats.count_computed_distance();
             if (dist_to_input < (1.0 + exploration_slack) * limit_dist) {
                 candidates.emplace(link.neighbor_nodeid, link.neighbor_ref, dist_to_input);
@@ -451,8 +502,9 @@ void HnswIndex<type>::search_layer_helper(Stats& stats, const BoundDistanceFunct
 template <HnswIndexType type>
 template <class VisitedTracker, class BestNeighbors>
 void HnswIndex<type>::search_layer_filter_first_helper(Stats& stats, const BoundDistanceFunction& df,
-                                                       uint32_t neighbors_to_find, double exploration_slack,
-                                                       bool prefetch_tensors, BestNeighbors& best_neighbors,
+                                                       const DocVectorAccess& vectors, uint32_t neighbors_to_find,
+                                                       double exploration_slack, bool prefetch_tensors,
+                                                       BestNeighbors& best_neighbors,
                                                        double exploration, uint32_t level, const GlobalFilter* filter,
                                                        uint32_t                        nodeid_limit,
                                                        const vespalib::Deadline* const deadline,
@@ -508,15 +560,15 @@ void HnswIndex<type>::search_layer_filter_first_helper(Stats& stats, const Bound
             uint32_t neighbor_subspace = neighbor_node.acquire_subspace();
 
             neighbor_link_metas.emplace_back(neighbor_nodeid, neighbor_ref, neighbor_docid, neighbor_subspace);
-            prefetch_docid(_vectors, neighbor_docid);
+            prefetch_docid(vectors, neighbor_docid);
         }
         if (prefetch_tensors) {
             for (const auto& link : neighbor_link_metas) {
-                prefetch_vector(_vectors, link.neighbor_docid);
+                prefetch_vector(vectors, link.neighbor_docid);
             }
         }
         for (const auto& link : neighbor_link_metas) {
-            double dist_to_input = calc_distance(df, link.neighbor_docid, link.neighbor_subspace);
+            double dist_to_input = calc_distance(df, vectors, link.neighbor_docid, link.neighbor_subspace);
             stats.count_computed_distance();
             if (dist_to_input < (1.0 + exploration_slack) * limit_dist) {
                 candidates.emplace(link.neighbor_nodeid, link.neighbor_ref, dist_to_input);
@@ -615,27 +667,28 @@ void HnswIndex<type>::exploreNeighborhoodByOneHop(Stats& stats, std::deque<uint3
 
 template <HnswIndexType type>
 template <class BestNeighbors>
-void HnswIndex<type>::search_layer(Stats& stats, const BoundDistanceFunction& df, uint32_t neighbors_to_find,
-                                   double exploration_slack, bool prefetch_tensors, BestNeighbors& best_neighbors,
-                                   uint32_t level, const vespalib::Deadline* const deadline,
-                                   const GlobalFilter* filter) const {
+void HnswIndex<type>::search_layer(Stats& stats, const BoundDistanceFunction& df, const DocVectorAccess& vectors,
+                                   uint32_t neighbors_to_find, double exploration_slack, bool prefetch_tensors,
+                                   BestNeighbors& best_neighbors, uint32_t level,
+                                   const vespalib::Deadline* const deadline, const GlobalFilter* filter) const {
     uint32_t nodeid_limit = _graph.nodes_size.load(std::memory_order_acquire);
     uint32_t estimated_visited_nodes = estimate_visited_nodes(level, nodeid_limit, neighbors_to_find, filter);
     if (estimated_visited_nodes >= nodeid_limit / 128) {
-        search_layer_helper<BitVectorVisitedTracker>(stats, df, neighbors_to_find, exploration_slack,
+        search_layer_helper<BitVectorVisitedTracker>(stats, df, vectors, neighbors_to_find, exploration_slack,
                                                      prefetch_tensors, best_neighbors, level, filter, nodeid_limit,
                                                      deadline, estimated_visited_nodes);
     } else {
-        search_layer_helper<HashSetVisitedTracker>(stats, df, neighbors_to_find, exploration_slack, prefetch_tensors,
-                                                   best_neighbors, level, filter, nodeid_limit, deadline,
-                                                   estimated_visited_nodes);
+        search_layer_helper<HashSetVisitedTracker>(stats, df, vectors, neighbors_to_find, exploration_slack,
+                                                   prefetch_tensors, best_neighbors, level, filter, nodeid_limit,
+                                                   deadline, estimated_visited_nodes);
     }
 }
 
 template <HnswIndexType type>
 template <class BestNeighbors>
 void HnswIndex<type>::search_layer_filter_first(Stats& stats, const BoundDistanceFunction& df,
-                                                uint32_t neighbors_to_find, double exploration_slack,
+                                                const DocVectorAccess& vectors, uint32_t neighbors_to_find,
+                                                double exploration_slack,
                                                 bool prefetch_tensors, BestNeighbors& best_neighbors,
                                                 double exploration, uint32_t level,
                                                 const vespalib::Deadline* const deadline,
@@ -644,25 +697,34 @@ void HnswIndex<type>::search_layer_filter_first(Stats& stats, const BoundDistanc
     uint32_t estimated_visited_nodes = estimate_visited_nodes(level, nodeid_limit, neighbors_to_find, filter);
     if (estimated_visited_nodes >= nodeid_limit / 128) {
         search_layer_filter_first_helper<BitVectorVisitedTracker>(
-            stats, df, neighbors_to_find, exploration_slack, prefetch_tensors, best_neighbors, exploration, level,
-            filter, nodeid_limit, deadline, estimated_visited_nodes);
+            stats, df, vectors, neighbors_to_find, exploration_slack, prefetch_tensors, best_neighbors, exploration,
+            level, filter, nodeid_limit, deadline, estimated_visited_nodes);
     } else {
         search_layer_filter_first_helper<HashSetVisitedTracker>(
-            stats, df, neighbors_to_find, exploration_slack, prefetch_tensors, best_neighbors, exploration, level,
-            filter, nodeid_limit, deadline, estimated_visited_nodes);
+            stats, df, vectors, neighbors_to_find, exploration_slack, prefetch_tensors, best_neighbors, exploration,
+            level, filter, nodeid_limit, deadline, estimated_visited_nodes);
     }
 }
 
 template <HnswIndexType type>
 HnswIndex<type>::HnswIndex(const DocVectorAccess& vectors, DistanceFunctionFactory::UP distance_ff,
-                           RandomLevelGenerator::UP level_generator, const HnswIndexConfig& cfg)
-    : _graph(),
+                           RandomLevelGenerator::UP level_generator, const HnswIndexConfig& cfg,
+                           std::unique_ptr<HnswQuantizedTraversal>            quantized_traversal,
+                           std::shared_ptr<vespalib::alloc::MemoryAllocator> links_allocator)
+    : _graph(std::move(links_allocator)),
       _vectors(vectors),
       _distance_ff(std::move(distance_ff)),
       _level_generator(std::move(level_generator)),
       _id_mapping(),
-      _cfg(cfg) {
+      _cfg(cfg),
+      _quantized_traversal(std::move(quantized_traversal)),
+      _query_distance_ff() {
     assert(_distance_ff);
+    if (_quantized_traversal) {
+        // Quantized codes are keyed by nodeid and exposed as vectors keyed by docid.
+        assert(NodeType::identity_mapping);
+        _query_distance_ff = _quantized_traversal->make_query_distance_function_factory(*_distance_ff);
+    }
 }
 
 template <HnswIndexType type> HnswIndex<type>::~HnswIndex() = default;
@@ -718,7 +780,7 @@ void HnswIndex<type>::internal_prepare_add_node(PreparedAddDoc& op, TypedCells i
     // TODO: check if entry nodeid/levels_ref is still valid here
     HnswCandidate entry_point(entry.nodeid, entry_docid, entry.levels_ref, entry_dist);
     while (search_level > node_max_level) {
-        entry_point = find_nearest_in_layer(stats, *df, entry_point, search_level);
+        entry_point = find_nearest_in_layer(stats, *df, _vectors, entry_point, search_level);
         --search_level;
     }
 
@@ -727,7 +789,7 @@ void HnswIndex<type>::internal_prepare_add_node(PreparedAddDoc& op, TypedCells i
     search_level = std::min(node_max_level, search_level);
     // Find neighbors of the added document in each level it should exist in.
     while (search_level >= 0) {
-        search_layer(stats, *df, _cfg.neighbors_to_explore_at_construction(), 0.0, false, best_neighbors,
+        search_layer(stats, *df, _vectors, _cfg.neighbors_to_explore_at_construction(), 0.0, false, best_neighbors,
                      search_level, nullptr);
         auto  neighbors = select_neighbors(best_neighbors.peek(), _cfg.max_links_on_inserts());
         auto& links = connections[search_level];
@@ -779,7 +841,11 @@ template <HnswIndexType type>
 void HnswIndex<type>::internal_complete_add_node(uint32_t nodeid, uint32_t docid, uint32_t subspace,
                                                  PreparedAddNode& prepared_node) {
     int32_t num_levels = prepared_node.connections.size();
-    auto    levels_ref = _graph.make_node(nodeid, docid, subspace, num_levels);
+    if (_quantized_traversal) {
+        // Must be set before the node is made visible to readers.
+        _quantized_traversal->set(nodeid, get_vector(docid, subspace));
+    }
+    auto levels_ref = _graph.make_node(nodeid, docid, subspace, num_levels);
     for (int level = 0; level < num_levels; ++level) {
         auto neighbors = filter_valid_nodeids(level, prepared_node.connections[level], nodeid);
         connect_new_node(nodeid, neighbors, level);
@@ -818,6 +884,34 @@ void HnswIndex<type>::complete_add_document(uint32_t docid, std::unique_ptr<Prep
     }
 }
 
+template <HnswIndexType type>
+void HnswIndex<type>::add_documents(std::span<const uint32_t> docids, vespalib::ThreadBundle& thread_bundle) {
+    std::vector<std::unique_ptr<PrepareResult>> prepared;
+    size_t                                      pos = 0;
+    while (pos < docids.size()) {
+        uint32_t active_nodes = _graph.get_active_nodes();
+        size_t   batch_size = std::min(docids.size() - pos, size_t(active_nodes / active_nodes_per_bulk_add));
+        if (active_nodes < _cfg.min_size_before_two_phase() || batch_size < 2 || thread_bundle.size() < 2) {
+            add_document(docids[pos++]);
+            continue;
+        }
+        auto batch = docids.subspan(pos, batch_size);
+        prepared.clear();
+        prepared.resize(batch.size());
+        size_t num_threads = std::min(thread_bundle.size(), batch.size());
+        std::vector<PrepareAddTask> tasks;
+        tasks.reserve(num_threads);
+        for (size_t thread_id = 0; thread_id < num_threads; ++thread_id) {
+            tasks.emplace_back(*this, _vectors, batch, prepared, thread_id, num_threads);
+        }
+        thread_bundle.run(tasks);
+        for (size_t i = 0; i < batch.size(); ++i) {
+            complete_add_document(batch[i], std::move(prepared[i]));
+        }
+        pos += batch_size;
+    }
+}
+
 template <HnswIndexType type> void HnswIndex<type>::mutual_reconnect(const LinkArrayRef& cluster, uint32_t level) {
     std::vector<PairDist> pairs;
     for (uint32_t i = 0; i + 1 < cluster.size(); ++i) {
@@ -900,6 +994,9 @@ template <HnswIndexType type> void HnswIndex<type>::assign_generation(Generation
     _graph.levels_store.assign_generation(current_gen);
     _graph.links_store.assign_generation(current_gen);
     _id_mapping.assign_generation(current_gen);
+    if (_quantized_traversal) {
+        _quantized_traversal->assign_generation(current_gen + 1);
+    }
 }
 
 template <HnswIndexType type> void HnswIndex<type>::reclaim_memory(Generation oldest_used_gen) {
@@ -907,6 +1004,9 @@ template <HnswIndexType type> void HnswIndex<type>::reclaim_memory(Generation ol
     _graph.levels_store.reclaim_memory(oldest_used_gen);
     _graph.links_store.reclaim_memory(oldest_used_gen);
     _id_mapping.reclaim_memory(oldest_used_gen);
+    if (_quantized_traversal) {
+        _quantized_traversal->reclaim_memory(oldest_used_gen);
+    }
 }
 
 template <HnswIndexType type> GenerationGuard HnswIndex<type>::make_generation_read_guard() const {
@@ -978,6 +1078,9 @@ vespalib::MemoryUsage HnswIndex<type>::update_stat(const CompactionStrategy& com
     result.merge(_graph.levels_store.update_stat(compaction_strategy));
     result.merge(_graph.links_store.update_stat(compaction_strategy));
     result.merge(_id_mapping.update_stat(compaction_strategy));
+    if (_quantized_traversal) {
+        result.merge(_quantized_traversal->memory_usage());
+    }
     return result;
 }
 
@@ -987,6 +1090,9 @@ template <HnswIndexType type> vespalib::MemoryUsage HnswIndex<type>::memory_usag
     result.merge(_graph.levels_store.getMemoryUsage());
     result.merge(_graph.links_store.getMemoryUsage());
     result.merge(_id_mapping.memory_usage());
+    if (_quantized_traversal) {
+        result.merge(_quantized_traversal->memory_usage());
+    }
     return result;
 }
 
@@ -1012,12 +1118,15 @@ template <HnswIndexType type> void HnswIndex<type>::shrink_lid_space(uint32_t do
             return;
         }
         _graph.nodes.shrink(doc_id_limit);
+        if (_quantized_traversal) {
+            _quantized_traversal->shrink(doc_id_limit);
+        }
     }
 }
 
 template <HnswIndexType type>
 std::unique_ptr<NearestNeighborIndexSaver> HnswIndex<type>::make_saver(GenericHeader& header) const {
-    save_mips_max_distance(header, distance_function_factory());
+    save_mips_max_distance(header, *_distance_ff);
     return std::make_unique<HnswIndexSaver<type>>(_graph);
 }
 
@@ -1025,11 +1134,26 @@ template <HnswIndexType type>
 std::unique_ptr<NearestNeighborIndexLoader> HnswIndex<type>::make_loader(FastOS_FileInterface&          file,
                                                                          const vespalib::GenericHeader& header) {
     assert(get_entry_nodeid() == 0); // cannot load after index has data
-    load_mips_max_distance(header, distance_function_factory());
+    load_mips_max_distance(header, *_distance_ff);
     _graph.set_last_flush_duration(CreateAndFreezeTimes(header).get_flush_duration());
     using ReaderType = FileReader<uint32_t>;
     using LoaderType = HnswIndexLoader<ReaderType, type>;
-    return std::make_unique<LoaderType>(_graph, _id_mapping, std::make_unique<ReaderType>(&file));
+    auto loader = std::make_unique<LoaderType>(_graph, _id_mapping, std::make_unique<ReaderType>(&file));
+    if (_quantized_traversal) {
+        // Quantized codes are not saved, rebuild them from the tensor attribute when the graph is loaded.
+        return std::make_unique<CompletionNotifyingLoader>(std::move(loader),
+                                                           [this]() { populate_quantized_traversal(); });
+    }
+    return loader;
+}
+
+template <HnswIndexType type> void HnswIndex<type>::populate_quantized_traversal() {
+    uint32_t nodeid_limit = _graph.size();
+    for (uint32_t nodeid = 1; nodeid < nodeid_limit; ++nodeid) {
+        if (_graph.get_levels_ref(nodeid).valid()) {
+            _quantized_traversal->set(nodeid, get_vector(nodeid));
+        }
+    }
 }
 
 struct NeighborsByDocId {
@@ -1044,6 +1168,17 @@ HnswIndex<type>::top_k_by_docid(Stats& stats, uint32_t k, const BoundDistanceFun
                                 bool low_hit_ratio, double exploration, uint32_t explore_k, double exploration_slack,
                                 bool prefetch_tensors, const vespalib::Deadline& deadline,
                                 double distance_threshold) const {
+    auto* query_df = _quantized_traversal ? dynamic_cast<const HnswQuantizedTraversal::QueryDistanceFunction*>(&df)
+                                          : nullptr;
+    if (query_df != nullptr) {
+        // Traverse the graph using quantized codes, then re-rank the final candidates with full precision.
+        SearchBestNeighbors candidates =
+            top_k_candidates(stats, query_df->traversal(), *_quantized_traversal, std::max(k, explore_k),
+                             exploration_slack, prefetch_tensors, filter, low_hit_ratio, exploration, deadline);
+        auto result = rerank_candidates(stats, df, candidates).get_neighbors(k, distance_threshold);
+        std::sort(result.begin(), result.end(), NeighborsByDocId());
+        return result;
+    }
     SearchBestNeighbors candidates = top_k_candidates(stats, df, std::max(k, explore_k), exploration_slack,
                                                       prefetch_tensors, filter, low_hit_ratio, exploration, deadline);
     auto                result = candidates.get_neighbors(k, distance_threshold);
@@ -1077,6 +1212,16 @@ typename HnswIndex<type>::SearchBestNeighbors
 HnswIndex<type>::top_k_candidates(Stats& stats, const BoundDistanceFunction& df, uint32_t k, double exploration_slack,
                                   bool prefetch_tensors, const GlobalFilter* filter, bool low_hit_ratio,
                                   double exploration, const vespalib::Deadline& deadline) const {
+    return top_k_candidates(stats, df, _vectors, k, exploration_slack, prefetch_tensors, filter, low_hit_ratio,
+                            exploration, deadline);
+}
+
+template <HnswIndexType type>
+typename HnswIndex<type>::SearchBestNeighbors
+HnswIndex<type>::top_k_candidates(Stats& stats, const BoundDistanceFunction& df, const DocVectorAccess& vectors,
+                                  uint32_t k, double exploration_slack, bool prefetch_tensors,
+                                  const GlobalFilter* filter, bool low_hit_ratio, double exploration,
+                                  const vespalib::Deadline& deadline) const {
     SearchBestNeighbors best_neighbors;
     auto                entry = _graph.get_entry_node();
     if (entry.nodeid == 0) {
@@ -1084,26 +1229,42 @@ HnswIndex<type>::top_k_candidates(Stats& stats, const BoundDistanceFunction& df,
         return best_neighbors;
     }
     stats.count_visited_node(); // Count entry point as visited node
-    int    search_level = entry.level;
-    double entry_dist = calc_distance(df, entry.nodeid);
-    stats.count_computed_distance();
+    int      search_level = entry.level;
     uint32_t entry_docid = get_docid(entry.nodeid);
+    double   entry_dist = calc_distance(df, vectors, entry_docid, _graph.acquire_node(entry.nodeid).acquire_subspace());
+    stats.count_computed_distance();
     // TODO: check if entry docid/levels_ref is still valid here
     HnswCandidate entry_point(entry.nodeid, entry_docid, entry.levels_ref, entry_dist);
     while (search_level > 0) {
-        entry_point = find_nearest_in_layer(stats, df, entry_point, search_level);
+        entry_point = find_nearest_in_layer(stats, df, vectors, entry_point, search_level);
         --search_level;
     }
     best_neighbors.push(entry_point);
     if (filter && filter->is_active() && low_hit_ratio) {
-        search_layer_filter_first(stats, df, k, exploration_slack, prefetch_tensors, best_neighbors, exploration, 0,
-                                  &deadline, filter);
+        search_layer_filter_first(stats, df, vectors, k, exploration_slack, prefetch_tensors, best_neighbors,
+                                  exploration, 0, &deadline, filter);
     } else {
-        search_layer(stats, df, k, exploration_slack, prefetch_tensors, best_neighbors, 0, &deadline, filter);
+        search_layer(stats, df, vectors, k, exploration_slack, prefetch_tensors, best_neighbors, 0, &deadline,
+                     filter);
     }
     return best_neighbors;
 }
 
+template <HnswIndexType type>
+typename HnswIndex<type>::SearchBestNeighbors
+HnswIndex<type>::rerank_candidates(Stats& stats, const BoundDistanceFunction& df,
+                                   const SearchBestNeighbors& candidates) const {
+    SearchBestNeighbors result;
+    for (const auto& candidate : candidates.peek()) {
+        auto&    node = _graph.acquire_node(candidate.nodeid);
+        uint32_t subspace = node.acquire_subspace();
+        result.emplace(candidate.nodeid, candidate.docid, candidate.levels_ref,
+                       calc_distance(df, _vectors, candidate.docid, subspace));
+        stats.count_computed_distance();
+    }
+    return result;
+}
+
 template <HnswIndexType type> HnswTestNode HnswIndex<type>::get_node(uint32_t nodeid) const {
     auto levels_ref = _graph.acquire_levels_ref(nodeid);
     if (!levels_ref.valid()) {
@@ -10,6 +10,7 @@
 #include "hnsw_index_utils.h"
 #include "hnsw_multi_best_neighbors.h"
 #include "hnsw_nodeid_mapping.h"
+#include "hnsw_quantized_traversal.h"
 #include "hnsw_single_best_neighbors.h"
 #include "hnsw_test_node.h"
 #include "nearest_neighbor_index.h"
@@ -174,6 +175,8 @@ protected:
     RandomLevelGenerator::UP                 _level_generator;
     IdMapping                                _id_mapping; // mapping from docid to nodeid vector
     HnswIndexConfig                          _cfg;
+    std::unique_ptr<HnswQuantizedTraversal>  _quantized_traversal; // nullptr unless quantized traversal is enabled
+    std::unique_ptr<DistanceFunctionFactory> _query_distance_ff;   // binds queries for quantized traversal
 
     uint32_t max_links_for_level(uint32_t level) const;
     void add_link_to(uint32_t nodeid, uint32_t level, const LinkArrayRef& old_links, uint32_t new_link) {
@@ -216,24 +219,26 @@ protected:
     VectorBundle get_vectors(uint32_t docid) const { return _vectors.get_vectors(docid); }
 
     double calc_distance(const BoundDistanceFunction& df, uint32_t rhs_nodeid) const;
-    double calc_distance(const BoundDistanceFunction& df, uint32_t rhs_docid, uint32_t rhs_subspace) const;
+    double calc_distance(const BoundDistanceFunction& df, const DocVectorAccess& vectors, uint32_t rhs_docid,
+                         uint32_t rhs_subspace) const;
     uint32_t estimate_visited_nodes(uint32_t level, uint32_t nodeid_limit, uint32_t neighbors_to_find,
                                     const GlobalFilter* filter) const;
 
     /**
      * Performs a greedy search in the given layer to find the candidate that is nearest the input vector.
      */
-    HnswCandidate find_nearest_in_layer(Stats& stats, const BoundDistanceFunction& df,
+    HnswCandidate find_nearest_in_layer(Stats& stats, const BoundDistanceFunction& df, const DocVectorAccess& vectors,
                                         const HnswCandidate& entry_point, uint32_t level) const
         __attribute__((noinline));
     template <class VisitedTracker, class BestNeighbors>
-    void search_layer_helper(Stats& stats, const BoundDistanceFunction& df, uint32_t neighbors_to_find,
-                             double exploration_slack, bool prefetch_tensors, BestNeighbors& best_neighbors,
+    void search_layer_helper(Stats& stats, const BoundDistanceFunction& df, const DocVectorAccess& vectors,
+                             uint32_t neighbors_to_find, double exploration_slack, bool prefetch_tensors, BestNeighbors& best_neighbors,
                              uint32_t level, const GlobalFilter* filter, uint32_t nodeid_limit,
                              const vespalib::Deadline* const doom, uint32_t estimated_visited_nodes) const
         __attribute__((noinline));
     template <class VisitedTracker, class BestNeighbors>
-    void search_layer_filter_first_helper(Stats& stats, const BoundDistanceFunction& df, uint32_t neighbors_to_find,
+    void search_layer_filter_first_helper(Stats& stats, const BoundDistanceFunction& df,
+                                          const DocVectorAccess& vectors, uint32_t neighbors_to_find,
                                           double exploration_slack, bool prefetch_tensors,
                                           BestNeighbors& best_neighbors, double exploration, uint32_t level,
                                           const GlobalFilter* filter, uint32_t nodeid_limit,
@@ -249,18 +254,28 @@ protected:
                                      const internal::GlobalFilterWrapper<type>& filter_wrapper, uint32_t nodeid_limit,
                                      uint32_t max_neighbors_to_find) const;
     template <class BestNeighbors>
-    void search_layer(Stats& stats, const BoundDistanceFunction& df, uint32_t neighbors_to_find,
-                      double exploration_slack, bool prefetch_tensors, BestNeighbors& best_neighbors, uint32_t level,
+    void search_layer(Stats& stats, const BoundDistanceFunction& df, const DocVectorAccess& vectors,
+                      uint32_t neighbors_to_find, double exploration_slack, bool prefetch_tensors, BestNeighbors& best_neighbors, uint32_t level,
                       const vespalib::Deadline* const doom, const GlobalFilter* filter = nullptr) const;
     template <class BestNeighbors>
-    void search_layer_filter_first(Stats& stats, const BoundDistanceFunction& df, uint32_t neighbors_to_find,
-                                   double exploration_slack, bool prefetch_tensors, BestNeighbors& best_neighbors,
+    void search_layer_filter_first(Stats& stats, const BoundDistanceFunction& df, const DocVectorAccess& vectors,
+                                   uint32_t neighbors_to_find, double exploration_slack, bool prefetch_tensors, BestNeighbors& best_neighbors,
                                    double exploration, uint32_t level, const vespalib::Deadline* const doom,
                                    const GlobalFilter* filter = nullptr) const;
     std::vector<Neighbor> top_k_by_docid(Stats& stats, uint32_t k, const BoundDistanceFunction& df,
                                          const GlobalFilter* filter, bool low_hit_ratio, double exploration,
                                          uint32_t explore_k, double exploration_slack, bool prefetch_tensors,
                                          const vespalib::Deadline& doom, double distance_threshold) const;
+    SearchBestNeighbors top_k_candidates(Stats& stats, const BoundDistanceFunction& df, const DocVectorAccess& vectors,
+                                         uint32_t k, double exploration_slack, bool prefetch_tensors,
+                                         const GlobalFilter* filter, bool low_hit_ratio, double exploration,
+                                         const vespalib::Deadline& doom) const;
+    /**
+     * Re-ranks candidates found by traversing the graph using quantized codes, using full precision distances.
+     */
+    SearchBestNeighbors rerank_candidates(Stats& stats, const BoundDistanceFunction& df,
+                                          const SearchBestNeighbors& candidates) const;
+    void populate_quantized_traversal();
 
     internal::PreparedAddDoc internal_prepare_add(uint32_t docid, VectorBundle input_vectors,
                                                   vespalib::GenerationGuard read_guard) const;
@@ -277,7 +292,9 @@ protected:
 
 public:
     HnswIndex(const DocVectorAccess& vectors, DistanceFunctionFactory::UP distance_ff,
-              RandomLevelGenerator::UP level_generator, const HnswIndexConfig& cfg);
+              RandomLevelGenerator::UP level_generator, const HnswIndexConfig& cfg,
+              std::unique_ptr<HnswQuantizedTraversal>            quantized_traversal = {},
+              std::shared_ptr<vespalib::alloc::MemoryAllocator> links_allocator = {});
     ~HnswIndex() override;
 
     const HnswIndexConfig& config() const { return _cfg; }
@@ -287,6 +304,7 @@ public:
     std::unique_ptr<PrepareResult> prepare_add_document(uint32_t docid, VectorBundle vectors,
                                                         vespalib::GenerationGuard read_guard) const override;
     void complete_add_document(uint32_t docid, std::unique_ptr<PrepareResult> prepare_result) override;
+    void add_documents(std::span<const uint32_t> docids, vespalib::ThreadBundle& thread_bundle) override;
     void remove_node(uint32_t nodeid);
     void remove_document(uint32_t docid) override;
     void assign_generation(vespalib::Generation current_gen) override;
@@ -317,7 +335,10 @@ public:
                                                  const vespalib::Deadline& doom,
                                                  double                    distance_threshold) const override;
 
-    DistanceFunctionFactory& distance_function_factory() const override { return *_distance_ff; }
+    DistanceFunctionFactory& distance_function_factory() const override {
+        return _query_distance_ff ? *_query_distance_ff : *_distance_ff;
+    }
+    const HnswQuantizedTraversal* quantized_traversal() const noexcept { return _quantized_traversal.get(); }
 
     SearchBestNeighbors top_k_candidates(Stats& stats, const BoundDistanceFunction& df, uint32_t k,
                                          double exploration_slack, bool prefetch_tensors, const GlobalFilter* filter,
@@ -0,0 +1,122 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "hnsw_quantized_traversal.h"
+
+#include <vespa/eval/eval/value_type.h>
+#include <vespa/searchcommon/attribute/quantization_params.h>
+#include <vespa/vespalib/util/rcuvector.hpp>
+
+#include <cassert>
+
+using search::attribute::DistanceMetric;
+using search::attribute::QuantizationParams;
+using vespalib::eval::CellType;
+using vespalib::eval::TypedCells;
+using vespalib::eval::ValueType;
+using vespalib::quant::QuantMode;
+
+namespace search::tensor {
+
+namespace {
+
+// Codes are never persisted (they are rebuilt from the tensor attribute), so the
+// seed only needs to be stable for the lifetime of the index.
+constexpr uint64_t traversal_quantization_seed = 0x5eed'ba5e'c0de'f00dULL;
+
+bool uses_inner_product(DistanceMetric distance_metric) noexcept {
+    return distance_metric != DistanceMetric::Euclidean;
+}
+
+QuantizationParams make_quantization_params(DistanceMetric distance_metric, uint8_t bits) noexcept {
+    using Mode = QuantizationParams::QuantizationMode;
+    return {traversal_quantization_seed, uses_inner_product(distance_metric) ? Mode::InnerProduct : Mode::MSE, bits};
+}
+
+class QueryDistanceFunctionFactory : public DistanceFunctionFactory {
+    const DistanceFunctionFactory& _full;
+    const DistanceFunctionFactory& _traversal;
+
+public:
+    QueryDistanceFunctionFactory(const DistanceFunctionFactory& full, const DistanceFunctionFactory& traversal) noexcept
+        : _full(full), _traversal(traversal) {}
+    ~QueryDistanceFunctionFactory() override;
+    BoundDistanceFunction::UP for_query_vector(TypedCells lhs) const override {
+        return std::make_unique<HnswQuantizedTraversal::QueryDistanceFunction>(_full.for_query_vector(lhs),
+                                                                                _traversal.for_query_vector(lhs));
+    }
+    BoundDistanceFunction::UP for_insertion_vector(TypedCells lhs) const override {
+        return _full.for_insertion_vector(lhs);
+    }
+};
+
+QueryDistanceFunctionFactory::~QueryDistanceFunctionFactory() = default;
+
+} // namespace
+
+HnswQuantizedTraversal::QueryDistanceFunction::QueryDistanceFunction(BoundDistanceFunction::UP full,
+                                                                     BoundDistanceFunction::UP traversal) noexcept
+    : BoundDistanceFunction(), _full(std::move(full)), _traversal(std::move(traversal)) {}
+
+HnswQuantizedTraversal::QueryDistanceFunction::~QueryDistanceFunction() = default;
+
+HnswQuantizedTraversal::HnswQuantizedTraversal(DistanceMetric distance_metric, size_t dimensions, uint8_t bits)
+    : DocVectorAccess(),
+      _quantizer(dimensions, bits, traversal_quantization_seed),
+      _quant_mode(uses_inner_product(distance_metric) ? QuantMode::InnerProduct : QuantMode::MSE),
+      _tmp_space(dimensions),
+      _distance_ff(make_distance_function_factory(distance_metric, CellType::FLOAT, dimensions,
+                                                  make_quantization_params(distance_metric, bits))),
+      _code_type(ValueType::make_type(CellType::INT8, {{"x", uint32_t(_quantizer.quantized_size())}})),
+      _codes() {
+    assert(supports(distance_metric));
+    _codes.ensure_size(quantized_size());
+}
+
+HnswQuantizedTraversal::~HnswQuantizedTraversal() = default;
+
+bool HnswQuantizedTraversal::supports(DistanceMetric distance_metric) noexcept {
+    switch (distance_metric) {
+    case DistanceMetric::Euclidean:
+    case DistanceMetric::Angular:
+    case DistanceMetric::InnerProduct:
+    case DistanceMetric::PrenormalizedAngular:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void HnswQuantizedTraversal::set(uint32_t nodeid, TypedCells vector) {
+    size_t offset = size_t(nodeid) * quantized_size();
+    _codes.ensure_size(offset + quantized_size());
+    std::span<uint8_t> code(reinterpret_cast<uint8_t*>(&_codes[offset]), quantized_size());
+    if (vector.non_existing_attribute_value() || vector.size != _quantizer.dimensions()) [[unlikely]] {
+        std::fill(code.begin(), code.end(), 0);
+        return;
+    }
+    _quantizer.quantize(_tmp_space.storeLhs(vector), code, _quant_mode);
+}
+
+void HnswQuantizedTraversal::shrink(uint32_t nodeid_limit) {
+    size_t new_size = std::max(size_t(nodeid_limit), size_t(1)) * quantized_size();
+    if (new_size < _codes.size()) {
+        _codes.shrink(new_size);
+    }
+}
+
+std::unique_ptr<DistanceFunctionFactory>
+HnswQuantizedTraversal::make_query_distance_function_factory(const DistanceFunctionFactory& full) const {
+    return std::make_unique<QueryDistanceFunctionFactory>(full, *_distance_ff);
+}
+
+TypedCells HnswQuantizedTraversal::get_vector(uint32_t docid, uint32_t subspace) const noexcept {
+    assert(subspace == 0);
+    (void)subspace;
+    return {acquire_code(docid), CellType::INT8, quantized_size()};
+}
+
+VectorBundle HnswQuantizedTraversal::get_vectors(uint32_t docid) const noexcept {
+    return {acquire_code(docid), 1, _code_type};
+}
+
+} // namespace search::tensor
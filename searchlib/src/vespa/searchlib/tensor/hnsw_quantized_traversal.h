@@ -0,0 +1,111 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "bound_distance_function.h"
+#include "distance_function_factory.h"
+#include "doc_vector_access.h"
+#include "subspace_type.h"
+#include "temporary_vector_store.h"
+#include "vector_bundle.h"
+
+#include <vespa/searchcommon/attribute/distance_metric.h>
+#include <vespa/vespalib/quant/eden.h>
+#include <vespa/vespalib/util/generation.h>
+#include <vespa/vespalib/util/memoryusage.h>
+#include <vespa/vespalib/util/rcuvector.h>
+
+#include <memory>
+
+namespace search::tensor {
+
+/**
+ * Compact EDEN quantized (1-4 bits per cell) copies of the vectors in a HnswIndex, keyed by nodeid.
+ *
+ * When used by a HnswIndex, graph traversal during queries measures the distance between the
+ * (pre-rotated) query vector and these codes instead of the full precision vectors in the tensor
+ * attribute. Only the final candidate set is re-ranked using full precision distances.
+ *
+ * The codes are exposed as a DocVectorAccess where each vector is an int8 cell array of
+ * quantized_size() cells. This is only valid when nodeid == docid, i.e. for HnswIndexType::SINGLE.
+ *
+ * Codes are set by the writer thread only, before the corresponding node is made visible in the
+ * graph. Search threads must hold a generation guard for the hnsw graph when reading codes.
+ */
+class HnswQuantizedTraversal : public DocVectorAccess {
+public:
+    using TypedCells = vespalib::eval::TypedCells;
+
+    /**
+     * Bound distance function used for queries when quantized traversal is enabled.
+     * calc() and friends use full precision, while traversal() operates on quantized codes.
+     */
+    class QueryDistanceFunction : public BoundDistanceFunction {
+        BoundDistanceFunction::UP _full;
+        BoundDistanceFunction::UP _traversal;
+
+    public:
+        QueryDistanceFunction(BoundDistanceFunction::UP full, BoundDistanceFunction::UP traversal) noexcept;
+        ~QueryDistanceFunction() override;
+        const BoundDistanceFunction& traversal() const noexcept { return *_traversal; }
+        double calc(TypedCells rhs) const noexcept override { return _full->calc(rhs); }
+        double calc_with_limit(TypedCells rhs, double limit) const noexcept override {
+            return _full->calc_with_limit(rhs, limit);
+        }
+        double convert_threshold(double threshold) const noexcept override {
+            return _full->convert_threshold(threshold);
+        }
+        double to_rawscore(double distance) const noexcept override { return _full->to_rawscore(distance); }
+        double to_distance(double rawscore) const noexcept override { return _full->to_distance(rawscore); }
+        double min_rawscore() const noexcept override { return _full->min_rawscore(); }
+    };
+
+private:
+    using Codes = vespalib::RcuVector<int8_t>;
+
+    vespalib::quant::EdenQuantizer           _quantizer; // Writer only
+    vespalib::quant::QuantMode               _quant_mode;
+    MutableSingleTemporaryVectorStore<float> _tmp_space; // Writer only
+    std::unique_ptr<DistanceFunctionFactory> _distance_ff;
+    SubspaceType                             _code_type;
+    Codes                                    _codes;
+
+    const int8_t* acquire_code(uint32_t nodeid) const noexcept {
+        return &_codes.acquire_elem_ref(size_t(nodeid) * quantized_size());
+    }
+
+public:
+    HnswQuantizedTraversal(search::attribute::DistanceMetric distance_metric, size_t dimensions, uint8_t bits);
+    ~HnswQuantizedTraversal() override;
+
+    /**
+     * Returns whether quantized traversal can be used for the given distance metric.
+     * Dotproduct (mips) is not supported as its distance transform depends on state
+     * that is only maintained for the full precision distance function factory.
+     */
+    static bool supports(search::attribute::DistanceMetric distance_metric) noexcept;
+
+    size_t quantized_size() const noexcept { return _quantizer.quantized_size(); }
+    uint8_t bits() const noexcept { return _quantizer.bits(); }
+
+    // Called from writer only.
+    void set(uint32_t nodeid, TypedCells vector);
+    void assign_generation(vespalib::Generation current_gen) { _codes.setGeneration(current_gen); }
+    void reclaim_memory(vespalib::Generation oldest_used_gen) { _codes.reclaim_memory(oldest_used_gen); }
+    void shrink(uint32_t nodeid_limit);
+    vespalib::MemoryUsage memory_usage() const { return _codes.getMemoryUsage(); }
+
+    /**
+     * Wraps the full precision distance function factory used by the hnsw index, returning a factory
+     * where query vectors are bound to a QueryDistanceFunction. Insertion vectors use full precision.
+     */
+    std::unique_ptr<DistanceFunctionFactory>
+    make_query_distance_function_factory(const DistanceFunctionFactory& full) const;
+
+    // Implements DocVectorAccess (docid == nodeid)
+    TypedCells get_vector(uint32_t docid, uint32_t subspace) const noexcept override;
+    VectorBundle get_vectors(uint32_t docid) const noexcept override;
+    void prefetch_vector(uint32_t docid) const noexcept override { __builtin_prefetch(acquire_code(docid)); }
+};
+
+} // namespace search::tensor
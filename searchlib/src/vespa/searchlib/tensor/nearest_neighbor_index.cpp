@@ -1,3 +1,36 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "nearest_neighbor_index.h"
+
+namespace search::tensor {
+
+void NearestNeighborIndex::add_documents(std::span<const uint32_t> docids, vespalib::ThreadBundle&) {
+    for (uint32_t docid : docids) {
+        add_document(docid);
+    }
+}
+
+const std::string& NearestNeighborIndex::partition_attribute() const {
+    static const std::string empty;
+    return empty;
+}
+
+void NearestNeighborIndex::set_partition_attribute(std::shared_ptr<const search::attribute::IAttributeVector>,
+                                                   std::span<const uint32_t>, vespalib::ThreadBundle&) {
+}
+
+void NearestNeighborIndex::partition_attribute_changed(uint32_t) {
+}
+
+void NearestNeighborIndex::update_partitions() {
+}
+
+const NearestNeighborIndex* NearestNeighborIndex::get_partition(int64_t) const {
+    return nullptr;
+}
+
+uint32_t NearestNeighborIndex::get_partition_num_docs() const noexcept {
+    return 0;
+}
+
+} // namespace search::tensor
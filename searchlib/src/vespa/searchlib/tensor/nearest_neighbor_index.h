@@ -12,6 +12,8 @@
 
 #include <cstdint>
 #include <memory>
+#include <span>
+#include <string>
 #include <vector>
 
 class FastOS_FileInterface;
@@ -20,6 +22,7 @@ namespace vespalib {
 class Deadline;
 class GenericHeader;
 struct StateExplorer;
+struct ThreadBundle;
 } // namespace vespalib
 namespace vespalib::datastore {
 class CompactionSpec;
@@ -36,6 +39,9 @@ class LoadedBuffer;
 namespace search {
 class AddressSpaceUsage;
 }
+namespace search::attribute {
+class IAttributeVector;
+}
 namespace search::queryeval {
 class GlobalFilter;
 }
@@ -103,6 +109,16 @@ public:
      */
     virtual void complete_add_document(uint32_t docid, std::unique_ptr<PrepareResult> prepare_result) = 0;
 
+    /**
+     * Adds the given documents to the index, e.g. when building the index while loading the enclosing
+     * tensor attribute.
+     *
+     * This function is only called by the attribute writer thread, and the documents are neither changed
+     * nor removed while it runs. The given thread bundle can be used to run the prepare step for several
+     * documents in parallel. The default implementation adds one document at a time.
+     */
+    virtual void add_documents(std::span<const uint32_t> docids, vespalib::ThreadBundle& thread_bundle);
+
     virtual void remove_document(uint32_t docid) = 0;
     virtual void assign_generation(vespalib::Generation current_gen) = 0;
     virtual void reclaim_memory(vespalib::Generation first_used_gen) = 0;
@@ -146,6 +162,49 @@ public:
 
     virtual DistanceFunctionFactory& distance_function_factory() const = 0;
 
+    /**
+     * Returns the name of the integer attribute used to partition this index, or an empty string if the
+     * index is not partitioned.
+     */
+    virtual const std::string& partition_attribute() const;
+
+    /**
+     * Sets the attribute used to assign documents to partitions, and adds the given documents (all
+     * documents currently in the index) to their partitions. Only called by the attribute writer thread.
+     * The given thread bundle is used to build several partitions in parallel.
+     * The default implementation does nothing.
+     */
+    virtual void set_partition_attribute(std::shared_ptr<const search::attribute::IAttributeVector> attr,
+                                         std::span<const uint32_t> docids, vespalib::ThreadBundle& thread_bundle);
+
+    /**
+     * Notifies that the value of the partition attribute has changed for the given document, which is in
+     * the index. The document is moved to its new partition by the next call to update_partitions().
+     * Only called by the attribute writer thread. The default implementation does nothing.
+     */
+    virtual void partition_attribute_changed(uint32_t docid);
+
+    /**
+     * Moves the documents that were added, or that got a new value of the partition attribute, since the last
+     * call to their partitions, as given by the committed values of the partition attribute. Only called by the
+     * attribute writer thread, after the partition attribute is committed. The default implementation does nothing.
+     */
+    virtual void update_partitions();
+
+    /**
+     * Returns the index to search when all hits must have the given value of the partition attribute,
+     * or nullptr if this index must be searched (e.g. when the index is not partitioned).
+     * The returned index lives as long as this index.
+     */
+    virtual const NearestNeighborIndex* get_partition(int64_t key) const;
+
+    /**
+     * Returns the number of documents in this index when it is a partition returned by get_partition().
+     * Hit ratios of filters are calculated against this when searching the partition.
+     * Safe to call from reader threads. The default implementation returns 0.
+     */
+    virtual uint32_t get_partition_num_docs() const noexcept;
+
     /*
      * Used when checking consistency during load.
      * Called from writer only.
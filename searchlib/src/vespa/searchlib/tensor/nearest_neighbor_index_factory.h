@@ -11,6 +11,9 @@
 namespace search::attribute {
 class HnswIndexParams;
 }
+namespace vespalib::alloc {
+class MemoryAllocator;
+}
 
 namespace search::tensor {
 
@@ -19,6 +22,9 @@ class NearestNeighborIndex;
 
 /**
  * Factory interface used to instantiate an index used for (approximate) nearest neighbor search.
+ *
+ * The memory allocator is the one used by the enclosing tensor attribute, which is non-null when
+ * the attribute is paged (backed by a memory mapped file).
  */
 class NearestNeighborIndexFactory {
 public:
@@ -27,7 +33,8 @@ public:
     [[nodiscard]] virtual std::unique_ptr<NearestNeighborIndex>
     make(const DocVectorAccess& vectors, size_t vector_size, bool multi_vector_index,
          vespalib::eval::CellType cell_type, const search::attribute::HnswIndexParams& params,
-         const std::optional<attribute::QuantizationParams>& quant_params) const = 0;
+         const std::optional<attribute::QuantizationParams>&      quant_params,
+         const std::shared_ptr<vespalib::alloc::MemoryAllocator>& memory_allocator) const = 0;
 };
 
 } // namespace search::tensor
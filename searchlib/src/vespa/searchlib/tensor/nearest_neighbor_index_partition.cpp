@@ -0,0 +1,284 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "nearest_neighbor_index_partition.h"
+
+#include "nearest_neighbor_index_loader.h"
+#include "nearest_neighbor_index_saver.h"
+#include "vector_bundle.h"
+
+#include <vespa/searchlib/queryeval/global_filter.h>
+#include <vespa/vespalib/net/http/state_explorer.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/vespalib/util/generation_hold_list.hpp>
+#include <vespa/vespalib/util/rcuvector.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace search::tensor {
+
+using vespalib::Generation;
+
+namespace {
+
+/*
+ * Global filter for the local ids of a partition, checking the docids in the given global filter.
+ */
+class LocalFilter : public search::queryeval::GlobalFilter {
+    const NearestNeighborIndexPartition& _partition;
+    const GlobalFilter&                  _filter;
+    uint32_t                             _size;
+    uint32_t                             _count;
+
+public:
+    LocalFilter(const NearestNeighborIndexPartition& partition, const GlobalFilter& filter)
+        : _partition(partition),
+          _filter(filter),
+          _size(partition.get_local_id_limit()),
+          // The filter comes from a query where all hits have the partition key, so it only matches documents
+          // in the partition.
+          _count(std::min(filter.count(), partition.size())) {}
+    ~LocalFilter() override;
+    bool is_active() const override { return _filter.is_active(); }
+    uint32_t size() const override { return _size; }
+    uint32_t count() const override { return _count; }
+    bool check(uint32_t local_id) const override {
+        if (local_id >= _size) {
+            return false;
+        }
+        uint32_t docid = _partition.get_docid(local_id);
+        return (docid != 0) && (docid < _filter.size()) && _filter.check(docid);
+    }
+};
+
+LocalFilter::~LocalFilter() = default;
+
+struct NeighborsByDocId {
+    bool operator()(const NearestNeighborIndex::Neighbor& lhs, const NearestNeighborIndex::Neighbor& rhs) {
+        return (lhs.docid < rhs.docid);
+    }
+};
+
+} // namespace
+
+vespalib::eval::TypedCells
+NearestNeighborIndexPartition::LocalDocVectorAccess::get_vector(uint32_t local_id, uint32_t subspace) const noexcept {
+    return _vectors.get_vector(_partition.get_docid(local_id), subspace);
+}
+
+VectorBundle NearestNeighborIndexPartition::LocalDocVectorAccess::get_vectors(uint32_t local_id) const noexcept {
+    return _vectors.get_vectors(_partition.get_docid(local_id));
+}
+
+void NearestNeighborIndexPartition::LocalDocVectorAccess::prefetch_docid(uint32_t local_id) const noexcept {
+    _partition._docids.prefetch_elem_ref(local_id);
+}
+
+void NearestNeighborIndexPartition::LocalDocVectorAccess::prefetch_vector(uint32_t local_id) const noexcept {
+    uint32_t docid = _partition.get_docid(local_id);
+    _vectors.prefetch_docid(docid);
+    _vectors.prefetch_vector(docid);
+}
+
+NearestNeighborIndexPartition::NearestNeighborIndexPartition(const DocVectorAccess& vectors,
+                                                             const IndexFactory&    index_factory)
+    : _local_vectors(*this, vectors),
+      _generation_handler(),
+      _docids(),
+      _local_id_limit(1), // Starting with local id 1, as id 0 is not used by the underlying index.
+      _num_docs(0),
+      _local_ids(),
+      _hold_list(),
+      _free_list(),
+      _index() {
+    _docids.ensure_size(1);
+    _index = index_factory(_local_vectors);
+}
+
+NearestNeighborIndexPartition::~NearestNeighborIndexPartition() {
+    _hold_list.reclaim_all();
+}
+
+uint32_t NearestNeighborIndexPartition::allocate_local_id(uint32_t docid) {
+    assert(!contains(docid));
+    uint32_t local_id = 0;
+    if (_free_list.empty()) {
+        local_id = _local_id_limit.load(std::memory_order_relaxed);
+        _docids.ensure_size(local_id + 1);
+        _local_id_limit.store(local_id + 1, std::memory_order_release);
+    } else {
+        local_id = _free_list.back();
+        _free_list.pop_back();
+    }
+    _docids[local_id].store_release(docid);
+    _local_ids[docid] = local_id;
+    _num_docs.store(_local_ids.size(), std::memory_order_relaxed);
+    return local_id;
+}
+
+std::vector<NearestNeighborIndex::Neighbor>
+NearestNeighborIndexPartition::to_docids(std::vector<Neighbor> neighbors) const {
+    std::vector<Neighbor> result;
+    result.reserve(neighbors.size());
+    for (const auto& neighbor : neighbors) {
+        uint32_t docid = get_docid(neighbor.docid);
+        // The local id is freed if the document was removed while searching.
+        if (docid != 0) {
+            result.emplace_back(docid, neighbor.distance);
+        }
+    }
+    std::sort(result.begin(), result.end(), NeighborsByDocId());
+    return result;
+}
+
+vespalib::MemoryUsage NearestNeighborIndexPartition::mapping_memory_usage() const {
+    auto result = _docids.getMemoryUsage();
+    result.incAllocatedBytes(_local_ids.getMemoryConsumption() + _free_list.capacity() * sizeof(uint32_t));
+    result.incUsedBytes(_local_ids.getMemoryUsed() + _free_list.size() * sizeof(uint32_t));
+    return result;
+}
+
+void NearestNeighborIndexPartition::add_document(uint32_t docid) {
+    _index->add_document(allocate_local_id(docid));
+}
+
+std::unique_ptr<PrepareResult> NearestNeighborIndexPartition::prepare_add_document(uint32_t, VectorBundle,
+                                                                                   vespalib::GenerationGuard) const {
+    // The local id is allocated when the document is added.
+    return {};
+}
+
+void NearestNeighborIndexPartition::complete_add_document(uint32_t docid, std::unique_ptr<PrepareResult>) {
+    add_document(docid);
+}
+
+void NearestNeighborIndexPartition::add_documents(std::span<const uint32_t> docids,
+                                                  vespalib::ThreadBundle&   thread_bundle) {
+    std::vector<uint32_t> local_ids;
+    local_ids.reserve(docids.size());
+    for (uint32_t docid : docids) {
+        local_ids.push_back(allocate_local_id(docid));
+    }
+    _index->add_documents(local_ids, thread_bundle);
+}
+
+void NearestNeighborIndexPartition::remove_document(uint32_t docid) {
+    auto itr = _local_ids.find(docid);
+    if (itr == _local_ids.end()) {
+        return;
+    }
+    uint32_t local_id = itr->second;
+    _local_ids.erase(itr);
+    _num_docs.store(_local_ids.size(), std::memory_order_relaxed);
+    _index->remove_document(local_id);
+    _docids[local_id].store_release(0);
+    _hold_list.insert(local_id);
+}
+
+void NearestNeighborIndexPartition::assign_generation(Generation current_gen) {
+    // Note: RcuVector transfers hold lists as part of reallocation based on current generation.
+    //       We need to set the next generation here, as it is incremented on a higher level right after this call.
+    _docids.setGeneration(current_gen + 1);
+    _hold_list.assign_generation(current_gen);
+    _index->assign_generation(current_gen);
+}
+
+void NearestNeighborIndexPartition::reclaim_memory(Generation first_used_gen) {
+    _docids.reclaim_memory(first_used_gen);
+    _hold_list.reclaim(first_used_gen, [this](uint32_t local_id) { _free_list.push_back(local_id); });
+    _index->reclaim_memory(first_used_gen);
+}
+
+vespalib::GenerationGuard NearestNeighborIndexPartition::make_generation_read_guard() const {
+    return _generation_handler.takeGuard();
+}
+
+void NearestNeighborIndexPartition::inc_generation() {
+    auto current_gen = _generation_handler.getCurrentGeneration();
+    _docids.setGeneration(current_gen + 1);
+    _hold_list.assign_generation(current_gen);
+    _generation_handler.incGeneration();
+    _index->inc_generation();
+}
+
+void NearestNeighborIndexPartition::reclaim_unused_memory() {
+    _generation_handler.update_oldest_used_generation();
+    auto oldest_used_gen = _generation_handler.get_oldest_used_generation();
+    _docids.reclaim_memory(oldest_used_gen);
+    _hold_list.reclaim(oldest_used_gen, [this](uint32_t local_id) { _free_list.push_back(local_id); });
+    _index->reclaim_unused_memory();
+}
+
+bool NearestNeighborIndexPartition::consider_compact(const CompactionStrategy& compaction_strategy) {
+    return _index->consider_compact(compaction_strategy);
+}
+
+vespalib::MemoryUsage NearestNeighborIndexPartition::update_stat(const CompactionStrategy& compaction_strategy) {
+    auto result = _index->update_stat(compaction_strategy);
+    result.merge(mapping_memory_usage());
+    return result;
+}
+
+vespalib::MemoryUsage NearestNeighborIndexPartition::memory_usage() const {
+    auto result = _index->memory_usage();
+    result.merge(mapping_memory_usage());
+    return result;
+}
+
+void NearestNeighborIndexPartition::populate_address_space_usage(search::AddressSpaceUsage& usage) const {
+    _index->populate_address_space_usage(usage);
+}
+
+std::unique_ptr<vespalib::StateExplorer> NearestNeighborIndexPartition::make_state_explorer() const {
+    return _index->make_state_explorer();
+}
+
+void NearestNeighborIndexPartition::shrink_lid_space(uint32_t) {
+    // Local ids are reused, and are not affected by the lid space of the enclosing tensor attribute.
+}
+
+std::unique_ptr<NearestNeighborIndexSaver> NearestNeighborIndexPartition::make_saver(vespalib::GenericHeader&) const {
+    return {};
+}
+
+std::unique_ptr<NearestNeighborIndexLoader>
+NearestNeighborIndexPartition::make_loader(FastOS_FileInterface&, const vespalib::GenericHeader&) {
+    return {};
+}
+
+std::vector<NearestNeighborIndex::Neighbor>
+NearestNeighborIndexPartition::find_top_k(Stats& stats, uint32_t k, const BoundDistanceFunction& df,
+                                          uint32_t explore_k, double exploration_slack, bool prefetch_tensors,
+                                          const vespalib::Deadline& doom, double distance_threshold) const {
+    auto guard = _generation_handler.takeGuard();
+    return to_docids(_index->find_top_k(stats, k, df, explore_k, exploration_slack, prefetch_tensors, doom,
+                                        distance_threshold));
+}
+
+std::vector<NearestNeighborIndex::Neighbor> NearestNeighborIndexPartition::find_top_k_with_filter(
+    Stats& stats, uint32_t k, const BoundDistanceFunction& df, const GlobalFilter& filter, bool low_hit_ratio,
+    double exploration, uint32_t explore_k, double exploration_slack, bool prefetch_tensors,
+    const vespalib::Deadline& doom, double distance_threshold) const {
+    auto        guard = _generation_handler.takeGuard();
+    LocalFilter local_filter(*this, filter);
+    return to_docids(_index->find_top_k_with_filter(stats, k, df, local_filter, low_hit_ratio, exploration,
+                                                    explore_k, exploration_slack, prefetch_tensors, doom,
+                                                    distance_threshold));
+}
+
+DistanceFunctionFactory& NearestNeighborIndexPartition::distance_function_factory() const {
+    return _index->distance_function_factory();
+}
+
+uint32_t NearestNeighborIndexPartition::check_consistency(uint32_t) const noexcept {
+    return _index->check_consistency(get_local_id_limit());
+}
+
+} // namespace search::tensor
+
+namespace vespalib {
+
+template class RcuVectorBase<vespalib::datastore::AtomicValueWrapper<uint32_t>>;
+template class RcuVector<vespalib::datastore::AtomicValueWrapper<uint32_t>>;
+
+} // namespace vespalib
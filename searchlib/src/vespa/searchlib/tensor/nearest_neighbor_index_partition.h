@@ -0,0 +1,112 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "doc_vector_access.h"
+#include "nearest_neighbor_index.h"
+
+#include <vespa/vespalib/datastore/atomic_value_wrapper.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/util/generation_hold_list.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/rcuvector.h>
+
+#include <atomic>
+#include <functional>
+
+namespace search::tensor {
+
+/**
+ * Nearest neighbor index for a subset of the documents in a tensor attribute (a partition).
+ *
+ * The documents are stored in an underlying index using compact local ids, so the size of the
+ * underlying index depends on the number of documents in the partition rather than the largest docid.
+ * Local ids that are freed are reused when no reader threads are accessing them (after a hold cycle).
+ * The public interface uses docids of the enclosing tensor attribute.
+ *
+ * Documents are added by the attribute writer thread, as local ids are allocated there.
+ * The partition is not saved.
+ */
+class NearestNeighborIndexPartition : public NearestNeighborIndex {
+public:
+    using IndexFactory = std::function<std::unique_ptr<NearestNeighborIndex>(const DocVectorAccess&)>;
+
+private:
+    using LocalIdVector = vespalib::RcuVector<vespalib::datastore::AtomicValueWrapper<uint32_t>>;
+    using LocalIdHoldList = vespalib::GenerationHoldList<uint32_t, false, true>;
+
+    /*
+     * Provides the vectors of the underlying index, mapping from local id to docid.
+     */
+    class LocalDocVectorAccess : public DocVectorAccess {
+        const NearestNeighborIndexPartition& _partition;
+        const DocVectorAccess&               _vectors;
+
+    public:
+        LocalDocVectorAccess(const NearestNeighborIndexPartition& partition, const DocVectorAccess& vectors) noexcept
+            : _partition(partition), _vectors(vectors) {}
+        vespalib::eval::TypedCells get_vector(uint32_t local_id, uint32_t subspace) const noexcept override;
+        VectorBundle get_vectors(uint32_t local_id) const noexcept override;
+        void prefetch_docid(uint32_t local_id) const noexcept override;
+        void prefetch_vector(uint32_t local_id) const noexcept override;
+    };
+
+    LocalDocVectorAccess                   _local_vectors;
+    vespalib::GenerationHandler            _generation_handler;
+    LocalIdVector                          _docids;         // Maps from local id to docid
+    std::atomic<uint32_t>                  _local_id_limit;
+    std::atomic<uint32_t>                  _num_docs;
+    vespalib::hash_map<uint32_t, uint32_t> _local_ids;      // Maps from docid to local id, writer only
+    LocalIdHoldList                        _hold_list;
+    std::vector<uint32_t>                  _free_list;
+    std::unique_ptr<NearestNeighborIndex>  _index;
+
+    uint32_t allocate_local_id(uint32_t docid);
+    std::vector<Neighbor> to_docids(std::vector<Neighbor> neighbors) const;
+    vespalib::MemoryUsage mapping_memory_usage() const;
+
+public:
+    NearestNeighborIndexPartition(const DocVectorAccess& vectors, const IndexFactory& index_factory);
+    ~NearestNeighborIndexPartition() override;
+
+    uint32_t get_docid(uint32_t local_id) const noexcept {
+        return _docids.acquire_elem_ref(local_id).load_acquire();
+    }
+    uint32_t get_local_id_limit() const noexcept { return _local_id_limit.load(std::memory_order_acquire); }
+    bool contains(uint32_t docid) const noexcept { return _local_ids.find(docid) != _local_ids.end(); }
+    uint32_t size() const noexcept { return _num_docs.load(std::memory_order_relaxed); }
+
+    void add_document(uint32_t docid) override;
+    std::unique_ptr<PrepareResult> prepare_add_document(uint32_t docid, VectorBundle vectors,
+                                                        vespalib::GenerationGuard read_guard) const override;
+    void complete_add_document(uint32_t docid, std::unique_ptr<PrepareResult> prepare_result) override;
+    void add_documents(std::span<const uint32_t> docids, vespalib::ThreadBundle& thread_bundle) override;
+    void remove_document(uint32_t docid) override;
+    void assign_generation(vespalib::Generation current_gen) override;
+    void reclaim_memory(vespalib::Generation first_used_gen) override;
+    vespalib::GenerationGuard make_generation_read_guard() const override;
+    void inc_generation() override;
+    void reclaim_unused_memory() override;
+    bool consider_compact(const CompactionStrategy& compaction_strategy) override;
+    vespalib::MemoryUsage update_stat(const CompactionStrategy& compaction_strategy) override;
+    vespalib::MemoryUsage memory_usage() const override;
+    void populate_address_space_usage(search::AddressSpaceUsage& usage) const override;
+    std::unique_ptr<vespalib::StateExplorer> make_state_explorer() const override;
+    void shrink_lid_space(uint32_t doc_id_limit) override;
+    std::unique_ptr<NearestNeighborIndexSaver> make_saver(vespalib::GenericHeader& header) const override;
+    std::unique_ptr<NearestNeighborIndexLoader> make_loader(FastOS_FileInterface&          file,
+                                                            const vespalib::GenericHeader& header) override;
+    std::vector<Neighbor> find_top_k(Stats& stats, uint32_t k, const BoundDistanceFunction& df, uint32_t explore_k,
+                                     double exploration_slack, bool prefetch_tensors, const vespalib::Deadline& doom,
+                                     double distance_threshold) const override;
+    std::vector<Neighbor> find_top_k_with_filter(Stats& stats, uint32_t k, const BoundDistanceFunction& df,
+                                                 const GlobalFilter& filter, bool low_hit_ratio, double exploration,
+                                                 uint32_t explore_k, double exploration_slack, bool prefetch_tensors,
+                                                 const vespalib::Deadline& doom,
+                                                 double                    distance_threshold) const override;
+    DistanceFunctionFactory& distance_function_factory() const override;
+    uint32_t check_consistency(uint32_t docid_limit) const noexcept override;
+    uint32_t get_partition_num_docs() const noexcept override { return size(); }
+};
+
+} // namespace search::tensor
@@ -0,0 +1,360 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "partitioned_nearest_neighbor_index.h"
+
+#include "nearest_neighbor_index_loader.h"
+#include "nearest_neighbor_index_saver.h"
+
+#include <vespa/searchcommon/attribute/iattributevector.h>
+#include <vespa/vespalib/net/http/state_explorer.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/vespalib/stllike/hash_set.hpp>
+#include <vespa/vespalib/util/thread_bundle.h>
+
+#include <algorithm>
+
+namespace search::tensor {
+
+namespace {
+
+using PartitionBuild = std::pair<NearestNeighborIndexPartition*, std::vector<uint32_t>>;
+
+/*
+ * Builds partitions in parallel with other tasks, taking the next partition to build from a shared position.
+ */
+class BuildPartitionsTask : public vespalib::Runnable {
+    std::span<PartitionBuild> _builds;
+    std::atomic<size_t>&      _next;
+
+public:
+    BuildPartitionsTask(std::span<PartitionBuild> builds, std::atomic<size_t>& next) noexcept
+        : _builds(builds), _next(next) {}
+    void run() override {
+        for (size_t i = _next.fetch_add(1, std::memory_order_relaxed); i < _builds.size();
+             i = _next.fetch_add(1, std::memory_order_relaxed))
+        {
+            auto& [partition, docids] = _builds[i];
+            partition->add_documents(docids, vespalib::ThreadBundle::trivial());
+        }
+    }
+};
+
+} // namespace
+
+PartitionedNearestNeighborIndex::PartitionedNearestNeighborIndex(std::string partition_attribute_name,
+                                                                 const DocVectorAccess&                vectors,
+                                                                 std::unique_ptr<NearestNeighborIndex> global,
+                                                                 IndexFactory partition_factory)
+    : _vectors(vectors),
+      _partition_factory(std::move(partition_factory)),
+      _global(std::move(global)),
+      _empty(std::make_unique<Partition>(_vectors, _partition_factory)),
+      _partition_attribute_name(std::move(partition_attribute_name)),
+      _lock(),
+      _partitions(),
+      _partitions_ready(false),
+      _writer_partition_attribute(),
+      _doc_partition(),
+      _pending(),
+      _assigned_gen() {
+}
+
+PartitionedNearestNeighborIndex::~PartitionedNearestNeighborIndex() = default;
+
+bool PartitionedNearestNeighborIndex::get_key(const IAttributeVector& attr, uint32_t docid, int64_t& key) {
+    if (docid >= attr.getNumDocs()) {
+        return false;
+    }
+    key = attr.getInt(docid);
+    return true;
+}
+
+NearestNeighborIndexPartition* PartitionedNearestNeighborIndex::find_partition(int64_t key) const {
+    std::lock_guard guard(_lock);
+    auto            itr = _partitions.find(key);
+    return (itr != _partitions.end()) ? itr->second.get() : nullptr;
+}
+
+NearestNeighborIndexPartition& PartitionedNearestNeighborIndex::get_or_create_partition(int64_t key) {
+    auto* partition = find_partition(key);
+    if (partition != nullptr) {
+        return *partition;
+    }
+    auto new_partition = std::make_unique<Partition>(_vectors, _partition_factory);
+    if (_assigned_gen.has_value()) {
+        new_partition->assign_generation(_assigned_gen.value());
+    }
+    partition = new_partition.get();
+    std::lock_guard guard(_lock);
+    _partitions[key] = std::move(new_partition);
+    return *partition;
+}
+
+NearestNeighborIndexPartition* PartitionedNearestNeighborIndex::get_doc_partition(uint32_t docid) const noexcept {
+    return (docid < _doc_partition.size()) ? _doc_partition[docid] : nullptr;
+}
+
+void PartitionedNearestNeighborIndex::set_doc_partition(uint32_t docid, Partition* partition) {
+    if (docid >= _doc_partition.size()) {
+        if (partition == nullptr) {
+            return;
+        }
+        _doc_partition.resize(docid + 1, nullptr);
+    }
+    _doc_partition[docid] = partition;
+}
+
+void PartitionedNearestNeighborIndex::update_partition(uint32_t docid) {
+    int64_t    key = 0;
+    Partition* partition = get_key(*_writer_partition_attribute, docid, key) ? &get_or_create_partition(key) : nullptr;
+    Partition* old_partition = get_doc_partition(docid);
+    if (partition == old_partition) {
+        return;
+    }
+    if (old_partition != nullptr) {
+        old_partition->remove_document(docid);
+    }
+    if (partition != nullptr) {
+        partition->add_document(docid);
+    }
+    set_doc_partition(docid, partition);
+}
+
+void PartitionedNearestNeighborIndex::mark_pending(uint32_t docid) {
+    // Before the partitions are built, all documents are added when building them.
+    if (_writer_partition_attribute) {
+        _pending.insert(docid);
+    }
+}
+
+void PartitionedNearestNeighborIndex::add_document(uint32_t docid) {
+    _global->add_document(docid);
+    mark_pending(docid);
+}
+
+std::unique_ptr<PrepareResult>
+PartitionedNearestNeighborIndex::prepare_add_document(uint32_t docid, VectorBundle vectors,
+                                                      vespalib::GenerationGuard read_guard) const {
+    // Only the global index uses the two-phase add. The document is added to its partition by update_partitions().
+    return _global->prepare_add_document(docid, vectors, std::move(read_guard));
+}
+
+void PartitionedNearestNeighborIndex::complete_add_document(uint32_t                       docid,
+                                                            std::unique_ptr<PrepareResult> prepare_result) {
+    _global->complete_add_document(docid, std::move(prepare_result));
+    mark_pending(docid);
+}
+
+void PartitionedNearestNeighborIndex::add_to_partitions(std::span<const uint32_t> docids,
+                                                        vespalib::ThreadBundle&   thread_bundle) {
+    vespalib::hash_map<int64_t, std::vector<uint32_t>> groups;
+    int64_t                                            key = 0;
+    for (uint32_t docid : docids) {
+        if (get_key(*_writer_partition_attribute, docid, key)) {
+            groups[key].push_back(docid);
+        }
+    }
+    std::vector<PartitionBuild> builds;
+    builds.reserve(groups.size());
+    for (auto& [group_key, group_docids] : groups) {
+        auto& partition = get_or_create_partition(group_key);
+        for (uint32_t docid : group_docids) {
+            set_doc_partition(docid, &partition);
+        }
+        builds.emplace_back(&partition, std::move(group_docids));
+    }
+    std::sort(builds.begin(), builds.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.second.size() > rhs.second.size(); });
+    // Partitions larger than a fair share of the documents are built one at a time using all threads,
+    // the remaining partitions are built in parallel using one thread each.
+    size_t fair_share = docids.size() / std::max(thread_bundle.size(), size_t(1));
+    size_t pos = 0;
+    for (; pos < builds.size() && builds[pos].second.size() > fair_share; ++pos) {
+        builds[pos].first->add_documents(builds[pos].second, thread_bundle);
+    }
+    std::span<PartitionBuild>        small_builds(builds.data() + pos, builds.size() - pos);
+    std::atomic<size_t>              next(0);
+    std::vector<BuildPartitionsTask> tasks;
+    size_t                           num_tasks = std::min(thread_bundle.size(), small_builds.size());
+    tasks.reserve(num_tasks);
+    for (size_t i = 0; i < num_tasks; ++i) {
+        tasks.emplace_back(small_builds, next);
+    }
+    if (!tasks.empty()) {
+        thread_bundle.run(tasks);
+    }
+}
+
+void PartitionedNearestNeighborIndex::add_documents(std::span<const uint32_t> docids,
+                                                    vespalib::ThreadBundle&   thread_bundle) {
+    _global->add_documents(docids, thread_bundle);
+    for (uint32_t docid : docids) {
+        mark_pending(docid);
+    }
+}
+
+void PartitionedNearestNeighborIndex::remove_document(uint32_t docid) {
+    _global->remove_document(docid);
+    if (auto* partition = get_doc_partition(docid)) {
+        partition->remove_document(docid);
+        _doc_partition[docid] = nullptr;
+    }
+    _pending.erase(docid);
+}
+
+void PartitionedNearestNeighborIndex::assign_generation(vespalib::Generation current_gen) {
+    _assigned_gen = current_gen;
+    _global->assign_generation(current_gen);
+    for (auto& partition : _partitions) {
+        partition.second->assign_generation(current_gen);
+    }
+}
+
+void PartitionedNearestNeighborIndex::reclaim_memory(vespalib::Generation first_used_gen) {
+    _global->reclaim_memory(first_used_gen);
+    for (auto& partition : _partitions) {
+        partition.second->reclaim_memory(first_used_gen);
+    }
+}
+
+vespalib::GenerationGuard PartitionedNearestNeighborIndex::make_generation_read_guard() const {
+    return _global->make_generation_read_guard();
+}
+
+void PartitionedNearestNeighborIndex::inc_generation() {
+    _global->inc_generation();
+    for (auto& partition : _partitions) {
+        partition.second->inc_generation();
+    }
+}
+
+void PartitionedNearestNeighborIndex::reclaim_unused_memory() {
+    _global->reclaim_unused_memory();
+    for (auto& partition : _partitions) {
+        partition.second->reclaim_unused_memory();
+    }
+}
+
+bool PartitionedNearestNeighborIndex::consider_compact(const CompactionStrategy& compaction_strategy) {
+    bool result = _global->consider_compact(compaction_strategy);
+    for (auto& partition : _partitions) {
+        if (partition.second->consider_compact(compaction_strategy)) {
+            result = true;
+        }
+    }
+    return result;
+}
+
+vespalib::MemoryUsage PartitionedNearestNeighborIndex::update_stat(const CompactionStrategy& compaction_strategy) {
+    auto result = _global->update_stat(compaction_strategy);
+    for (auto& partition : _partitions) {
+        result.merge(partition.second->update_stat(compaction_strategy));
+    }
+    result.incAllocatedBytes(_doc_partition.capacity() * sizeof(Partition*) + _pending.getMemoryConsumption());
+    result.incUsedBytes(_doc_partition.size() * sizeof(Partition*) + _pending.getMemoryConsumption());
+    return result;
+}
+
+vespalib::MemoryUsage PartitionedNearestNeighborIndex::memory_usage() const {
+    auto result = _global->memory_usage();
+    for (const auto& partition : _partitions) {
+        result.merge(partition.second->memory_usage());
+    }
+    result.incAllocatedBytes(_doc_partition.capacity() * sizeof(Partition*) + _pending.getMemoryConsumption());
+    result.incUsedBytes(_doc_partition.size() * sizeof(Partition*) + _pending.getMemoryConsumption());
+    return result;
+}
+
+void PartitionedNearestNeighborIndex::populate_address_space_usage(search::AddressSpaceUsage& usage) const {
+    // The partition indexes are smaller than the global index.
+    _global->populate_address_space_usage(usage);
+}
+
+std::unique_ptr<vespalib::StateExplorer> PartitionedNearestNeighborIndex::make_state_explorer() const {
+    return _global->make_state_explorer();
+}
+
+void PartitionedNearestNeighborIndex::shrink_lid_space(uint32_t doc_id_limit) {
+    _global->shrink_lid_space(doc_id_limit);
+    if (_doc_partition.size() > doc_id_limit) {
+        _doc_partition.resize(doc_id_limit);
+        _doc_partition.shrink_to_fit();
+    }
+}
+
+std::unique_ptr<NearestNeighborIndexSaver>
+PartitionedNearestNeighborIndex::make_saver(vespalib::GenericHeader& header) const {
+    return _global->make_saver(header);
+}
+
+std::unique_ptr<NearestNeighborIndexLoader>
+PartitionedNearestNeighborIndex::make_loader(FastOS_FileInterface& file, const vespalib::GenericHeader& header) {
+    return _global->make_loader(file, header);
+}
+
+std::vector<NearestNeighborIndex::Neighbor>
+PartitionedNearestNeighborIndex::find_top_k(Stats& stats, uint32_t k, const BoundDistanceFunction& df,
+                                            uint32_t explore_k, double exploration_slack, bool prefetch_tensors,
+                                            const vespalib::Deadline& doom, double distance_threshold) const {
+    return _global->find_top_k(stats, k, df, explore_k, exploration_slack, prefetch_tensors, doom,
+                               distance_threshold);
+}
+
+std::vector<NearestNeighborIndex::Neighbor> PartitionedNearestNeighborIndex::find_top_k_with_filter(
+    Stats& stats, uint32_t k, const BoundDistanceFunction& df, const GlobalFilter& filter, bool low_hit_ratio,
+    double exploration, uint32_t explore_k, double exploration_slack, bool prefetch_tensors,
+    const vespalib::Deadline& doom, double distance_threshold) const {
+    return _global->find_top_k_with_filter(stats, k, df, filter, low_hit_ratio, exploration, explore_k,
+                                           exploration_slack, prefetch_tensors, doom, distance_threshold);
+}
+
+DistanceFunctionFactory& PartitionedNearestNeighborIndex::distance_function_factory() const {
+    // Query vectors are bound using the global index, also when searching a partition index.
+    return _global->distance_function_factory();
+}
+
+uint32_t PartitionedNearestNeighborIndex::check_consistency(uint32_t docid_limit) const noexcept {
+    return _global->check_consistency(docid_limit);
+}
+
+void PartitionedNearestNeighborIndex::set_partition_attribute(std::shared_ptr<const IAttributeVector> attr,
+                                                              std::span<const uint32_t>               docids,
+                                                              vespalib::ThreadBundle& thread_bundle) {
+    bool build = !_writer_partition_attribute;
+    _writer_partition_attribute = std::move(attr);
+    if (build) {
+        add_to_partitions(docids, thread_bundle);
+        _partitions_ready.store(true, std::memory_order_release);
+    }
+}
+
+void PartitionedNearestNeighborIndex::partition_attribute_changed(uint32_t docid) {
+    mark_pending(docid);
+}
+
+void PartitionedNearestNeighborIndex::update_partitions() {
+    if (_pending.empty()) {
+        return;
+    }
+    std::vector<uint32_t> docids(_pending.begin(), _pending.end());
+    _pending.clear();
+    std::sort(docids.begin(), docids.end());
+    for (uint32_t docid : docids) {
+        update_partition(docid);
+    }
+}
+
+const NearestNeighborIndex* PartitionedNearestNeighborIndex::get_partition(int64_t key) const {
+    if (!_partitions_ready.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    auto* partition = find_partition(key);
+    return (partition != nullptr) ? partition : _empty.get();
+}
+
+size_t PartitionedNearestNeighborIndex::num_partitions() const {
+    std::lock_guard guard(_lock);
+    return _partitions.size();
+}
+
+} // namespace search::tensor
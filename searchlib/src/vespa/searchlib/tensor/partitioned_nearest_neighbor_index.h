@@ -0,0 +1,111 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "nearest_neighbor_index.h"
+#include "nearest_neighbor_index_partition.h"
+
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/stllike/hash_set.h>
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <optional>
+
+namespace search::tensor {
+
+/**
+ * Nearest neighbor index partitioned by the value of an integer attribute (e.g. a tenant id).
+ *
+ * All documents are added to a global index, which is used for saving, loading and unrestricted search.
+ * In addition, each document is added to a (much smaller) index for its value of the partition attribute.
+ * A query with an equality filter on the partition attribute searches the index of that partition instead
+ * of searching the global index with a highly selective filter. Each partition index uses compact local ids,
+ * see NearestNeighborIndexPartition.
+ *
+ * The partition indexes are not saved. They are built when the partition attribute is set (after the
+ * enclosing tensor attribute is loaded), and until then all queries use the global index. Afterwards,
+ * documents that are added, or that get a new value of the partition attribute, are moved to their
+ * partitions by update_partitions(), which is called after the partition attribute is committed.
+ * A partition index is never removed, as queries might use it.
+ */
+class PartitionedNearestNeighborIndex : public NearestNeighborIndex {
+public:
+    using IndexFactory = NearestNeighborIndexPartition::IndexFactory;
+    using IAttributeVector = search::attribute::IAttributeVector;
+
+private:
+    using Partition = NearestNeighborIndexPartition;
+    using PartitionMap = vespalib::hash_map<int64_t, std::unique_ptr<Partition>>;
+
+    const DocVectorAccess&                  _vectors;
+    IndexFactory                            _partition_factory;
+    std::unique_ptr<NearestNeighborIndex>   _global;
+    std::unique_ptr<Partition>              _empty;
+    std::string                             _partition_attribute_name;
+    mutable std::mutex                      _lock;
+    PartitionMap                            _partitions;                 // Guarded by _lock
+    std::atomic<bool>                       _partitions_ready;
+    std::shared_ptr<const IAttributeVector> _writer_partition_attribute; // Writer only
+    std::vector<Partition*>                 _doc_partition;              // Writer only
+    vespalib::hash_set<uint32_t>            _pending;                    // Writer only
+    std::optional<vespalib::Generation>     _assigned_gen;               // Writer only
+
+    static bool get_key(const IAttributeVector& attr, uint32_t docid, int64_t& key);
+    Partition* find_partition(int64_t key) const;
+    Partition& get_or_create_partition(int64_t key);
+    Partition* get_doc_partition(uint32_t docid) const noexcept;
+    void       set_doc_partition(uint32_t docid, Partition* partition);
+    void       update_partition(uint32_t docid);
+    void       add_to_partitions(std::span<const uint32_t> docids, vespalib::ThreadBundle& thread_bundle);
+    void       mark_pending(uint32_t docid);
+
+public:
+    PartitionedNearestNeighborIndex(std::string partition_attribute_name, const DocVectorAccess& vectors,
+                                    std::unique_ptr<NearestNeighborIndex> global, IndexFactory partition_factory);
+    ~PartitionedNearestNeighborIndex() override;
+
+    void add_document(uint32_t docid) override;
+    std::unique_ptr<PrepareResult> prepare_add_document(uint32_t docid, VectorBundle vectors,
+                                                        vespalib::GenerationGuard read_guard) const override;
+    void complete_add_document(uint32_t docid, std::unique_ptr<PrepareResult> prepare_result) override;
+    void add_documents(std::span<const uint32_t> docids, vespalib::ThreadBundle& thread_bundle) override;
+    void remove_document(uint32_t docid) override;
+    void assign_generation(vespalib::Generation current_gen) override;
+    void reclaim_memory(vespalib::Generation first_used_gen) override;
+    vespalib::GenerationGuard make_generation_read_guard() const override;
+    void inc_generation() override;
+    void reclaim_unused_memory() override;
+    bool consider_compact(const CompactionStrategy& compaction_strategy) override;
+    vespalib::MemoryUsage update_stat(const CompactionStrategy& compaction_strategy) override;
+    vespalib::MemoryUsage memory_usage() const override;
+    void populate_address_space_usage(search::AddressSpaceUsage& usage) const override;
+    std::unique_ptr<vespalib::StateExplorer> make_state_explorer() const override;
+    void shrink_lid_space(uint32_t doc_id_limit) override;
+    std::unique_ptr<NearestNeighborIndexSaver> make_saver(vespalib::GenericHeader& header) const override;
+    std::unique_ptr<NearestNeighborIndexLoader> make_loader(FastOS_FileInterface&          file,
+                                                            const vespalib::GenericHeader& header) override;
+    std::vector<Neighbor> find_top_k(Stats& stats, uint32_t k, const BoundDistanceFunction& df, uint32_t explore_k,
+                                     double exploration_slack, bool prefetch_tensors, const vespalib::Deadline& doom,
+                                     double distance_threshold) const override;
+    std::vector<Neighbor> find_top_k_with_filter(Stats& stats, uint32_t k, const BoundDistanceFunction& df,
+                                                 const GlobalFilter& filter, bool low_hit_ratio, double exploration,
+                                                 uint32_t explore_k, double exploration_slack, bool prefetch_tensors,
+                                                 const vespalib::Deadline& doom,
+                                                 double                    distance_threshold) const override;
+    DistanceFunctionFactory& distance_function_factory() const override;
+    uint32_t check_consistency(uint32_t docid_limit) const noexcept override;
+
+    const std::string& partition_attribute() const override { return _partition_attribute_name; }
+    void set_partition_attribute(std::shared_ptr<const IAttributeVector> attr, std::span<const uint32_t> docids,
+                                 vespalib::ThreadBundle& thread_bundle) override;
+    void partition_attribute_changed(uint32_t docid) override;
+    void update_partitions() override;
+    const NearestNeighborIndex* get_partition(int64_t key) const override;
+
+    const NearestNeighborIndex& global_index() const noexcept { return *_global; }
+    size_t num_partitions() const;
+};
+
+} // namespace search::tensor
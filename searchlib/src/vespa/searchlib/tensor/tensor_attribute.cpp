@@ -125,7 +125,8 @@ TensorAttribute::TensorAttribute(std::string_view name, const Config& cfg, Tenso
         // Note that we always pass the dimensionality of the unquantized (original) tensor type
         size_t vector_size = cfg.unquantized_tensor_type().dense_subspace_size();
         _index = index_factory.make(*this, vector_size, !_is_dense, cfg.tensorType().cell_type(),
-                                    cfg.hnsw_index_params().value(), cfg.quantization_params());
+                                    cfg.hnsw_index_params().value(), cfg.quantization_params(),
+                                    get_memory_allocator());
     }
 }
 
@@ -336,7 +337,7 @@ uint32_t TensorAttribute::getVersion() const {
 }
 
 bool TensorAttribute::onLoad(vespalib::Executor* executor) {
-    TensorAttributeLoader loader(*this, getGenerationHandler(), _refVector, _tensorStore, _index.get());
+    TensorAttributeLoader loader(*this, _refVector, _tensorStore, _index.get());
     return loader.on_load(executor);
 }
 
@@ -424,6 +425,37 @@ void TensorAttribute::complete_set_tensor(DocId docid, const vespalib::eval::Val
     }
 }
 
+void TensorAttribute::set_nearest_neighbor_partition_attribute(
+    std::shared_ptr<const search::attribute::IAttributeVector> attr, vespalib::ThreadBundle& thread_bundle) {
+    if (!_index || _index->partition_attribute().empty()) {
+        return;
+    }
+    std::vector<uint32_t> docids;
+    uint32_t              docid_limit = getCommittedDocIdLimit();
+    for (uint32_t docid = 1; docid < docid_limit; ++docid) {
+        if (_refVector[docid].load_relaxed().valid()) {
+            docids.push_back(docid);
+        }
+    }
+    _index->set_partition_attribute(std::move(attr), docids, thread_bundle);
+    commit();
+}
+
+void TensorAttribute::nearest_neighbor_partition_changed(DocId docid) {
+    if (!_index || _index->partition_attribute().empty()) {
+        return;
+    }
+    if (docid < _refVector.size() && _refVector[docid].load_relaxed().valid()) {
+        _index->partition_attribute_changed(docid);
+    }
+}
+
+void TensorAttribute::update_nearest_neighbor_partitions() {
+    if (_index) {
+        _index->update_partitions();
+    }
+}
+
 attribute::DistanceMetric TensorAttribute::distance_metric() const {
     return getConfig().distance_metric();
 }
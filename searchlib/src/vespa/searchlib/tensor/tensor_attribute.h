@@ -15,6 +15,10 @@
 
 #include <atomic>
 
+namespace vespalib {
+struct ThreadBundle;
+}
+
 namespace vespalib::eval {
 struct Value;
 struct ValueBuilderFactory;
@@ -128,6 +132,32 @@ public:
      */
     virtual void complete_set_tensor(DocId docid, const vespalib::eval::Value& tensor,
                                      std::unique_ptr<PrepareResult> prepare_result);
+
+    /**
+     * Sets the integer attribute used to partition the nearest neighbor index, building the
+     * partitions for all documents in the index using the given thread bundle.
+     * Has no effect if the index is not partitioned.
+     *
+     * This function is only called by the attribute writer thread.
+     */
+    void set_nearest_neighbor_partition_attribute(std::shared_ptr<const search::attribute::IAttributeVector> attr,
+                                                  vespalib::ThreadBundle& thread_bundle);
+
+    /**
+     * Signals that the value of the partition attribute has changed for the given document.
+     * The document is moved to its new partition by update_nearest_neighbor_partitions().
+     *
+     * This function is only called by the attribute writer thread.
+     */
+    void nearest_neighbor_partition_changed(DocId docid);
+
+    /**
+     * Moves added documents, and documents with a changed value of the partition attribute, to their
+     * partitions of the nearest neighbor index. Called after the partition attribute is committed.
+     *
+     * This function is only called by the attribute writer thread.
+     */
+    void update_nearest_neighbor_partitions();
     void set_memory_usage_at_save_start(uint64_t memory_usage) noexcept;
     void set_size_on_disk(uint64_t value) noexcept override;
     uint64_t getEstimatedSaveByteSize() const override;
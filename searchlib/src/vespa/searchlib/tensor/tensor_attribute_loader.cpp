@@ -12,28 +12,23 @@
 #include <vespa/searchcommon/attribute/config.h>
 #include <vespa/searchlib/attribute/attribute_header.h>
 #include <vespa/searchlib/attribute/blob_sequence_reader.h>
+#include <vespa/searchlib/attribute/executor_thread_bundle.h>
 #include <vespa/searchlib/attribute/load_utils.h>
 #include <vespa/searchlib/attribute/readerbase.h>
 #include <vespa/searchlib/util/disk_space_calculator.h>
 #include <vespa/vespalib/objects/nbostream.h>
-#include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/jsonwriter.h>
-#include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/time.h>
 
-#include <vespa/vespalib/util/arrayqueue.hpp>
-
-#include <condition_variable>
 #include <filesystem>
-#include <mutex>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.tensor.tensor_attribute_loader");
 
 using search::attribute::AttributeHeader;
 using search::attribute::BlobSequenceReader;
+using search::attribute::ExecutorThreadBundle;
 using search::attribute::LoadUtils;
-using vespalib::CpuUsage;
 using vespalib::datastore::EntryRef;
 
 namespace search::tensor {
@@ -106,100 +101,42 @@ public:
 };
 
 /**
- * Will build nearest neighbor index in parallel. Note that indexing order is not guaranteed,
- * but that is inline with the guarantees vespa already has.
+ * Will build nearest neighbor index in parallel, by adding batches of documents using the bulk add
+ * of the index. Note that indexing order is not guaranteed, but that is inline with the guarantees
+ * vespa already has.
  */
 class ThreadedIndexBuilder : public IndexBuilder {
 public:
-    ThreadedIndexBuilder(TensorAttribute& attr, vespalib::GenerationHandler& generation_handler, TensorStore& store,
-                         NearestNeighborIndex& index, vespalib::Executor& shared_executor)
+    ThreadedIndexBuilder(TensorAttribute& attr, NearestNeighborIndex& index, vespalib::Executor& shared_executor)
         : _attr(attr),
-          _generation_handler(generation_handler),
           _index(index),
-          _shared_executor(shared_executor),
-          _queue(MAX_PENDING),
-          _pending(0) {
-        (void)store;
-    }
-    void add(uint32_t lid) override;
-    void wait_complete() override { drainUntilPending(0); }
-
-private:
-    using Entry = std::pair<uint32_t, std::unique_ptr<PrepareResult>>;
-    using Queue = vespalib::ArrayQueue<Entry>;
-
-    bool pop(Entry& entry) {
-        std::unique_lock guard(_mutex);
-        if (_queue.empty())
-            return false;
-        entry = std::move(_queue.front());
-        _queue.pop();
-        return true;
+          _thread_bundle(shared_executor),
+          _batch() {
+        _batch.reserve(BATCH_SIZE);
     }
-    void drainQ() {
-        Queue queue(MAX_PENDING);
-        {
-            std::unique_lock guard(_mutex);
-            queue.swap(_queue);
-        }
-        while (!queue.empty()) {
-            auto item = std::move(queue.front());
-            queue.pop();
-            complete(item.first, std::move(item.second));
+    void add(uint32_t lid) override {
+        _batch.push_back(lid);
+        if (_batch.size() >= BATCH_SIZE) {
+            flush();
         }
     }
+    void wait_complete() override { flush(); }
 
-    void complete(uint32_t lid, std::unique_ptr<PrepareResult> prepared) {
-        _index.complete_add_document(lid, std::move(prepared));
-        --_pending;
-        if ((lid % LOAD_COMMIT_INTERVAL) == 0) {
+private:
+    void flush() {
+        if (!_batch.empty()) {
+            _index.add_documents(_batch, _thread_bundle);
+            _batch.clear();
             _attr.commit();
-        };
-    }
-    void drainUntilPending(uint32_t maxPending) {
-        while (_pending > maxPending) {
-            {
-                std::unique_lock guard(_mutex);
-                while (_queue.empty()) {
-                    _cond.wait(guard);
-                }
-            }
-            drainQ();
         }
     }
-    static constexpr uint32_t          MAX_PENDING = 1000;
-    TensorAttribute&                   _attr;
-    const vespalib::GenerationHandler& _generation_handler;
-    NearestNeighborIndex&              _index;
-    vespalib::Executor&                _shared_executor;
-    std::mutex                         _mutex;
-    std::condition_variable            _cond;
-    Queue                              _queue;
-    uint64_t                           _pending; // _pending is only modified in forground thread
+    static constexpr uint32_t BATCH_SIZE = 4 * LOAD_COMMIT_INTERVAL;
+    TensorAttribute&          _attr;
+    NearestNeighborIndex&     _index;
+    ExecutorThreadBundle      _thread_bundle;
+    std::vector<uint32_t>     _batch;
 };
 
-void ThreadedIndexBuilder::add(uint32_t lid) {
-    Entry item;
-    while (pop(item)) {
-        // First process items that are ready to complete
-        complete(item.first, std::move(item.second));
-    }
-    // Then ensure that there no more than MAX_PENDING inflight
-    drainUntilPending(MAX_PENDING);
-
-    // Then we can issue a new one
-    ++_pending;
-    auto task = vespalib::makeLambdaTask([this, lid]() {
-        auto prepared = _index.prepare_add_document(lid, _attr.get_vectors(lid), _generation_handler.takeGuard());
-        std::unique_lock guard(_mutex);
-        _queue.push(std::make_pair(lid, std::move(prepared)));
-        if (_queue.size() == 1) {
-            _cond.notify_all();
-        }
-    });
-    _shared_executor.execute(CpuUsage::wrap(std::move(task), CpuUsage::Category::SETUP));
-}
-
 class ForegroundIndexBuilder : public IndexBuilder {
 public:
     ForegroundIndexBuilder(AttributeVector& attr, NearestNeighborIndex& index) : _attr(attr), _index(index) {}
@@ -218,9 +155,9 @@ private:
 
 } // namespace loader
 
-TensorAttributeLoader::TensorAttributeLoader(TensorAttribute& attr, GenerationHandler& generation_handler,
-                                             RefVector& ref_vector, TensorStore& store, NearestNeighborIndex* index)
-    : _attr(attr), _generation_handler(generation_handler), _ref_vector(ref_vector), _store(store), _index(index) {
+TensorAttributeLoader::TensorAttributeLoader(TensorAttribute& attr, RefVector& ref_vector, TensorStore& store,
+                                             NearestNeighborIndex* index)
+    : _attr(attr), _ref_vector(ref_vector), _store(store), _index(index) {
 }
 
 TensorAttributeLoader::~TensorAttributeLoader() = default;
@@ -271,7 +208,7 @@ void TensorAttributeLoader::build_index(vespalib::Executor* executor, uint32_t d
     _attr.get_initialization_status().start_reprocessing();
     std::unique_ptr<IndexBuilder> builder;
     if (executor != nullptr) {
-        builder = std::make_unique<ThreadedIndexBuilder>(_attr, _generation_handler, _store, *_index, *executor);
+        builder = std::make_unique<ThreadedIndexBuilder>(_attr, *_index, *executor);
         Event(_attr).addKV("execution", "multi-threaded").log("hnsw.index.rebuild.start");
     } else {
         builder = std::make_unique<ForegroundIndexBuilder>(_attr, *_index);
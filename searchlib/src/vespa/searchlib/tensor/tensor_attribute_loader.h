@@ -12,9 +12,8 @@ class BlobSequenceReader;
 namespace vespalib {
 
 class Executor;
-class GenerationHandler;
 
-} // namespace vespalib
+}
 
 namespace search::tensor {
 
@@ -29,10 +28,8 @@ class TensorStore;
  */
 class TensorAttributeLoader {
     using AtomicEntryRef = vespalib::datastore::AtomicEntryRef;
-    using GenerationHandler = vespalib::GenerationHandler;
     using RefVector = vespalib::RcuVectorBase<AtomicEntryRef>;
     TensorAttribute&      _attr;
-    GenerationHandler&    _generation_handler;
     RefVector&            _ref_vector;
     TensorStore&          _store;
     NearestNeighborIndex* _index;
@@ -46,8 +43,8 @@ class TensorAttributeLoader {
     void check_consistency(uint32_t docid_limit);
 
 public:
-    TensorAttributeLoader(TensorAttribute& attr, GenerationHandler& generation_handler, RefVector& ref_vector,
-                          TensorStore& store, NearestNeighborIndex* index);
+    TensorAttributeLoader(TensorAttribute& attr, RefVector& ref_vector, TensorStore& store,
+                          NearestNeighborIndex* index);
     ~TensorAttributeLoader();
     bool on_load(vespalib::Executor* executor);
 };
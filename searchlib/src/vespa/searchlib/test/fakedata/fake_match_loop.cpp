@@ -8,12 +8,16 @@
 #include <vespa/searchlib/queryeval/andsearch.h>
 #include <vespa/searchlib/queryeval/orsearch.h>
 #include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/searchlib/queryeval/wand/weak_and_heap.h>
+#include <vespa/searchlib/queryeval/wand/weak_and_search.h>
 
 using search::fef::TermFieldMatchData;
 using search::fef::TermFieldMatchDataArray;
 using search::queryeval::AndSearch;
 using search::queryeval::OrSearch;
 using search::queryeval::SearchIterator;
+using search::queryeval::WeakAndPriorityQueue;
+using search::queryeval::WeakAndSearch;
 
 namespace search::fakedata {
 
@@ -102,4 +106,24 @@ int FakeMatchLoop::or_pair_posting_scan_with_unpack(const FakePosting& posting_1
     return do_match_loop<true>(*iterator, doc_id_limit);
 }
 
+int FakeMatchLoop::weak_and_pair_posting_scan_with_unpack(const FakePosting& posting_1, const FakePosting& posting_2,
+                                                          uint32_t doc_id_limit, uint32_t target_hits,
+                                                          bool block_max) {
+    IteratorState        state_1(posting_1);
+    IteratorState        state_2(posting_2);
+    WeakAndPriorityQueue scores(target_hits);
+    // Document frequency is not known here, both terms are given the same estimate
+    uint32_t             est_hits = doc_id_limit / 2;
+    WeakAndSearch::Terms terms;
+    terms.emplace_back(state_1.release(), 100, est_hits);
+    terms.emplace_back(state_2.release(), 100, est_hits);
+    WeakAndSearch::MatchParams params(scores, search::queryeval::wand::StopWordStrategy::none(),
+                                      search::queryeval::wand::DEFAULT_PARALLEL_WAND_SCORES_ADJUST_FREQUENCY,
+                                      doc_id_limit);
+    std::unique_ptr<SearchIterator> iterator(
+        block_max ? WeakAndSearch::create_block_max(terms, params, target_hits, true, false)
+                  : WeakAndSearch::create(terms, params, target_hits, true, false));
+    return do_match_loop<true>(*iterator, doc_id_limit);
+}
+
 } // namespace search::fakedata
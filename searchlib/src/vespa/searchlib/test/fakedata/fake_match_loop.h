@@ -25,6 +25,13 @@ public:
                                     uint32_t doc_id_limit);
     static int or_pair_posting_scan_with_unpack(const FakePosting& posting_1, const FakePosting& posting_2,
                                                 uint32_t doc_id_limit);
+
+    /*
+     * WeakAnd over a pair of postings, tracking the best target_hits scores. Matching documents are always
+     * unpacked since the score threshold is only raised when unpacking.
+     */
+    static int weak_and_pair_posting_scan_with_unpack(const FakePosting& posting_1, const FakePosting& posting_2,
+                                                      uint32_t doc_id_limit, uint32_t target_hits, bool block_max);
 };
 
 } // namespace search::fakedata
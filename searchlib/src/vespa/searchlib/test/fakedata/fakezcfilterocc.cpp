@@ -124,6 +124,8 @@ template <bool bigEndian> void FakeZcFilterOcc::setupT(const FakeWord& fw) {
     params.set("minChunkDocs", _posting_params._min_chunk_docs); // Control chunking
     params.set("minSkipDocs", _posting_params._min_skip_docs);   // Control skip info
     params.set("interleaved_features", _posting_params._encode_interleaved_features);
+    params.set("block_max_features", _posting_params._encode_block_max);
+    params.set("packed_doc_ids", _posting_params._encode_packed_doc_ids);
     writer.set_posting_list_params(params);
     auto&                writeContext = writer.get_write_context();
     search::ComprBuffer& cb = writeContext;
@@ -612,6 +614,48 @@ public:
 
 template <bool bigEndian> FakeZc4SkipPosOccCf<bigEndian>::~FakeZc4SkipPosOccCf() = default;
 
+class FakeZc4SkipPosOccCfBlockMax : public FakeZc4SkipPosOcc<true> {
+    static Zc4PostingParams make_posting_params(const FakeWord& fw) {
+        Zc4PostingParams params(force_skip, disable_chunking, fw._docIdLimit, false, true, true);
+        params._encode_block_max = true;
+        return params;
+    }
+
+public:
+    FakeZc4SkipPosOccCfBlockMax(const FakeWord& fw)
+        : FakeZc4SkipPosOcc<true>(fw, make_posting_params(fw), ".zc4skipposoccbe.cf.bm") {}
+    ~FakeZc4SkipPosOccCfBlockMax() override;
+};
+
+FakeZc4SkipPosOccCfBlockMax::~FakeZc4SkipPosOccCfBlockMax() = default;
+
+class FakeZc4SkipPosOccPacked : public FakeZc4SkipPosOcc<true> {
+    static Zc4PostingParams make_posting_params(const FakeWord& fw, bool encode_interleaved_features) {
+        Zc4PostingParams params(force_skip, disable_chunking, fw._docIdLimit, false, true,
+                                encode_interleaved_features);
+        params._encode_block_max = encode_interleaved_features;
+        params._encode_packed_doc_ids = true;
+        return params;
+    }
+
+public:
+    FakeZc4SkipPosOccPacked(const FakeWord& fw)
+        : FakeZc4SkipPosOccPacked(fw, false, ".zc4skipposoccbe.pd") {}
+    FakeZc4SkipPosOccPacked(const FakeWord& fw, bool encode_interleaved_features, const char* name_suffix)
+        : FakeZc4SkipPosOcc<true>(fw, make_posting_params(fw, encode_interleaved_features), name_suffix) {}
+    ~FakeZc4SkipPosOccPacked() override;
+};
+
+FakeZc4SkipPosOccPacked::~FakeZc4SkipPosOccPacked() = default;
+
+class FakeZc4SkipPosOccCfPacked : public FakeZc4SkipPosOccPacked {
+public:
+    FakeZc4SkipPosOccCfPacked(const FakeWord& fw) : FakeZc4SkipPosOccPacked(fw, true, ".zc4skipposoccbe.cf.pd") {}
+    ~FakeZc4SkipPosOccCfPacked() override;
+};
+
+FakeZc4SkipPosOccCfPacked::~FakeZc4SkipPosOccCfPacked() = default;
+
 class FakeZc4SkipPosOccCfNoNormalUnpack : public FakeZc4SkipPosOcc<true> {
 public:
     FakeZc4SkipPosOccCfNoNormalUnpack(const FakeWord& fw)
@@ -716,6 +760,15 @@ static FPFactoryInit initSkipPos0becf(std::make_pair("Zc4SkipPosOccBE.cf",
 static FPFactoryInit initSkipPos0lecf(std::make_pair("Zc4SkipPosOccLE.cf",
                                                      makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCf<false>>>));
 
+static FPFactoryInit initSkipPos0becfbm(std::make_pair("Zc4SkipPosOccBE.cf.bm",
+                                                       makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfBlockMax>>));
+
+static FPFactoryInit initSkipPos0bepd(std::make_pair("Zc4SkipPosOccBE.pd",
+                                                     makeFPFactory<FPFactoryT<FakeZc4SkipPosOccPacked>>));
+
+static FPFactoryInit initSkipPos0becfpd(std::make_pair("Zc4SkipPosOccBE.cf.pd",
+                                                       makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfPacked>>));
+
 static FPFactoryInit initSkipPos0becfnnu(
     std::make_pair("Zc4SkipPosOccBE.cf.nnu", makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfNoNormalUnpack>>));
 
@@ -38,6 +38,13 @@ FeatureExecutor& ImpureValueBlueprint::createExecutor(const IQueryEnvironment&,
 
 struct DocidExecutor : FeatureExecutor {
     void execute(uint32_t docid) override { outputs().set_number(0, docid); }
+    bool supports_batch() const override { return true; }
+    void execute_batch(std::span<const uint32_t> docids, std::span<const feature_t* const>,
+                       std::span<feature_t* const> out) override {
+        for (size_t i = 0; i < docids.size(); ++i) {
+            out[0][i] = docids[i];
+        }
+    }
 };
 
 bool DocidBlueprint::setup(const IIndexEnvironment&, const std::vector<std::string>&) {
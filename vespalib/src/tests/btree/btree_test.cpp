@@ -1117,6 +1117,38 @@ TEST_F(BTreeTest, require_that_upper_bound_works) {
     requireThatUpperBoundWorksT<SetTreeL>();
 }
 
+struct OpaqueLess {
+    bool operator()(uint32_t lhs, uint32_t rhs) const noexcept { return lhs < rhs; }
+};
+
+static_assert(BTreeLinearKeySearch<uint32_t, std::less<uint32_t>>::value);
+static_assert(BTreeLinearKeySearch<uint64_t, std::less<>>::value);
+static_assert(!BTreeLinearKeySearch<uint32_t, OpaqueLess>::value);
+static_assert(!BTreeLinearKeySearch<EntryRef, std::less<EntryRef>>::value);
+
+TEST_F(BTreeTest, require_that_linear_key_search_matches_binary_key_search) {
+    using LinearTree = BTree<uint32_t, uint32_t, btree::NoAggregated, std::less<uint32_t>, BTreeDefaultTraits>;
+    using BinaryTree = BTree<uint32_t, uint32_t, btree::NoAggregated, OpaqueLess, BTreeDefaultTraits>;
+    GenerationHandler g;
+    LinearTree        linear_tree;
+    BinaryTree        binary_tree;
+    for (uint32_t key = 10; key < 10000; key += 3) {
+        EXPECT_TRUE(linear_tree.insert(key, key));
+        EXPECT_TRUE(binary_tree.insert(key, key));
+    }
+    auto linear_itr = linear_tree.begin();
+    auto binary_itr = binary_tree.begin();
+    for (uint32_t key = 0; key < 10010; ++key) {
+        EXPECT_EQ(binary_tree.lowerBound(key).position(), linear_tree.lowerBound(key).position());
+        EXPECT_EQ(binary_tree.upperBound(key).position(), linear_tree.upperBound(key).position());
+        if ((key % 7) == 0 && binary_itr.valid()) {
+            binary_itr.binarySeek(key);
+            linear_itr.binarySeek(key);
+            EXPECT_EQ(binary_itr.position(), linear_itr.position());
+        }
+    }
+}
+
 struct UpdKeyComp {
     int            _remainder;
     mutable size_t _numErrors;
@@ -39,6 +39,7 @@ void MemoryMapTestImpl(int mmap_flags) {
     char* mmapBuffer = static_cast<char*>(file.MemoryMapPtr(0));
     fprintf(stderr, "Memory mapping %s\n", mmapEnabled ? "enabled" : "disabled");
     fprintf(stderr, "Map address: 0x%p\n", mmapBuffer);
+    file.willNeed(100, 2 * bufSize); // Range extends beyond end of file
     if (mmapEnabled) {
         for (int i = 0; i < bufSize; i++) {
             EXPECT_EQ(mmapBuffer[i], char(i % 256));
@@ -192,6 +193,7 @@ TEST(FileTest, ReadBufTest) {
     buffer[4] = '\0';
     EXPECT_EQ(file.getPosition(), 4);
     EXPECT_EQ(strcmp(buffer, "This"), 0);
+    file.willNeed(8, 6);
     file.ReadBuf(buffer, 6, 8);
     buffer[6] = '\0';
     EXPECT_EQ(file.getPosition(), 4);
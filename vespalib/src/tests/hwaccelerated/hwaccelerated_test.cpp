@@ -322,6 +322,45 @@ TEST_F(HwAcceleratedTest, binary_hamming_distance_with_alignments) {
     }
 }
 
+// Bit-at-a-time reference packing of 128 values into the 4-lane vertical layout expected by unpack_bits_128
+std::vector<uint8_t> reference_pack_bits_128(const std::vector<uint32_t>& values, uint32_t bit_width) {
+    std::vector<uint32_t> words(4 * bit_width, 0);
+    for (uint32_t i = 0; i < 128; ++i) {
+        uint32_t lane = i % 4;
+        uint32_t lane_bit_pos = (i / 4) * bit_width;
+        for (uint32_t bit = 0; bit < bit_width; ++bit, ++lane_bit_pos) {
+            if ((values[i] >> bit) & 1) {
+                words[(lane_bit_pos / 32) * 4 + lane] |= (1u << (lane_bit_pos % 32));
+            }
+        }
+    }
+    std::vector<uint8_t> bytes(words.size() * sizeof(uint32_t) + 1); // +1 to test unaligned source
+    memcpy(bytes.data() + 1, words.data(), words.size() * sizeof(uint32_t));
+    return bytes;
+}
+
+TEST_F(HwAcceleratedTest, unpack_bits_128_impls_match_source_of_truth) {
+    auto                    accelerators = all_accelerators_to_test();
+    std::mt19937            gen(1234);
+    std::vector<uint32_t>   values(128);
+    std::vector<uint32_t>   unpacked(128);
+    for (uint32_t bit_width = 0; bit_width <= 32; ++bit_width) {
+        uint32_t max_value = (bit_width == 32) ? std::numeric_limits<uint32_t>::max() : ((1u << bit_width) - 1);
+        std::uniform_int_distribution<uint32_t> dist(0, max_value);
+        for (auto& v : values) {
+            v = dist(gen);
+        }
+        values[127] = max_value;
+        auto packed = reference_pack_bits_128(values, bit_width);
+        for (const auto* accel : accelerators) {
+            ScopedFnTableOverride fn_scope(accel->fn_table());
+            std::fill(unpacked.begin(), unpacked.end(), 0xdeadbeef);
+            unpack_bits_128(packed.data() + 1, bit_width, unpacked.data());
+            ASSERT_EQ(values, unpacked) << accel->target_info().to_string() << " with bit width " << bit_width;
+        }
+    }
+}
+
 using namespace dispatch;
 
 void PrintTo(const TargetInfo& info, std::ostream* os) {
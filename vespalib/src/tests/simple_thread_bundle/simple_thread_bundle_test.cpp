@@ -183,6 +183,15 @@ TEST(SimpleThreadBundleTest, require_that_all_strategies_work_with_variable_numb
     }
 }
 
+TEST(SimpleThreadBundleTest, require_that_bundles_with_numa_pinning_work) {
+    SimpleThreadBundle::Pool pool(4, Runnable::default_init_function, true);
+    auto                     guard = pool.getBundle();
+    State                    state(4);
+    guard.bundle().run(state.getTargets(4));
+    guard.bundle().run(state.getTargets(3));
+    state.check(Box<size_t>().add(2).add(2).add(2).add(1));
+}
+
 TEST(SimpleThreadBundleTest, require_that_bundle_pool_gives_out_bundles) {
     SimpleThreadBundle::Pool f1(5);
     auto                     b1 = f1.getBundle();
@@ -0,0 +1,48 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/test/test_path.h>
+#include <vespa/vespalib/util/numa_topology.h>
+
+using namespace vespalib;
+
+using CpuList = std::vector<uint32_t>;
+
+TEST(NumaTopologyTest, cpu_lists_can_be_parsed) {
+    EXPECT_EQ(CpuList({0, 1, 2, 3, 8, 9, 10, 11}), NumaTopology::parse_cpu_list("0-3,8-11\n"));
+    EXPECT_EQ(CpuList({5}), NumaTopology::parse_cpu_list("5"));
+    EXPECT_EQ(CpuList({1, 2, 7}), NumaTopology::parse_cpu_list("7,1-2"));
+    EXPECT_EQ(CpuList(), NumaTopology::parse_cpu_list(""));
+    EXPECT_EQ(CpuList(), NumaTopology::parse_cpu_list("3-1"));
+    EXPECT_EQ(CpuList(), NumaTopology::parse_cpu_list("1-x"));
+}
+
+TEST(NumaTopologyTest, nodes_are_read_from_node_directory) {
+    NumaTopology topology(TEST_PATH("numa_topology/two_nodes"));
+    ASSERT_EQ(2u, topology.num_nodes());
+    EXPECT_EQ(0u, topology.node_id(0));
+    EXPECT_EQ(1u, topology.node_id(1));
+    EXPECT_EQ(CpuList({0, 1, 2, 3, 8, 9, 10, 11}), topology.cpus(0));
+    EXPECT_EQ(CpuList({4, 5, 6, 7, 12, 13, 14, 15}), topology.cpus(1));
+}
+
+TEST(NumaTopologyTest, missing_node_directory_gives_single_node) {
+    NumaTopology topology(TEST_PATH("numa_topology/no_such_dir"));
+    ASSERT_EQ(1u, topology.num_nodes());
+    EXPECT_EQ(0u, topology.node_id(0));
+    EXPECT_TRUE(topology.cpus(0).empty());
+    EXPECT_FALSE(topology.pin_current_thread(0));
+}
+
+TEST(NumaTopologyTest, threads_are_split_into_contiguous_groups_per_node) {
+    NumaTopology        topology(TEST_PATH("numa_topology/two_nodes"));
+    std::vector<size_t> nodes;
+    for (size_t i = 0; i < 5; ++i) {
+        nodes.push_back(topology.node_for_thread(i, 5));
+    }
+    EXPECT_EQ(std::vector<size_t>({0, 0, 0, 1, 1}), nodes);
+}
+
+TEST(NumaTopologyTest, host_topology_has_at_least_one_node) {
+    EXPECT_LE(1u, NumaTopology::get().num_nodes());
+}
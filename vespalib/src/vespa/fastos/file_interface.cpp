@@ -202,3 +202,6 @@ bool FastOS_FileInterface::OpenWriteOnly(const char* filename) {
 
 void FastOS_FileInterface::dropFromCache() const {
 }
+
+void FastOS_FileInterface::willNeed(int64_t, size_t) const {
+}
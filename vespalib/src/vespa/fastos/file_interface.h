@@ -427,4 +427,12 @@ public:
      * Will drop whatever is in the FS cache when called. Does not have effect in the future.
      **/
     virtual void dropFromCache() const;
+
+    /**
+     * Hint that the given part of the file will be read soon. Asynchronous
+     * readahead is started for the range (the memory mapping if the file is
+     * memory mapped, otherwise the page cache) and the call returns without
+     * waiting for it to complete. Does not have effect when direct io is used.
+     **/
+    virtual void willNeed(int64_t position, size_t length) const;
 };
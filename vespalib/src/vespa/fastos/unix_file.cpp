@@ -10,12 +10,14 @@
 #include "unix_file.h"
 
 #include <vespa/vespalib/util/error.h>
+#include <vespa/vespalib/util/round_up_to_page_size.h>
 
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 #ifdef __APPLE__
@@ -198,6 +200,24 @@ void FastOS_UNIX_File::dropFromCache() const {
 #endif
 }
 
+void FastOS_UNIX_File::willNeed(int64_t position, size_t length) const {
+    if (position < 0 || length == 0) {
+        return;
+    }
+    if (_mmapbase != nullptr) {
+        if (position >= int64_t(_mmaplen)) {
+            return;
+        }
+        size_t start = vespalib::round_down_to_page_boundary(position);
+        size_t end = std::min(size_t(position) + length, _mmaplen);
+        madvise(static_cast<char*>(_mmapbase) + start, end - start, MADV_WILLNEED);
+    } else if (_filedes >= 0 && !_directIOEnabled) {
+#ifdef __linux__
+        posix_fadvise(_filedes, position, length, POSIX_FADV_WILLNEED);
+#endif
+    }
+}
+
 bool FastOS_UNIX_File::Close() {
     bool ok = true;
 
@@ -71,6 +71,7 @@ public:
     [[nodiscard]] bool Sync() override;
     bool SetSize(int64_t newSize) override;
     void dropFromCache() const override;
+    void willNeed(int64_t position, size_t length) const override;
 
     static int count_open_files();
 };
@@ -11,6 +11,7 @@
 
 #include <cassert>
 #include <cstddef>
+#include <functional>
 #include <type_traits>
 #include <utility>
 
@@ -152,6 +153,18 @@ public:
 
 template <> MinMaxAggregated BTreeNodeAggregatedWrap<MinMaxAggregated>::_instance;
 
+/**
+ * Selects a branchless linear scan instead of a binary search when
+ * searching for a key in a node. All remaining keys in the node are
+ * compared without data dependent branches, which the compiler turns
+ * into SIMD compares. Used for integral keys ordered by std::less, and
+ * can be specialized for other keys with a trivial ordering.
+ */
+template <typename KeyT, typename CompareT> struct BTreeLinearKeySearch {
+    static constexpr bool value = std::is_integral_v<KeyT> && (std::is_same_v<CompareT, std::less<KeyT>> ||
+                                                               std::is_same_v<CompareT, std::less<>>);
+};
+
 template <typename KeyT, uint32_t NumSlots> class BTreeNodeT : public BTreeNode {
 protected:
     KeyT _keys[NumSlots];
@@ -177,6 +190,16 @@ protected:
         return *this;
     }
 
+    template <typename CompareT>
+    static constexpr bool use_linear_key_search = BTreeLinearKeySearch<KeyT, std::remove_cv_t<CompareT>>::value;
+
+    // Number of keys from sidx that are ordered before key
+    template <typename CompareT> uint32_t count_less(uint32_t sidx, const KeyT& key, CompareT comp) const noexcept;
+
+    // Number of keys from sidx that are not ordered after key
+    template <typename CompareT>
+    uint32_t count_not_greater(uint32_t sidx, const KeyT& key, CompareT comp) const noexcept;
+
 public:
     const KeyT& getKey(uint32_t idx) const noexcept { return _keys[idx]; }
     const KeyT& getLastKey() const noexcept { return _keys[validSlots() - 1]; }
@@ -36,25 +36,61 @@ public:
 
 } // namespace
 
+template <typename KeyT, uint32_t NumSlots>
+template <typename CompareT>
+uint32_t BTreeNodeT<KeyT, NumSlots>::count_less(uint32_t sidx, const KeyT& key, CompareT comp) const noexcept {
+    uint32_t count = 0;
+    uint32_t eidx = validSlots();
+    for (uint32_t i = sidx; i < eidx; ++i) {
+        count += comp(_keys[i], key) ? 1 : 0;
+    }
+    return count;
+}
+
+template <typename KeyT, uint32_t NumSlots>
+template <typename CompareT>
+uint32_t BTreeNodeT<KeyT, NumSlots>::count_not_greater(uint32_t sidx, const KeyT& key, CompareT comp) const noexcept {
+    uint32_t count = 0;
+    uint32_t eidx = validSlots();
+    for (uint32_t i = sidx; i < eidx; ++i) {
+        count += comp(key, _keys[i]) ? 0 : 1;
+    }
+    return count;
+}
+
 template <typename KeyT, uint32_t NumSlots>
 template <typename CompareT>
 uint32_t BTreeNodeT<KeyT, NumSlots>::lower_bound(uint32_t sidx, const KeyT& key, CompareT comp) const noexcept {
-    const KeyT* itr = std::lower_bound<const KeyT*, KeyT, CompareT>(_keys + sidx, _keys + validSlots(), key, comp);
-    return itr - _keys;
+    if constexpr (use_linear_key_search<CompareT>) {
+        return sidx + count_less(sidx, key, comp);
+    } else {
+        const KeyT* itr =
+            std::lower_bound<const KeyT*, KeyT, CompareT>(_keys + sidx, _keys + validSlots(), key, comp);
+        return itr - _keys;
+    }
 }
 
 template <typename KeyT, uint32_t NumSlots>
 template <typename CompareT>
 uint32_t BTreeNodeT<KeyT, NumSlots>::lower_bound(const KeyT& key, CompareT comp) const noexcept {
-    const KeyT* itr = std::lower_bound<const KeyT*, KeyT, CompareT>(_keys, _keys + validSlots(), key, comp);
-    return itr - _keys;
+    if constexpr (use_linear_key_search<CompareT>) {
+        return count_less(0, key, comp);
+    } else {
+        const KeyT* itr = std::lower_bound<const KeyT*, KeyT, CompareT>(_keys, _keys + validSlots(), key, comp);
+        return itr - _keys;
+    }
 }
 
 template <typename KeyT, uint32_t NumSlots>
 template <typename CompareT>
 uint32_t BTreeNodeT<KeyT, NumSlots>::upper_bound(uint32_t sidx, const KeyT& key, CompareT comp) const noexcept {
-    const KeyT* itr = std::upper_bound<const KeyT*, KeyT, CompareT>(_keys + sidx, _keys + validSlots(), key, comp);
-    return itr - _keys;
+    if constexpr (use_linear_key_search<CompareT>) {
+        return sidx + count_not_greater(sidx, key, comp);
+    } else {
+        const KeyT* itr =
+            std::upper_bound<const KeyT*, KeyT, CompareT>(_keys + sidx, _keys + validSlots(), key, comp);
+        return itr - _keys;
+    }
 }
 
 template <typename KeyT, typename DataT, typename AggrT, uint32_t NumSlots>
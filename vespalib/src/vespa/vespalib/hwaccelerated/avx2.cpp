@@ -32,6 +32,9 @@ void my_and_128(size_t offset, const std::vector<std::pair<const void*, bool>>&
 void my_or_128(size_t offset, const std::vector<std::pair<const void*, bool>>& src, void* dest) noexcept {
     helper::orChunks<32u, 4u>(offset, src, dest);
 }
+void my_unpack_bits_128(const void* src, uint32_t bit_width, uint32_t* dest) noexcept {
+    helper::unpack_bits_128(src, bit_width, dest);
+}
 TargetInfo my_target_info() noexcept {
     return {"AutoVec", "AVX2", 32};
 }
@@ -49,6 +52,7 @@ namespace {
     ft.convert_bfloat16_to_float = my_convert_bfloat16_to_float;
     ft.and_128 = my_and_128;
     ft.or_128 = my_or_128;
+    ft.unpack_bits_128 = my_unpack_bits_128;
     return ft;
 }
 
@@ -41,6 +41,9 @@ void my_and_128(size_t offset, const std::vector<std::pair<const void*, bool>>&
 void my_or_128(size_t offset, const std::vector<std::pair<const void*, bool>>& src, void* dest) noexcept {
     helper::orChunks<64, 2>(offset, src, dest);
 }
+void my_unpack_bits_128(const void* src, uint32_t bit_width, uint32_t* dest) noexcept {
+    helper::unpack_bits_128(src, bit_width, dest);
+}
 TargetInfo my_target_info() noexcept {
     return {"AutoVec", "AVX3", 64};
 }
@@ -61,6 +64,7 @@ namespace {
     ft.convert_bfloat16_to_float = my_convert_bfloat16_to_float;
     ft.and_128 = my_and_128;
     ft.or_128 = my_or_128;
+    ft.unpack_bits_128 = my_unpack_bits_128;
     return ft;
 }
 
@@ -48,6 +48,8 @@ using NotBitFn = void (*)(void* a, size_t bytes) noexcept;
 using And128Fn = void (*)(size_t offset, const std::vector<std::pair<const void*, bool>>& src, void* dest) noexcept;
 using Or128Fn = void (*)(size_t offset, const std::vector<std::pair<const void*, bool>>& src, void* dest) noexcept;
 
+using UnpackBits128Fn = void (*)(const void* src, uint32_t bit_width, uint32_t* dest) noexcept;
+
 // Function table containing (possibly nullptr) raw function pointers to vectorization
 // function implementations. These pointers must be entirely "freestanding" (i.e. not
 // require any explicit `this`-like state) and must be valid for the lifetime of the
@@ -92,6 +94,8 @@ struct FnTable {
     And128Fn and_128 = nullptr;
     Or128Fn  or_128 = nullptr;
 
+    UnpackBits128Fn unpack_bits_128 = nullptr;
+
     enum class FnId {
         DOT_PRODUCT_I8 = 0,
         DOT_PRODUCT_I16,
@@ -114,6 +118,7 @@ struct FnTable {
         NOT_BIT,
         AND_128,
         OR_128,
+        UNPACK_BITS_128,
         MAX_ID_SENTINEL
     };
 
@@ -193,7 +198,8 @@ struct FnTable {
     VISITOR(AndNotBitFn, and_not_bit, FnTable::FnId::AND_NOT_BIT)                                                   \
     VISITOR(NotBitFn, not_bit, FnTable::FnId::NOT_BIT)                                                              \
     VISITOR(And128Fn, and_128, FnTable::FnId::AND_128)                                                              \
-    VISITOR(Or128Fn, or_128, FnTable::FnId::OR_128)
+    VISITOR(Or128Fn, or_128, FnTable::FnId::OR_128)                                                                 \
+    VISITOR(UnpackBits128Fn, unpack_bits_128, FnTable::FnId::UNPACK_BITS_128)
 
 // Freestanding global dispatch function pointers declarations.
 // These are link-time initialized to the baseline target implementations (which
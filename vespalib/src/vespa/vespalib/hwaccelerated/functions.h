@@ -98,4 +98,11 @@ inline void or_128(size_t offset, const std::vector<std::pair<const void*, bool>
     dispatch::VESPA_HWACCEL_DISPATCH_FN_PTR_NAME(or_128)(offset, src, dest);
 }
 
+// Unpack 128 unsigned integers of bit_width (0-32) bits each. The input is 4 * bit_width little
+// endian 32-bit words (no alignment requirement) where value i is stored in lane (i % 4), i.e.
+// lane l is the bit stream formed by words l, l + 4, l + 8, ... (SIMD-BP128 vertical layout).
+inline void unpack_bits_128(const void* src, uint32_t bit_width, uint32_t* dest) noexcept {
+    dispatch::VESPA_HWACCEL_DISPATCH_FN_PTR_NAME(unpack_bits_128)(src, bit_width, dest);
+}
+
 } // namespace vespalib::hwaccelerated
@@ -163,6 +163,9 @@ void my_and_128(size_t offset, const std::vector<std::pair<const void*, bool>>&
 void my_or_128(size_t offset, const std::vector<std::pair<const void*, bool>>& src, void* dest) noexcept {
     helper::orChunks<16, 8>(offset, src, dest);
 }
+void my_unpack_bits_128(const void* src, uint32_t bit_width, uint32_t* dest) noexcept {
+    helper::unpack_bits_128(src, bit_width, dest);
+}
 constexpr uint16_t baseline_vector_bytes() noexcept {
 #if defined(__AVX512F__)
     return 64;
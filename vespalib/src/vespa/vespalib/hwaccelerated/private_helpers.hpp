@@ -4,9 +4,11 @@
 
 #include <vespa/config.h>
 
+#include <array>
 #include <bit>
 #include <cstdint>
 #include <cstring>
+#include <utility>
 #include <vector>
 
 namespace vespalib::hwaccelerated::helper {
@@ -147,6 +149,43 @@ inline void convert_bfloat16_to_float(const uint16_t* src, float* dest, size_t s
     }
 }
 
+// Unpacks 128 values of BitWidth bits stored in 4 interleaved 32-bit lanes. With a compile time bit
+// width all shifts are constant and the inner lane loop maps directly onto 128-bit vector operations.
+template <uint32_t BitWidth> void unpack_bits_128_t(const uint8_t* src, uint32_t* dest) noexcept {
+    if constexpr (BitWidth == 0) {
+        memset(dest, 0, 128 * sizeof(uint32_t));
+    } else {
+        constexpr uint32_t mask = (BitWidth == 32) ? ~0u : ((1u << BitWidth) - 1);
+        uint32_t           words[4 * BitWidth];
+        memcpy(words, src, sizeof(words));
+        for (uint32_t i = 0; i < 32; ++i) {
+            const uint32_t bit_pos = i * BitWidth;
+            const uint32_t word = bit_pos / 32;
+            const uint32_t shift = bit_pos % 32;
+            for (uint32_t lane = 0; lane < 4; ++lane) {
+                uint32_t v = words[word * 4 + lane] >> shift;
+                if (shift + BitWidth > 32) {
+                    v |= words[(word + 1) * 4 + lane] << (32 - shift);
+                }
+                dest[i * 4 + lane] = v & mask;
+            }
+        }
+    }
+}
+
+using UnpackBits128T = void (*)(const uint8_t* src, uint32_t* dest) noexcept;
+
+template <size_t... BitWidths>
+constexpr std::array<UnpackBits128T, sizeof...(BitWidths)>
+make_unpack_bits_128_table(std::index_sequence<BitWidths...>) noexcept {
+    return {&unpack_bits_128_t<BitWidths>...};
+}
+
+inline void unpack_bits_128(const void* src, uint32_t bit_width, uint32_t* dest) noexcept {
+    static constexpr auto table = make_unpack_bits_128_table(std::make_index_sequence<33>());
+    table[bit_width](static_cast<const uint8_t*>(src), dest);
+}
+
 template <typename ACCUM = uint32_t>
 ACCUM multiplyAddT(const int8_t* a, const int8_t* b, size_t sz) noexcept __attribute__((noinline));
 
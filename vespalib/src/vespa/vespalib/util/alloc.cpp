@@ -3,6 +3,7 @@
 
 #include "atomic.h"
 #include "memory_allocator.h"
+#include "numa_topology.h"
 #include "round_up_to_page_size.h"
 
 #include <vespa/vespalib/util/backtrace.h>
@@ -11,6 +12,11 @@
 #include <vespa/vespalib/util/stringfmt.h>
 
 #include <sys/mman.h>
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #include <atomic>
 #include <cassert>
@@ -18,6 +24,7 @@
 #include <mutex>
 #include <system_error>
 #include <unordered_map>
+#include <vector>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".vespalib.alloc");
@@ -33,6 +40,7 @@ bool                _g_SilenceCoreOnOOM(false);
 int                 _g_HugeFlags = 0;
 size_t              _g_MMapLogLimit = std::numeric_limits<size_t>::max();
 size_t              _g_MMapNoCoreLimit = std::numeric_limits<size_t>::max();
+size_t              _g_MMapNumaInterleaveLimit = std::numeric_limits<size_t>::max();
 std::mutex          _g_lock;
 std::atomic<size_t> _g_mmapCount(0);
 
@@ -68,6 +76,36 @@ void initializeEnvironment() {
     _g_SilenceCoreOnOOM = (getenv("VESPA_SILENCE_CORE_ON_OOM") != nullptr) ? true : false;
     _g_MMapLogLimit = readOptionalEnvironmentVar("VESPA_MMAP_LOG_LIMIT", std::numeric_limits<size_t>::max());
     _g_MMapNoCoreLimit = readOptionalEnvironmentVar("VESPA_MMAP_NOCORE_LIMIT", std::numeric_limits<size_t>::max());
+    _g_MMapNumaInterleaveLimit =
+        readOptionalEnvironmentVar("VESPA_MMAP_NUMA_INTERLEAVE_LIMIT", std::numeric_limits<size_t>::max());
+}
+
+/*
+ * Spread the pages of a large mapping evenly over all NUMA nodes, so
+ * that memory bandwidth is shared between the nodes instead of all
+ * pages ending up on the node of the thread that happens to touch
+ * them first.
+ */
+void interleaveAcrossNumaNodes(void* buf, size_t sz) {
+#ifdef __linux__
+    const NumaTopology& topology = NumaTopology::get();
+    if (topology.num_nodes() < 2) {
+        return;
+    }
+    constexpr size_t           word_bits = 8 * sizeof(unsigned long);
+    uint32_t                   max_node_id = topology.node_id(topology.num_nodes() - 1);
+    std::vector<unsigned long> node_mask(((max_node_id + 1) / word_bits) + 1, 0);
+    for (size_t node = 0; node < topology.num_nodes(); ++node) {
+        uint32_t id = topology.node_id(node);
+        node_mask[id / word_bits] |= (1ul << (id % word_bits));
+    }
+    if (syscall(SYS_mbind, buf, sz, MPOL_INTERLEAVE, node_mask.data(), max_node_id + 2, 0) != 0) {
+        LOG(debug, "Failed mbind(%p, %ld, MPOL_INTERLEAVE) = '%s'", buf, sz, getLastErrorString().c_str());
+    }
+#else
+    (void)buf;
+    (void)sz;
+#endif
 }
 
 class Initialize {
@@ -354,6 +392,9 @@ PtrAndSize MMapAllocator::salloc(size_t sz, void* wantedAddress) {
             }
         }
 #endif
+        if (sz >= _g_MMapNumaInterleaveLimit) {
+            interleaveAcrossNumaNodes(buf, sz);
+        }
         if (sz >= _g_MMapLogLimit) {
             std::lock_guard guard(_g_lock);
             _g_HugeMappings[buf] = MMapInfo(mmapId, sz, stackTrace);
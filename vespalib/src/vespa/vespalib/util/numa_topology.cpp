@@ -0,0 +1,105 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "numa_topology.h"
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace vespalib {
+
+namespace {
+
+bool parse_number(std::string_view str, uint32_t& value) {
+    auto res = std::from_chars(str.data(), str.data() + str.size(), value);
+    return (res.ec == std::errc()) && (res.ptr == str.data() + str.size()) && !str.empty();
+}
+
+} // namespace
+
+NumaTopology::NumaTopology(const std::string& node_dir) : _node_ids(), _node_cpus() {
+    std::map<uint32_t, std::vector<uint32_t>> nodes;
+    std::error_code                           ec;
+    for (const auto& entry : std::filesystem::directory_iterator(node_dir, ec)) {
+        std::string name = entry.path().filename().string();
+        uint32_t    id = 0;
+        if (name.starts_with("node") && parse_number(std::string_view(name).substr(4), id)) {
+            std::ifstream file(entry.path() / "cpulist");
+            std::string   line;
+            std::getline(file, line);
+            nodes[id] = parse_cpu_list(line);
+        }
+    }
+    for (auto& [id, cpus] : nodes) {
+        _node_ids.push_back(id);
+        _node_cpus.push_back(std::move(cpus));
+    }
+    if (_node_ids.empty()) {
+        _node_ids.push_back(0);
+        _node_cpus.emplace_back();
+    }
+}
+
+NumaTopology::~NumaTopology() = default;
+
+const NumaTopology& NumaTopology::get() {
+    static NumaTopology topology("/sys/devices/system/node");
+    return topology;
+}
+
+std::vector<uint32_t> NumaTopology::parse_cpu_list(std::string_view list) {
+    std::vector<uint32_t> result;
+    while (!list.empty() && (list.back() == '\n' || list.back() == ' ')) {
+        list.remove_suffix(1);
+    }
+    while (!list.empty()) {
+        auto             comma = list.find(',');
+        std::string_view range = list.substr(0, comma);
+        list = (comma == std::string_view::npos) ? std::string_view() : list.substr(comma + 1);
+        auto     dash = range.find('-');
+        uint32_t first = 0;
+        uint32_t last = 0;
+        if (!parse_number(range.substr(0, dash), first)) {
+            return {};
+        }
+        if (dash == std::string_view::npos) {
+            last = first;
+        } else if (!parse_number(range.substr(dash + 1), last) || (last < first)) {
+            return {};
+        }
+        for (uint32_t cpu = first; cpu <= last; ++cpu) {
+            result.push_back(cpu);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+bool NumaTopology::pin_current_thread(size_t node) const {
+#ifdef __linux__
+    if ((node >= num_nodes()) || cpus(node).empty()) {
+        return false;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (uint32_t cpu : cpus(node)) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &cpu_set);
+        }
+    }
+    return (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0);
+#else
+    (void)node;
+    return false;
+#endif
+}
+
+} // namespace vespalib
@@ -0,0 +1,57 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * The NUMA nodes of this host and the cpus belonging to each of them,
+ * as listed in sysfs. A host without NUMA information is seen as a
+ * single node with no known cpus. This is only used to give placement
+ * hints; a failure to apply them is not an error.
+ **/
+class NumaTopology {
+private:
+    std::vector<uint32_t>              _node_ids;
+    std::vector<std::vector<uint32_t>> _node_cpus;
+
+public:
+    // Read the topology from a directory laid out like /sys/devices/system/node
+    explicit NumaTopology(const std::string& node_dir);
+    NumaTopology(const NumaTopology&) = delete;
+    NumaTopology& operator=(const NumaTopology&) = delete;
+    ~NumaTopology();
+
+    // The topology of this host, detected on first use
+    static const NumaTopology& get();
+
+    // Parse a cpu list like "0-3,8-11"; invalid lists give an empty result
+    static std::vector<uint32_t> parse_cpu_list(std::string_view list);
+
+    size_t num_nodes() const noexcept { return _node_ids.size(); }
+    uint32_t node_id(size_t node) const noexcept { return _node_ids[node]; }
+    const std::vector<uint32_t>& cpus(size_t node) const noexcept { return _node_cpus[node]; }
+
+    /**
+     * The node (index) for thread 'thread_id' out of 'num_threads'
+     * threads, when threads are split into one contiguous group per
+     * node.
+     **/
+    size_t node_for_thread(size_t thread_id, size_t num_threads) const noexcept {
+        return (thread_id * num_nodes()) / num_threads;
+    }
+
+    /**
+     * Restrict the calling thread to the cpus of the given node
+     * (index). Returns false if this was not possible.
+     **/
+    bool pin_current_thread(size_t node) const;
+};
+
+} // namespace vespalib
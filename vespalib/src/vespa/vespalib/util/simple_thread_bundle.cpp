@@ -3,6 +3,7 @@
 #include "simple_thread_bundle.h"
 
 #include "exceptions.h"
+#include "numa_topology.h"
 
 #include <cassert>
 
@@ -50,6 +51,13 @@ Runnable::UP chain(Runnable::UP first, Runnable::UP second) {
     return std::make_unique<HookPair>(std::move(first), std::move(second));
 }
 
+Runnable::init_fun_t pin_to_node(Runnable::init_fun_t init_fun, size_t node) {
+    return [init_fun = std::move(init_fun), node](Runnable& target) {
+        NumaTopology::get().pin_current_thread(node);
+        return init_fun(target);
+    };
+}
+
 } // namespace
 
 //-----------------------------------------------------------------------------
@@ -62,8 +70,8 @@ Signal::Signal() noexcept
 }
 Signal::~Signal() = default;
 
-SimpleThreadBundle::Pool::Pool(size_t bundleSize, init_fun_t init_fun)
-    : _lock(), _bundleSize(bundleSize), _init_fun(init_fun), _bundles() {
+SimpleThreadBundle::Pool::Pool(size_t bundleSize, init_fun_t init_fun, bool numa_pinning)
+    : _lock(), _bundleSize(bundleSize), _init_fun(init_fun), _numa_pinning(numa_pinning), _bundles() {
 }
 
 SimpleThreadBundle::Pool::~Pool() {
@@ -82,7 +90,7 @@ SimpleThreadBundle::UP SimpleThreadBundle::Pool::obtain() {
             return ret;
         }
     }
-    return std::make_unique<SimpleThreadBundle>(_bundleSize, _init_fun, USE_SIGNAL_LIST);
+    return std::make_unique<SimpleThreadBundle>(_bundleSize, _init_fun, USE_SIGNAL_LIST, _numa_pinning);
 }
 
 void SimpleThreadBundle::Pool::release(SimpleThreadBundle::UP bundle) {
@@ -93,7 +101,8 @@ void SimpleThreadBundle::Pool::release(SimpleThreadBundle::UP bundle) {
 
 //-----------------------------------------------------------------------------
 
-SimpleThreadBundle::SimpleThreadBundle(size_t size_in, Runnable::init_fun_t init_fun, Strategy strategy)
+SimpleThreadBundle::SimpleThreadBundle(size_t size_in, Runnable::init_fun_t init_fun, Strategy strategy,
+                                       bool numa_pinning)
     : _work(), _signals(), _workers(), _hook() {
     if (size_in == 0) {
         throw IllegalArgumentException("size must be greater than 0");
@@ -103,7 +112,9 @@ SimpleThreadBundle::SimpleThreadBundle(size_t size_in, Runnable::init_fun_t init
     } else {
         _signals.resize(size_in - 1); // separate signal per worker
     }
-    size_t next_unwired = 1;
+    const NumaTopology& topology = NumaTopology::get();
+    const bool          pin_threads = numa_pinning && (topology.num_nodes() > 1);
+    size_t              next_unwired = 1;
     for (size_t i = 0; i < size_in; ++i) {
         Runnable::UP hook(new PartHook(Part(_work, i)));
         if (strategy == USE_SIGNAL_TREE) {
@@ -123,8 +134,12 @@ SimpleThreadBundle::SimpleThreadBundle(size_t size_in, Runnable::init_fun_t init
         if (i == 0) {
             _hook = std::move(hook);
         } else {
-            size_t signal_idx = (strategy == USE_BROADCAST) ? 0 : (i - 1);
-            _workers.push_back(std::make_unique<Worker>(_signals[signal_idx], init_fun, std::move(hook)));
+            size_t     signal_idx = (strategy == USE_BROADCAST) ? 0 : (i - 1);
+            init_fun_t worker_init_fun = init_fun;
+            if (pin_threads) {
+                worker_init_fun = pin_to_node(init_fun, topology.node_for_thread(i, size_in));
+            }
+            _workers.push_back(std::make_unique<Worker>(_signals[signal_idx], worker_init_fun, std::move(hook)));
         }
     }
 }
@@ -83,6 +83,13 @@ struct Signal {
 /**
  * A ThreadBundle implementation employing a fixed set of internal
  * threads. The internal Pool class can be used to recycle bundles.
+ *
+ * With NUMA pinning, the threads are split into one contiguous group
+ * per NUMA node (see NumaTopology) and each internal thread is
+ * restricted to the cpus of its node. Targets given to run are
+ * assigned to threads in order, so adjacent targets (e.g. adjacent
+ * docid partitions) are handled on the same node. The calling thread
+ * runs the first target and is never pinned.
  **/
 class SimpleThreadBundle : public ThreadBundle {
 public:
@@ -98,6 +105,7 @@ public:
         std::mutex                       _lock;
         size_t                           _bundleSize;
         init_fun_t                       _init_fun;
+        bool                             _numa_pinning;
         std::vector<SimpleThreadBundle*> _bundles;
 
     public:
@@ -113,7 +121,8 @@ public:
             SimpleThreadBundle::UP _bundle;
             Pool&                  _pool;
         };
-        Pool(size_t bundleSize, init_fun_t init_fun);
+        Pool(size_t bundleSize, init_fun_t init_fun, bool numa_pinning);
+        Pool(size_t bundleSize, init_fun_t init_fun) : Pool(bundleSize, std::move(init_fun), false) {}
         explicit Pool(size_t bundleSize) : Pool(bundleSize, Runnable::default_init_function) {}
         ~Pool();
         Guard getBundle() { return Guard(*this); }
@@ -138,7 +147,9 @@ private:
     Runnable::UP            _hook;
 
 public:
-    SimpleThreadBundle(size_t size, init_fun_t init_fun, Strategy strategy);
+    SimpleThreadBundle(size_t size, init_fun_t init_fun, Strategy strategy, bool numa_pinning);
+    SimpleThreadBundle(size_t size, init_fun_t init_fun, Strategy strategy)
+        : SimpleThreadBundle(size, std::move(init_fun), strategy, false) {}
     SimpleThreadBundle(size_t size, Strategy strategy)
         : SimpleThreadBundle(size, Runnable::default_init_function, strategy) {}
     explicit SimpleThreadBundle(size_t size) : SimpleThreadBundle(size, USE_SIGNAL_LIST) {}